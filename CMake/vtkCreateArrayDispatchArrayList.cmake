@@ -15,6 +15,10 @@
 #   Include vtkTypedDataArray<ValueType> for the basic types supported
 #   by VTK. This enables the old-style in-situ vtkMappedDataArray subclasses
 #   to be used.
+# - VTK_DISPATCH_IMPLICIT_ARRAYS (default: OFF)
+#   Include vtkConstantArray<ValueType>, vtkAffineArray<ValueType> and
+#   vtkCompositeArray<ValueType> for the basic types supported by VTK, so that
+#   dispatched workers compute their values inline.
 #
 # At a lower level, specific arrays can be added to the list individually in
 # two ways:
@@ -139,6 +143,23 @@ if (VTK_DISPATCH_TYPED_ARRAYS)
   )
 endif()
 
+if (VTK_DISPATCH_IMPLICIT_ARRAYS)
+  list(APPEND vtkArrayDispatch_containers
+    vtkConstantArray vtkAffineArray vtkCompositeArray)
+  set(vtkArrayDispatch_vtkConstantArray_header vtkConstantArray.h)
+  set(vtkArrayDispatch_vtkConstantArray_types
+    ${vtkArrayDispatch_all_types}
+  )
+  set(vtkArrayDispatch_vtkAffineArray_header vtkAffineArray.h)
+  set(vtkArrayDispatch_vtkAffineArray_types
+    ${vtkArrayDispatch_all_types}
+  )
+  set(vtkArrayDispatch_vtkCompositeArray_header vtkCompositeArray.h)
+  set(vtkArrayDispatch_vtkCompositeArray_types
+    ${vtkArrayDispatch_all_types}
+  )
+endif()
+
 endmacro()
 
 # Concatenates a list of strings into a single string, since string(CONCAT ...)
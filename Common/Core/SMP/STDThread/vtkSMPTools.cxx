@@ -0,0 +1,296 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPTools.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Implementation based on a persistent pool of std::thread workers. The
+// range of a For() is cut in chunks of "grain" items which are distributed
+// evenly over per-thread queues. Each thread processes the chunks of its
+// own queue from the front and, once it is empty, steals chunks from the
+// back of the other queues. The calling thread takes part in the work.
+
+namespace
+{
+
+std::atomic<int> vtkSMPNumberOfSpecifiedThreads(0);
+
+//--------------------------------------------------------------------------------
+// A contiguous range of chunk indices [Begin, End) owned by one thread.
+struct vtkSMPWorkQueue
+{
+  std::mutex Lock;
+  vtkIdType Begin;
+  vtkIdType End;
+
+  vtkSMPWorkQueue() : Begin(0), End(0) {}
+
+  // Take a chunk from the front: used by the owner of the queue.
+  bool Pop(vtkIdType &chunk)
+  {
+    std::lock_guard<std::mutex> guard(this->Lock);
+    if (this->Begin >= this->End)
+    {
+      return false;
+    }
+    chunk = this->Begin++;
+    return true;
+  }
+
+  // Take a chunk from the back: used by the other threads.
+  bool Steal(vtkIdType &chunk)
+  {
+    std::lock_guard<std::mutex> guard(this->Lock);
+    if (this->Begin >= this->End)
+    {
+      return false;
+    }
+    chunk = --this->End;
+    return true;
+  }
+};
+
+//--------------------------------------------------------------------------------
+class vtkSMPThreadPool
+{
+public:
+  explicit vtkSMPThreadPool(int numThreads)
+    : Queues(numThreads), Busy(false), Generation(0), Pending(0), Stop(false),
+      First(0), Last(0), Grain(1), Executer(NULL), Functor(NULL)
+  {
+    for (int i = 1; i < numThreads; ++i)
+    {
+      this->Threads.push_back(std::thread(&vtkSMPThreadPool::Work, this, i));
+    }
+  }
+
+  ~vtkSMPThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> guard(this->JobLock);
+      this->Stop = true;
+    }
+    this->JobCondition.notify_all();
+    for (size_t i = 0; i < this->Threads.size(); ++i)
+    {
+      this->Threads[i].join();
+    }
+  }
+
+  int GetNumberOfThreads() const
+  {
+    return static_cast<int>(this->Queues.size());
+  }
+
+  // Execute a For() on the pool. Returns false, without executing anything,
+  // if the pool is already busy (nested or concurrent For() calls).
+  bool Run(vtkIdType first, vtkIdType last, vtkIdType grain,
+           vtk::detail::smp::ExecuteFunctorPtrType functorExecuter,
+           void *functor)
+  {
+    bool expected = false;
+    if (!this->Busy.compare_exchange_strong(expected, true))
+    {
+      return false;
+    }
+
+    vtkIdType numChunks = (last - first + grain - 1) / grain;
+    vtkIdType numQueues = static_cast<vtkIdType>(this->Queues.size());
+    for (vtkIdType i = 0; i < numQueues; ++i)
+    {
+      this->Queues[i].Begin = i * numChunks / numQueues;
+      this->Queues[i].End = (i + 1) * numChunks / numQueues;
+    }
+
+    {
+      std::lock_guard<std::mutex> guard(this->JobLock);
+      this->First = first;
+      this->Last = last;
+      this->Grain = grain;
+      this->Executer = functorExecuter;
+      this->Functor = functor;
+      this->Pending = static_cast<int>(this->Threads.size());
+      ++this->Generation;
+    }
+    this->JobCondition.notify_all();
+
+    this->Process(0);
+
+    {
+      std::unique_lock<std::mutex> guard(this->JobLock);
+      while (this->Pending > 0)
+      {
+        this->DoneCondition.wait(guard);
+      }
+    }
+    this->Busy.store(false);
+    return true;
+  }
+
+private:
+  void Process(int index)
+  {
+    vtkIdType numQueues = static_cast<vtkIdType>(this->Queues.size());
+    vtkIdType chunk;
+    for (;;)
+    {
+      bool found = this->Queues[index].Pop(chunk);
+      for (vtkIdType i = 1; !found && i < numQueues; ++i)
+      {
+        found = this->Queues[(index + i) % numQueues].Steal(chunk);
+      }
+      if (!found)
+      {
+        return;
+      }
+      this->Executer(this->Functor, this->First + chunk * this->Grain,
+                     this->Grain, this->Last);
+    }
+  }
+
+  void Work(int index)
+  {
+    unsigned long generation = 0;
+    for (;;)
+    {
+      {
+        std::unique_lock<std::mutex> guard(this->JobLock);
+        while (!this->Stop && this->Generation == generation)
+        {
+          this->JobCondition.wait(guard);
+        }
+        if (this->Stop)
+        {
+          return;
+        }
+        generation = this->Generation;
+      }
+
+      this->Process(index);
+
+      bool done;
+      {
+        std::lock_guard<std::mutex> guard(this->JobLock);
+        done = (--this->Pending == 0);
+      }
+      if (done)
+      {
+        this->DoneCondition.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> Threads;
+  std::vector<vtkSMPWorkQueue> Queues;
+
+  std::atomic<bool> Busy;
+  std::mutex JobLock;
+  std::condition_variable JobCondition;
+  std::condition_variable DoneCondition;
+  unsigned long Generation;
+  int Pending;
+  bool Stop;
+
+  // Current job.
+  vtkIdType First;
+  vtkIdType Last;
+  vtkIdType Grain;
+  vtk::detail::smp::ExecuteFunctorPtrType Executer;
+  void *Functor;
+};
+
+std::mutex vtkSMPThreadPoolLock;
+std::shared_ptr<vtkSMPThreadPool> vtkSMPThreadPoolInstance;
+
+//--------------------------------------------------------------------------------
+// Return the pool, creating it with the requested number of threads if
+// needed. Returns an empty pointer when only one thread is to be used.
+// A pool replaced after a change of the number of threads stays alive until
+// the callers still holding it are done with it.
+std::shared_ptr<vtkSMPThreadPool> vtkSMPGetThreadPool()
+{
+  std::lock_guard<std::mutex> guard(vtkSMPThreadPoolLock);
+  int numThreads = vtk::detail::smp::GetNumberOfThreads();
+  if (numThreads <= 1)
+  {
+    return std::shared_ptr<vtkSMPThreadPool>();
+  }
+  if (!vtkSMPThreadPoolInstance ||
+      vtkSMPThreadPoolInstance->GetNumberOfThreads() != numThreads)
+  {
+    vtkSMPThreadPoolInstance =
+      std::make_shared<vtkSMPThreadPool>(numThreads);
+  }
+  return vtkSMPThreadPoolInstance;
+}
+
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::Initialize(int numThreads)
+{
+  if (numThreads > 0)
+  {
+    vtkSMPNumberOfSpecifiedThreads.store(numThreads);
+  }
+}
+
+//--------------------------------------------------------------------------------
+int vtkSMPTools::GetEstimatedNumberOfThreads()
+{
+  return vtk::detail::smp::GetNumberOfThreads();
+}
+
+//--------------------------------------------------------------------------------
+int vtk::detail::smp::GetNumberOfThreads()
+{
+  int numSpecifiedThreads = vtkSMPNumberOfSpecifiedThreads.load();
+  if (numSpecifiedThreads > 0)
+  {
+    return numSpecifiedThreads;
+  }
+  int numThreads = static_cast<int>(std::thread::hardware_concurrency());
+  return numThreads > 0 ? numThreads : 1;
+}
+
+//--------------------------------------------------------------------------------
+void vtk::detail::smp::vtkSMPTools_Impl_For_STDThread(vtkIdType first,
+  vtkIdType last, vtkIdType grain, ExecuteFunctorPtrType functorExecuter,
+  void *functor)
+{
+  std::shared_ptr<vtkSMPThreadPool> pool = vtkSMPGetThreadPool();
+  if (grain <= 0)
+  {
+    int numThreads = pool ? pool->GetNumberOfThreads() : 1;
+    vtkIdType estimateGrain = (last - first) / (numThreads * 4);
+    grain = (estimateGrain > 0) ? estimateGrain : 1;
+  }
+
+  // Run sequentially when there is a single thread, or when the pool is
+  // busy, which happens for nested For() calls made from a worker thread.
+  if (!pool || !pool->Run(first, last, grain, functorExecuter, functor))
+  {
+    for (vtkIdType from = first; from < last; from += grain)
+    {
+      functorExecuter(functor, from, grain, last);
+    }
+  }
+}
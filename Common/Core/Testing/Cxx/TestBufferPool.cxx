@@ -0,0 +1,179 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBufferPool.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the recycling of array buffers by vtkBufferPool, its statistics and
+// its use by concurrent threads.
+
+#include "vtkBufferPool.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMultiThreader.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+
+namespace
+{
+
+// Allocate, fill, check and release arrays of various sizes.
+VTK_THREAD_RETURN_TYPE AllocateArrays(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  int *failed = static_cast<int*>(info->UserData);
+  for (int i = 0; i < 50; ++i)
+  {
+    vtkNew<vtkDoubleArray> array;
+    const vtkIdType numValues = 20000 + 1000 * ((i + info->ThreadID) % 7);
+    array->SetNumberOfValues(numValues);
+    for (vtkIdType v = 0; v < numValues; ++v)
+    {
+      array->SetValue(v, static_cast<double>(v + info->ThreadID));
+    }
+    for (vtkIdType v = 0; v < numValues; ++v)
+    {
+      if (array->GetValue(v) != static_cast<double>(v + info->ThreadID))
+      {
+        failed[info->ThreadID] = 1;
+      }
+    }
+  }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+}
+
+int TestBufferPool(int, char *[])
+{
+  vtkAbstractArray::SetUseBufferPool(true);
+  vtkBufferPool::ResetStatistics();
+  if (!vtkBufferPool::GetEnabled() ||
+      vtkBufferPool::GetNumberOfRetainedBuffers() != 0)
+  {
+    cerr << "Unexpected initial pool state." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // A released buffer is reused by the next array of a similar size.
+  void *pointer = NULL;
+  {
+    vtkNew<vtkFloatArray> array;
+    array->SetNumberOfComponents(3);
+    array->SetNumberOfTuples(100000);
+    pointer = array->GetVoidPointer(0);
+  }
+  if (vtkBufferPool::GetNumberOfMisses() != 1 ||
+      vtkBufferPool::GetNumberOfRetainedBuffers() != 1 ||
+      vtkBufferPool::GetRetainedBytes() < 300000 * sizeof(float))
+  {
+    cerr << "Buffer was not retained." << endl;
+    return EXIT_FAILURE;
+  }
+#if defined(__unix__) || defined(__APPLE__)
+  if (reinterpret_cast<size_t>(pointer) % 4096 != 0)
+  {
+    cerr << "Buffer is not page aligned." << endl;
+    return EXIT_FAILURE;
+  }
+#endif
+
+  vtkNew<vtkIntArray> ints;
+  ints->SetNumberOfValues(299000);
+  if (ints->GetVoidPointer(0) != pointer ||
+      vtkBufferPool::GetNumberOfHits() != 1 ||
+      vtkBufferPool::GetNumberOfRetainedBuffers() != 0 ||
+      vtkBufferPool::GetRetainedBytes() != 0)
+  {
+    cerr << "Buffer was not recycled." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Reallocating within the size class does not move the buffer.
+  for (int i = 0; i < 299000; ++i)
+  {
+    ints->SetValue(i, i);
+  }
+  ints->Resize(298000);
+  if (ints->GetVoidPointer(0) != pointer || ints->GetValue(297999) != 297999)
+  {
+    cerr << "Buffer was moved." << endl;
+    return EXIT_FAILURE;
+  }
+  // Growing further moves it, with its values.
+  ints->Resize(1000000);
+  if (ints->GetValue(0) != 0 || ints->GetValue(297999) != 297999 ||
+      vtkBufferPool::GetNumberOfRetainedBuffers() != 1)
+  {
+    cerr << "Buffer was not reallocated." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Struct-of-arrays buffers are pooled too; small buffers are not.
+  vtkBufferPool::ReleaseRetainedBuffers();
+  vtkBufferPool::ResetStatistics();
+  {
+    vtkNew<vtkSOADataArrayTemplate<float> > soa;
+    soa->SetNumberOfComponents(3);
+    soa->SetNumberOfTuples(100000);
+    vtkNew<vtkFloatArray> small;
+    small->SetNumberOfValues(100);
+  }
+  if (vtkBufferPool::GetNumberOfMisses() != 3 ||
+      vtkBufferPool::GetNumberOfRetainedBuffers() != 3)
+  {
+    cerr << "Unexpected statistics " << vtkBufferPool::GetNumberOfHits()
+         << " " << vtkBufferPool::GetNumberOfMisses() << " "
+         << vtkBufferPool::GetNumberOfRetainedBuffers() << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Buffers are freed beyond the retention limit.
+  vtkBufferPool::ReleaseRetainedBuffers();
+  vtkBufferPool::SetMaximumRetainedBytes(100000);
+  {
+    vtkNew<vtkDoubleArray> array;
+    array->SetNumberOfValues(100000);
+  }
+  if (vtkBufferPool::GetNumberOfRetainedBuffers() != 0)
+  {
+    cerr << "Retention limit was ignored." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkBufferPool::SetMaximumRetainedBytes(static_cast<vtkTypeUInt64>(1) << 30);
+
+  // Concurrent allocations.
+  vtkNew<vtkMultiThreader> threader;
+  threader->SetNumberOfThreads(4);
+  int failed[4] = { 0, 0, 0, 0 };
+  threader->SetSingleMethod(AllocateArrays, failed);
+  threader->SingleMethodExecute();
+  if (failed[0] || failed[1] || failed[2] || failed[3])
+  {
+    cerr << "Wrong values with concurrent allocations." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Disabling the pool releases the buffers, and arrays allocated from the
+  // pool can still be released.
+  vtkAbstractArray::SetUseBufferPool(false);
+  ints->Initialize();
+  if (vtkBufferPool::GetNumberOfRetainedBuffers() != 0 ||
+      vtkBufferPool::GetRetainedBytes() != 0)
+  {
+    cerr << "Buffers were retained after disabling the pool." << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayComputeRange.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the (possibly multithreaded) range computation of large arrays
+// against a straightforward serial traversal.
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+
+// Serial reference: range of one component, or of the tuple norms when comp
+// is -1, skipping NaNs and optionally infinite values.
+void ReferenceRange(vtkDataArray *array, int comp, bool finite,
+                    double range[2])
+{
+  range[0] = VTK_DOUBLE_MAX;
+  range[1] = VTK_DOUBLE_MIN;
+  const int numComps = array->GetNumberOfComponents();
+  if (numComps == 1)
+  {
+    comp = 0;
+  }
+  for (vtkIdType t = 0; t < array->GetNumberOfTuples(); ++t)
+  {
+    double value = 0.0;
+    if (comp < 0)
+    {
+      for (int c = 0; c < numComps; ++c)
+      {
+        double v = array->GetComponent(t, c);
+        value += v * v;
+      }
+    }
+    else
+    {
+      value = array->GetComponent(t, comp);
+    }
+    if (vtkMath::IsNan(value) || (finite && vtkMath::IsInf(value)))
+    {
+      continue;
+    }
+    range[0] = std::min(range[0], value);
+    range[1] = std::max(range[1], value);
+  }
+  if (comp < 0)
+  {
+    range[0] = std::sqrt(range[0]);
+    range[1] = std::sqrt(range[1]);
+  }
+}
+
+bool CheckRanges(vtkDataArray *array, const char *label)
+{
+  for (int comp = -1; comp < array->GetNumberOfComponents(); ++comp)
+  {
+    double expected[2], range[2], finiteExpected[2], finiteRange[2];
+    ReferenceRange(array, comp, false, expected);
+    ReferenceRange(array, comp, true, finiteExpected);
+    array->Modified();
+    array->GetRange(range, comp);
+    array->GetFiniteRange(finiteRange, comp);
+    if (range[0] != expected[0] || range[1] != expected[1] ||
+        finiteRange[0] != finiteExpected[0] ||
+        finiteRange[1] != finiteExpected[1])
+    {
+      cerr << label << ": wrong range for component " << comp << ": ["
+           << range[0] << ", " << range[1] << "] / ["
+           << finiteRange[0] << ", " << finiteRange[1] << "], expected ["
+           << expected[0] << ", " << expected[1] << "] / ["
+           << finiteExpected[0] << ", " << finiteExpected[1] << "]" << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class ArrayT>
+void FillArray(ArrayT *array, int numComps, vtkIdType numTuples,
+               bool special)
+{
+  typedef typename ArrayT::ValueType ValueType;
+  array->SetNumberOfComponents(numComps);
+  array->SetNumberOfTuples(numTuples);
+  for (vtkIdType t = 0; t < numTuples; ++t)
+  {
+    for (int c = 0; c < numComps; ++c)
+    {
+      // Deterministic values with extrema in the middle of the array.
+      vtkIdType v = (t * 7919 + c * 104729) % 200003 - 100000;
+      array->SetTypedComponent(t, c, static_cast<ValueType>(v) /
+                               static_cast<ValueType>(c + 1));
+    }
+  }
+  if (special && std::numeric_limits<ValueType>::has_infinity)
+  {
+    array->SetTypedComponent(numTuples / 3, 0,
+                             std::numeric_limits<ValueType>::infinity());
+    array->SetTypedComponent(numTuples / 2, numComps - 1,
+                             -std::numeric_limits<ValueType>::infinity());
+    array->SetTypedComponent(numTuples - 1, 0,
+                             std::numeric_limits<ValueType>::quiet_NaN());
+    array->SetTypedComponent(0, numComps - 1,
+                             std::numeric_limits<ValueType>::quiet_NaN());
+  }
+}
+
+}
+
+int TestDataArrayComputeRange(int, char *[])
+{
+  const vtkIdType numTuples = 300007;
+  const int comps[] = { 1, 3, 10 };
+  for (int i = 0; i < 3; ++i)
+  {
+    vtkNew<vtkFloatArray> floats;
+    FillArray(floats.GetPointer(), comps[i], numTuples, true);
+    vtkNew<vtkDoubleArray> doubles;
+    FillArray(doubles.GetPointer(), comps[i], numTuples, true);
+    vtkNew<vtkIntArray> ints;
+    FillArray(ints.GetPointer(), comps[i], numTuples, false);
+    vtkNew<vtkSOADataArrayTemplate<double> > soa;
+    FillArray(soa.GetPointer(), comps[i], numTuples, true);
+    if (!CheckRanges(floats.GetPointer(), "float") ||
+        !CheckRanges(doubles.GetPointer(), "double") ||
+        !CheckRanges(ints.GetPointer(), "int") ||
+        !CheckRanges(soa.GetPointer(), "soa"))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Small arrays are processed serially.
+  vtkNew<vtkFloatArray> small;
+  FillArray(small.GetPointer(), 3, 5, true);
+  if (!CheckRanges(small.GetPointer(), "small"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,339 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImplicitArrays.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the values, ranges, copies and dispatch of the implicit constant,
+// affine and composite arrays.
+
+#include "vtkAffineArray.h"
+#include "vtkArrayDispatch.h"
+#include "vtkCompositeArray.h"
+#include "vtkConstantArray.h"
+#include "vtkDataArrayAccessor.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+
+namespace
+{
+
+// Sums all the values of an array.
+struct SumWorker
+{
+  double Sum;
+  SumWorker() : Sum(0.0) {}
+
+  template <class ArrayT>
+  void operator()(ArrayT *array)
+  {
+    vtkDataArrayAccessor<ArrayT> access(array);
+    for (vtkIdType t = 0; t < array->GetNumberOfTuples(); ++t)
+    {
+      for (int c = 0; c < array->GetNumberOfComponents(); ++c)
+      {
+        this->Sum += static_cast<double>(access.Get(t, c));
+      }
+    }
+  }
+};
+
+// Compare the values of an array with the generic API of a reference array.
+bool CheckValues(vtkDataArray *array, vtkDataArray *expected,
+                 const char *label)
+{
+  if (array->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+      array->GetNumberOfComponents() != expected->GetNumberOfComponents())
+  {
+    cerr << label << ": wrong dimensions " << array->GetNumberOfTuples()
+         << "x" << array->GetNumberOfComponents() << endl;
+    return false;
+  }
+  for (vtkIdType t = 0; t < array->GetNumberOfTuples(); ++t)
+  {
+    for (int c = 0; c < array->GetNumberOfComponents(); ++c)
+    {
+      if (array->GetComponent(t, c) != expected->GetComponent(t, c))
+      {
+        cerr << label << ": wrong value " << array->GetComponent(t, c)
+             << " for component " << c << " of tuple " << t << ", expected "
+             << expected->GetComponent(t, c) << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool TestConstant()
+{
+  vtkNew<vtkConstantArray<float> > constant;
+  constant->SetNumberOfComponents(3);
+  constant->SetNumberOfTuples(1000);
+  const float tuple[3] = { 1.f, -2.f, 3.f };
+  constant->SetConstantTuple(tuple);
+
+  vtkNew<vtkFloatArray> expected;
+  expected->SetNumberOfComponents(3);
+  expected->SetNumberOfTuples(1000);
+  for (vtkIdType t = 0; t < 1000; ++t)
+  {
+    expected->SetTypedTuple(t, tuple);
+  }
+  if (!CheckValues(constant.GetPointer(), expected.GetPointer(), "constant"))
+  {
+    return false;
+  }
+
+  double range[2];
+  constant->GetRange(range, 1);
+  if (range[0] != -2.0 || range[1] != -2.0)
+  {
+    cerr << "Wrong constant range [" << range[0] << ", " << range[1] << "]"
+         << endl;
+    return false;
+  }
+
+  // No storage: the size does not depend on the number of tuples.
+  if (constant->GetActualMemorySize() > 1)
+  {
+    cerr << "Constant array uses " << constant->GetActualMemorySize()
+         << " kB." << endl;
+    return false;
+  }
+
+  // Writing is an error and does not change the values.
+  vtkObject::GlobalWarningDisplayOff();
+  constant->SetTypedComponent(0, 0, 5.f);
+  vtkObject::GlobalWarningDisplayOn();
+  if (constant->GetTypedComponent(0, 0) != 1.f)
+  {
+    cerr << "Read only array was modified." << endl;
+    return false;
+  }
+
+  // Copying into a regular array does not allocate the implicit values.
+  vtkNew<vtkFloatArray> copy;
+  copy->DeepCopy(constant.GetPointer());
+  if (!CheckValues(copy.GetPointer(), expected.GetPointer(), "copy") ||
+      constant->GetActualMemorySize() > 1)
+  {
+    cerr << "Deep copy failed." << endl;
+    return false;
+  }
+
+  // NewInstance(), as called by filters, creates a writable array.
+  vtkDataArray *base = constant.GetPointer();
+  vtkSmartPointer<vtkDataArray> instance;
+  instance.TakeReference(base->NewInstance());
+  if (!vtkArrayDownCast<vtkFloatArray>(instance))
+  {
+    cerr << "NewInstance() returned a " << instance->GetClassName() << endl;
+    return false;
+  }
+
+  // Legacy raw pointer access materializes the values, and refreshes them.
+  float *values = static_cast<float*>(constant->GetVoidPointer(0));
+  if (values[3 * 999 + 2] != 3.f || constant->GetActualMemorySize() < 11)
+  {
+    cerr << "Values were not materialized." << endl;
+    return false;
+  }
+  constant->SetConstantValue(7.f);
+  values = static_cast<float*>(constant->GetVoidPointer(0));
+  if (values[0] != 7.f || values[3 * 999 + 2] != 7.f)
+  {
+    cerr << "Materialized values were not refreshed." << endl;
+    return false;
+  }
+
+  // Copying between implicit arrays copies the parameters.
+  vtkNew<vtkConstantArray<float> > constantCopy;
+  constantCopy->DeepCopy(constant.GetPointer());
+  if (constantCopy->GetNumberOfTuples() != 1000 ||
+      constantCopy->GetConstantValue(2) != 7.f)
+  {
+    cerr << "Implicit copy failed." << endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestAffine()
+{
+  vtkNew<vtkAffineArray<double> > affine;
+  affine->SetNumberOfComponents(2);
+  affine->SetNumberOfTuples(101);
+  affine->SetOffset(0, 10.0);
+  affine->SetSlope(0, 0.5);
+  affine->SetOffset(1, 3.0);
+  affine->SetSlope(1, -1.0);
+
+  vtkNew<vtkDoubleArray> expected;
+  expected->SetNumberOfComponents(2);
+  expected->SetNumberOfTuples(101);
+  for (vtkIdType t = 0; t < 101; ++t)
+  {
+    expected->SetTypedComponent(t, 0, 10.0 + 0.5 * t);
+    expected->SetTypedComponent(t, 1, 3.0 - t);
+  }
+  if (!CheckValues(affine.GetPointer(), expected.GetPointer(), "affine"))
+  {
+    return false;
+  }
+
+  double range[2];
+  affine->GetRange(range, 1);
+  if (range[0] != -97.0 || range[1] != 3.0)
+  {
+    cerr << "Wrong affine range [" << range[0] << ", " << range[1] << "]"
+         << endl;
+    return false;
+  }
+
+  // Ids, with the conversion of the value type.
+  vtkNew<vtkAffineArray<vtkIdType> > ids;
+  ids->SetNumberOfTuples(50);
+  ids->SetSlope(1.0);
+  for (vtkIdType i = 0; i < 50; ++i)
+  {
+    if (ids->GetValue(i) != i)
+    {
+      cerr << "Wrong id " << ids->GetValue(i) << " at " << i << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestComposite()
+{
+  vtkNew<vtkFloatArray> floats;
+  floats->SetNumberOfComponents(2);
+  vtkNew<vtkIntArray> ints;
+  ints->SetNumberOfComponents(2);
+  vtkNew<vtkFloatArray> empty;
+  empty->SetNumberOfComponents(2);
+  vtkNew<vtkFloatArray> expected;
+  expected->SetNumberOfComponents(2);
+  for (int i = 0; i < 10; ++i)
+  {
+    floats->InsertNextTuple2(i, -i);
+    expected->InsertNextTuple2(i, -i);
+  }
+  for (int i = 0; i < 7; ++i)
+  {
+    ints->InsertNextTuple2(100 + i, 200 + i);
+  }
+
+  vtkNew<vtkCompositeArray<float> > composite;
+  composite->AddArray(floats.GetPointer());
+  composite->AddArray(empty.GetPointer());
+  composite->AddArray(ints.GetPointer());
+  composite->AddArray(floats.GetPointer());
+  for (int i = 0; i < 7; ++i)
+  {
+    expected->InsertNextTuple2(100 + i, 200 + i);
+  }
+  for (int i = 0; i < 10; ++i)
+  {
+    expected->InsertNextTuple2(i, -i);
+  }
+  if (composite->GetNumberOfArrays() != 4 ||
+      !CheckValues(composite.GetPointer(), expected.GetPointer(), "composite"))
+  {
+    return false;
+  }
+
+  // Arrays with another number of components are rejected.
+  vtkNew<vtkFloatArray> scalars;
+  vtkObject::GlobalWarningDisplayOff();
+  composite->AddArray(scalars.GetPointer());
+  vtkObject::GlobalWarningDisplayOn();
+  if (composite->GetNumberOfArrays() != 4)
+  {
+    cerr << "Array with a wrong number of components was added." << endl;
+    return false;
+  }
+
+  // Changes of the sub-arrays are visible, also through the materialized
+  // values.
+  float *values = static_cast<float*>(composite->GetVoidPointer(0));
+  if (values[1] != 0.f)
+  {
+    cerr << "Wrong materialized value " << values[1] << endl;
+    return false;
+  }
+  floats->SetTypedComponent(0, 1, 42.f);
+  floats->Modified();
+  values = static_cast<float*>(composite->GetVoidPointer(0));
+  if (composite->GetTypedComponent(0, 1) != 42.f ||
+      composite->GetTypedComponent(17, 1) != 42.f || values[1] != 42.f)
+  {
+    cerr << "Sub-array modification not visible." << endl;
+    return false;
+  }
+
+  composite->RemoveAllArrays();
+  if (composite->GetNumberOfTuples() != 0)
+  {
+    cerr << "Composite array was not emptied." << endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestDispatch()
+{
+  typedef vtkTypeList_Create_3(vtkConstantArray<int>, vtkAffineArray<int>,
+                               vtkCompositeArray<int>) Arrays;
+  typedef vtkArrayDispatch::DispatchByArray<Arrays> Dispatcher;
+
+  vtkNew<vtkConstantArray<int> > constant;
+  constant->SetNumberOfTuples(10);
+  constant->SetConstantValue(3);
+  vtkNew<vtkAffineArray<int> > affine;
+  affine->SetNumberOfTuples(10);
+  affine->SetSlope(1.0);
+  vtkNew<vtkCompositeArray<int> > composite;
+  composite->AddArray(constant.GetPointer());
+  composite->AddArray(affine.GetPointer());
+
+  vtkDataArray *arrays[3] = { constant.GetPointer(), affine.GetPointer(),
+                              composite.GetPointer() };
+  const double sums[3] = { 30.0, 45.0, 75.0 };
+  for (int i = 0; i < 3; ++i)
+  {
+    SumWorker worker;
+    if (!Dispatcher::Execute(arrays[i], worker) || worker.Sum != sums[i])
+    {
+      cerr << "Dispatch failed for " << arrays[i]->GetClassName() << ": "
+           << worker.Sum << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+int TestImplicitArrays(int, char *[])
+{
+  if (!TestConstant() || !TestAffine() || !TestComposite() ||
+      !TestDispatch())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
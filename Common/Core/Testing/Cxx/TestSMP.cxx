@@ -94,6 +94,111 @@ public:
 // For sorting comparison
 bool myComp (double a, double b) { return (a<b); }
 
+// Associative but not commutative: checks that the order of the elements is
+// preserved by Reduce() and the scans.
+vtkIdType keepLast (vtkIdType, vtkIdType b) { return b; }
+
+vtkIdType twice (vtkIdType a) { return 2 * a; }
+
+// Test the parallel algorithms on n values. Large values of n make sure that
+// the ranges are split in several blocks.
+static bool TestAlgorithms(vtkIdType n)
+{
+  std::vector<vtkIdType> counts(n);
+  vtkSMPTools::Fill(counts.begin(), counts.end(), 3);
+  std::vector<vtkIdType> values(n);
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    if (counts[i] != 3)
+    {
+      cerr << "Error: Bad fill!" << endl;
+      return false;
+    }
+    values[i] = i % 7;
+  }
+
+  std::vector<vtkIdType> out(n);
+  vtkSMPTools::Transform(values.begin(), values.end(), out.begin(), twice);
+  vtkSMPTools::Transform(out.begin(), out.end(), values.begin(), out.begin(),
+                         std::minus<vtkIdType>());
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    if (out[i] != values[i])
+    {
+      cerr << "Error: Bad transform!" << endl;
+      return false;
+    }
+  }
+
+  vtkIdType sum = 0;
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    sum += values[i];
+  }
+  if (vtkSMPTools::Reduce(values.begin(), values.end(),
+                          static_cast<vtkIdType>(5)) != sum + 5 ||
+      vtkSMPTools::Reduce(values.begin(), values.end(),
+                          static_cast<vtkIdType>(-1), keepLast) !=
+        (n > 0 ? values[n - 1] : -1))
+  {
+    cerr << "Error: Bad reduce!" << endl;
+    return false;
+  }
+
+  vtkSMPTools::InclusiveScan(values.begin(), values.end(), out.begin());
+  vtkIdType running = 0;
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    running += values[i];
+    if (out[i] != running)
+    {
+      cerr << "Error: Bad inclusive scan!" << endl;
+      return false;
+    }
+  }
+  vtkSMPTools::InclusiveScan(values.begin(), values.end(), out.begin(),
+                             keepLast);
+  if (out != values)
+  {
+    cerr << "Error: Bad inclusive scan order!" << endl;
+    return false;
+  }
+
+  // In place, as used to turn counts into offsets.
+  vtkIdType total = vtkSMPTools::ExclusiveScan(
+    counts.begin(), counts.end(), counts.begin(), static_cast<vtkIdType>(10));
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    if (counts[i] != 10 + 3 * i)
+    {
+      cerr << "Error: Bad exclusive scan!" << endl;
+      return false;
+    }
+  }
+  if (total != 10 + 3 * n)
+  {
+    cerr << "Error: Bad exclusive scan total!" << endl;
+    return false;
+  }
+  total = vtkSMPTools::ExclusiveScan(values.begin(), values.end(),
+    out.begin(), static_cast<vtkIdType>(-1), keepLast);
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    if (out[i] != (i > 0 ? values[i - 1] : -1))
+    {
+      cerr << "Error: Bad exclusive scan order!" << endl;
+      return false;
+    }
+  }
+  if (total != (n > 0 ? values[n - 1] : -1))
+  {
+    cerr << "Error: Bad exclusive scan order total!" << endl;
+    return false;
+  }
+
+  return true;
+}
+
 int TestSMP(int, char*[])
 {
   //vtkSMPTools::Initialize(8);
@@ -167,5 +272,11 @@ int TestSMP(int, char*[])
     }
   }
 
+  // Test the parallel algorithms
+  if (!TestAlgorithms(0) || !TestAlgorithms(11) || !TestAlgorithms(100003))
+  {
+    return 1;
+  }
+
   return 0;
 }
@@ -52,7 +52,8 @@ public:
   {
     VTK_DATA_ARRAY_FREE=vtkAbstractArray::VTK_DATA_ARRAY_FREE,
     VTK_DATA_ARRAY_DELETE=vtkAbstractArray::VTK_DATA_ARRAY_DELETE,
-    VTK_DATA_ARRAY_ALIGNED_FREE=vtkAbstractArray::VTK_DATA_ARRAY_ALIGNED_FREE
+    VTK_DATA_ARRAY_ALIGNED_FREE=vtkAbstractArray::VTK_DATA_ARRAY_ALIGNED_FREE,
+    VTK_DATA_ARRAY_UNMAP=vtkAbstractArray::VTK_DATA_ARRAY_UNMAP
   };
 
   static vtkAOSDataArrayTemplate* New();
@@ -166,7 +167,9 @@ public:
    * VTK_DATA_ARRAY_FREE, free() will be used. If the delete method is
    * VTK_DATA_ARRAY_DELETE, delete[] will be used. If the delete method is
    * VTK_DATA_ARRAY_ALIGNED_FREE _aligned_free() will be used on windows, while
-   * free() will be used everywhere else. The default is FREE.
+   * free() will be used everywhere else. If the delete method is
+   * VTK_DATA_ARRAY_UNMAP, the array must come from vtkMemoryMappedFile::Map()
+   * and will be unmapped. The default is FREE.
    */
   void SetArray(ValueType* array, vtkIdType size, int save, int deleteMethod);
   void SetArray(ValueType* array, vtkIdType size, int save);
@@ -175,6 +178,21 @@ public:
                     int deleteMethod) VTK_OVERRIDE;
   //@}
 
+  /**
+   * Use @a numValues values stored at byte @a offset of the raw file
+   * @a fileName as the contents of the array, without reading them: the
+   * region is mapped in memory with vtkMemoryMappedFile and the pages are
+   * loaded on demand. The values must be stored in the native byte order,
+   * and the number of components must be set first. The mapping is
+   * copy-on-write: the values can be modified in memory like those of any
+   * other array, without changing the file. Resizing the array copies it to
+   * the heap. The offset must be a multiple of the size of the values.
+   * Returns false if the region cannot be mapped, in which
+   * case the array is left unchanged.
+   */
+  bool MapFile(const char *fileName, vtkTypeUInt64 offset,
+               vtkIdType numValues);
+
   // Overridden for optimized implementations:
   void SetTuple(vtkIdType tupleIdx, const float *tuple) VTK_OVERRIDE;
   void SetTuple(vtkIdType tupleIdx, const double *tuple) VTK_OVERRIDE;
@@ -18,6 +18,7 @@
 #include "vtkAOSDataArrayTemplate.h"
 
 #include "vtkArrayIteratorTemplate.h"
+#include "vtkMemoryMappedFile.h"
 
 //-----------------------------------------------------------------------------
 template <class ValueTypeT>
@@ -58,6 +59,11 @@ void vtkAOSDataArrayTemplate<ValueTypeT>
     this->Buffer->SetBuffer(array, size, save != 0, free);
 #endif
   }
+  else if(deleteMethod == VTK_DATA_ARRAY_UNMAP)
+  {
+    this->Buffer->SetBuffer(array, size, save != 0,
+                            vtkMemoryMappedFile::Unmap);
+  }
   else
   {
     this->Buffer->SetBuffer(array, size, save != 0, free);
@@ -76,6 +82,36 @@ void vtkAOSDataArrayTemplate<ValueTypeT>
   this->SetArray(array, size, save, VTK_DATA_ARRAY_FREE);
 }
 
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+bool vtkAOSDataArrayTemplate<ValueTypeT>
+::MapFile(const char *fileName, vtkTypeUInt64 offset, vtkIdType numValues)
+{
+  if (numValues <= 0 || numValues % this->NumberOfComponents != 0)
+  {
+    vtkErrorMacro("Cannot map " << numValues << " values in an array with "
+                  << this->NumberOfComponents << " components.");
+    return false;
+  }
+  if (offset % sizeof(ValueType) != 0)
+  {
+    vtkErrorMacro("Offset " << offset << " is not aligned on the size of "
+                  "the values.");
+    return false;
+  }
+  void *array = vtkMemoryMappedFile::Map(
+    fileName, offset,
+    static_cast<vtkTypeUInt64>(numValues) * sizeof(ValueType),
+    vtkMemoryMappedFile::COPY_ON_WRITE);
+  if (!array)
+  {
+    return false;
+  }
+  this->SetArray(static_cast<ValueType*>(array), numValues, 0,
+                 VTK_DATA_ARRAY_UNMAP);
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>
@@ -15,6 +15,7 @@
 #include "vtkAbstractArray.h"
 
 #include "vtkBitArray.h"
+#include "vtkBufferPool.h"
 #include "vtkCharArray.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
@@ -349,6 +350,18 @@ int vtkAbstractArray::GetDataTypeSize(int type)
   return 1;
 }
 
+// ----------------------------------------------------------------------
+void vtkAbstractArray::SetUseBufferPool(bool use)
+{
+  vtkBufferPool::SetEnabled(use);
+}
+
+// ----------------------------------------------------------------------
+bool vtkAbstractArray::GetUseBufferPool()
+{
+  return vtkBufferPool::GetEnabled();
+}
+
 // ----------------------------------------------------------------------
 vtkAbstractArray* vtkAbstractArray::CreateArray(int dataType)
 {
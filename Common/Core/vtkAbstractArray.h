@@ -331,7 +331,8 @@ public:
   {
     VTK_DATA_ARRAY_FREE,
     VTK_DATA_ARRAY_DELETE,
-    VTK_DATA_ARRAY_ALIGNED_FREE
+    VTK_DATA_ARRAY_ALIGNED_FREE,
+    VTK_DATA_ARRAY_UNMAP
   };
 
   //@{
@@ -346,7 +347,9 @@ public:
    * will be used. If the delete method is VTK_DATA_ARRAY_DELETE, delete[]
    * will be used. If the delete method is VTK_DATA_ARRAY_ALIGNED_FREE
    * _aligned_free() will be used on windows, while free() will be used
-   * everywhere else.The default is FREE.
+   * everywhere else. If the delete method is VTK_DATA_ARRAY_UNMAP, the
+   * array must have been returned by vtkMemoryMappedFile::Map() and will be
+   * unmapped. The default is FREE.
    * (Note not all subclasses can support deleteMethod.)
    */
   virtual void SetVoidArray(void *vtkNotUsed(array),
@@ -400,6 +403,16 @@ public:
   VTK_NEWINSTANCE
   static vtkAbstractArray* CreateArray(int dataType);
 
+  //@{
+  /**
+   * Enable or disable the recycling of the buffers of large arrays through
+   * vtkBufferPool, for all the arrays. This is a convenience for
+   * vtkBufferPool::SetEnabled(). Default is off.
+   */
+  static void SetUseBufferPool(bool use);
+  static bool GetUseBufferPool();
+  //@}
+
   /**
    * This method is here to make backward compatibility easier.  It
    * must return true if and only if an array contains numeric data.
@@ -611,6 +624,7 @@ public:
     SoADataArrayTemplate,
     TypedDataArray,
     MappedDataArray,
+    ImplicitArray,
 
     DataArrayTemplate = AoSDataArrayTemplate //! Legacy
   };
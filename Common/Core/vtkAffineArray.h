@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAffineArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkAffineArray
+ * @brief   Implicit array whose values are an affine function of the tuple
+ * index.
+ *
+ *
+ * Component c of tuple t of a vtkAffineArray is Offset[c] + Slope[c] * t,
+ * computed in double precision and cast to the value type. It represents
+ * ids (offset 0, slope 1), regular coordinates (offset origin, slope
+ * spacing) or the offsets of a cell array of fixed-size cells without
+ * storing them:
+ * \code
+ * vtkNew<vtkAffineArray<vtkIdType> > ids;
+ * ids->SetNumberOfTuples(numPoints);
+ * ids->SetSlope(1.0);
+ * \endcode
+ *
+ * @sa
+ * vtkImplicitArray vtkConstantArray
+*/
+
+#ifndef vtkAffineArray_h
+#define vtkAffineArray_h
+
+#include "vtkImplicitArray.h" // Parent
+
+#include <vector> // For the parameters
+
+template <class ValueTypeT>
+class vtkAffineArray
+    : public vtkImplicitArray<vtkAffineArray<ValueTypeT>, ValueTypeT>
+{
+  typedef vtkImplicitArray<vtkAffineArray<ValueTypeT>, ValueTypeT>
+    ImplicitArrayType;
+public:
+  typedef vtkAffineArray<ValueTypeT> SelfType;
+  vtkAbstractTemplateTypeMacro(SelfType, ImplicitArrayType)
+  vtkAOSArrayNewInstanceMacro(SelfType)
+  static vtkAffineArray* New();
+  void PrintSelf(ostream &os, vtkIndent indent) VTK_OVERRIDE;
+
+  typedef typename Superclass::ValueType ValueType;
+
+  /**
+   * Get the value at @a valueIdx. @a valueIdx assumes AOS ordering.
+   */
+  ValueType GetValue(vtkIdType valueIdx) const
+  {
+    if (this->NumberOfComponents == 1)
+    {
+      return static_cast<ValueType>(
+        this->Offset[0] + this->Slope[0] * static_cast<double>(valueIdx));
+    }
+    const vtkIdType tupleIdx = valueIdx / this->NumberOfComponents;
+    const int compIdx =
+      static_cast<int>(valueIdx - tupleIdx * this->NumberOfComponents);
+    return static_cast<ValueType>(this->Offset[compIdx] +
+      this->Slope[compIdx] * static_cast<double>(tupleIdx));
+  }
+
+  //@{
+  /**
+   * Set/Get the value of component @a compIdx of the first tuple. The
+   * one-argument setter sets all the components.
+   */
+  void SetOffset(int compIdx, double offset);
+  void SetOffset(double offset);
+  double GetOffset(int compIdx = 0) const { return this->Offset[compIdx]; }
+  //@}
+
+  //@{
+  /**
+   * Set/Get the increment of component @a compIdx between two consecutive
+   * tuples. The one-argument setter sets all the components.
+   */
+  void SetSlope(int compIdx, double slope);
+  void SetSlope(double slope);
+  double GetSlope(int compIdx = 0) const { return this->Slope[compIdx]; }
+  //@}
+
+  /**
+   * Set the number of components, which resets the offsets and slopes to
+   * zero when changed.
+   */
+  void SetNumberOfComponents(int numComps) VTK_OVERRIDE;
+
+protected:
+  vtkAffineArray();
+  ~vtkAffineArray() VTK_OVERRIDE;
+
+  // The range is given by the first and last tuples.
+  bool ComputeScalarRange(double *ranges) VTK_OVERRIDE;
+
+  void CopyParameters(SelfType *other) VTK_OVERRIDE;
+  size_t GetParametersSize() VTK_OVERRIDE;
+
+  std::vector<double> Offset;
+  std::vector<double> Slope;
+
+private:
+  vtkAffineArray(const vtkAffineArray&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkAffineArray&) VTK_DELETE_FUNCTION;
+};
+
+#include "vtkAffineArray.txx"
+
+#endif
+// VTK-HeaderTest-Exclude: vtkAffineArray.h
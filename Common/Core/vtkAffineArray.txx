@@ -0,0 +1,172 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAffineArray.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkAffineArray_txx
+#define vtkAffineArray_txx
+
+#include "vtkAffineArray.h"
+
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkAffineArray<ValueTypeT> *vtkAffineArray<ValueTypeT>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkAffineArray<ValueTypeT>)
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkAffineArray<ValueTypeT>::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Offset:";
+  for (size_t c = 0; c < this->Offset.size(); ++c)
+  {
+    os << " " << this->Offset[c];
+  }
+  os << "\n";
+  os << indent << "Slope:";
+  for (size_t c = 0; c < this->Slope.size(); ++c)
+  {
+    os << " " << this->Slope[c];
+  }
+  os << "\n";
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkAffineArray<ValueTypeT>::SetOffset(int compIdx, double offset)
+{
+  if (compIdx < 0 || compIdx >= this->NumberOfComponents)
+  {
+    vtkErrorMacro("Invalid component index " << compIdx << ".");
+    return;
+  }
+  this->Offset[compIdx] = offset;
+  this->DataChanged();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkAffineArray<ValueTypeT>::SetOffset(double offset)
+{
+  std::fill(this->Offset.begin(), this->Offset.end(), offset);
+  this->DataChanged();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkAffineArray<ValueTypeT>::SetSlope(int compIdx, double slope)
+{
+  if (compIdx < 0 || compIdx >= this->NumberOfComponents)
+  {
+    vtkErrorMacro("Invalid component index " << compIdx << ".");
+    return;
+  }
+  this->Slope[compIdx] = slope;
+  this->DataChanged();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkAffineArray<ValueTypeT>::SetSlope(double slope)
+{
+  std::fill(this->Slope.begin(), this->Slope.end(), slope);
+  this->DataChanged();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkAffineArray<ValueTypeT>::SetNumberOfComponents(int numComps)
+{
+  this->Superclass::SetNumberOfComponents(numComps);
+  if (static_cast<int>(this->Offset.size()) != this->NumberOfComponents)
+  {
+    this->Offset.assign(this->NumberOfComponents, 0.0);
+    this->Slope.assign(this->NumberOfComponents, 0.0);
+    this->DataChanged();
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkAffineArray<ValueTypeT>::vtkAffineArray()
+  : Offset(1, 0.0), Slope(1, 0.0)
+{
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkAffineArray<ValueTypeT>::~vtkAffineArray()
+{
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+bool vtkAffineArray<ValueTypeT>::ComputeScalarRange(double *ranges)
+{
+  const vtkIdType numTuples = this->GetNumberOfTuples();
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+  {
+    if (!vtkMath::IsFinite(this->Offset[c]) ||
+        !vtkMath::IsFinite(this->Slope[c]))
+    {
+      return this->Superclass::ComputeScalarRange(ranges);
+    }
+  }
+  if (numTuples == 0)
+  {
+    return this->Superclass::ComputeScalarRange(ranges);
+  }
+  // The values are monotonic, so the extrema are at the ends (after the
+  // cast to the value type, which is monotonic too).
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+  {
+    const double first =
+      static_cast<double>(this->GetTypedComponent(0, c));
+    const double last =
+      static_cast<double>(this->GetTypedComponent(numTuples - 1, c));
+    ranges[2 * c] = std::min(first, last);
+    ranges[2 * c + 1] = std::max(first, last);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkAffineArray<ValueTypeT>::CopyParameters(SelfType *other)
+{
+  this->Offset = other->Offset;
+  this->Slope = other->Slope;
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+size_t vtkAffineArray<ValueTypeT>::GetParametersSize()
+{
+  return (this->Offset.capacity() + this->Slope.capacity()) * sizeof(double);
+}
+
+#endif
@@ -20,6 +20,9 @@
  * vtkBuffer makes it easier to keep data pointers in vtkDataArray subclasses.
  * This is an internal class and not intended for direct use expect when writing
  * new types of vtkDataArray subclasses.
+ *
+ * When vtkBufferPool is enabled, large buffers are allocated from and
+ * released to the pool.
 */
 
 #ifndef vtkBuffer_h
@@ -27,6 +30,7 @@
 
 #include "vtkObject.h"
 #include "vtkObjectFactory.h" // New() implementation
+#include "vtkBufferPool.h" // For recycled buffers
 
 template <class ScalarTypeT>
 class vtkBuffer : public vtkObject
@@ -109,7 +113,15 @@ void vtkBuffer<ScalarT>::SetBuffer(
   {
     if (!this->Save)
     {
-      this->DeleteFunction(this->Pointer);
+      if (this->DeleteFunction == vtkBufferPool::Free)
+      {
+        vtkBufferPool::Release(this->Pointer,
+                               this->Size * sizeof(ScalarType));
+      }
+      else
+      {
+        this->DeleteFunction(this->Pointer);
+      }
     }
     this->Pointer = array;
   }
@@ -124,6 +136,17 @@ bool vtkBuffer<ScalarT>::Allocate(vtkIdType size)
 {
   // release old memory.
   this->SetBuffer(NULL, 0);
+  if (size > 0 && vtkBufferPool::UsePool(size * sizeof(ScalarType)))
+  {
+    ScalarType* newArray = static_cast<ScalarType*>(
+      vtkBufferPool::Allocate(size * sizeof(ScalarType)));
+    if (newArray)
+    {
+      this->SetBuffer(newArray, size, false, vtkBufferPool::Free);
+      return true;
+    }
+    return false;
+  }
   if (size > 0)
   {
     ScalarType* newArray =
@@ -144,6 +167,32 @@ bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
 {
   if (newsize == 0) { return this->Allocate(0); }
 
+  const size_t newBytes = newsize * sizeof(ScalarType);
+  if (this->Pointer && !this->Save &&
+      this->DeleteFunction == vtkBufferPool::Free &&
+      vtkBufferPool::SameSizeClass(this->Size * sizeof(ScalarType), newBytes))
+  {
+    // The pooled buffer is large enough.
+    this->Size = newsize;
+    return true;
+  }
+  if (vtkBufferPool::UsePool(newBytes))
+  {
+    ScalarType* newArray =
+        static_cast<ScalarType*>(vtkBufferPool::Allocate(newBytes));
+    if (!newArray)
+    {
+      return false;
+    }
+    if (this->Pointer)
+    {
+      std::copy(this->Pointer, this->Pointer + std::min(this->Size, newsize),
+                newArray);
+    }
+    this->SetBuffer(newArray, newsize, false, vtkBufferPool::Free);
+    return true;
+  }
+
   if (this->Pointer &&
       (this->Save || this->DeleteFunction != free))
   {
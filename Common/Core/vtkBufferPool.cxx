@@ -0,0 +1,392 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBufferPool.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBufferPool.h"
+
+#include "vtkAtomic.h"
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+#include "vtkSimpleCriticalSection.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+# define VTK_BUFFER_POOL_POSIX
+# include <unistd.h>
+#endif
+
+vtkStandardNewMacro(vtkBufferPool);
+
+namespace
+{
+
+// Number of caches selected by thread, and number of buffers of each size
+// class they keep before the shared cache is used.
+const int vtkNumberOfThreadCaches = 16;
+const size_t vtkThreadCacheCapacity = 2;
+
+// Enough classes for 2^64 bytes: four per power of two.
+const int vtkNumberOfSizeClasses = 256;
+
+// Retained buffers, by size class.
+struct vtkBufferCache
+{
+  vtkSimpleCriticalSection Lock;
+  std::vector<void*> Buffers[vtkNumberOfSizeClasses];
+};
+
+struct vtkBufferPoolState
+{
+  vtkAtomic<int> Enabled;
+  vtkAtomic<vtkTypeInt64> MinimumBufferSize;
+  vtkAtomic<vtkTypeInt64> MaximumRetainedBytes;
+  vtkAtomic<vtkTypeInt64> Hits;
+  vtkAtomic<vtkTypeInt64> Misses;
+  vtkAtomic<vtkTypeInt64> RetainedBuffers;
+  vtkAtomic<vtkTypeInt64> RetainedBytes;
+  size_t PageSize;
+
+  vtkBufferCache ThreadCaches[vtkNumberOfThreadCaches];
+  vtkBufferCache SharedCache;
+
+  vtkBufferPoolState()
+  {
+    this->MinimumBufferSize = 64 * 1024;
+    this->MaximumRetainedBytes = static_cast<vtkTypeInt64>(1) << 30;
+#if defined(VTK_BUFFER_POOL_POSIX)
+    this->PageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    this->PageSize = 4096;
+#endif
+  }
+};
+
+// The state is never deleted, since arrays may be released during static
+// destruction. vtkBufferPoolCleanup frees the retained buffers at exit.
+vtkBufferPoolState& vtkGetBufferPoolState()
+{
+  static vtkBufferPoolState *state = new vtkBufferPoolState;
+  return *state;
+}
+
+class vtkBufferPoolCleanup
+{
+public:
+  ~vtkBufferPoolCleanup()
+  {
+    vtkBufferPool::SetEnabled(false);
+  }
+};
+vtkBufferPoolCleanup vtkBufferPoolCleanupInstance;
+
+// Return the size class of buffers of size bytes, and the size of the
+// buffers of this class: m * 2^e pages with m in [1, 7] when e is 0 and in
+// [4, 7] otherwise. The class index is 4 * e + m - 1.
+int vtkSizeClass(size_t size, size_t pageSize, size_t &capacity)
+{
+  size_t pages = (size + pageSize - 1) / pageSize;
+  pages = pages > 0 ? pages : 1;
+  int e = 0;
+  size_t m = pages;
+  if (pages > 4)
+  {
+    int log2 = 0;
+    while ((pages >> (log2 + 1)) != 0)
+    {
+      ++log2;
+    }
+    e = log2 - 2;
+    m = (pages + (static_cast<size_t>(1) << e) - 1) >> e;
+    if (m == 8)
+    {
+      ++e;
+      m = 4;
+    }
+  }
+  capacity = (m << e) * pageSize;
+  return 4 * e + static_cast<int>(m) - 1;
+}
+
+// Return the size of the buffers of a size class.
+size_t vtkSizeClassCapacity(int sizeClass, size_t pageSize)
+{
+  if (sizeClass < 3)
+  {
+    return static_cast<size_t>(sizeClass + 1) * pageSize;
+  }
+  const int e = (sizeClass + 1) / 4 - 1;
+  const size_t m = static_cast<size_t>((sizeClass + 1) % 4 + 4);
+  return (m << e) * pageSize;
+}
+
+// Select the cache of the calling thread by hashing its id (FNV-1a).
+vtkBufferCache& vtkGetThreadCache(vtkBufferPoolState &state)
+{
+  vtkMultiThreaderIDType id = vtkMultiThreader::GetCurrentThreadID();
+  unsigned char bytes[sizeof(id)];
+  memcpy(bytes, &id, sizeof(id));
+  vtkTypeUInt32 hash = 2166136261u;
+  for (size_t i = 0; i < sizeof(id); ++i)
+  {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return state.ThreadCaches[hash % vtkNumberOfThreadCaches];
+}
+
+void *vtkPopBuffer(vtkBufferCache &cache, int sizeClass)
+{
+  void *buffer = NULL;
+  cache.Lock.Lock();
+  std::vector<void*> &buffers = cache.Buffers[sizeClass];
+  if (!buffers.empty())
+  {
+    buffer = buffers.back();
+    buffers.pop_back();
+  }
+  cache.Lock.Unlock();
+  return buffer;
+}
+
+bool vtkPushBuffer(vtkBufferCache &cache, int sizeClass, void *buffer,
+                   size_t capacity)
+{
+  cache.Lock.Lock();
+  std::vector<void*> &buffers = cache.Buffers[sizeClass];
+  bool pushed = buffers.size() < capacity;
+  if (pushed)
+  {
+    buffers.push_back(buffer);
+  }
+  cache.Lock.Unlock();
+  return pushed;
+}
+
+void vtkFreeBuffers(vtkBufferPoolState &state, vtkBufferCache &cache)
+{
+  cache.Lock.Lock();
+  for (int c = 0; c < vtkNumberOfSizeClasses; ++c)
+  {
+    std::vector<void*> &buffers = cache.Buffers[c];
+    if (buffers.empty())
+    {
+      continue;
+    }
+    const size_t capacity = vtkSizeClassCapacity(c, state.PageSize);
+    for (size_t i = 0; i < buffers.size(); ++i)
+    {
+      free(buffers[i]);
+    }
+    state.RetainedBuffers -= static_cast<vtkTypeInt64>(buffers.size());
+    state.RetainedBytes -=
+      static_cast<vtkTypeInt64>(capacity * buffers.size());
+    buffers.clear();
+  }
+  cache.Lock.Unlock();
+}
+
+}
+
+//----------------------------------------------------------------------------
+void vtkBufferPool::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Enabled: " << vtkBufferPool::GetEnabled() << "\n";
+  os << indent << "MinimumBufferSize: "
+     << vtkBufferPool::GetMinimumBufferSize() << "\n";
+  os << indent << "MaximumRetainedBytes: "
+     << vtkBufferPool::GetMaximumRetainedBytes() << "\n";
+  os << indent << "NumberOfHits: " << vtkBufferPool::GetNumberOfHits() << "\n";
+  os << indent << "NumberOfMisses: "
+     << vtkBufferPool::GetNumberOfMisses() << "\n";
+  os << indent << "NumberOfRetainedBuffers: "
+     << vtkBufferPool::GetNumberOfRetainedBuffers() << "\n";
+  os << indent << "RetainedBytes: " << vtkBufferPool::GetRetainedBytes()
+     << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkBufferPool::SetEnabled(bool enabled)
+{
+  vtkGetBufferPoolState().Enabled = enabled ? 1 : 0;
+  if (!enabled)
+  {
+    vtkBufferPool::ReleaseRetainedBuffers();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkBufferPool::GetEnabled()
+{
+  return vtkGetBufferPoolState().Enabled.load() != 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkBufferPool::SetMinimumBufferSize(size_t size)
+{
+  vtkGetBufferPoolState().MinimumBufferSize = static_cast<vtkTypeInt64>(size);
+}
+
+//----------------------------------------------------------------------------
+size_t vtkBufferPool::GetMinimumBufferSize()
+{
+  return static_cast<size_t>(vtkGetBufferPoolState().MinimumBufferSize.load());
+}
+
+//----------------------------------------------------------------------------
+void vtkBufferPool::SetMaximumRetainedBytes(vtkTypeUInt64 size)
+{
+  vtkGetBufferPoolState().MaximumRetainedBytes =
+    static_cast<vtkTypeInt64>(size);
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkBufferPool::GetMaximumRetainedBytes()
+{
+  return static_cast<vtkTypeUInt64>(
+    vtkGetBufferPoolState().MaximumRetainedBytes.load());
+}
+
+//----------------------------------------------------------------------------
+bool vtkBufferPool::UsePool(size_t size)
+{
+  vtkBufferPoolState &state = vtkGetBufferPoolState();
+  return state.Enabled.load() != 0 &&
+    static_cast<vtkTypeInt64>(size) >= state.MinimumBufferSize.load();
+}
+
+//----------------------------------------------------------------------------
+void *vtkBufferPool::Allocate(size_t size)
+{
+  vtkBufferPoolState &state = vtkGetBufferPoolState();
+  size_t capacity = 0;
+  const int sizeClass = vtkSizeClass(size, state.PageSize, capacity);
+
+  void *buffer = vtkPopBuffer(vtkGetThreadCache(state), sizeClass);
+  if (!buffer)
+  {
+    buffer = vtkPopBuffer(state.SharedCache, sizeClass);
+  }
+  if (buffer)
+  {
+    ++state.Hits;
+    --state.RetainedBuffers;
+    state.RetainedBytes -= static_cast<vtkTypeInt64>(capacity);
+    return buffer;
+  }
+
+  ++state.Misses;
+#if defined(VTK_BUFFER_POOL_POSIX)
+  // Page aligned memory can still be released with free().
+  if (posix_memalign(&buffer, state.PageSize, capacity) != 0)
+  {
+    buffer = NULL;
+  }
+#else
+  buffer = malloc(capacity);
+#endif
+  return buffer;
+}
+
+//----------------------------------------------------------------------------
+void vtkBufferPool::Release(void *buffer, size_t size)
+{
+  if (!buffer)
+  {
+    return;
+  }
+
+  vtkBufferPoolState &state = vtkGetBufferPoolState();
+  size_t capacity = 0;
+  const int sizeClass = vtkSizeClass(size, state.PageSize, capacity);
+  // The limit is approximate, as concurrent releases are not serialized.
+  if (state.Enabled.load() == 0 ||
+      state.RetainedBytes.load() + static_cast<vtkTypeInt64>(capacity) >
+      state.MaximumRetainedBytes.load())
+  {
+    free(buffer);
+    return;
+  }
+
+  ++state.RetainedBuffers;
+  state.RetainedBytes += static_cast<vtkTypeInt64>(capacity);
+  if (!vtkPushBuffer(vtkGetThreadCache(state), sizeClass, buffer,
+                     vtkThreadCacheCapacity))
+  {
+    vtkPushBuffer(state.SharedCache, sizeClass, buffer,
+                  static_cast<size_t>(-1));
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkBufferPool::SameSizeClass(size_t size1, size_t size2)
+{
+  const size_t pageSize = vtkGetBufferPoolState().PageSize;
+  size_t capacity = 0;
+  return vtkSizeClass(size1, pageSize, capacity) ==
+    vtkSizeClass(size2, pageSize, capacity);
+}
+
+//----------------------------------------------------------------------------
+void vtkBufferPool::Free(void *buffer)
+{
+  free(buffer);
+}
+
+//----------------------------------------------------------------------------
+void vtkBufferPool::ReleaseRetainedBuffers()
+{
+  vtkBufferPoolState &state = vtkGetBufferPoolState();
+  for (int i = 0; i < vtkNumberOfThreadCaches; ++i)
+  {
+    vtkFreeBuffers(state, state.ThreadCaches[i]);
+  }
+  vtkFreeBuffers(state, state.SharedCache);
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkBufferPool::GetNumberOfHits()
+{
+  return static_cast<vtkTypeUInt64>(vtkGetBufferPoolState().Hits.load());
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkBufferPool::GetNumberOfMisses()
+{
+  return static_cast<vtkTypeUInt64>(vtkGetBufferPoolState().Misses.load());
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkBufferPool::GetNumberOfRetainedBuffers()
+{
+  return static_cast<vtkTypeUInt64>(
+    vtkGetBufferPoolState().RetainedBuffers.load());
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkBufferPool::GetRetainedBytes()
+{
+  return static_cast<vtkTypeUInt64>(
+    vtkGetBufferPoolState().RetainedBytes.load());
+}
+
+//----------------------------------------------------------------------------
+void vtkBufferPool::ResetStatistics()
+{
+  vtkBufferPoolState &state = vtkGetBufferPoolState();
+  state.Hits = 0;
+  state.Misses = 0;
+}
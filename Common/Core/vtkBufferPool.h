@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBufferPool.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkBufferPool
+ * @brief   recycle the memory of large data array buffers
+ *
+ * vtkBufferPool keeps the buffers released by data arrays to hand them back
+ * to the next arrays allocating buffers of a similar size. Pipelines that
+ * re-execute (e.g. when playing back time steps) then reuse the memory of
+ * their previous outputs instead of going through the allocator and the page
+ * faults of freshly mapped memory.
+ *
+ * The pool is global and disabled by default. When enabled (see
+ * SetEnabled() or vtkAbstractArray::SetUseBufferPool()), vtkBuffer, which
+ * holds the values of vtkAOSDataArrayTemplate and vtkSOADataArrayTemplate,
+ * allocates the buffers of at least GetMinimumBufferSize() bytes from the
+ * pool. Smaller buffers are allocated with malloc().
+ *
+ * Buffers are rounded up to size classes: a whole number of pages up to four
+ * pages, then four classes per power of two, so that at most 25% of a buffer
+ * is unused. They are page aligned on POSIX systems. Released buffers are
+ * first kept in a small cache selected by the releasing thread, so that
+ * threads mostly recycle their own buffers without contention, then in a
+ * shared cache. Buffers are freed instead of being retained when the pool
+ * would retain more than GetMaximumRetainedBytes().
+ *
+ * Reallocating a pooled buffer within its size class does not move it.
+ *
+ * @sa
+ * vtkBuffer vtkAbstractArray
+*/
+
+#ifndef vtkBufferPool_h
+#define vtkBufferPool_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+class VTKCOMMONCORE_EXPORT vtkBufferPool : public vtkObject
+{
+public:
+  static vtkBufferPool *New();
+  vtkTypeMacro(vtkBufferPool,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) VTK_OVERRIDE;
+
+  //@{
+  /**
+   * Enable or disable the pool. Disabling the pool releases the retained
+   * buffers. Buffers allocated from the pool are still recycled correctly
+   * when they are released after the pool is disabled.
+   */
+  static void SetEnabled(bool enabled);
+  static bool GetEnabled();
+  //@}
+
+  //@{
+  /**
+   * Set/Get the size in bytes under which buffers are not allocated from
+   * the pool. Default is 64 KiB.
+   */
+  static void SetMinimumBufferSize(size_t size);
+  static size_t GetMinimumBufferSize();
+  //@}
+
+  //@{
+  /**
+   * Set/Get the maximum number of bytes retained by the pool. Default is
+   * 1 GiB. Lowering it does not release the buffers already retained, see
+   * ReleaseRetainedBuffers().
+   */
+  static void SetMaximumRetainedBytes(vtkTypeUInt64 size);
+  static vtkTypeUInt64 GetMaximumRetainedBytes();
+  //@}
+
+  /**
+   * Return true if a buffer of @a size bytes would be allocated from the
+   * pool, i.e. if the pool is enabled and @a size is large enough.
+   */
+  static bool UsePool(size_t size);
+
+  /**
+   * Return a buffer of at least @a size bytes, or NULL on failure. The
+   * buffer must be released with Release() and the same size.
+   */
+  static void *Allocate(size_t size);
+
+  /**
+   * Give back a buffer returned by Allocate(@a size). NULL is ignored.
+   */
+  static void Release(void *buffer, size_t size);
+
+  /**
+   * Return true if buffers of @a size1 and @a size2 bytes belong to the
+   * same size class, in which case a buffer allocated for one can be
+   * used for the other.
+   */
+  static bool SameSizeClass(size_t size1, size_t size2);
+
+  /**
+   * Delete function marking the buffers of vtkBuffer allocated from the
+   * pool. vtkBuffer releases them with Release(); when called directly,
+   * the buffer is freed without being recycled.
+   */
+  static void Free(void *buffer);
+
+  /**
+   * Free all the buffers retained by the pool.
+   */
+  static void ReleaseRetainedBuffers();
+
+  //@{
+  /**
+   * Statistics: the number of allocations served by a retained buffer
+   * (hits) or by the system allocator (misses), and the number and total
+   * size of the buffers currently retained.
+   */
+  static vtkTypeUInt64 GetNumberOfHits();
+  static vtkTypeUInt64 GetNumberOfMisses();
+  static vtkTypeUInt64 GetNumberOfRetainedBuffers();
+  static vtkTypeUInt64 GetRetainedBytes();
+  //@}
+
+  /**
+   * Reset the hit and miss counters.
+   */
+  static void ResetStatistics();
+
+protected:
+  vtkBufferPool() {}
+  ~vtkBufferPool() VTK_OVERRIDE {}
+
+private:
+  vtkBufferPool(const vtkBufferPool&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkBufferPool&) VTK_DELETE_FUNCTION;
+};
+
+#endif
@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCompositeArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCompositeArray
+ * @brief   Implicit array concatenating other arrays.
+ *
+ *
+ * vtkCompositeArray presents the tuples of several data arrays, which must
+ * have the same number of components, as a single array without copying
+ * them: the first tuples are those of the first array, followed by those of
+ * the second one, etc. It lets filters such as vtkAppendFilter reference the
+ * arrays of their inputs instead of copying them.
+ *
+ * The number of components and of tuples are set by AddArray(). The arrays
+ * are referenced, and must not be resized once added. Values of sub-arrays
+ * of the same value type stored as vtkAOSDataArrayTemplate are read
+ * directly, the others through the vtkDataArray API.
+ *
+ * @sa
+ * vtkImplicitArray
+*/
+
+#ifndef vtkCompositeArray_h
+#define vtkCompositeArray_h
+
+#include "vtkImplicitArray.h" // Parent
+#include "vtkAOSDataArrayTemplate.h" // For the typed sub-arrays
+#include "vtkSmartPointer.h" // For the sub-arrays
+
+#include <algorithm> // For std::upper_bound
+#include <vector> // For the sub-arrays
+
+template <class ValueTypeT>
+class vtkCompositeArray
+    : public vtkImplicitArray<vtkCompositeArray<ValueTypeT>, ValueTypeT>
+{
+  typedef vtkImplicitArray<vtkCompositeArray<ValueTypeT>, ValueTypeT>
+    ImplicitArrayType;
+public:
+  typedef vtkCompositeArray<ValueTypeT> SelfType;
+  vtkAbstractTemplateTypeMacro(SelfType, ImplicitArrayType)
+  vtkAOSArrayNewInstanceMacro(SelfType)
+  static vtkCompositeArray* New();
+  void PrintSelf(ostream &os, vtkIndent indent) VTK_OVERRIDE;
+
+  typedef typename Superclass::ValueType ValueType;
+
+  /**
+   * Get the value at @a valueIdx. @a valueIdx assumes AOS ordering.
+   */
+  ValueType GetValue(vtkIdType valueIdx) const
+  {
+    // Index of the first array starting after valueIdx, minus one.
+    const size_t arrayIdx = static_cast<size_t>(
+      std::upper_bound(this->Offsets.begin() + 1, this->Offsets.end() - 1,
+                       valueIdx) - (this->Offsets.begin() + 1));
+    const vtkIdType localIdx = valueIdx - this->Offsets[arrayIdx];
+    if (vtkAOSDataArrayTemplate<ValueType> *typed = this->Typed[arrayIdx])
+    {
+      return typed->GetValue(localIdx);
+    }
+    const int numComps = this->NumberOfComponents;
+    return static_cast<ValueType>(this->Arrays[arrayIdx]->GetComponent(
+      localIdx / numComps, static_cast<int>(localIdx % numComps)));
+  }
+
+  /**
+   * Append the tuples of @a array. The first array sets the number of
+   * components, the others must match it.
+   */
+  void AddArray(vtkDataArray *array);
+
+  /**
+   * Remove all the arrays, leaving an empty array.
+   */
+  void RemoveAllArrays();
+
+  /**
+   * Return the number of concatenated arrays.
+   */
+  int GetNumberOfArrays() const
+  {
+    return static_cast<int>(this->Arrays.size());
+  }
+
+  /**
+   * Return array @a idx, or NULL if out of range.
+   */
+  vtkDataArray *GetArray(int idx);
+
+  /**
+   * Include the modification times of the sub-arrays.
+   */
+  vtkMTimeType GetMTime() VTK_OVERRIDE;
+
+protected:
+  vtkCompositeArray();
+  ~vtkCompositeArray() VTK_OVERRIDE;
+
+  void CopyParameters(SelfType *other) VTK_OVERRIDE;
+  size_t GetParametersSize() VTK_OVERRIDE;
+
+  std::vector<vtkSmartPointer<vtkDataArray> > Arrays;
+  // Sub-arrays which can be read directly, or NULL.
+  std::vector<vtkAOSDataArrayTemplate<ValueType>*> Typed;
+  // Index of the first value of each array, followed by the number of
+  // values.
+  std::vector<vtkIdType> Offsets;
+
+private:
+  vtkCompositeArray(const vtkCompositeArray&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkCompositeArray&) VTK_DELETE_FUNCTION;
+};
+
+#include "vtkCompositeArray.txx"
+
+#endif
+// VTK-HeaderTest-Exclude: vtkCompositeArray.h
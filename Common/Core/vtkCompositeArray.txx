@@ -0,0 +1,144 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCompositeArray.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkCompositeArray_txx
+#define vtkCompositeArray_txx
+
+#include "vtkCompositeArray.h"
+
+#include "vtkObjectFactory.h"
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkCompositeArray<ValueTypeT> *vtkCompositeArray<ValueTypeT>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkCompositeArray<ValueTypeT>)
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompositeArray<ValueTypeT>::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfArrays: " << this->Arrays.size() << "\n";
+  for (size_t i = 0; i < this->Arrays.size(); ++i)
+  {
+    os << indent << "Array " << i << ": " << this->Arrays[i]->GetClassName()
+       << " (" << this->Arrays[i].GetPointer() << ")\n";
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompositeArray<ValueTypeT>::AddArray(vtkDataArray *array)
+{
+  if (!array)
+  {
+    return;
+  }
+  if (this->Arrays.empty())
+  {
+    this->SetNumberOfComponents(array->GetNumberOfComponents());
+  }
+  else if (array->GetNumberOfComponents() != this->NumberOfComponents)
+  {
+    vtkErrorMacro("Cannot add an array with "
+                  << array->GetNumberOfComponents() << " components to a "
+                  "composite array with " << this->NumberOfComponents
+                  << " components.");
+    return;
+  }
+
+  this->Arrays.push_back(array);
+  this->Typed.push_back(
+    vtkArrayDownCast<vtkAOSDataArrayTemplate<ValueType> >(array));
+  const vtkIdType numValues = this->Offsets.back() +
+    array->GetNumberOfTuples() * this->NumberOfComponents;
+  this->Offsets.push_back(numValues);
+  this->SetNumberOfTuples(numValues / this->NumberOfComponents);
+  this->DataChanged();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompositeArray<ValueTypeT>::RemoveAllArrays()
+{
+  this->Arrays.clear();
+  this->Typed.clear();
+  this->Offsets.assign(1, 0);
+  this->SetNumberOfTuples(0);
+  this->DataChanged();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkDataArray *vtkCompositeArray<ValueTypeT>::GetArray(int idx)
+{
+  if (idx < 0 || idx >= static_cast<int>(this->Arrays.size()))
+  {
+    return NULL;
+  }
+  return this->Arrays[idx];
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkMTimeType vtkCompositeArray<ValueTypeT>::GetMTime()
+{
+  vtkMTimeType mTime = this->Superclass::GetMTime();
+  for (size_t i = 0; i < this->Arrays.size(); ++i)
+  {
+    vtkMTimeType arrayTime = this->Arrays[i]->GetMTime();
+    mTime = arrayTime > mTime ? arrayTime : mTime;
+  }
+  return mTime;
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkCompositeArray<ValueTypeT>::vtkCompositeArray()
+  : Offsets(1, 0)
+{
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkCompositeArray<ValueTypeT>::~vtkCompositeArray()
+{
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompositeArray<ValueTypeT>::CopyParameters(SelfType *other)
+{
+  // The sub-arrays are shared: only the composition is copied.
+  this->Arrays = other->Arrays;
+  this->Typed = other->Typed;
+  this->Offsets = other->Offsets;
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+size_t vtkCompositeArray<ValueTypeT>::GetParametersSize()
+{
+  return this->Arrays.capacity() * sizeof(vtkSmartPointer<vtkDataArray>) +
+    this->Typed.capacity() * sizeof(vtkAOSDataArrayTemplate<ValueType>*) +
+    this->Offsets.capacity() * sizeof(vtkIdType);
+}
+
+#endif
@@ -0,0 +1,109 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConstantArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConstantArray
+ * @brief   Implicit array whose tuples all have the same value.
+ *
+ *
+ * vtkConstantArray stores a single tuple, returned for every tuple index.
+ * It replaces the arrays of identical values filters often create (e.g. a
+ * uniform scalar or a default color), which then cost one value per
+ * component instead of one per point or cell:
+ * \code
+ * vtkNew<vtkConstantArray<float> > ones;
+ * ones->SetNumberOfTuples(numPoints);
+ * ones->SetConstantValue(1.0f);
+ * \endcode
+ *
+ * @sa
+ * vtkImplicitArray vtkAffineArray
+*/
+
+#ifndef vtkConstantArray_h
+#define vtkConstantArray_h
+
+#include "vtkImplicitArray.h" // Parent
+
+#include <vector> // For the constant tuple
+
+template <class ValueTypeT>
+class vtkConstantArray
+    : public vtkImplicitArray<vtkConstantArray<ValueTypeT>, ValueTypeT>
+{
+  typedef vtkImplicitArray<vtkConstantArray<ValueTypeT>, ValueTypeT>
+    ImplicitArrayType;
+public:
+  typedef vtkConstantArray<ValueTypeT> SelfType;
+  vtkAbstractTemplateTypeMacro(SelfType, ImplicitArrayType)
+  vtkAOSArrayNewInstanceMacro(SelfType)
+  static vtkConstantArray* New();
+  void PrintSelf(ostream &os, vtkIndent indent) VTK_OVERRIDE;
+
+  typedef typename Superclass::ValueType ValueType;
+
+  /**
+   * Get the value at @a valueIdx. @a valueIdx assumes AOS ordering.
+   */
+  ValueType GetValue(vtkIdType valueIdx) const
+  {
+    return this->NumberOfComponents == 1 ? this->Tuple[0] :
+      this->Tuple[valueIdx % this->NumberOfComponents];
+  }
+
+  /**
+   * Set all the components of the constant tuple to @a value.
+   */
+  void SetConstantValue(ValueType value);
+
+  /**
+   * Set the constant tuple. @a tuple has NumberOfComponents values.
+   */
+  void SetConstantTuple(const ValueType *tuple);
+
+  /**
+   * Get component @a compIdx of the constant tuple.
+   */
+  ValueType GetConstantValue(int compIdx = 0) const
+  {
+    return this->Tuple[compIdx];
+  }
+
+  /**
+   * Set the number of components, which resets the constant tuple to zero
+   * when changed.
+   */
+  void SetNumberOfComponents(int numComps) VTK_OVERRIDE;
+
+protected:
+  vtkConstantArray();
+  ~vtkConstantArray() VTK_OVERRIDE;
+
+  // The range is the constant tuple.
+  bool ComputeScalarRange(double *ranges) VTK_OVERRIDE;
+
+  void CopyParameters(SelfType *other) VTK_OVERRIDE;
+  size_t GetParametersSize() VTK_OVERRIDE;
+
+  std::vector<ValueType> Tuple;
+
+private:
+  vtkConstantArray(const vtkConstantArray&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkConstantArray&) VTK_DELETE_FUNCTION;
+};
+
+#include "vtkConstantArray.txx"
+
+#endif
+// VTK-HeaderTest-Exclude: vtkConstantArray.h
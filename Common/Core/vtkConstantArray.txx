@@ -0,0 +1,128 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConstantArray.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkConstantArray_txx
+#define vtkConstantArray_txx
+
+#include "vtkConstantArray.h"
+
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkConstantArray<ValueTypeT> *vtkConstantArray<ValueTypeT>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkConstantArray<ValueTypeT>)
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkConstantArray<ValueTypeT>::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ConstantTuple:";
+  for (size_t c = 0; c < this->Tuple.size(); ++c)
+  {
+    os << " " << this->Tuple[c];
+  }
+  os << "\n";
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkConstantArray<ValueTypeT>::SetConstantValue(ValueType value)
+{
+  std::fill(this->Tuple.begin(), this->Tuple.end(), value);
+  this->DataChanged();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkConstantArray<ValueTypeT>::SetConstantTuple(const ValueType *tuple)
+{
+  std::copy(tuple, tuple + this->NumberOfComponents, this->Tuple.begin());
+  this->DataChanged();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkConstantArray<ValueTypeT>::SetNumberOfComponents(int numComps)
+{
+  this->Superclass::SetNumberOfComponents(numComps);
+  if (static_cast<int>(this->Tuple.size()) != this->NumberOfComponents)
+  {
+    this->Tuple.assign(this->NumberOfComponents, ValueType(0));
+    this->DataChanged();
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkConstantArray<ValueTypeT>::vtkConstantArray()
+  : Tuple(1, ValueType(0))
+{
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkConstantArray<ValueTypeT>::~vtkConstantArray()
+{
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+bool vtkConstantArray<ValueTypeT>::ComputeScalarRange(double *ranges)
+{
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+  {
+    if (vtkMath::IsNan(static_cast<double>(this->Tuple[c])))
+    {
+      // Let the superclass handle the skipped values.
+      return this->Superclass::ComputeScalarRange(ranges);
+    }
+  }
+  if (this->GetNumberOfTuples() == 0)
+  {
+    return this->Superclass::ComputeScalarRange(ranges);
+  }
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+  {
+    ranges[2 * c] = ranges[2 * c + 1] = static_cast<double>(this->Tuple[c]);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkConstantArray<ValueTypeT>::CopyParameters(SelfType *other)
+{
+  this->Tuple = other->Tuple;
+}
+
+//------------------------------------------------------------------------------
+template <class ValueTypeT>
+size_t vtkConstantArray<ValueTypeT>::GetParametersSize()
+{
+  return this->Tuple.capacity() * sizeof(ValueType);
+}
+
+#endif
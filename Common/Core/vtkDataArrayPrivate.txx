@@ -15,12 +15,17 @@
 #ifndef vtkDataArrayPrivate_txx
 #define vtkDataArrayPrivate_txx
 
+#include "vtkAOSDataArrayTemplate.h"
 #include "vtkAssume.h"
 #include "vtkDataArray.h"
 #include "vtkDataArrayAccessor.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSOADataArrayTemplate.h"
 #include "vtkTypeTraits.h"
 #include <algorithm>
 #include <cassert> // for assert()
+#include <vector>
 
 namespace vtkDataArrayPrivate
 {
@@ -103,194 +108,201 @@ bool isinf(T x)
 }
 
 //----------------------------------------------------------------------------
-template <class APIType, int NumComps, int RangeSize>
-struct ComputeScalarRange
-{
-  template<class ArrayT>
-  bool operator()(ArrayT *array, double *ranges)
-  {
-    VTK_ASSUME(array->GetNumberOfComponents() == NumComps);
+// The ranges are computed by vtkSMPTools::For() functors which keep a
+// per-thread range that is merged in Reduce(). Since min/max do not depend on
+// the order of the values, and NaNs are skipped the same way by every thread,
+// the result is identical to a serial traversal.
+//
+// Arrays smaller than this number of values are processed serially.
+const vtkIdType MinimumNumberOfValuesForThreading = 65536;
 
-    vtkDataArrayAccessor<ArrayT> access(array);
-    APIType tempRange[RangeSize];
-
-    for(int i = 0, j = 0; i < NumComps; ++i, j+=2)
-    {
-      tempRange[j] = vtkTypeTraits<APIType>::Max();
-      tempRange[j+1] = vtkTypeTraits<APIType>::Min();
-    }
+//----------------------------------------------------------------------------
+// Whether the values of an array can be read from several threads at once.
+// The generic vtkDataArray API (and the one of some mapped arrays) may go
+// through internal buffers, so only the array templates with in-memory
+// storage are processed by several threads.
+template <class ArrayT>
+struct IsThreadSafeArray
+{
+  static const bool value = false;
+};
 
-    //compute the range for each component of the data array at the same time
-    const vtkIdType numTuples = array->GetNumberOfTuples();
-    for(vtkIdType tupleIdx = 0; tupleIdx < numTuples; ++tupleIdx)
-    {
-      for(int compIdx = 0, j = 0; compIdx < NumComps; ++compIdx, j+=2)
-      {
-        APIType value = access.Get(tupleIdx, compIdx);
-        tempRange[j]   = detail::min(tempRange[j], value);
-        tempRange[j+1] = detail::max(tempRange[j+1], value);
-      }
-    }
+template <class ValueType>
+struct IsThreadSafeArray<vtkAOSDataArrayTemplate<ValueType> >
+{
+  static const bool value = true;
+};
 
-    //convert the range to doubles
-    for (int i = 0, j = 0; i < NumComps; ++i, j+=2)
-    {
-      ranges[j] = static_cast<double>(tempRange[j]);
-      ranges[j+1] = static_cast<double>(tempRange[j+1]);
-    }
-    return true;
-  }
+template <class ValueType>
+struct IsThreadSafeArray<vtkSOADataArrayTemplate<ValueType> >
+{
+  static const bool value = true;
 };
 
 //----------------------------------------------------------------------------
-template <class APIType, int NumComps, int RangeSize>
-struct ComputeScalarFiniteRange
+template <class Functor>
+void ExecuteRangeFunctor(Functor &functor, vtkIdType numTuples,
+                         vtkIdType numValues, bool threadSafe)
 {
-  template<class ArrayT>
-  bool operator()(ArrayT *array, double *ranges)
+  if (threadSafe && numValues >= MinimumNumberOfValuesForThreading)
+  {
+    vtkSMPTools::For(0, numTuples, functor);
+  }
+  else
   {
-    VTK_ASSUME(array->GetNumberOfComponents() == NumComps);
+    functor.Initialize();
+    functor(0, numTuples);
+    functor.Reduce();
+  }
+}
 
-    vtkDataArrayAccessor<ArrayT> access(array);
-    APIType tempRange[RangeSize];
+//----------------------------------------------------------------------------
+template <class APIType>
+void InitializeRange(APIType *range, int numComps)
+{
+  for (int i = 0, j = 0; i < numComps; ++i, j+=2)
+  {
+    range[j] = vtkTypeTraits<APIType>::Max();
+    range[j+1] = vtkTypeTraits<APIType>::Min();
+  }
+}
 
-    for(int i = 0, j = 0; i < NumComps; ++i, j+=2)
+//----------------------------------------------------------------------------
+// Update the per-component range with the tuples [begin, end). NumComps is
+// the number of components when known at compile time, 0 otherwise. When
+// Finite is true, infinite values are skipped.
+template <int NumComps, bool Finite, class ArrayT, class APIType>
+void UpdateScalarRange(ArrayT *array, int numComps, vtkIdType begin,
+                       vtkIdType end, APIType *range)
+{
+  vtkDataArrayAccessor<ArrayT> access(array);
+  const int nc = NumComps > 0 ? NumComps : numComps;
+  for (vtkIdType tupleIdx = begin; tupleIdx < end; ++tupleIdx)
+  {
+    for (int compIdx = 0, j = 0; compIdx < nc; ++compIdx, j+=2)
     {
-      tempRange[j] = vtkTypeTraits<APIType>::Max();
-      tempRange[j+1] = vtkTypeTraits<APIType>::Min();
+      APIType value = access.Get(tupleIdx, compIdx);
+      if (!Finite || !detail::isinf(value))
+      {
+        range[j]   = detail::min(range[j], value);
+        range[j+1] = detail::max(range[j+1], value);
+      }
     }
+  }
+}
 
-    //compute the range for each component of the data array at the same time
-    const vtkIdType numTuples = array->GetNumberOfTuples();
-    for(vtkIdType tupleIdx = 0; tupleIdx < numTuples; ++tupleIdx)
+//----------------------------------------------------------------------------
+// Contiguous arrays are traversed with a pointer. When the number of
+// components is known, the range is kept in a local array so that the
+// compiler can keep it in registers and vectorize the loop.
+template <int NumComps, bool Finite, class APIType>
+void UpdateScalarRange(vtkAOSDataArrayTemplate<APIType> *array, int numComps,
+                       vtkIdType begin, vtkIdType end, APIType *range)
+{
+  const int nc = NumComps > 0 ? NumComps : numComps;
+  const APIType *values = array->GetPointer(begin * nc);
+  const APIType *valuesEnd = values + (end - begin) * nc;
+  if (NumComps > 0)
+  {
+    APIType localRange[NumComps > 0 ? 2 * NumComps : 1];
+    std::copy(range, range + 2 * nc, localRange);
+    for (; values != valuesEnd; values += NumComps)
     {
-      for(int compIdx = 0, j = 0; compIdx < NumComps; ++compIdx, j+=2)
+      for (int compIdx = 0, j = 0; compIdx < NumComps; ++compIdx, j+=2)
       {
-        APIType value = access.Get(tupleIdx, compIdx);
-        if (!detail::isinf(value))
+        const APIType value = values[compIdx];
+        if (!Finite || !detail::isinf(value))
         {
-          tempRange[j]   = detail::min(tempRange[j], value);
-          tempRange[j+1] = detail::max(tempRange[j+1], value);
+          localRange[j]   = detail::min(localRange[j], value);
+          localRange[j+1] = detail::max(localRange[j+1], value);
         }
       }
     }
-
-    //convert the range to doubles
-    for (int i = 0, j = 0; i < NumComps; ++i, j+=2)
+    std::copy(localRange, localRange + 2 * nc, range);
+  }
+  else
+  {
+    for (; values != valuesEnd; values += nc)
     {
-      ranges[j] = static_cast<double>(tempRange[j]);
-      ranges[j+1] = static_cast<double>(tempRange[j+1]);
+      for (int compIdx = 0, j = 0; compIdx < nc; ++compIdx, j+=2)
+      {
+        const APIType value = values[compIdx];
+        if (!Finite || !detail::isinf(value))
+        {
+          range[j]   = detail::min(range[j], value);
+          range[j+1] = detail::max(range[j+1], value);
+        }
+      }
     }
-    return true;
   }
-};
+}
 
 //----------------------------------------------------------------------------
-template <typename ArrayT>
-bool DoComputeScalarFiniteRange(ArrayT *array, double *ranges)
+template <class ArrayT, int NumComps, bool Finite>
+class ComputeScalarRange
 {
-  vtkDataArrayAccessor<ArrayT> access(array);
   typedef typename vtkDataArrayAccessor<ArrayT>::APIType APIType;
 
-  const vtkIdType numTuples = array->GetNumberOfTuples();
-  const int numComp = array->GetNumberOfComponents();
+  ArrayT *Array;
+  int NumberOfComponents;
+  vtkSMPThreadLocal<std::vector<APIType> > TLRange;
 
-  //setup the initial ranges to be the max,min for double
-  for (int i = 0, j = 0; i < numComp; ++i, j+=2)
-  {
-    ranges[j] =  vtkTypeTraits<double>::Max();
-    ranges[j+1] = vtkTypeTraits<double>::Min();
-  }
+public:
+  std::vector<APIType> Range;
 
-  //do this after we make sure range is max to min
-  if (numTuples == 0)
+  ComputeScalarRange(ArrayT *array)
+    : Array(array), NumberOfComponents(array->GetNumberOfComponents()),
+      Range(2 * array->GetNumberOfComponents())
   {
-    return false;
+    InitializeRange(&this->Range[0], this->NumberOfComponents);
   }
 
-  //Special case for single value scalar range. This is done to help the
-  //compiler detect it can perform loop optimizations.
-  if (numComp == 1)
-  {
-    return ComputeScalarFiniteRange<APIType,1,2>()(array, ranges);
-  }
-  else if (numComp == 2)
-  {
-    return ComputeScalarFiniteRange<APIType,2,4>()(array, ranges);
-  }
-  else if (numComp == 3)
-  {
-    return ComputeScalarFiniteRange<APIType,3,6>()(array, ranges);
-  }
-  else if (numComp == 4)
-  {
-    return ComputeScalarFiniteRange<APIType,4,8>()(array, ranges);
-  }
-  else if (numComp == 5)
-  {
-    return ComputeScalarFiniteRange<APIType,5,10>()(array, ranges);
-  }
-  else if (numComp == 6)
-  {
-    return ComputeScalarFiniteRange<APIType,6,12>()(array, ranges);
-  }
-  else if (numComp == 7)
+  void Initialize()
   {
-    return ComputeScalarFiniteRange<APIType,7,14>()(array, ranges);
+    std::vector<APIType> &range = this->TLRange.Local();
+    range.resize(2 * this->NumberOfComponents);
+    InitializeRange(&range[0], this->NumberOfComponents);
   }
-  else if (numComp == 8)
-  {
-    return ComputeScalarFiniteRange<APIType,8,16>()(array, ranges);
-  }
-  else if (numComp == 9)
+
+  void operator()(vtkIdType begin, vtkIdType end)
   {
-    return ComputeScalarFiniteRange<APIType,9,18>()(array, ranges);
+    UpdateScalarRange<NumComps, Finite>(this->Array,
+      this->NumberOfComponents, begin, end, &this->TLRange.Local()[0]);
   }
-  else
-  {
-    //initialize the temp range storage to min/max pairs
-    APIType* tempRange = new APIType[numComp*2];
-    for (int i = 0, j = 0; i < numComp; ++i, j+=2)
-    {
-      tempRange[j] = vtkTypeTraits<APIType>::Max();
-      tempRange[j+1] = vtkTypeTraits<APIType>::Min();
-    }
 
-    //compute the range for each component of the data array at the same time
-    for (vtkIdType tupleIdx = 0; tupleIdx < numTuples; ++tupleIdx)
+  void Reduce()
+  {
+    typename vtkSMPThreadLocal<std::vector<APIType> >::iterator itr;
+    for (itr = this->TLRange.begin(); itr != this->TLRange.end(); ++itr)
     {
-      for(int compIdx = 0, j = 0; compIdx < numComp; ++compIdx, j+=2)
+      for (int j = 0; j < 2 * this->NumberOfComponents; j+=2)
       {
-        APIType value = access.Get(tupleIdx, compIdx);
-        if (!detail::isinf(value))
-        {
-          tempRange[j]   = detail::min(tempRange[j],value);
-          tempRange[j+1] = detail::max(tempRange[j+1],value);
-        }
+        this->Range[j]   = detail::min(this->Range[j], (*itr)[j]);
+        this->Range[j+1] = detail::max(this->Range[j+1], (*itr)[j+1]);
       }
     }
+  }
+
+  bool Execute(double *ranges)
+  {
+    const vtkIdType numTuples = this->Array->GetNumberOfTuples();
+    ExecuteRangeFunctor(*this, numTuples,
+      numTuples * this->NumberOfComponents, IsThreadSafeArray<ArrayT>::value);
 
     //convert the range to doubles
-    for (int i = 0, j = 0; i < numComp; ++i, j+=2)
+    for (int j = 0; j < 2 * this->NumberOfComponents; j+=2)
     {
-      ranges[j] = static_cast<double>(tempRange[j]);
-      ranges[j+1] = static_cast<double>(tempRange[j+1]);
+      ranges[j] = static_cast<double>(this->Range[j]);
+      ranges[j+1] = static_cast<double>(this->Range[j+1]);
     }
-
-    //cleanup temp range storage
-    delete[] tempRange;
-
     return true;
   }
-}
+};
 
 //----------------------------------------------------------------------------
-template <typename ArrayT>
-bool DoComputeScalarRange(ArrayT *array, double *ranges)
+template <bool Finite, typename ArrayT>
+bool DoComputeScalarRangeImpl(ArrayT *array, double *ranges)
 {
-  vtkDataArrayAccessor<ArrayT> access(array);
-  typedef typename vtkDataArrayAccessor<ArrayT>::APIType APIType;
-
   const vtkIdType numTuples = array->GetNumberOfTuples();
   const int numComp = array->GetNumberOfComponents();
 
@@ -307,126 +319,151 @@ bool DoComputeScalarRange(ArrayT *array, double *ranges)
     return false;
   }
 
-  //Special case for single value scalar range. This is done to help the
+  //Special case for small numbers of components. This is done to help the
   //compiler detect it can perform loop optimizations.
-  if (numComp == 1)
-  {
-    return ComputeScalarRange<APIType,1,2>()(array, ranges);
-  }
-  else if (numComp == 2)
-  {
-    return ComputeScalarRange<APIType,2,4>()(array, ranges);
-  }
-  else if (numComp == 3)
-  {
-    return ComputeScalarRange<APIType,3,6>()(array, ranges);
+  switch (numComp)
+  {
+    case 1:
+      return ComputeScalarRange<ArrayT, 1, Finite>(array).Execute(ranges);
+    case 2:
+      return ComputeScalarRange<ArrayT, 2, Finite>(array).Execute(ranges);
+    case 3:
+      return ComputeScalarRange<ArrayT, 3, Finite>(array).Execute(ranges);
+    case 4:
+      return ComputeScalarRange<ArrayT, 4, Finite>(array).Execute(ranges);
+    case 5:
+      return ComputeScalarRange<ArrayT, 5, Finite>(array).Execute(ranges);
+    case 6:
+      return ComputeScalarRange<ArrayT, 6, Finite>(array).Execute(ranges);
+    case 7:
+      return ComputeScalarRange<ArrayT, 7, Finite>(array).Execute(ranges);
+    case 8:
+      return ComputeScalarRange<ArrayT, 8, Finite>(array).Execute(ranges);
+    case 9:
+      return ComputeScalarRange<ArrayT, 9, Finite>(array).Execute(ranges);
+    default:
+      return ComputeScalarRange<ArrayT, 0, Finite>(array).Execute(ranges);
   }
-  else if (numComp == 4)
-  {
-    return ComputeScalarRange<APIType,4,8>()(array, ranges);
-  }
-  else if (numComp == 5)
-  {
-    return ComputeScalarRange<APIType,5,10>()(array, ranges);
-  }
-  else if (numComp == 6)
-  {
-    return ComputeScalarRange<APIType,6,12>()(array, ranges);
-  }
-  else if (numComp == 7)
-  {
-    return ComputeScalarRange<APIType,7,14>()(array, ranges);
-  }
-  else if (numComp == 8)
-  {
-    return ComputeScalarRange<APIType,8,16>()(array, ranges);
-  }
-  else if (numComp == 9)
-  {
-    return ComputeScalarRange<APIType,9,18>()(array, ranges);
-  }
-  else
+}
+
+//----------------------------------------------------------------------------
+template <typename ArrayT>
+bool DoComputeScalarFiniteRange(ArrayT *array, double *ranges)
+{
+  return DoComputeScalarRangeImpl<true>(array, ranges);
+}
+
+//----------------------------------------------------------------------------
+template <typename ArrayT>
+bool DoComputeScalarRange(ArrayT *array, double *ranges)
+{
+  return DoComputeScalarRangeImpl<false>(array, ranges);
+}
+
+//----------------------------------------------------------------------------
+// Update the range of the squared norms of the tuples [begin, end).
+template <bool Finite, class ArrayT>
+void UpdateVectorRange(ArrayT *array, int numComps, vtkIdType begin,
+                       vtkIdType end, double range[2])
+{
+  vtkDataArrayAccessor<ArrayT> access(array);
+  for (vtkIdType tupleIdx = begin; tupleIdx < end; ++tupleIdx)
   {
-    //initialize the temp range storage to min/max pairs
-    APIType* tempRange = new APIType[numComp*2];
-    for (int i = 0, j = 0; i < numComp; ++i, j+=2)
+    double squaredSum = 0.0;
+    for (int compIdx = 0; compIdx < numComps; ++compIdx)
     {
-      tempRange[j] = vtkTypeTraits<APIType>::Max();
-      tempRange[j+1] = vtkTypeTraits<APIType>::Min();
+      const double t = static_cast<double>(access.Get(tupleIdx, compIdx));
+      squaredSum += t * t;
     }
-
-    //compute the range for each component of the data array at the same time
-    for (vtkIdType tupleIdx = 0; tupleIdx < numTuples; ++tupleIdx)
+    if (!Finite || !detail::isinf(squaredSum))
     {
-      for(int compIdx = 0, j = 0; compIdx < numComp; ++compIdx, j+=2)
-      {
-        APIType value = access.Get(tupleIdx, compIdx);
-        tempRange[j]   = detail::min(tempRange[j],value);
-        tempRange[j+1] = detail::max(tempRange[j+1],value);
-      }
+      range[0] = detail::min(range[0], squaredSum);
+      range[1] = detail::max(range[1], squaredSum);
     }
+  }
+}
 
-    //convert the range to doubles
-    for (int i = 0, j = 0; i < numComp; ++i, j+=2)
+//----------------------------------------------------------------------------
+template <bool Finite, class APIType>
+void UpdateVectorRange(vtkAOSDataArrayTemplate<APIType> *array, int numComps,
+                       vtkIdType begin, vtkIdType end, double range[2])
+{
+  const APIType *values = array->GetPointer(begin * numComps);
+  const APIType *valuesEnd = values + (end - begin) * numComps;
+  double localRange[2] = { range[0], range[1] };
+  for (; values != valuesEnd; values += numComps)
+  {
+    double squaredSum = 0.0;
+    for (int compIdx = 0; compIdx < numComps; ++compIdx)
     {
-      ranges[j] = static_cast<double>(tempRange[j]);
-      ranges[j+1] = static_cast<double>(tempRange[j+1]);
+      const double t = static_cast<double>(values[compIdx]);
+      squaredSum += t * t;
+    }
+    if (!Finite || !detail::isinf(squaredSum))
+    {
+      localRange[0] = detail::min(localRange[0], squaredSum);
+      localRange[1] = detail::max(localRange[1], squaredSum);
     }
-
-    //cleanup temp range storage
-    delete[] tempRange;
-
-    return true;
   }
+  range[0] = localRange[0];
+  range[1] = localRange[1];
 }
 
 //----------------------------------------------------------------------------
-template <typename ArrayT>
-bool DoComputeVectorRange(ArrayT *array, double range[2])
+template <class ArrayT, bool Finite>
+class ComputeVectorRange
 {
-  vtkDataArrayAccessor<ArrayT> access(array);
+  ArrayT *Array;
+  int NumberOfComponents;
+  vtkSMPThreadLocal<std::vector<double> > TLRange;
 
-  const vtkIdType numTuples = array->GetNumberOfTuples();
-  const int numComps = array->GetNumberOfComponents();
+public:
+  double Range[2];
 
-  range[0] = vtkTypeTraits<double>::Max();
-  range[1] = vtkTypeTraits<double>::Min();
+  ComputeVectorRange(ArrayT *array)
+    : Array(array), NumberOfComponents(array->GetNumberOfComponents())
+  {
+    this->Range[0] = vtkTypeTraits<double>::Max();
+    this->Range[1] = vtkTypeTraits<double>::Min();
+  }
 
-  //do this after we make sure range is max to min
-  if (numTuples == 0)
+  void Initialize()
   {
-    return false;
+    std::vector<double> &range = this->TLRange.Local();
+    range.resize(2);
+    range[0] = vtkTypeTraits<double>::Max();
+    range[1] = vtkTypeTraits<double>::Min();
   }
 
-  //iterate over all the tuples
-  for (vtkIdType tupleIdx = 0; tupleIdx < numTuples; ++tupleIdx)
+  void operator()(vtkIdType begin, vtkIdType end)
   {
-    double squaredSum = 0.0;
-    for (int compIdx = 0; compIdx < numComps; ++compIdx)
+    UpdateVectorRange<Finite>(this->Array, this->NumberOfComponents, begin,
+                              end, &this->TLRange.Local()[0]);
+  }
+
+  void Reduce()
+  {
+    vtkSMPThreadLocal<std::vector<double> >::iterator itr;
+    for (itr = this->TLRange.begin(); itr != this->TLRange.end(); ++itr)
     {
-      const double t = static_cast<double>(access.Get(tupleIdx, compIdx));
-      squaredSum += t * t;
+      this->Range[0] = detail::min(this->Range[0], (*itr)[0]);
+      this->Range[1] = detail::max(this->Range[1], (*itr)[1]);
     }
-    range[0] = detail::min(range[0], squaredSum);
-    range[1] = detail::max(range[1], squaredSum);
   }
 
-  //now that we have computed the smallest and largest value, take the
-  //square root of that value.
-  range[0] = sqrt(range[0]);
-  range[1] = sqrt(range[1]);
-
-  return true;
-}
+  void Execute()
+  {
+    const vtkIdType numTuples = this->Array->GetNumberOfTuples();
+    ExecuteRangeFunctor(*this, numTuples,
+      numTuples * this->NumberOfComponents, IsThreadSafeArray<ArrayT>::value);
+  }
+};
 
 //----------------------------------------------------------------------------
-template <typename ArrayT>
-bool DoComputeVectorFiniteRange(ArrayT *array, double range[2])
+template <bool Finite, typename ArrayT>
+bool DoComputeVectorRangeImpl(ArrayT *array, double range[2])
 {
-  vtkDataArrayAccessor<ArrayT> access(array);
-
   const vtkIdType numTuples = array->GetNumberOfTuples();
-  const int numComps = array->GetNumberOfComponents();
 
   range[0] = vtkTypeTraits<double>::Max();
   range[1] = vtkTypeTraits<double>::Min();
@@ -437,30 +474,31 @@ bool DoComputeVectorFiniteRange(ArrayT *array, double range[2])
     return false;
   }
 
-  //iterate over all the tuples
-  for (vtkIdType tupleIdx = 0; tupleIdx < numTuples; ++tupleIdx)
-  {
-    double squaredSum = 0.0;
-    for (int compIdx = 0; compIdx < numComps; ++compIdx)
-    {
-      const double t = static_cast<double>(access.Get(tupleIdx, compIdx));
-      squaredSum += t * t;
-    }
-    if (!detail::isinf(squaredSum))
-    {
-      range[0] = detail::min(range[0], squaredSum);
-      range[1] = detail::max(range[1], squaredSum);
-    }
-  }
+  ComputeVectorRange<ArrayT, Finite> functor(array);
+  functor.Execute();
 
   //now that we have computed the smallest and largest value, take the
   //square root of that value.
-  range[0] = sqrt(range[0]);
-  range[1] = sqrt(range[1]);
+  range[0] = sqrt(functor.Range[0]);
+  range[1] = sqrt(functor.Range[1]);
 
   return true;
 }
 
+//----------------------------------------------------------------------------
+template <typename ArrayT>
+bool DoComputeVectorRange(ArrayT *array, double range[2])
+{
+  return DoComputeVectorRangeImpl<false>(array, range);
+}
+
+//----------------------------------------------------------------------------
+template <typename ArrayT>
+bool DoComputeVectorFiniteRange(ArrayT *array, double range[2])
+{
+  return DoComputeVectorRangeImpl<true>(array, range);
+}
+
 } // end namespace vtkDataArrayPrivate
 #endif
 // VTK-HeaderTest-Exclude: vtkDataArrayPrivate.txx
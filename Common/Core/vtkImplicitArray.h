@@ -0,0 +1,163 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImplicitArray
+ * @brief   Superclass of the read-only arrays whose values are computed
+ * from their index instead of being stored.
+ *
+ *
+ * vtkImplicitArray is the base of vtkGenericDataArray subclasses that hold no
+ * storage: DerivedT only implements the
+ * `ValueType GetValue(vtkIdType valueIdx) const` concept method, from which
+ * the tuple and component accessors are derived. Since these methods are
+ * non-virtual, code instantiated for the concrete implicit array through
+ * vtkArrayDispatch (or vtkDataArrayAccessor) computes the values inline.
+ *
+ * The number of components and of tuples are set as for any other array
+ * (SetNumberOfComponents() and SetNumberOfTuples()), but no memory is
+ * allocated. Writing values is an error.
+ *
+ * The values are only stored when legacy code asks for a raw pointer with
+ * GetVoidPointer(): they are then materialized in an array-of-structs buffer
+ * which is kept, and refreshed when the array is modified, until the array
+ * is resized or deleted. Writing through this pointer does not change the
+ * values of the array.
+ *
+ * NewInstance() returns a vtkAOSDataArrayTemplate of the same value type so
+ * that filters copying the array produce regular, writable arrays.
+ *
+ * @sa
+ * vtkConstantArray vtkAffineArray vtkCompositeArray vtkGenericDataArray
+*/
+
+#ifndef vtkImplicitArray_h
+#define vtkImplicitArray_h
+
+#include "vtkGenericDataArray.h" // Parent
+#include "vtkBuffer.h" // For materialized values
+
+template <class DerivedT, class ValueTypeT>
+class vtkImplicitArray : public vtkGenericDataArray<DerivedT, ValueTypeT>
+{
+  typedef vtkGenericDataArray<DerivedT, ValueTypeT> GenericDataArrayType;
+public:
+  typedef vtkImplicitArray<DerivedT, ValueTypeT> SelfType;
+  vtkAbstractTemplateTypeMacro(SelfType, GenericDataArrayType)
+  typedef typename Superclass::ValueType ValueType;
+
+  void PrintSelf(ostream &os, vtkIndent indent) VTK_OVERRIDE;
+
+  /**
+   * Copy the tuple at @a tupleIdx into @a tuple.
+   */
+  void GetTypedTuple(vtkIdType tupleIdx, ValueType* tuple) const
+  {
+    const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+      tuple[c] = static_cast<const DerivedT*>(this)->GetValue(valueIdx + c);
+    }
+  }
+
+  /**
+   * Get component @a compIdx of the tuple at @a tupleIdx.
+   */
+  ValueType GetTypedComponent(vtkIdType tupleIdx, int compIdx) const
+  {
+    return static_cast<const DerivedT*>(this)->GetValue(
+      tupleIdx * this->NumberOfComponents + compIdx);
+  }
+
+  //@{
+  /**
+   * Read only container, not supported.
+   */
+  void SetValue(vtkIdType valueIdx, ValueType value);
+  void SetTypedTuple(vtkIdType tupleIdx, const ValueType* tuple);
+  void SetTypedComponent(vtkIdType tupleIdx, int compIdx, ValueType value);
+  //@}
+
+  /**
+   * Return a pointer to the values, materialized in an array-of-structs
+   * buffer on the first call (and after the array is modified). Use of this
+   * method is discouraged, since it allocates the memory implicit arrays
+   * are meant to save.
+   */
+  void *GetVoidPointer(vtkIdType valueIdx) VTK_OVERRIDE;
+
+  /**
+   * Export a copy of the values in AoS ordering to the preallocated memory
+   * buffer, without materializing them in the array.
+   */
+  void ExportToVoidPointer(void *ptr) VTK_OVERRIDE;
+
+  //@{
+  /**
+   * Copy the parameters of another implicit array of the same type. Other
+   * arrays cannot be copied into an implicit array.
+   */
+  void DeepCopy(vtkAbstractArray *aa) VTK_OVERRIDE;
+  void DeepCopy(vtkDataArray *da) VTK_OVERRIDE;
+  void ShallowCopy(vtkDataArray *da) VTK_OVERRIDE;
+  //@}
+
+  /**
+   * Return the memory in kilobytes consumed by the materialized values, if
+   * any, and the parameters of the array.
+   */
+  unsigned long GetActualMemorySize() VTK_OVERRIDE;
+
+  int GetArrayType() VTK_OVERRIDE { return vtkAbstractArray::ImplicitArray; }
+
+protected:
+  vtkImplicitArray();
+  ~vtkImplicitArray() VTK_OVERRIDE;
+
+  //@{
+  /**
+   * Implicit arrays hold no storage: these only release the materialized
+   * values and always succeed.
+   */
+  bool AllocateTuples(vtkIdType numTuples);
+  bool ReallocateTuples(vtkIdType numTuples);
+  //@}
+
+  /**
+   * Copy the parameters of @a other, an array of the same class, into this
+   * array. Called by DeepCopy() and ShallowCopy() with the number of
+   * components and tuples already set.
+   */
+  virtual void CopyParameters(DerivedT *other) = 0;
+
+  /**
+   * Return the memory in bytes used by the parameters of the array.
+   */
+  virtual size_t GetParametersSize() { return 0; }
+
+  // Values materialized by GetVoidPointer().
+  vtkBuffer<ValueType> *Materialized;
+  vtkTimeStamp MaterializedTime;
+
+private:
+  vtkImplicitArray(const vtkImplicitArray&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkImplicitArray&) VTK_DELETE_FUNCTION;
+
+  friend class vtkGenericDataArray<DerivedT, ValueTypeT>;
+};
+
+#include "vtkImplicitArray.txx"
+
+#endif
+// VTK-HeaderTest-Exclude: vtkImplicitArray.h
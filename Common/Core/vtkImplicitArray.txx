@@ -0,0 +1,216 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkImplicitArray_txx
+#define vtkImplicitArray_txx
+
+#include "vtkImplicitArray.h"
+
+#include <cmath>
+
+//------------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+void vtkImplicitArray<DerivedT, ValueTypeT>
+::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Materialized: "
+     << (this->Materialized ? "Yes" : "No") << "\n";
+}
+
+//------------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+void vtkImplicitArray<DerivedT, ValueTypeT>
+::SetValue(vtkIdType, ValueType)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+void vtkImplicitArray<DerivedT, ValueTypeT>
+::SetTypedTuple(vtkIdType, const ValueType*)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+void vtkImplicitArray<DerivedT, ValueTypeT>
+::SetTypedComponent(vtkIdType, int, ValueType)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+void *vtkImplicitArray<DerivedT, ValueTypeT>
+::GetVoidPointer(vtkIdType valueIdx)
+{
+  const vtkIdType numValues = this->MaxId + 1;
+  if (!this->Materialized)
+  {
+    this->Materialized = vtkBuffer<ValueType>::New();
+  }
+  if (this->Materialized->GetSize() != numValues ||
+      this->MaterializedTime < this->GetMTime())
+  {
+    if (this->Materialized->GetSize() != numValues &&
+        !this->Materialized->Allocate(numValues))
+    {
+      vtkErrorMacro("Error materializing " << numValues << " values.");
+      return NULL;
+    }
+    ValueType *values = this->Materialized->GetBuffer();
+    const DerivedT *self = static_cast<const DerivedT*>(this);
+    for (vtkIdType i = 0; i < numValues; ++i)
+    {
+      values[i] = self->GetValue(i);
+    }
+    this->MaterializedTime.Modified();
+  }
+  return this->Materialized->GetBuffer() + valueIdx;
+}
+
+//------------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+void vtkImplicitArray<DerivedT, ValueTypeT>
+::ExportToVoidPointer(void *ptr)
+{
+  if (!ptr)
+  {
+    return;
+  }
+  ValueType *values = static_cast<ValueType*>(ptr);
+  const DerivedT *self = static_cast<const DerivedT*>(this);
+  for (vtkIdType i = 0; i <= this->MaxId; ++i)
+  {
+    values[i] = self->GetValue(i);
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+void vtkImplicitArray<DerivedT, ValueTypeT>
+::DeepCopy(vtkAbstractArray *aa)
+{
+  if (aa == NULL)
+  {
+    return;
+  }
+
+  vtkDataArray *da = vtkDataArray::FastDownCast(aa);
+  if (da == NULL)
+  {
+    vtkErrorMacro(<< "Input array is not a vtkDataArray ("
+                  << aa->GetClassName() << ")");
+    return;
+  }
+
+  this->DeepCopy(da);
+}
+
+//------------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+void vtkImplicitArray<DerivedT, ValueTypeT>
+::DeepCopy(vtkDataArray *da)
+{
+  if (da == NULL || da == this)
+  {
+    return;
+  }
+
+  DerivedT *other = DerivedT::SafeDownCast(da);
+  if (other == NULL)
+  {
+    vtkErrorMacro(<< "Cannot copy a " << da->GetClassName()
+                  << " into an implicit array.");
+    return;
+  }
+
+  // Copy the name, information and component names.
+  this->vtkAbstractArray::DeepCopy(da);
+  this->SetNumberOfComponents(other->GetNumberOfComponents());
+  this->SetNumberOfTuples(other->GetNumberOfTuples());
+  this->CopyParameters(other);
+  this->DataChanged();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+void vtkImplicitArray<DerivedT, ValueTypeT>
+::ShallowCopy(vtkDataArray *da)
+{
+  // Only the parameters are copied, which is as cheap as sharing them.
+  this->DeepCopy(da);
+}
+
+//------------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+unsigned long vtkImplicitArray<DerivedT, ValueTypeT>
+::GetActualMemorySize()
+{
+  size_t size = sizeof(DerivedT) + this->GetParametersSize();
+  if (this->Materialized)
+  {
+    size += static_cast<size_t>(this->Materialized->GetSize()) *
+      sizeof(ValueType);
+  }
+  return static_cast<unsigned long>(ceil(size / 1024.0));
+}
+
+//------------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+vtkImplicitArray<DerivedT, ValueTypeT>
+::vtkImplicitArray()
+  : Materialized(NULL)
+{
+}
+
+//------------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+vtkImplicitArray<DerivedT, ValueTypeT>
+::~vtkImplicitArray()
+{
+  if (this->Materialized)
+  {
+    this->Materialized->Delete();
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+bool vtkImplicitArray<DerivedT, ValueTypeT>
+::AllocateTuples(vtkIdType)
+{
+  if (this->Materialized)
+  {
+    this->Materialized->Delete();
+    this->Materialized = NULL;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+bool vtkImplicitArray<DerivedT, ValueTypeT>
+::ReallocateTuples(vtkIdType numTuples)
+{
+  return this->AllocateTuples(numTuples);
+}
+
+#endif
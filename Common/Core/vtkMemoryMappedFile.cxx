@@ -0,0 +1,226 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryMappedFile.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMemoryMappedFile.h"
+
+#include "vtkObjectFactory.h"
+#include "vtkSimpleCriticalSection.h"
+
+#include <map>
+
+#if defined(_WIN32)
+# define VTK_MEMORY_MAPPED_FILE_WIN32
+# include "vtkWindows.h"
+#elif defined(__unix__) || defined(__APPLE__)
+# define VTK_MEMORY_MAPPED_FILE_POSIX
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+vtkStandardNewMacro(vtkMemoryMappedFile);
+
+namespace
+{
+
+// The start and the length of the pages actually mapped for a region.
+struct vtkMappedRegion
+{
+  void *Base;
+  vtkTypeUInt64 Length;
+};
+
+// Mapped regions indexed by the pointer returned to the user. Unmap() only
+// gets this pointer, as it is used as a vtkBuffer delete function.
+typedef std::map<const void*, vtkMappedRegion> vtkMappedRegionMap;
+
+vtkMappedRegionMap& vtkGetMappedRegions()
+{
+  static vtkMappedRegionMap regions;
+  return regions;
+}
+
+vtkSimpleCriticalSection& vtkGetMappedRegionsLock()
+{
+  static vtkSimpleCriticalSection lock;
+  return lock;
+}
+
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryMappedFile::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
+
+//----------------------------------------------------------------------------
+bool vtkMemoryMappedFile::IsSupported()
+{
+#if defined(VTK_MEMORY_MAPPED_FILE_WIN32) || \
+    defined(VTK_MEMORY_MAPPED_FILE_POSIX)
+  return true;
+#else
+  return false;
+#endif
+}
+
+//----------------------------------------------------------------------------
+void *vtkMemoryMappedFile::Map(const char *fileName, vtkTypeUInt64 offset,
+                               vtkTypeUInt64 length, int mode)
+{
+  if (!fileName || length == 0)
+  {
+    vtkGenericWarningMacro("Cannot map an empty region or a NULL file name.");
+    return NULL;
+  }
+  if (static_cast<vtkTypeUInt64>(static_cast<size_t>(length)) != length)
+  {
+    vtkGenericWarningMacro("Region of " << length << " bytes of " << fileName
+                           << " is too large to be mapped.");
+    return NULL;
+  }
+
+  void *base = NULL;
+  vtkTypeUInt64 alignedOffset = 0;
+  vtkTypeUInt64 mappedLength = 0;
+
+#if defined(VTK_MEMORY_MAPPED_FILE_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  alignedOffset = offset - offset % info.dwAllocationGranularity;
+  mappedLength = length + (offset - alignedOffset);
+
+  HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    vtkGenericWarningMacro("Cannot open " << fileName << " for mapping.");
+    return NULL;
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) ||
+      static_cast<vtkTypeUInt64>(fileSize.QuadPart) < offset + length)
+  {
+    vtkGenericWarningMacro("File " << fileName << " is too short to map "
+                           << length << " bytes at offset " << offset << ".");
+    CloseHandle(file);
+    return NULL;
+  }
+  HANDLE mapping = CreateFileMappingA(
+    file, NULL, mode == COPY_ON_WRITE ? PAGE_WRITECOPY : PAGE_READONLY,
+    0, 0, NULL);
+  if (mapping)
+  {
+    base = MapViewOfFile(
+      mapping, mode == COPY_ON_WRITE ? FILE_MAP_COPY : FILE_MAP_READ,
+      static_cast<DWORD>(alignedOffset >> 32),
+      static_cast<DWORD>(alignedOffset & 0xffffffff),
+      static_cast<SIZE_T>(mappedLength));
+    // The view keeps a reference to the mapping and to the file.
+    CloseHandle(mapping);
+  }
+  CloseHandle(file);
+#elif defined(VTK_MEMORY_MAPPED_FILE_POSIX)
+  const vtkTypeUInt64 pageSize =
+    static_cast<vtkTypeUInt64>(sysconf(_SC_PAGESIZE));
+  alignedOffset = offset - offset % pageSize;
+  mappedLength = length + (offset - alignedOffset);
+
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+  {
+    vtkGenericWarningMacro("Cannot open " << fileName << " for mapping.");
+    return NULL;
+  }
+  struct stat fs;
+  if (fstat(fd, &fs) != 0 ||
+      static_cast<vtkTypeUInt64>(fs.st_size) < offset + length)
+  {
+    vtkGenericWarningMacro("File " << fileName << " is too short to map "
+                           << length << " bytes at offset " << offset << ".");
+    close(fd);
+    return NULL;
+  }
+  base = mmap(NULL, static_cast<size_t>(mappedLength),
+              mode == COPY_ON_WRITE ? PROT_READ | PROT_WRITE : PROT_READ,
+              mode == COPY_ON_WRITE ? MAP_PRIVATE : MAP_SHARED,
+              fd, static_cast<off_t>(alignedOffset));
+  // The mapping keeps a reference to the file.
+  close(fd);
+  if (base == MAP_FAILED)
+  {
+    base = NULL;
+  }
+#else
+  (void)mode;
+#endif
+
+  if (!base)
+  {
+    vtkGenericWarningMacro("Cannot map " << length << " bytes at offset "
+                           << offset << " of " << fileName << ".");
+    return NULL;
+  }
+
+  void *pointer = static_cast<char*>(base) + (offset - alignedOffset);
+  vtkMappedRegion region = { base, mappedLength };
+  vtkGetMappedRegionsLock().Lock();
+  vtkGetMappedRegions()[pointer] = region;
+  vtkGetMappedRegionsLock().Unlock();
+  return pointer;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryMappedFile::Unmap(void *pointer)
+{
+  if (!pointer)
+  {
+    return;
+  }
+
+  vtkMappedRegion region = { NULL, 0 };
+  vtkGetMappedRegionsLock().Lock();
+  vtkMappedRegionMap::iterator it = vtkGetMappedRegions().find(pointer);
+  if (it != vtkGetMappedRegions().end())
+  {
+    region = it->second;
+    vtkGetMappedRegions().erase(it);
+  }
+  vtkGetMappedRegionsLock().Unlock();
+
+  if (!region.Base)
+  {
+    vtkGenericWarningMacro("Pointer " << pointer << " was not mapped by "
+                           "vtkMemoryMappedFile.");
+    return;
+  }
+
+#if defined(VTK_MEMORY_MAPPED_FILE_WIN32)
+  UnmapViewOfFile(region.Base);
+#elif defined(VTK_MEMORY_MAPPED_FILE_POSIX)
+  munmap(region.Base, static_cast<size_t>(region.Length));
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool vtkMemoryMappedFile::IsMapped(const void *pointer)
+{
+  vtkGetMappedRegionsLock().Lock();
+  bool mapped =
+    vtkGetMappedRegions().find(pointer) != vtkGetMappedRegions().end();
+  vtkGetMappedRegionsLock().Unlock();
+  return mapped;
+}
@@ -0,0 +1,97 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryMappedFile.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkMemoryMappedFile
+ * @brief   map regions of files in memory for use as array storage
+ *
+ * vtkMemoryMappedFile maps a region of a file in the address space of the
+ * process (with mmap() on POSIX systems and MapViewOfFile() on Windows) so
+ * that it can be used as the storage of a data array without being read.
+ * The pages are loaded on demand by the operating system and are shared,
+ * through the page cache, by all the processes which map the same file.
+ *
+ * A mapping is either read-only, in which case writing in it is an access
+ * violation, or copy-on-write, in which case the pages that are modified
+ * become private to the process and the file is never changed.
+ *
+ * Unmap() has the signature of the delete functions used by vtkBuffer, so a
+ * mapped region can be given to an array with
+ * vtkAbstractArray::VTK_DATA_ARRAY_UNMAP as delete method:
+ * \code
+ * void *data = vtkMemoryMappedFile::Map(fileName, offset, length);
+ * array->SetVoidArray(data, numValues, 0,
+ *                     vtkAbstractArray::VTK_DATA_ARRAY_UNMAP);
+ * \endcode
+ *
+ * The file must not be truncated while it is mapped.
+ *
+ * @sa
+ * vtkAOSDataArrayTemplate::MapFile
+*/
+
+#ifndef vtkMemoryMappedFile_h
+#define vtkMemoryMappedFile_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+class VTKCOMMONCORE_EXPORT vtkMemoryMappedFile : public vtkObject
+{
+public:
+  static vtkMemoryMappedFile *New();
+  vtkTypeMacro(vtkMemoryMappedFile,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) VTK_OVERRIDE;
+
+  enum MappingModes
+  {
+    READ_ONLY = 0,
+    COPY_ON_WRITE
+  };
+
+  /**
+   * Return true if memory mapping is available on this platform.
+   */
+  static bool IsSupported();
+
+  /**
+   * Map @a length bytes located at byte @a offset of the file @a fileName.
+   * The offset does not need to be aligned on pages. Returns a pointer to
+   * the first mapped byte, or NULL (and reports an error) if the file
+   * cannot be mapped or is too short. The region must be released with
+   * Unmap().
+   */
+  static void *Map(const char *fileName, vtkTypeUInt64 offset,
+                   vtkTypeUInt64 length, int mode = READ_ONLY);
+
+  /**
+   * Release a region returned by Map(). NULL is ignored.
+   */
+  static void Unmap(void *pointer);
+
+  /**
+   * Return true if @a pointer was returned by Map() and is still mapped.
+   */
+  static bool IsMapped(const void *pointer);
+
+protected:
+  vtkMemoryMappedFile() {}
+  ~vtkMemoryMappedFile() VTK_OVERRIDE {}
+
+private:
+  vtkMemoryMappedFile(const vtkMemoryMappedFile&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkMemoryMappedFile&) VTK_DELETE_FUNCTION;
+};
+
+#endif
@@ -19,7 +19,7 @@
  * vtkSMPTools provides a set of utility functions that can
  * be used to parallelize parts of VTK code using multiple threads.
  * There are several back-end implementations of parallel functionality
- * (currently Sequential, TBB and X-Kaapi) that actual execution is
+ * (currently Sequential, STDThread, OpenMP and TBB) that actual execution is
  * delegated to.
 */
 
@@ -32,6 +32,9 @@
 #include "vtkSMPThreadLocal.h" // For Initialized
 #include "vtkSMPToolsInternal.h"
 
+#include <functional> // For std::plus
+#include <iterator> // For std::iterator_traits
+
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 #ifndef __VTK_WRAP__
@@ -210,7 +213,7 @@ public:
    * not required as it is automatically called before the first
    * execution of any parallel code. However, it can be used to
    * control the maximum number of threads used when the back-end
-   * supports it (currently Simple and TBB only). Make sure to call
+   * supports it (currently STDThread, OpenMP and TBB). Make sure to call
    * it before any other parallel operation.
    * When using Kaapi, use the KAAPI_CPUCOUNT env. variable to control
    * the number of threads used in the thread pool.
@@ -249,6 +252,117 @@ public:
     vtk::detail::smp::vtkSMPTools_Impl_Sort(begin,end,comp);
   }
 
+  /**
+   * A convenience method for transforming data. It is a drop in replacement
+   * for std::transform() and requires random access iterators. The unary
+   * operation is applied to every element of [inBegin, inEnd) and the result
+   * is stored at the same position starting from outBegin. The operation may
+   * be executed concurrently and must not have side effects.
+   */
+  template<typename InputIt, typename OutputIt, typename UnaryOperation>
+    static void Transform(InputIt inBegin, InputIt inEnd, OutputIt outBegin,
+      UnaryOperation op)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_Transform(inBegin, inEnd, outBegin, op);
+  }
+
+  /**
+   * A convenience method for transforming data. It is a drop in replacement
+   * for the binary version of std::transform() and requires random access
+   * iterators. The operation is applied to the pairs of elements of
+   * [inBegin1, inEnd1) and of the range starting at inBegin2.
+   */
+  template<typename InputIt1, typename InputIt2, typename OutputIt,
+           typename BinaryOperation>
+    static void Transform(InputIt1 inBegin1, InputIt1 inEnd1,
+      InputIt2 inBegin2, OutputIt outBegin, BinaryOperation op)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_Transform(
+      inBegin1, inEnd1, inBegin2, outBegin, op);
+  }
+
+  /**
+   * A convenience method for filling data. It is a drop in replacement for
+   * std::fill() and requires random access iterators.
+   */
+  template<typename Iterator, typename T>
+    static void Fill(Iterator begin, Iterator end, const T& value)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_Fill(begin, end, value);
+  }
+
+  /**
+   * Combine the elements of [begin, end) and init with the binary operation
+   * op. The operation must be associative, but it does not have to be
+   * commutative: the elements are combined in an unspecified grouping but in
+   * their original order, init coming first. Requires random access
+   * iterators.
+   */
+  template<typename Iterator, typename T, typename BinaryOperation>
+    static T Reduce(Iterator begin, Iterator end, T init, BinaryOperation op)
+  {
+    return vtk::detail::smp::vtkSMPTools_Impl_Reduce(begin, end, init, op);
+  }
+
+  /**
+   * Sum the elements of [begin, end) and init.
+   */
+  template<typename Iterator, typename T>
+    static T Reduce(Iterator begin, Iterator end, T init)
+  {
+    return vtkSMPTools::Reduce(begin, end, init, std::plus<T>());
+  }
+
+  /**
+   * Compute the inclusive prefix sums of [begin, end) with the associative
+   * binary operation op: the i-th output is the combination of the first
+   * i+1 elements. The output may be the input range itself. Requires random
+   * access iterators.
+   */
+  template<typename InputIt, typename OutputIt, typename BinaryOperation>
+    static void InclusiveScan(InputIt begin, InputIt end, OutputIt out,
+      BinaryOperation op)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_InclusiveScan(begin, end, out, op);
+  }
+
+  /**
+   * Compute the inclusive prefix sums of [begin, end).
+   */
+  template<typename InputIt, typename OutputIt>
+    static void InclusiveScan(InputIt begin, InputIt end, OutputIt out)
+  {
+    typedef typename std::iterator_traits<InputIt>::value_type ValueType;
+    vtkSMPTools::InclusiveScan(begin, end, out, std::plus<ValueType>());
+  }
+
+  /**
+   * Compute the exclusive prefix sums of [begin, end) with the associative
+   * binary operation op: the i-th output is the combination of init and of
+   * the first i elements. The output may be the input range itself, which
+   * turns an array of counts into an array of offsets. The combination of
+   * init and of all the elements (e.g. the total count) is returned.
+   * Requires random access iterators.
+   */
+  template<typename InputIt, typename OutputIt, typename T,
+           typename BinaryOperation>
+    static T ExclusiveScan(InputIt begin, InputIt end, OutputIt out, T init,
+      BinaryOperation op)
+  {
+    return vtk::detail::smp::vtkSMPTools_Impl_ExclusiveScan(
+      begin, end, out, init, op);
+  }
+
+  /**
+   * Compute the exclusive prefix sums of [begin, end) starting at init and
+   * return the total.
+   */
+  template<typename InputIt, typename OutputIt, typename T>
+    static T ExclusiveScan(InputIt begin, InputIt end, OutputIt out, T init)
+  {
+    return vtkSMPTools::ExclusiveScan(begin, end, out, init, std::plus<T>());
+  }
+
 };
 
 #endif
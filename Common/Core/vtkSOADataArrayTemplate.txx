@@ -20,6 +20,7 @@
 
 #include "vtkArrayIteratorTemplate.h"
 #include "vtkBuffer.h"
+#include "vtkMemoryMappedFile.h"
 
 #include <cassert>
 
@@ -214,6 +215,10 @@ void vtkSOADataArrayTemplate<ValueType>::SetArray(int comp, ValueType* array,
     this->Data[comp]->SetBuffer(array, size, save, free);
 #endif
   }
+  else if(deleteMethod == VTK_DATA_ARRAY_UNMAP)
+  {
+    this->Data[comp]->SetBuffer(array, size, save, vtkMemoryMappedFile::Unmap);
+  }
   else
   {
     this->Data[comp]->SetBuffer(array, size, save, free);
@@ -0,0 +1,280 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellArraySplitStorage.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkCommand.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestErrorObserver.h"
+
+namespace
+{
+
+// Cells used by the test: a triangle, a quad, a vertex and a pentagon.
+const vtkIdType TestCells[] = { 3, 0, 1, 2,   4, 2, 3, 4, 5,   1, 6,
+                                5, 1, 3, 5, 7, 8 };
+const vtkIdType NumberOfTestCells = 4;
+
+void InsertTestCells(vtkCellArray *ca)
+{
+  for (vtkIdType loc = 0; loc < 17; loc += TestCells[loc] + 1)
+  {
+    ca->InsertNextCell(TestCells[loc], TestCells + loc + 1);
+  }
+}
+
+// Check the content of the cell array through the traversal API.
+bool CheckTraversal(vtkCellArray *ca, const char *label)
+{
+  if (ca->GetNumberOfCells() != NumberOfTestCells ||
+      ca->GetNumberOfConnectivityEntries() != 17)
+  {
+    cerr << label << ": wrong number of cells or entries." << endl;
+    return false;
+  }
+  vtkIdType npts, *pts, loc = 0;
+  for (ca->InitTraversal(); ca->GetNextCell(npts, pts); loc += npts + 1)
+  {
+    if (npts != TestCells[loc])
+    {
+      cerr << label << ": wrong cell size at " << loc << endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      if (pts[i] != TestCells[loc + 1 + i])
+      {
+        cerr << label << ": wrong point id at " << loc << endl;
+        return false;
+      }
+    }
+  }
+  return loc == 17;
+}
+
+// Check random access to the cells.
+bool CheckRandomAccess(vtkCellArray *ca, const char *label)
+{
+  vtkNew<vtkIdList> ids;
+  vtkIdType loc = 0;
+  for (vtkIdType cellId = 0; cellId < NumberOfTestCells; ++cellId)
+  {
+    ca->GetCellAtId(cellId, ids.GetPointer());
+    if (ca->GetCellSize(cellId) != TestCells[loc] ||
+        ids->GetNumberOfIds() != TestCells[loc])
+    {
+      cerr << label << ": wrong size for cell " << cellId << endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+    {
+      if (ids->GetId(i) != TestCells[loc + 1 + i])
+      {
+        cerr << label << ": wrong point id for cell " << cellId << endl;
+        return false;
+      }
+    }
+    loc += TestCells[loc] + 1;
+  }
+  return true;
+}
+
+// Check the legacy view.
+bool CheckLegacy(vtkCellArray *ca, const char *label)
+{
+  vtkIdType *legacy = ca->GetPointer();
+  if (ca->IsStorageSplit() ||
+      ca->GetData()->GetNumberOfTuples() != 17)
+  {
+    cerr << label << ": legacy conversion failed." << endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < 17; ++i)
+  {
+    if (legacy[i] != TestCells[i])
+    {
+      cerr << label << ": wrong legacy value at " << i << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+int TestCellArraySplitStorage(int, char *[])
+{
+  // Legacy storage round trip through 64-bit and 32-bit split storage.
+  vtkNew<vtkCellArray> ca;
+  InsertTestCells(ca.GetPointer());
+  if (ca->IsStorageSplit() || !CheckTraversal(ca.GetPointer(), "legacy"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  if (!ca->UseSplitStorage(false) || ca->IsStorage32Bit() ||
+      !CheckTraversal(ca.GetPointer(), "split64") ||
+      !CheckRandomAccess(ca.GetPointer(), "split64") ||
+      ca->GetMaxCellSize() != 5)
+  {
+    return EXIT_FAILURE;
+  }
+  if (!ca->CanUse32BitStorage() || !ca->UseSplitStorage(true) ||
+      !ca->IsStorage32Bit() ||
+      !CheckTraversal(ca.GetPointer(), "split32") ||
+      !CheckRandomAccess(ca.GetPointer(), "split32"))
+  {
+    return EXIT_FAILURE;
+  }
+  if (!CheckLegacy(ca.GetPointer(), "split32->legacy"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Native insertion into split storage, including the incremental API.
+  vtkNew<vtkCellArray> split;
+  split->UseSplitStorage(true);
+  split->InsertNextCell(3, TestCells + 1);
+  split->InsertNextCell(4, TestCells + 5);
+  split->InsertNextCell(3);
+  split->InsertCellPoint(6);
+  split->UpdateCellCount(1);
+  split->InsertNextCell(5);
+  for (vtkIdType i = 0; i < 5; ++i)
+  {
+    split->InsertCellPoint(TestCells[12 + i]);
+  }
+  if (!split->IsStorage32Bit() ||
+      !CheckTraversal(split.GetPointer(), "insert32") ||
+      !CheckRandomAccess(split.GetPointer(), "insert32"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Switching to the legacy layout in the middle of a traversal keeps the
+  // traversal position.
+  vtkIdType npts, *pts;
+  split->InitTraversal();
+  split->GetNextCell(npts, pts);
+  split->GetNextCell(npts, pts);
+  if (split->GetTraversalLocation(npts) != 4 ||
+      split->IsStorageSplit() ||
+      !split->GetNextCell(npts, pts) || npts != 1 || pts[0] != 6)
+  {
+    cerr << "Traversal location not preserved by conversion." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Ids that do not fit in 32 bits promote the storage to vtkIdType.
+  split->UseSplitStorage(true);
+  vtkIdType bigId = static_cast<vtkIdType>(VTK_TYPE_INT32_MAX);
+  if (sizeof(vtkIdType) > 4)
+  {
+    ++bigId;
+  }
+  split->InsertNextCell(1, &bigId);
+  if (sizeof(vtkIdType) > 4 && split->IsStorage32Bit())
+  {
+    cerr << "Storage was not promoted for a large id." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkIdList> ids;
+  split->GetCellAtId(NumberOfTestCells, ids.GetPointer());
+  if (ids->GetNumberOfIds() != 1 || ids->GetId(0) != bigId)
+  {
+    cerr << "Wrong large id." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Zero-copy import of 32-bit offsets/connectivity.
+  vtkNew<vtkIntArray> offsets;
+  vtkNew<vtkIntArray> conn;
+  offsets->InsertNextValue(0);
+  for (vtkIdType loc = 0; loc < 17; loc += TestCells[loc] + 1)
+  {
+    for (vtkIdType i = 0; i < TestCells[loc]; ++i)
+    {
+      conn->InsertNextValue(static_cast<int>(TestCells[loc + 1 + i]));
+    }
+    offsets->InsertNextValue(conn->GetNumberOfTuples());
+  }
+  vtkNew<vtkCellArray> imported;
+  if (!imported->SetData(offsets.GetPointer(), conn.GetPointer()) ||
+      imported->GetConnectivityArray() != conn.GetPointer() ||
+      imported->GetOffsetsArray() != offsets.GetPointer() ||
+      !CheckTraversal(imported.GetPointer(), "imported") ||
+      !CheckRandomAccess(imported.GetPointer(), "imported"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Invalid arrays are rejected.
+  vtkSmartPointer<vtkTest::ErrorObserver> errorObserver =
+    vtkSmartPointer<vtkTest::ErrorObserver>::New();
+  imported->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  vtkNew<vtkIntArray> badOffsets;
+  badOffsets->InsertNextValue(0);
+  badOffsets->InsertNextValue(3);
+  if (imported->SetData(badOffsets.GetPointer(), conn.GetPointer()) ||
+      errorObserver->CheckErrorMessage("Offsets array must start with 0") ||
+      imported->GetNumberOfCells() != NumberOfTestCells)
+  {
+    cerr << "Invalid offsets were accepted." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkIntArray> decreasingOffsets;
+  decreasingOffsets->InsertNextValue(0);
+  decreasingOffsets->InsertNextValue(5);
+  decreasingOffsets->InsertNextValue(2);
+  decreasingOffsets->InsertNextValue(conn->GetNumberOfTuples());
+  if (imported->SetData(decreasingOffsets.GetPointer(), conn.GetPointer()) ||
+      errorObserver->CheckErrorMessage("Offsets array must not decrease") ||
+      imported->GetNumberOfCells() != NumberOfTestCells)
+  {
+    cerr << "Decreasing offsets were accepted." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Deep copy and use through vtkPolyData, which relies on the legacy layout.
+  vtkNew<vtkCellArray> copy;
+  copy->DeepCopy(imported.GetPointer());
+  if (!copy->IsStorage32Bit() || !CheckTraversal(copy.GetPointer(), "copy"))
+  {
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 9; ++i)
+  {
+    points->InsertNextPoint(i, i % 3, 0.0);
+  }
+  vtkNew<vtkPolyData> pd;
+  pd->SetPoints(points.GetPointer());
+  pd->SetVerts(copy.GetPointer());
+  pd->BuildCells();
+  pd->GetCellPoints(3, ids.GetPointer());
+  if (pd->GetNumberOfCells() != NumberOfTestCells ||
+      ids->GetNumberOfIds() != 5 || ids->GetId(4) != 8 ||
+      !CheckLegacy(copy.GetPointer(), "polydata"))
+  {
+    cerr << "Polydata access to split cells failed." << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
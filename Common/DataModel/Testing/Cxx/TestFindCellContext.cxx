@@ -0,0 +1,248 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestFindCellContext.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkDataSet::FindCellWithContext(), run concurrently with one
+// context per thread, locates the same cells as FindCell() does.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkFindCellContext.h"
+#include "vtkGenericCell.h"
+#include "vtkImageData.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStructuredGrid.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+const int Res = 8;
+const double Tol2 = 1.0e-6;
+
+// Locate a batch of points with one context per thread.
+struct FindCells
+{
+  vtkDataSet *DataSet;
+  const double *Points;
+  vtkIdType *CellIds;
+  double *Weights; // 8 weights per point
+  vtkSMPThreadLocalObject<vtkFindCellContext> Context;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkFindCellContext *context = this->Context.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      double x[3] = { this->Points[3 * i], this->Points[3 * i + 1],
+                      this->Points[3 * i + 2] };
+      this->CellIds[i] = this->DataSet->FindCellWithContext(x, Tol2, context);
+      if (this->CellIds[i] >= 0)
+      {
+        vtkIdType npts = context->GetCell()->GetNumberOfPoints();
+        for (vtkIdType j = 0; j < npts; ++j)
+        {
+          this->Weights[8 * i + j] = context->GetWeights()[j];
+        }
+      }
+    }
+  }
+};
+
+int TestDataSet(vtkDataSet *ds, vtkMinimalStandardRandomSequence *random)
+{
+  const vtkIdType numQueries = 1000;
+  double bounds[6];
+  ds->GetBounds(bounds);
+  std::vector<double> points(3 * numQueries);
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      double pad = 0.1 * (bounds[2 * c + 1] - bounds[2 * c]);
+      points[3 * i + c] = random->GetRangeValue(bounds[2 * c] - pad,
+                                                bounds[2 * c + 1] + pad);
+      random->Next();
+    }
+  }
+
+  ds->PrepareFindCellWithContext();
+  std::vector<vtkIdType> cellIds(numQueries);
+  std::vector<double> weights(8 * numQueries, 0.0);
+  FindCells find;
+  find.DataSet = ds;
+  find.Points = &points[0];
+  find.CellIds = &cellIds[0];
+  find.Weights = &weights[0];
+  vtkSMPTools::For(0, numQueries, find);
+
+  // Compare with the (serial) FindCell().
+  vtkNew<vtkGenericCell> cell;
+  double pcoords[3], expectedWeights[8];
+  int subId, numFound = 0;
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    vtkIdType cellId = ds->FindCell(&points[3 * i], NULL, cell.Get(), -1,
+                                    Tol2, subId, pcoords, expectedWeights);
+    if (cellId != cellIds[i])
+    {
+      cerr << "Point " << i << ": found cell " << cellIds[i] << " expected "
+           << cellId << endl;
+      return EXIT_FAILURE;
+    }
+    if (cellId < 0)
+    {
+      continue;
+    }
+    numFound++;
+    ds->GetCell(cellId, cell.Get());
+    for (vtkIdType j = 0; j < cell->GetNumberOfPoints(); ++j)
+    {
+      if (fabs(weights[8 * i + j] - expectedWeights[j]) > 1.0e-12)
+      {
+        cerr << "Point " << i << ": weight " << j << " is "
+             << weights[8 * i + j] << " expected " << expectedWeights[j]
+             << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  if (numFound == 0 || numFound == numQueries)
+  {
+    cerr << "Expected points both inside and outside of the dataset, found "
+         << numFound << " inside." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Searching a dataset modified since the preparation is an error.
+  ds->Modified();
+  vtkNew<vtkFindCellContext> context;
+  vtkObject::GlobalWarningDisplayOff();
+  vtkIdType cellId = ds->FindCellWithContext(&points[0], Tol2, context.Get());
+  vtkObject::GlobalWarningDisplayOn();
+  if (cellId != -1 || context->GetCellId() != -1)
+  {
+    cerr << "Searched a dataset that was not prepared." << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+// Points of a Res^3 grid moved by a smooth distortion.
+void MakePoints(vtkPoints *points)
+{
+  for (int k = 0; k <= Res; ++k)
+  {
+    for (int j = 0; j <= Res; ++j)
+    {
+      for (int i = 0; i <= Res; ++i)
+      {
+        double x = i, y = j, z = k;
+        points->InsertNextPoint(x + 0.2 * sin(y + z), y + 0.2 * sin(x * z),
+                                z + 0.1 * cos(x + y));
+      }
+    }
+  }
+}
+
+}
+
+int TestFindCellContext(int, char *[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+
+  vtkNew<vtkPoints> points;
+  MakePoints(points.Get());
+
+  vtkNew<vtkStructuredGrid> sgrid;
+  sgrid->SetDimensions(Res + 1, Res + 1, Res + 1);
+  sgrid->SetPoints(points.Get());
+  if (TestDataSet(sgrid.Get(), random.Get()) != EXIT_SUCCESS)
+  {
+    cerr << "Failure with the structured grid." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkUnstructuredGrid> ugrid;
+  ugrid->SetPoints(points.Get());
+  ugrid->Allocate(Res * Res * Res);
+  const vtkIdType n = Res + 1;
+  for (int k = 0; k < Res; ++k)
+  {
+    for (int j = 0; j < Res; ++j)
+    {
+      for (int i = 0; i < Res; ++i)
+      {
+        vtkIdType p = i + j * n + k * n * n;
+        vtkIdType hex[8] = { p, p + 1, p + 1 + n, p + n, p + n * n,
+                             p + 1 + n * n, p + 1 + n + n * n, p + n + n * n };
+        ugrid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+      }
+    }
+  }
+  if (TestDataSet(ugrid.Get(), random.Get()) != EXIT_SUCCESS)
+  {
+    cerr << "Failure with the unstructured grid." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // The bottom layer of the grid flattened to z = 0, as quads.
+  vtkNew<vtkPolyData> surface;
+  vtkNew<vtkPoints> flatPoints;
+  vtkNew<vtkCellArray> quads;
+  for (vtkIdType i = 0; i < n * n; ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    flatPoints->InsertNextPoint(x[0], x[1], 0.0);
+  }
+  for (int j = 0; j < Res; ++j)
+  {
+    for (int i = 0; i < Res; ++i)
+    {
+      vtkIdType p = i + j * n;
+      vtkIdType quad[4] = { p, p + 1, p + 1 + n, p + n };
+      quads->InsertNextCell(4, quad);
+    }
+  }
+  surface->SetPoints(flatPoints.Get());
+  surface->SetPolys(quads.Get());
+  if (TestDataSet(surface.Get(), random.Get()) != EXIT_SUCCESS)
+  {
+    cerr << "Failure with the polygonal surface." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, Res, -2, Res, 0, Res / 2);
+  image->SetOrigin(0.5, 0.0, -1.0);
+  image->SetSpacing(0.5, 1.0, 2.0);
+  if (TestDataSet(image.Get(), random.Get()) != EXIT_SUCCESS)
+  {
+    cerr << "Failure with the image." << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,316 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the queries of vtkStaticCellLocator against brute force searches
+// over the cells of a distorted hexahedral mesh and of a triangle mesh, and
+// that FindCell() finds the cells within the tolerance of points lying in
+// other bins.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkTriangle.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+const int Res = 8;
+
+// A grid of Res^3 hexahedra whose points are moved by a smooth distortion.
+void MakeGrid(vtkUnstructuredGrid *grid)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= Res; ++k)
+  {
+    for (int j = 0; j <= Res; ++j)
+    {
+      for (int i = 0; i <= Res; ++i)
+      {
+        double x = i, y = j, z = k;
+        points->InsertNextPoint(x + 0.2 * sin(y + z), y + 0.2 * sin(x * z),
+                                0.5 * z + 0.1 * cos(x + y));
+      }
+    }
+  }
+  grid->SetPoints(points.Get());
+  grid->Allocate(Res * Res * Res);
+  const vtkIdType n = Res + 1;
+  for (int k = 0; k < Res; ++k)
+  {
+    for (int j = 0; j < Res; ++j)
+    {
+      for (int i = 0; i < Res; ++i)
+      {
+        vtkIdType p = i + j * n + k * n * n;
+        vtkIdType hex[8] = { p, p + 1, p + 1 + n, p + n, p + n * n,
+                             p + 1 + n * n, p + 1 + n + n * n, p + n + n * n };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+      }
+    }
+  }
+}
+
+void RandomPoint(vtkMinimalStandardRandomSequence *random,
+                 const double bounds[6], double x[3])
+{
+  for (int c = 0; c < 3; ++c)
+  {
+    x[c] = random->GetRangeValue(bounds[2 * c], bounds[2 * c + 1]);
+    random->Next();
+  }
+}
+
+int TestDataSet(vtkDataSet *ds, vtkMinimalStandardRandomSequence *random)
+{
+  vtkNew<vtkStaticCellLocator> locator;
+  locator->SetDataSet(ds);
+  locator->BuildLocator();
+  if (locator->GetLargeIds())
+  {
+    cerr << "Unexpected large ids." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkGenericCell> cell;
+  std::vector<double> weights(ds->GetMaxCellSize());
+  double bounds[6], queryBounds[6], x[3], pcoords[3], closest[3], dist2;
+  int subId;
+  ds->GetBounds(bounds);
+  for (int c = 0; c < 3; ++c)
+  {
+    double pad = 0.2 * (bounds[2 * c + 1] - bounds[2 * c]) + 0.1;
+    queryBounds[2 * c] = bounds[2 * c] - pad;
+    queryBounds[2 * c + 1] = bounds[2 * c + 1] + pad;
+  }
+  const vtkIdType numCells = ds->GetNumberOfCells();
+
+  for (int q = 0; q < 500; ++q)
+  {
+    RandomPoint(random, queryBounds, x);
+
+    // FindCell: compare with the cells containing the point.
+    const double tol2 = 0.0025;
+    vtkIdType cellId =
+      locator->FindCell(x, tol2, cell.Get(), pcoords, &weights[0]);
+    vtkIdType expectedId = -1;
+    for (vtkIdType c = 0; c < numCells && expectedId < 0; ++c)
+    {
+      ds->GetCell(c, cell.Get());
+      if (cell->EvaluatePosition(x, closest, subId, pcoords, dist2,
+                                 &weights[0]) == 1 && dist2 <= tol2)
+      {
+        expectedId = c;
+      }
+    }
+    if ((cellId < 0) != (expectedId < 0))
+    {
+      cerr << "FindCell: found " << cellId << " expected " << expectedId
+           << endl;
+      return EXIT_FAILURE;
+    }
+
+    // FindClosestPoint: compare the distance with the closest cell.
+    double minDist2 = VTK_DOUBLE_MAX;
+    for (vtkIdType c = 0; c < numCells; ++c)
+    {
+      ds->GetCell(c, cell.Get());
+      if (cell->EvaluatePosition(x, closest, subId, pcoords, dist2,
+                                 &weights[0]) != -1 && dist2 < minDist2)
+      {
+        minDist2 = dist2;
+      }
+    }
+    locator->FindClosestPoint(x, closest, cell.Get(), cellId, subId, dist2);
+    if (cellId < 0 || fabs(dist2 - minDist2) > 1e-9 * (1.0 + minDist2))
+    {
+      cerr << "FindClosestPoint: distance " << dist2 << " expected "
+           << minDist2 << endl;
+      return EXIT_FAILURE;
+    }
+
+    // IntersectWithLine: compare with the first cell along the line.
+    double p2[3], t, tMin = VTK_DOUBLE_MAX, xHit[3];
+    RandomPoint(random, queryBounds, p2);
+    for (vtkIdType c = 0; c < numCells; ++c)
+    {
+      ds->GetCell(c, cell.Get());
+      if (cell->IntersectWithLine(x, p2, 0.0, t, xHit, pcoords, subId) &&
+          t < tMin)
+      {
+        tMin = t;
+      }
+    }
+    int hit = locator->IntersectWithLine(x, p2, 0.0, t, xHit, pcoords, subId,
+                                         cellId, cell.Get());
+    if (hit != (tMin < VTK_DOUBLE_MAX) || (hit && fabs(t - tMin) > 1e-9))
+    {
+      cerr << "IntersectWithLine: t " << t << " expected " << tMin << endl;
+      return EXIT_FAILURE;
+    }
+
+    // FindCellsWithinBounds: compare with the cell bounds overlapping.
+    double bbox[6], cellBounds[6];
+    for (int c = 0; c < 3; ++c)
+    {
+      bbox[2 * c] = x[c] - 0.7;
+      bbox[2 * c + 1] = x[c] + 0.7;
+    }
+    vtkNew<vtkIdList> cells;
+    locator->FindCellsWithinBounds(bbox, cells.Get());
+    vtkIdType numOverlapping = 0;
+    for (vtkIdType c = 0; c < numCells; ++c)
+    {
+      ds->GetCellBounds(c, cellBounds);
+      if (cellBounds[0] <= bbox[1] && cellBounds[1] >= bbox[0] &&
+          cellBounds[2] <= bbox[3] && cellBounds[3] >= bbox[2] &&
+          cellBounds[4] <= bbox[5] && cellBounds[5] >= bbox[4])
+      {
+        numOverlapping++;
+      }
+    }
+    if (cells->GetNumberOfIds() != numOverlapping)
+    {
+      cerr << "FindCellsWithinBounds: found " << cells->GetNumberOfIds()
+           << " expected " << numOverlapping << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+// Points off a tilted triangle mesh by less than the tolerance may lie in
+// other bins than the triangles containing their projection.
+int TestTolerance(vtkPolyData *surface, vtkMinimalStandardRandomSequence *random)
+{
+  vtkNew<vtkStaticCellLocator> locator;
+  locator->SetDataSet(surface);
+  locator->BuildLocator();
+
+  vtkNew<vtkGenericCell> cell;
+  double pcoords[3], weights[3], closest[3], dist2, x[3];
+  int subId;
+  const double tol2 = 0.0025;
+  const double offset = 0.9 * sqrt(tol2);
+  for (vtkIdType c = 0; c < surface->GetNumberOfCells(); ++c)
+  {
+    surface->GetCell(c, cell.Get());
+    double p[3][3], normal[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      cell->GetPoints()->GetPoint(i, p[i]);
+    }
+    vtkTriangle::ComputeNormal(p[0], p[1], p[2], normal);
+    for (int q = 0; q < 20; ++q)
+    {
+      double a = random->GetValue();
+      random->Next();
+      double b = random->GetValue() * (1.0 - a);
+      random->Next();
+      double side = (q % 2) ? offset : -offset;
+      for (int i = 0; i < 3; ++i)
+      {
+        x[i] = p[0][i] + a * (p[1][i] - p[0][i]) + b * (p[2][i] - p[0][i]) +
+          side * normal[i];
+      }
+      vtkIdType cellId =
+        locator->FindCell(x, tol2, cell.Get(), pcoords, weights);
+      if (cellId < 0 ||
+          cell->EvaluatePosition(x, closest, subId, pcoords, dist2,
+                                 weights) != 1 || dist2 > tol2)
+      {
+        cerr << "FindCell: no cell within the tolerance of a point off cell "
+             << c << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int TestStaticCellLocator(int, char *[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid.Get());
+  if (TestDataSet(grid.Get(), random.Get()) != EXIT_SUCCESS)
+  {
+    cerr << "Failure with the hexahedral mesh." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // A triangulated height field, flat in z.
+  vtkNew<vtkPolyData> surface;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> triangles;
+  for (int j = 0; j <= Res; ++j)
+  {
+    for (int i = 0; i <= Res; ++i)
+    {
+      points->InsertNextPoint(i, j + 0.3 * sin(static_cast<double>(i)), 0.0);
+    }
+  }
+  for (int j = 0; j < Res; ++j)
+  {
+    for (int i = 0; i < Res; ++i)
+    {
+      vtkIdType p = i + j * (Res + 1);
+      vtkIdType tri0[3] = { p, p + 1, p + Res + 2 };
+      vtkIdType tri1[3] = { p, p + Res + 2, p + Res + 1 };
+      triangles->InsertNextCell(3, tri0);
+      triangles->InsertNextCell(3, tri1);
+    }
+  }
+  surface->SetPoints(points.Get());
+  surface->SetPolys(triangles.Get());
+  if (TestDataSet(surface.Get(), random.Get()) != EXIT_SUCCESS)
+  {
+    cerr << "Failure with the triangle mesh." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // The same mesh, tilted by 45 degrees about the x axis.
+  vtkNew<vtkPoints> tiltedPoints;
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    tiltedPoints->InsertNextPoint(x[0], x[1], x[1]);
+  }
+  vtkNew<vtkPolyData> tilted;
+  tilted->SetPoints(tiltedPoints.Get());
+  tilted->SetPolys(triangles.Get());
+  if (TestTolerance(tilted.Get(), random.Get()) != EXIT_SUCCESS)
+  {
+    cerr << "Failure with the tilted triangle mesh." << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,169 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticPointLocatorBatch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the batch queries of vtkStaticPointLocator against the queries of
+// single points.
+
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticPointLocator.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+void RandomPoints(vtkMinimalStandardRandomSequence *random, vtkIdType num,
+                  vtkPoints *points)
+{
+  points->SetNumberOfPoints(num);
+  for (vtkIdType i = 0; i < num; ++i)
+  {
+    double x[3];
+    for (int c = 0; c < 3; ++c)
+    {
+      x[c] = random->GetRangeValue(-1.0, 1.0);
+      random->Next();
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+}
+
+int TestStaticPointLocatorBatch(int, char *[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+
+  vtkNew<vtkPoints> points;
+  RandomPoints(random.Get(), 5000, points.Get());
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points.Get());
+
+  vtkNew<vtkPoints> queryPts;
+  RandomPoints(random.Get(), 1000, queryPts.Get());
+  const vtkIdType numQueryPts = queryPts->GetNumberOfPoints();
+
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(polyData.Get());
+  locator->BuildLocator();
+
+  // Closest point. Ties are not expected with random points.
+  vtkNew<vtkIdTypeArray> closest;
+  locator->FindClosestPoints(queryPts.Get(), closest.Get());
+  if (closest->GetNumberOfTuples() != numQueryPts)
+  {
+    cerr << "Wrong number of closest points." << endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < numQueryPts; ++i)
+  {
+    if (closest->GetValue(i) !=
+        locator->FindClosestPoint(queryPts->GetPoint(i)))
+    {
+      cerr << "Wrong closest point for query " << i << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Closest N points.
+  const int N = 7;
+  vtkNew<vtkIdTypeArray> closestN;
+  vtkNew<vtkIdList> ids;
+  locator->FindClosestNPoints(N, queryPts.Get(), closestN.Get());
+  if (closestN->GetNumberOfComponents() != N ||
+      closestN->GetNumberOfTuples() != numQueryPts)
+  {
+    cerr << "Wrong shape of the closest N points." << endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < numQueryPts; ++i)
+  {
+    locator->FindClosestNPoints(N, queryPts->GetPoint(i), ids.Get());
+    for (int j = 0; j < N; ++j)
+    {
+      if (closestN->GetComponent(i, j) != ids->GetId(j))
+      {
+        cerr << "Wrong closest N points for query " << i << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Points within a radius, in CSR layout.
+  const double radius = 0.15;
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> radiusIds;
+  vtkIdType numIds = locator->FindPointsWithinRadius(
+    radius, queryPts.Get(), offsets.Get(), radiusIds.Get());
+  if (offsets->GetNumberOfTuples() != numQueryPts + 1 ||
+      offsets->GetValue(numQueryPts) != numIds ||
+      radiusIds->GetNumberOfTuples() != numIds || numIds == 0)
+  {
+    cerr << "Wrong layout of the points within radius." << endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < numQueryPts; ++i)
+  {
+    locator->FindPointsWithinRadius(radius, queryPts->GetPoint(i), ids.Get());
+    std::vector<vtkIdType> expected(ids->GetPointer(0),
+                                    ids->GetPointer(0) + ids->GetNumberOfIds());
+    std::vector<vtkIdType> found(
+      radiusIds->GetPointer(offsets->GetValue(i)),
+      radiusIds->GetPointer(0) + offsets->GetValue(i + 1));
+    std::sort(expected.begin(), expected.end());
+    std::sort(found.begin(), found.end());
+    if (expected != found)
+    {
+      cerr << "Wrong points within radius for query " << i << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Counting only.
+  vtkNew<vtkIdTypeArray> counts;
+  if (locator->FindPointsWithinRadius(radius, queryPts.Get(), counts.Get(),
+                                      NULL) != numIds ||
+      counts->GetValue(numQueryPts / 2) != offsets->GetValue(numQueryPts / 2))
+  {
+    cerr << "Wrong counts of points within radius." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // More neighbors requested than there are points.
+  vtkNew<vtkPoints> fewPoints;
+  RandomPoints(random.Get(), 3, fewPoints.Get());
+  vtkNew<vtkPolyData> fewData;
+  fewData->SetPoints(fewPoints.Get());
+  locator->SetDataSet(fewData.Get());
+  locator->FindClosestNPoints(5, queryPts.Get(), closestN.Get());
+  for (vtkIdType i = 0; i < numQueryPts; ++i)
+  {
+    double *tuple = closestN->GetTuple(i);
+    if (tuple[0] < 0 || tuple[2] < 0 || tuple[3] != -1 || tuple[4] != -1)
+    {
+      cerr << "Wrong padding of the closest N points." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
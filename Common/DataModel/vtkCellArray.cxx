@@ -13,10 +13,150 @@
 
 =========================================================================*/
 #include "vtkCellArray.h"
+
+#include "vtkAOSDataArrayTemplate.h"
 #include "vtkObjectFactory.h"
+#include "vtkTypeInt32Array.h"
+
+#include <algorithm>
 
 vtkStandardNewMacro(vtkCellArray);
 
+namespace
+{
+
+typedef vtkAOSDataArrayTemplate<vtkIdType> vtkCellArrayIds64;
+typedef vtkAOSDataArrayTemplate<vtkTypeInt32> vtkCellArrayIds32;
+
+//----------------------------------------------------------------------------
+// Create an empty split storage array for the given storage type.
+vtkDataArray* vtkCellArrayNewSplitArray(int storageType)
+{
+  if (storageType == vtkCellArray::SPLIT_STORAGE_32)
+  {
+    return vtkTypeInt32Array::New();
+  }
+  return vtkIdTypeArray::New();
+}
+
+//----------------------------------------------------------------------------
+// Fill split storage arrays from the legacy (n,id1,id2,...) layout. Also
+// maps the legacy traversal location onto a cell id.
+template <typename ValueType>
+void vtkCellArrayLegacyToSplit(const vtkIdType *legacy, vtkIdType numCells,
+                               vtkAOSDataArrayTemplate<ValueType> *offsets,
+                               vtkAOSDataArrayTemplate<ValueType> *conn,
+                               vtkIdType &traversal)
+{
+  offsets->SetNumberOfValues(numCells + 1);
+  conn->SetNumberOfValues(0);
+  ValueType *o = offsets->GetPointer(0);
+  vtkIdType connSize = 0, loc = 0, newTraversal = numCells;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    if (loc == traversal)
+    {
+      newTraversal = cellId;
+    }
+    o[cellId] = static_cast<ValueType>(connSize);
+    vtkIdType npts = legacy[loc];
+    connSize += npts;
+    loc += npts + 1;
+  }
+  o[numCells] = static_cast<ValueType>(connSize);
+  traversal = newTraversal;
+
+  ValueType *c = conn->WritePointer(0, connSize);
+  for (vtkIdType cellId = 0, loc2 = 0; cellId < numCells; ++cellId)
+  {
+    vtkIdType npts = legacy[loc2++];
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      *c++ = static_cast<ValueType>(legacy[loc2++]);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Fill the legacy layout from split storage arrays. Also maps the traversal
+// cell id onto a legacy location.
+template <typename ValueType>
+void vtkCellArraySplitToLegacy(vtkAOSDataArrayTemplate<ValueType> *offsets,
+                               vtkAOSDataArrayTemplate<ValueType> *conn,
+                               vtkIdType numCells, vtkIdTypeArray *legacy,
+                               vtkIdType &traversal)
+{
+  const ValueType *o = offsets->GetPointer(0);
+  const ValueType *c = conn->GetPointer(0);
+  vtkIdType *l = legacy->WritePointer(0, conn->GetNumberOfValues() + numCells);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    vtkIdType npts = static_cast<vtkIdType>(o[cellId + 1] - o[cellId]);
+    *l++ = npts;
+    for (vtkIdType i = o[cellId]; i < o[cellId + 1]; ++i)
+    {
+      *l++ = static_cast<vtkIdType>(c[i]);
+    }
+  }
+  traversal = (traversal < numCells ? traversal : numCells);
+  traversal = static_cast<vtkIdType>(o[traversal]) + traversal;
+}
+
+//----------------------------------------------------------------------------
+template <typename ValueType>
+void vtkCellArrayInsertSplit(vtkAOSDataArrayTemplate<ValueType> *offsets,
+                             vtkAOSDataArrayTemplate<ValueType> *conn,
+                             vtkIdType npts, const vtkIdType *pts)
+{
+  vtkIdType loc = conn->GetNumberOfValues();
+  ValueType *ptr = conn->WritePointer(loc, npts);
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    ptr[i] = static_cast<ValueType>(pts[i]);
+  }
+  offsets->InsertNextValue(static_cast<ValueType>(loc + npts));
+}
+
+//----------------------------------------------------------------------------
+// Incremental insertion (InsertNextCell(int)/InsertCellPoint()) into split
+// storage: the last offset always tracks the end of the connectivity.
+template <typename ValueType>
+void vtkCellArrayInsertSplitPoint(vtkAOSDataArrayTemplate<ValueType> *offsets,
+                                  vtkAOSDataArrayTemplate<ValueType> *conn,
+                                  vtkIdType id)
+{
+  conn->InsertNextValue(static_cast<ValueType>(id));
+  offsets->SetValue(offsets->GetNumberOfValues() - 1,
+                    static_cast<ValueType>(conn->GetNumberOfValues()));
+}
+
+//----------------------------------------------------------------------------
+// Functor checking that the ids of a split or legacy array fit in 32 bits.
+struct vtkCellArrayFits32Bit
+{
+  bool Fits;
+  vtkCellArrayFits32Bit() : Fits(true) {}
+
+  template <typename ArrayT>
+  void operator()(ArrayT *array)
+  {
+    typedef typename ArrayT::ValueType ValueType;
+    vtkIdType numValues = array->GetNumberOfValues();
+    for (vtkIdType i = 0; i < numValues; ++i)
+    {
+      ValueType v = array->GetValue(i);
+      if (v < static_cast<ValueType>(VTK_TYPE_INT32_MIN) ||
+          v > static_cast<ValueType>(VTK_TYPE_INT32_MAX))
+      {
+        this->Fits = false;
+        return;
+      }
+    }
+  }
+};
+
+} // end anon namespace
+
 //----------------------------------------------------------------------------
 vtkCellArray::vtkCellArray()
 {
@@ -24,6 +164,10 @@ vtkCellArray::vtkCellArray()
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+  this->StorageType = LEGACY_STORAGE;
+  this->Offsets = NULL;
+  this->Connectivity = NULL;
+  this->TempCell = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -35,7 +179,16 @@ void vtkCellArray::DeepCopy (vtkCellArray *ca)
     return;
   }
 
+  this->ReleaseSplitStorage();
   this->Ia->DeepCopy(ca->Ia);
+  if (ca->StorageType != LEGACY_STORAGE)
+  {
+    this->StorageType = ca->StorageType;
+    this->Offsets = vtkCellArrayNewSplitArray(this->StorageType);
+    this->Offsets->DeepCopy(ca->Offsets);
+    this->Connectivity = vtkCellArrayNewSplitArray(this->StorageType);
+    this->Connectivity->DeepCopy(ca->Connectivity);
+  }
   this->NumberOfCells = ca->NumberOfCells;
   this->InsertLocation = ca->InsertLocation;
   this->TraversalLocation = ca->TraversalLocation;
@@ -45,17 +198,84 @@ void vtkCellArray::DeepCopy (vtkCellArray *ca)
 vtkCellArray::~vtkCellArray()
 {
   this->Ia->Delete();
+  this->ReleaseSplitStorage();
+  if (this->TempCell)
+  {
+    this->TempCell->Delete();
+  }
 }
 
 //----------------------------------------------------------------------------
 void vtkCellArray::Initialize()
 {
   this->Ia->Initialize();
+  if (this->StorageType != LEGACY_STORAGE)
+  {
+    this->Offsets->Initialize();
+    this->Offsets->InsertTuple1(0, 0);
+    this->Connectivity->Initialize();
+  }
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
 }
 
+//----------------------------------------------------------------------------
+void vtkCellArray::Reset()
+{
+  this->NumberOfCells = 0;
+  this->InsertLocation = 0;
+  this->TraversalLocation = 0;
+  this->Ia->Reset();
+  if (this->StorageType != LEGACY_STORAGE)
+  {
+    this->Offsets->Reset();
+    this->Offsets->InsertTuple1(0, 0);
+    this->Connectivity->Reset();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkCellArray::Allocate(const vtkIdType sz, const int ext)
+{
+  if (this->StorageType != LEGACY_STORAGE)
+  {
+    return this->Connectivity->Allocate(sz, ext);
+  }
+  return this->Ia->Allocate(sz, ext);
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::Squeeze()
+{
+  this->Ia->Squeeze();
+  if (this->StorageType != LEGACY_STORAGE)
+  {
+    this->Offsets->Squeeze();
+    this->Connectivity->Squeeze();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetSize()
+{
+  if (this->StorageType != LEGACY_STORAGE)
+  {
+    return this->Offsets->GetSize() + this->Connectivity->GetSize();
+  }
+  return this->Ia->GetSize();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetNumberOfConnectivityEntries()
+{
+  if (this->StorageType != LEGACY_STORAGE)
+  {
+    return this->Connectivity->GetNumberOfTuples() + this->NumberOfCells;
+  }
+  return this->Ia->GetMaxId() + 1;
+}
+
 //----------------------------------------------------------------------------
 // Returns the size of the largest cell. The size is the number of points
 // defining the cell.
@@ -64,6 +284,18 @@ int vtkCellArray::GetMaxCellSize()
   int npts=0, maxSize=0;
   vtkIdType i;
 
+  if (this->StorageType != LEGACY_STORAGE)
+  {
+    for (i=0; i < this->NumberOfCells; ++i)
+    {
+      if ( (npts=static_cast<int>(this->GetCellSize(i))) > maxSize )
+      {
+        maxSize = npts;
+      }
+    }
+    return maxSize;
+  }
+
   for (i=0; i<this->Ia->GetMaxId(); i+=(npts+1))
   {
     if ( (npts=this->Ia->GetValue(i)) > maxSize )
@@ -81,6 +313,7 @@ void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
   if ( cells && cells != this->Ia )
   {
     this->Modified();
+    this->ReleaseSplitStorage();
     this->Ia->Delete();
     this->Ia = cells;
     this->Ia->Register(this);
@@ -94,7 +327,13 @@ void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
 //----------------------------------------------------------------------------
 unsigned long vtkCellArray::GetActualMemorySize()
 {
-  return this->Ia->GetActualMemorySize();
+  unsigned long size = this->Ia->GetActualMemorySize();
+  if (this->StorageType != LEGACY_STORAGE)
+  {
+    size += this->Offsets->GetActualMemorySize() +
+      this->Connectivity->GetActualMemorySize();
+  }
+  return size;
 }
 
 //----------------------------------------------------------------------------
@@ -116,6 +355,11 @@ int vtkCellArray::GetNextCell(vtkIdList *pts)
 //----------------------------------------------------------------------------
 void vtkCellArray::GetCell(vtkIdType loc, vtkIdList *pts)
 {
+  if (this->StorageType != LEGACY_STORAGE)
+  {
+    this->GetCellAtId(this->GetCellIdFromLegacyLocation(loc), pts);
+    return;
+  }
   vtkIdType npts = this->Ia->GetValue(loc++);
   vtkIdType *ppts = this->Ia->GetPointer(loc);
   pts->SetNumberOfIds(npts);
@@ -131,6 +375,445 @@ void vtkCellArray::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "Number Of Cells: " << this->NumberOfCells << endl;
+  os << indent << "Storage Type: "
+     << (this->StorageType == SPLIT_STORAGE_32 ? "Split (32-bit)" :
+         this->StorageType == SPLIT_STORAGE_64 ? "Split (vtkIdType)" :
+         "Legacy") << endl;
   os << indent << "Insert Location: " << this->InsertLocation << endl;
   os << indent << "Traversal Location: " << this->TraversalLocation << endl;
 }
+
+//----------------------------------------------------------------------------
+void vtkCellArray::ReleaseSplitStorage()
+{
+  if (this->Offsets)
+  {
+    this->Offsets->Delete();
+    this->Offsets = NULL;
+  }
+  if (this->Connectivity)
+  {
+    this->Connectivity->Delete();
+    this->Connectivity = NULL;
+  }
+  this->StorageType = LEGACY_STORAGE;
+}
+
+//----------------------------------------------------------------------------
+bool vtkCellArray::SetData(vtkDataArray *offsets, vtkDataArray *connectivity)
+{
+  if (!offsets || !connectivity ||
+      offsets->GetNumberOfComponents() != 1 ||
+      connectivity->GetNumberOfComponents() != 1 ||
+      offsets->GetNumberOfTuples() < 1)
+  {
+    vtkErrorMacro("Offsets and connectivity arrays must be single component"
+                  " arrays, and offsets must hold at least one value.");
+    return false;
+  }
+  if (offsets->GetComponent(0, 0) != 0.0 ||
+      static_cast<vtkIdType>(
+        offsets->GetComponent(offsets->GetNumberOfTuples() - 1, 0)) !=
+      connectivity->GetNumberOfTuples())
+  {
+    vtkErrorMacro("Offsets array must start with 0 and end with the size of"
+                  " the connectivity array.");
+    return false;
+  }
+  for (vtkIdType i = 1; i < offsets->GetNumberOfTuples(); ++i)
+  {
+    if (offsets->GetComponent(i, 0) < offsets->GetComponent(i - 1, 0))
+    {
+      vtkErrorMacro("Offsets array must not decrease (offset " << i << ").");
+      return false;
+    }
+  }
+
+  offsets->Register(this);
+  connectivity->Register(this);
+  this->ReleaseSplitStorage();
+  this->Ia->Delete();
+  this->Ia = vtkIdTypeArray::New();
+
+  if (vtkArrayDownCast<vtkCellArrayIds64>(offsets) &&
+      vtkArrayDownCast<vtkCellArrayIds64>(connectivity))
+  {
+    this->StorageType = SPLIT_STORAGE_64;
+    this->Offsets = offsets;
+    this->Connectivity = connectivity;
+  }
+  else if (vtkArrayDownCast<vtkCellArrayIds32>(offsets) &&
+           vtkArrayDownCast<vtkCellArrayIds32>(connectivity))
+  {
+    this->StorageType = SPLIT_STORAGE_32;
+    this->Offsets = offsets;
+    this->Connectivity = connectivity;
+  }
+  else
+  {
+    // Other integral types: copy into vtkIdType storage.
+    this->StorageType = SPLIT_STORAGE_64;
+    this->Offsets = vtkIdTypeArray::New();
+    this->Offsets->DeepCopy(offsets);
+    this->Connectivity = vtkIdTypeArray::New();
+    this->Connectivity->DeepCopy(connectivity);
+    offsets->UnRegister(this);
+    connectivity->UnRegister(this);
+  }
+
+  this->NumberOfCells = this->Offsets->GetNumberOfTuples() - 1;
+  this->InsertLocation = 0;
+  this->TraversalLocation = 0;
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArray* vtkCellArray::GetOffsetsArray()
+{
+  if (this->StorageType == LEGACY_STORAGE)
+  {
+    this->UseSplitStorage(false);
+  }
+  return this->Offsets;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArray* vtkCellArray::GetConnectivityArray()
+{
+  if (this->StorageType == LEGACY_STORAGE)
+  {
+    this->UseSplitStorage(false);
+  }
+  return this->Connectivity;
+}
+
+//----------------------------------------------------------------------------
+bool vtkCellArray::CanUse32BitStorage()
+{
+  if (this->StorageType == SPLIT_STORAGE_32)
+  {
+    return true;
+  }
+
+  vtkIdType connSize = this->GetNumberOfConnectivityEntries() -
+    this->NumberOfCells;
+  if (connSize > VTK_TYPE_INT32_MAX)
+  {
+    return false;
+  }
+
+  vtkCellArrayFits32Bit worker;
+  worker(this->StorageType == LEGACY_STORAGE ?
+         static_cast<vtkCellArrayIds64*>(this->Ia) :
+         static_cast<vtkCellArrayIds64*>(this->Connectivity));
+  return worker.Fits;
+}
+
+//----------------------------------------------------------------------------
+bool vtkCellArray::UseSplitStorage(bool use32BitIds)
+{
+  int storageType = SPLIT_STORAGE_64;
+  if (use32BitIds && this->CanUse32BitStorage())
+  {
+    storageType = SPLIT_STORAGE_32;
+  }
+  bool result = (use32BitIds == (storageType == SPLIT_STORAGE_32));
+  if (storageType == this->StorageType)
+  {
+    return result;
+  }
+
+  vtkDataArray *offsets = vtkCellArrayNewSplitArray(storageType);
+  vtkDataArray *conn = vtkCellArrayNewSplitArray(storageType);
+  if (this->StorageType == LEGACY_STORAGE)
+  {
+    const vtkIdType *legacy = this->Ia->GetPointer(0);
+    if (storageType == SPLIT_STORAGE_32)
+    {
+      vtkCellArrayLegacyToSplit(legacy, this->NumberOfCells,
+        static_cast<vtkCellArrayIds32*>(offsets),
+        static_cast<vtkCellArrayIds32*>(conn), this->TraversalLocation);
+    }
+    else
+    {
+      vtkCellArrayLegacyToSplit(legacy, this->NumberOfCells,
+        static_cast<vtkCellArrayIds64*>(offsets),
+        static_cast<vtkCellArrayIds64*>(conn), this->TraversalLocation);
+    }
+    // Do not release the memory in place: the array may be shared.
+    this->Ia->Delete();
+    this->Ia = vtkIdTypeArray::New();
+  }
+  else
+  {
+    // Switching between 32-bit and 64-bit split storage.
+    offsets->DeepCopy(this->Offsets);
+    conn->DeepCopy(this->Connectivity);
+    this->ReleaseSplitStorage();
+  }
+
+  this->StorageType = storageType;
+  this->Offsets = offsets;
+  this->Connectivity = conn;
+  this->InsertLocation = 0;
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::ConvertToLegacyStorage()
+{
+  vtkIdTypeArray *legacy = vtkIdTypeArray::New();
+  if (this->StorageType == SPLIT_STORAGE_32)
+  {
+    vtkCellArraySplitToLegacy(
+      static_cast<vtkCellArrayIds32*>(this->Offsets),
+      static_cast<vtkCellArrayIds32*>(this->Connectivity),
+      this->NumberOfCells, legacy, this->TraversalLocation);
+  }
+  else
+  {
+    vtkCellArraySplitToLegacy(
+      static_cast<vtkCellArrayIds64*>(this->Offsets),
+      static_cast<vtkCellArrayIds64*>(this->Connectivity),
+      this->NumberOfCells, legacy, this->TraversalLocation);
+  }
+  this->ReleaseSplitStorage();
+  this->Ia->Delete();
+  this->Ia = legacy;
+  this->InsertLocation = legacy->GetMaxId() + 1;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetCellSize(vtkIdType cellId)
+{
+  if (this->StorageType == LEGACY_STORAGE)
+  {
+    this->UseSplitStorage(false);
+  }
+  if (this->StorageType == SPLIT_STORAGE_32)
+  {
+    const vtkTypeInt32 *o =
+      static_cast<vtkCellArrayIds32*>(this->Offsets)->GetPointer(cellId);
+    return static_cast<vtkIdType>(o[1] - o[0]);
+  }
+  const vtkIdType *o =
+    static_cast<vtkCellArrayIds64*>(this->Offsets)->GetPointer(cellId);
+  return o[1] - o[0];
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdList *pts)
+{
+  if (this->StorageType == LEGACY_STORAGE)
+  {
+    this->UseSplitStorage(false);
+  }
+  if (this->StorageType == SPLIT_STORAGE_32)
+  {
+    const vtkTypeInt32 *o =
+      static_cast<vtkCellArrayIds32*>(this->Offsets)->GetPointer(cellId);
+    const vtkTypeInt32 *c =
+      static_cast<vtkCellArrayIds32*>(this->Connectivity)->GetPointer(0);
+    vtkIdType npts = static_cast<vtkIdType>(o[1] - o[0]);
+    vtkIdType *ids = pts->WritePointer(0, npts);
+    pts->SetNumberOfIds(npts);
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      ids[i] = static_cast<vtkIdType>(c[o[0] + i]);
+    }
+    return;
+  }
+  const vtkIdType *o =
+    static_cast<vtkCellArrayIds64*>(this->Offsets)->GetPointer(cellId);
+  vtkIdType npts = o[1] - o[0];
+  const vtkIdType *c =
+    static_cast<vtkCellArrayIds64*>(this->Connectivity)->GetPointer(o[0]);
+  vtkIdType *ids = pts->WritePointer(0, npts);
+  pts->SetNumberOfIds(npts);
+  std::copy(c, c + npts, ids);
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType &npts,
+                               const vtkIdType* &pts, vtkIdList *ptIds)
+{
+  if (this->StorageType == LEGACY_STORAGE)
+  {
+    this->UseSplitStorage(false);
+  }
+  if (this->StorageType == SPLIT_STORAGE_32)
+  {
+    this->GetCellAtId(cellId, ptIds);
+    npts = ptIds->GetNumberOfIds();
+    pts = ptIds->GetPointer(0);
+    return;
+  }
+  const vtkIdType *o =
+    static_cast<vtkCellArrayIds64*>(this->Offsets)->GetPointer(cellId);
+  npts = o[1] - o[0];
+  pts = static_cast<vtkCellArrayIds64*>(this->Connectivity)->GetPointer(o[0]);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetLegacyLocation(vtkIdType cellId)
+{
+  if (this->StorageType == LEGACY_STORAGE)
+  {
+    vtkIdType loc = 0;
+    const vtkIdType *legacy = this->Ia->GetPointer(0);
+    for (vtkIdType i = 0; i < cellId; ++i)
+    {
+      loc += legacy[loc] + 1;
+    }
+    return loc;
+  }
+  // Each cell takes its size plus one entry in the legacy layout.
+  return static_cast<vtkIdType>(this->Offsets->GetComponent(cellId, 0)) +
+    cellId;
+}
+
+//----------------------------------------------------------------------------
+// Binary search of the cell whose legacy location is loc: the legacy
+// location of cell i is Offsets[i] + i, which strictly increases with i.
+vtkIdType vtkCellArray::GetCellIdFromLegacyLocation(vtkIdType loc)
+{
+  vtkIdType low = 0, high = this->NumberOfCells;
+  if (this->StorageType == SPLIT_STORAGE_32)
+  {
+    const vtkTypeInt32 *o =
+      static_cast<vtkCellArrayIds32*>(this->Offsets)->GetPointer(0);
+    while (low < high)
+    {
+      vtkIdType mid = low + (high - low) / 2;
+      if (static_cast<vtkIdType>(o[mid]) + mid < loc)
+      {
+        low = mid + 1;
+      }
+      else
+      {
+        high = mid;
+      }
+    }
+    return low;
+  }
+  const vtkIdType *o =
+    static_cast<vtkCellArrayIds64*>(this->Offsets)->GetPointer(0);
+  while (low < high)
+  {
+    vtkIdType mid = low + (high - low) / 2;
+    if (o[mid] + mid < loc)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::InsertNextCellSplit(vtkIdType npts,
+                                            const vtkIdType* pts)
+{
+  if (this->StorageType == SPLIT_STORAGE_32)
+  {
+    // Fall back to vtkIdType storage when the new cell does not fit.
+    vtkIdType end = this->Connectivity->GetNumberOfTuples() + npts;
+    bool fits = (end <= VTK_TYPE_INT32_MAX);
+    for (vtkIdType i = 0; fits && i < npts; ++i)
+    {
+      fits = (pts[i] >= VTK_TYPE_INT32_MIN && pts[i] <= VTK_TYPE_INT32_MAX);
+    }
+    if (!fits)
+    {
+      this->UseSplitStorage(false);
+    }
+  }
+
+  if (this->StorageType == SPLIT_STORAGE_32)
+  {
+    vtkCellArrayInsertSplit(static_cast<vtkCellArrayIds32*>(this->Offsets),
+      static_cast<vtkCellArrayIds32*>(this->Connectivity), npts, pts);
+  }
+  else
+  {
+    vtkCellArrayInsertSplit(static_cast<vtkCellArrayIds64*>(this->Offsets),
+      static_cast<vtkCellArrayIds64*>(this->Connectivity), npts, pts);
+  }
+  return this->NumberOfCells++;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::InsertNextCellSplit(int vtkNotUsed(npts))
+{
+  // The cell is empty until points are added with InsertCellPoint().
+  return this->InsertNextCellSplit(0, NULL);
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::InsertCellPointSplit(vtkIdType id)
+{
+  if (this->StorageType == SPLIT_STORAGE_32 &&
+      (id < VTK_TYPE_INT32_MIN || id > VTK_TYPE_INT32_MAX ||
+       this->Connectivity->GetNumberOfTuples() >= VTK_TYPE_INT32_MAX))
+  {
+    this->UseSplitStorage(false);
+  }
+
+  if (this->StorageType == SPLIT_STORAGE_32)
+  {
+    vtkCellArrayInsertSplitPoint(
+      static_cast<vtkCellArrayIds32*>(this->Offsets),
+      static_cast<vtkCellArrayIds32*>(this->Connectivity), id);
+  }
+  else
+  {
+    vtkCellArrayInsertSplitPoint(
+      static_cast<vtkCellArrayIds64*>(this->Offsets),
+      static_cast<vtkCellArrayIds64*>(this->Connectivity), id);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::UpdateCellCountSplit(int npts)
+{
+  // Only meaningful after InsertNextCell(int): trims the last cell to npts.
+  vtkIdType end = static_cast<vtkIdType>(
+    this->Offsets->GetComponent(this->NumberOfCells - 1, 0)) + npts;
+  this->Offsets->SetComponent(this->NumberOfCells, 0,
+                              static_cast<double>(end));
+  this->Connectivity->SetNumberOfTuples(end);
+}
+
+//----------------------------------------------------------------------------
+int vtkCellArray::GetNextCellSplit(vtkIdType& npts, vtkIdType* &pts)
+{
+  if (this->TraversalLocation >= this->NumberOfCells)
+  {
+    npts = 0;
+    pts = 0;
+    return 0;
+  }
+
+  vtkIdType cellId = this->TraversalLocation++;
+  if (this->StorageType == SPLIT_STORAGE_64)
+  {
+    const vtkIdType *o =
+      static_cast<vtkCellArrayIds64*>(this->Offsets)->GetPointer(cellId);
+    npts = o[1] - o[0];
+    pts = static_cast<vtkCellArrayIds64*>(this->Connectivity)->GetPointer(o[0]);
+    return 1;
+  }
+
+  if (!this->TempCell)
+  {
+    this->TempCell = vtkIdList::New();
+  }
+  this->GetCellAtId(cellId, this->TempCell);
+  npts = this->TempCell->GetNumberOfIds();
+  pts = this->TempCell->GetPointer(0);
+  return 1;
+}
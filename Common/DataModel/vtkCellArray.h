@@ -28,6 +28,21 @@
  * using the vtkCellTypes and vtkCellLinks objects to extend the definition of
  * the data structure.
  *
+ * Alternatively the cells may be kept in a split storage layout made of two
+ * arrays: an offsets array of (NumberOfCells+1) entries, and a connectivity
+ * array holding the point ids of all cells back to back (cell i uses the
+ * ids in [offsets[i], offsets[i+1]) ). This layout supports random access
+ * by cell id (see GetCellAtId()), does not spend a count entry per cell,
+ * and may optionally use 32-bit ids when the point ids fit. It is the
+ * layout used by the XML file formats, so readers may hand their arrays to
+ * the cell array without copying them (see SetData()). The traversal and
+ * insertion methods (InitTraversal(), GetNextCell(), InsertNextCell(), ...)
+ * work natively on both layouts. Methods exposing the legacy
+ * (n,id1,id2,...) layout, such as GetPointer(), GetData(), GetCell(loc,...)
+ * or the location based methods, transparently convert the storage back to
+ * the legacy layout first; pointers previously returned by the cell array
+ * are invalidated by such a conversion.
+ *
  * @sa
  * vtkCellTypes vtkCellLinks
 */
@@ -41,6 +56,8 @@
 #include "vtkIdTypeArray.h" // Needed for inline methods
 #include "vtkCell.h" // Needed for inline methods
 
+class vtkDataArray;
+
 class VTKCOMMONDATAMODEL_EXPORT vtkCellArray : public vtkObject
 {
 public:
@@ -52,11 +69,23 @@ public:
    */
   static vtkCellArray *New();
 
+  /**
+   * Storage layouts supported by the cell array. LEGACY_STORAGE is the
+   * interleaved (n,id1,id2,...) list. SPLIT_STORAGE_64 and SPLIT_STORAGE_32
+   * use separate offsets and connectivity arrays of 64-bit (vtkIdType) or
+   * 32-bit (vtkTypeInt32) integers respectively.
+   */
+  enum StorageTypes
+  {
+    LEGACY_STORAGE = 0,
+    SPLIT_STORAGE_64,
+    SPLIT_STORAGE_32
+  };
+
   /**
    * Allocate memory and set the size to extend by.
    */
-  int Allocate(const vtkIdType sz, const int ext=1000)
-    {return this->Ia->Allocate(sz,ext);}
+  int Allocate(const vtkIdType sz, const int ext=1000);
 
   /**
    * Free any memory and reset to an empty state.
@@ -99,7 +128,9 @@ public:
    * A cell traversal methods that is more efficient than vtkDataSet traversal
    * methods.  GetNextCell() gets the next cell in the list. If end of list
    * is encountered, 0 is returned. A value of 1 is returned whenever
-   * npts and pts have been updated without error.
+   * npts and pts have been updated without error. With 32-bit split
+   * storage, pts points to an internal scratch buffer that is only valid
+   * until the next call and must not be written to.
    */
   int GetNextCell(vtkIdType& npts, vtkIdType* &pts);
 
@@ -111,28 +142,32 @@ public:
   int GetNextCell(vtkIdList *pts);
 
   /**
-   * Get the size of the allocated connectivity array.
+   * Get the size of the allocated connectivity array. With split storage
+   * this is the sum of the allocated sizes of the offsets and connectivity
+   * arrays.
    */
-  vtkIdType GetSize()
-    {return this->Ia->GetSize();}
+  vtkIdType GetSize();
 
   /**
    * Get the total number of entries (i.e., data values) in the connectivity
    * array. This may be much less than the allocated size (i.e., return value
-   * from GetSize().)
+   * from GetSize().) The value is always expressed in terms of the legacy
+   * (n,id1,id2,...) layout, whatever the current storage.
    */
-  vtkIdType GetNumberOfConnectivityEntries()
-    {return this->Ia->GetMaxId()+1;}
+  vtkIdType GetNumberOfConnectivityEntries();
 
   /**
    * Internal method used to retrieve a cell given an offset into
-   * the internal array.
+   * the internal array. With split storage the offset is the one the cell
+   * would have in the legacy layout; 64-bit split storage is read in place,
+   * while 32-bit split storage is converted to the legacy layout.
    */
   void GetCell(vtkIdType loc, vtkIdType &npts, vtkIdType* &pts);
 
   /**
    * Internal method used to retrieve a cell given an offset into
-   * the internal array.
+   * the internal array. With split storage the offset is the one the cell
+   * would have in the legacy layout, and the storage is read in place.
    */
   void GetCell(vtkIdType loc, vtkIdList* pts);
 
@@ -175,13 +210,18 @@ public:
 
   /**
    * Computes the current insertion location within the internal array.
-   * Used in conjunction with GetCell(int loc,...).
+   * Used in conjunction with GetCell(int loc,...). This converts the storage
+   * to the legacy layout if needed.
    */
   vtkIdType GetInsertLocation(int npts)
-    {return (this->InsertLocation - npts - 1);};
+  {
+    this->UseLegacyStorage();
+    return (this->InsertLocation - npts - 1);
+  }
 
   /**
-   * Get/Set the current traversal location.
+   * Get/Set the current traversal location. With split storage the
+   * traversal location is the id of the next cell to be traversed.
    */
   vtkIdType GetTraversalLocation()
     {return this->TraversalLocation;}
@@ -190,10 +230,14 @@ public:
 
   /**
    * Computes the current traversal location within the internal array. Used
-   * in conjunction with GetCell(int loc,...).
+   * in conjunction with GetCell(int loc,...). This converts the storage to
+   * the legacy layout if needed.
    */
   vtkIdType GetTraversalLocation(vtkIdType npts)
-    {return(this->TraversalLocation-npts-1);}
+  {
+    this->UseLegacyStorage();
+    return(this->TraversalLocation-npts-1);
+  }
 
   /**
    * Special method inverts ordering of current cell. Must be called
@@ -216,10 +260,14 @@ public:
   int GetMaxCellSize();
 
   /**
-   * Get pointer to array of cell data.
+   * Get pointer to array of cell data. This converts the storage to the
+   * legacy layout if needed.
    */
   vtkIdType *GetPointer()
-    {return this->Ia->GetPointer(0);}
+  {
+    this->UseLegacyStorage();
+    return this->Ia->GetPointer(0);
+  }
 
   /**
    * Get pointer to data array for purpose of direct writes of data. Size is the
@@ -245,10 +293,108 @@ public:
   void DeepCopy(vtkCellArray *ca);
 
   /**
-   * Return the underlying data as a data array.
+   * Return the underlying data as a data array. This converts the storage
+   * to the legacy layout if needed.
    */
   vtkIdTypeArray* GetData()
-    {return this->Ia;}
+  {
+    this->UseLegacyStorage();
+    return this->Ia;
+  }
+
+  /**
+   * Define the cells from an offsets and a connectivity array, switching to
+   * split storage. The offsets array holds NumberOfCells+1 monotonically
+   * increasing entries starting at 0; its last entry is the number of
+   * values in the connectivity array. Both arrays must have a single
+   * component. When both arrays are vtkIdTypeArray or both are
+   * vtkTypeInt32Array they are used as is (reference counted, no copy);
+   * otherwise the values are copied into vtkIdType storage. Returns false
+   * (leaving the cell array untouched) if the arrays are not valid.
+   */
+  bool SetData(vtkDataArray *offsets, vtkDataArray *connectivity);
+
+  //@{
+  /**
+   * Return the offsets and connectivity arrays of the split storage. The
+   * storage is converted to split storage (keeping 64-bit ids) if needed.
+   * The arrays are either vtkIdTypeArray or vtkTypeInt32Array depending on
+   * the storage type.
+   */
+  vtkDataArray* GetOffsetsArray();
+  vtkDataArray* GetConnectivityArray();
+  //@}
+
+  //@{
+  /**
+   * Query the current storage layout (see StorageTypes).
+   */
+  int GetStorageType()
+    {return this->StorageType;}
+  bool IsStorageSplit()
+    {return this->StorageType != LEGACY_STORAGE;}
+  bool IsStorage32Bit()
+    {return this->StorageType == SPLIT_STORAGE_32;}
+  //@}
+
+  /**
+   * Convert the cells to split offsets/connectivity storage. If use32BitIds
+   * is true, 32-bit integers are used when all point ids and offsets fit in
+   * a vtkTypeInt32 (see CanUse32BitStorage()), otherwise 64-bit storage is
+   * used. Returns true if the requested storage was obtained.
+   */
+  bool UseSplitStorage(bool use32BitIds = false);
+
+  /**
+   * Convert the cells back to the legacy (n,id1,id2,...) layout. This is a
+   * no-op if the storage is already the legacy one.
+   */
+  void UseLegacyStorage()
+  {
+    if (this->StorageType != LEGACY_STORAGE)
+    {
+      this->ConvertToLegacyStorage();
+    }
+  }
+
+  /**
+   * Return true if the current cells can be represented with 32-bit
+   * offsets and point ids.
+   */
+  bool CanUse32BitStorage();
+
+  /**
+   * Random access to the cells. Return the number of points of the cell
+   * with the given id. The storage is converted to split storage if
+   * needed.
+   */
+  vtkIdType GetCellSize(vtkIdType cellId);
+
+  /**
+   * Random access to the cells. Copy the point ids of the cell with the
+   * given id into pts. The storage is converted to split storage if
+   * needed. This method is thread safe as long as the cell array is not
+   * modified concurrently and the storage is already split.
+   */
+  void GetCellAtId(vtkIdType cellId, vtkIdList *pts);
+
+  /**
+   * Random access to the cells. Return the number of points and the point
+   * ids of the cell with the given id. With 64-bit split storage pts points
+   * into the connectivity array; with 32-bit split storage the ids are
+   * copied into ptIds and pts points into it. The storage is converted to
+   * split storage if needed. This method is thread safe as long as the cell
+   * array is not modified concurrently and the storage is already split.
+   */
+  void GetCellAtId(vtkIdType cellId, vtkIdType &npts, const vtkIdType* &pts,
+                   vtkIdList *ptIds);
+
+  /**
+   * Return the offset the cell with the given id has, or would have, in the
+   * legacy (n,id1,id2,...) layout. The storage is not modified, so this can
+   * be used to build cell locations while keeping split storage.
+   */
+  vtkIdType GetLegacyLocation(vtkIdType cellId);
 
   /**
    * Reuse list. Reset to initial condition.
@@ -258,8 +404,7 @@ public:
   /**
    * Reclaim any extra memory.
    */
-  void Squeeze()
-    {this->Ia->Squeeze();}
+  void Squeeze();
 
   /**
    * Return the memory in kibibytes (1024 bytes) consumed by this cell array. Used to
@@ -275,11 +420,27 @@ protected:
   vtkCellArray();
   ~vtkCellArray() VTK_OVERRIDE;
 
+  // Split storage versions of the inline methods.
+  vtkIdType InsertNextCellSplit(vtkIdType npts, const vtkIdType* pts);
+  vtkIdType InsertNextCellSplit(int npts);
+  void InsertCellPointSplit(vtkIdType id);
+  void UpdateCellCountSplit(int npts);
+  int GetNextCellSplit(vtkIdType& npts, vtkIdType* &pts);
+  vtkIdType GetCellIdFromLegacyLocation(vtkIdType loc);
+  void ConvertToLegacyStorage();
+  void ReleaseSplitStorage();
+
   vtkIdType NumberOfCells;
   vtkIdType InsertLocation;     //keep track of current insertion point
   vtkIdType TraversalLocation;   //keep track of traversal position
   vtkIdTypeArray *Ia;
 
+  // Split storage. In split mode the traversal location is a cell id.
+  int StorageType;
+  vtkDataArray *Offsets;
+  vtkDataArray *Connectivity;
+  vtkIdList *TempCell; // scratch ids returned by GetNextCell() in 32-bit mode
+
 private:
   vtkCellArray(const vtkCellArray&) VTK_DELETE_FUNCTION;
   void operator=(const vtkCellArray&) VTK_DELETE_FUNCTION;
@@ -290,6 +451,11 @@ private:
 inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts,
                                               const vtkIdType* pts)
 {
+  if (this->StorageType != LEGACY_STORAGE)
+  {
+    return this->InsertNextCellSplit(npts, pts);
+  }
+
   vtkIdType i = this->Ia->GetMaxId() + 1;
   vtkIdType *ptr = this->Ia->WritePointer(i, npts+1);
 
@@ -307,6 +473,11 @@ inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts,
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 {
+  if (this->StorageType != LEGACY_STORAGE)
+  {
+    return this->InsertNextCellSplit(npts);
+  }
+
   this->InsertLocation = this->Ia->InsertNextValue(npts) + 1;
   this->NumberOfCells++;
 
@@ -316,12 +487,24 @@ inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 //----------------------------------------------------------------------------
 inline void vtkCellArray::InsertCellPoint(vtkIdType id)
 {
+  if (this->StorageType != LEGACY_STORAGE)
+  {
+    this->InsertCellPointSplit(id);
+    return;
+  }
+
   this->Ia->InsertValue(this->InsertLocation++, id);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::UpdateCellCount(int npts)
 {
+  if (this->StorageType != LEGACY_STORAGE)
+  {
+    this->UpdateCellCountSplit(npts);
+    return;
+  }
+
   this->Ia->SetValue(this->InsertLocation-npts-1, npts);
 }
 
@@ -338,18 +521,14 @@ inline vtkIdType vtkCellArray::InsertNextCell(vtkCell *cell)
                               cell->PointIds->GetPointer(0));
 }
 
-//----------------------------------------------------------------------------
-inline void vtkCellArray::Reset()
-{
-  this->NumberOfCells = 0;
-  this->InsertLocation = 0;
-  this->TraversalLocation = 0;
-  this->Ia->Reset();
-}
-
 //----------------------------------------------------------------------------
 inline int vtkCellArray::GetNextCell(vtkIdType& npts, vtkIdType* &pts)
 {
+  if (this->StorageType != LEGACY_STORAGE)
+  {
+    return this->GetNextCellSplit(npts, pts);
+  }
+
   if ( this->Ia->GetMaxId() >= 0 &&
        this->TraversalLocation <= this->Ia->GetMaxId() )
   {
@@ -367,6 +546,16 @@ inline int vtkCellArray::GetNextCell(vtkIdType& npts, vtkIdType* &pts)
 inline void vtkCellArray::GetCell(vtkIdType loc, vtkIdType &npts,
                                   vtkIdType* &pts)
 {
+  if (this->StorageType == SPLIT_STORAGE_64)
+  {
+    typedef vtkAOSDataArrayTemplate<vtkIdType> IdsType;
+    const vtkIdType *o = static_cast<IdsType*>(this->Offsets)->
+      GetPointer(this->GetCellIdFromLegacyLocation(loc));
+    npts = o[1] - o[0];
+    pts = static_cast<IdsType*>(this->Connectivity)->GetPointer(o[0]);
+    return;
+  }
+  this->UseLegacyStorage();
   npts = this->Ia->GetValue(loc++);
   pts  = this->Ia->GetPointer(loc);
 }
@@ -376,6 +565,7 @@ inline void vtkCellArray::ReverseCell(vtkIdType loc)
 {
   int i;
   vtkIdType tmp;
+  this->UseLegacyStorage();
   vtkIdType npts=this->Ia->GetValue(loc);
   vtkIdType *pts=this->Ia->GetPointer(loc+1);
   for (i=0; i < (npts/2); i++)
@@ -390,6 +580,7 @@ inline void vtkCellArray::ReverseCell(vtkIdType loc)
 inline void vtkCellArray::ReplaceCell(vtkIdType loc, int npts,
                                       const vtkIdType *pts)
 {
+  this->UseLegacyStorage();
   vtkIdType *oldPts=this->Ia->GetPointer(loc+1);
   for (int i=0; i < npts; i++)
   {
@@ -401,6 +592,7 @@ inline void vtkCellArray::ReplaceCell(vtkIdType loc, int npts,
 inline vtkIdType *vtkCellArray::WritePointer(const vtkIdType ncells,
                                              const vtkIdType size)
 {
+  this->ReleaseSplitStorage();
   this->NumberOfCells = ncells;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
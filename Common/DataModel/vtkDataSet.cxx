@@ -19,6 +19,7 @@
 #include "vtkCellData.h"
 #include "vtkCellTypes.h"
 #include "vtkDataSetCellIterator.h"
+#include "vtkFindCellContext.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
@@ -283,6 +284,51 @@ vtkCell *vtkDataSet::FindAndGetCell (double x[3], vtkCell *cell,
   return cell;
 }
 
+//----------------------------------------------------------------------------
+vtkIdType vtkDataSet::FindCellWithContext(double x[3], double tol2,
+                                          vtkFindCellContext *context)
+{
+  if ( !this->IsFindCellWithContextPrepared() )
+  {
+    context->SetCellLocation(-1, 0);
+    return -1;
+  }
+
+  int subId = 0;
+  double *weights = context->AllocateWeights(this->GetMaxCellSize());
+  vtkIdType cellId = this->FindCell(x, NULL, context->GetCell(), -1, tol2,
+                                    subId, context->GetPCoords(), weights);
+  if ( cellId >= 0 )
+  {
+    this->GetCell(cellId, context->GetCell());
+  }
+  context->SetCellLocation(cellId, subId);
+  return cellId;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataSet::PrepareFindCellWithContext()
+{
+  this->ComputeBounds();
+  // Cache the ghost arrays, used to skip blanked cells
+  this->GetPointGhostArray();
+  this->GetCellGhostArray();
+  this->FindCellWithContextTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataSet::IsFindCellWithContextPrepared()
+{
+  if ( this->GetMTime() > this->FindCellWithContextTime )
+  {
+    vtkErrorMacro("PrepareFindCellWithContext() must be called before "
+                  "FindCellWithContext(), and again after the dataset is "
+                  "modified.");
+    return false;
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkDataSet::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
                                   vtkIdList *cellIds)
@@ -47,6 +47,7 @@ class vtkCell;
 class vtkCellData;
 class vtkCellIterator;
 class vtkCellTypes;
+class vtkFindCellContext;
 class vtkGenericCell;
 class vtkIdList;
 class vtkPointData;
@@ -236,6 +237,34 @@ public:
                                   double tol2, int& subId, double pcoords[3],
                                   double *weights);
 
+  /**
+   * Reentrant version of FindCell(). All the scratch storage used by the
+   * search (generic cell, id lists, interpolation weights) is taken from the
+   * caller-owned context, which also receives the result: the cell
+   * containing x, and the sub id, parametric coordinates and interpolation
+   * weights of x in this cell (see vtkFindCellContext). Returns the cell id
+   * (< 0 if no cell contains x within the squared tolerance tol2).
+   * vtkPointSet (and so vtkUnstructuredGrid, vtkPolyData and
+   * vtkStructuredGrid) and vtkImageData do not modify the dataset during the
+   * search, so several threads may search the same dataset concurrently,
+   * each with its own context. The default implementation forwards to the
+   * vtkGenericCell version of FindCell(). PrepareFindCellWithContext() must
+   * be called first, and again whenever the dataset is modified: otherwise
+   * an error is reported and -1 is returned.
+   * THIS METHOD IS THREAD SAFE IF PrepareFindCellWithContext() IS FIRST
+   * CALLED FROM A SINGLE THREAD AND THE DATASET IS NOT MODIFIED
+   */
+  virtual vtkIdType FindCellWithContext(double x[3], double tol2,
+                                        vtkFindCellContext *context);
+
+  /**
+   * Build the structures used by FindCellWithContext() (bounds, cell links,
+   * point locator, ...). Must be called before searching, and again after
+   * the dataset is modified.
+   * THIS METHOD IS NOT THREAD SAFE.
+   */
+  virtual void PrepareFindCellWithContext();
+
   /**
    * Datasets are composite objects and need to check each part for MTime
    * THIS METHOD IS THREAD SAFE
@@ -487,6 +516,12 @@ protected:
    */
   bool IsAnyBitSet(vtkUnsignedCharArray *a, int bitFlag);
 
+  /**
+   * Return true if PrepareFindCellWithContext() was called since the last
+   * modification of the dataset; otherwise report an error.
+   */
+  bool IsFindCellWithContextPrepared();
+
   vtkCellData *CellData;   // Scalars, vectors, etc. associated w/ each cell
   vtkPointData *PointData;   // Scalars, vectors, etc. associated w/ each point
   vtkCallbackCommand *DataObserver; // Observes changes to cell/point data
@@ -500,6 +535,9 @@ protected:
   // Time at which scalar range is computed
   vtkTimeStamp ScalarRangeComputeTime;
 
+  // Time at which PrepareFindCellWithContext() was called
+  vtkTimeStamp FindCellWithContextTime;
+
   //@{
   /**
    * These arrays pointers are caches used to avoid a string comparison (when
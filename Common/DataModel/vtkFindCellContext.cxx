@@ -0,0 +1,78 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFindCellContext.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkFindCellContext.h"
+
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+
+vtkStandardNewMacro(vtkFindCellContext);
+
+//----------------------------------------------------------------------------
+vtkFindCellContext::vtkFindCellContext()
+{
+  this->CellId = -1;
+  this->SubId = 0;
+  this->PCoords[0] = this->PCoords[1] = this->PCoords[2] = 0.0;
+  this->WeightsSize = 8; // enough for linear 3D cells
+  this->Weights = new double[this->WeightsSize];
+  this->Cell = vtkGenericCell::New();
+  this->PointIds = vtkIdList::New();
+  this->PointIds->Allocate(8, 100);
+  this->Neighbors = vtkIdList::New();
+  this->Neighbors->Allocate(8, 100);
+  this->CellIds = vtkIdList::New();
+  this->CellIds->Allocate(8, 100);
+  this->CoincidentIds = vtkIdList::New();
+  this->CoincidentIds->Allocate(8, 100);
+  this->VisitedCells = vtkIdList::New();
+  this->VisitedCells->Allocate(64, 100);
+}
+
+//----------------------------------------------------------------------------
+vtkFindCellContext::~vtkFindCellContext()
+{
+  delete [] this->Weights;
+  this->Cell->Delete();
+  this->PointIds->Delete();
+  this->Neighbors->Delete();
+  this->CellIds->Delete();
+  this->CoincidentIds->Delete();
+  this->VisitedCells->Delete();
+}
+
+//----------------------------------------------------------------------------
+double *vtkFindCellContext::AllocateWeights(int numWeights)
+{
+  if ( numWeights > this->WeightsSize )
+  {
+    delete [] this->Weights;
+    this->WeightsSize = 2 * numWeights;
+    this->Weights = new double[this->WeightsSize];
+  }
+  return this->Weights;
+}
+
+//----------------------------------------------------------------------------
+void vtkFindCellContext::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Cell Id: " << this->CellId << "\n";
+  os << indent << "Sub Id: " << this->SubId << "\n";
+  os << indent << "PCoords: (" << this->PCoords[0] << ", "
+     << this->PCoords[1] << ", " << this->PCoords[2] << ")\n";
+  os << indent << "Weights Size: " << this->WeightsSize << "\n";
+}
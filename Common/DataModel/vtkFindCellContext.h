@@ -0,0 +1,118 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFindCellContext.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkFindCellContext
+ * @brief   caller-owned scratch storage for reentrant cell location
+ *
+ * vtkFindCellContext holds all the scratch storage used by
+ * vtkDataSet::FindCellWithContext(): a vtkGenericCell, the id lists used to
+ * walk through neighboring cells and the interpolation weights buffer. Once
+ * a search succeeds, the context also holds its result: the id of the cell
+ * containing the point, the cell itself, and the sub id, parametric
+ * coordinates and interpolation weights returned by
+ * vtkCell::EvaluatePosition().
+ *
+ * Since the dataset does not modify any of its own state during the search,
+ * several threads can locate points in the same dataset concurrently, each
+ * with its own context (e.g., a vtkSMPThreadLocalObject<vtkFindCellContext>).
+ * A context is meant to be reused over many searches: its storage only grows
+ * when a larger cell is encountered.
+ *
+ * @sa
+ * vtkDataSet vtkGenericCell vtkSMPThreadLocalObject
+*/
+
+#ifndef vtkFindCellContext_h
+#define vtkFindCellContext_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkGenericCell;
+class vtkIdList;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkFindCellContext : public vtkObject
+{
+public:
+  /**
+   * Create an empty context.
+   */
+  static vtkFindCellContext *New();
+
+  //@{
+  /**
+   * Standard type and print methods.
+   */
+  vtkTypeMacro(vtkFindCellContext,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) VTK_OVERRIDE;
+  //@}
+
+  //@{
+  /**
+   * The result of the last search: the id of the cell containing the point
+   * (< 0 if none), and the sub id, parametric coordinates and interpolation
+   * weights (one per point of the cell) of the point in this cell.
+   */
+  vtkIdType GetCellId() {return this->CellId;}
+  int GetSubId() {return this->SubId;}
+  double *GetPCoords() {return this->PCoords;}
+  double *GetWeights() {return this->Weights;}
+  //@}
+
+  /**
+   * The generic cell used during the search. After a successful search, it
+   * is the cell containing the point.
+   */
+  vtkGenericCell *GetCell() {return this->Cell;}
+
+  //@{
+  /**
+   * Scratch storage for the vtkDataSet subclasses implementing
+   * FindCellWithContext(). AllocateWeights() makes sure that the weights
+   * buffer holds at least numWeights values and returns it.
+   * SetCellLocation() records the result of the search.
+   */
+  double *AllocateWeights(int numWeights);
+  void SetCellLocation(vtkIdType cellId, int subId)
+    {this->CellId = cellId; this->SubId = subId;}
+  vtkIdList *GetPointIds() {return this->PointIds;}
+  vtkIdList *GetNeighbors() {return this->Neighbors;}
+  vtkIdList *GetCellIds() {return this->CellIds;}
+  vtkIdList *GetCoincidentIds() {return this->CoincidentIds;}
+  vtkIdList *GetVisitedCells() {return this->VisitedCells;}
+  //@}
+
+protected:
+  vtkFindCellContext();
+  ~vtkFindCellContext() VTK_OVERRIDE;
+
+  vtkIdType CellId;
+  int SubId;
+  double PCoords[3];
+  double *Weights;
+  int WeightsSize;
+  vtkGenericCell *Cell;
+  vtkIdList *PointIds;
+  vtkIdList *Neighbors;
+  vtkIdList *CellIds;
+  vtkIdList *CoincidentIds;
+  vtkIdList *VisitedCells;
+
+private:
+  vtkFindCellContext(const vtkFindCellContext&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkFindCellContext&) VTK_DELETE_FUNCTION;
+};
+
+#endif
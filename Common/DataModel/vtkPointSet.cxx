@@ -15,6 +15,7 @@
 #include "vtkPointSet.h"
 
 #include "vtkCell.h"
+#include "vtkFindCellContext.h"
 #include "vtkGarbageCollector.h"
 #include "vtkGenericCell.h"
 #include "vtkInformation.h"
@@ -324,6 +325,152 @@ vtkIdType vtkPointSet::FindCell(double x[3], vtkCell *cell,
   return -1;
 }
 
+//-----------------------------------------------------------------------------
+// Reentrant version of FindCellWalk(): the scratch storage comes from the
+// context and the cells are retrieved into the context's generic cell.
+static vtkIdType FindCellWalk(vtkPointSet *self, double x[3],
+                              vtkIdType cellId, double tol2,
+                              vtkFindCellContext *context)
+{
+  vtkGenericCell *cell = context->GetCell();
+  vtkIdList *visitedCells = context->GetVisitedCells();
+  vtkIdList *ptIds = context->GetPointIds();
+  vtkIdList *neighbors = context->GetNeighbors();
+  double *pcoords = context->GetPCoords();
+  double closestPoint[3], dist2, *weights;
+  int subId;
+
+  for (int walk = 0; walk < VTK_MAX_WALK; walk++)
+  {
+    // Check to see if we already visited this cell.
+    if (visitedCells->IsId(cellId) >= 0) break;
+    visitedCells->InsertNextId(cellId);
+
+    // Check to see if the cell contains the point.
+    self->GetCell(cellId, cell);
+    weights = context->AllocateWeights(cell->GetNumberOfPoints());
+    if (   (cell->EvaluatePosition(x, closestPoint, subId,
+                                   pcoords, dist2, weights) == 1)
+        && (dist2 <= tol2) )
+    {
+      context->SetCellLocation(cellId, subId);
+      return cellId;
+    }
+
+    // This is not the right cell.  Find the next one.
+    cell->CellBoundary(subId, pcoords, ptIds);
+    self->GetCellNeighbors(cellId, ptIds, neighbors);
+    // If there is no next one, exit.
+    if (neighbors->GetNumberOfIds() < 1) break;
+    // Set the next cell as the current one and iterate.
+    cellId = neighbors->GetId(0);
+  }
+
+  // Could not find a cell.
+  return -1;
+}
+
+//-----------------------------------------------------------------------------
+static vtkIdType FindCellWalk(vtkPointSet *self, double x[3],
+                              vtkIdList *cellIds, double tol2,
+                              vtkFindCellContext *context)
+{
+  for (vtkIdType i = 0; i < cellIds->GetNumberOfIds(); i++)
+  {
+    vtkIdType foundCell = FindCellWalk(self, x, cellIds->GetId(i), tol2,
+                                       context);
+    if (foundCell >= 0) return foundCell;
+  }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+// Same search as FindCell(), except that nothing is allocated or modified
+// once the locator is built.
+vtkIdType vtkPointSet::FindCellWithContext(double x[3], double tol2,
+                                           vtkFindCellContext *context)
+{
+  context->SetCellLocation(-1, 0);
+
+  // make sure everything is up to snuff
+  if ( !this->Points || this->Points->GetNumberOfPoints() < 1)
+  {
+    return -1;
+  }
+
+  if ( !this->IsFindCellWithContextPrepared() || !this->Locator )
+  {
+    return -1;
+  }
+
+  // Check to see if the point is within the bounds of the data.  This is not
+  // a strict check, but it is fast.
+  const double *bounds = this->Bounds;
+  double tol = sqrt(tol2);
+  if (   (x[0] < bounds[0] - tol) || (x[0] > bounds[1] + tol)
+      || (x[1] < bounds[2] - tol) || (x[1] > bounds[3] + tol)
+      || (x[2] < bounds[4] - tol) || (x[2] > bounds[5] + tol) )
+  {
+    return -1;
+  }
+
+  context->GetVisitedCells()->Reset();
+  vtkIdList *cellIds = context->GetCellIds();
+
+  // Find the point closest to the coordinates given and search from the
+  // adjacent cells.
+  vtkIdType ptId = this->Locator->FindClosestPoint(x);
+  if (ptId < 0) return -1;
+  this->GetPointCells(ptId, cellIds);
+  vtkIdType foundCell = FindCellWalk(this, x, cellIds, tol2, context);
+  if (foundCell >= 0) return foundCell;
+
+  // Then from the cells using the points coincident with the closest point
+  // (see FindCell()).
+  double ptCoord[3];
+  this->GetPoint(ptId, ptCoord);
+  vtkIdList *coincidentPtIds = context->GetCoincidentIds();
+  this->Locator->FindPointsWithinRadius(tol2, ptCoord, coincidentPtIds);
+  coincidentPtIds->DeleteId(ptId);      // Already searched this one.
+  for (vtkIdType i = 0; i < coincidentPtIds->GetNumberOfIds(); i++)
+  {
+    this->GetPointCells(coincidentPtIds->GetId(i), cellIds);
+    foundCell = FindCellWalk(this, x, cellIds, tol2, context);
+    if (foundCell >= 0) return foundCell;
+  }
+
+  // Could not find the cell.
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPointSet::PrepareFindCellWithContext()
+{
+  this->Superclass::PrepareFindCellWithContext();
+
+  if ( !this->Points || this->Points->GetNumberOfPoints() < 1)
+  {
+    return;
+  }
+
+  if ( !this->Locator )
+  {
+    this->Locator = vtkPointLocator::New();
+    this->Locator->Register(this);
+    this->Locator->Delete();
+    this->Locator->SetDataSet(this);
+  }
+
+  if ( this->Points->GetMTime() > this->Locator->GetBuildTime() )
+  {
+    this->Locator->SetDataSet(this);
+  }
+
+  // Rebuilds the locator if the dataset was modified since the last build,
+  // so that the searches never do.
+  this->Locator->BuildLocator();
+}
+
 //----------------------------------------------------------------------------
 vtkCellIterator *vtkPointSet::NewCellIterator()
 {
@@ -71,6 +71,17 @@ public:
                              double *weights) VTK_OVERRIDE;
   //@}
 
+  //@{
+  /**
+   * Reentrant cell location, see vtkDataSet for additional information. The
+   * search walks from the cells using the point closest to x, like
+   * FindCell(). PrepareFindCellWithContext() builds the point locator.
+   */
+  vtkIdType FindCellWithContext(double x[3], double tol2,
+                                vtkFindCellContext *context) VTK_OVERRIDE;
+  void PrepareFindCellWithContext() VTK_OVERRIDE;
+  //@}
+
   /**
    * See vtkDataSet for additional information.
    * WARNING: Just don't use this error-prone method, the returned pointer
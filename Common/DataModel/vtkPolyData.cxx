@@ -56,6 +56,29 @@ struct vtkPolyDataDummyContainter
 
 vtkPolyDataDummyContainter vtkPolyData::DummyContainer;
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+// Return the legacy (n,id1,id2,...) data of the cell array, or NULL when it
+// uses split storage, which is then left untouched.
+vtkIdType* vtkPolyDataGetLegacyCells(vtkCellArray *cells)
+{
+  return cells->IsStorageSplit() ? NULL : cells->GetData()->GetPointer(0);
+}
+
+//----------------------------------------------------------------------------
+// Number of points of the cell at the given legacy location, read from the
+// legacy data when available, from split storage by cell id otherwise.
+inline vtkIdType vtkPolyDataGetCellSize(vtkCellArray *cells,
+                                        const vtkIdType *legacy,
+                                        vtkIdType cellId, vtkIdType loc)
+{
+  return legacy ? legacy[loc] : cells->GetCellSize(cellId);
+}
+
+}
+
 vtkPolyData::vtkPolyData () :
   Vertex(NULL), PolyVertex(NULL), Line(NULL), PolyLine(NULL),
   Triangle(NULL), Quad(NULL), Polygon(NULL), TriangleStrip(NULL),
@@ -932,6 +955,17 @@ void vtkPolyData::BuildCells()
   vtkCellArray *polyCells = this->GetPolys();
   vtkCellArray *stripCells = this->GetStrips();
 
+  // Split storage is kept, with vtkIdType ids so that the cells can be
+  // returned in place from the locations recorded below.
+  vtkCellArray *cellArrays[4] = { vertCells, lineCells, polyCells, stripCells };
+  for (int c = 0; c < 4; ++c)
+  {
+    if (cellArrays[c]->IsStorage32Bit())
+    {
+      cellArrays[c]->UseSplitStorage(false);
+    }
+  }
+
   // here are the number of cells we have
   vtkIdType nVerts = vertCells->GetNumberOfCells();
   vtkIdType nLines = lineCells->GetNumberOfCells();
@@ -953,14 +987,14 @@ void vtkPolyData::BuildCells()
   vtkIdType nextCellPts;
   if (nVerts)
   {
-    vtkIdType *pVerts = vertCells->GetData()->GetPointer(0);
-    numCellPts = pVerts[0];
+    vtkIdType *pVerts = vtkPolyDataGetLegacyCells(vertCells);
+    numCellPts = vtkPolyDataGetCellSize(vertCells, pVerts, 0, 0);
     nextCellPts = numCellPts + 1;
     pLocs[0] = 0;
     pTypes[0] = numCellPts > 1 ? VTK_POLY_VERTEX : VTK_VERTEX;
     for (vtkIdType i = 1; i < nVerts; ++i)
     {
-      numCellPts = pVerts[nextCellPts];
+      numCellPts = vtkPolyDataGetCellSize(vertCells, pVerts, i, nextCellPts);
       pLocs[i] = nextCellPts;
       pTypes[i] = numCellPts > 1 ? VTK_POLY_VERTEX : VTK_VERTEX;
       nextCellPts += numCellPts + 1;
@@ -972,8 +1006,8 @@ void vtkPolyData::BuildCells()
   // lines
   if (nLines)
   {
-    vtkIdType *pLines = lineCells->GetData()->GetPointer(0);
-    numCellPts = pLines[0];
+    vtkIdType *pLines = vtkPolyDataGetLegacyCells(lineCells);
+    numCellPts = vtkPolyDataGetCellSize(lineCells, pLines, 0, 0);
     pLocs[0] = 0;
     pTypes[0] = numCellPts > 2 ? VTK_POLY_LINE : VTK_LINE;
     if (numCellPts == 1)
@@ -984,7 +1018,7 @@ void vtkPolyData::BuildCells()
     nextCellPts = numCellPts + 1;
     for (vtkIdType i = 1; i < nLines; ++i)
     {
-      numCellPts = pLines[nextCellPts];
+      numCellPts = vtkPolyDataGetCellSize(lineCells, pLines, i, nextCellPts);
       pLocs[i] = nextCellPts;
       pTypes[i] = numCellPts > 2 ? VTK_POLY_LINE : VTK_LINE;
       if (numCellPts == 1)
@@ -1001,8 +1035,8 @@ void vtkPolyData::BuildCells()
   // polys
   if (nPolys)
   {
-    vtkIdType *pPolys = polyCells->GetData()->GetPointer(0);
-    numCellPts = pPolys[0];
+    vtkIdType *pPolys = vtkPolyDataGetLegacyCells(polyCells);
+    numCellPts = vtkPolyDataGetCellSize(polyCells, pPolys, 0, 0);
     pLocs[0] = 0;
     if (numCellPts < 3)
     {
@@ -1014,7 +1048,7 @@ void vtkPolyData::BuildCells()
     nextCellPts = numCellPts + 1;
     for (vtkIdType i = 1; i < nPolys; ++i)
     {
-      numCellPts = pPolys[nextCellPts];
+      numCellPts = vtkPolyDataGetCellSize(polyCells, pPolys, i, nextCellPts);
       pLocs[i] = nextCellPts;
       if (numCellPts < 3)
       {
@@ -1034,13 +1068,13 @@ void vtkPolyData::BuildCells()
   if (nStrips)
   {
     std::fill_n(pTypes, nStrips, VTK_TRIANGLE_STRIP);
-    vtkIdType *pStrips = stripCells->GetData()->GetPointer(0);
-    numCellPts = pStrips[0];
+    vtkIdType *pStrips = vtkPolyDataGetLegacyCells(stripCells);
+    numCellPts = vtkPolyDataGetCellSize(stripCells, pStrips, 0, 0);
     pLocs[0] = 0;
     nextCellPts = numCellPts + 1;
     for (vtkIdType i = 1; i < nStrips; ++i)
     {
-      numCellPts = pStrips[nextCellPts];
+      numCellPts = vtkPolyDataGetCellSize(stripCells, pStrips, i, nextCellPts);
       pLocs[i] = nextCellPts;
       nextCellPts += numCellPts + 1;
     }
@@ -1095,6 +1129,20 @@ void vtkPolyData::BuildLinks(int initialSize)
   this->Links->BuildLinks(this);
 }
 
+//----------------------------------------------------------------------------
+void vtkPolyData::PrepareFindCellWithContext()
+{
+  if ( !this->Cells )
+  {
+    this->BuildCells();
+  }
+  if ( !this->Links )
+  {
+    this->BuildLinks();
+  }
+  this->Superclass::PrepareFindCellWithContext();
+}
+
 //----------------------------------------------------------------------------
 // Copy a cells point ids into list provided. (Less efficient.)
 void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
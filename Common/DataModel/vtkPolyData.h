@@ -269,6 +269,12 @@ public:
    */
   void BuildLinks(int initialSize=0);
 
+  /**
+   * Build the cells and the cell links used to walk through neighboring
+   * cells, then the point locator. See vtkDataSet::FindCellWithContext().
+   */
+  void PrepareFindCellWithContext() VTK_OVERRIDE;
+
   /**
    * Release data structure that allows random access of the cells. This must
    * be done before a 2nd call to BuildLinks(). DeleteCells implicitly deletes
@@ -0,0 +1,1215 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkStaticCellLocator.h"
+
+#include "vtkBox.h"
+#include "vtkCellArray.h"
+#include "vtkDataSet.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+vtkStandardNewMacro(vtkStaticCellLocator);
+
+//-----------------------------------------------------------------------------
+// The following code supports threaded cell locator construction. The
+// locator is assumed to be constructed once (i.e., it does not allow
+// incremental cell insertion). The algorithm proceeds in four steps:
+// 1) The bounds of all the cells are computed (and cached) in parallel.
+// 2) The number of bins overlapped by the bounds of each cell is counted in
+// parallel. A prefix sum of the counts gives the position of the (cell,bin)
+// pairs (the fragments) of each cell.
+// 3) The fragments are generated in parallel, then sorted on their bin id
+// with vtkSMPTools::Sort(). This creates contiguous runs of cells all
+// overlapping the same bin.
+// 4) The bin offsets are updated to refer to the right entry location into
+// the sorted fragments. This enables quick access, and an indirect count
+// of the number of cells in each bin.
+
+//-----------------------------------------------------------------------------
+// The binned cells, including the sorted fragments. This is just a PIMPLd
+// wrapper around the classes that do the real work.
+class vtkCellBinner
+{
+public:
+  vtkStaticCellLocator *Locator; //locater
+  vtkIdType NumCells; //the number of cells to bin
+  vtkIdType NumFragments; //the number of (cell,bin) pairs
+  vtkIdType NumBins;
+
+  // These are internal data members used for performance reasons
+  vtkDataSet *DataSet;
+  double (*CellBounds)[6];
+  int Divisions[3];
+  double Bounds[6];
+  double H[3];
+  double hX, hY, hZ;
+  double fX, fY, fZ, bX, bY, bZ;
+  vtkIdType xD, yD, zD, xyD;
+
+  // Construction
+  vtkCellBinner(vtkStaticCellLocator *loc, vtkIdType numCells,
+                vtkIdType numFrags, vtkIdType numBins)
+  {
+      this->Locator = loc;
+      this->NumCells = numCells;
+      this->NumFragments = numFrags;
+      this->NumBins = numBins;
+      this->DataSet = loc->GetDataSet();
+      this->CellBounds = loc->CellBounds;
+      loc->GetDivisions(this->Divisions);
+
+      // Setup internal data members for more efficient processing.
+      this->hX = this->H[0] = loc->H[0];
+      this->hY = this->H[1] = loc->H[1];
+      this->hZ = this->H[2] = loc->H[2];
+      this->fX = 1.0 / loc->H[0];
+      this->fY = 1.0 / loc->H[1];
+      this->fZ = 1.0 / loc->H[2];
+      this->bX = this->Bounds[0] = loc->Bounds[0];
+      this->Bounds[1] = loc->Bounds[1];
+      this->bY = this->Bounds[2] = loc->Bounds[2];
+      this->Bounds[3] = loc->Bounds[3];
+      this->bZ = this->Bounds[4] = loc->Bounds[4];
+      this->Bounds[5] = loc->Bounds[5];
+      this->xD = this->Divisions[0];
+      this->yD = this->Divisions[1];
+      this->zD = this->Divisions[2];
+      this->xyD = this->Divisions[0] * this->Divisions[1];
+  }
+
+  // Virtuals for templated subclasses
+  virtual ~vtkCellBinner() {}
+  virtual void BuildLocator(const vtkIdType *cellOffsets) = 0;
+
+  //-----------------------------------------------------------------------------
+  // Inlined for performance. These function invocations must be called after
+  // BuildLocator() is invoked, otherwise the output is indeterminate.
+  void GetBinIndices(const double *x, int ijk[3]) const
+  {
+    // Compute bin index. Make sure it lies within range of locator.
+    vtkIdType tmp0 = static_cast<vtkIdType>(((x[0] - bX) * fX));
+    vtkIdType tmp1 = static_cast<vtkIdType>(((x[1] - bY) * fY));
+    vtkIdType tmp2 = static_cast<vtkIdType>(((x[2] - bZ) * fZ));
+
+    ijk[0] = tmp0 < 0 ? 0 : (tmp0 >= xD ? xD-1 : tmp0);
+    ijk[1] = tmp1 < 0 ? 0 : (tmp1 >= yD ? yD-1 : tmp1);
+    ijk[2] = tmp2 < 0 ? 0 : (tmp2 >= zD ? zD-1 : tmp2);
+  }
+
+  //-----------------------------------------------------------------------------
+  vtkIdType GetBinIndex(const double *x) const
+  {
+    int ijk[3];
+    this->GetBinIndices(x, ijk);
+    return ijk[0] + ijk[1]*xD + ijk[2]*xyD;
+  }
+
+  //-----------------------------------------------------------------------------
+  // The range of bins overlapped by the bounds of a cell. Returns the
+  // number of bins (zero for cells without points, which have
+  // uninitialized bounds).
+  vtkIdType GetBinRange(const double bds[6], int ijkMin[3], int ijkMax[3]) const
+  {
+    if ( bds[0] > bds[1] )
+    {
+      return 0;
+    }
+    const double xMin[3] = {bds[0], bds[2], bds[4]};
+    const double xMax[3] = {bds[1], bds[3], bds[5]};
+    this->GetBinIndices(xMin, ijkMin);
+    this->GetBinIndices(xMax, ijkMax);
+    return static_cast<vtkIdType>(ijkMax[0]-ijkMin[0]+1) *
+      (ijkMax[1]-ijkMin[1]+1) * (ijkMax[2]-ijkMin[2]+1);
+  }
+
+  //-----------------------------------------------------------------------------
+  void GetBinBounds(const int ijk[3], double bds[6]) const
+  {
+    bds[0] = this->bX + ijk[0]*this->hX;
+    bds[1] = bds[0] + this->hX;
+    bds[2] = this->bY + ijk[1]*this->hY;
+    bds[3] = bds[2] + this->hY;
+    bds[4] = this->bZ + ijk[2]*this->hZ;
+    bds[5] = bds[4] + this->hZ;
+  }
+
+  // Calculate the distance between the point x and the specified bounds
+  static double Distance2ToBounds(const double x[3], const double bds[6])
+  {
+    double d, dist2 = 0.0;
+    for (int i=0; i < 3; ++i)
+    {
+      if ( x[i] < bds[2*i] )
+      {
+        d = bds[2*i] - x[i];
+        dist2 += d*d;
+      }
+      else if ( x[i] > bds[2*i+1] )
+      {
+        d = x[i] - bds[2*i+1];
+        dist2 += d*d;
+      }
+    }
+    return dist2;
+  }
+};
+
+namespace {
+
+//-----------------------------------------------------------------------------
+// Compute and cache the cell bounds in parallel.
+struct ComputeCellBounds
+{
+  vtkDataSet *DataSet;
+  double (*CellBounds)[6];
+
+  ComputeCellBounds(vtkDataSet *ds, double (*bds)[6]) :
+    DataSet(ds), CellBounds(bds)
+  {
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    for ( ; cellId < endCellId; ++cellId )
+    {
+      this->DataSet->GetCellBounds(cellId, this->CellBounds[cellId]);
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Count the number of bins overlapped by each cell.
+struct CountFragments
+{
+  const vtkCellBinner *Binner;
+  vtkIdType *Counts;
+
+  CountFragments(const vtkCellBinner *binner, vtkIdType *counts) :
+    Binner(binner), Counts(counts)
+  {
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    int ijkMin[3], ijkMax[3];
+    for ( ; cellId < endCellId; ++cellId )
+    {
+      this->Counts[cellId] = this->Binner->
+        GetBinRange(this->Binner->CellBounds[cellId], ijkMin, ijkMax);
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Keep track of the closest cell during the search of the closest point.
+struct ClosestCell
+{
+  vtkIdType CellId;
+  int SubId;
+  int Inside;
+  double Dist2;
+  double Point[3];
+};
+
+//-----------------------------------------------------------------------------
+// The following tuple is what is sorted in the map. Note that it is
+// templated because depending on the number of cells / bins to process we
+// may want to use vtkIdType. Otherwise for performance reasons it's best to
+// use an int (or other integral type). See vtkStaticPointLocator.
+template <typename TTuple>
+class CellFragment
+{
+public:
+  TTuple CellId; //originating cell id
+  TTuple BinId; //i-j-k index into bin space
+
+  //Operator< used to support the subsequent sort operation.
+  bool operator< (const CellFragment& tuple) const
+    {return BinId < tuple.BinId;}
+};
+
+//-----------------------------------------------------------------------------
+// This templated class manages the creation of the static locator
+// structures and implements the queries.
+template <typename TIds>
+class CellProcessor : public vtkCellBinner
+{
+public:
+  CellFragment<TIds> *Map; //the map to be sorted
+  TIds               *Offsets; //offsets for each bin into the map
+
+  // Construction
+  CellProcessor(vtkStaticCellLocator *loc, vtkIdType numCells,
+                vtkIdType numFrags, vtkIdType numBins) :
+    vtkCellBinner(loc, numCells, numFrags, numBins)
+  {
+      this->Map = new CellFragment<TIds>[numFrags];
+      this->Offsets = new TIds[numBins+1];
+  }
+
+  // Release allocated memory
+  ~CellProcessor() VTK_OVERRIDE
+  {
+      delete [] this->Map;
+      delete [] this->Offsets;
+  }
+
+  // The number of cell ids in a bin is determined by computing the
+  // difference between the offsets into the sorted cells array.
+  vtkIdType GetNumberOfIds(vtkIdType binNum) const
+  {
+      return (this->Offsets[binNum+1] - this->Offsets[binNum]);
+  }
+
+  // Given a bin number, return the cells in that bin.
+  const CellFragment<TIds> *GetIds(vtkIdType binNum) const
+  {
+      return this->Map + this->Offsets[binNum];
+  }
+
+  // Generate the fragments of a range of cells.
+  struct MapCells
+  {
+    CellProcessor<TIds> *Processor;
+    const vtkIdType *CellOffsets;
+
+    MapCells(CellProcessor<TIds> *p, const vtkIdType *offsets) :
+      Processor(p), CellOffsets(offsets)
+    {
+    }
+
+    void operator()(vtkIdType cellId, vtkIdType endCellId)
+    {
+      CellProcessor<TIds> *p = this->Processor;
+      CellFragment<TIds> *t = p->Map + this->CellOffsets[cellId];
+      int i, j, k, ijkMin[3], ijkMax[3];
+      vtkIdType jOffset, kOffset;
+      for ( ; cellId < endCellId; ++cellId )
+      {
+        if ( p->GetBinRange(p->CellBounds[cellId], ijkMin, ijkMax) == 0 )
+        {
+          continue;
+        }
+        for ( k=ijkMin[2]; k <= ijkMax[2]; ++k )
+        {
+          kOffset = k*p->xyD;
+          for ( j=ijkMin[1]; j <= ijkMax[1]; ++j )
+          {
+            jOffset = j*p->xD;
+            for ( i=ijkMin[0]; i <= ijkMax[0]; ++i, ++t )
+            {
+              t->CellId = static_cast<TIds>(cellId);
+              t->BinId = static_cast<TIds>(i + jOffset + kOffset);
+            }
+          }
+        }
+      }
+    }
+  };
+
+  // Build the bin offsets from the sorted fragments. Each thread processes a
+  // range of fragments and fills the offsets of the bins which start in this
+  // range, so that each offset is written once.
+  struct MapOffsets
+  {
+    CellProcessor<TIds> *Processor;
+
+    MapOffsets(CellProcessor<TIds> *p) : Processor(p)
+    {
+    }
+
+    void operator()(vtkIdType fragId, vtkIdType endFragId)
+    {
+      const CellFragment<TIds> *map = this->Processor->Map;
+      TIds *offsets = this->Processor->Offsets;
+      for ( ; fragId < endFragId; ++fragId )
+      {
+        vtkIdType prevBin = (fragId == 0 ? -1 : map[fragId-1].BinId);
+        if ( map[fragId].BinId != prevBin )
+        {
+          std::fill(offsets + prevBin + 1, offsets + map[fragId].BinId + 1,
+                    static_cast<TIds>(fragId));
+        }
+      }
+    }
+  };
+
+  // Build the map and other structures to support locator operations
+  void BuildLocator(const vtkIdType *cellOffsets) VTK_OVERRIDE
+  {
+      MapCells mapper(this, cellOffsets);
+      vtkSMPTools::For(0, this->NumCells, mapper);
+
+      // Now gather the cells into contiguous runs in bins
+      vtkSMPTools::Sort(this->Map, this->Map + this->NumFragments);
+
+      // Build the offsets into the Map. The offsets past the last bin
+      // holding cells refer to the end of the map.
+      MapOffsets offMapper(this);
+      vtkSMPTools::For(0, this->NumFragments, offMapper);
+      vtkIdType lastBin = (this->NumFragments > 0 ?
+                           this->Map[this->NumFragments-1].BinId : -1);
+      std::fill(this->Offsets + lastBin + 1,
+                this->Offsets + this->NumBins + 1,
+                static_cast<TIds>(this->NumFragments));
+  }
+
+  // Templated implementations of the locator
+  vtkIdType FindCell(double x[3], double tol2, vtkGenericCell *cell,
+                     double pcoords[3], double *weights);
+  vtkIdType FindCellInBin(const int ijk[3], const int xIjk[3],
+                          const int ijkMin[3], double x[3], double tol2,
+                          vtkGenericCell *cell, double pcoords[3],
+                          double *weights);
+  int FindClosestPointWithinRadius(double x[3], double radius2,
+                                   ClosestCell &closest, vtkGenericCell *cell);
+  int IntersectWithLine(double a0[3], double a1[3], double tol, double &t,
+                        double x[3], double pcoords[3], int &subId,
+                        vtkIdType &cellId, vtkGenericCell *cell);
+  void FindCellsWithinBounds(double *bbox, vtkIdList *cells);
+  void GenerateRepresentation(vtkPolyData *pd);
+};
+
+//-----------------------------------------------------------------------------
+// Search the bins overlapped by the tolerance box around x for a cell
+// containing x within the tolerance, as vtkPointSet::FindCell() does. The
+// bin containing x is searched first, as it holds the cell in most cases.
+template <typename TIds> vtkIdType CellProcessor<TIds>::
+FindCell(double x[3], double tol2, vtkGenericCell *cell, double pcoords[3],
+         double *weights)
+{
+  double tol = sqrt(tol2);
+  double delta[3] = {tol, tol, tol};
+
+  // Points outside of the locator are not in any cell
+  if ( !vtkMath::PointIsWithinBounds(x, this->Bounds, delta) )
+  {
+    return -1;
+  }
+
+  int xIjk[3], ijkMin[3], ijkMax[3], ijk[3];
+  this->GetBinIndices(x, xIjk);
+  vtkIdType cellId = this->FindCellInBin(xIjk, xIjk, xIjk, x, tol2,
+                                         cell, pcoords, weights);
+  if ( cellId >= 0 || tol <= 0.0 )
+  {
+    return cellId;
+  }
+
+  double bbox[6] = {x[0]-tol, x[0]+tol, x[1]-tol, x[1]+tol,
+                    x[2]-tol, x[2]+tol};
+  this->GetBinRange(bbox, ijkMin, ijkMax);
+  for ( ijk[2]=ijkMin[2]; ijk[2] <= ijkMax[2]; ++ijk[2] )
+  {
+    for ( ijk[1]=ijkMin[1]; ijk[1] <= ijkMax[1]; ++ijk[1] )
+    {
+      for ( ijk[0]=ijkMin[0]; ijk[0] <= ijkMax[0]; ++ijk[0] )
+      {
+        if ( ijk[0] != xIjk[0] || ijk[1] != xIjk[1] || ijk[2] != xIjk[2] )
+        {
+          cellId = this->FindCellInBin(ijk, xIjk, ijkMin, x, tol2,
+                                       cell, pcoords, weights);
+          if ( cellId >= 0 )
+          {
+            return cellId;
+          }
+        }
+      }
+    }
+  }
+
+  return -1;
+}
+
+//-----------------------------------------------------------------------------
+// Search the cells of bin ijk for a cell containing x within the tolerance.
+// Unless ijk is the bin of x, the cells overlapping the bin of x or a bin of
+// the search range visited before ijk were already evaluated and are
+// skipped, so that each cell is evaluated once.
+template <typename TIds> vtkIdType CellProcessor<TIds>::
+FindCellInBin(const int ijk[3], const int xIjk[3], const int ijkMin[3],
+              double x[3], double tol2, vtkGenericCell *cell,
+              double pcoords[3], double *weights)
+{
+  double tol = sqrt(tol2), dist2, closestPoint[3];
+  double delta[3] = {tol, tol, tol};
+  int subId, cellMin[3], cellMax[3];
+  bool xBin = (ijk[0] == xIjk[0] && ijk[1] == xIjk[1] && ijk[2] == xIjk[2]);
+
+  vtkIdType binId = ijk[0] + ijk[1]*this->xD + ijk[2]*this->xyD;
+  vtkIdType numIds = this->GetNumberOfIds(binId);
+  const CellFragment<TIds> *ids = this->GetIds(binId);
+  vtkIdType cellId;
+  for (vtkIdType j=0; j < numIds; ++j)
+  {
+    cellId = ids[j].CellId;
+    double *bds = this->CellBounds[cellId];
+    if ( !vtkMath::PointIsWithinBounds(x, bds, delta) )
+    {
+      continue;
+    }
+    if ( !xBin )
+    {
+      this->GetBinRange(bds, cellMin, cellMax);
+      bool overlapsXBin = true, firstBin = true;
+      for ( int i=0; i < 3; ++i )
+      {
+        overlapsXBin = overlapsXBin &&
+          cellMin[i] <= xIjk[i] && xIjk[i] <= cellMax[i];
+        firstBin = firstBin && std::max(cellMin[i], ijkMin[i]) == ijk[i];
+      }
+      if ( overlapsXBin || !firstBin )
+      {
+        continue;
+      }
+    }
+    this->DataSet->GetCell(cellId, cell);
+    if ( cell->EvaluatePosition(x, closestPoint, subId, pcoords, dist2,
+                                weights) == 1 && dist2 <= tol2 )
+    {
+      return cellId;
+    }
+  }
+
+  return -1;
+}
+
+//-----------------------------------------------------------------------------
+// Search the bins in shells of increasing size around the bin of x, until
+// the shells are farther from x than the closest cell found. Cells are only
+// evaluated if their bounds are closer than the current closest cell.
+template <typename TIds> int CellProcessor<TIds>::
+FindClosestPointWithinRadius(double x[3], double radius2,
+                             ClosestCell &closest, vtkGenericCell *cell)
+{
+  double weightsArray[6], pcoords[3], point[3], dist2, bds[6];
+  double *weights = weightsArray;
+  int nWeights = 6, nPoints, subId, status;
+  int ijk[3], bin[3], level, maxLevel;
+  int i, j, k, jkOnShell, iStep;
+  vtkIdType binId, cellId, numIds, ii;
+  const CellFragment<TIds> *ids;
+  double hMin = std::min(this->hX, std::min(this->hY, this->hZ));
+
+  closest.CellId = -1;
+  closest.Dist2 = radius2;
+  this->GetBinIndices(x, ijk);
+  maxLevel = std::max(this->Divisions[0],
+                      std::max(this->Divisions[1], this->Divisions[2]));
+
+  for ( level=0; level < maxLevel; ++level )
+  {
+    // The bins of this shell are at least (level-1) bins away from x
+    double minDist = (level - 1) * hMin;
+    if ( level > 1 && minDist*minDist > closest.Dist2 )
+    {
+      break;
+    }
+
+    for ( k=ijk[2]-level; k <= ijk[2]+level; ++k )
+    {
+      if ( k < 0 || k >= this->Divisions[2] )
+      {
+        continue;
+      }
+      for ( j=ijk[1]-level; j <= ijk[1]+level; ++j )
+      {
+        if ( j < 0 || j >= this->Divisions[1] )
+        {
+          continue;
+        }
+        // Inside the shell only the two extreme bins along x are visited
+        jkOnShell = (k == ijk[2]-level || k == ijk[2]+level ||
+                     j == ijk[1]-level || j == ijk[1]+level);
+        iStep = (jkOnShell || level == 0 ? 1 : 2*level);
+        for ( i=ijk[0]-level; i <= ijk[0]+level; i += iStep )
+        {
+          if ( i < 0 || i >= this->Divisions[0] )
+          {
+            continue;
+          }
+          bin[0] = i; bin[1] = j; bin[2] = k;
+          binId = i + j*this->xD + k*this->xyD;
+          if ( (numIds = this->GetNumberOfIds(binId)) == 0 )
+          {
+            continue;
+          }
+          this->GetBinBounds(bin, bds);
+          if ( this->Distance2ToBounds(x, bds) > closest.Dist2 )
+          {
+            continue;
+          }
+
+          ids = this->GetIds(binId);
+          for ( ii=0; ii < numIds; ++ii )
+          {
+            cellId = ids[ii].CellId;
+            if ( this->Distance2ToBounds(x, this->CellBounds[cellId]) >
+                 closest.Dist2 )
+            {
+              continue;
+            }
+            this->DataSet->GetCell(cellId, cell);
+
+            // make sure we have enough storage space for the weights
+            nPoints = cell->GetPointIds()->GetNumberOfIds();
+            if ( nPoints > nWeights )
+            {
+              if ( nWeights > 6 )
+              {
+                delete [] weights;
+              }
+              weights = new double[2*nPoints];  // allocate some extra room
+              nWeights = 2*nPoints;
+            }
+
+            status = cell->EvaluatePosition(x, point, subId, pcoords,
+                                            dist2, weights);
+            if ( status != -1 && (dist2 < closest.Dist2 ||
+                                  (dist2 == closest.Dist2 &&
+                                   closest.CellId < 0)) )
+            {
+              closest.CellId = cellId;
+              closest.SubId = subId;
+              closest.Inside = status;
+              closest.Dist2 = dist2;
+              closest.Point[0] = point[0];
+              closest.Point[1] = point[1];
+              closest.Point[2] = point[2];
+            }
+          }//for all cells in bin
+        }//i
+      }//j
+    }//k
+  }//for all shells
+
+  if ( nWeights > 6 )
+  {
+    delete [] weights;
+  }
+
+  return ( closest.CellId >= 0 ? 1 : 0 );
+}
+
+//-----------------------------------------------------------------------------
+// Walk the bins along the line (3D DDA). The cells of each bin are
+// intersected with the line and the walk stops at the first bin whose exit
+// point is beyond the closest intersection found.
+template <typename TIds> int CellProcessor<TIds>::
+IntersectWithLine(double a0[3], double a1[3], double tol, double &t,
+                  double x[3], double pcoords[3], int &subId,
+                  vtkIdType &cellId, vtkGenericCell *cell)
+{
+  double bounds[6], t0, t1, x0[3], dir[3], tCell, xCell[3], pcCell[3];
+  double tNext[3], tDelta[3], bestT = VTK_DOUBLE_MAX;
+  double bestX[3] = {0.0, 0.0, 0.0}, bestPcoords[3] = {0.0, 0.0, 0.0};
+  int plane0, plane1, ijk[3], step[3], subCell, bestSubId = 0, i;
+  vtkIdType bestCellId = -1;
+
+  // Clip the line with the locator (with some slack for the tolerance)
+  for ( i=0; i < 3; ++i )
+  {
+    bounds[2*i] = this->Bounds[2*i] - tol;
+    bounds[2*i+1] = this->Bounds[2*i+1] + tol;
+    dir[i] = a1[i] - a0[i];
+  }
+  if ( !vtkBox::IntersectWithLine(bounds, a0, a1, t0, t1, x0, NULL,
+                                  plane0, plane1) )
+  {
+    return 0;
+  }
+
+  // Setup the walk: the bin of the entry point, the parametric coordinate
+  // of the next bin boundary in each direction and the parametric width of
+  // the bins.
+  this->GetBinIndices(x0, ijk);
+  for ( i=0; i < 3; ++i )
+  {
+    if ( dir[i] > 0.0 )
+    {
+      step[i] = 1;
+      tNext[i] = (this->Bounds[2*i] + (ijk[i]+1)*this->H[i] - a0[i]) / dir[i];
+      tDelta[i] = this->H[i] / dir[i];
+    }
+    else if ( dir[i] < 0.0 )
+    {
+      step[i] = -1;
+      tNext[i] = (this->Bounds[2*i] + ijk[i]*this->H[i] - a0[i]) / dir[i];
+      tDelta[i] = -this->H[i] / dir[i];
+    }
+    else
+    {
+      step[i] = 0;
+      tNext[i] = tDelta[i] = VTK_DOUBLE_MAX;
+    }
+  }
+
+  while ( true )
+  {
+    vtkIdType binId = ijk[0] + ijk[1]*this->xD + ijk[2]*this->xyD;
+    vtkIdType numIds = this->GetNumberOfIds(binId);
+    const CellFragment<TIds> *ids = this->GetIds(binId);
+    for ( vtkIdType ii=0; ii < numIds; ++ii )
+    {
+      vtkIdType cId = ids[ii].CellId;
+      double *cellBounds = this->CellBounds[cId];
+      for ( i=0; i < 3; ++i )
+      {
+        bounds[2*i] = cellBounds[2*i] - tol;
+        bounds[2*i+1] = cellBounds[2*i+1] + tol;
+      }
+      if ( !vtkBox::IntersectWithLine(bounds, a0, a1, t0, t1, NULL, NULL,
+                                      plane0, plane1) || t0 >= bestT )
+      {
+        continue;
+      }
+      this->DataSet->GetCell(cId, cell);
+      if ( cell->IntersectWithLine(a0, a1, tol, tCell, xCell, pcCell,
+                                   subCell) && tCell < bestT )
+      {
+        bestT = tCell;
+        bestCellId = cId;
+        bestSubId = subCell;
+        for ( i=0; i < 3; ++i )
+        {
+          bestX[i] = xCell[i];
+          bestPcoords[i] = pcCell[i];
+        }
+      }
+    }
+
+    // Move to the next bin, unless the closest intersection lies before it
+    // or the end of the line is reached.
+    int axis = (tNext[0] < tNext[1] ?
+                (tNext[0] < tNext[2] ? 0 : 2) : (tNext[1] < tNext[2] ? 1 : 2));
+    if ( tNext[axis] >= bestT || tNext[axis] > 1.0 )
+    {
+      break;
+    }
+    ijk[axis] += step[axis];
+    if ( ijk[axis] < 0 || ijk[axis] >= this->Divisions[axis] )
+    {
+      break;
+    }
+    tNext[axis] += tDelta[axis];
+  }
+
+  if ( bestCellId < 0 )
+  {
+    return 0;
+  }
+
+  this->DataSet->GetCell(bestCellId, cell);
+  t = bestT;
+  subId = bestSubId;
+  cellId = bestCellId;
+  for ( i=0; i < 3; ++i )
+  {
+    x[i] = bestX[i];
+    pcoords[i] = bestPcoords[i];
+  }
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+template <typename TIds> void CellProcessor<TIds>::
+FindCellsWithinBounds(double *bbox, vtkIdList *cells)
+{
+  int ijkMin[3], ijkMax[3], i, j, k;
+  vtkIdType binId, numIds, ii, cellId;
+  const CellFragment<TIds> *ids;
+  std::vector<vtkIdType> found;
+
+  cells->Reset();
+  if ( bbox[1] < this->Bounds[0] || bbox[0] > this->Bounds[1] ||
+       bbox[3] < this->Bounds[2] || bbox[2] > this->Bounds[3] ||
+       bbox[5] < this->Bounds[4] || bbox[4] > this->Bounds[5] ||
+       this->GetBinRange(bbox, ijkMin, ijkMax) == 0 )
+  {
+    return;
+  }
+
+  for ( k=ijkMin[2]; k <= ijkMax[2]; ++k )
+  {
+    for ( j=ijkMin[1]; j <= ijkMax[1]; ++j )
+    {
+      for ( i=ijkMin[0]; i <= ijkMax[0]; ++i )
+      {
+        binId = i + j*this->xD + k*this->xyD;
+        numIds = this->GetNumberOfIds(binId);
+        ids = this->GetIds(binId);
+        for ( ii=0; ii < numIds; ++ii )
+        {
+          cellId = ids[ii].CellId;
+          const double *bds = this->CellBounds[cellId];
+          if ( bds[0] <= bbox[1] && bds[1] >= bbox[0] &&
+               bds[2] <= bbox[3] && bds[3] >= bbox[2] &&
+               bds[4] <= bbox[5] && bds[5] >= bbox[4] )
+          {
+            found.push_back(cellId);
+          }
+        }
+      }
+    }
+  }
+
+  // Cells overlapping several bins are found several times
+  std::sort(found.begin(), found.end());
+  found.erase(std::unique(found.begin(), found.end()), found.end());
+  cells->SetNumberOfIds(static_cast<vtkIdType>(found.size()));
+  std::copy(found.begin(), found.end(), cells->GetPointer(0));
+}
+
+//-----------------------------------------------------------------------------
+// Build polygonal representation of locator: the outline of each non-empty
+// bin.
+template <typename TIds> void CellProcessor<TIds>::
+GenerateRepresentation(vtkPolyData *pd)
+{
+  static const int faces[6][4] = { {0,2,6,4}, {1,3,7,5}, {0,1,5,4},
+                                   {2,3,7,6}, {0,1,3,2}, {4,5,7,6} };
+  vtkPoints *pts = vtkPoints::New();
+  vtkCellArray *polys = vtkCellArray::New();
+  int ijk[3], f, v;
+  double bds[6], x[3];
+  vtkIdType ids[8], quad[4];
+
+  for ( ijk[2]=0; ijk[2] < this->Divisions[2]; ++ijk[2] )
+  {
+    for ( ijk[1]=0; ijk[1] < this->Divisions[1]; ++ijk[1] )
+    {
+      for ( ijk[0]=0; ijk[0] < this->Divisions[0]; ++ijk[0] )
+      {
+        if ( this->GetNumberOfIds(ijk[0] + ijk[1]*this->xD +
+                                  ijk[2]*this->xyD) == 0 )
+        {
+          continue;
+        }
+        this->GetBinBounds(ijk, bds);
+        for ( v=0; v < 8; ++v )
+        {
+          x[0] = bds[v & 1];
+          x[1] = bds[2 + ((v >> 1) & 1)];
+          x[2] = bds[4 + ((v >> 2) & 1)];
+          ids[v] = pts->InsertNextPoint(x);
+        }
+        for ( f=0; f < 6; ++f )
+        {
+          for ( v=0; v < 4; ++v )
+          {
+            quad[v] = ids[faces[f][v]];
+          }
+          polys->InsertNextCell(4, quad);
+        }
+      }
+    }
+  }
+
+  pd->SetPoints(pts);
+  pts->Delete();
+  pd->SetPolys(polys);
+  polys->Delete();
+  pd->Squeeze();
+}
+
+} //anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Here is the VTK class proper. It's implemented with the templated
+// CellProcessor class.
+
+//-----------------------------------------------------------------------------
+// Construct with automatic computation of divisions, averaging
+// 10 cells per bin.
+vtkStaticCellLocator::vtkStaticCellLocator()
+{
+  this->NumberOfCellsPerNode = 10;
+  this->Divisions[0] = this->Divisions[1] = this->Divisions[2] = 50;
+  this->H[0] = this->H[1] = this->H[2] = 0.0;
+  this->Bounds[0] = this->Bounds[2] = this->Bounds[4] = 0.0;
+  this->Bounds[1] = this->Bounds[3] = this->Bounds[5] = 1.0;
+  this->MaxNumberOfBuckets = VTK_INT_MAX;
+  this->Binner = NULL;
+  this->LargeIds = false;
+}
+
+//-----------------------------------------------------------------------------
+vtkStaticCellLocator::~vtkStaticCellLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::Initialize()
+{
+  this->FreeSearchStructure();
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::FreeSearchStructure()
+{
+  if ( this->Binner )
+  {
+    delete this->Binner;
+    this->Binner = NULL;
+  }
+  this->FreeCellBounds();
+}
+
+//-----------------------------------------------------------------------------
+//  Method to form subdivision of space based on the cells provided and
+//  subject to the constraints of NumberOfCellsPerNode and
+//  MaxNumberOfBuckets. The result is directly addressable and of uniform
+//  subdivision.
+void vtkStaticCellLocator::BuildLocator()
+{
+  vtkIdType numCells;
+  int ndivs[3];
+  int i;
+
+  if ( (this->Binner != NULL) && (this->BuildTime > this->MTime)
+       && (this->BuildTime > this->DataSet->GetMTime()) )
+  {
+    return;
+  }
+
+  vtkDebugMacro( << "Binning cells..." );
+  this->Level = 1; //only single lowest level - from superclass
+
+  if ( !this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1 )
+  {
+    vtkErrorMacro( << "No cells to locate");
+    return;
+  }
+
+  //  Make sure the appropriate data is available
+  //
+  this->FreeSearchStructure();
+
+  //  Size the root bin. Zero widths are padded so that each bin has a
+  //  finite size.
+  //
+  const double *bounds = this->DataSet->GetBounds();
+  double length[3];
+  int numNonZeroWidths = 3;
+  for (i=0; i<3; i++)
+  {
+    this->Bounds[2*i] = bounds[2*i];
+    this->Bounds[2*i+1] = bounds[2*i+1];
+    if ( this->Bounds[2*i+1] <= this->Bounds[2*i] ) //prevent zero width
+    {
+      this->Bounds[2*i+1] = this->Bounds[2*i] + 1.0;
+      numNonZeroWidths--;
+      length[i] = 0.0;
+    }
+    else
+    {
+      length[i] = this->Bounds[2*i+1] - this->Bounds[2*i];
+    }
+  }
+
+  vtkIdType maxBins = this->MaxNumberOfBuckets;
+  if ( this->Automatic )
+  {
+    // Divide the non-zero widths proportionally to their length, so that
+    // the bins are roughly cubes.
+    double numBins = static_cast<double>(numCells) / this->NumberOfCellsPerNode;
+    numBins = (numBins < maxBins ? numBins : maxBins);
+    double volume = 1.0;
+    for (i=0; i<3; i++)
+    {
+      volume *= (length[i] > 0.0 ? length[i] : 1.0);
+    }
+    double f = (numNonZeroWidths > 0 ?
+                pow(numBins / volume, 1.0/numNonZeroWidths) : 0.0);
+    for (i=0; i<3; i++)
+    {
+      double n = f * length[i] + 0.5;
+      ndivs[i] = (n < 100000.0 ? static_cast<int>(n) : 100000);
+    }
+  }//automatic
+  else
+  {
+    for (i=0; i<3; i++)
+    {
+      ndivs[i] = this->Divisions[i];
+    }
+  }
+
+  // Clamp the divisions, then reduce them until the maximum number of bins
+  // is honored.
+  for (i=0; i<3; i++)
+  {
+    ndivs[i] = (ndivs[i] < 1 ? 1 : (ndivs[i] <= 100000 ? ndivs[i] : 100000));
+  }
+  while ( static_cast<vtkIdType>(ndivs[0])*ndivs[1]*ndivs[2] > maxBins )
+  {
+    int maxAxis = (ndivs[0] >= ndivs[1] ? (ndivs[0] >= ndivs[2] ? 0 : 2) :
+                   (ndivs[1] >= ndivs[2] ? 1 : 2));
+    ndivs[maxAxis] = (ndivs[maxAxis] > 1 ? ndivs[maxAxis] / 2 : 1);
+  }
+  for (i=0; i<3; i++)
+  {
+    this->Divisions[i] = ndivs[i];
+    this->H[i] = (this->Bounds[2*i+1] - this->Bounds[2*i]) / ndivs[i] ;
+  }
+  vtkIdType numBins = static_cast<vtkIdType>(ndivs[0])*ndivs[1]*ndivs[2];
+
+  // Compute the cell bounds. The first cell is processed serially so that
+  // lazily built dataset structures (e.g. the cells of vtkPolyData) are
+  // built before threading.
+  this->CellBounds = new double [numCells][6];
+  this->DataSet->GetCellBounds(0, this->CellBounds[0]);
+  this->DataSet->GetCell(0, this->GenericCell);
+  ComputeCellBounds cellBounds(this->DataSet, this->CellBounds);
+  vtkSMPTools::For(1, numCells, cellBounds);
+
+  // Count the fragments of each cell, and convert the counts into offsets.
+  // The number of fragments determines the type of ids.
+  std::vector<vtkIdType> cellOffsets(numCells + 1);
+  {
+    // An empty processor provides the geometry of the bins
+    CellProcessor<vtkIdType> counter(this, numCells, 0, 0);
+    CountFragments count(&counter, &cellOffsets[0]);
+    vtkSMPTools::For(0, numCells, count);
+  }
+  vtkIdType numFrags = vtkSMPTools::ExclusiveScan(
+    cellOffsets.begin(), cellOffsets.begin() + numCells, cellOffsets.begin(),
+    static_cast<vtkIdType>(0));
+  cellOffsets[numCells] = numFrags;
+
+  // Instantiate the locator. The type is related to the maximum cell id and
+  // fragment id. This is done for performance (e.g., the sort is faster)
+  // and significant memory savings.
+  //
+  if ( numCells >= VTK_INT_MAX || numBins >= VTK_INT_MAX ||
+       numFrags >= VTK_INT_MAX )
+  {
+    this->LargeIds = true;
+    this->Binner = new CellProcessor<vtkIdType>(this,numCells,numFrags,numBins);
+  }
+  else
+  {
+    this->LargeIds = false;
+    this->Binner = new CellProcessor<int>(this,numCells,numFrags,numBins);
+  }
+
+  // Actually construct the locator
+  this->Binner->BuildLocator(&cellOffsets[0]);
+
+  this->BuildTime.Modified();
+}
+
+//-----------------------------------------------------------------------------
+// These methods satisfy the vtkStaticCellLocator API. The implementation is
+// with the templated CellProcessor class, as in vtkStaticPointLocator.
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkStaticCellLocator::
+FindCell(double x[3], double tol2, vtkGenericCell *GenCell, double pcoords[3],
+         double *weights)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Binner )
+  {
+    return -1;
+  }
+
+  if ( this->LargeIds )
+  {
+    return static_cast<CellProcessor<vtkIdType>*>(this->Binner)->
+      FindCell(x,tol2,GenCell,pcoords,weights);
+  }
+  else
+  {
+    return static_cast<CellProcessor<int>*>(this->Binner)->
+      FindCell(x,tol2,GenCell,pcoords,weights);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::
+FindClosestPoint(double x[3], double closestPoint[3], vtkGenericCell *cell,
+                 vtkIdType &cellId, int &subId, double& dist2)
+{
+  int inside;
+  if ( !this->FindClosestPointWithinRadius(x, VTK_DOUBLE_MAX, closestPoint,
+                                           cell, cellId, subId, dist2, inside) )
+  {
+    cellId = -1;
+  }
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkStaticCellLocator::
+FindClosestPointWithinRadius(double x[3], double radius, double closestPoint[3],
+                             vtkGenericCell *cell, vtkIdType &cellId,
+                             int &subId, double& dist2, int &inside)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Binner )
+  {
+    return 0;
+  }
+
+  ClosestCell closest;
+  double radius2 = (radius < sqrt(VTK_DOUBLE_MAX) ? radius*radius :
+                    VTK_DOUBLE_MAX);
+  int found;
+  if ( this->LargeIds )
+  {
+    found = static_cast<CellProcessor<vtkIdType>*>(this->Binner)->
+      FindClosestPointWithinRadius(x,radius2,closest,cell);
+  }
+  else
+  {
+    found = static_cast<CellProcessor<int>*>(this->Binner)->
+      FindClosestPointWithinRadius(x,radius2,closest,cell);
+  }
+
+  if ( found )
+  {
+    this->DataSet->GetCell(closest.CellId, cell);
+    cellId = closest.CellId;
+    subId = closest.SubId;
+    dist2 = closest.Dist2;
+    inside = closest.Inside;
+    closestPoint[0] = closest.Point[0];
+    closestPoint[1] = closest.Point[1];
+    closestPoint[2] = closest.Point[2];
+  }
+  return found;
+}
+
+//-----------------------------------------------------------------------------
+int vtkStaticCellLocator::
+IntersectWithLine(double p1[3], double p2[3], double tol, double& t,
+                  double x[3], double pcoords[3], int &subId,
+                  vtkIdType &cellId, vtkGenericCell *cell)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Binner )
+  {
+    return 0;
+  }
+
+  if ( this->LargeIds )
+  {
+    return static_cast<CellProcessor<vtkIdType>*>(this->Binner)->
+      IntersectWithLine(p1,p2,tol,t,x,pcoords,subId,cellId,cell);
+  }
+  else
+  {
+    return static_cast<CellProcessor<int>*>(this->Binner)->
+      IntersectWithLine(p1,p2,tol,t,x,pcoords,subId,cellId,cell);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::FindCellsWithinBounds(double *bbox, vtkIdList *cells)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Binner )
+  {
+    cells->Reset();
+    return;
+  }
+
+  if ( this->LargeIds )
+  {
+    static_cast<CellProcessor<vtkIdType>*>(this->Binner)->
+      FindCellsWithinBounds(bbox,cells);
+  }
+  else
+  {
+    static_cast<CellProcessor<int>*>(this->Binner)->
+      FindCellsWithinBounds(bbox,cells);
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool vtkStaticCellLocator::InsideCellBounds(double x[3], vtkIdType cellId)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->CellBounds )
+  {
+    return false;
+  }
+  double delta[3] = {0.0, 0.0, 0.0};
+  return vtkMath::PointIsWithinBounds(x, this->CellBounds[cellId], delta) != 0;
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkStaticCellLocator::GetNumberOfCellsInBucket(vtkIdType bNum)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Binner )
+  {
+    return 0;
+  }
+
+  if ( this->LargeIds )
+  {
+    return static_cast<CellProcessor<vtkIdType>*>(this->Binner)->
+      GetNumberOfIds(bNum);
+  }
+  else
+  {
+    return static_cast<CellProcessor<int>*>(this->Binner)->
+      GetNumberOfIds(bNum);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::
+GenerateRepresentation(int vtkNotUsed(level), vtkPolyData *pd)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Binner )
+  {
+    return;
+  }
+
+  if ( this->LargeIds )
+  {
+    static_cast<CellProcessor<vtkIdType>*>(this->Binner)->
+      GenerateRepresentation(pd);
+  }
+  else
+  {
+    static_cast<CellProcessor<int>*>(this->Binner)->
+      GenerateRepresentation(pd);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Divisions: (" << this->Divisions[0] << ", "
+     << this->Divisions[1] << ", " << this->Divisions[2] << ")\n";
+  os << indent << "Max Number Of Buckets: "
+     << this->MaxNumberOfBuckets << "\n";
+  os << indent << "Large Ids: " << this->LargeIds << "\n";
+}
@@ -0,0 +1,207 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticCellLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkStaticCellLocator
+ * @brief   perform fast cell location operations
+ *
+ * vtkStaticCellLocator is a type of vtkAbstractCellLocator that accelerates
+ * certain operations when performing spatial operations on cells. These
+ * operations include finding a point that contains a cell, the closest
+ * point to a cell, and intersecting a line with the cells.
+ *
+ * vtkStaticCellLocator does for cells what vtkStaticPointLocator does for
+ * points. It divides a specified region of space into a regular array of
+ * cuboid bins, and then keeps a list of the cells whose bounding box
+ * overlaps each bin. The locator is threaded (via vtkSMPTools) and
+ * constructed once (i.e., it does not support incremental insertion of
+ * cells): the bin ids of each (cell, bin) pair are computed in parallel,
+ * then sorted with vtkSMPTools::Sort() so that the cells of each bin are
+ * contiguous.
+ *
+ * Once built, the queries which take a vtkGenericCell (and the weights
+ * buffer, if any) are thread safe: several threads can query the locator
+ * concurrently, each one with its own vtkGenericCell.
+ *
+ * @warning
+ * This class is templated. It may run slower than serial execution if the
+ * code is not optimized during compilation. Build in Release or
+ * ReleaseWithDebugInfo.
+ *
+ * @warning
+ * The cell bounds are always cached (CacheCellBounds is ignored): they are
+ * needed to bin the cells.
+ *
+ * @sa
+ * vtkAbstractCellLocator vtkCellLocator vtkStaticPointLocator
+*/
+
+#ifndef vtkStaticCellLocator_h
+#define vtkStaticCellLocator_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkAbstractCellLocator.h"
+
+class vtkCellBinner;
+
+
+class VTKCOMMONDATAMODEL_EXPORT vtkStaticCellLocator : public vtkAbstractCellLocator
+{
+friend class vtkCellBinner;
+public:
+  /**
+   * Construct with automatic computation of divisions, averaging 10 cells
+   * per bin.
+   */
+  static vtkStaticCellLocator *New();
+
+  //@{
+  /**
+   * Standard type and print methods.
+   */
+  vtkTypeMacro(vtkStaticCellLocator,vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent) VTK_OVERRIDE;
+  //@}
+
+  //@{
+  /**
+   * Set the number of divisions in x-y-z directions. If the Automatic data
+   * member is enabled, the Divisions are set according to the
+   * NumberOfCellsPerNode data member, proportionally to the extent of the
+   * data in each direction.
+   */
+  vtkSetVector3Macro(Divisions,int);
+  vtkGetVectorMacro(Divisions,int,3);
+  //@}
+
+  //@{
+  /**
+   * Set the maximum number of bins of the locator. This caps the divisions
+   * computed automatically as well as the ones specified. Default is
+   * VTK_INT_MAX.
+   */
+  vtkSetClampMacro(MaxNumberOfBuckets,vtkIdType,1000,VTK_ID_MAX);
+  vtkGetMacro(MaxNumberOfBuckets,vtkIdType);
+  //@}
+
+  // Re-use any superclass signatures that we don't override.
+  using vtkAbstractCellLocator::IntersectWithLine;
+  using vtkAbstractCellLocator::FindClosestPoint;
+  using vtkAbstractCellLocator::FindClosestPointWithinRadius;
+  using vtkAbstractCellLocator::FindCell;
+
+  /**
+   * Find the cell containing a given point. Returns -1 if no cell found. As
+   * in vtkPointSet::FindCell(), the point must lie within the squared
+   * distance tol2 of the cell (which matters for cells of dimension lower
+   * than 3). The cell parameters are copied into the supplied variables;
+   * the weights buffer must hold GetMaxCellSize() values of the dataset.
+   */
+  vtkIdType FindCell(double x[3], double tol2, vtkGenericCell *GenCell,
+                     double pcoords[3], double *weights) VTK_OVERRIDE;
+
+  /**
+   * Return the closest point and the cell which is closest to the point x.
+   * The closest point is somewhere on a cell, it need not be one of the
+   * vertices of the cell.
+   */
+  void FindClosestPoint(
+    double x[3], double closestPoint[3], vtkGenericCell *cell,
+    vtkIdType &cellId, int &subId, double& dist2) VTK_OVERRIDE;
+
+  /**
+   * Return the closest point within a specified radius and the cell which
+   * is closest to the point x. The closest point is somewhere on a cell, it
+   * need not be one of the vertices of the cell. This method returns 1 if a
+   * point is found within the specified radius. If there are no cells
+   * within the specified radius, the method returns 0 and the values of
+   * closestPoint, cellId, subId, and dist2 are undefined. If a closest
+   * point is found, inside returns the return value of the EvaluatePosition
+   * call to the closest cell; inside(=1) or outside(=0).
+   */
+  vtkIdType FindClosestPointWithinRadius(
+    double x[3], double radius, double closestPoint[3], vtkGenericCell *cell,
+    vtkIdType &cellId, int &subId, double& dist2, int &inside) VTK_OVERRIDE;
+
+  /**
+   * Return the intersection point (if any) AND the cell which was
+   * intersected by the finite line, the closest to p1 along the line. The
+   * cell is returned as a cell id and as a generic cell.
+   */
+  int IntersectWithLine(
+    double p1[3], double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int &subId, vtkIdType &cellId,
+    vtkGenericCell *cell) VTK_OVERRIDE;
+
+  /**
+   * Return a list of unique cell ids whose bounds intersect the bounding
+   * box bbox.
+   */
+  void FindCellsWithinBounds(double *bbox, vtkIdList *cells) VTK_OVERRIDE;
+
+  /**
+   * Quickly test if a point is inside the bounds of a particular cell.
+   */
+  bool InsideCellBounds(double x[3], vtkIdType cellId) VTK_OVERRIDE;
+
+  //@{
+  /**
+   * Satisfy vtkLocator abstract interface. These methods are not thread
+   * safe.
+   */
+  void Initialize() VTK_OVERRIDE;
+  void FreeSearchStructure() VTK_OVERRIDE;
+  void BuildLocator() VTK_OVERRIDE;
+  void GenerateRepresentation(int level, vtkPolyData *pd) VTK_OVERRIDE;
+  //@}
+
+  /**
+   * Given a bin number bNum between 0 <= bNum < GetNumberOfBuckets(),
+   * return the number of cells overlapping the bin.
+   */
+  vtkIdType GetNumberOfCellsInBucket(vtkIdType bNum);
+
+  /**
+   * Return the number of bins of the locator, once built.
+   */
+  vtkIdType GetNumberOfBuckets()
+    {return static_cast<vtkIdType>(this->Divisions[0])*this->Divisions[1]*
+       this->Divisions[2];}
+
+  /**
+   * Inform the user as to whether large ids are being used. This flag only
+   * has meaning after the locator has been built. Large ids are used when
+   * the number of cells, of bins or of (cell, bin) pairs is >= the signed
+   * integer max value.
+   */
+  bool GetLargeIds() {return this->LargeIds;}
+
+protected:
+  vtkStaticCellLocator();
+  ~vtkStaticCellLocator() VTK_OVERRIDE;
+
+  double Bounds[6]; // Bounding box of the whole dataset
+  int Divisions[3]; // Number of sub-divisions in x-y-z directions
+  double H[3]; // Width of each bin in x-y-z directions
+  vtkIdType MaxNumberOfBuckets; // Maximum number of bins
+  vtkCellBinner *Binner; // Lists of cell ids in each bin
+  bool LargeIds; //indicate whether integer ids are small or large
+
+private:
+  vtkStaticCellLocator(const vtkStaticCellLocator&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkStaticCellLocator&) VTK_DELETE_FUNCTION;
+
+};
+
+#endif
@@ -16,11 +16,13 @@
 
 #include "vtkCellArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
 #include "vtkSMPTools.h"
 
 #include <vector>
@@ -421,6 +423,20 @@ public:
 };
 
 
+namespace {
+//-----------------------------------------------------------------------------
+// Obtaining closest points requires sorting nearby points
+class IdTuple
+{
+public:
+  vtkIdType PtId;
+  double    Dist2;
+
+  bool operator< (const IdTuple& tuple) const
+    {return Dist2 < tuple.Dist2;}
+};
+}
+
 //-----------------------------------------------------------------------------
 // This templates class manages the creation of the static locator
 // structures. It also implements the operator() functors which are supplied
@@ -484,6 +500,26 @@ public:
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList *result);
   void GenerateRepresentation(int vtkNotUsed(level), vtkPolyData *pd);
 
+  // Variants of the queries above working in caller-provided memory, so
+  // that the batch queries do not allocate memory for each query point.
+  // FindClosestNPoints() returns the number of points found (<= N) in res,
+  // sorted. FindPointsWithinRadius() returns the number of points found and
+  // writes their ids in result, unless result is NULL.
+  vtkIdType FindClosestPoint(const double x[3], NeighborBuckets *buckets);
+  int FindClosestNPoints(int N, const double x[3], NeighborBuckets *buckets,
+                         IdTuple *res);
+  vtkIdType FindPointsWithinRadius(double R, const double x[3],
+                                   vtkIdType *result);
+
+  // Batch queries, threaded over the query points
+  void FindClosestPoints(vtkPoints *queryPts, vtkIdType *closest);
+  void FindClosestNPoints(int N, vtkPoints *queryPts, vtkIdType *closest);
+  vtkIdType FindPointsWithinRadius(double R, vtkPoints *queryPts,
+                                   vtkIdType *offsets, vtkIdTypeArray *ids);
+
+  // Threaded merging of coincident points
+  void MergePoints(double tol, vtkIdType *mergeMap);
+
   // Internal methods
   void GetOverlappingBuckets(NeighborBuckets* buckets, const double x[3],
                              const int ijk[3], double dist, int level);
@@ -663,7 +699,7 @@ public:
 //-----------------------------------------------------------------------------
 // Given a position x, return the id of the point closest to it.
 template <typename TIds> vtkIdType BucketList<TIds>::
-FindClosestPoint(const double x[3])
+FindClosestPoint(const double x[3], NeighborBuckets *buckets)
 {
   int i, j;
   double minDist2;
@@ -672,7 +708,6 @@ FindClosestPoint(const double x[3])
   int closest, level;
   vtkIdType ptId, cno, numIds;
   int ijk[3], *nei;
-  NeighborBuckets buckets;
   const LocatorTuple<TIds> *ids;
 
   //  Find bucket point is in.
@@ -687,11 +722,11 @@ FindClosestPoint(const double x[3])
          (level < this->Divisions[0] || level < this->Divisions[1] ||
           level < this->Divisions[2]); level++)
   {
-    this->GetBucketNeighbors (&buckets, ijk, this->Divisions, level);
+    this->GetBucketNeighbors (buckets, ijk, this->Divisions, level);
 
-    for (i=0; i<buckets.GetNumberOfNeighbors(); i++)
+    for (i=0; i<buckets->GetNumberOfNeighbors(); i++)
     {
-      nei = buckets.GetPoint(i);
+      nei = buckets->GetPoint(i);
       cno = nei[0] + nei[1]*this->xD + nei[2]*this->xyD;
 
       if ( (numIds = this->GetNumberOfIds(cno)) > 0 )
@@ -718,10 +753,10 @@ FindClosestPoint(const double x[3])
   //
   if ( minDist2 > 0.0 )
   {
-    this->GetOverlappingBuckets (&buckets, x, ijk, sqrt(minDist2), 0);
-    for (i=0; i<buckets.GetNumberOfNeighbors(); i++)
+    this->GetOverlappingBuckets (buckets, x, ijk, sqrt(minDist2), 0);
+    for (i=0; i<buckets->GetNumberOfNeighbors(); i++)
     {
-      nei = buckets.GetPoint(i);
+      nei = buckets->GetPoint(i);
       cno = nei[0] + nei[1]*this->xD + nei[2]*this->xyD;
 
       if ( (numIds = this->GetNumberOfIds(cno)) > 0 )
@@ -744,6 +779,14 @@ FindClosestPoint(const double x[3])
   return closest;
 }
 
+//-----------------------------------------------------------------------------
+template <typename TIds> vtkIdType BucketList<TIds>::
+FindClosestPoint(const double x[3])
+{
+  NeighborBuckets buckets;
+  return this->FindClosestPoint(x, &buckets);
+}
+
 //-----------------------------------------------------------------------------
 template <typename TIds> vtkIdType BucketList<TIds>::
 FindClosestPointWithinRadius(double radius, const double x[3],
@@ -921,23 +964,10 @@ FindClosestPointWithinRadius(double radius, const double x[3],
   return closest;
 }
 
-namespace {
 //-----------------------------------------------------------------------------
-// Obtaining closest points requires sorting nearby points
-class IdTuple
-{
-public:
-  vtkIdType PtId;
-  double    Dist2;
-
-  bool operator< (const IdTuple& tuple) const
-    {return Dist2 < tuple.Dist2;}
-};
-}
-
-//-----------------------------------------------------------------------------
-template <typename TIds> void BucketList<TIds>::
-FindClosestNPoints(int N, const double x[3], vtkIdList *result)
+template <typename TIds> int BucketList<TIds>::
+FindClosestNPoints(int N, const double x[3], NeighborBuckets *buckets,
+                   IdTuple *res)
 {
   int i, j;
   double dist2;
@@ -945,12 +975,8 @@ FindClosestNPoints(int N, const double x[3], vtkIdList *result)
   int level;
   vtkIdType ptId, cno, numIds;
   int ijk[3], *nei;
-  NeighborBuckets buckets;
   const LocatorTuple<TIds> *ids;
 
-  // Clear out any previous results
-  result->Reset();
-
   //  Find the bucket the point is in.
   //
   this->GetBucketIndices(x, ijk);
@@ -961,14 +987,13 @@ FindClosestNPoints(int N, const double x[3], vtkIdList *result)
   level = 0;
   double maxDistance = 0.0;
   int currentCount = 0;
-  IdTuple *res = new IdTuple [N];
 
-  this->GetBucketNeighbors (&buckets, ijk, this->Divisions, level);
-  while (buckets.GetNumberOfNeighbors() && currentCount < N)
+  this->GetBucketNeighbors (buckets, ijk, this->Divisions, level);
+  while (buckets->GetNumberOfNeighbors() && currentCount < N)
   {
-    for (i=0; i<buckets.GetNumberOfNeighbors(); i++)
+    for (i=0; i<buckets->GetNumberOfNeighbors(); i++)
     {
-      nei = buckets.GetPoint(i);
+      nei = buckets->GetPoint(i);
       cno = nei[0] + nei[1]*this->xD + nei[2]*this->xyD;
 
       if ( (numIds = this->GetNumberOfIds(cno)) > 0 )
@@ -1004,18 +1029,23 @@ FindClosestNPoints(int N, const double x[3], vtkIdList *result)
       }
     }
     level++;
-    this->GetBucketNeighbors (&buckets, ijk, this->Divisions, level);
+    this->GetBucketNeighbors (buckets, ijk, this->Divisions, level);
   }
 
   // do a sort
   std::sort(res, res+currentCount);
 
-  // Now do the refinement
-  this->GetOverlappingBuckets (&buckets, x, ijk, sqrt(maxDistance),level-1);
+  // Now do the refinement. If fewer than N points were found, all the
+  // points have been visited and there is nothing to refine.
+  if ( currentCount < N )
+  {
+    return currentCount;
+  }
+  this->GetOverlappingBuckets (buckets, x, ijk, sqrt(maxDistance),level-1);
 
-  for (i=0; i<buckets.GetNumberOfNeighbors(); i++)
+  for (i=0; i<buckets->GetNumberOfNeighbors(); i++)
   {
-    nei = buckets.GetPoint(i);
+    nei = buckets->GetPoint(i);
     cno = nei[0] + nei[1]*this->xD + nei[2]*this->xyD;
 
     if ( (numIds = this->GetNumberOfIds(cno)) > 0 )
@@ -1037,9 +1067,20 @@ FindClosestNPoints(int N, const double x[3], vtkIdList *result)
     }
   }
 
+  return currentCount;
+}
+
+//-----------------------------------------------------------------------------
+template <typename TIds> void BucketList<TIds>::
+FindClosestNPoints(int N, const double x[3], vtkIdList *result)
+{
+  NeighborBuckets buckets;
+  IdTuple *res = new IdTuple [N];
+
   // Fill in the IdList
-  result->SetNumberOfIds(currentCount);
-  for (i = 0; i < currentCount; i++)
+  int numFound = this->FindClosestNPoints(N, x, &buckets, res);
+  result->SetNumberOfIds(numFound);
+  for (int i = 0; i < numFound; i++)
   {
     result->SetId(i,res[i].PtId);
   }
@@ -1106,6 +1147,67 @@ FindPointsWithinRadius(double R, const double x[3], vtkIdList *result)
   }//k-footprint
 }
 
+//-----------------------------------------------------------------------------
+// Same as above, but the ids are written in a caller-provided buffer (or
+// only counted if the buffer is NULL).
+template <typename TIds> vtkIdType BucketList<TIds>::
+FindPointsWithinRadius(double R, const double x[3], vtkIdType *result)
+{
+  double pt[3];
+  vtkIdType ptId, cno, numIds, numFound=0;
+  double R2 = R*R;
+  const LocatorTuple<TIds> *ids;
+  double xMin[3], xMax[3];
+  int i, j, k, ii, ijkMin[3], ijkMax[3];
+  vtkIdType jOffset, kOffset;
+
+  // Determine the range of indices in each direction based on radius R
+  xMin[0] = x[0] - R;
+  xMin[1] = x[1] - R;
+  xMin[2] = x[2] - R;
+  xMax[0] = x[0] + R;
+  xMax[1] = x[1] + R;
+  xMax[2] = x[2] + R;
+
+  //  Find the footprint in the locator
+  this->GetBucketIndices(xMin, ijkMin);
+  this->GetBucketIndices(xMax, ijkMax);
+
+  // Add points within footprint and radius
+  for ( k=ijkMin[2]; k <= ijkMax[2]; ++k)
+  {
+    kOffset = k*this->xyD;
+    for ( j=ijkMin[1]; j <= ijkMax[1]; ++j)
+    {
+      jOffset = j*this->xD;
+      for ( i=ijkMin[0]; i <= ijkMax[0]; ++i)
+      {
+        cno = i + jOffset + kOffset;
+
+        if ( (numIds = this->GetNumberOfIds(cno)) > 0 )
+        {
+          ids = this->GetIds(cno);
+          for (ii=0; ii < numIds; ii++)
+          {
+            ptId = ids[ii].PtId;
+            this->DataSet->GetPoint(ptId, pt);
+            if ( vtkMath::Distance2BetweenPoints(x,pt) <= R2 )
+            {
+              if ( result )
+              {
+                result[numFound] = ptId;
+              }
+              numFound++;
+            }
+          }//for all points in bucket
+        }//if points in bucket
+      }//i-footprint
+    }//j-footprint
+  }//k-footprint
+
+  return numFound;
+}
+
 //-----------------------------------------------------------------------------
 // Internal method to find those buckets that are within distance specified
 // only those buckets outside of level radiuses of ijk are returned
@@ -1325,6 +1427,355 @@ GenerateRepresentation(int vtkNotUsed(level), vtkPolyData *pd)
   pd->Squeeze();
 }
 
+//-----------------------------------------------------------------------------
+// The following functors support the batch queries. Each thread reuses its
+// own scratch memory (the neighbor bucket lists are large), so that no memory
+// is allocated for each query point.
+struct BatchScratch
+{
+  NeighborBuckets *Buckets;
+  std::vector<IdTuple> Tuples;
+  BatchScratch() : Buckets(NULL) {}
+};
+
+template <typename TIds>
+struct BatchFunctor
+{
+  BucketList<TIds> *BList;
+  vtkPoints *QueryPts;
+  int N;
+  vtkSMPThreadLocal<BatchScratch> Scratch;
+
+  BatchFunctor(BucketList<TIds> *blist, vtkPoints *queryPts, int N) :
+    BList(blist), QueryPts(queryPts), N(N)
+  {
+  }
+
+  void Initialize()
+  {
+    BatchScratch &scratch = this->Scratch.Local();
+    scratch.Buckets = new NeighborBuckets;
+    scratch.Tuples.resize(this->N);
+  }
+
+  void Reduce()
+  {
+    typename vtkSMPThreadLocal<BatchScratch>::iterator itr;
+    for ( itr=this->Scratch.begin(); itr != this->Scratch.end(); ++itr )
+    {
+      delete (*itr).Buckets;
+      (*itr).Buckets = NULL;
+    }
+  }
+};
+
+// Closest point to each query point.
+template <typename TIds>
+struct ClosestPoints : public BatchFunctor<TIds>
+{
+  vtkIdType *Closest;
+
+  ClosestPoints(BucketList<TIds> *blist, vtkPoints *queryPts,
+                vtkIdType *closest) :
+    BatchFunctor<TIds>(blist, queryPts, 0), Closest(closest)
+  {
+  }
+
+  void Initialize()
+  {
+    this->BatchFunctor<TIds>::Initialize();
+  }
+
+  void operator()(vtkIdType qId, vtkIdType endQId)
+  {
+    double x[3];
+    NeighborBuckets *buckets = this->Scratch.Local().Buckets;
+    for ( ; qId < endQId; ++qId )
+    {
+      this->QueryPts->GetPoint(qId, x);
+      this->Closest[qId] = this->BList->FindClosestPoint(x, buckets);
+    }
+  }
+
+  void Reduce()
+  {
+    this->BatchFunctor<TIds>::Reduce();
+  }
+};
+
+// The N closest points to each query point, padded with -1 when the locator
+// holds fewer than N points.
+template <typename TIds>
+struct ClosestNPoints : public BatchFunctor<TIds>
+{
+  vtkIdType *Closest;
+
+  ClosestNPoints(BucketList<TIds> *blist, int N, vtkPoints *queryPts,
+                 vtkIdType *closest) :
+    BatchFunctor<TIds>(blist, queryPts, N), Closest(closest)
+  {
+  }
+
+  void Initialize()
+  {
+    this->BatchFunctor<TIds>::Initialize();
+  }
+
+  void operator()(vtkIdType qId, vtkIdType endQId)
+  {
+    double x[3];
+    BatchScratch &scratch = this->Scratch.Local();
+    IdTuple *res = &scratch.Tuples[0];
+    vtkIdType *closest = this->Closest + qId*this->N;
+    int i, numFound;
+    for ( ; qId < endQId; ++qId )
+    {
+      this->QueryPts->GetPoint(qId, x);
+      numFound = this->BList->FindClosestNPoints(this->N, x, scratch.Buckets,
+                                                 res);
+      for ( i=0; i < numFound; ++i )
+      {
+        *closest++ = res[i].PtId;
+      }
+      for ( ; i < this->N; ++i )
+      {
+        *closest++ = -1;
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    this->BatchFunctor<TIds>::Reduce();
+  }
+};
+
+// Points within a radius of each query point, in two passes: the first pass
+// counts the points (Ids is NULL), the second one writes them at the offsets
+// obtained by a prefix sum of the counts.
+template <typename TIds>
+struct PointsWithinRadius
+{
+  BucketList<TIds> *BList;
+  double Radius;
+  vtkPoints *QueryPts;
+  vtkIdType *Offsets;
+  vtkIdType *Ids;
+
+  PointsWithinRadius(BucketList<TIds> *blist, double R, vtkPoints *queryPts,
+                     vtkIdType *offsets, vtkIdType *ids) :
+    BList(blist), Radius(R), QueryPts(queryPts), Offsets(offsets), Ids(ids)
+  {
+  }
+
+  void operator()(vtkIdType qId, vtkIdType endQId)
+  {
+    double x[3];
+    for ( ; qId < endQId; ++qId )
+    {
+      this->QueryPts->GetPoint(qId, x);
+      if ( this->Ids )
+      {
+        this->BList->FindPointsWithinRadius(this->Radius, x,
+                                            this->Ids + this->Offsets[qId]);
+      }
+      else
+      {
+        this->Offsets[qId] = this->BList->
+          FindPointsWithinRadius(this->Radius, x, static_cast<vtkIdType*>(NULL));
+      }
+    }
+  }
+};
+
+// Merging of the points with the same coordinates: such points are in the
+// same bucket, and are merged to the point of smallest id. Each thread
+// processes a range of buckets.
+template <typename TIds>
+struct MergeExact
+{
+  BucketList<TIds> *BList;
+  vtkIdType *MergeMap;
+
+  MergeExact(BucketList<TIds> *blist, vtkIdType *mergeMap) :
+    BList(blist), MergeMap(mergeMap)
+  {
+  }
+
+  void operator()(vtkIdType bucket, vtkIdType endBucket)
+  {
+    double p[3], q[3];
+    vtkDataSet *ds = this->BList->DataSet;
+    const LocatorTuple<TIds> *ids;
+    vtkIdType i, j, numIds, ptId, mergeId;
+    for ( ; bucket < endBucket; ++bucket )
+    {
+      ids = this->BList->GetIds(bucket);
+      numIds = this->BList->GetNumberOfIds(bucket);
+      for ( i=0; i < numIds; ++i )
+      {
+        mergeId = ptId = ids[i].PtId;
+        ds->GetPoint(ptId, p);
+        for ( j=0; j < numIds; ++j )
+        {
+          if ( ids[j].PtId < mergeId )
+          {
+            ds->GetPoint(ids[j].PtId, q);
+            if ( p[0] == q[0] && p[1] == q[1] && p[2] == q[2] )
+            {
+              mergeId = ids[j].PtId;
+            }
+          }
+        }
+        this->MergeMap[ptId] = mergeId;
+      }
+    }
+  }
+};
+
+// Merging of the points within a tolerance. The points within the tolerance
+// of a batch of points are gathered in two passes (as in PointsWithinRadius),
+// skipping the points already merged by a previous batch.
+template <typename TIds>
+struct MergeClose
+{
+  BucketList<TIds> *BList;
+  double Tol;
+  const vtkIdType *MergeMap;
+  vtkIdType Begin; //first point id of the batch
+  vtkIdType *Offsets;
+  vtkIdType *Ids;
+
+  MergeClose(BucketList<TIds> *blist, double tol, const vtkIdType *mergeMap,
+             vtkIdType begin, vtkIdType *offsets, vtkIdType *ids) :
+    BList(blist), Tol(tol), MergeMap(mergeMap), Begin(begin),
+    Offsets(offsets), Ids(ids)
+  {
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    double x[3];
+    vtkIdType *offset = this->Offsets + (ptId - this->Begin);
+    for ( ; ptId < endPtId; ++ptId, ++offset )
+    {
+      if ( this->MergeMap[ptId] >= 0 )
+      {
+        if ( !this->Ids )
+        {
+          *offset = 0;
+        }
+        continue;
+      }
+      this->BList->DataSet->GetPoint(ptId, x);
+      if ( this->Ids )
+      {
+        this->BList->FindPointsWithinRadius(this->Tol, x, this->Ids + *offset);
+      }
+      else
+      {
+        *offset = this->BList->
+          FindPointsWithinRadius(this->Tol, x, static_cast<vtkIdType*>(NULL));
+      }
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+template <typename TIds> void BucketList<TIds>::
+FindClosestPoints(vtkPoints *queryPts, vtkIdType *closest)
+{
+  ClosestPoints<TIds> query(this, queryPts, closest);
+  vtkSMPTools::For(0, queryPts->GetNumberOfPoints(), query);
+}
+
+//-----------------------------------------------------------------------------
+template <typename TIds> void BucketList<TIds>::
+FindClosestNPoints(int N, vtkPoints *queryPts, vtkIdType *closest)
+{
+  ClosestNPoints<TIds> query(this, N, queryPts, closest);
+  vtkSMPTools::For(0, queryPts->GetNumberOfPoints(), query);
+}
+
+//-----------------------------------------------------------------------------
+template <typename TIds> vtkIdType BucketList<TIds>::
+FindPointsWithinRadius(double R, vtkPoints *queryPts, vtkIdType *offsets,
+                       vtkIdTypeArray *ids)
+{
+  vtkIdType numQueryPts = queryPts->GetNumberOfPoints();
+  PointsWithinRadius<TIds> count(this, R, queryPts, offsets, NULL);
+  vtkSMPTools::For(0, numQueryPts, count);
+
+  vtkIdType numIds = vtkSMPTools::ExclusiveScan(
+    offsets, offsets + numQueryPts, offsets, static_cast<vtkIdType>(0));
+  offsets[numQueryPts] = numIds;
+
+  if ( ids )
+  {
+    ids->SetNumberOfComponents(1);
+    ids->SetNumberOfTuples(numIds);
+    PointsWithinRadius<TIds> fill(this, R, queryPts, offsets,
+                                  ids->GetPointer(0));
+    vtkSMPTools::For(0, numQueryPts, fill);
+  }
+
+  return numIds;
+}
+
+//-----------------------------------------------------------------------------
+// The merge within a tolerance is order dependent: the points are visited in
+// id order, and each point not merged yet merges the points around it. The
+// searches are threaded, by batches of points, and the merge map is then
+// updated serially so that the result does not depend on the threads.
+template <typename TIds> void BucketList<TIds>::
+MergePoints(double tol, vtkIdType *mergeMap)
+{
+  if ( tol <= 0.0 )
+  {
+    MergeExact<TIds> merge(this, mergeMap);
+    vtkSMPTools::For(0, this->NumBuckets, merge);
+    return;
+  }
+
+  std::fill_n(mergeMap, this->NumPts, -1);
+  const vtkIdType batchSize = 10 * this->BatchSize;
+  std::vector<vtkIdType> offsets(batchSize + 1), ids;
+  vtkIdType begin, end, numIds, ptId, i;
+  for ( begin=0; begin < this->NumPts; begin=end )
+  {
+    end = std::min(begin + batchSize, this->NumPts);
+    MergeClose<TIds> count(this, tol, mergeMap, begin, &offsets[0], NULL);
+    vtkSMPTools::For(begin, end, count);
+    numIds = vtkSMPTools::ExclusiveScan(
+      offsets.begin(), offsets.begin() + (end - begin), offsets.begin(),
+      static_cast<vtkIdType>(0));
+    offsets[end - begin] = numIds;
+    if ( numIds < 1 )
+    {
+      continue;
+    }
+    ids.resize(numIds);
+    MergeClose<TIds> fill(this, tol, mergeMap, begin, &offsets[0], &ids[0]);
+    vtkSMPTools::For(begin, end, fill);
+
+    for ( ptId=begin; ptId < end; ++ptId )
+    {
+      if ( mergeMap[ptId] >= 0 )
+      {
+        continue;
+      }
+      mergeMap[ptId] = ptId;
+      for ( i=offsets[ptId-begin]; i < offsets[ptId-begin+1]; ++i )
+      {
+        if ( mergeMap[ids[i]] < 0 )
+        {
+          mergeMap[ids[i]] = ptId;
+        }
+      }
+    }
+  }
+}
+
 //-----------------------------------------------------------------------------
 // Here is the VTK class proper. It's implemented with the templated
 // BucketList class.
@@ -1592,6 +2043,114 @@ FindPointsWithinRadius(double R, const double x[3], vtkIdList *result)
   }
 }
 
+//-----------------------------------------------------------------------------
+void vtkStaticPointLocator::
+FindClosestPoints(vtkPoints *queryPts, vtkIdTypeArray *closest)
+{
+  closest->SetNumberOfComponents(1);
+  closest->SetNumberOfTuples(queryPts->GetNumberOfPoints());
+
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Buckets )
+  {
+    closest->FillComponent(0, -1);
+    return;
+  }
+
+  if ( this->LargeIds )
+  {
+    static_cast<BucketList<vtkIdType>*>(this->Buckets)->
+      FindClosestPoints(queryPts, closest->GetPointer(0));
+  }
+  else
+  {
+    static_cast<BucketList<int>*>(this->Buckets)->
+      FindClosestPoints(queryPts, closest->GetPointer(0));
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticPointLocator::
+FindClosestNPoints(int N, vtkPoints *queryPts, vtkIdTypeArray *closest)
+{
+  N = (N < 1 ? 1 : N);
+  closest->SetNumberOfComponents(N);
+  closest->SetNumberOfTuples(queryPts->GetNumberOfPoints());
+
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Buckets )
+  {
+    std::fill_n(closest->GetPointer(0), closest->GetNumberOfValues(), -1);
+    return;
+  }
+
+  if ( this->LargeIds )
+  {
+    static_cast<BucketList<vtkIdType>*>(this->Buckets)->
+      FindClosestNPoints(N, queryPts, closest->GetPointer(0));
+  }
+  else
+  {
+    static_cast<BucketList<int>*>(this->Buckets)->
+      FindClosestNPoints(N, queryPts, closest->GetPointer(0));
+  }
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkStaticPointLocator::
+FindPointsWithinRadius(double R, vtkPoints *queryPts, vtkIdTypeArray *offsets,
+                       vtkIdTypeArray *ids)
+{
+  vtkIdType numQueryPts = queryPts->GetNumberOfPoints();
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfTuples(numQueryPts + 1);
+
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Buckets )
+  {
+    offsets->FillComponent(0, 0);
+    if ( ids )
+    {
+      ids->SetNumberOfComponents(1);
+      ids->SetNumberOfTuples(0);
+    }
+    return 0;
+  }
+
+  if ( this->LargeIds )
+  {
+    return static_cast<BucketList<vtkIdType>*>(this->Buckets)->
+      FindPointsWithinRadius(R, queryPts, offsets->GetPointer(0), ids);
+  }
+  else
+  {
+    return static_cast<BucketList<int>*>(this->Buckets)->
+      FindPointsWithinRadius(R, queryPts, offsets->GetPointer(0), ids);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticPointLocator::
+MergePoints(double tol, vtkIdType *mergeMap)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Buckets )
+  {
+    return;
+  }
+
+  if ( this->LargeIds )
+  {
+    static_cast<BucketList<vtkIdType>*>(this->Buckets)->
+      MergePoints(tol, mergeMap);
+  }
+  else
+  {
+    static_cast<BucketList<int>*>(this->Buckets)->
+      MergePoints(tol, mergeMap);
+  }
+}
+
 //-----------------------------------------------------------------------------
 void vtkStaticPointLocator::
 GenerateRepresentation(int level, vtkPolyData *pd)
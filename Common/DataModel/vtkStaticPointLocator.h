@@ -54,6 +54,8 @@
 #include "vtkAbstractPointLocator.h"
 
 class vtkIdList;
+class vtkIdTypeArray;
+class vtkPoints;
 class vtkBucketList;
 
 
@@ -144,6 +146,48 @@ public:
   void FindPointsWithinRadius(double R, const double x[3],
                               vtkIdList *result) VTK_OVERRIDE;
 
+  //@{
+  /**
+   * Batch versions of the queries above, which process all the points of
+   * queryPts in parallel (via vtkSMPTools) without allocating memory for
+   * each query. FindClosestPoints() returns in closest the id of the point
+   * closest to each query point (one component per tuple).
+   * FindClosestNPoints() returns the ids of the N closest points of each
+   * query point, sorted from closest to farthest, as a tuple of N components
+   * (padded with -1 if fewer than N points are located). These methods are
+   * thread safe if BuildLocator() is directly or indirectly called from a
+   * single thread first.
+   */
+  void FindClosestPoints(vtkPoints *queryPts, vtkIdTypeArray *closest);
+  void FindClosestNPoints(int N, vtkPoints *queryPts, vtkIdTypeArray *closest);
+  //@}
+
+  /**
+   * Batch version of FindPointsWithinRadius(). The ids of the points within
+   * radius R of the i-th query point are returned in ids, in the range
+   * [offsets[i], offsets[i+1]) (offsets has one more value than there are
+   * query points). If ids is NULL, only the offsets are computed, which
+   * counts the points within the radius of each query point. The total number
+   * of ids is returned. The query runs in two passes over the query points,
+   * one to count the points and one to gather their ids.
+   */
+  vtkIdType FindPointsWithinRadius(double R, vtkPoints *queryPts,
+                                   vtkIdTypeArray *offsets,
+                                   vtkIdTypeArray *ids);
+
+  /**
+   * Merge the coincident points of the dataset. mergeMap, allocated by the
+   * caller with one value per point of the dataset, returns for each point
+   * the id of the point it is merged to (its own id if it is not merged).
+   * If tol is 0.0, the points with exactly the same coordinates are merged
+   * to the one of smallest id. Otherwise, the points are visited in
+   * increasing id order, and each point not merged yet is kept and merges
+   * all the points within the distance tol of it which are not merged yet.
+   * The points are merged in parallel (via vtkSMPTools), and the result does
+   * not depend on the number of threads. This method is not thread safe.
+   */
+  void MergePoints(double tol, vtkIdType *mergeMap);
+
   //@{
   /**
    * See vtkLocator and vtkAbstractPointLocator interface documentation.
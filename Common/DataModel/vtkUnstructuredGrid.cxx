@@ -491,7 +491,7 @@ vtkCell *vtkUnstructuredGrid::GetCell(vtkIdType cellId)
 
   loc = this->Locations->GetValue(cellId);
   vtkDebugMacro(<< "location = " <<  loc);
-  this->Connectivity->GetCell(loc,numPts,pts);
+  this->GetCellPoints(cellId, numPts, pts);
 
   int cellType = static_cast<int>(this->Types->GetValue(cellId));
   switch (cellType)
@@ -803,18 +803,10 @@ vtkCell *vtkUnstructuredGrid::GetCell(vtkIdType cellId)
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
 {
-  vtkIdType loc;
-  vtkIdType *pts, numPts;
-
   int cellType = static_cast<int>(this->Types->GetValue(cellId));
   cell->SetCellType(cellType);
 
-  loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
-
-  cell->PointIds->SetNumberOfIds(numPts);
-
-  std::copy(pts, pts + numPts, cell->PointIds->GetPointer(0));
+  this->GetCellPoints(cellId, cell->PointIds);
   this->Points->GetPoints(cell->PointIds, cell->Points);
 
   // Explicit face representation
@@ -837,12 +829,10 @@ void vtkUnstructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
 void vtkUnstructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6])
 {
   vtkIdType i;
-  vtkIdType loc;
   double x[3];
   vtkIdType *pts, numPts;
 
-  loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
+  this->GetCellPoints(cellId, numPts, pts);
 
   // carefully compute the bounds
   if (numPts)
@@ -1121,10 +1111,22 @@ void vtkUnstructuredGrid::SetCells(int *types, vtkCellArray *cells)
   if (!containPolyhedron)
   {
     // only need to build types and locations
-    for (i=0, cells->InitTraversal(); cells->GetNextCell(npts,pts); i++)
+    if (cells->IsStorageSplit())
     {
-      cellTypes->InsertNextValue(static_cast<unsigned char>(types[i]));
-      cellLocations->InsertNextValue(cells->GetTraversalLocation(npts));
+      // Keep the split storage: the locations are computed from the offsets.
+      for (i=0; i < ncells; i++)
+      {
+        cellTypes->InsertNextValue(static_cast<unsigned char>(types[i]));
+        cellLocations->InsertNextValue(cells->GetLegacyLocation(i));
+      }
+    }
+    else
+    {
+      for (i=0, cells->InitTraversal(); cells->GetNextCell(npts,pts); i++)
+      {
+        cellTypes->InsertNextValue(static_cast<unsigned char>(types[i]));
+        cellLocations->InsertNextValue(cells->GetTraversalLocation(npts));
+      }
     }
 
     this->SetCells(cellTypes, cellLocations, cells, NULL, NULL);
@@ -1309,12 +1311,29 @@ void vtkUnstructuredGrid::BuildLinks()
   this->Links->Delete();
 }
 
+//----------------------------------------------------------------------------
+void vtkUnstructuredGrid::PrepareFindCellWithContext()
+{
+  if ( !this->Links && this->Connectivity )
+  {
+    this->BuildLinks();
+  }
+  this->Superclass::PrepareFindCellWithContext();
+}
+
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
 {
   vtkIdType i, loc;
   vtkIdType *pts, numPts;
 
+  // Split storage is read in place by cell id.
+  if (this->Connectivity->IsStorageSplit())
+  {
+    this->Connectivity->GetCellAtId(cellId, ptIds);
+    return;
+  }
+
   loc = this->Locations->GetValue(cellId);
   this->Connectivity->GetCell(loc,numPts,pts);
   ptIds->SetNumberOfIds(numPts);
@@ -1333,11 +1352,41 @@ void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
 {
   vtkIdType loc;
 
+  // 32-bit ids cannot be returned in place: use vtkIdType ids instead.
+  if (this->Connectivity->IsStorage32Bit())
+  {
+    this->Connectivity->UseSplitStorage(false);
+  }
+  if (this->Connectivity->IsStorageSplit())
+  {
+    const vtkIdType *cellPts;
+    this->Connectivity->GetCellAtId(cellId, npts, cellPts, NULL);
+    pts = const_cast<vtkIdType*>(cellPts);
+    return;
+  }
+
   loc = this->Locations->GetValue(cellId);
 
   this->Connectivity->GetCell(loc,npts,pts);
 }
 
+//----------------------------------------------------------------------------
+void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                                        const vtkIdType* &pts,
+                                        vtkIdList *ptIds)
+{
+  if (this->Connectivity->IsStorageSplit())
+  {
+    this->Connectivity->GetCellAtId(cellId, npts, pts, ptIds);
+    return;
+  }
+
+  vtkIdType *cellPts;
+  this->Connectivity->GetCell(this->Locations->GetValue(cellId), npts,
+                              cellPts);
+  pts = cellPts;
+}
+
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::GetFaceStream(vtkIdType cellId, vtkIdList *ptIds)
 {
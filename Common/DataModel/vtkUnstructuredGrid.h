@@ -151,9 +151,31 @@ public:
   int GetMaxCellSize() VTK_OVERRIDE;
   void BuildLinks();
   vtkCellLinks *GetCellLinks() {return this->Links;};
+
+  /**
+   * Build the cell links used to walk through neighboring cells, then the
+   * point locator. See vtkDataSet::FindCellWithContext().
+   */
+  void PrepareFindCellWithContext() VTK_OVERRIDE;
+
+  /**
+   * Get a pointer to the point ids of the cell. If the connectivity uses
+   * 32-bit split storage, it is first converted to vtkIdType split storage,
+   * so the first call is not thread safe for such grids.
+   */
   virtual void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
                              vtkIdType* &pts);
 
+  /**
+   * Get the point ids of the cell without modifying the connectivity. pts
+   * points to the cell array internals when possible; otherwise, as with
+   * 32-bit split storage, the ids are copied into ptIds and pts points into
+   * it. This method is thread safe as long as the grid is not modified
+   * concurrently.
+   */
+  void GetCellPoints(vtkIdType cellId, vtkIdType& npts, const vtkIdType* &pts,
+                     vtkIdList *ptIds);
+
   /**
    * Get the face stream of a polyhedron cell in the following format:
    * (numCellFaces, numFace0Pts, id1, id2, id3, numFace1Pts,id1, id2, id3, ...).
@@ -0,0 +1,50 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPAlgorithmProgress.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMPAlgorithmProgress.h"
+
+#include "vtkAlgorithm.h"
+
+//----------------------------------------------------------------------------
+vtkSMPAlgorithmProgress::vtkSMPAlgorithmProgress(vtkAlgorithm *algorithm,
+                                                 vtkIdType numberOfItems,
+                                                 double start, double end)
+  : Algorithm(algorithm), NumberOfItems(numberOfItems), Start(start),
+    End(end), NextReport(0), Processed(0), Aborted(0)
+{
+  this->ReportInterval = numberOfItems / 100 + 1;
+  this->ReportingThread = vtkMultiThreader::GetCurrentThreadID();
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMPAlgorithmProgress::Advance(vtkIdType count)
+{
+  vtkIdType processed = (this->Processed += count);
+  if (processed >= this->NextReport &&
+      vtkMultiThreader::ThreadsEqual(vtkMultiThreader::GetCurrentThreadID(),
+                                     this->ReportingThread))
+  {
+    // Only the reporting thread reads and writes NextReport.
+    this->NextReport = processed + this->ReportInterval;
+    double fraction = this->NumberOfItems > 0 ?
+      static_cast<double>(processed) / this->NumberOfItems : 1.0;
+    this->Algorithm->UpdateProgress(
+      this->Start + (this->End - this->Start) * fraction);
+    if (this->Algorithm->GetAbortExecute())
+    {
+      this->Aborted = 1;
+    }
+  }
+  return !this->IsAborted();
+}
@@ -0,0 +1,82 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPAlgorithmProgress.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSMPAlgorithmProgress
+ * @brief   progress and abort of an algorithm running vtkSMPTools::For()
+ *
+ * vtkSMPAlgorithmProgress counts the items processed by the functor of a
+ * vtkSMPTools::For() with an atomic counter. The progress of the algorithm
+ * is only updated, and its AbortExecute flag only checked, from the thread
+ * that created this object, which takes part in the For() with the
+ * threaded backends, so that the progress observers are not invoked
+ * concurrently. An abort is then seen by all the threads through
+ * IsAborted(), and the functor skips the remaining items.
+ *
+ * @sa
+ * vtkImageProgressIterator vtkSMPProgressObserver
+*/
+
+#ifndef vtkSMPAlgorithmProgress_h
+#define vtkSMPAlgorithmProgress_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkAtomic.h" // For the counters
+#include "vtkMultiThreader.h" // For vtkMultiThreaderIDType
+
+class vtkAlgorithm;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkSMPAlgorithmProgress
+{
+public:
+  /**
+   * Report the progress of algorithm over numberOfItems items, as the
+   * fraction [start, end] of its whole execution. The progress is reported
+   * about every percent of the items.
+   */
+  vtkSMPAlgorithmProgress(vtkAlgorithm *algorithm, vtkIdType numberOfItems,
+                          double start = 0.0, double end = 1.0);
+
+  /**
+   * Count count more items as processed. Returns false once the execution
+   * of the algorithm is aborted.
+   */
+  bool Advance(vtkIdType count = 1);
+
+  /**
+   * Whether the execution of the algorithm was aborted while the items
+   * were processed.
+   */
+  bool IsAborted() const
+  {
+    return this->Aborted.load() != 0;
+  }
+
+private:
+  vtkAlgorithm *Algorithm;
+  vtkIdType NumberOfItems;
+  vtkIdType ReportInterval;
+  double Start;
+  double End;
+  vtkMultiThreaderIDType ReportingThread;
+  vtkIdType NextReport;
+  vtkAtomic<vtkIdType> Processed;
+  vtkAtomic<int> Aborted;
+
+  vtkSMPAlgorithmProgress(const vtkSMPAlgorithmProgress&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkSMPAlgorithmProgress&) VTK_DELETE_FUNCTION;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPAlgorithmProgress.h
@@ -0,0 +1,281 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAttributeDataAveraging.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the (threaded) averaging of vtkCellDataToPointData and
+// vtkPointDataToCellData against a direct computation, for several arrays
+// and several types of datasets.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellDataToPointData.h"
+#include "vtkCellType.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointDataToCellData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+
+const int Res = 12;
+
+// A 3-component float array and an int array, whose values depend on the
+// tuple index, and a string array.
+void AddArrays(vtkDataSetAttributes *dsa, vtkIdType numTuples)
+{
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numTuples);
+  vtkNew<vtkIntArray> labels;
+  labels->SetName("Labels");
+  labels->SetNumberOfTuples(numTuples);
+  vtkNew<vtkStringArray> names;
+  names->SetName("Names");
+  names->SetNumberOfValues(numTuples);
+  for (vtkIdType i = 0; i < numTuples; ++i)
+  {
+    vectors->SetTuple3(i, sin(0.1 * i), cos(0.3 * i), 0.01 * i);
+    labels->SetValue(i, static_cast<int>((7 * i) % 23));
+    names->SetValue(i, "name");
+  }
+  dsa->AddArray(vectors.Get());
+  dsa->AddArray(labels.Get());
+  dsa->AddArray(names.Get());
+}
+
+// Compare the output tuple outId of the arrays with the mean of the input
+// tuples ids. If typed, the sum and division are carried out in the value
+// type of the arrays, otherwise in double precision and rounded.
+bool CheckMean(vtkDataSetAttributes *in, vtkDataSetAttributes *out,
+               vtkIdList *ids, vtkIdType outId, bool typed)
+{
+  vtkIdType n = ids->GetNumberOfIds();
+  vtkFloatArray *inVectors =
+    vtkFloatArray::SafeDownCast(in->GetArray("Vectors"));
+  vtkFloatArray *outVectors =
+    vtkFloatArray::SafeDownCast(out->GetArray("Vectors"));
+  vtkIntArray *inLabels = vtkIntArray::SafeDownCast(in->GetArray("Labels"));
+  vtkIntArray *outLabels = vtkIntArray::SafeDownCast(out->GetArray("Labels"));
+  if (!outVectors || !outLabels)
+  {
+    cerr << "Missing output arrays." << endl;
+    return false;
+  }
+
+  for (int c = 0; c < 3; ++c)
+  {
+    float sum = 0.0f;
+    double mean = 0.0;
+    for (vtkIdType i = 0; i < n; ++i)
+    {
+      sum += inVectors->GetTypedComponent(ids->GetId(i), c);
+      mean += (1.0 / n) * inVectors->GetTypedComponent(ids->GetId(i), c);
+    }
+    float expected = typed ? (n ? sum / n : 0.0f) : static_cast<float>(mean);
+    if (outVectors->GetTypedComponent(outId, c) != expected)
+    {
+      cerr << "Tuple " << outId << ": vector component " << c << " is "
+           << outVectors->GetTypedComponent(outId, c) << " expected "
+           << expected << endl;
+      return false;
+    }
+  }
+
+  int sum = 0;
+  double mean = 0.0;
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    sum += inLabels->GetValue(ids->GetId(i));
+    mean += (1.0 / n) * inLabels->GetValue(ids->GetId(i));
+  }
+  int expected = typed ? (n ? sum / static_cast<int>(n) : 0) :
+    static_cast<int>(vtkMath::Round(mean));
+  if (outLabels->GetValue(outId) != expected)
+  {
+    cerr << "Tuple " << outId << ": label is " << outLabels->GetValue(outId)
+         << " expected " << expected << endl;
+    return false;
+  }
+  return true;
+}
+
+int TestCellDataToPointData(vtkDataSet *input, bool typed)
+{
+  vtkNew<vtkCellDataToPointData> c2p;
+  c2p->SetInputData(input);
+  c2p->Update();
+  vtkDataSet *output = c2p->GetOutput();
+  vtkPointData *outPD = output->GetPointData();
+  if (output->GetNumberOfPoints() != input->GetNumberOfPoints())
+  {
+    cerr << "Unexpected number of points." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkIdList> cellIds;
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    input->GetPointCells(ptId, cellIds.GetPointer());
+    if (!CheckMean(input->GetCellData(), outPD, cellIds.GetPointer(), ptId,
+                   typed))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The string array is interpolated, except for unstructured grids.
+  vtkAbstractArray *names = outPD->GetAbstractArray("Names");
+  if (!typed && (!names || names->GetNumberOfTuples() !=
+                 input->GetNumberOfPoints()))
+  {
+    cerr << "Missing the string array." << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int TestPointDataToCellData(vtkDataSet *input)
+{
+  vtkNew<vtkPointDataToCellData> p2c;
+  p2c->SetInputData(input);
+  p2c->Update();
+  vtkDataSet *output = p2c->GetOutput();
+
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    input->GetCellPoints(cellId, ptIds.GetPointer());
+    if (!CheckMean(input->GetPointData(), output->GetCellData(),
+                   ptIds.GetPointer(), cellId, false))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  vtkAbstractArray *names = output->GetCellData()->GetAbstractArray("Names");
+  if (!names || names->GetNumberOfTuples() != input->GetNumberOfCells())
+  {
+    cerr << "Missing the string array." << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+}
+
+int TestAttributeDataAveraging(int, char *[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Res + 1, Res + 1, Res / 2 + 1);
+  AddArrays(image->GetCellData(), image->GetNumberOfCells());
+  AddArrays(image->GetPointData(), image->GetNumberOfPoints());
+  if (TestCellDataToPointData(image.Get(), false) != EXIT_SUCCESS ||
+      TestPointDataToCellData(image.Get()) != EXIT_SUCCESS)
+  {
+    cerr << "Failure with the image." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Hexahedra and tetrahedra, and an unused point.
+  vtkNew<vtkUnstructuredGrid> ugrid;
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= Res; ++k)
+  {
+    for (int j = 0; j <= Res; ++j)
+    {
+      for (int i = 0; i <= Res; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  points->InsertNextPoint(-1.0, -1.0, -1.0);
+  ugrid->SetPoints(points.Get());
+  ugrid->Allocate(2 * Res * Res * Res);
+  const vtkIdType n = Res + 1;
+  for (int k = 0; k < Res; ++k)
+  {
+    for (int j = 0; j < Res; ++j)
+    {
+      for (int i = 0; i < Res; ++i)
+      {
+        vtkIdType p = i + j * n + k * n * n;
+        vtkIdType hex[8] = { p, p + 1, p + 1 + n, p + n, p + n * n,
+                             p + 1 + n * n, p + 1 + n + n * n, p + n + n * n };
+        if ((i + j + k) % 3)
+        {
+          ugrid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+        }
+        else
+        {
+          vtkIdType tet[4] = { hex[0], hex[1], hex[3], hex[4] };
+          ugrid->InsertNextCell(VTK_TETRA, 4, tet);
+        }
+      }
+    }
+  }
+  AddArrays(ugrid->GetCellData(), ugrid->GetNumberOfCells());
+  AddArrays(ugrid->GetPointData(), ugrid->GetNumberOfPoints());
+  if (TestCellDataToPointData(ugrid.Get(), true) != EXIT_SUCCESS ||
+      TestPointDataToCellData(ugrid.Get()) != EXIT_SUCCESS)
+  {
+    cerr << "Failure with the unstructured grid." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // The surface of the image as triangles, and an unused point.
+  vtkNew<vtkPolyData> surface;
+  vtkNew<vtkPoints> surfacePoints;
+  vtkNew<vtkCellArray> triangles;
+  for (vtkIdType i = 0; i < n * n; ++i)
+  {
+    surfacePoints->InsertNextPoint(points->GetPoint(i));
+  }
+  surfacePoints->InsertNextPoint(-1.0, -1.0, 0.0);
+  for (int j = 0; j < Res; ++j)
+  {
+    for (int i = 0; i < Res; ++i)
+    {
+      vtkIdType p = i + j * n;
+      vtkIdType tri0[3] = { p, p + 1, p + 1 + n };
+      vtkIdType tri1[3] = { p, p + 1 + n, p + n };
+      triangles->InsertNextCell(3, tri0);
+      triangles->InsertNextCell(3, tri1);
+    }
+  }
+  surface->SetPoints(surfacePoints.Get());
+  surface->SetPolys(triangles.Get());
+  AddArrays(surface->GetCellData(), surface->GetNumberOfCells());
+  AddArrays(surface->GetPointData(), surface->GetNumberOfPoints());
+  if (TestCellDataToPointData(surface.Get(), false) != EXIT_SUCCESS ||
+      TestPointDataToCellData(surface.Get()) != EXIT_SUCCESS)
+  {
+    cerr << "Failure with the surface." << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,275 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConnectivityFilterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the parallel labeling of vtkConnectivityFilter and
+// vtkPolyDataConnectivityFilter extracts the same regions as the serial
+// wave propagation, in every extraction mode and with scalar connectivity.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkConnectivityFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataConnectivityFilter.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "TestDataComparison.h"
+
+#include <cmath>
+
+namespace
+{
+
+const int Res = 16;
+
+double Scalar(int i, int j, int k)
+{
+  return sin(0.5 * i) * cos(0.4 * j) + 0.2 * k;
+}
+
+// Hexahedra and tetrahedra in slabs separated by gaps, so that there are
+// several regions, and a few isolated vertices.
+void MakeGrid(vtkUnstructuredGrid *grid)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (int k = 0; k <= 3; ++k)
+  {
+    for (int j = 0; j <= Res; ++j)
+    {
+      for (int i = 0; i <= Res; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+        scalars->InsertNextValue(Scalar(i, j, k));
+      }
+    }
+  }
+  grid->SetPoints(points.Get());
+  grid->GetPointData()->SetScalars(scalars.Get());
+
+  grid->Allocate(Res * Res * 3);
+  const vtkIdType n = Res + 1;
+  for (int k = 0; k < 3; ++k)
+  {
+    for (int j = 0; j < Res; ++j)
+    {
+      for (int i = 0; i < Res; ++i)
+      {
+        if (i % 6 == 5 || (j % 7 == 6 && i > 8))
+        {
+          continue;
+        }
+        vtkIdType p = i + j * n + k * n * n;
+        vtkIdType hex[8] = { p, p + 1, p + 1 + n, p + n, p + n * n,
+                             p + 1 + n * n, p + 1 + n + n * n, p + n + n * n };
+        if ((i + j + k) % 4)
+        {
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+        }
+        else
+        {
+          vtkIdType tet[4] = { hex[0], hex[1], hex[3], hex[4] };
+          grid->InsertNextCell(VTK_TETRA, 4, tet);
+        }
+      }
+    }
+  }
+  for (vtkIdType p = 5; p < n * n; p += 37)
+  {
+    grid->InsertNextCell(VTK_VERTEX, 1, &p);
+  }
+}
+
+// Triangles of a height field with holes and gaps, lines and vertices.
+void MakeSurface(vtkPolyData *surface)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (int j = 0; j <= Res; ++j)
+  {
+    for (int i = 0; i <= Res; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.1 * i * j);
+      scalars->InsertNextValue(Scalar(i, j, 0));
+    }
+  }
+
+  const vtkIdType n = Res + 1;
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < Res; ++j)
+  {
+    for (int i = 0; i < Res; ++i)
+    {
+      if (i % 5 == 4 || j % 6 == 5 || (i * 3 + j * 7) % 11 == 0)
+      {
+        continue;
+      }
+      vtkIdType p = i + j * n;
+      vtkIdType tri0[3] = { p, p + 1, p + 1 + n };
+      vtkIdType tri1[3] = { p, p + 1 + n, p + n };
+      polys->InsertNextCell(3, tri0);
+      polys->InsertNextCell(3, tri1);
+    }
+  }
+  vtkNew<vtkCellArray> lines;
+  for (vtkIdType p = 4; p < n * n - 1; p += 23)
+  {
+    vtkIdType line[2] = { p, p + 1 };
+    lines->InsertNextCell(2, line);
+  }
+  vtkNew<vtkCellArray> verts;
+  for (vtkIdType p = 9; p < n * n; p += 31)
+  {
+    verts->InsertNextCell(1, &p);
+  }
+
+  surface->SetPoints(points.Get());
+  surface->SetVerts(verts.Get());
+  surface->SetLines(lines.Get());
+  surface->SetPolys(polys.Get());
+  surface->GetPointData()->SetScalars(scalars.Get());
+}
+
+template <class FilterT>
+void Configure(FilterT *filter, vtkDataSet *input, int mode, int scalar,
+               int parallel)
+{
+  filter->SetInputData(input);
+  filter->SetExtractionMode(mode);
+  filter->SetScalarConnectivity(scalar != 0);
+  filter->SetScalarRange(0.1, 0.6);
+  filter->ColorRegionsOn();
+  filter->AddSeed(40);
+  filter->AddSeed(130);
+  filter->AddSpecifiedRegion(1);
+  filter->AddSpecifiedRegion(3);
+  filter->SetClosestPoint(Res, Res, 0.0);
+  filter->SetParallelLabeling(parallel);
+}
+
+int CompareGrid(vtkUnstructuredGrid *grid, int mode, int scalar)
+{
+  vtkNew<vtkConnectivityFilter> serial;
+  vtkNew<vtkConnectivityFilter> parallel;
+  Configure(serial.Get(), grid, mode, scalar, 0);
+  Configure(parallel.Get(), grid, mode, scalar, 1);
+  serial->Update();
+  parallel->Update();
+
+  vtkDataSet *expected = serial->GetOutput();
+  vtkDataSet *output = parallel->GetOutput();
+  if (expected->GetNumberOfCells() == 0 ||
+      (mode == VTK_EXTRACT_ALL_REGIONS && serial->GetNumberOfExtractedRegions() < 3))
+  {
+    cerr << "Unexpected serial output." << endl;
+    return EXIT_FAILURE;
+  }
+  // The cell region ids are only defined for the visited cells.
+  if (mode != VTK_EXTRACT_ALL_REGIONS)
+  {
+    expected->GetCellData()->RemoveArray("RegionId");
+    output->GetCellData()->RemoveArray("RegionId");
+  }
+  if (serial->GetNumberOfExtractedRegions() !=
+      parallel->GetNumberOfExtractedRegions() ||
+      !vtkTest::SameCellsByPoints(expected, output, "grid"))
+  {
+    cerr << "Different grid outputs in mode "
+         << serial->GetExtractionModeAsString() << ", scalar connectivity "
+         << scalar << ": " << output->GetNumberOfCells() << " cells in "
+         << parallel->GetNumberOfExtractedRegions() << " regions, expected "
+         << expected->GetNumberOfCells() << " in "
+         << serial->GetNumberOfExtractedRegions() << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int CompareSurface(vtkPolyData *surface, int mode, int scalar)
+{
+  vtkNew<vtkPolyDataConnectivityFilter> serial;
+  vtkNew<vtkPolyDataConnectivityFilter> parallel;
+  Configure(serial.Get(), surface, mode, scalar, 0);
+  Configure(parallel.Get(), surface, mode, scalar, 1);
+  serial->SetFullScalarConnectivity(scalar == 2);
+  parallel->SetFullScalarConnectivity(scalar == 2);
+  serial->Update();
+  parallel->Update();
+
+  vtkPolyData *expected = serial->GetOutput();
+  vtkPolyData *output = parallel->GetOutput();
+  if (expected->GetNumberOfCells() == 0 ||
+      (mode == VTK_EXTRACT_ALL_REGIONS && serial->GetNumberOfExtractedRegions() < 3))
+  {
+    cerr << "Unexpected serial output." << endl;
+    return EXIT_FAILURE;
+  }
+  if (mode != VTK_EXTRACT_ALL_REGIONS)
+  {
+    expected->GetCellData()->RemoveArray("RegionId");
+    output->GetCellData()->RemoveArray("RegionId");
+  }
+  if (!vtkTest::SameArrays(serial->GetRegionSizes(),
+                           parallel->GetRegionSizes(), "region sizes") ||
+      !vtkTest::SameCellsByPoints(expected, output, "surface"))
+  {
+    cerr << "Different surface outputs in mode "
+         << serial->GetExtractionModeAsString() << ", scalar connectivity "
+         << scalar << ": " << output->GetNumberOfCells() << " cells in "
+         << parallel->GetNumberOfExtractedRegions() << " regions, expected "
+         << expected->GetNumberOfCells() << " in "
+         << serial->GetNumberOfExtractedRegions() << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int TestConnectivityFilterParallel(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid.Get());
+  vtkNew<vtkPolyData> surface;
+  MakeSurface(surface.Get());
+
+  const int modes[6] = {
+    VTK_EXTRACT_POINT_SEEDED_REGIONS, VTK_EXTRACT_CELL_SEEDED_REGIONS,
+    VTK_EXTRACT_SPECIFIED_REGIONS, VTK_EXTRACT_LARGEST_REGION,
+    VTK_EXTRACT_ALL_REGIONS, VTK_EXTRACT_CLOSEST_POINT_REGION };
+  for (int m = 0; m < 6; ++m)
+  {
+    for (int scalar = 0; scalar < 3; ++scalar)
+    {
+      if ((scalar < 2 &&
+           CompareGrid(grid.Get(), modes[m], scalar) != EXIT_SUCCESS) ||
+          CompareSurface(surface.Get(), modes[m], scalar) != EXIT_SUCCESS)
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
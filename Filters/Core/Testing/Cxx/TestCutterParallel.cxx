@@ -0,0 +1,181 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCutterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the parallel cutting of unstructured grids by vtkCutter gives
+// the same output as the serial cutting.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCutter.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSphere.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "TestDataComparison.h"
+
+#include <cmath>
+
+namespace
+{
+
+const int Res = 14;
+
+// Hexahedra and tetrahedra, with quads on the z = 0 face and lines along
+// the x = 0, y = 0 edge, in this order of the cell ids.
+void MakeGrid(vtkUnstructuredGrid *grid)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkStringArray> names;
+  names->SetName("Names");
+  for (int k = 0; k <= Res; ++k)
+  {
+    for (int j = 0; j <= Res; ++j)
+    {
+      for (int i = 0; i <= Res; ++i)
+      {
+        points->InsertNextPoint(i + 0.1 * sin(0.7 * j), j, k);
+        vectors->InsertNextTuple3(sin(0.3 * i), cos(0.2 * j), 0.1 * k);
+        names->InsertNextValue(i % 2 ? "odd" : "even");
+      }
+    }
+  }
+  grid->SetPoints(points.Get());
+  grid->GetPointData()->AddArray(vectors.Get());
+  grid->GetPointData()->AddArray(names.Get());
+
+  vtkNew<vtkIntArray> labels;
+  labels->SetName("Labels");
+  grid->Allocate(2 * Res * Res * Res);
+  const vtkIdType n = Res + 1;
+  for (int k = 0; k < Res; ++k)
+  {
+    for (int j = 0; j < Res; ++j)
+    {
+      for (int i = 0; i < Res; ++i)
+      {
+        vtkIdType p = i + j * n + k * n * n;
+        vtkIdType hex[8] = { p, p + 1, p + 1 + n, p + n, p + n * n,
+                             p + 1 + n * n, p + 1 + n + n * n, p + n + n * n };
+        if ((i + j + k) % 3)
+        {
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+        }
+        else
+        {
+          vtkIdType tet[4] = { hex[0], hex[1], hex[3], hex[4] };
+          grid->InsertNextCell(VTK_TETRA, 4, tet);
+        }
+        labels->InsertNextValue(i + 2 * j + 3 * k);
+      }
+    }
+  }
+  for (int j = 0; j < Res; ++j)
+  {
+    for (int i = 0; i < Res; ++i)
+    {
+      vtkIdType p = i + j * n;
+      vtkIdType quad[4] = { p, p + 1, p + 1 + n, p + n };
+      grid->InsertNextCell(VTK_QUAD, 4, quad);
+      labels->InsertNextValue(-i - j);
+    }
+  }
+  for (int k = 0; k < Res; ++k)
+  {
+    vtkIdType line[2] = { k * n * n, (k + 1) * n * n };
+    grid->InsertNextCell(VTK_LINE, 2, line);
+    labels->InsertNextValue(-100 - k);
+  }
+  grid->GetCellData()->AddArray(labels.Get());
+}
+
+int Compare(vtkUnstructuredGrid *grid, vtkImplicitFunction *function,
+            int generateCutScalars)
+{
+  vtkNew<vtkCutter> serial;
+  vtkNew<vtkCutter> parallel;
+  vtkCutter *cutters[2] = { serial.Get(), parallel.Get() };
+  for (int c = 0; c < 2; ++c)
+  {
+    cutters[c]->SetInputData(grid);
+    cutters[c]->SetCutFunction(function);
+    cutters[c]->SetValue(0, 4.0);
+    cutters[c]->SetValue(1, 12.0);
+    cutters[c]->SetValue(2, 30.0);
+    cutters[c]->SetGenerateCutScalars(generateCutScalars);
+    cutters[c]->SetParallelCutting(c);
+    cutters[c]->Update();
+  }
+
+  vtkPolyData *expected = serial->GetOutput();
+  vtkPolyData *output = parallel->GetOutput();
+  if (expected->GetNumberOfPolys() == 0 || expected->GetNumberOfLines() == 0 ||
+      expected->GetNumberOfVerts() == 0)
+  {
+    cerr << "Unexpected serial output." << endl;
+    return EXIT_FAILURE;
+  }
+  if (!vtkTest::SamePolyData(expected, output, "the cut"))
+  {
+    cerr << "Different outputs with a " << function->GetClassName()
+         << ", cut scalars " << generateCutScalars << ": "
+         << output->GetNumberOfPoints()
+         << " points, " << output->GetNumberOfCells() << " cells, expected "
+         << expected->GetNumberOfPoints() << " and "
+         << expected->GetNumberOfCells() << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int TestCutterParallel(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid.Get());
+
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(0.0, 0.0, 0.0);
+  sphere->SetRadius(0.0);
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(0.3, 0.2, 0.1);
+  plane->SetNormal(1.0, 1.0, 1.0);
+
+  vtkImplicitFunction *functions[2] = { sphere.Get(), plane.Get() };
+  for (int f = 0; f < 2; ++f)
+  {
+    for (int i = 0; i < 2; ++i)
+    {
+      if (Compare(grid.Get(), functions[f], i) != EXIT_SUCCESS)
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
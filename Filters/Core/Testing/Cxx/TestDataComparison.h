@@ -0,0 +1,308 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataComparison.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * Functions comparing the output of a filter with an expected output, used
+ * by the tests checking that the parallel path of a filter produces the
+ * same data as the serial one. Each function prints the first difference it
+ * finds to cerr, naming the compared data with the given "what" string, and
+ * returns false. Numeric values may differ by the given tolerance.
+*/
+
+#ifndef TestDataComparison_h
+#define TestDataComparison_h
+
+#include "vtkAbstractArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkVariant.h"
+
+#include <cmath> // Needed for fabs
+
+namespace vtkTest
+{
+
+inline bool SameValues(double expected, double output, double tolerance)
+{
+  return expected == output || fabs(expected - output) <= tolerance;
+}
+
+/**
+ * Compare the value id of two arrays of the same kind.
+ */
+inline bool SameValues(vtkAbstractArray *expected, vtkIdType id0,
+                       vtkAbstractArray *output, vtkIdType id1,
+                       double tolerance)
+{
+  vtkDataArray *data0 = vtkArrayDownCast<vtkDataArray>(expected);
+  vtkDataArray *data1 = vtkArrayDownCast<vtkDataArray>(output);
+  if (data0 && data1)
+  {
+    int numComps = data0->GetNumberOfComponents();
+    return SameValues(data0->GetComponent(id0 / numComps, id0 % numComps),
+                      data1->GetComponent(id1 / numComps, id1 % numComps),
+                      tolerance);
+  }
+  return expected->GetVariantValue(id0) == output->GetVariantValue(id1);
+}
+
+/**
+ * Compare two arrays, which may both be NULL. They must have the same data
+ * type, number of tuples and number of components.
+ */
+inline bool SameArrays(vtkAbstractArray *expected, vtkAbstractArray *output,
+                       const char *what, double tolerance = 0.0)
+{
+  if (!expected || !output)
+  {
+    if (expected != output)
+    {
+      cerr << "Missing " << what << " array." << endl;
+      return false;
+    }
+    return true;
+  }
+  if (expected->GetDataType() != output->GetDataType() ||
+      expected->GetNumberOfTuples() != output->GetNumberOfTuples() ||
+      expected->GetNumberOfComponents() != output->GetNumberOfComponents())
+  {
+    cerr << "Wrong " << what << " array "
+         << (expected->GetName() ? expected->GetName() : "") << ": "
+         << output->GetNumberOfTuples() << " tuples of "
+         << output->GetNumberOfComponents() << " "
+         << output->GetDataTypeAsString() << " instead of "
+         << expected->GetNumberOfTuples() << " tuples of "
+         << expected->GetNumberOfComponents() << " "
+         << expected->GetDataTypeAsString() << endl;
+    return false;
+  }
+  vtkIdType numValues =
+    expected->GetNumberOfTuples() * expected->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    if (!SameValues(expected, i, output, i, tolerance))
+    {
+      cerr << "Value " << i << " of " << what << " array "
+           << (expected->GetName() ? expected->GetName() : "")
+           << " differs." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Compare the arrays of two field data, matched by name or by index when
+ * they have no name. For point and cell data, the arrays used as
+ * attributes must also be the same.
+ */
+inline bool SameFieldData(vtkFieldData *expected, vtkFieldData *output,
+                          const char *what, double tolerance = 0.0)
+{
+  if (expected->GetNumberOfArrays() != output->GetNumberOfArrays())
+  {
+    cerr << "Wrong number of " << what << " arrays: "
+         << output->GetNumberOfArrays() << " instead of "
+         << expected->GetNumberOfArrays() << endl;
+    return false;
+  }
+  for (int a = 0; a < expected->GetNumberOfArrays(); ++a)
+  {
+    vtkAbstractArray *array = expected->GetAbstractArray(a);
+    if (!SameArrays(array, array->GetName() ?
+                    output->GetAbstractArray(array->GetName()) :
+                    output->GetAbstractArray(a), what, tolerance))
+    {
+      return false;
+    }
+  }
+  vtkDataSetAttributes *attributes0 =
+    vtkDataSetAttributes::SafeDownCast(expected);
+  vtkDataSetAttributes *attributes1 =
+    vtkDataSetAttributes::SafeDownCast(output);
+  for (int i = 0; attributes0 && attributes1 &&
+       i < vtkDataSetAttributes::NUM_ATTRIBUTES; ++i)
+  {
+    vtkAbstractArray *array0 = attributes0->GetAbstractAttribute(i);
+    vtkAbstractArray *array1 = attributes1->GetAbstractAttribute(i);
+    if ((array0 == NULL) != (array1 == NULL) || (array0 && array1 &&
+        !SameArrays(array0, array1, what, tolerance)))
+    {
+      cerr << "Wrong " << vtkDataSetAttributes::GetAttributeTypeAsString(i)
+           << " of the " << what << " data." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Compare the tuple id0 of a field data with the tuple id1 of another one,
+ * whose arrays are matched by name.
+ */
+inline bool SameTuples(vtkFieldData *expected, vtkIdType id0,
+                       vtkFieldData *output, vtkIdType id1,
+                       double tolerance = 0.0)
+{
+  if (expected->GetNumberOfArrays() != output->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int a = 0; a < expected->GetNumberOfArrays(); ++a)
+  {
+    vtkAbstractArray *array0 = expected->GetAbstractArray(a);
+    vtkAbstractArray *array1 = output->GetAbstractArray(array0->GetName());
+    if (!array1 || array1->GetDataType() != array0->GetDataType() ||
+        array1->GetNumberOfComponents() != array0->GetNumberOfComponents())
+    {
+      return false;
+    }
+    int numComps = array0->GetNumberOfComponents();
+    for (int c = 0; c < numComps; ++c)
+    {
+      if (!SameValues(array0, id0 * numComps + c,
+                      array1, id1 * numComps + c, tolerance))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Compare two cell arrays, which may both be NULL or empty, cell by cell.
+ */
+inline bool SameCells(vtkCellArray *expected, vtkCellArray *output,
+                      const char *what)
+{
+  vtkIdType numCells = expected ? expected->GetNumberOfCells() : 0;
+  if (numCells != (output ? output->GetNumberOfCells() : 0))
+  {
+    cerr << "Wrong number of " << what << ": "
+         << (output ? output->GetNumberOfCells() : 0) << " instead of "
+         << numCells << endl;
+    return false;
+  }
+  // Outputs passing the cells of their input may share the cell array,
+  // which cannot be traversed twice at once.
+  if (numCells == 0 || expected == output)
+  {
+    return true;
+  }
+  vtkIdType npts0, npts1, *pts0, *pts1;
+  expected->InitTraversal();
+  output->InitTraversal();
+  for (vtkIdType cellId = 0; expected->GetNextCell(npts0, pts0) &&
+       output->GetNextCell(npts1, pts1); ++cellId)
+  {
+    bool same = (npts0 == npts1);
+    for (vtkIdType i = 0; same && i < npts0; ++i)
+    {
+      same = (pts0[i] == pts1[i]);
+    }
+    if (!same)
+    {
+      cerr << "Connectivity of the " << what << " differs at cell "
+           << cellId << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Compare two poly data: their points, cells, point data and cell data.
+ */
+inline bool SamePolyData(vtkPolyData *expected, vtkPolyData *output,
+                         const char *what, double tolerance = 0.0)
+{
+  if (!SameArrays(expected->GetPoints() ? expected->GetPoints()->GetData() :
+                  NULL, output->GetPoints() ? output->GetPoints()->GetData() :
+                  NULL, "points", tolerance) ||
+      !SameCells(expected->GetVerts(), output->GetVerts(), "verts") ||
+      !SameCells(expected->GetLines(), output->GetLines(), "lines") ||
+      !SameCells(expected->GetPolys(), output->GetPolys(), "polys") ||
+      !SameCells(expected->GetStrips(), output->GetStrips(), "strips") ||
+      !SameFieldData(expected->GetPointData(), output->GetPointData(),
+                     "point", tolerance) ||
+      !SameFieldData(expected->GetCellData(), output->GetCellData(),
+                     "cell", tolerance))
+  {
+    cerr << "for " << what << endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Compare two datasets cell by cell, through the types, the data and the
+ * points of their cells, for outputs whose points may be numbered
+ * differently. Points used by no cell are not compared.
+ */
+inline bool SameCellsByPoints(vtkDataSet *expected, vtkDataSet *output,
+                              const char *what, double tolerance = 0.0)
+{
+  if (expected->GetNumberOfPoints() != output->GetNumberOfPoints() ||
+      expected->GetNumberOfCells() != output->GetNumberOfCells())
+  {
+    cerr << "Size of " << what << " differs: " << output->GetNumberOfPoints()
+         << " points and " << output->GetNumberOfCells()
+         << " cells instead of " << expected->GetNumberOfPoints() << " and "
+         << expected->GetNumberOfCells() << endl;
+    return false;
+  }
+  vtkNew<vtkIdList> ptIds0;
+  vtkNew<vtkIdList> ptIds1;
+  for (vtkIdType cellId = 0; cellId < expected->GetNumberOfCells(); ++cellId)
+  {
+    expected->GetCellPoints(cellId, ptIds0.GetPointer());
+    output->GetCellPoints(cellId, ptIds1.GetPointer());
+    bool same = expected->GetCellType(cellId) == output->GetCellType(cellId) &&
+      ptIds0->GetNumberOfIds() == ptIds1->GetNumberOfIds() &&
+      SameTuples(expected->GetCellData(), cellId,
+                 output->GetCellData(), cellId, tolerance);
+    for (vtkIdType i = 0; same && i < ptIds0->GetNumberOfIds(); ++i)
+    {
+      vtkIdType ptId0 = ptIds0->GetId(i);
+      vtkIdType ptId1 = ptIds1->GetId(i);
+      double x0[3], x1[3];
+      expected->GetPoint(ptId0, x0);
+      output->GetPoint(ptId1, x1);
+      same = SameValues(x0[0], x1[0], tolerance) &&
+        SameValues(x0[1], x1[1], tolerance) &&
+        SameValues(x0[2], x1[2], tolerance) &&
+        SameTuples(expected->GetPointData(), ptId0,
+                   output->GetPointData(), ptId1, tolerance);
+    }
+    if (!same)
+    {
+      cerr << "Cell " << cellId << " of " << what << " differs." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+#endif
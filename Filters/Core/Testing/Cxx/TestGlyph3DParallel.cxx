@@ -0,0 +1,494 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGlyph3DParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the parallel generation of glyphs by vtkGlyph3D gives the same
+// output as the serial one, and that the glyph instances, drawn by a
+// vtkGlyph3DMapper set up with ConfigureForGlyph3DInstances(), describe the
+// same glyphs.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFloatArray.h"
+#include "vtkGlyph3D.h"
+#include "vtkGlyph3DMapper.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStringArray.h"
+#include "vtkTransform.h"
+#include "vtkUnsignedCharArray.h"
+
+#include "TestDataComparison.h"
+
+#include <cmath>
+
+namespace
+{
+
+const int Res = 20;
+
+// Points with scalars, vectors (some of them null or along the x axis),
+// normals, other arrays and a few duplicate ghost points.
+void MakeInput(vtkPolyData *input)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkFloatArray> normals;
+  normals->SetName("Normals");
+  normals->SetNumberOfComponents(3);
+  vtkNew<vtkIntArray> labels;
+  labels->SetName("Labels");
+  vtkNew<vtkStringArray> names;
+  names->SetName("Names");
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  for (int j = 0; j < Res; ++j)
+  {
+    for (int i = 0; i < Res; ++i)
+    {
+      int id = i + j * Res;
+      points->InsertNextPoint(i, j, 0.3 * sin(0.5 * i * j));
+      scalars->InsertNextValue(-0.2 + 1.5 * (id % 17) / 16.0);
+      if (id % 11 == 0)
+      {
+        vectors->InsertNextTuple3(0.0, 0.0, 0.0);
+      }
+      else if (id % 7 == 0)
+      {
+        vectors->InsertNextTuple3(id % 2 ? -1.2 : 0.7, 0.0, 0.0);
+      }
+      else
+      {
+        vectors->InsertNextTuple3(sin(0.3 * i), cos(0.2 * j), 0.1 * (id % 5));
+      }
+      normals->InsertNextTuple3(0.0, sin(0.1 * id), cos(0.1 * id));
+      labels->InsertNextValue(id * 3);
+      names->InsertNextValue(id % 2 ? "odd" : "even");
+      ghosts->InsertNextValue(id % 13 == 5 ?
+        vtkDataSetAttributes::DUPLICATEPOINT : 0);
+    }
+  }
+  input->SetPoints(points.Get());
+  input->GetPointData()->SetScalars(scalars.Get());
+  input->GetPointData()->SetVectors(vectors.Get());
+  input->GetPointData()->SetNormals(normals.Get());
+  input->GetPointData()->AddArray(labels.Get());
+  input->GetPointData()->AddArray(names.Get());
+  input->GetPointData()->AddArray(ghosts.Get());
+}
+
+// A pyramid with normals and texture coordinates.
+void MakePyramid(vtkPolyData *pyramid)
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0.0, -0.5, -0.5);
+  points->InsertNextPoint(0.0, 0.5, -0.5);
+  points->InsertNextPoint(0.0, 0.5, 0.5);
+  points->InsertNextPoint(0.0, -0.5, 0.5);
+  points->InsertNextPoint(1.0, 0.0, 0.0);
+  vtkNew<vtkFloatArray> normals;
+  normals->SetNumberOfComponents(3);
+  vtkNew<vtkFloatArray> tcoords;
+  tcoords->SetNumberOfComponents(2);
+  for (vtkIdType i = 0; i < 5; ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    x[0] -= 0.3;
+    vtkMath::Normalize(x);
+    normals->InsertNextTuple(x);
+    tcoords->InsertNextTuple2(0.25 * i, 1.0 - 0.2 * i);
+  }
+  vtkNew<vtkCellArray> polys;
+  vtkIdType base[4] = { 0, 3, 2, 1 };
+  polys->InsertNextCell(4, base);
+  for (vtkIdType i = 0; i < 4; ++i)
+  {
+    vtkIdType tri[3] = { i, (i + 1) % 4, 4 };
+    polys->InsertNextCell(3, tri);
+  }
+  pyramid->SetPoints(points.Get());
+  pyramid->SetPolys(polys.Get());
+  pyramid->GetPointData()->SetNormals(normals.Get());
+  pyramid->GetPointData()->SetTCoords(tcoords.Get());
+}
+
+// A polyline with a vertex at its end, in double precision.
+void MakeArrow(vtkPolyData *arrow)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(1.0, 0.0, 0.0);
+  points->InsertNextPoint(0.8, 0.1, 0.0);
+  points->InsertNextPoint(0.8, -0.1, 0.05);
+  vtkNew<vtkCellArray> lines;
+  vtkIdType line[4] = { 0, 1, 2, 3 };
+  lines->InsertNextCell(4, line);
+  vtkNew<vtkCellArray> verts;
+  vtkIdType vert = 1;
+  verts->InsertNextCell(1, &vert);
+  arrow->SetPoints(points.Get());
+  arrow->SetLines(lines.Get());
+  arrow->SetVerts(verts.Get());
+}
+
+struct Settings
+{
+  int ScaleMode;
+  int ColorMode;
+  int VectorMode;
+  int IndexMode;
+  int Clamping;
+  int Orient;
+  int Scaling;
+  int GeneratePointIds;
+  int FillCellData;
+  bool UseSourceTransform;
+};
+
+// A mapper giving the source and the transform of each glyph as
+// vtkOpenGLGlyph3DMapper computes them from its arrays and settings, without
+// rendering.
+class InstanceMapper : public vtkGlyph3DMapper
+{
+public:
+  static InstanceMapper *New();
+  vtkTypeMacro(InstanceMapper, vtkGlyph3DMapper);
+
+  // Returns the index of the source of the glyph of point ptId.
+  int GetGlyph(vtkDataSet *input, vtkIdType ptId, vtkTransform *trans)
+  {
+    double den = this->Range[1] - this->Range[0];
+    if (den == 0.0)
+    {
+      den = 1.0;
+    }
+
+    int index = 0;
+    int numEntries = this->GetNumberOfInputConnections(1);
+    vtkDataArray *indexArray = this->GetSourceIndexArray(input);
+    if (indexArray)
+    {
+      double value = vtkMath::Norm(indexArray->GetTuple(ptId),
+        indexArray->GetNumberOfComponents());
+      index = static_cast<int>((value - this->Range[0]) * numEntries / den);
+      index = vtkMath::ClampValue(index, 0, numEntries - 1);
+    }
+
+    double scale[3] = { 1.0, 1.0, 1.0 };
+    vtkDataArray *scaleArray = this->GetScaleArray(input);
+    if (scaleArray)
+    {
+      double *tuple = scaleArray->GetTuple(ptId);
+      if (this->ScaleMode == SCALE_BY_MAGNITUDE)
+      {
+        scale[0] = scale[1] = scale[2] =
+          vtkMath::Norm(tuple, scaleArray->GetNumberOfComponents());
+      }
+      else if (this->ScaleMode == SCALE_BY_COMPONENTS)
+      {
+        scale[0] = tuple[0];
+        scale[1] = tuple[1];
+        scale[2] = tuple[2];
+      }
+      for (int i = 0; i < 3 && this->Clamping &&
+             this->ScaleMode != NO_DATA_SCALING; ++i)
+      {
+        scale[i] = vtkMath::ClampValue(scale[i], this->Range[0],
+                                       this->Range[1]);
+        scale[i] = (scale[i] - this->Range[0]) / den;
+      }
+    }
+
+    double x[3];
+    input->GetPoint(ptId, x);
+    trans->Identity();
+    trans->Translate(x);
+    vtkDataArray *orientArray = this->GetOrientationArray(input);
+    if (orientArray)
+    {
+      double orientation[3];
+      orientArray->GetTuple(ptId, orientation);
+      if (this->OrientationMode == ROTATION)
+      {
+        trans->RotateZ(orientation[2]);
+        trans->RotateX(orientation[0]);
+        trans->RotateY(orientation[1]);
+      }
+      else if (orientation[1] == 0.0 && orientation[2] == 0.0)
+      {
+        if (orientation[0] < 0)
+        {
+          trans->RotateWXYZ(180.0, 0, 1, 0);
+        }
+      }
+      else
+      {
+        double vMag = vtkMath::Norm(orientation);
+        trans->RotateWXYZ(180.0, (orientation[0] + vMag) / 2.0,
+                          orientation[1] / 2.0, orientation[2] / 2.0);
+      }
+    }
+    if (this->Scaling)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        scale[i] *= this->ScaleFactor;
+        if (scale[i] == 0.0)
+        {
+          scale[i] = 1.0e-10;
+        }
+      }
+      trans->Scale(scale);
+    }
+    return index;
+  }
+
+protected:
+  InstanceMapper() {}
+  ~InstanceMapper() VTK_OVERRIDE {}
+
+private:
+  InstanceMapper(const InstanceMapper&) VTK_DELETE_FUNCTION;
+  void operator=(const InstanceMapper&) VTK_DELETE_FUNCTION;
+};
+
+vtkStandardNewMacro(InstanceMapper);
+
+void SetUp(vtkGlyph3D *glyph, vtkPolyData *input, vtkPolyData *pyramid,
+           vtkPolyData *arrow, const Settings &settings)
+{
+  glyph->SetInputData(input);
+  glyph->SetSourceData(0, pyramid);
+  if (settings.IndexMode != VTK_INDEXING_OFF)
+  {
+    glyph->SetSourceData(1, arrow);
+    glyph->SetSourceData(2, pyramid);
+  }
+  glyph->SetScaleMode(settings.ScaleMode);
+  glyph->SetColorMode(settings.ColorMode);
+  glyph->SetVectorMode(settings.VectorMode);
+  glyph->SetIndexMode(settings.IndexMode);
+  glyph->SetClamping(settings.Clamping);
+  glyph->SetOrient(settings.Orient);
+  glyph->SetScaling(settings.Scaling);
+  glyph->SetGeneratePointIds(settings.GeneratePointIds);
+  glyph->SetFillCellData(settings.FillCellData);
+  glyph->SetScaleFactor(0.4);
+  glyph->SetRange(0.0, 1.2);
+  if (settings.UseSourceTransform)
+  {
+    vtkNew<vtkTransform> transform;
+    transform->RotateZ(30.0);
+    transform->Scale(1.0, 2.0, 0.5);
+    glyph->SetSourceTransform(transform.Get());
+  }
+}
+
+int Compare(vtkPolyData *input, vtkPolyData *pyramid, vtkPolyData *arrow,
+            const Settings &settings)
+{
+  vtkNew<vtkGlyph3D> serial;
+  vtkNew<vtkGlyph3D> parallel;
+  SetUp(serial.Get(), input, pyramid, arrow, settings);
+  SetUp(parallel.Get(), input, pyramid, arrow, settings);
+  parallel->ParallelGlyphingOn();
+  serial->Update();
+  parallel->Update();
+
+  vtkPolyData *expected = serial->GetOutput();
+  vtkPolyData *output = parallel->GetOutput();
+  if (expected->GetNumberOfCells() == 0)
+  {
+    cerr << "Unexpected serial output." << endl;
+    return EXIT_FAILURE;
+  }
+  if (!vtkTest::SamePolyData(expected, output, "the glyphs"))
+  {
+    cerr << "Different outputs with scale mode " << settings.ScaleMode
+         << ", color mode " << settings.ColorMode << ", vector mode "
+         << settings.VectorMode << ", index mode " << settings.IndexMode
+         << ": " << output->GetNumberOfPoints() << " points, "
+         << output->GetNumberOfCells() << " cells, expected "
+         << expected->GetNumberOfPoints() << " and "
+         << expected->GetNumberOfCells() << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+// Expand the instances as vtkGlyph3DMapper does and compare them to the
+// glyph geometry.
+int CheckInstances(vtkPolyData *input, vtkPolyData *pyramid,
+                   vtkPolyData *arrow, const Settings &settings)
+{
+  vtkNew<vtkGlyph3D> glyph;
+  vtkNew<vtkGlyph3D> instancer;
+  SetUp(glyph.Get(), input, pyramid, arrow, settings);
+  SetUp(instancer.Get(), input, pyramid, arrow, settings);
+  instancer->GenerateInstancesOn();
+  glyph->Update();
+  instancer->Update();
+
+  vtkPolyData *expected = glyph->GetOutput();
+  vtkPolyData *instances = instancer->GetOutput();
+  vtkPointData *instancePD = instances->GetPointData();
+  vtkDataArray *scaleFactors = instancePD->GetArray("GlyphScaleFactors");
+  vtkDataArray *orientations = instancePD->GetArray("GlyphOrientation");
+  vtkDataArray *sourceIndexes = instancePD->GetArray("GlyphSourceIndex");
+  if (!scaleFactors || !orientations || instances->GetNumberOfCells() != 0 ||
+      (settings.IndexMode != VTK_INDEXING_OFF) != (sourceIndexes != NULL))
+  {
+    cerr << "Missing instance arrays." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkPolyData *sources[3] = { pyramid, arrow, pyramid };
+  int numberOfSources = (settings.IndexMode != VTK_INDEXING_OFF ? 3 : 1);
+  vtkNew<InstanceMapper> mapper;
+  for (int i = 0; i < numberOfSources; ++i)
+  {
+    mapper->SetSourceData(i, sources[i]);
+  }
+  mapper->ConfigureForGlyph3DInstances(numberOfSources);
+
+  vtkIdType ptIncr = 0;
+  vtkNew<vtkTransform> trans;
+  vtkNew<vtkPoints> glyphPts;
+  for (vtkIdType g = 0; g < instances->GetNumberOfPoints(); ++g)
+  {
+    int index = mapper->GetGlyph(instances, g, trans.Get());
+    vtkPoints *sourcePts = sources[index]->GetPoints();
+    glyphPts->Reset();
+    trans->TransformPoints(sourcePts, glyphPts.Get());
+
+    for (vtkIdType i = 0; i < sourcePts->GetNumberOfPoints(); ++i)
+    {
+      double y[3], z[3];
+      glyphPts->GetPoint(i, y);
+      expected->GetPoint(ptIncr + i, z);
+      if (sqrt(vtkMath::Distance2BetweenPoints(y, z)) > 1e-5)
+      {
+        cerr << "Instance " << g << " point " << i << " is (" << y[0] << ", "
+             << y[1] << ", " << y[2] << ") expected (" << z[0] << ", "
+             << z[1] << ", " << z[2] << ")" << endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // The point data of the instance is the point data of its glyph.
+    vtkPointData *expectedPD = expected->GetPointData();
+    for (int a = 0; a < expectedPD->GetNumberOfArrays(); ++a)
+    {
+      vtkAbstractArray *expectedArray = expectedPD->GetAbstractArray(a);
+      if (expectedArray == expectedPD->GetNormals() ||
+          expectedArray == expectedPD->GetTCoords())
+      {
+        continue;
+      }
+      vtkAbstractArray *array =
+        instancePD->GetAbstractArray(expectedArray->GetName());
+      int numComps = expectedArray->GetNumberOfComponents();
+      for (int c = 0; array && c < numComps; ++c)
+      {
+        if (!vtkTest::SameValues(expectedArray, ptIncr * numComps + c,
+                                 array, g * numComps + c, 0.0))
+        {
+          array = NULL;
+        }
+      }
+      if (!array)
+      {
+        cerr << "Wrong " << expectedArray->GetName() << " for instance " << g
+             << endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    ptIncr += sourcePts->GetNumberOfPoints();
+  }
+  if (ptIncr != expected->GetNumberOfPoints() || ptIncr == 0)
+  {
+    cerr << "The instances have " << ptIncr << " points, expected "
+         << expected->GetNumberOfPoints() << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int TestGlyph3DParallel(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkPolyData> input;
+  MakeInput(input.Get());
+  vtkNew<vtkPolyData> pyramid;
+  MakePyramid(pyramid.Get());
+  vtkNew<vtkPolyData> arrow;
+  MakeArrow(arrow.Get());
+
+  const int scaleModes[4] = { VTK_SCALE_BY_SCALAR, VTK_SCALE_BY_VECTOR,
+    VTK_SCALE_BY_VECTORCOMPONENTS, VTK_DATA_SCALING_OFF };
+  const int colorModes[3] = { VTK_COLOR_BY_SCALE, VTK_COLOR_BY_SCALAR,
+    VTK_COLOR_BY_VECTOR };
+  const int vectorModes[3] = { VTK_USE_VECTOR, VTK_USE_NORMAL,
+    VTK_VECTOR_ROTATION_OFF };
+  const int indexModes[3] = { VTK_INDEXING_OFF, VTK_INDEXING_BY_SCALAR,
+    VTK_INDEXING_BY_VECTOR };
+
+  for (int i = 0; i < 72; ++i)
+  {
+    Settings settings;
+    settings.ScaleMode = scaleModes[i % 4];
+    settings.ColorMode = colorModes[(i / 4) % 3];
+    settings.VectorMode = vectorModes[(i / 12) % 3];
+    settings.IndexMode = indexModes[(i / 2) % 3];
+    settings.Clamping = (i / 3) % 2;
+    settings.Orient = (i % 5) != 0;
+    settings.Scaling = (i % 7) != 0;
+    settings.GeneratePointIds = i % 2;
+    // Cells are numbered glyph after glyph in serial, and by type over all
+    // the glyphs in parallel, so only compare the cell data of sources
+    // with a single cell type.
+    settings.FillCellData = (settings.IndexMode == VTK_INDEXING_OFF);
+    settings.UseSourceTransform = (i / 6) % 2 != 0;
+    if (Compare(input.Get(), pyramid.Get(), arrow.Get(), settings) !=
+        EXIT_SUCCESS)
+    {
+      return EXIT_FAILURE;
+    }
+    if (!settings.UseSourceTransform &&
+        CheckInstances(input.Get(), pyramid.Get(), arrow.Get(), settings) !=
+        EXIT_SUCCESS)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,320 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestParallelPointMerging.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the parallel point merging of vtkCleanPolyData and
+// vtkAppendPolyData on a triangle soup (each triangle has its own points),
+// and the parallel cleaning of cells which become degenerate once merged.
+
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCleanPolyData.h"
+#include "vtkCellData.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include "TestDataComparison.h"
+
+#include <cmath>
+
+namespace
+{
+
+const int Res = 40;
+
+// The triangles of the rows [row0,row1) of a Res x Res grid, each with its
+// own points, moved by up to jitter.
+void MakeSoup(vtkPolyData *soup, int row0, int row1, double jitter)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> triangles;
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  for (int j = row0; j < row1; ++j)
+  {
+    for (int i = 0; i < Res; ++i)
+    {
+      double x0 = i, y0 = j;
+      double corners[4][2] = { { x0, y0 }, { x0 + 1, y0 },
+                               { x0 + 1, y0 + 1 }, { x0, y0 + 1 } };
+      int tris[2][3] = { { 0, 1, 2 }, { 0, 2, 3 } };
+      for (int t = 0; t < 2; ++t)
+      {
+        vtkIdType ids[3];
+        for (int c = 0; c < 3; ++c)
+        {
+          const double *x = corners[tris[t][c]];
+          double offset = jitter * sin(37.0 * points->GetNumberOfPoints());
+          ids[c] = points->InsertNextPoint(x[0] + offset, x[1], 0.0);
+          scalars->InsertNextValue(static_cast<float>(x[0] + x[1]));
+        }
+        triangles->InsertNextCell(3, ids);
+      }
+    }
+  }
+  soup->SetPoints(points.Get());
+  soup->SetPolys(triangles.Get());
+  soup->GetPointData()->SetScalars(scalars.Get());
+}
+
+// Copies of a unit square whose first two corners are duplicated, with
+// cells of every kind collapsing to other kinds once the duplicates are
+// merged. There are enough copies for the cells to span several chunks of
+// the parallel cleaning.
+void MakeDegenerateCells(vtkPolyData *cells)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> verts, lines, polys, strips;
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  for (int c = 0; c < 400; ++c)
+  {
+    // a, b, c, d, and the duplicates of a and b.
+    double corners[6][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 },
+                             { 0, 0 }, { 1, 0 } };
+    vtkIdType p = points->GetNumberOfPoints();
+    for (int i = 0; i < 6; ++i)
+    {
+      points->InsertNextPoint(2.0 * c + corners[i][0], corners[i][1], 0.0);
+      scalars->InsertNextValue(static_cast<float>(p + i));
+    }
+    vtkIdType a = p, b = p + 1, cc = p + 2, d = p + 3, a2 = p + 4, b2 = p + 5;
+
+    vtkIdType vert[3] = { a, a2, cc };
+    verts->InsertNextCell(1, vert);
+    verts->InsertNextCell(3, vert);
+
+    vtkIdType line0[2] = { a, a2 };
+    vtkIdType line1[4] = { a, b, b2, cc };
+    lines->InsertNextCell(2, line0);
+    lines->InsertNextCell(4, line1);
+
+    vtkIdType poly0[3] = { a, b, b2 };
+    vtkIdType poly1[4] = { a, b, cc, a2 };
+    vtkIdType poly2[3] = { a, a2, a };
+    vtkIdType poly3[4] = { a, b, cc, d };
+    polys->InsertNextCell(3, poly0);
+    polys->InsertNextCell(4, poly1);
+    polys->InsertNextCell(3, poly2);
+    polys->InsertNextCell(4, poly3);
+
+    vtkIdType strip0[4] = { a, b, d, cc };
+    vtkIdType strip1[5] = { a, b, b2, d, cc };
+    vtkIdType strip2[4] = { a, b, b2, cc };
+    vtkIdType strip3[3] = { a, a2, b };
+    vtkIdType strip4[2] = { a, a2 };
+    strips->InsertNextCell(4, strip0);
+    strips->InsertNextCell(5, strip1);
+    strips->InsertNextCell(4, strip2);
+    strips->InsertNextCell(3, strip3);
+    strips->InsertNextCell(2, strip4);
+  }
+  cells->SetPoints(points.Get());
+  cells->SetVerts(verts.Get());
+  cells->SetLines(lines.Get());
+  cells->SetPolys(polys.Get());
+  cells->SetStrips(strips.Get());
+  cells->GetPointData()->SetScalars(scalars.Get());
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType cellId = 0; cellId < cells->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->InsertNextValue(cellId);
+  }
+  cells->GetCellData()->AddArray(cellIds.Get());
+}
+
+bool SameArrays(vtkDataArray *array0, vtkDataArray *array1)
+{
+  if (array0->GetNumberOfTuples() != array1->GetNumberOfTuples() ||
+      array0->GetNumberOfComponents() != array1->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < array0->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < array0->GetNumberOfComponents(); ++c)
+    {
+      if (array0->GetComponent(i, c) != array1->GetComponent(i, c))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int TestClean()
+{
+  // Exact merging: same output as the serial merging.
+  vtkNew<vtkPolyData> soup;
+  MakeSoup(soup.Get(), 0, Res, 0.0);
+  vtkNew<vtkCleanPolyData> serial;
+  serial->SetInputData(soup.Get());
+  serial->Update();
+  vtkNew<vtkCleanPolyData> parallel;
+  parallel->SetInputData(soup.Get());
+  parallel->ParallelPointMergingOn();
+  parallel->Update();
+
+  vtkPolyData *expected = serial->GetOutput();
+  vtkPolyData *output = parallel->GetOutput();
+  if (output->GetNumberOfPoints() != (Res + 1) * (Res + 1) ||
+      !SameArrays(expected->GetPoints()->GetData(),
+                  output->GetPoints()->GetData()) ||
+      !SameArrays(expected->GetPolys()->GetData(),
+                  output->GetPolys()->GetData()) ||
+      !SameArrays(expected->GetPointData()->GetScalars(),
+                  output->GetPointData()->GetScalars()))
+  {
+    cerr << "Exact merging: " << output->GetNumberOfPoints()
+         << " points, expected " << expected->GetNumberOfPoints() << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Merging within a tolerance.
+  vtkNew<vtkPolyData> jittered;
+  MakeSoup(jittered.Get(), 0, Res, 1.0e-3);
+  parallel->SetInputData(jittered.Get());
+  parallel->ToleranceIsAbsoluteOn();
+  parallel->SetAbsoluteTolerance(0.01);
+  parallel->Update();
+  output = parallel->GetOutput();
+  if (output->GetNumberOfPoints() != (Res + 1) * (Res + 1) ||
+      output->GetNumberOfPolys() != 2 * Res * Res)
+  {
+    cerr << "Merging within a tolerance: " << output->GetNumberOfPoints()
+         << " points and " << output->GetNumberOfPolys() << " triangles"
+         << endl;
+    return EXIT_FAILURE;
+  }
+
+  // The merging within a tolerance does not depend on the number of threads.
+  vtkNew<vtkPolyData> expectedJittered;
+  expectedJittered->DeepCopy(output);
+  vtkSMPTools::Initialize(1);
+  parallel->Modified();
+  parallel->Update();
+  vtkSMPTools::Initialize(4);
+  if (!vtkTest::SamePolyData(expectedJittered.Get(), parallel->GetOutput(),
+                             "the merging within a tolerance on one thread"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+// The cells collapsing once their points are merged are converted or
+// removed as in the serial cleaning.
+int TestDegenerateCells()
+{
+  vtkNew<vtkPolyData> cells;
+  MakeDegenerateCells(cells.Get());
+  for (int i = 0; i < 8; ++i)
+  {
+    vtkNew<vtkCleanPolyData> serial;
+    vtkNew<vtkCleanPolyData> parallel;
+    vtkCleanPolyData *filters[2] = { serial.Get(), parallel.Get() };
+    for (int f = 0; f < 2; ++f)
+    {
+      filters[f]->SetInputData(cells.Get());
+      filters[f]->SetConvertLinesToPoints(i & 1);
+      filters[f]->SetConvertPolysToLines((i >> 1) & 1);
+      filters[f]->SetConvertStripsToPolys((i >> 2) & 1);
+      filters[f]->SetParallelPointMerging(f);
+      filters[f]->Update();
+    }
+    if (!vtkTest::SamePolyData(serial->GetOutput(), parallel->GetOutput(),
+                               "the cleaning of degenerate cells"))
+    {
+      cerr << "with lines to points " << (i & 1) << ", polys to lines "
+           << ((i >> 1) & 1) << ", strips to polys " << ((i >> 2) & 1)
+           << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestAppend()
+{
+  vtkNew<vtkPolyData> soup0, soup1;
+  MakeSoup(soup0.Get(), 0, Res / 2, 0.0);
+  MakeSoup(soup1.Get(), Res / 2, Res, 0.0);
+  vtkNew<vtkAppendPolyData> append;
+  append->AddInputData(soup0.Get());
+  append->AddInputData(soup1.Get());
+  append->Update();
+  vtkNew<vtkPolyData> expected;
+  expected->DeepCopy(append->GetOutput());
+
+  append->MergePointsOn();
+  append->Update();
+  vtkPolyData *output = append->GetOutput();
+  if (output->GetNumberOfPoints() != (Res + 1) * (Res + 1) ||
+      output->GetNumberOfPolys() != expected->GetNumberOfPolys())
+  {
+    cerr << "Append: " << output->GetNumberOfPoints() << " points, expected "
+         << (Res + 1) * (Res + 1) << endl;
+    return EXIT_FAILURE;
+  }
+
+  // The triangles and their point data must not change.
+  vtkIdType npts, *pts, expectedNpts, *expectedPts;
+  vtkCellArray *polys = output->GetPolys();
+  vtkCellArray *expectedPolys = expected->GetPolys();
+  vtkDataArray *scalars = output->GetPointData()->GetScalars();
+  vtkDataArray *expectedScalars = expected->GetPointData()->GetScalars();
+  polys->InitTraversal();
+  expectedPolys->InitTraversal();
+  while (polys->GetNextCell(npts, pts) &&
+         expectedPolys->GetNextCell(expectedNpts, expectedPts))
+  {
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      double x[3], expectedX[3];
+      output->GetPoint(pts[i], x);
+      expected->GetPoint(expectedPts[i], expectedX);
+      if (x[0] != expectedX[0] || x[1] != expectedX[1] ||
+          x[2] != expectedX[2] || scalars->GetTuple1(pts[i]) !=
+          expectedScalars->GetTuple1(expectedPts[i]))
+      {
+        cerr << "Append: a triangle changed." << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+}
+
+int TestParallelPointMerging(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  if (TestClean() != EXIT_SUCCESS || TestDegenerateCells() != EXIT_SUCCESS ||
+      TestAppend() != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
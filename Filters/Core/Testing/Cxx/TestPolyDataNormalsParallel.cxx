@@ -0,0 +1,175 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyDataNormalsParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded mode of vtkPolyDataNormals gives the same output
+// as the serial mode, with and without splitting and consistency.
+
+#include "vtkCellArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkSMPTools.h"
+
+#include "TestDataComparison.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+const int Res = 30;
+
+// A height field of quads and triangles with a crease along x = Res / 2,
+// some reversed cells, a triangle strip, and a fin sharing an edge of the
+// height field (non-manifold).
+void MakeSurface(vtkPolyData *surface)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIntArray> labels;
+  labels->SetName("Labels");
+  for (int j = 0; j <= Res; ++j)
+  {
+    for (int i = 0; i <= Res; ++i)
+    {
+      double z = 0.3 * fabs(i - 0.5 * Res) + 0.5 * sin(0.4 * j) * cos(0.3 * i);
+      points->InsertNextPoint(i, j, z);
+      labels->InsertNextValue(i + j);
+    }
+  }
+
+  vtkNew<vtkCellArray> polys;
+  const vtkIdType n = Res + 1;
+  for (int j = 0; j < Res - 2; ++j)
+  {
+    for (int i = 0; i < Res; ++i)
+    {
+      vtkIdType p = i + j * n;
+      bool reverse = ((i * 7 + j * 3) % 5) == 0;
+      if ((i + j) % 4)
+      {
+        vtkIdType quad[4] = { p, p + 1, p + 1 + n, p + n };
+        if (reverse)
+        {
+          std::swap(quad[1], quad[3]);
+        }
+        polys->InsertNextCell(4, quad);
+      }
+      else
+      {
+        vtkIdType tri0[3] = { p, p + 1, p + 1 + n };
+        vtkIdType tri1[3] = { p, p + 1 + n, p + n };
+        if (reverse)
+        {
+          std::swap(tri0[1], tri0[2]);
+        }
+        polys->InsertNextCell(3, tri0);
+        polys->InsertNextCell(3, tri1);
+      }
+    }
+  }
+
+  // The fin.
+  vtkIdType top = points->InsertNextPoint(2.5, 2.5, 5.0);
+  labels->InsertNextValue(-1);
+  vtkIdType fin[3] = { 2 + 2 * n, 3 + 2 * n, top };
+  polys->InsertNextCell(3, fin);
+
+  // The last two rows as a strip each.
+  vtkNew<vtkCellArray> strips;
+  for (int j = Res - 2; j < Res; ++j)
+  {
+    strips->InsertNextCell(2 * n);
+    for (int i = 0; i <= Res; ++i)
+    {
+      strips->InsertCellPoint(i + (j + 1) * n);
+      strips->InsertCellPoint(i + j * n);
+    }
+  }
+
+  surface->SetPoints(points.Get());
+  surface->SetPolys(polys.Get());
+  surface->SetStrips(strips.Get());
+  surface->GetPointData()->AddArray(labels.Get());
+}
+
+int Compare(vtkPolyData *surface, int splitting, int consistency,
+            int flip, int autoOrient)
+{
+  vtkNew<vtkPolyDataNormals> serial;
+  vtkNew<vtkPolyDataNormals> parallel;
+  vtkPolyDataNormals *filters[2] = { serial.Get(), parallel.Get() };
+  for (int f = 0; f < 2; ++f)
+  {
+    filters[f]->SetInputData(surface);
+    filters[f]->SetFeatureAngle(20.0);
+    filters[f]->SetSplitting(splitting);
+    filters[f]->SetConsistency(consistency);
+    filters[f]->SetFlipNormals(flip);
+    filters[f]->SetAutoOrientNormals(autoOrient);
+    filters[f]->ComputeCellNormalsOn();
+    filters[f]->SetParallelNormals(f);
+    filters[f]->Update();
+  }
+
+  vtkPolyData *expected = serial->GetOutput();
+  vtkPolyData *output = parallel->GetOutput();
+  if (splitting && expected->GetNumberOfPoints() <= surface->GetNumberOfPoints())
+  {
+    cerr << "No point was split." << endl;
+    return EXIT_FAILURE;
+  }
+  if (!vtkTest::SamePolyData(expected, output, "the normals"))
+  {
+    cerr << "Different outputs with splitting " << splitting
+         << ", consistency " << consistency << ", flip " << flip
+         << ", auto orient " << autoOrient << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int TestPolyDataNormalsParallel(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkPolyData> surface;
+  MakeSurface(surface.Get());
+
+  for (int splitting = 0; splitting < 2; ++splitting)
+  {
+    for (int consistency = 0; consistency < 2; ++consistency)
+    {
+      for (int flip = 0; flip < 2; ++flip)
+      {
+        if (Compare(surface.Get(), splitting, consistency, flip, 0) !=
+            EXIT_SUCCESS)
+        {
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+  if (Compare(surface.Get(), 1, 1, 0, 1) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
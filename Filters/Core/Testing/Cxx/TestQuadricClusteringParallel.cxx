@@ -0,0 +1,199 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestQuadricClusteringParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the parallel accumulation of the quadrics of
+// vtkQuadricClustering produces the same output as the serial one, that
+// fine divisions only use memory for the visited bins, and that pieces
+// appended one by one give the same result as the whole input.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricClustering.h"
+#include "vtkSmartPointer.h"
+#include "vtkSMPTools.h"
+#include "vtkSphereSource.h"
+#include "vtkStripper.h"
+
+#include "TestDataComparison.h"
+
+#include <cmath>
+
+namespace
+{
+
+const double Tolerance = 1.0e-6;
+
+// A sphere with polygons, a polyline and a few vertices, and an id per
+// cell.
+void MakeSurface(vtkPolyData *surface)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(60);
+  sphere->SetPhiResolution(40);
+  sphere->Update();
+  surface->DeepCopy(sphere->GetOutput());
+
+  vtkNew<vtkCellArray> lines;
+  lines->InsertNextCell(40);
+  for (vtkIdType i = 0; i < 40; ++i)
+  {
+    lines->InsertCellPoint(2 + 38 * i);
+  }
+  vtkNew<vtkCellArray> verts;
+  for (vtkIdType i = 0; i < 5; ++i)
+  {
+    vtkIdType vert = 100 + 300 * i;
+    verts->InsertNextCell(1, &vert);
+  }
+  surface->SetLines(lines.Get());
+  surface->SetVerts(verts.Get());
+
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("ids");
+  for (vtkIdType i = 0; i < surface->GetNumberOfCells(); ++i)
+  {
+    ids->InsertNextValue(i);
+  }
+  surface->GetCellData()->AddArray(ids.Get());
+}
+
+int Compare(vtkPolyData *input, int divisions, int useInputPoints,
+            int useFeatureEdges, int useInternalTriangles,
+            int preventDuplicateCells, const char *name)
+{
+  vtkNew<vtkQuadricClustering> serial;
+  vtkNew<vtkQuadricClustering> parallel;
+  vtkQuadricClustering *filters[2] = { serial.Get(), parallel.Get() };
+  for (int f = 0; f < 2; ++f)
+  {
+    filters[f]->SetInputData(input);
+    filters[f]->SetNumberOfDivisions(divisions, divisions, divisions);
+    filters[f]->AutoAdjustNumberOfDivisionsOff();
+    filters[f]->SetUseInputPoints(useInputPoints);
+    filters[f]->SetUseFeatureEdges(useFeatureEdges);
+    filters[f]->SetUseFeaturePoints(useFeatureEdges);
+    filters[f]->SetUseInternalTriangles(useInternalTriangles);
+    filters[f]->SetPreventDuplicateCells(preventDuplicateCells);
+    filters[f]->CopyCellDataOn();
+    filters[f]->SetParallelAccumulation(f);
+    filters[f]->Update();
+  }
+  if (serial->GetOutput()->GetNumberOfPoints() == 0)
+  {
+    cerr << "Unexpected serial output for " << name << endl;
+    return EXIT_FAILURE;
+  }
+  return vtkTest::SamePolyData(serial->GetOutput(), parallel->GetOutput(),
+                               name, Tolerance) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Append the pieces of a sphere one by one.
+void AppendPieces(vtkQuadricClustering *filter, vtkSphereSource *sphere,
+                  int numberOfPieces, double bounds[6])
+{
+  filter->StartAppend(bounds);
+  for (int piece = 0; piece < numberOfPieces; ++piece)
+  {
+    sphere->UpdatePiece(piece, numberOfPieces, 0);
+    vtkNew<vtkPolyData> copy;
+    copy->ShallowCopy(sphere->GetOutput());
+    filter->Append(copy.Get());
+  }
+  filter->EndAppend();
+}
+
+int TestPieces(int parallel)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(32);
+  sphere->Update();
+  double bounds[6];
+  sphere->GetOutput()->GetBounds(bounds);
+
+  vtkNew<vtkQuadricClustering> whole;
+  whole->SetInputConnection(sphere->GetOutputPort());
+  whole->SetNumberOfDivisions(12, 12, 12);
+  whole->AutoAdjustNumberOfDivisionsOff();
+  whole->Update();
+
+  vtkNew<vtkQuadricClustering> pieces;
+  pieces->SetNumberOfDivisions(12, 12, 12);
+  pieces->SetParallelAccumulation(parallel);
+  AppendPieces(pieces.Get(), sphere.Get(), 4, bounds);
+
+  // The triangles are numbered differently, but the same bins are used.
+  vtkPolyData *expected = whole->GetOutput();
+  vtkPolyData *output = pieces->GetOutput();
+  if (expected->GetNumberOfPoints() == 0 ||
+      expected->GetNumberOfPoints() != output->GetNumberOfPoints() ||
+      expected->GetNumberOfPolys() != output->GetNumberOfPolys())
+  {
+    cerr << "Appending pieces (parallel " << parallel << ") gives "
+         << output->GetNumberOfPoints() << " points and "
+         << output->GetNumberOfPolys() << " triangles instead of "
+         << expected->GetNumberOfPoints() << " and "
+         << expected->GetNumberOfPolys() << endl;
+    return EXIT_FAILURE;
+  }
+  double bounds0[6], bounds1[6];
+  expected->GetBounds(bounds0);
+  output->GetBounds(bounds1);
+  for (int i = 0; i < 6; ++i)
+  {
+    if (fabs(bounds0[i] - bounds1[i]) > Tolerance)
+    {
+      cerr << "Appending pieces (parallel " << parallel
+           << ") gives different bounds." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int TestQuadricClusteringParallel(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkPolyData> surface;
+  MakeSurface(surface.Get());
+
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputData(surface.Get());
+  stripper->Update();
+  vtkSmartPointer<vtkPolyData> strips = vtkSmartPointer<vtkPolyData>::New();
+  strips->ShallowCopy(stripper->GetOutput());
+
+  int status = EXIT_SUCCESS;
+  status |= Compare(surface.Get(), 10, 0, 0, 1, 1, "polygons");
+  status |= Compare(surface.Get(), 16, 1, 0, 1, 1, "input points");
+  status |= Compare(surface.Get(), 12, 0, 1, 1, 1, "feature edges");
+  status |= Compare(surface.Get(), 12, 0, 0, 0, 0, "no internal triangles");
+  status |= Compare(strips, 10, 0, 0, 1, 1, "strips");
+
+  // One million bins along each axis: a dense bin array could not be
+  // allocated, and the output keeps (almost) every input point.
+  status |= Compare(surface.Get(), 1000000, 0, 0, 1, 0, "fine divisions");
+
+  status |= TestPieces(0);
+  status |= TestPieces(1);
+
+  return status;
+}
@@ -0,0 +1,196 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestQuadricDecimationParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the parallel collapse of vtkQuadricDecimation reaches the
+// requested reduction with a valid mesh and an error comparable to the
+// serial collapse, with and without attributes, and that the boundary of
+// open meshes is kept.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimation.h"
+#include "vtkSMPTools.h"
+#include "vtkSphereSource.h"
+#include "vtkTriangleFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+namespace
+{
+
+const double Radius = 0.5;
+
+// No degenerate or duplicate triangle.
+bool ValidTriangles(vtkPolyData *output, const char *name)
+{
+  std::set<std::set<vtkIdType> > triangles;
+  vtkCellArray *polys = output->GetPolys();
+  vtkIdType npts, *pts;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); )
+  {
+    std::set<vtkIdType> triangle(pts, pts + npts);
+    if (npts != 3 || triangle.size() != 3)
+    {
+      cerr << "Degenerate triangle for " << name << endl;
+      return false;
+    }
+    if (!triangles.insert(triangle).second)
+    {
+      cerr << "Duplicate triangle for " << name << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Mean distance of the used points to the sphere.
+double SphereError(vtkPolyData *output)
+{
+  std::set<vtkIdType> used;
+  vtkCellArray *polys = output->GetPolys();
+  vtkIdType npts, *pts;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); )
+  {
+    used.insert(pts, pts + npts);
+  }
+  double error = 0.0;
+  for (std::set<vtkIdType>::iterator it = used.begin(); it != used.end(); ++it)
+  {
+    double x[3];
+    output->GetPoint(*it, x);
+    error += fabs(sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]) - Radius);
+  }
+  return used.empty() ? 0.0 : error / used.size();
+}
+
+int Compare(vtkPolyData *input, double target, int attributeErrorMetric,
+            int volumePreservation, bool sphere, const char *name)
+{
+  vtkNew<vtkQuadricDecimation> serial;
+  vtkNew<vtkQuadricDecimation> parallel;
+  vtkQuadricDecimation *filters[2] = { serial.Get(), parallel.Get() };
+  for (int f = 0; f < 2; ++f)
+  {
+    filters[f]->SetInputData(input);
+    filters[f]->SetTargetReduction(target);
+    filters[f]->SetAttributeErrorMetric(attributeErrorMetric);
+    filters[f]->SetVolumePreservation(volumePreservation);
+    filters[f]->SetParallelCollapse(f);
+    filters[f]->Update();
+    if (!ValidTriangles(filters[f]->GetOutput(), name))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  vtkPolyData *output = parallel->GetOutput();
+  double reduction = parallel->GetActualReduction();
+  vtkIdType numTris = input->GetNumberOfPolys();
+  if (reduction < serial->GetActualReduction() - 0.01 ||
+      reduction > target + 0.01 ||
+      output->GetNumberOfPolys() !=
+        numTris - static_cast<vtkIdType>(reduction * numTris + 0.5))
+  {
+    cerr << "Parallel reduction of " << reduction << " for " << name
+         << " instead of " << serial->GetActualReduction() << endl;
+    return EXIT_FAILURE;
+  }
+
+  // The boundary of the plane and the extent of the spheres are kept.
+  double bounds0[6], bounds1[6], tolerance = sphere ? 0.05 : 1.0e-6;
+  serial->GetOutput()->GetBounds(bounds0);
+  output->GetBounds(bounds1);
+  for (int i = 0; i < 6; ++i)
+  {
+    if (fabs(bounds0[i] - bounds1[i]) > tolerance)
+    {
+      cerr << "Parallel bounds differ for " << name << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (sphere)
+  {
+    double error0 = SphereError(serial->GetOutput());
+    double error1 = SphereError(output);
+    if (error1 > 2.0 * error0 + 1.0e-3 * Radius)
+    {
+      cerr << "Parallel error of " << error1 << " for " << name
+           << " instead of " << error0 << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (attributeErrorMetric)
+  {
+    // The elevation stays within the range of the input.
+    double range0[2], range1[2];
+    input->GetPointData()->GetScalars()->GetRange(range0);
+    output->GetPointData()->GetScalars()->GetRange(range1);
+    if (range1[0] < range0[0] - 1.0e-3 || range1[1] > range0[1] + 1.0e-3)
+    {
+      cerr << "Parallel scalars out of range for " << name << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int TestQuadricDecimationParallel(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkSphereSource> sphereSource;
+  sphereSource->SetRadius(Radius);
+  sphereSource->SetThetaResolution(96);
+  sphereSource->SetPhiResolution(64);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphereSource->GetOutputPort());
+  elevation->SetLowPoint(0, 0, -Radius);
+  elevation->SetHighPoint(0, 0, Radius);
+  elevation->Update();
+  vtkNew<vtkPolyData> sphere;
+  sphere->ShallowCopy(elevation->GetOutput());
+
+  // Open at the equator.
+  sphereSource->SetEndPhi(90);
+  elevation->Update();
+  vtkNew<vtkPolyData> hemisphere;
+  hemisphere->ShallowCopy(elevation->GetOutput());
+
+  vtkNew<vtkPlaneSource> planeSource;
+  planeSource->SetResolution(40, 30);
+  vtkNew<vtkTriangleFilter> triangles;
+  triangles->SetInputConnection(planeSource->GetOutputPort());
+  triangles->Update();
+  vtkPolyData *plane = triangles->GetOutput();
+
+  int status = EXIT_SUCCESS;
+  status |= Compare(sphere.Get(), 0.9, 0, 0, true, "sphere");
+  status |= Compare(sphere.Get(), 0.5, 0, 1, true, "volume preservation");
+  status |= Compare(sphere.Get(), 0.8, 1, 0, true, "attributes");
+  status |= Compare(hemisphere.Get(), 0.8, 1, 0, true, "hemisphere");
+  status |= Compare(plane, 0.9, 0, 0, false, "plane");
+
+  return status;
+}
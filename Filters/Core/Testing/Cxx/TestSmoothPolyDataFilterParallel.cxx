@@ -0,0 +1,296 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSmoothPolyDataFilterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the parallel smoothing of vtkWindowedSincPolyDataFilter against its
+// serial smoothing, and the parallel (Jacobi) smoothing of
+// vtkSmoothPolyDataFilter against a direct computation.
+
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmoothPolyDataFilter.h"
+#include "vtkSMPTools.h"
+#include "vtkWindowedSincPolyDataFilter.h"
+
+#include "TestDataComparison.h"
+
+#include <cmath>
+#include <set>
+
+namespace
+{
+
+const int Res = 24;
+
+// A noisy height field of triangles with a crease along x = Res / 2, a
+// fin sharing an edge of the height field (non-manifold), a polyline and a
+// vertex.
+void MakeSurface(vtkPolyData *surface)
+{
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j <= Res; ++j)
+  {
+    for (int i = 0; i <= Res; ++i)
+    {
+      double z = 0.5 * fabs(i - 0.5 * Res) + 0.2 * sin(1.7 * i * j);
+      points->InsertNextPoint(i + 0.2 * sin(3.1 * j), j, z);
+    }
+  }
+
+  vtkNew<vtkCellArray> polys;
+  const vtkIdType n = Res + 1;
+  for (int j = 0; j < Res; ++j)
+  {
+    for (int i = 0; i < Res; ++i)
+    {
+      vtkIdType p = i + j * n;
+      vtkIdType tri0[3] = { p, p + 1, p + 1 + n };
+      vtkIdType tri1[3] = { p, p + 1 + n, p + n };
+      polys->InsertNextCell(3, tri0);
+      polys->InsertNextCell(3, tri1);
+    }
+  }
+  vtkIdType top = points->InsertNextPoint(4.5, 4.5, 6.0);
+  vtkIdType fin[3] = { 4 + 4 * n, 5 + 5 * n, top };
+  polys->InsertNextCell(3, fin);
+
+  vtkNew<vtkCellArray> lines;
+  lines->InsertNextCell(5);
+  for (int i = 0; i < 5; ++i)
+  {
+    lines->InsertCellPoint(points->InsertNextPoint(i, -2.0 + 0.3 * (i % 2), 0.0));
+  }
+
+  vtkNew<vtkCellArray> verts;
+  vtkIdType vert = 3 + 7 * n;
+  verts->InsertNextCell(1, &vert);
+
+  surface->SetPoints(points.Get());
+  surface->SetVerts(verts.Get());
+  surface->SetLines(lines.Get());
+  surface->SetPolys(polys.Get());
+}
+
+int CompareWindowedSinc(vtkPolyData *surface, int featureEdgeSmoothing,
+                        int boundarySmoothing, int nonManifoldSmoothing,
+                        int normalizeCoordinates)
+{
+  vtkNew<vtkWindowedSincPolyDataFilter> serial;
+  vtkNew<vtkWindowedSincPolyDataFilter> parallel;
+  vtkWindowedSincPolyDataFilter *filters[2] = { serial.Get(), parallel.Get() };
+  for (int f = 0; f < 2; ++f)
+  {
+    filters[f]->SetInputData(surface);
+    filters[f]->SetNumberOfIterations(15);
+    filters[f]->SetFeatureAngle(30.0);
+    filters[f]->SetFeatureEdgeSmoothing(featureEdgeSmoothing);
+    filters[f]->SetBoundarySmoothing(boundarySmoothing);
+    filters[f]->SetNonManifoldSmoothing(nonManifoldSmoothing);
+    filters[f]->SetNormalizeCoordinates(normalizeCoordinates);
+    filters[f]->SetParallelSmoothing(f);
+    filters[f]->Update();
+  }
+
+  if (!vtkTest::SamePolyData(serial->GetOutput(), parallel->GetOutput(),
+                             "the windowed sinc smoothing"))
+  {
+    cerr << "with feature edges " << featureEdgeSmoothing << ", boundary "
+         << boundarySmoothing << ", non-manifold " << nonManifoldSmoothing
+         << ", normalize " << normalizeCoordinates << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+// One Jacobi iteration moves the interior points of the height field toward
+// the mean of their neighbors, and leaves the fixed points alone.
+int CheckOneLaplacianIteration(vtkPolyData *surface)
+{
+  vtkNew<vtkSmoothPolyDataFilter> smoother;
+  smoother->SetInputData(surface);
+  smoother->SetNumberOfIterations(1);
+  smoother->SetRelaxationFactor(0.3);
+  smoother->BoundarySmoothingOff();
+  smoother->ParallelSmoothingOn();
+  smoother->Update();
+  vtkPoints *points = surface->GetPoints();
+  vtkPoints *output = smoother->GetOutput()->GetPoints();
+
+  const vtkIdType n = Res + 1;
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkIdList> ptIds;
+  for (int j = 0; j <= Res; ++j)
+  {
+    for (int i = 0; i <= Res; ++i)
+    {
+      vtkIdType ptId = i + j * n;
+      double x[3], y[3], expected[3];
+      points->GetPoint(ptId, x);
+      output->GetPoint(ptId, y);
+      bool fixed = (i == 0 || j == 0 || i == Res || j == Res ||
+                    ptId == 3 + 7 * n || ptId == 4 + 4 * n ||
+                    ptId == 5 + 5 * n);
+      if (fixed)
+      {
+        expected[0] = x[0];
+        expected[1] = x[1];
+        expected[2] = x[2];
+      }
+      else
+      {
+        std::set<vtkIdType> neighbors;
+        surface->GetPointCells(ptId, cellIds.Get());
+        for (vtkIdType c = 0; c < cellIds->GetNumberOfIds(); ++c)
+        {
+          surface->GetCellPoints(cellIds->GetId(c), ptIds.Get());
+          for (vtkIdType p = 0; p < ptIds->GetNumberOfIds(); ++p)
+          {
+            if (ptIds->GetId(p) != ptId)
+            {
+              neighbors.insert(ptIds->GetId(p));
+            }
+          }
+        }
+        double mean[3] = { 0.0, 0.0, 0.0 };
+        for (std::set<vtkIdType>::iterator itr = neighbors.begin();
+             itr != neighbors.end(); ++itr)
+        {
+          double z[3];
+          points->GetPoint(*itr, z);
+          vtkMath::Add(mean, z, mean);
+        }
+        for (int k = 0; k < 3; ++k)
+        {
+          expected[k] = x[k] + 0.3 * (mean[k] / neighbors.size() - x[k]);
+        }
+      }
+      if (sqrt(vtkMath::Distance2BetweenPoints(y, expected)) > 1e-5)
+      {
+        cerr << "Point " << ptId << " is (" << y[0] << ", " << y[1] << ", "
+             << y[2] << ") expected (" << expected[0] << ", " << expected[1]
+             << ", " << expected[2] << ")" << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+// Over many iterations, the Jacobi and serial iterations end up close.
+int CompareLaplacian(vtkPolyData *surface, int featureEdgeSmoothing,
+                     int dataType)
+{
+  vtkNew<vtkSmoothPolyDataFilter> serial;
+  vtkNew<vtkSmoothPolyDataFilter> parallel;
+  vtkSmoothPolyDataFilter *filters[2] = { serial.Get(), parallel.Get() };
+  for (int f = 0; f < 2; ++f)
+  {
+    filters[f]->SetInputData(surface);
+    filters[f]->SetNumberOfIterations(200);
+    filters[f]->SetRelaxationFactor(0.1);
+    filters[f]->SetFeatureAngle(30.0);
+    filters[f]->SetFeatureEdgeSmoothing(featureEdgeSmoothing);
+    filters[f]->SetOutputPointsPrecision(
+      dataType == VTK_DOUBLE ? vtkAlgorithm::DOUBLE_PRECISION :
+      vtkAlgorithm::SINGLE_PRECISION);
+    filters[f]->SetParallelSmoothing(f);
+    filters[f]->Update();
+  }
+
+  if (parallel->GetOutput()->GetPoints()->GetDataType() != dataType)
+  {
+    cerr << "Wrong output points type." << endl;
+    return EXIT_FAILURE;
+  }
+  if (!vtkTest::SamePolyData(serial->GetOutput(), parallel->GetOutput(),
+                             "the Laplacian smoothing", 0.05))
+  {
+    cerr << "with feature edges " << featureEdgeSmoothing << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+// The convergence test of the Jacobi iterations stops at the same iteration
+// whatever the number of threads.
+int CompareConvergence(vtkPolyData *surface, double convergence)
+{
+  vtkNew<vtkSmoothPolyDataFilter> oneThread;
+  vtkNew<vtkSmoothPolyDataFilter> fourThreads;
+  vtkSmoothPolyDataFilter *filters[2] = { oneThread.Get(), fourThreads.Get() };
+  for (int f = 0; f < 2; ++f)
+  {
+    vtkSMPTools::Initialize(f ? 4 : 1);
+    filters[f]->SetInputData(surface);
+    filters[f]->SetNumberOfIterations(50);
+    filters[f]->SetRelaxationFactor(0.1);
+    filters[f]->SetConvergence(convergence);
+    filters[f]->ParallelSmoothingOn();
+    filters[f]->Update();
+  }
+
+  if (!vtkTest::SamePolyData(oneThread->GetOutput(), fourThreads->GetOutput(),
+                             "the converged smoothing"))
+  {
+    cerr << "with convergence " << convergence << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int TestSmoothPolyDataFilterParallel(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkPolyData> surface;
+  MakeSurface(surface.Get());
+
+  for (int i = 0; i < 16; ++i)
+  {
+    if (CompareWindowedSinc(surface.Get(), i & 1, (i >> 1) & 1, (i >> 2) & 1,
+                            (i >> 3) & 1) != EXIT_SUCCESS)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (CheckOneLaplacianIteration(surface.Get()) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  for (int i = 0; i < 2; ++i)
+  {
+    if (CompareLaplacian(surface.Get(), i, VTK_FLOAT) != EXIT_SUCCESS ||
+        CompareLaplacian(surface.Get(), i, VTK_DOUBLE) != EXIT_SUCCESS)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  const double convergences[4] = { 0.5, 2.0, 3.0, 4.0 };
+  for (int i = 0; i < 4; ++i)
+  {
+    if (CompareConvergence(surface.Get(), convergences[i]) != EXIT_SUCCESS)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
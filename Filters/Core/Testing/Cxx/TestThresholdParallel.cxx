@@ -0,0 +1,191 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThresholdParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkThreshold selects the same cells, with the same points and
+// attributes, with and without ParallelThresholding, and that SelectionOnly
+// produces the ids of these cells.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSMPTools.h"
+#include "vtkStringArray.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "TestDataComparison.h"
+
+#include <cmath>
+
+namespace
+{
+
+const int Res = 12;
+
+// Hexahedra and tetrahedra, with a 3-component int array on the points and
+// a string array on the cells.
+void MakeGrid(vtkUnstructuredGrid *grid)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIntArray> labels;
+  labels->SetName("Labels");
+  labels->SetNumberOfComponents(3);
+  for (int k = 0; k <= Res; ++k)
+  {
+    for (int j = 0; j <= Res; ++j)
+    {
+      for (int i = 0; i <= Res; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+        labels->InsertNextTuple3((i * j) % 7, (j + 2 * k) % 5, i - k);
+      }
+    }
+  }
+  grid->SetPoints(points.Get());
+  grid->GetPointData()->SetScalars(labels.Get());
+
+  vtkNew<vtkStringArray> names;
+  names->SetName("Names");
+  grid->Allocate(2 * Res * Res * Res);
+  const vtkIdType n = Res + 1;
+  for (int k = 0; k < Res; ++k)
+  {
+    for (int j = 0; j < Res; ++j)
+    {
+      for (int i = 0; i < Res; ++i)
+      {
+        vtkIdType p = i + j * n + k * n * n;
+        vtkIdType hex[8] = { p, p + 1, p + 1 + n, p + n, p + n * n,
+                             p + 1 + n * n, p + 1 + n + n * n, p + n + n * n };
+        if ((i + j + k) % 3)
+        {
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+          names->InsertNextValue("hexahedron");
+        }
+        else
+        {
+          vtkIdType tet[4] = { hex[0], hex[1], hex[3], hex[4] };
+          grid->InsertNextCell(VTK_TETRA, 4, tet);
+          names->InsertNextValue("tetrahedron");
+        }
+      }
+    }
+  }
+  grid->GetCellData()->AddArray(names.Get());
+}
+
+// Threshold input with the given settings, serially, in parallel and with
+// SelectionOnly.
+int Compare(vtkDataSet *input, int association, int componentMode,
+            int allScalars, int continuousRange, double lower, double upper)
+{
+  vtkNew<vtkThreshold> serial, parallel, selection;
+  vtkThreshold *filters[3] = { serial.Get(), parallel.Get(), selection.Get() };
+  for (int i = 0; i < 3; ++i)
+  {
+    filters[i]->SetInputData(input);
+    filters[i]->SetInputArrayToProcess(0, 0, 0, association,
+      vtkDataSetAttributes::SCALARS);
+    filters[i]->SetComponentMode(componentMode);
+    filters[i]->SetAllScalars(allScalars);
+    filters[i]->SetUseContinuousCellRange(continuousRange);
+    filters[i]->ThresholdBetween(lower, upper);
+  }
+  parallel->ParallelThresholdingOn();
+  selection->SelectionOnlyOn();
+  for (int i = 0; i < 3; ++i)
+  {
+    filters[i]->Update();
+  }
+
+  vtkUnstructuredGrid *expected = serial->GetOutput();
+  if (expected->GetNumberOfCells() == 0 ||
+      expected->GetNumberOfCells() == input->GetNumberOfCells() ||
+      !vtkTest::SameCellsByPoints(expected, parallel->GetOutput(),
+                                  "the parallel thresholding"))
+  {
+    cerr << "Parallel thresholding in [" << lower << ", " << upper << "]: "
+         << parallel->GetOutput()->GetNumberOfCells() << " cells, expected "
+         << expected->GetNumberOfCells() << " (of "
+         << input->GetNumberOfCells() << ")" << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkIdTypeArray *cellIds = vtkIdTypeArray::SafeDownCast(
+    selection->GetOutput()->GetFieldData()->GetArray("vtkOriginalCellIds"));
+  if (!cellIds || selection->GetOutput()->GetNumberOfCells() != 0 ||
+      cellIds->GetNumberOfTuples() != expected->GetNumberOfCells())
+  {
+    cerr << "Selection only: wrong cell ids." << endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < cellIds->GetNumberOfTuples(); ++i)
+  {
+    if (input->GetCellType(cellIds->GetValue(i)) != expected->GetCellType(i) ||
+        (i > 0 && cellIds->GetValue(i) <= cellIds->GetValue(i - 1)))
+    {
+      cerr << "Selection only: wrong cell id " << cellIds->GetValue(i) << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int TestThresholdParallel(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-8, 8, -8, 8, -8, 8);
+  source->Update();
+  vtkImageData *image = source->GetOutput();
+  const int points = vtkDataObject::FIELD_ASSOCIATION_POINTS;
+  const int cells = vtkDataObject::FIELD_ASSOCIATION_CELLS;
+  if (Compare(image, points, VTK_COMPONENT_MODE_USE_SELECTED, 1, 0, 100, 200) ||
+      Compare(image, points, VTK_COMPONENT_MODE_USE_SELECTED, 0, 0, 100, 200) ||
+      Compare(image, points, VTK_COMPONENT_MODE_USE_SELECTED, 0, 1, 150, 150))
+  {
+    cerr << "Failure with the image." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid.Get());
+  vtkNew<vtkIntArray> cellScalars;
+  cellScalars->SetName("CellScalars");
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+  {
+    cellScalars->InsertNextValue(static_cast<int>((i * 13) % 17));
+  }
+  grid->GetCellData()->SetScalars(cellScalars.Get());
+  if (Compare(grid.Get(), points, VTK_COMPONENT_MODE_USE_ANY, 1, 0, 5, 6) ||
+      Compare(grid.Get(), points, VTK_COMPONENT_MODE_USE_ALL, 0, 0, 0, 4) ||
+      Compare(grid.Get(), points, VTK_COMPONENT_MODE_USE_ANY, 0, 1, 6.5, 6.5) ||
+      Compare(grid.Get(), cells, VTK_COMPONENT_MODE_USE_SELECTED, 1, 0, 3, 9))
+  {
+    cerr << "Failure with the unstructured grid." << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -21,16 +21,20 @@
 #include "vtkCellData.h"
 #include "vtkDataArrayAccessor.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTrivialProducer.h"
 
 #include <cassert>
 #include <cstdlib>
+#include <vector>
 
 vtkStandardNewMacro(vtkAppendPolyData);
 
@@ -38,6 +42,7 @@ vtkStandardNewMacro(vtkAppendPolyData);
 vtkAppendPolyData::vtkAppendPolyData()
 {
   this->ParallelStreaming = 0;
+  this->MergePoints = 0;
   this->UserManagedInputs = 0;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
 }
@@ -566,6 +571,24 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output,
   }
   newStrips->Delete();
 
+  if (this->MergePoints)
+  {
+    // Points are not merged if there are ghost cells, as vtkAppendFilter.
+    bool hasGhostCells = false;
+    for (idx = 0; idx < numInputs && !hasGhostCells; ++idx)
+    {
+      hasGhostCells = inputs[idx] != NULL && inputs[idx]->HasAnyGhostCells();
+    }
+    if (hasGhostCells)
+    {
+      vtkDebugMacro(<< "Ghost cells present, so points will not be merged");
+    }
+    else
+    {
+      this->MergeCoincidentPoints(output);
+    }
+  }
+
   // When all optimizations are complete, this squeeze will be unnecessary.
   // (But it does not seem to cost much.)
   output->Squeeze();
@@ -585,7 +608,7 @@ int vtkAppendPolyData::RequestData(vtkInformation *vtkNotUsed(request),
   vtkPolyData *output = vtkPolyData::GetData(outputVector, 0);
 
   int numInputs = inputVector[0]->GetNumberOfInformationObjects();
-  if (numInputs == 1)
+  if (numInputs == 1 && !this->MergePoints)
   {
     output->ShallowCopy(vtkPolyData::GetData(inputVector[0], 0));
     return 1;
@@ -686,6 +709,7 @@ void vtkAppendPolyData::PrintSelf(ostream& os, vtkIndent indent)
 
   os << "ParallelStreaming:" << (this->ParallelStreaming?"On":"Off") << endl;
   os << "UserManagedInputs:" << (this->UserManagedInputs?"On":"Off") << endl;
+  os << "MergePoints:" << (this->MergePoints?"On":"Off") << endl;
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision
      << endl;
 }
@@ -771,6 +795,89 @@ vtkIdType *vtkAppendPolyData::AppendCells(vtkIdType *pDest, vtkCellArray *src,
   return pDest;
 }
 
+//----------------------------------------------------------------------------
+// Replace the point ids of the cells by their merged ids.
+static void MergeCellPoints(vtkCellArray *cells, const vtkIdType *pointMap)
+{
+  if (cells == NULL)
+  {
+    return;
+  }
+
+  vtkIdType *pCells = cells->GetPointer();
+  vtkIdType *end = pCells + cells->GetNumberOfConnectivityEntries();
+  vtkIdType *pCellEnd;
+  while (pCells < end)
+  {
+    pCellEnd = pCells + 1 + *pCells;
+    for (++pCells; pCells < pCellEnd; ++pCells)
+    {
+      *pCells = pointMap[*pCells];
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// The coincident points are merged with a vtkStaticPointLocator (in
+// parallel) to the point of smallest id, so the points kept are numbered in
+// the order they are appended.
+void vtkAppendPolyData::MergeCoincidentPoints(vtkPolyData *output)
+{
+  vtkIdType numPts = output->GetNumberOfPoints();
+  if (numPts < 2)
+  {
+    return;
+  }
+
+  std::vector<vtkIdType> pointMap(numPts);
+  vtkStaticPointLocator *locator = vtkStaticPointLocator::New();
+  locator->SetDataSet(output);
+  locator->BuildLocator();
+  locator->MergePoints(0.0, &pointMap[0]);
+  locator->Delete();
+
+  vtkIdList *keptIds = vtkIdList::New();
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (pointMap[ptId] == ptId)
+    {
+      pointMap[ptId] = keptIds->InsertNextId(ptId);
+    }
+    else
+    {
+      pointMap[ptId] = pointMap[pointMap[ptId]];
+    }
+  }
+  vtkIdType numKept = keptIds->GetNumberOfIds();
+  if (numKept == numPts)
+  {
+    keptIds->Delete();
+    return;
+  }
+
+  vtkPoints *newPts = output->GetPoints()->NewInstance();
+  newPts->SetDataType(output->GetPoints()->GetDataType());
+  output->GetPoints()->GetPoints(keptIds, newPts);
+  output->SetPoints(newPts);
+  newPts->Delete();
+
+  vtkPointData *outputPD = output->GetPointData();
+  vtkPointData *newPD = vtkPointData::New();
+  newPD->CopyAllocate(outputPD, numKept);
+  for (vtkIdType ptId = 0; ptId < numKept; ++ptId)
+  {
+    newPD->CopyData(outputPD, keptIds->GetId(ptId), ptId);
+  }
+  outputPD->ShallowCopy(newPD);
+  newPD->Delete();
+  keptIds->Delete();
+
+  MergeCellPoints(output->GetVerts(), &pointMap[0]);
+  MergeCellPoints(output->GetLines(), &pointMap[0]);
+  MergeCellPoints(output->GetPolys(), &pointMap[0]);
+  MergeCellPoints(output->GetStrips(), &pointMap[0]);
+}
+
 //----------------------------------------------------------------------------
 int vtkAppendPolyData::FillInputPortInformation(int port, vtkInformation *info)
 {
@@ -105,6 +105,20 @@ public:
   vtkBooleanMacro(ParallelStreaming, int);
   //@}
 
+  //@{
+  /**
+   * Set/get whether the points with the same coordinates are merged after
+   * appending the inputs, as vtkAppendFilter does. The points are merged in
+   * parallel with a vtkStaticPointLocator, and the points kept are numbered
+   * in the order they are appended. Unlike vtkCleanPolyData, the unused
+   * points and the degenerate cells are kept. The points are not merged if
+   * an input has ghost cells. Defaults to Off.
+   */
+  vtkSetMacro(MergePoints, int);
+  vtkGetMacro(MergePoints, int);
+  vtkBooleanMacro(MergePoints, int);
+  //@}
+
   //@{
   /**
    * Set/get the desired precision for the output types. See the documentation
@@ -124,6 +138,7 @@ protected:
 
   // Flag for selecting parallel streaming behavior
   int ParallelStreaming;
+  int MergePoints;
   int OutputPointsPrecision;
 
   // Usual data generation method
@@ -141,6 +156,9 @@ protected:
   vtkIdType *AppendCells(vtkIdType *pDest, vtkCellArray *src,
                          vtkIdType offset);
 
+  // Merge the coincident points of the appended output.
+  void MergeCoincidentPoints(vtkPolyData *output);
+
  private:
   // hide the superclass' AddInput() from the user and the compiler
   void AddInputData(vtkDataObject *)
@@ -0,0 +1,242 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAttributeAveragerTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkAttributeAveragerTemplate
+ * @brief   average attribute arrays from within threads
+ *
+ * vtkAttributeAveragerTemplate.h provides internal helpers that set the
+ * tuples of a set of output arrays to the mean (or a copy) of tuples of the
+ * corresponding input arrays. The array pairs are taken from a
+ * vtkDataSetAttributes::FieldList once, and each pair is dispatched to its
+ * concrete array types with vtkArrayDispatch so that the per-tuple work is a
+ * plain loop. The output arrays are sized up front, so distinct output
+ * tuples may then be written concurrently (e.g., in a vtkSMPTools functor).
+ * Arrays that are not vtkDataArrays (e.g., string arrays) are not averaged
+ * in place; they are kept aside for the serial InterpolateOther() and
+ * CopyOther() methods.
+ *
+ * @sa
+ * vtkCellDataToPointData vtkPointDataToCellData vtkArrayListTemplate
+*/
+
+#ifndef vtkAttributeAveragerTemplate_h
+#define vtkAttributeAveragerTemplate_h
+
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayAccessor.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+
+#include <utility>
+#include <vector>
+
+// Type-erased interface of an input/output array pair.
+struct vtkAttributeAverager
+{
+  virtual ~vtkAttributeAverager() {}
+
+  // Set the output tuple outId to the mean of the input tuples ids[0,n),
+  // accumulated in double precision and rounded for integral types, as
+  // vtkDataArray::InterpolateTuple() does with equal weights.
+  virtual void Interpolate(vtkIdType n, const vtkIdType *ids,
+                           vtkIdType outId) = 0;
+
+  // Same as Interpolate(), but with the sum and the division carried out in
+  // the value type of the arrays. A null output tuple is set if n is 0.
+  virtual void Average(vtkIdType n, const vtkIdType *ids, vtkIdType outId) = 0;
+
+  // Copy the input tuple inId to the output tuple outId.
+  virtual void Copy(vtkIdType inId, vtkIdType outId) = 0;
+};
+
+// The concrete array pairs.
+template <typename InArrayT, typename OutArrayT>
+struct vtkAttributeAveragerPair : public vtkAttributeAverager
+{
+  typedef typename vtkDataArrayAccessor<OutArrayT>::APIType ValueType;
+
+  InArrayT *Input;
+  OutArrayT *Output;
+  int NumComps;
+
+  vtkAttributeAveragerPair(InArrayT *input, OutArrayT *output) :
+    Input(input), Output(output),
+    NumComps(output->GetNumberOfComponents())
+  {
+  }
+
+  void Interpolate(vtkIdType n, const vtkIdType *ids,
+                   vtkIdType outId) VTK_OVERRIDE
+  {
+    vtkDataArrayAccessor<InArrayT> in(this->Input);
+    vtkDataArrayAccessor<OutArrayT> out(this->Output);
+    double weight = 1.0 / n;
+    for (int c = 0; c < this->NumComps; ++c)
+    {
+      double val = 0.0;
+      for (vtkIdType i = 0; i < n; ++i)
+      {
+        val += weight * static_cast<double>(in.Get(ids[i], c));
+      }
+      ValueType valT;
+      vtkMath::RoundDoubleToIntegralIfNecessary(val, &valT);
+      out.Set(outId, c, valT);
+    }
+  }
+
+  void Average(vtkIdType n, const vtkIdType *ids, vtkIdType outId) VTK_OVERRIDE
+  {
+    vtkDataArrayAccessor<InArrayT> in(this->Input);
+    vtkDataArrayAccessor<OutArrayT> out(this->Output);
+    for (int c = 0; c < this->NumComps; ++c)
+    {
+      ValueType sum = static_cast<ValueType>(0);
+      for (vtkIdType i = 0; i < n; ++i)
+      {
+        sum = static_cast<ValueType>(sum + in.Get(ids[i], c));
+      }
+      if (n > 0)
+      {
+        sum = static_cast<ValueType>(sum / static_cast<ValueType>(n));
+      }
+      out.Set(outId, c, sum);
+    }
+  }
+
+  void Copy(vtkIdType inId, vtkIdType outId) VTK_OVERRIDE
+  {
+    vtkDataArrayAccessor<InArrayT> in(this->Input);
+    vtkDataArrayAccessor<OutArrayT> out(this->Output);
+    for (int c = 0; c < this->NumComps; ++c)
+    {
+      out.Set(outId, c, static_cast<ValueType>(in.Get(inId, c)));
+    }
+  }
+};
+
+// vtkArrayDispatch worker creating the array pairs.
+struct vtkAttributeAveragerMaker
+{
+  std::vector<vtkAttributeAverager*> *Averagers;
+
+  template <typename InArrayT, typename OutArrayT>
+  void operator()(InArrayT *input, OutArrayT *output)
+  {
+    this->Averagers->push_back(
+      new vtkAttributeAveragerPair<InArrayT,OutArrayT>(input, output));
+  }
+};
+
+// The list of the array pairs of a vtkDataSetAttributes.
+struct vtkAttributeAveragerList
+{
+  std::vector<vtkAttributeAverager*> Averagers;
+  std::vector<std::pair<vtkAbstractArray*,vtkAbstractArray*> > Others;
+
+  vtkAttributeAveragerList() {}
+
+  ~vtkAttributeAveragerList()
+  {
+    for (size_t i = 0; i < this->Averagers.size(); ++i)
+    {
+      delete this->Averagers[i];
+    }
+  }
+
+  // Add the pairs of the fields of list, whose input arrays are in inDA and
+  // output arrays in outDA (as allocated by InterpolateAllocate() or
+  // CopyAllocate() with list). The output arrays are resized to numOutTuples.
+  void AddArrays(vtkDataSetAttributes::FieldList &list,
+                 vtkDataSetAttributes *inDA, vtkDataSetAttributes *outDA,
+                 vtkIdType numOutTuples)
+  {
+    vtkAttributeAveragerMaker maker;
+    maker.Averagers = &this->Averagers;
+    for (int i = 0, n = list.GetNumberOfFields(); i < n; ++i)
+    {
+      int outIdx = list.GetFieldIndex(i);
+      int inIdx = list.GetDSAIndex(0, i);
+      if (outIdx < 0 || inIdx < 0)
+      {
+        continue;
+      }
+      vtkAbstractArray *input = inDA->GetAbstractArray(inIdx);
+      vtkAbstractArray *output = outDA->GetAbstractArray(outIdx);
+      output->SetNumberOfTuples(numOutTuples);
+      vtkDataArray *inArray = vtkArrayDownCast<vtkDataArray>(input);
+      vtkDataArray *outArray = vtkArrayDownCast<vtkDataArray>(output);
+      if (!inArray || !outArray)
+      {
+        this->Others.push_back(std::make_pair(input, output));
+      }
+      else if (!vtkArrayDispatch::Dispatch2SameValueType::Execute(
+                 inArray, outArray, maker))
+      {
+        maker(inArray, outArray);
+      }
+    }
+  }
+
+  void Interpolate(vtkIdType n, const vtkIdType *ids, vtkIdType outId)
+  {
+    for (size_t i = 0; i < this->Averagers.size(); ++i)
+    {
+      this->Averagers[i]->Interpolate(n, ids, outId);
+    }
+  }
+
+  void Average(vtkIdType n, const vtkIdType *ids, vtkIdType outId)
+  {
+    for (size_t i = 0; i < this->Averagers.size(); ++i)
+    {
+      this->Averagers[i]->Average(n, ids, outId);
+    }
+  }
+
+  void Copy(vtkIdType inId, vtkIdType outId)
+  {
+    for (size_t i = 0; i < this->Averagers.size(); ++i)
+    {
+      this->Averagers[i]->Copy(inId, outId);
+    }
+  }
+
+  // Serial counterparts of Interpolate() and Copy() for the arrays that are
+  // not vtkDataArrays.
+  void InterpolateOther(vtkIdList *ids, double *weights, vtkIdType outId)
+  {
+    for (size_t i = 0; i < this->Others.size(); ++i)
+    {
+      this->Others[i].second->InterpolateTuple(outId, ids,
+                                               this->Others[i].first, weights);
+    }
+  }
+
+  void CopyOther(vtkIdType inId, vtkIdType outId)
+  {
+    for (size_t i = 0; i < this->Others.size(); ++i)
+    {
+      this->Others[i].second->InsertTuple(outId, inId, this->Others[i].first);
+    }
+  }
+
+private:
+  vtkAttributeAveragerList(const vtkAttributeAveragerList&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkAttributeAveragerList&) VTK_DELETE_FUNCTION;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkAttributeAveragerTemplate.h
@@ -14,6 +14,8 @@
 =========================================================================*/
 #include "vtkCellDataToPointData.h"
 
+#include "vtkAttributeAveragerTemplate.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCell.h"
 #include "vtkDataSet.h"
@@ -23,13 +25,16 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPAlgorithmProgress.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLinksTemplate.h"
 #include "vtkStructuredGrid.h"
-#include "vtkUnsignedIntArray.h"
 #include "vtkUnstructuredGrid.h"
 
-#include <algorithm>
-#include <functional>
+#include <vector>
 
 #define VTK_MAX_CELLS_PER_POINT 4096
 
@@ -112,52 +117,119 @@ void vtkCellDataToPointData::PrintSelf(ostream& os, vtkIndent indent)
 }
 
 //----------------------------------------------------------------------------
-// Helper template function that implement the major part of the algorighm
-// which will be expanded by the vtkTemplateMacro. The template function is
-// provided so that coverage test can cover this function.
+// Helper functors that average the cell data onto the points, one range of
+// points per thread. All the arrays are processed together for each point.
+// The progress is counted, and the abort checked, for each range of points.
 namespace
 {
-  template <typename T>
-  void __spread (vtkUnstructuredGrid* const src, vtkUnsignedIntArray* const num,
-             vtkDataArray* const srcarray, vtkDataArray* const dstarray,
-             vtkIdType ncells, vtkIdType npoints, vtkIdType ncomps)
+  // Unstructured grids: the cells of the points are read from static links.
+  template <typename TIds>
+  struct AverageCellsToPoints
   {
-    T const* const srcptr = static_cast<T const*>(srcarray->GetVoidPointer(0));
-    T      * const dstptr = static_cast<T      *>(dstarray->GetVoidPointer(0));
-
-    // zero initialization
-    std::fill_n(dstptr, npoints*ncomps, T(0));
+    vtkStaticCellLinksTemplate<TIds> *Links;
+    vtkAttributeAveragerList *Arrays;
+    vtkSMPAlgorithmProgress *Progress;
+    vtkSMPThreadLocal<std::vector<vtkIdType> > CellIds;
+
+    AverageCellsToPoints(vtkStaticCellLinksTemplate<TIds> *links,
+                         vtkAttributeAveragerList *arrays,
+                         vtkSMPAlgorithmProgress *progress) :
+      Links(links), Arrays(arrays), Progress(progress)
+    {
+    }
 
-    // accumulate
-    T const* srcbeg = srcptr;
-    vtkNew<vtkIdList> pids;
-    for (vtkIdType cid = 0; cid < ncells; ++cid, srcbeg += ncomps)
+    void operator()(vtkIdType begin, vtkIdType end)
     {
-      src->GetCellPoints(cid, pids.GetPointer());
-      for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
+      if (this->Progress->IsAborted())
       {
-        T* const dstbeg = dstptr + pids->GetId(i)*ncomps;
-        // accumulate cell data to point data <==> point_data += cell_data
-        std::transform(srcbeg,srcbeg+ncomps,dstbeg,dstbeg,std::plus<T>());
+        return;
       }
+      std::vector<vtkIdType> &cellIds = this->CellIds.Local();
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        vtkIdType numCells = this->Links->GetNumberOfCells(ptId);
+        const TIds *cells = this->Links->GetCells(ptId);
+        // The links list the cells in decreasing order: accumulate them in
+        // increasing order, as a serial scatter over the cells would.
+        cellIds.resize(numCells + 1);
+        for (vtkIdType i = 0; i < numCells; ++i)
+        {
+          cellIds[i] = cells[numCells - 1 - i];
+        }
+        this->Arrays->Average(numCells, &cellIds[0], ptId);
+      }
+      this->Progress->Advance(end - begin);
     }
+  };
+
+  template <typename TIds>
+  void AverageCellData(vtkUnstructuredGrid *input,
+                       vtkAttributeAveragerList *arrays,
+                       vtkSMPAlgorithmProgress *progress)
+  {
+    vtkStaticCellLinksTemplate<TIds> links;
+    links.BuildLinks(input);
+    AverageCellsToPoints<TIds> average(&links, arrays, progress);
+    vtkIdType numPts = input->GetNumberOfPoints();
+    vtkSMPTools::For(0, numPts, numPts / 100 + 1, average);
+  }
 
-    // average
-    T* dstbeg = dstptr;
-    for (vtkIdType pid = 0; pid < npoints; ++pid, dstbeg += ncomps)
+  // Other datasets: the cells of the points are given by GetPointCells(),
+  // minus the blanked cells of a structured grid if needed. The points
+  // without cells (or with too many of them) are flagged to be nulled.
+  struct InterpolateCellsToPoints
+  {
+    vtkDataSet *Input;
+    vtkStructuredGrid *Mask;
+    vtkAttributeAveragerList *Arrays;
+    unsigned char *NullPoints;
+    vtkSMPAlgorithmProgress *Progress;
+    vtkSMPThreadLocalObject<vtkIdList> AllCellIds;
+    vtkSMPThreadLocalObject<vtkIdList> CellIds;
+
+    void operator()(vtkIdType begin, vtkIdType end)
     {
-      // guard against divide by zero
-      if (unsigned int const denum = num->GetValue(pid))
+      if (this->Progress->IsAborted())
       {
-        // divide point data by the number of cells using it <==>
-        // point_data /= denum
-        std::transform(dstbeg, dstbeg+ncomps, dstbeg,
-          std::bind2nd(std::divides<T>(), denum));
+        return;
       }
+      vtkIdList *allCellIds = this->AllCellIds.Local();
+      vtkIdList *cellIds = this->CellIds.Local();
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        if (!this->Mask)
+        {
+          this->Input->GetPointCells(ptId, cellIds);
+        }
+        else
+        {
+          this->Input->GetPointCells(ptId, allCellIds);
+          cellIds->Reset();
+          for (vtkIdType i = 0; i < allCellIds->GetNumberOfIds(); ++i)
+          {
+            vtkIdType cellId = allCellIds->GetId(i);
+            if (this->Mask->IsCellVisible(cellId))
+            {
+              cellIds->InsertNextId(cellId);
+            }
+          }
+        }
+
+        vtkIdType numCells = cellIds->GetNumberOfIds();
+        if (numCells > 0 && numCells < VTK_MAX_CELLS_PER_POINT)
+        {
+          this->Arrays->Interpolate(numCells, cellIds->GetPointer(0), ptId);
+          this->NullPoints[ptId] = 0;
+        }
+        else
+        {
+          this->NullPoints[ptId] = 1;
+        }
+      }
+      this->Progress->Advance(end - begin);
     }
-  }
+  };
 }
-
 //----------------------------------------------------------------------------
 int vtkCellDataToPointData::RequestDataForUnstructuredGrid
   (vtkInformation*,
@@ -177,23 +249,6 @@ int vtkCellDataToPointData::RequestDataForUnstructuredGrid
     return 1;
   }
 
-  // count the number of cells associated with each point
-  vtkSmartPointer<vtkUnsignedIntArray> num
-    = vtkSmartPointer<vtkUnsignedIntArray>::New();
-  num->SetNumberOfComponents(1);
-  num->SetNumberOfTuples(npoints);
-  std::fill_n(num->GetPointer(0), npoints, 0u);
-  vtkNew<vtkIdList> pids;
-  for (vtkIdType cid = 0; cid < ncells; ++cid)
-  {
-    src->GetCellPoints(cid, pids.GetPointer());
-    for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
-    {
-      vtkIdType const pid = pids->GetId(i);
-      num->SetValue(pid, num->GetValue(pid)+1);
-    }
-  }
-
   // First, copy the input to the output as a starting point
   dst->CopyStructure(src);
   vtkPointData* const opd = dst->GetPointData();
@@ -223,42 +278,20 @@ int vtkCellDataToPointData::RequestDataForUnstructuredGrid
   cfl.InitializeFieldList(clean);
   opd->InterpolateAllocate(cfl, npoints, npoints);
 
-  for (int fid = 0, nfields = cfl.GetNumberOfFields(); fid < nfields; ++fid)
-  {
-    // update progress and check for an abort request.
-    this->UpdateProgress((fid+1.)/nfields);
-    if (this->GetAbortExecute())
-    {
-      break;
-    }
-
-    // indices into the field arrays associated with the cell and the point
-    // respectively
-    int const dstid = cfl.GetFieldIndex(fid);
-    int const srcid = cfl.GetDSAIndex(0,fid);
-    if  (srcid < 0 || dstid < 0)
-    {
-      continue;
-    }
-
-    vtkCellData * const srccelldata  = clean;
-    vtkPointData* const dstpointdata = dst->GetPointData();
-
-    if (!srccelldata || !dstpointdata)
-    {
-      continue;
-    }
-
-    vtkDataArray* const srcarray = srccelldata ->GetArray(srcid);
-    vtkDataArray* const dstarray = dstpointdata->GetArray(dstid);
-    dstarray->SetNumberOfTuples(npoints);
+  vtkAttributeAveragerList arrays;
+  arrays.AddArrays(cfl, clean, opd, npoints);
 
-    vtkIdType const ncomps = srcarray->GetNumberOfComponents();
-    switch (srcarray->GetDataType())
-    {
-      vtkTemplateMacro
-        (__spread<VTK_TT>(src,num,srcarray,dstarray,ncells,npoints,ncomps));
-    }
+  // Average all the arrays at once, one range of points per thread.
+  vtkSMPAlgorithmProgress progress(this, npoints);
+  vtkCellArray *cells = src->GetCells();
+  if (cells->GetNumberOfConnectivityEntries() < VTK_INT_MAX &&
+      npoints < VTK_INT_MAX)
+  {
+    AverageCellData<int>(src, &arrays, &progress);
+  }
+  else
+  {
+    AverageCellData<vtkIdType>(src, &arrays, &progress);
   }
 
   if (!this->PassCellData)
@@ -270,103 +303,92 @@ int vtkCellDataToPointData::RequestDataForUnstructuredGrid
 
   return 1;
 }
-
+//----------------------------------------------------------------------------
 void vtkCellDataToPointData::interpolatePointData(vtkDataSet *input,
                                                   vtkDataSet *output)
 {
-  vtkNew<vtkIdList> cellIds;
-  cellIds->Allocate(VTK_MAX_CELLS_PER_POINT);
-
-  vtkIdType numPts = input->GetNumberOfPoints();
-
-  vtkCellData *inCD = input->GetCellData();
-  vtkPointData *outPD = output->GetPointData();
-  outPD->InterpolateAllocate(inCD,numPts);
-
-  std::vector<double> weights(VTK_MAX_CELLS_PER_POINT);
-
-  int abort = 0;
-  vtkIdType progressInterval = numPts / 20 + 1;
-  for (vtkIdType ptId = 0; ptId < numPts && !abort; ptId++)
-  {
-    if ( !(ptId % progressInterval) )
-    {
-      this->UpdateProgress(static_cast<double>(ptId)/numPts);
-      abort = GetAbortExecute();
-    }
-
-    input->GetPointCells(ptId, cellIds.GetPointer());
-    vtkIdType numCells = cellIds->GetNumberOfIds();
-
-    if ( numCells > 0 && numCells < VTK_MAX_CELLS_PER_POINT )
-    {
-      double weight = 1.0 / numCells;
-      for (vtkIdType cellId = 0; cellId < numCells; cellId++)
-      {
-        weights[cellId] = weight;
-      }
-      outPD->InterpolatePoint(inCD, ptId, cellIds.GetPointer(), &weights[0]);
-    }
-    else
-    {
-      outPD->NullPoint(ptId);
-    }
-  }
+  this->InterpolatePointData(input, NULL, output);
 }
 
+//----------------------------------------------------------------------------
 void vtkCellDataToPointData::interpolatePointDataWithMask(
     vtkStructuredGrid *input, vtkDataSet *output)
 {
-  vtkNew<vtkIdList> allCellIds;
-  allCellIds->Allocate(VTK_MAX_CELLS_PER_POINT);
-  vtkNew<vtkIdList> cellIds;
-  cellIds->Allocate(VTK_MAX_CELLS_PER_POINT);
+  this->InterpolatePointData(input, input, output);
+}
 
+//----------------------------------------------------------------------------
+void vtkCellDataToPointData::InterpolatePointData(vtkDataSet *input,
+                                                  vtkStructuredGrid *mask,
+                                                  vtkDataSet *output)
+{
   vtkIdType numPts = input->GetNumberOfPoints();
 
   vtkCellData *inCD = input->GetCellData();
   vtkPointData *outPD = output->GetPointData();
-  outPD->InterpolateAllocate(inCD,numPts);
+  vtkDataSetAttributes::FieldList cfl(1);
+  cfl.InitializeFieldList(inCD);
+  outPD->InterpolateAllocate(cfl, numPts, numPts);
 
-  std::vector<double> weights(VTK_MAX_CELLS_PER_POINT);
+  vtkAttributeAveragerList arrays;
+  arrays.AddArrays(cfl, inCD, outPD, numPts);
+
+  // GetPointCells() and IsCellVisible() are thread safe once they have been
+  // called from a single thread.
+  vtkNew<vtkIdList> cellIds;
+  cellIds->Allocate(VTK_MAX_CELLS_PER_POINT);
+  input->GetPointCells(0, cellIds.GetPointer());
+  if (mask && mask->GetNumberOfCells() > 0)
+  {
+    mask->IsCellVisible(0);
+  }
 
-  int abort = 0;
-  vtkIdType progressInterval = numPts / 20 + 1;
-  for (vtkIdType ptId = 0; ptId < numPts && !abort; ptId++)
+  std::vector<unsigned char> nullPoints(numPts);
+  vtkSMPAlgorithmProgress progress(this, numPts, 0.0, 0.9);
+  InterpolateCellsToPoints interpolate;
+  interpolate.Input = input;
+  interpolate.Mask = mask;
+  interpolate.Arrays = &arrays;
+  interpolate.NullPoints = &nullPoints[0];
+  interpolate.Progress = &progress;
+  vtkSMPTools::For(0, numPts, numPts / 100 + 1, interpolate);
+  if (progress.IsAborted())
   {
-    if ( !(ptId % progressInterval) )
+    return;
+  }
+
+  // Null the points without cells, and interpolate the arrays that are not
+  // data arrays (serially, these are rare).
+  std::vector<double> weights(VTK_MAX_CELLS_PER_POINT);
+  vtkNew<vtkIdList> allCellIds;
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+  {
+    if (nullPoints[ptId])
+    {
+      outPD->NullPoint(ptId);
+      continue;
+    }
+    if (arrays.Others.empty())
     {
-      this->UpdateProgress(static_cast<double>(ptId)/numPts);
-      abort = GetAbortExecute();
+      continue;
     }
 
     input->GetPointCells(ptId, allCellIds.GetPointer());
     cellIds->Reset();
-    // Only consider cells that are not masked:
-    for (vtkIdType cId = 0; cId < allCellIds->GetNumberOfIds(); ++cId)
+    for (vtkIdType i = 0; i < allCellIds->GetNumberOfIds(); ++i)
     {
-      vtkIdType curCell = allCellIds->GetId(cId);
-      if (input->IsCellVisible(curCell))
+      vtkIdType cellId = allCellIds->GetId(i);
+      if (!mask || mask->IsCellVisible(cellId))
       {
-        cellIds->InsertNextId(curCell);
+        cellIds->InsertNextId(cellId);
       }
     }
-
     vtkIdType numCells = cellIds->GetNumberOfIds();
-
-    if ( numCells > 0 && numCells < VTK_MAX_CELLS_PER_POINT )
+    double weight = 1.0 / numCells;
+    for (vtkIdType i = 0; i < numCells; i++)
     {
-      double weight = 1.0 / numCells;
-      for (vtkIdType cellId = 0; cellId < numCells; cellId++)
-      {
-        weights[cellId] = weight;
-      }
-      outPD->InterpolatePoint(inCD, ptId, cellIds.GetPointer(), &weights[0]);
-    }
-    else
-    {
-      outPD->NullPoint(ptId);
+      weights[i] = weight;
     }
+    arrays.InterpolateOther(cellIds.GetPointer(), &weights[0], ptId);
   }
 }
-
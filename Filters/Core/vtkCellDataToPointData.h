@@ -23,6 +23,11 @@
  * data can be passed through to the output as well.
  *
  * @warning
+ * The averaging is threaded with vtkSMPTools: all the cell arrays are
+ * averaged together over ranges of points. Unstructured grids use static
+ * point-to-cell links (vtkStaticCellLinksTemplate) built once per execution.
+ *
+ * @warning
  * This filter is an abstract filter, that is, the output is an abstract type
  * (i.e., vtkDataSet). Use the convenience methods (e.g.,
  * GetPolyDataOutput(), GetStructuredPointsOutput(), etc.) to get the type
@@ -76,6 +81,11 @@ protected:
   void interpolatePointDataWithMask(vtkStructuredGrid *input,
                                     vtkDataSet *output);
 
+  // Threaded implementation of the two methods above: the cells of each
+  // point are those of GetPointCells() that are visible in mask (if any).
+  void InterpolatePointData(vtkDataSet *input, vtkStructuredGrid *mask,
+                            vtkDataSet *output);
+
   int PassCellData;
 private:
   vtkCellDataToPointData(const vtkCellDataToPointData&) VTK_DELETE_FUNCTION;
@@ -16,15 +16,24 @@
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkMergePoints.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkIncrementalPointLocator.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkCleanPolyData);
 
 //---------------------------------------------------------------------------
@@ -37,6 +46,7 @@ vtkCxxSetObjectMacro(vtkCleanPolyData,Locator,vtkIncrementalPointLocator);
 vtkCleanPolyData::vtkCleanPolyData()
 {
   this->PointMerging = 1;
+  this->ParallelPointMerging = 0;
   this->ToleranceIsAbsolute  = 0;
   this->Tolerance            = 0.0;
   this->AbsoluteTolerance    = 1.0;
@@ -73,6 +83,36 @@ void vtkCleanPolyData::OperateOnBounds(double in[6], double out[6])
   out[5] = in[5];
 }
 
+//--------------------------------------------------------------------------
+// Compute the point each point of the input is merged to, with a static
+// point locator built over the points transformed by OperateOnPoint(),
+// which are returned in mappedPts.
+void vtkCleanPolyData::MergePointsInParallel(vtkPolyData *input,
+                                             vtkPoints *mappedPts,
+                                             vtkIdType *mergeMap)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPoints *inPts = input->GetPoints();
+  mappedPts->SetDataTypeToDouble();
+  mappedPts->SetNumberOfPoints(numPts);
+  double x[3], newx[3];
+  for ( vtkIdType ptId=0; ptId < numPts; ptId++ )
+  {
+    inPts->GetPoint(ptId, x);
+    this->OperateOnPoint(x, newx);
+    mappedPts->SetPoint(ptId, newx);
+  }
+
+  vtkNew<vtkPolyData> mapped;
+  mapped->SetPoints(mappedPts);
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(mapped.Get());
+  locator->BuildLocator();
+  double tol = ( this->ToleranceIsAbsolute ? this->AbsoluteTolerance :
+                 this->Tolerance*input->GetLength() );
+  locator->MergePoints(tol, mergeMap);
+}
+
 //--------------------------------------------------------------------------
 int vtkCleanPolyData::RequestUpdateExtent(
   vtkInformation *vtkNotUsed(request),
@@ -138,6 +178,10 @@ int vtkCleanPolyData::RequestData(
     vtkDebugMacro(<<"No data to Operate On!");
     return 1;
   }
+  if ( this->PointMerging && this->ParallelPointMerging )
+  {
+    return this->CleanInParallel(input, output);
+  }
   vtkIdType *updatedPts = new vtkIdType[input->GetMaxCellSize()];
 
   vtkIdType numNewPts;
@@ -594,6 +638,432 @@ int vtkCleanPolyData::RequestData(
   return 1;
 }
 
+//--------------------------------------------------------------------------
+namespace
+{
+
+// The input cells of vtkCleanPolyData::CleanInParallel(). The cells of the
+// verts, lines, polys and strips are numbered one after the other, and cut
+// into chunks of consecutive cells. Each input cell gives at most one output
+// cell, whose kind depends on its number of distinct points once merged.
+struct vtkCleanPolyDataCells
+{
+  enum { VERTS = 0, LINES, POLYS, STRIPS, DROPPED };
+  enum { CHUNK_SIZE = 1024 };
+
+  const vtkIdType *Connectivity[4];
+  vtkIdType FirstCell[5];
+  const vtkIdType *Locations;
+  const vtkIdType *MergeMap;
+  int ConvertLinesToPoints;
+  int ConvertPolysToLines;
+  int ConvertStripsToPolys;
+
+  vtkIdType GetNumberOfChunks() const
+  {
+    return (this->FirstCell[4] + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  }
+
+  // Get the points of a cell, and return the kind of its input array.
+  int GetCell(vtkIdType cellId, vtkIdType &npts, const vtkIdType *&pts) const
+  {
+    int kind = VERTS;
+    while (cellId >= this->FirstCell[kind + 1])
+    {
+      ++kind;
+    }
+    const vtkIdType *cell = this->Connectivity[kind] + this->Locations[cellId];
+    npts = cell[0];
+    pts = cell + 1;
+    return kind;
+  }
+
+  // Return the kind of the output cell of a cell, and its number of points,
+  // with the rules of the serial cleaning: consecutive points merged
+  // together (but those of vertices) count once, as does the last point of
+  // a polygon merged with its first point.
+  int Classify(int kind, vtkIdType npts, const vtkIdType *pts,
+               vtkIdType &numNewPts) const
+  {
+    if (kind == VERTS)
+    {
+      numNewPts = npts;
+      return npts > 0 ? VERTS : DROPPED;
+    }
+
+    numNewPts = 0;
+    vtkIdType last = -1;
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      vtkIdType mergeId = this->MergeMap[pts[i]];
+      if (i == 0 || mergeId != last)
+      {
+        ++numNewPts;
+        last = mergeId;
+      }
+    }
+
+    if (kind == STRIPS)
+    {
+      if (numNewPts > 3 || !this->ConvertStripsToPolys)
+      {
+        return STRIPS;
+      }
+      if (numNewPts == 3 || !this->ConvertPolysToLines)
+      {
+        return POLYS;
+      }
+    }
+    else if (kind == POLYS)
+    {
+      if (numNewPts > 2 && this->MergeMap[pts[0]] == last)
+      {
+        --numNewPts;
+      }
+      if (numNewPts > 2 || !this->ConvertPolysToLines)
+      {
+        return POLYS;
+      }
+    }
+    else if (numNewPts > 1 || !this->ConvertLinesToPoints)
+    {
+      return LINES;
+    }
+    if (kind != LINES && (numNewPts == 2 || !this->ConvertLinesToPoints))
+    {
+      return LINES;
+    }
+    return numNewPts == 1 ? VERTS : DROPPED;
+  }
+};
+
+// Count the output cells of each kind of a chunk and the size of their
+// connectivity, and list the points of the chunk that are the first ones
+// merged to a point, in the order of the cells.
+struct vtkCleanPolyDataCount
+{
+  const vtkCleanPolyDataCells *Cells;
+  vtkIdType NumberOfPoints;
+  vtkIdType *Counts;
+  std::vector<vtkIdType> *FirstPoints;
+  vtkSMPThreadLocal<std::vector<char> > Marked;
+
+  void Initialize()
+  {
+    this->Marked.Local().resize(this->NumberOfPoints, 0);
+  }
+
+  void operator()(vtkIdType chunk, vtkIdType endChunk)
+  {
+    const vtkCleanPolyDataCells *cells = this->Cells;
+    std::vector<char> &marked = this->Marked.Local();
+    for ( ; chunk < endChunk; ++chunk)
+    {
+      vtkIdType *counts = this->Counts + 8 * chunk;
+      std::fill(counts, counts + 8, 0);
+      std::vector<vtkIdType> &firstPoints = this->FirstPoints[chunk];
+      vtkIdType cellId = chunk * vtkCleanPolyDataCells::CHUNK_SIZE;
+      vtkIdType endCellId = std::min(
+        cellId + vtkCleanPolyDataCells::CHUNK_SIZE, cells->FirstCell[4]);
+      for ( ; cellId < endCellId; ++cellId)
+      {
+        vtkIdType npts, numNewPts;
+        const vtkIdType *pts;
+        int kind = cells->GetCell(cellId, npts, pts);
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          vtkIdType mergeId = cells->MergeMap[pts[i]];
+          if (!marked[mergeId])
+          {
+            marked[mergeId] = 1;
+            firstPoints.push_back(pts[i]);
+          }
+        }
+        kind = cells->Classify(kind, npts, pts, numNewPts);
+        if (kind != vtkCleanPolyDataCells::DROPPED)
+        {
+          ++counts[kind];
+          counts[4 + kind] += numNewPts + 1;
+        }
+      }
+      for (std::vector<vtkIdType>::iterator itr = firstPoints.begin();
+           itr != firstPoints.end(); ++itr)
+      {
+        marked[cells->MergeMap[*itr]] = 0;
+      }
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+// Write the output cells of a chunk, from the first output cell and the
+// first connectivity location of each kind given by Offsets, and the input
+// cell of each output cell.
+struct vtkCleanPolyDataFill
+{
+  const vtkCleanPolyDataCells *Cells;
+  const vtkIdType *Offsets;
+  const vtkIdType *PointMap;
+  vtkIdType *Connectivity[4];
+  vtkIdType FirstCell[4];
+  vtkIdType *CellIds;
+
+  void operator()(vtkIdType chunk, vtkIdType endChunk)
+  {
+    const vtkCleanPolyDataCells *cells = this->Cells;
+    for ( ; chunk < endChunk; ++chunk)
+    {
+      vtkIdType offsets[8];
+      std::copy(this->Offsets + 8 * chunk, this->Offsets + 8 * chunk + 8,
+                offsets);
+      vtkIdType cellId = chunk * vtkCleanPolyDataCells::CHUNK_SIZE;
+      vtkIdType endCellId = std::min(
+        cellId + vtkCleanPolyDataCells::CHUNK_SIZE, cells->FirstCell[4]);
+      for ( ; cellId < endCellId; ++cellId)
+      {
+        vtkIdType npts, numNewPts;
+        const vtkIdType *pts;
+        int kind = cells->GetCell(cellId, npts, pts);
+        int newKind = cells->Classify(kind, npts, pts, numNewPts);
+        if (newKind == vtkCleanPolyDataCells::DROPPED)
+        {
+          continue;
+        }
+        this->CellIds[this->FirstCell[newKind] + offsets[newKind]++] = cellId;
+        vtkIdType *conn = this->Connectivity[newKind] + offsets[4 + newKind];
+        offsets[4 + newKind] += numNewPts + 1;
+        *conn++ = numNewPts;
+        vtkIdType last = -1;
+        for (vtkIdType i = 0, n = 0; n < numNewPts; ++i)
+        {
+          vtkIdType mergeId = cells->MergeMap[pts[i]];
+          if (kind == vtkCleanPolyDataCells::VERTS || i == 0 ||
+              mergeId != last)
+          {
+            conn[n++] = this->PointMap[mergeId];
+            last = mergeId;
+          }
+        }
+      }
+    }
+  }
+};
+
+// Copy the transformed coordinates of the first point merged to each
+// output point.
+struct vtkCleanPolyDataCopyPoints
+{
+  vtkPoints *MappedPoints;
+  const vtkIdType *PointIds;
+  vtkPoints *Points;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    double x[3];
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      this->MappedPoints->GetPoint(this->PointIds[ptId], x);
+      this->Points->SetPoint(ptId, x);
+    }
+  }
+};
+
+} // end anon namespace
+
+//--------------------------------------------------------------------------
+// Clean the input with a merge map computed beforehand, with the same
+// output as the serial traversal of RequestData() would give.
+//
+// The counts of the output cells of each kind are computed by chunks of
+// cells, scanned into the locations of each chunk in the output cell
+// arrays, which are then filled by chunks too. The output points are
+// numbered in the order in which the cells first use them: each chunk
+// lists the points it uses first, and these lists are merged in the order
+// of the chunks.
+int vtkCleanPolyData::CleanInParallel(vtkPolyData *input, vtkPolyData *output)
+{
+  vtkPoints *inPts = input->GetPoints();
+  vtkIdType numPts = input->GetNumberOfPoints();
+
+  vtkNew<vtkPoints> mappedPts;
+  std::vector<vtkIdType> mergeMap(numPts);
+  this->MergePointsInParallel(input, mappedPts.Get(), &mergeMap[0]);
+  this->UpdateProgress(0.25);
+
+  vtkCellArray *inCells[4] = { input->GetVerts(), input->GetLines(),
+                               input->GetPolys(), input->GetStrips() };
+  vtkCleanPolyDataCells cells;
+  cells.FirstCell[0] = 0;
+  for (int k = 0; k < 4; ++k)
+  {
+    vtkIdType numCells = inCells[k]->GetNumberOfCells();
+    cells.Connectivity[k] = numCells ? inCells[k]->GetPointer() : NULL;
+    cells.FirstCell[k + 1] = cells.FirstCell[k] + numCells;
+  }
+  vtkIdType numCells = cells.FirstCell[4];
+  std::vector<vtkIdType> locations(numCells);
+  for (int k = 0; k < 4; ++k)
+  {
+    vtkIdType loc = 0;
+    for (vtkIdType cellId = cells.FirstCell[k];
+         cellId < cells.FirstCell[k + 1]; ++cellId)
+    {
+      locations[cellId] = loc;
+      loc += cells.Connectivity[k][loc] + 1;
+    }
+  }
+  cells.Locations = locations.empty() ? NULL : &locations[0];
+  cells.MergeMap = &mergeMap[0];
+  cells.ConvertLinesToPoints = this->ConvertLinesToPoints;
+  cells.ConvertPolysToLines = this->ConvertPolysToLines;
+  cells.ConvertStripsToPolys = this->ConvertStripsToPolys;
+
+  // Count the output cells of the chunks, and scan the counts.
+  vtkIdType numChunks = cells.GetNumberOfChunks();
+  std::vector<vtkIdType> offsets(8 * (numChunks + 1), 0);
+  std::vector<std::vector<vtkIdType> > firstPoints(numChunks);
+  if (numChunks > 0)
+  {
+    vtkCleanPolyDataCount count;
+    count.Cells = &cells;
+    count.NumberOfPoints = numPts;
+    count.Counts = &offsets[0];
+    count.FirstPoints = &firstPoints[0];
+    vtkSMPTools::For(0, numChunks, 1, count);
+  }
+  vtkIdType totals[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  for (vtkIdType chunk = 0; chunk <= numChunks; ++chunk)
+  {
+    for (int j = 0; j < 8; ++j)
+    {
+      vtkIdType count = offsets[8 * chunk + j];
+      offsets[8 * chunk + j] = totals[j];
+      totals[j] += count;
+    }
+  }
+  this->UpdateProgress(0.5);
+
+  // Number the output points.
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  vtkNew<vtkIdList> pointIds;
+  pointIds->Allocate(numPts);
+  for (vtkIdType chunk = 0; chunk < numChunks; ++chunk)
+  {
+    std::vector<vtkIdType> &chunkPoints = firstPoints[chunk];
+    for (std::vector<vtkIdType>::iterator itr = chunkPoints.begin();
+         itr != chunkPoints.end(); ++itr)
+    {
+      vtkIdType &ptId = pointMap[mergeMap[*itr]];
+      if (ptId < 0)
+      {
+        ptId = pointIds->InsertNextId(*itr);
+      }
+    }
+    std::vector<vtkIdType>().swap(chunkPoints);
+  }
+  vtkIdType numNewPts = pointIds->GetNumberOfIds();
+
+  // Fill the output cells.
+  vtkIdTypeArray *newConnectivity[4] = { NULL, NULL, NULL, NULL };
+  vtkNew<vtkIdList> cellIds;
+  cellIds->SetNumberOfIds(totals[0] + totals[1] + totals[2] + totals[3]);
+  vtkCleanPolyDataFill fill;
+  fill.Cells = &cells;
+  fill.Offsets = &offsets[0];
+  fill.PointMap = &pointMap[0];
+  fill.CellIds = cellIds->GetPointer(0);
+  for (int k = 0; k < 4; ++k)
+  {
+    fill.FirstCell[k] = k ? fill.FirstCell[k - 1] + totals[k - 1] : 0;
+    fill.Connectivity[k] = NULL;
+    if (totals[k] > 0 || inCells[k]->GetNumberOfCells() > 0)
+    {
+      newConnectivity[k] = vtkIdTypeArray::New();
+      newConnectivity[k]->SetNumberOfValues(totals[4 + k]);
+      fill.Connectivity[k] = newConnectivity[k]->GetPointer(0);
+    }
+  }
+  if (numChunks > 0)
+  {
+    vtkSMPTools::For(0, numChunks, 1, fill);
+  }
+  this->UpdateProgress(0.75);
+
+  // Copy the points and the attribute data.
+  vtkPoints *newPts = inPts->NewInstance();
+  if(this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    newPts->SetDataType(inPts->GetDataType());
+  }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkCleanPolyDataCopyPoints copyPoints;
+  copyPoints.MappedPoints = mappedPts.Get();
+  copyPoints.PointIds = pointIds->GetPointer(0);
+  copyPoints.Points = newPts;
+  vtkSMPTools::For(0, numNewPts, copyPoints);
+
+  vtkNew<vtkIdList> outIds;
+  outIds->SetNumberOfIds(numNewPts);
+  for (vtkIdType ptId = 0; ptId < numNewPts; ++ptId)
+  {
+    outIds->SetId(ptId, ptId);
+  }
+  vtkPointData *outputPD = output->GetPointData();
+  outputPD->CopyAllocate(input->GetPointData(), numNewPts);
+  outputPD->CopyData(input->GetPointData(), pointIds.Get(), outIds.Get());
+
+  vtkIdType numNewCells = cellIds->GetNumberOfIds();
+  outIds->SetNumberOfIds(numNewCells);
+  for (vtkIdType cellId = 0; cellId < numNewCells; ++cellId)
+  {
+    outIds->SetId(cellId, cellId);
+  }
+  vtkCellData *outputCD = output->GetCellData();
+  outputCD->CopyAllocate(input->GetCellData(), numNewCells);
+  outputCD->CopyData(input->GetCellData(), cellIds.Get(), outIds.Get());
+
+  vtkDebugMacro(<<"Removed " << numPts - numNewPts << " points");
+
+  output->SetPoints(newPts);
+  newPts->Delete();
+  for (int k = 0; k < 4; ++k)
+  {
+    if (newConnectivity[k])
+    {
+      vtkNew<vtkCellArray> newCells;
+      newCells->SetCells(totals[k], newConnectivity[k]);
+      newConnectivity[k]->Delete();
+      switch (k)
+      {
+        case vtkCleanPolyDataCells::VERTS:
+          output->SetVerts(newCells.Get());
+          break;
+        case vtkCleanPolyDataCells::LINES:
+          output->SetLines(newCells.Get());
+          break;
+        case vtkCleanPolyDataCells::POLYS:
+          output->SetPolys(newCells.Get());
+          break;
+        default:
+          output->SetStrips(newCells.Get());
+      }
+    }
+  }
+
+  return 1;
+}
+
 //--------------------------------------------------------------------------
 // Method manages creation of locators. It takes into account the potential
 // change of tolerance (zero to non-zero).
@@ -651,6 +1121,8 @@ void vtkCleanPolyData::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Point Merging: "
      << (this->PointMerging ? "On\n" : "Off\n");
+  os << indent << "Parallel Point Merging: "
+     << (this->ParallelPointMerging ? "On\n" : "Off\n");
   os << indent << "ToleranceIsAbsolute: "
      << (this->ToleranceIsAbsolute ? "On\n" : "Off\n");
   os << indent << "Tolerance: "
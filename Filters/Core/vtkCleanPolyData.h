@@ -144,6 +144,24 @@ public:
   vtkBooleanMacro(PointMerging,int);
   //@}
 
+  //@{
+  /**
+   * Set/Get a boolean value that controls whether the points are merged in
+   * parallel. If on (and PointMerging is on), the point each point is merged
+   * to is computed beforehand by a vtkStaticPointLocator, threaded with
+   * vtkSMPTools, instead of inserting the points one at a time in the
+   * Locator (which is not used), and the cells are then rewritten with
+   * vtkSMPTools as well. With a 0.0 tolerance the output is the
+   * same as the serial one. Otherwise the points are merged in id order,
+   * so that the output does not depend on the number of threads, but may
+   * differ from the serial one. Note that OperateOnPoint() is still called
+   * from a single thread. By default, this is off.
+   */
+  vtkSetMacro(ParallelPointMerging,int);
+  vtkGetMacro(ParallelPointMerging,int);
+  vtkBooleanMacro(ParallelPointMerging,int);
+  //@}
+
   //@{
   /**
    * Set/Get a spatial locator for speeding the search process. By
@@ -205,7 +223,15 @@ protected:
   int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *) VTK_OVERRIDE;
   int RequestUpdateExtent(vtkInformation *, vtkInformationVector **, vtkInformationVector *) VTK_OVERRIDE;
 
+  // Compute the merge map of the points with a vtkStaticPointLocator
+  void MergePointsInParallel(vtkPolyData *input, vtkPoints *mappedPts,
+                             vtkIdType *mergeMap);
+
+  // Clean the input with ParallelPointMerging on
+  int CleanInParallel(vtkPolyData *input, vtkPolyData *output);
+
   int   PointMerging;
+  int   ParallelPointMerging;
   double Tolerance;
   double AbsoluteTolerance;
   int ConvertLinesToPoints;
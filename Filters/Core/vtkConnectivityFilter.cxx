@@ -16,6 +16,7 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectivityLabeler.h"
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
@@ -57,6 +58,7 @@ vtkConnectivityFilter::vtkConnectivityFilter()
   this->NewCellScalars = 0;
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->ParallelLabeling = 0;
 }
 
 vtkConnectivityFilter::~vtkConnectivityFilter()
@@ -184,8 +186,31 @@ int vtkConnectivityFilter::RequestData(
   this->PointIds = vtkIdList::New();
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
 
+  vtkConnectivityLabeler labeler;
+  if ( this->InScalars )
+  {
+    labeler.SetScalarCriterion(this->InScalars, this->ScalarRange, false);
+  }
+
   if ( this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
   this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
+  this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION &&
+  this->ParallelLabeling )
+  { //label all cells in parallel, regions are numbered as below
+    this->RegionNumber =
+      labeler.LabelAllRegions(input, this->Visited, this->RegionSizes);
+    for (i=0; i < this->RegionNumber; i++)
+    {
+      if ( this->RegionSizes->GetValue(i) > maxCellsInRegion )
+      {
+        maxCellsInRegion = static_cast<int>(this->RegionSizes->GetValue(i));
+        largestRegionId = static_cast<int>(i);
+      }
+    }
+    this->UpdateProgress (0.9);
+  }
+  else if ( this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+  this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
   this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION )
   { //visit all cells marking with region number
     for (cellId=0; cellId < numCells; cellId++)
@@ -267,7 +292,16 @@ int vtkConnectivityFilter::RequestData(
     this->UpdateProgress (0.5);
 
     //mark all seeded regions
-    this->TraverseAndMark (input);
+    if ( this->ParallelLabeling )
+    {
+      this->NumCellsInRegion = labeler.LabelSeededRegion(
+        input, this->Wave->GetNumberOfIds(), this->Wave->GetPointer(0),
+        this->Visited);
+    }
+    else
+    {
+      this->TraverseAndMark (input);
+    }
     this->RegionSizes->InsertValue(this->RegionNumber,this->NumCellsInRegion);
     this->UpdateProgress (0.9);
   }
@@ -276,6 +310,16 @@ int vtkConnectivityFilter::RequestData(
   this->Wave->Delete();
   this->Wave2->Delete();
 
+  if ( this->ParallelLabeling )
+  { //number the points in input order, and copy the cell labels
+    this->PointNumber = labeler.MapPoints(input, this->Visited,
+      this->PointMap, this->NewScalars->GetPointer(0));
+    for (cellId=0; cellId < numCells; cellId++)
+    {
+      this->NewCellScalars->SetValue(cellId, this->Visited[cellId]);
+    }
+  }
+
   // Now that points and cells have been marked, traverse these lists pulling
   // everything that has been visited.
   //
@@ -595,5 +639,7 @@ void vtkConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Scalar Range: (" << range[0] << ", " << range[1] << ")\n";
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision
      << "\n";
+  os << indent << "Parallel Labeling: "
+     << (this->ParallelLabeling ? "On\n" : "Off\n");
 }
 
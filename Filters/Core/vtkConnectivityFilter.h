@@ -181,6 +181,21 @@ public:
   vtkGetMacro(OutputPointsPrecision,int);
   //@}
 
+  //@{
+  /**
+   * Turn on/off the labeling of the regions in parallel (vtkSMPTools) with a
+   * union-find over the cells, instead of the serial wave propagation. The
+   * regions, their sizes and the RegionId arrays are the same, whatever the
+   * number of threads; only the output points are numbered in the order of
+   * the input points rather than in the order of the traversal. The input
+   * must support concurrent calls to GetCellPoints() and GetPointCells(),
+   * as all the datasets of VTK do. Off by default.
+   */
+  vtkSetMacro(ParallelLabeling,int);
+  vtkGetMacro(ParallelLabeling,int);
+  vtkBooleanMacro(ParallelLabeling,int);
+  //@}
+
 protected:
   vtkConnectivityFilter();
   ~vtkConnectivityFilter() VTK_OVERRIDE;
@@ -192,6 +207,7 @@ protected:
   int ColorRegions; //boolean turns on/off scalar gen for separate regions
   int ExtractionMode; //how to extract regions
   int OutputPointsPrecision;
+  int ParallelLabeling;
   vtkIdList *Seeds; //id's of points or cells used to seed regions
   vtkIdList *SpecifiedRegionIds; //regions specified for extraction
   vtkIdTypeArray *RegionSizes; //size (in cells) of each region extracted
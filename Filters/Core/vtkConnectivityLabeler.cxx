@@ -0,0 +1,542 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConnectivityLabeler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkConnectivityLabeler.h"
+
+#include "vtkCell.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <utility>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+// Union-find over the cells. Parent[id] <= id always holds: the larger root
+// is linked below the smaller one, and path halving only moves a cell closer
+// to its root.
+vtkIdType vtkConnectivityLabelerFind(vtkIdType *parent, vtkIdType id)
+{
+  while (parent[id] != id)
+  {
+    parent[id] = parent[parent[id]];
+    id = parent[id];
+  }
+  return id;
+}
+
+void vtkConnectivityLabelerUnite(vtkIdType *parent, vtkIdType id0,
+                                 vtkIdType id1)
+{
+  id0 = vtkConnectivityLabelerFind(parent, id0);
+  id1 = vtkConnectivityLabelerFind(parent, id1);
+  if (id0 < id1)
+  {
+    parent[id1] = id0;
+  }
+  else if (id1 < id0)
+  {
+    parent[id0] = id1;
+  }
+}
+
+//----------------------------------------------------------------------------
+// Evaluate the scalar criterion of each cell, as the wave propagation does:
+// the scalars go through a float array before their range is compared.
+struct vtkConnectivityLabelerCriterion
+{
+  vtkDataSet *Input;
+  vtkDataArray *Scalars;
+  const double *Range;
+  bool Full;
+  char *Connected;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+
+  void Initialize()
+  {
+    vtkIdList *&ptIds = this->PointIds.Local();
+    ptIds->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *ptIds = this->PointIds.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      this->Input->GetCellPoints(cellId, ptIds);
+      double range[2] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+      {
+        double s = static_cast<float>(
+          this->Scalars->GetComponent(ptIds->GetId(i), 0));
+        if (s < range[0])
+        {
+          range[0] = s;
+        }
+        if (s > range[1])
+        {
+          range[1] = s;
+        }
+      }
+      if (this->Full)
+      {
+        this->Connected[cellId] =
+          range[0] >= this->Range[0] && range[1] <= this->Range[1];
+      }
+      else
+      {
+        this->Connected[cellId] =
+          range[1] >= this->Range[0] && range[0] <= this->Range[1];
+      }
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+//----------------------------------------------------------------------------
+// Find the smallest cell satisfying the criterion and the smallest cell
+// failing it around each point.
+struct vtkConnectivityLabelerPointMinima
+{
+  vtkDataSet *Input;
+  const char *Connected;
+  vtkIdType *MinConnected;
+  vtkIdType *MinUnconnected;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+
+  void Initialize()
+  {
+    vtkIdList *&cellIds = this->CellIds.Local();
+    cellIds->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellIds = this->CellIds.Local();
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      this->Input->GetPointCells(ptId, cellIds);
+      vtkIdType minConnected = -1;
+      vtkIdType minUnconnected = -1;
+      for (vtkIdType i = 0; i < cellIds->GetNumberOfIds(); ++i)
+      {
+        vtkIdType cellId = cellIds->GetId(i);
+        vtkIdType &minId = (!this->Connected || this->Connected[cellId]) ?
+          minConnected : minUnconnected;
+        if (minId < 0 || cellId < minId)
+        {
+          minId = cellId;
+        }
+      }
+      this->MinConnected[ptId] = minConnected;
+      if (this->MinUnconnected)
+      {
+        this->MinUnconnected[ptId] = minUnconnected;
+      }
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+//----------------------------------------------------------------------------
+// Join the cells of a range with the smallest connected cell of each of
+// their points. The parents of the range are only written by its thread;
+// links to cells before the range are kept for the serial pass.
+struct vtkConnectivityLabelerJoin
+{
+  typedef std::vector<std::pair<vtkIdType, vtkIdType> > LinkList;
+
+  vtkDataSet *Input;
+  const char *Connected;
+  const vtkIdType *MinConnected;
+  vtkIdType *Parent;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+  vtkSMPThreadLocal<LinkList> Links;
+
+  void Initialize()
+  {
+    vtkIdList *&ptIds = this->PointIds.Local();
+    ptIds->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *ptIds = this->PointIds.Local();
+    LinkList &links = this->Links.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (this->Connected && !this->Connected[cellId])
+      {
+        continue;
+      }
+      this->Input->GetCellPoints(cellId, ptIds);
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+      {
+        vtkIdType minId = this->MinConnected[ptIds->GetId(i)];
+        if (minId >= begin)
+        {
+          vtkConnectivityLabelerUnite(this->Parent, cellId, minId);
+        }
+        else if (links.empty() || links.back().first != cellId ||
+                 links.back().second != minId)
+        {
+          links.push_back(std::make_pair(cellId, minId));
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+//----------------------------------------------------------------------------
+// Find the smallest cell failing the criterion around each connected cell.
+struct vtkConnectivityLabelerAbsorbers
+{
+  vtkDataSet *Input;
+  const char *Connected;
+  const vtkIdType *MinUnconnected;
+  vtkIdType *Absorbers;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+
+  void Initialize()
+  {
+    vtkIdList *&ptIds = this->PointIds.Local();
+    ptIds->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *ptIds = this->PointIds.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (!this->Connected[cellId])
+      {
+        continue;
+      }
+      this->Input->GetCellPoints(cellId, ptIds);
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+      {
+        vtkIdType minId = this->MinUnconnected[ptIds->GetId(i)];
+        if (minId >= 0 && minId < this->Absorbers[cellId])
+        {
+          this->Absorbers[cellId] = minId;
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+//----------------------------------------------------------------------------
+// Find the smallest region of the labeled cells using each point.
+struct vtkConnectivityLabelerPointRegions
+{
+  vtkDataSet *Input;
+  const vtkIdType *CellRegionIds;
+  vtkIdType *PointRegionIds;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+
+  void Initialize()
+  {
+    vtkIdList *&cellIds = this->CellIds.Local();
+    cellIds->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellIds = this->CellIds.Local();
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      this->Input->GetPointCells(ptId, cellIds);
+      vtkIdType regionId = -1;
+      for (vtkIdType i = 0; i < cellIds->GetNumberOfIds(); ++i)
+      {
+        vtkIdType cellRegionId = this->CellRegionIds[cellIds->GetId(i)];
+        if (cellRegionId >= 0 && (regionId < 0 || cellRegionId < regionId))
+        {
+          regionId = cellRegionId;
+        }
+      }
+      this->PointRegionIds[ptId] = regionId;
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkConnectivityLabeler::vtkConnectivityLabeler()
+{
+  this->Scalars = NULL;
+  this->Range[0] = 0.0;
+  this->Range[1] = 1.0;
+  this->Full = false;
+}
+
+//----------------------------------------------------------------------------
+vtkConnectivityLabeler::~vtkConnectivityLabeler()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkConnectivityLabeler::SetScalarCriterion(vtkDataArray *scalars,
+                                                const double range[2],
+                                                bool full)
+{
+  this->Scalars = scalars;
+  this->Range[0] = range[0];
+  this->Range[1] = range[1];
+  this->Full = full;
+}
+
+//----------------------------------------------------------------------------
+// Build the components of the cells satisfying the criterion. On return,
+// Parent[id] is the root of every cell.
+void vtkConnectivityLabeler::BuildComponents(vtkDataSet *input)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+
+  // Build the cells and links before going parallel.
+  vtkIdList *ids = vtkIdList::New();
+  input->GetCellPoints(0, ids);
+  input->GetPointCells(0, ids);
+  ids->Delete();
+
+  this->Connected.clear();
+  if (this->Scalars)
+  {
+    this->Connected.resize(numCells);
+    vtkConnectivityLabelerCriterion criterion;
+    criterion.Input = input;
+    criterion.Scalars = this->Scalars;
+    criterion.Range = this->Range;
+    criterion.Full = this->Full;
+    criterion.Connected = &this->Connected[0];
+    vtkSMPTools::For(0, numCells, criterion);
+  }
+  const char *connected = this->Scalars ? &this->Connected[0] : NULL;
+
+  this->MinConnected.resize(numPts);
+  this->MinUnconnected.resize(this->Scalars ? numPts : 0);
+  vtkConnectivityLabelerPointMinima minima;
+  minima.Input = input;
+  minima.Connected = connected;
+  minima.MinConnected = &this->MinConnected[0];
+  minima.MinUnconnected = this->Scalars ? &this->MinUnconnected[0] : NULL;
+  vtkSMPTools::For(0, numPts, minima);
+
+  this->Parent.resize(numCells);
+  vtkIdType *parent = &this->Parent[0];
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    parent[cellId] = cellId;
+  }
+  vtkConnectivityLabelerJoin join;
+  join.Input = input;
+  join.Connected = connected;
+  join.MinConnected = &this->MinConnected[0];
+  join.Parent = parent;
+  vtkSMPTools::For(0, numCells, join);
+
+  // The partition does not depend on the order in which the links between
+  // ranges are joined.
+  for (vtkSMPThreadLocal<vtkConnectivityLabelerJoin::LinkList>::iterator
+         itr = join.Links.begin(); itr != join.Links.end(); ++itr)
+  {
+    for (size_t i = 0; i < itr->size(); ++i)
+    {
+      vtkConnectivityLabelerUnite(parent, (*itr)[i].first, (*itr)[i].second);
+    }
+  }
+
+  // Since parents come first, one pass links every cell to its root.
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    parent[cellId] = parent[parent[cellId]];
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkConnectivityLabeler::LabelAllRegions(vtkDataSet *input,
+                                                  vtkIdType *cellRegionIds,
+                                                  vtkIdTypeArray *regionSizes)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+  this->BuildComponents(input);
+  const vtkIdType *parent = &this->Parent[0];
+
+  // A cell failing the criterion starts a region, which takes the
+  // components it touches unless they started before it. Each component
+  // thus goes to the smallest failing cell around it, if smaller than its
+  // root.
+  std::vector<vtkIdType> absorbers;
+  if (this->Scalars)
+  {
+    absorbers.resize(numCells, numCells);
+    vtkConnectivityLabelerAbsorbers finder;
+    finder.Input = input;
+    finder.Connected = &this->Connected[0];
+    finder.MinUnconnected = &this->MinUnconnected[0];
+    finder.Absorbers = &absorbers[0];
+    vtkSMPTools::For(0, numCells, finder);
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      vtkIdType root = parent[cellId];
+      if (root != cellId && absorbers[cellId] < absorbers[root])
+      {
+        absorbers[root] = absorbers[cellId];
+      }
+    }
+  }
+
+  // Number the regions in the order of their first cell.
+  std::vector<vtkIdType> sizes;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    vtkIdType root = parent[cellId];
+    vtkIdType regionId;
+    if (root != cellId)
+    {
+      regionId = cellRegionIds[root];
+    }
+    else if (this->Scalars && this->Connected[cellId] &&
+             absorbers[cellId] < cellId)
+    {
+      regionId = cellRegionIds[absorbers[cellId]];
+    }
+    else
+    {
+      regionId = static_cast<vtkIdType>(sizes.size());
+      sizes.push_back(0);
+    }
+    cellRegionIds[cellId] = regionId;
+    ++sizes[regionId];
+  }
+
+  const vtkIdType numRegions = static_cast<vtkIdType>(sizes.size());
+  regionSizes->SetNumberOfValues(numRegions);
+  for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+  {
+    regionSizes->SetValue(regionId, sizes[regionId]);
+  }
+  return numRegions;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkConnectivityLabeler::LabelSeededRegion(vtkDataSet *input,
+                                                    vtkIdType numSeeds,
+                                                    const vtkIdType *seeds,
+                                                    vtkIdType *cellRegionIds)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+  this->BuildComponents(input);
+  const vtkIdType *parent = &this->Parent[0];
+
+  // The region is made of the seeds, and of the components containing or
+  // touching a seed.
+  std::vector<char> reached(numCells, 0);
+  vtkIdList *ptIds = vtkIdList::New();
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    cellRegionIds[cellId] = -1;
+  }
+  for (vtkIdType i = 0; i < numSeeds; ++i)
+  {
+    vtkIdType seed = seeds[i];
+    if (seed < 0 || seed >= numCells)
+    {
+      continue;
+    }
+    cellRegionIds[seed] = 0;
+    if (!this->Scalars || this->Connected[seed])
+    {
+      reached[parent[seed]] = 1;
+    }
+    input->GetCellPoints(seed, ptIds);
+    for (vtkIdType j = 0; j < ptIds->GetNumberOfIds(); ++j)
+    {
+      vtkIdType minId = this->MinConnected[ptIds->GetId(j)];
+      if (minId >= 0)
+      {
+        reached[parent[minId]] = 1;
+      }
+    }
+  }
+  ptIds->Delete();
+
+  vtkIdType numCellsInRegion = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    if (cellRegionIds[cellId] < 0 && reached[parent[cellId]] &&
+        (!this->Scalars || this->Connected[cellId]))
+    {
+      cellRegionIds[cellId] = 0;
+    }
+    if (cellRegionIds[cellId] == 0)
+    {
+      ++numCellsInRegion;
+    }
+  }
+  return numCellsInRegion;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkConnectivityLabeler::MapPoints(vtkDataSet *input,
+                                            const vtkIdType *cellRegionIds,
+                                            vtkIdType *pointMap,
+                                            vtkIdType *pointRegionIds)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+
+  // Store the region of each point in pointMap, then number the points.
+  vtkConnectivityLabelerPointRegions regions;
+  regions.Input = input;
+  regions.CellRegionIds = cellRegionIds;
+  regions.PointRegionIds = pointMap;
+  vtkSMPTools::For(0, numPts, regions);
+
+  vtkIdType numNewPts = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (pointMap[ptId] >= 0)
+    {
+      pointRegionIds[numNewPts] = pointMap[ptId];
+      pointMap[ptId] = numNewPts++;
+    }
+  }
+  return numNewPts;
+}
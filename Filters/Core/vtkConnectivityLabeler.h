@@ -0,0 +1,113 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConnectivityLabeler.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConnectivityLabeler
+ * @brief   A utility class labeling connected regions in parallel
+ *
+ * This is a simple utility class used by the connectivity filters to label
+ * the cells of a dataset with the connected region they belong to. Cells are
+ * connected through their shared points, optionally only when they satisfy a
+ * scalar criterion. The connected components are built with a union-find:
+ * blocks of cells are joined in parallel (vtkSMPTools), then the few links
+ * between blocks are joined serially. Every component is represented by its
+ * smallest cell id, so the labels do not depend on the number of threads, and
+ * regions are numbered exactly as the serial wave propagation of
+ * vtkConnectivityFilter numbers them.
+ *
+ * The input must support concurrent calls to GetCellPoints() and
+ * GetPointCells(); both are primed from a single thread first, which builds
+ * the cells and links of polydata and unstructured grids.
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter
+*/
+
+#ifndef vtkConnectivityLabeler_h
+#define vtkConnectivityLabeler_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkType.h" // for vtkIdType
+
+#include <vector> // for the member variables
+
+class vtkDataArray;
+class vtkDataSet;
+class vtkIdTypeArray;
+
+class VTKFILTERSCORE_EXPORT vtkConnectivityLabeler
+{
+public:
+  vtkConnectivityLabeler();
+  ~vtkConnectivityLabeler();
+
+  /**
+   * Only connect the cells whose range of scalars (the first component at
+   * their points, as single precision values) intersects range, or lies
+   * within it if full is true. As in the wave propagation, a cell failing the
+   * criterion still starts a region of its own, which grows into the
+   * neighboring cells satisfying it. A NULL scalars array (the default)
+   * connects all the cells.
+   */
+  void SetScalarCriterion(vtkDataArray *scalars, const double range[2],
+                          bool full);
+
+  /**
+   * Set cellRegionIds[cellId] to the region of every cell of input, regions
+   * being numbered in the order of their first cell, and store the number of
+   * cells of each region in regionSizes. Return the number of regions.
+   */
+  vtkIdType LabelAllRegions(vtkDataSet *input, vtkIdType *cellRegionIds,
+                            vtkIdTypeArray *regionSizes);
+
+  /**
+   * Set cellRegionIds[cellId] to 0 for the cells of the region grown from
+   * the numSeeds seed cells, and to -1 for the other cells. Return the number
+   * of cells of the region.
+   */
+  vtkIdType LabelSeededRegion(vtkDataSet *input, vtkIdType numSeeds,
+                              const vtkIdType *seeds,
+                              vtkIdType *cellRegionIds);
+
+  /**
+   * Number the points used by the labeled cells (cellRegionIds >= 0) in
+   * increasing order of their ids: pointMap[ptId] is set to the new id, or
+   * -1, and pointRegionIds[newId] to the smallest region of the cells using
+   * the point. Return the number of points used.
+   */
+  vtkIdType MapPoints(vtkDataSet *input, const vtkIdType *cellRegionIds,
+                      vtkIdType *pointMap, vtkIdType *pointRegionIds);
+
+private:
+  vtkConnectivityLabeler(const vtkConnectivityLabeler&) VTK_DELETE_FUNCTION;
+  vtkConnectivityLabeler& operator=(const vtkConnectivityLabeler&) VTK_DELETE_FUNCTION;
+
+  void BuildComponents(vtkDataSet *input);
+
+  vtkDataArray *Scalars;
+  double Range[2];
+  bool Full;
+
+  // Whether each cell satisfies the criterion (empty if there is none).
+  std::vector<char> Connected;
+  // Union-find parent of each cell; Parent[id] <= id, roots are the
+  // smallest cell id of their component.
+  std::vector<vtkIdType> Parent;
+  // Per point, the smallest cell satisfying the criterion and the smallest
+  // cell failing it, or -1.
+  std::vector<vtkIdType> MinConnected;
+  std::vector<vtkIdType> MinUnconnected;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkConnectivityLabeler.h
@@ -49,9 +49,16 @@
 #include "vtkTimerLog.h"
 #include "vtkSmartPointer.h"
 #include "vtkContourHelper.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkCutter);
 vtkCxxSetObjectMacro(vtkCutter,CutFunction,vtkImplicitFunction);
@@ -69,6 +76,7 @@ vtkCutter::vtkCutter(vtkImplicitFunction *cf)
   this->Locator = NULL;
   this->GenerateTriangles = 1;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->ParallelCutting = 0;
 
   this->SynchronizedTemplates3D = vtkSynchronizedTemplates3D::New();
   this->SynchronizedTemplatesCutter3D = vtkSynchronizedTemplatesCutter3D::New();
@@ -403,8 +411,19 @@ int vtkCutter::RequestData(
   else if (input->GetDataObjectType() == VTK_UNSTRUCTURED_GRID_BASE ||
            input->GetDataObjectType() == VTK_UNSTRUCTURED_GRID)
   {
-    vtkDebugMacro(<< "Executing Unstructured Grid Cutter");
-    this->UnstructuredGridCutter(input, output);
+    vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(input);
+    if (this->ParallelCutting && grid && !grid->GetFaces() &&
+        this->SortBy == VTK_SORT_BY_VALUE && this->GenerateTriangles &&
+        (!this->Locator || this->Locator->IsA("vtkMergePoints")))
+    {
+      vtkDebugMacro(<< "Executing Parallel Unstructured Grid Cutter");
+      this->UnstructuredGridCutterInParallel(input, output);
+    }
+    else
+    {
+      vtkDebugMacro(<< "Executing Unstructured Grid Cutter");
+      this->UnstructuredGridCutter(input, output);
+    }
   }
   else
   {
@@ -1014,6 +1033,466 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
   output->Squeeze();
 }
 
+//----------------------------------------------------------------------------
+// Parallel cutting of unstructured grids.
+namespace
+{
+
+// Number of cells of a batch. The batches do not depend on the number of
+// threads, so neither does the output.
+const vtkIdType VTK_CUTTER_BATCH_SIZE = 1000;
+
+// Evaluate the cut function at the points of a point set.
+struct vtkCutterEvaluateFunction
+{
+  vtkPoints *Points;
+  vtkImplicitFunction *Function;
+  double *Scalars;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      this->Points->GetPoint(ptId, x);
+      this->Scalars[ptId] = this->Function->EvaluateFunction(x);
+    }
+  }
+};
+
+// The cut of a batch of cells of one dimension. Its points are merged
+// within the batch, and the input cell of each output cell (in the order of
+// the verts, lines and polys) is kept to copy the cell data afterwards.
+// The arrays are only allocated once a cell of the batch is cut, so they
+// are NULL for the (many) batches without any cell of their dimension.
+struct vtkCutterBatch
+{
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkPointData> PointData;
+  vtkSmartPointer<vtkCellArray> Cells[3];
+  std::vector<vtkIdType> CellSources[3];
+
+  vtkIdType GetNumberOfPoints() const
+  {
+    return this->Points ? this->Points->GetNumberOfPoints() : 0;
+  }
+};
+
+// Cut the batches of cells. The batches of the 1D cells come first, then
+// those of the 2D and 3D cells, as the passes of the serial cutter.
+struct vtkCutterCutCells
+{
+  vtkUnstructuredGrid *Input;
+  vtkDoubleArray *CutScalars;
+  vtkPointData *InPD;
+  const double *ContourValues;
+  int NumContours;
+  const unsigned char *CellTypeDimensions;
+  vtkIdType NumRanges;
+  int PointsType;
+  const double *Bounds;
+  vtkCutterBatch *Batches;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkDoubleArray> CellScalars;
+
+  void Initialize()
+  {
+    vtkDoubleArray *&cellScalars = this->CellScalars.Local();
+    cellScalars->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell *&cell = this->Cell.Local();
+    vtkDoubleArray *&cellScalars = this->CellScalars.Local();
+    const double *scalars = this->CutScalars->GetPointer(0);
+    const double *contourValuesEnd = this->ContourValues + this->NumContours;
+    vtkIdType numCells = this->Input->GetNumberOfCells();
+    vtkIdType npts;
+    const vtkIdType *pts;
+
+    // The cell data is copied afterwards.
+    vtkNew<vtkCellData> noCellData;
+
+    for (vtkIdType batchId = begin; batchId < end; ++batchId)
+    {
+      int dimensionality = static_cast<int>(batchId / this->NumRanges) + 1;
+      vtkIdType cellBegin =
+        (batchId % this->NumRanges) * VTK_CUTTER_BATCH_SIZE;
+      vtkIdType cellEnd =
+        std::min(cellBegin + VTK_CUTTER_BATCH_SIZE, numCells);
+
+      vtkCutterBatch &batch = this->Batches[batchId];
+      vtkSmartPointer<vtkMergePoints> locator;
+      vtkContourHelper *helper = NULL;
+
+      for (vtkIdType cellId = cellBegin; cellId < cellEnd; ++cellId)
+      {
+        int cellType = this->Input->GetCellType(cellId);
+        if (cellType >= VTK_NUMBER_OF_CELL_TYPES ||
+            this->CellTypeDimensions[cellType] != dimensionality)
+        {
+          continue;
+        }
+
+        // The point ids of cell are scratch space until GetCell() below.
+        this->Input->GetCellPoints(cellId, npts, pts, cell->PointIds);
+        double range[2];
+        range[0] = range[1] = scalars[pts[0]];
+        for (vtkIdType i = 1; i < npts; ++i)
+        {
+          range[0] = std::min(range[0], scalars[pts[i]]);
+          range[1] = std::max(range[1], scalars[pts[i]]);
+        }
+        bool needCell = false;
+        for (const double *value = this->ContourValues;
+             value != contourValuesEnd && !needCell; ++value)
+        {
+          needCell = *value >= range[0] && *value <= range[1];
+        }
+        if (!needCell)
+        {
+          continue;
+        }
+
+        if (!helper)
+        {
+          batch.Points = vtkSmartPointer<vtkPoints>::New();
+          batch.Points->SetDataType(this->PointsType);
+          batch.PointData = vtkSmartPointer<vtkPointData>::New();
+          batch.PointData->InterpolateAllocate(this->InPD,
+                                               VTK_CUTTER_BATCH_SIZE);
+          for (int i = 0; i < 3; ++i)
+          {
+            batch.Cells[i] = vtkSmartPointer<vtkCellArray>::New();
+          }
+          locator = vtkSmartPointer<vtkMergePoints>::New();
+          locator->InitPointInsertion(batch.Points, this->Bounds,
+                                      VTK_CUTTER_BATCH_SIZE);
+          helper = new vtkContourHelper(locator, batch.Cells[0],
+                                        batch.Cells[1], batch.Cells[2],
+                                        this->InPD, noCellData.GetPointer(),
+                                        batch.PointData,
+                                        noCellData.GetPointer(),
+                                        VTK_CUTTER_BATCH_SIZE, true);
+        }
+
+        this->Input->GetCell(cellId, cell);
+        this->CutScalars->GetTuples(cell->GetPointIds(), cellScalars);
+        for (const double *value = this->ContourValues;
+             value != contourValuesEnd; ++value)
+        {
+          helper->Contour(cell, *value, cellScalars, cellId);
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+          batch.CellSources[i].resize(batch.Cells[i]->GetNumberOfCells(),
+                                      cellId);
+        }
+      }
+      delete helper;
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+// Copy the points of the batches, one after the other.
+struct vtkCutterGatherPoints
+{
+  const vtkCutterBatch *Batches;
+  const vtkIdType *PointOffsets;
+  vtkPoints *Points;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType batchId = begin; batchId < end; ++batchId)
+    {
+      vtkPoints *points = this->Batches[batchId].Points;
+      if (!points)
+      {
+        continue;
+      }
+      vtkIdType offset = this->PointOffsets[batchId];
+      for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+      {
+        points->GetPoint(ptId, x);
+        this->Points->SetPoint(offset + ptId, x);
+      }
+    }
+  }
+};
+
+// Copy the cells of one kind (verts, lines or polys) of the batches, with
+// their points renumbered to the merged points.
+struct vtkCutterGatherCells
+{
+  const vtkCutterBatch *Batches;
+  int Kind;
+  const vtkIdType *PointOffsets;
+  const vtkIdType *ConnectivityOffsets;
+  const vtkIdType *PointMap;
+  vtkIdType *Connectivity;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType batchId = begin; batchId < end; ++batchId)
+    {
+      vtkCellArray *cells = this->Batches[batchId].Cells[this->Kind];
+      if (!cells)
+      {
+        continue;
+      }
+      const vtkIdType *src = cells->GetPointer();
+      const vtkIdType *srcEnd = src + cells->GetNumberOfConnectivityEntries();
+      vtkIdType *dst = this->Connectivity + this->ConnectivityOffsets[batchId];
+      const vtkIdType *pointMap =
+        this->PointMap + this->PointOffsets[batchId];
+      while (src < srcEnd)
+      {
+        vtkIdType npts = *src++;
+        *dst++ = npts;
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          *dst++ = pointMap[*src++];
+        }
+      }
+    }
+  }
+};
+
+} // end anon namespace
+
+//----------------------------------------------------------------------------
+// Same output as UnstructuredGridCutter() when sorting by value. The cut
+// function is evaluated in parallel, then the batches of cells are cut in
+// parallel with their own vtkMergePoints, and the points of the batches are
+// merged with a vtkStaticPointLocator to the first one in the batch order,
+// i.e., the one the serial cutter inserts first.
+void vtkCutter::UnstructuredGridCutterInParallel(vtkDataSet *input,
+                                                 vtkPolyData *output)
+{
+  vtkUnstructuredGrid *grid = static_cast<vtkUnstructuredGrid*>(input);
+  vtkIdType numCells = grid->GetNumberOfCells();
+  vtkIdType numPts = grid->GetNumberOfPoints();
+  vtkCellData *inCD = grid->GetCellData();
+  vtkCellData *outCD = output->GetCellData();
+  vtkPointData *outPD = output->GetPointData();
+
+  int pointsType = VTK_FLOAT;
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    pointsType = grid->GetPoints()->GetDataType();
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    pointsType = VTK_DOUBLE;
+  }
+
+  // Evaluate the cut function. vtkPlane evaluates arrays in parallel (in
+  // the precision of the points), other functions are evaluated here point
+  // by point, as vtkImplicitFunction::EvaluateFunction() does. The serial
+  // evaluation of the first point takes care of any lazy initialization.
+  vtkDoubleArray *cutScalars = vtkDoubleArray::New();
+  cutScalars->SetNumberOfTuples(numPts);
+  if (this->CutFunction->IsA("vtkPlane"))
+  {
+    this->CutFunction->EvaluateFunction(grid->GetPoints()->GetData(),
+                                        cutScalars);
+  }
+  else
+  {
+    double x[3];
+    grid->GetPoint(0, x);
+    this->CutFunction->EvaluateFunction(x);
+    vtkCutterEvaluateFunction evaluate;
+    evaluate.Points = grid->GetPoints();
+    evaluate.Function = this->CutFunction;
+    evaluate.Scalars = cutScalars->GetPointer(0);
+    vtkSMPTools::For(0, numPts, evaluate);
+  }
+  this->UpdateProgress(0.2);
+
+  vtkPointData *inPD;
+  if ( this->GenerateCutScalars )
+  {
+    inPD = vtkPointData::New();
+    inPD->ShallowCopy(grid->GetPointData());//copies original attributes
+    inPD->SetScalars(cutScalars);
+  }
+  else
+  {
+    inPD = grid->GetPointData();
+  }
+
+  // Cut the batches of cells.
+  unsigned char cellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+  vtkCutter::GetCellTypeDimensions(cellTypeDimensions);
+  vtkIdType numRanges =
+    (numCells + VTK_CUTTER_BATCH_SIZE - 1) / VTK_CUTTER_BATCH_SIZE;
+  vtkIdType numBatches = 3 * numRanges;
+  std::vector<vtkCutterBatch> batches(numBatches);
+  if (numCells > 0)
+  {
+    // Build the cell types and locations before threading.
+    grid->GetCellType(0);
+  }
+  vtkCutterCutCells cut;
+  cut.Input = grid;
+  cut.CutScalars = cutScalars;
+  cut.InPD = inPD;
+  cut.ContourValues = this->ContourValues->GetValues();
+  cut.NumContours = this->ContourValues->GetNumberOfContours();
+  cut.CellTypeDimensions = cellTypeDimensions;
+  cut.NumRanges = numRanges;
+  cut.PointsType = pointsType;
+  cut.Bounds = grid->GetBounds();
+  cut.Batches = batches.empty() ? NULL : &batches[0];
+  vtkSMPTools::For(0, numBatches, 1, cut);
+  this->UpdateProgress(0.8);
+
+  // Merge the points of the batches.
+  std::vector<vtkIdType> pointOffsets(numBatches + 1, 0);
+  for (vtkIdType batchId = 0; batchId < numBatches; ++batchId)
+  {
+    pointOffsets[batchId + 1] = pointOffsets[batchId] +
+      batches[batchId].GetNumberOfPoints();
+  }
+  vtkIdType numBatchPts = pointOffsets[numBatches];
+  vtkPoints *batchPoints = vtkPoints::New();
+  batchPoints->SetDataType(pointsType);
+  batchPoints->SetNumberOfPoints(numBatchPts);
+  vtkCutterGatherPoints gatherPoints;
+  gatherPoints.Batches = cut.Batches;
+  gatherPoints.PointOffsets = &pointOffsets[0];
+  gatherPoints.Points = batchPoints;
+  vtkSMPTools::For(0, numBatches, gatherPoints);
+
+  std::vector<vtkIdType> pointMap(numBatchPts);
+  if (numBatchPts > 0)
+  {
+    vtkPolyData *merged = vtkPolyData::New();
+    merged->SetPoints(batchPoints);
+    vtkStaticPointLocator *locator = vtkStaticPointLocator::New();
+    locator->SetDataSet(merged);
+    locator->BuildLocator();
+    locator->MergePoints(0.0, &pointMap[0]);
+    locator->Delete();
+    merged->Delete();
+  }
+  vtkIdList *keptIds = vtkIdList::New();
+  for (vtkIdType ptId = 0; ptId < numBatchPts; ++ptId)
+  {
+    if (pointMap[ptId] == ptId)
+    {
+      pointMap[ptId] = keptIds->InsertNextId(ptId);
+    }
+    else
+    {
+      pointMap[ptId] = pointMap[pointMap[ptId]];
+    }
+  }
+  vtkIdType numNewPts = keptIds->GetNumberOfIds();
+
+  vtkPoints *newPoints = vtkPoints::New();
+  newPoints->SetDataType(pointsType);
+  batchPoints->GetPoints(keptIds, newPoints);
+  batchPoints->Delete();
+  output->SetPoints(newPoints);
+  newPoints->Delete();
+
+  // The point data of all the batches has the layout of this one.
+  vtkNew<vtkPointData> batchPD;
+  batchPD->InterpolateAllocate(inPD, 0);
+  outPD->CopyAllocate(batchPD.GetPointer(), numNewPts);
+  vtkIdType batchId = 0;
+  for (vtkIdType ptId = 0; ptId < numNewPts; ++ptId)
+  {
+    vtkIdType batchPtId = keptIds->GetId(ptId);
+    while (pointOffsets[batchId + 1] <= batchPtId)
+    {
+      ++batchId;
+    }
+    outPD->CopyData(batches[batchId].PointData,
+                    batchPtId - pointOffsets[batchId], ptId);
+  }
+  keptIds->Delete();
+
+  // Gather the verts, lines and polys, and their cell data in this order.
+  vtkIdType numOutCells[3] = { 0, 0, 0 };
+  vtkCellArray *newCells[3];
+  std::vector<vtkIdType> connectivityOffsets(numBatches + 1);
+  for (int kind = 0; kind < 3; ++kind)
+  {
+    connectivityOffsets[0] = 0;
+    for (batchId = 0; batchId < numBatches; ++batchId)
+    {
+      vtkCellArray *cells = batches[batchId].Cells[kind];
+      connectivityOffsets[batchId + 1] = connectivityOffsets[batchId];
+      if (cells)
+      {
+        numOutCells[kind] += cells->GetNumberOfCells();
+        connectivityOffsets[batchId + 1] +=
+          cells->GetNumberOfConnectivityEntries();
+      }
+    }
+    vtkIdTypeArray *connectivity = vtkIdTypeArray::New();
+    connectivity->SetNumberOfValues(connectivityOffsets[numBatches]);
+    vtkCutterGatherCells gatherCells;
+    gatherCells.Batches = cut.Batches;
+    gatherCells.Kind = kind;
+    gatherCells.PointOffsets = &pointOffsets[0];
+    gatherCells.ConnectivityOffsets = &connectivityOffsets[0];
+    gatherCells.PointMap = pointMap.empty() ? NULL : &pointMap[0];
+    gatherCells.Connectivity = connectivity->GetPointer(0);
+    vtkSMPTools::For(0, numBatches, gatherCells);
+    newCells[kind] = vtkCellArray::New();
+    newCells[kind]->SetCells(numOutCells[kind], connectivity);
+    connectivity->Delete();
+  }
+
+  outCD->CopyAllocate(inCD, numOutCells[0] + numOutCells[1] + numOutCells[2]);
+  vtkIdType outCellId = 0;
+  for (int kind = 0; kind < 3; ++kind)
+  {
+    for (batchId = 0; batchId < numBatches; ++batchId)
+    {
+      const std::vector<vtkIdType> &sources = batches[batchId].CellSources[kind];
+      for (size_t i = 0; i < sources.size(); ++i)
+      {
+        outCD->CopyData(inCD, sources[i], outCellId++);
+      }
+    }
+  }
+
+  cutScalars->Delete();
+  if ( this->GenerateCutScalars )
+  {
+    inPD->Delete();
+  }
+
+  if (numOutCells[0])
+  {
+    output->SetVerts(newCells[0]);
+  }
+  if (numOutCells[1])
+  {
+    output->SetLines(newCells[1]);
+  }
+  if (numOutCells[2])
+  {
+    output->SetPolys(newCells[2]);
+  }
+  for (int kind = 0; kind < 3; ++kind)
+  {
+    newCells[kind]->Delete();
+  }
+  output->Squeeze();
+}
+
 //----------------------------------------------------------------------------
 // Specify a spatial locator for merging points. By default,
 // an instance of vtkMergePoints is used.
@@ -1069,4 +1548,6 @@ void vtkCutter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Precision of the output points: "
      << this->OutputPointsPrecision << "\n";
+  os << indent << "Parallel Cutting: "
+     << (this->ParallelCutting ? "On\n" : "Off\n");
 }
@@ -223,6 +223,22 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   //@}
 
+  //@{
+  /**
+   * Turn on/off the threaded cutting of unstructured grids (vtkSMPTools).
+   * The cut function is evaluated at the points in parallel, so its
+   * EvaluateFunction() must be thread safe. The cells are then cut by
+   * batches, each with its own point merging, and the batches are merged
+   * into an output identical to the serial one. This applies when sorting
+   * by value and generating triangles, with the default locator
+   * (vtkMergePoints), and to grids without polyhedra; other cases use the
+   * serial path. Off by default.
+   */
+  vtkSetMacro(ParallelCutting,int);
+  vtkGetMacro(ParallelCutting,int);
+  vtkBooleanMacro(ParallelCutting,int);
+  //@}
+
 protected:
   vtkCutter(vtkImplicitFunction *cf=NULL);
   ~vtkCutter() VTK_OVERRIDE;
@@ -231,6 +247,7 @@ protected:
   int RequestUpdateExtent(vtkInformation *, vtkInformationVector **, vtkInformationVector *) VTK_OVERRIDE;
   int FillInputPortInformation(int port, vtkInformation *info) VTK_OVERRIDE;
   void UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output);
+  void UnstructuredGridCutterInParallel(vtkDataSet *input, vtkPolyData *output);
   void DataSetCutter(vtkDataSet *input, vtkPolyData *output);
   void StructuredPointsCutter(vtkDataSet *, vtkPolyData *,
                               vtkInformation *, vtkInformationVector **,
@@ -250,6 +267,7 @@ protected:
   vtkContourValues *ContourValues;
   int GenerateCutScalars;
   int OutputPointsPrecision;
+  int ParallelCutting;
 private:
   vtkCutter(const vtkCutter&) VTK_DELETE_FUNCTION;
   void operator=(const vtkCutter&) VTK_DELETE_FUNCTION;
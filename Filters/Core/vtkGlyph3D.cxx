@@ -14,18 +14,25 @@
 =========================================================================*/
 #include "vtkGlyph3D.h"
 
+#include "vtkArrayListTemplate.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCell.h"
+#include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -33,6 +40,8 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkGlyph3D);
 vtkCxxSetObjectMacro(vtkGlyph3D, SourceTransform, vtkTransform);
 
@@ -58,6 +67,8 @@ vtkGlyph3D::vtkGlyph3D()
   this->SetPointIdsName("InputPointIds");
   this->SetNumberOfInputPorts(2);
   this->FillCellData = 0;
+  this->ParallelGlyphing = 0;
+  this->GenerateInstances = 0;
   this->SourceTransform = 0;
 
   // by default process active point scalars
@@ -133,6 +144,12 @@ bool vtkGlyph3D::Execute(
     return true;
   }
 
+  if (this->ParallelGlyphing || this->GenerateInstances)
+  {
+    return this->GlyphInParallel(input, sourceVector, output, inSScalars,
+                                 inVectors);
+  }
+
   // this is used to respect blanking specified on uniform grids.
   vtkUniformGrid* inputUG = vtkUniformGrid::SafeDownCast(input);
 
@@ -732,6 +749,939 @@ bool vtkGlyph3D::Execute(
   return true;
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+
+// A source of the table of glyphs, ready to be copied concurrently.
+struct vtkGlyph3DSource
+{
+  vtkPolyData *Source; // NULL for the empty entries of the table
+  vtkIdType NumberOfPoints;
+  std::vector<double> Points; // transformed by the SourceTransform, if any
+  vtkDataArray *Normals;
+  vtkDataArray *TCoords;
+  // The verts, lines, polys and strips, in this order.
+  vtkIdType NumberOfCells[4];
+  vtkIdType ConnectivitySize[4];
+  const vtkIdType *Connectivity[4];
+};
+
+void vtkGlyph3DPrepareSource(vtkPolyData *source,
+                             vtkTransform *sourceTransform,
+                             vtkGlyph3DSource &glyphSource)
+{
+  glyphSource.Source = source;
+  glyphSource.NumberOfPoints = 0;
+  glyphSource.Normals = NULL;
+  glyphSource.TCoords = NULL;
+  for (int k = 0; k < 4; ++k)
+  {
+    glyphSource.NumberOfCells[k] = 0;
+    glyphSource.ConnectivitySize[k] = 0;
+    glyphSource.Connectivity[k] = NULL;
+  }
+  if (!source)
+  {
+    return;
+  }
+
+  vtkPoints *sourcePts = source->GetPoints();
+  vtkNew<vtkPoints> transformedSourcePts;
+  if (sourcePts && sourceTransform)
+  {
+    transformedSourcePts->SetDataTypeToDouble();
+    sourceTransform->TransformPoints(sourcePts,
+                                     transformedSourcePts.GetPointer());
+    sourcePts = transformedSourcePts.GetPointer();
+  }
+  if (sourcePts)
+  {
+    glyphSource.NumberOfPoints = sourcePts->GetNumberOfPoints();
+    glyphSource.Points.resize(3 * glyphSource.NumberOfPoints);
+    for (vtkIdType i = 0; i < glyphSource.NumberOfPoints; ++i)
+    {
+      sourcePts->GetPoint(i, &glyphSource.Points[3 * i]);
+    }
+  }
+  glyphSource.Normals = source->GetPointData()->GetNormals();
+  glyphSource.TCoords = source->GetPointData()->GetTCoords();
+
+  vtkCellArray *cells[4] = { source->GetVerts(), source->GetLines(),
+                             source->GetPolys(), source->GetStrips() };
+  for (int k = 0; k < 4; ++k)
+  {
+    glyphSource.NumberOfCells[k] = cells[k]->GetNumberOfCells();
+    glyphSource.ConnectivitySize[k] =
+      cells[k]->GetNumberOfConnectivityEntries();
+    if (glyphSource.ConnectivitySize[k] > 0)
+    {
+      glyphSource.Connectivity[k] = cells[k]->GetPointer();
+    }
+  }
+}
+
+// The glyph of an input point.
+struct vtkGlyph3DPoint
+{
+  int Index; // the source of the glyph, -1 if the point is not glyphed
+  double Scale[3]; // the (clamped) scale from the data
+  double V[3];
+  double VMag;
+};
+
+// Compute the glyph of the input points as the serial loop of
+// vtkGlyph3D::Execute() does.
+struct vtkGlyph3DEvaluator
+{
+  vtkUniformGrid *InputUG;
+  const unsigned char *GhostLevels;
+  vtkDataArray *Scalars;
+  vtkDataArray *Vectors; // the vectors or normals, if they are used
+  int Scaling;
+  int ScaleMode;
+  double ScaleFactor;
+  int Clamping;
+  double Range[2];
+  double Den;
+  int Orient;
+  int IndexMode;
+  const std::vector<vtkGlyph3DSource> *Sources;
+
+  void Evaluate(vtkIdType ptId, vtkGlyph3DPoint &glyph) const
+  {
+    double s = 0.0;
+    double *scale = glyph.Scale;
+    scale[0] = scale[1] = scale[2] = 1.0;
+    glyph.V[0] = glyph.V[1] = glyph.V[2] = 0.0;
+    glyph.VMag = 0.0;
+
+    if (this->Scalars)
+    {
+      s = this->Scalars->GetComponent(ptId, 0);
+      if (this->ScaleMode == VTK_SCALE_BY_SCALAR ||
+          this->ScaleMode == VTK_DATA_SCALING_OFF)
+      {
+        scale[0] = scale[1] = scale[2] = s;
+      }
+    }
+
+    if (this->Vectors)
+    {
+      this->Vectors->GetTuple(ptId, glyph.V);
+      glyph.VMag = vtkMath::Norm(glyph.V);
+      if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+      {
+        scale[0] = glyph.V[0];
+        scale[1] = glyph.V[1];
+        scale[2] = glyph.V[2];
+      }
+      else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+      {
+        scale[0] = scale[1] = scale[2] = glyph.VMag;
+      }
+    }
+
+    if (this->Clamping)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        scale[i] = (scale[i] < this->Range[0] ? this->Range[0] :
+                    (scale[i] > this->Range[1] ? this->Range[1] : scale[i]));
+        scale[i] = (scale[i] - this->Range[0]) / this->Den;
+      }
+    }
+
+    int numberOfSources = static_cast<int>(this->Sources->size());
+    glyph.Index = 0;
+    if (this->IndexMode != VTK_INDEXING_OFF)
+    {
+      double value =
+        (this->IndexMode == VTK_INDEXING_BY_SCALAR ? s : glyph.VMag);
+      int index = static_cast<int>(
+        (value - this->Range[0]) * numberOfSources / this->Den);
+      glyph.Index = (index < 0 ? 0 :
+        (index >= numberOfSources ? (numberOfSources - 1) : index));
+    }
+
+    if (glyph.Index < 0 || !(*this->Sources)[glyph.Index].Source ||
+        (this->GhostLevels &&
+         this->GhostLevels[ptId] & vtkDataSetAttributes::DUPLICATEPOINT) ||
+        (this->InputUG && !this->InputUG->IsPointVisible(ptId)))
+    {
+      glyph.Index = -1;
+    }
+  }
+
+  // The scale factors applied to the source when Scaling is on.
+  void GetScaleFactors(const vtkGlyph3DPoint &glyph, double scale[3]) const
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      scale[i] = (this->ScaleMode == VTK_DATA_SCALING_OFF ? this->ScaleFactor :
+                  glyph.Scale[i] * this->ScaleFactor);
+      if (scale[i] == 0.0)
+      {
+        scale[i] = 1.0e-10;
+      }
+    }
+  }
+
+  bool IsOriented(const vtkGlyph3DPoint &glyph) const
+  {
+    return this->Orient && this->Vectors && glyph.VMag > 0.0;
+  }
+};
+
+// Select the glyphed points and their source.
+struct vtkGlyph3DSelect
+{
+  const vtkGlyph3DEvaluator *Evaluator;
+  int *Indexes;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkGlyph3DPoint glyph;
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      this->Evaluator->Evaluate(ptId, glyph);
+      this->Indexes[ptId] = glyph.Index;
+    }
+  }
+};
+
+// The point data of a glyph that does not depend on its source.
+struct vtkGlyph3DPointData
+{
+  int ColorMode;
+  float *Vectors;
+  vtkDataArray *ColorScalars; // copied when coloring by scalar
+  vtkDataArray *Scalars; // the output scalars, if any
+  float *ScalarValues; // their values when they are computed
+  vtkIdType *PointIds;
+  ArrayList *Arrays;
+
+  void Copy(vtkIdType inPtId, const vtkGlyph3DPoint &glyph,
+            vtkIdType outId, vtkIdType numOutPts)
+  {
+    for (vtkIdType i = outId; i < outId + numOutPts; ++i)
+    {
+      if (this->Vectors)
+      {
+        float *v = this->Vectors + 3 * i;
+        v[0] = static_cast<float>(glyph.V[0]);
+        v[1] = static_cast<float>(glyph.V[1]);
+        v[2] = static_cast<float>(glyph.V[2]);
+      }
+      if (this->Scalars)
+      {
+        if (this->ColorMode == VTK_COLOR_BY_SCALAR)
+        {
+          this->Scalars->SetTuple(i, inPtId, this->ColorScalars);
+        }
+        else
+        {
+          this->ScalarValues[i] = static_cast<float>(
+            this->ColorMode == VTK_COLOR_BY_SCALE ? glyph.Scale[0] :
+            glyph.VMag);
+        }
+      }
+      if (this->PointIds)
+      {
+        this->PointIds[i] = inPtId;
+      }
+      if (this->Arrays)
+      {
+        this->Arrays->Copy(inPtId, i);
+      }
+    }
+  }
+};
+
+// Copy and transform the sources to the glyphed points. The points are
+// transformed as vtkLinearTransform::TransformPoints() and
+// TransformNormals() do, so that the output matches the serial one.
+struct vtkGlyph3DCopyGlyphs
+{
+  vtkDataSet *Input;
+  const vtkGlyph3DEvaluator *Evaluator;
+  const vtkIdType *GlyphPoints; // the input point of each glyph
+  const vtkIdType *PointOffsets; // the first output point of each glyph
+  // Per cell array, the first cell and connectivity entry of each glyph,
+  // the output connectivity and the id of its first cell.
+  const vtkIdType *CellOffsets[4];
+  const vtkIdType *ConnectivityOffsets[4];
+  vtkIdType *Connectivity[4];
+  vtkIdType FirstCellIds[4];
+  float *Points;
+  float *Normals;
+  float *TCoords;
+  int NumberOfTCoordsComponents;
+  vtkGlyph3DPointData PointData;
+  ArrayList *CellArrays;
+  vtkSMPThreadLocalObject<vtkTransform> Transform;
+
+  void operator()(vtkIdType glyphId, vtkIdType endGlyphId)
+  {
+    vtkTransform *trans = this->Transform.Local();
+    vtkGlyph3DPoint glyph;
+    double x[3], scale[3], tc[3], n[3], normalMatrix[4][4];
+    for ( ; glyphId < endGlyphId; ++glyphId)
+    {
+      vtkIdType inPtId = this->GlyphPoints[glyphId];
+      this->Evaluator->Evaluate(inPtId, glyph);
+      const vtkGlyph3DSource &source = (*this->Evaluator->Sources)[glyph.Index];
+      vtkIdType ptIncr = this->PointOffsets[glyphId];
+      vtkIdType numSourcePts = source.NumberOfPoints;
+
+      // Copy all topology (transformation independent)
+      for (int k = 0; k < 4; ++k)
+      {
+        const vtkIdType *conn = source.Connectivity[k];
+        const vtkIdType *connEnd = conn + source.ConnectivitySize[k];
+        vtkIdType *outConn =
+          this->Connectivity[k] + this->ConnectivityOffsets[k][glyphId];
+        while (conn < connEnd)
+        {
+          vtkIdType npts = *conn++;
+          *outConn++ = npts;
+          for (vtkIdType i = 0; i < npts; ++i)
+          {
+            *outConn++ = *conn++ + ptIncr;
+          }
+        }
+        if (this->CellArrays)
+        {
+          vtkIdType cellId =
+            this->FirstCellIds[k] + this->CellOffsets[k][glyphId];
+          for (vtkIdType i = 0; i < source.NumberOfCells[k]; ++i)
+          {
+            this->CellArrays->Copy(inPtId, cellId + i);
+          }
+        }
+      }
+
+      // Build the transform as the serial loop does
+      trans->Identity();
+      this->Input->GetPoint(inPtId, x);
+      trans->Translate(x[0], x[1], x[2]);
+      if (this->Evaluator->IsOriented(glyph))
+      {
+        const double *v = glyph.V;
+        if (v[1] == 0.0 && v[2] == 0.0)
+        {
+          if (v[0] < 0) //just flip x if we need to
+          {
+            trans->RotateWXYZ(180.0,0,1,0);
+          }
+        }
+        else
+        {
+          trans->RotateWXYZ(180.0, (v[0] + glyph.VMag) / 2.0, v[1] / 2.0,
+                            v[2] / 2.0);
+        }
+      }
+      if (this->Evaluator->Scaling)
+      {
+        this->Evaluator->GetScaleFactors(glyph, scale);
+        trans->Scale(scale[0], scale[1], scale[2]);
+      }
+      double (*matrix)[4] = trans->GetMatrix()->Element;
+
+      const double *in = source.Points.empty() ? NULL : &source.Points[0];
+      float *out = this->Points + 3 * ptIncr;
+      for (vtkIdType i = 0; i < numSourcePts; ++i, in += 3, out += 3)
+      {
+        out[0] = static_cast<float>(
+          matrix[0][0]*in[0]+matrix[0][1]*in[1]+matrix[0][2]*in[2]+matrix[0][3]);
+        out[1] = static_cast<float>(
+          matrix[1][0]*in[0]+matrix[1][1]*in[1]+matrix[1][2]*in[2]+matrix[1][3]);
+        out[2] = static_cast<float>(
+          matrix[2][0]*in[0]+matrix[2][1]*in[1]+matrix[2][2]*in[2]+matrix[2][3]);
+      }
+
+      if (this->Normals)
+      {
+        // to transform the normal, multiply by the transposed inverse matrix
+        vtkMatrix4x4::DeepCopy(*normalMatrix, trans->GetMatrix());
+        vtkMatrix4x4::Invert(*normalMatrix, *normalMatrix);
+        vtkMatrix4x4::Transpose(*normalMatrix, *normalMatrix);
+        out = this->Normals + 3 * ptIncr;
+        for (vtkIdType i = 0; i < numSourcePts; ++i, out += 3)
+        {
+          source.Normals->GetTuple(i, n);
+          out[0] = static_cast<float>(normalMatrix[0][0] * n[0] +
+            normalMatrix[0][1] * n[1] + normalMatrix[0][2] * n[2]);
+          out[1] = static_cast<float>(normalMatrix[1][0] * n[0] +
+            normalMatrix[1][1] * n[1] + normalMatrix[1][2] * n[2]);
+          out[2] = static_cast<float>(normalMatrix[2][0] * n[0] +
+            normalMatrix[2][1] * n[1] + normalMatrix[2][2] * n[2]);
+          vtkMath::Normalize(out);
+        }
+      }
+
+      if (this->TCoords)
+      {
+        int numComps = this->NumberOfTCoordsComponents;
+        out = this->TCoords + numComps * ptIncr;
+        for (vtkIdType i = 0; i < numSourcePts; ++i)
+        {
+          source.TCoords->GetTuple(i, tc);
+          for (int j = 0; j < numComps; ++j)
+          {
+            *out++ = static_cast<float>(tc[j]);
+          }
+        }
+      }
+
+      this->PointData.Copy(inPtId, glyph, ptIncr, numSourcePts);
+    }
+  }
+};
+
+// Describe the glyphs for vtkGlyph3DMapper.
+struct vtkGlyph3DCopyInstances
+{
+  vtkDataSet *Input;
+  const vtkGlyph3DEvaluator *Evaluator;
+  const vtkIdType *GlyphPoints;
+  vtkPoints *Points;
+  double *ScaleFactors;
+  double *Orientations;
+  int *SourceIndexes;
+  vtkGlyph3DPointData PointData;
+
+  void operator()(vtkIdType glyphId, vtkIdType endGlyphId)
+  {
+    vtkGlyph3DPoint glyph;
+    double x[3];
+    for ( ; glyphId < endGlyphId; ++glyphId)
+    {
+      vtkIdType inPtId = this->GlyphPoints[glyphId];
+      this->Evaluator->Evaluate(inPtId, glyph);
+      this->Input->GetPoint(inPtId, x);
+      this->Points->SetPoint(glyphId, x);
+
+      double *scale = this->ScaleFactors + 3 * glyphId;
+      if (this->Evaluator->Scaling)
+      {
+        this->Evaluator->GetScaleFactors(glyph, scale);
+      }
+      else
+      {
+        scale[0] = scale[1] = scale[2] = 1.0;
+      }
+      double *orientation = this->Orientations + 3 * glyphId;
+      bool oriented = this->Evaluator->IsOriented(glyph);
+      for (int i = 0; i < 3; ++i)
+      {
+        orientation[i] = (oriented ? glyph.V[i] : 0.0);
+      }
+      if (this->SourceIndexes)
+      {
+        this->SourceIndexes[glyphId] = glyph.Index;
+      }
+
+      this->PointData.Copy(inPtId, glyph, glyphId, 1);
+    }
+  }
+};
+
+// The size of the source of a glyphed point, from a table of the sizes of
+// the sources.
+struct vtkGlyph3DSourceSize
+{
+  const int *Indexes;
+  const vtkIdType *Sizes;
+
+  vtkIdType operator()(vtkIdType ptId) const
+  {
+    return this->Sizes[this->Indexes[ptId]];
+  }
+};
+
+// The offsets of the glyphs in the output, the exclusive prefix sums of the
+// sizes of their sources, followed by the total.
+void vtkGlyph3DComputeOffsets(const std::vector<vtkIdType> &glyphPoints,
+                              const int *indexes,
+                              const std::vector<vtkIdType> &sizes,
+                              std::vector<vtkIdType> &offsets)
+{
+  vtkGlyph3DSourceSize size;
+  size.Indexes = indexes;
+  size.Sizes = sizes.empty() ? NULL : &sizes[0];
+  offsets.resize(glyphPoints.size() + 1);
+  vtkSMPTools::Transform(glyphPoints.begin(), glyphPoints.end(),
+                         offsets.begin(), size);
+  offsets.back() = vtkSMPTools::ExclusiveScan(
+    offsets.begin(), offsets.end() - 1, offsets.begin(),
+    static_cast<vtkIdType>(0));
+}
+
+// Copy the tuples of the arrays that are not data arrays (e.g., string
+// arrays), which ArrayList does not process. The output tuples
+// firstId + offsets[g] to firstId + offsets[g + 1] come from the input
+// point glyphPoints[g].
+void vtkGlyph3DCopyOtherArrays(vtkDataSetAttributes *inDA,
+                               vtkDataSetAttributes *outDA,
+                               vtkIdType numOutTuples,
+                               const std::vector<vtkIdType> &glyphPoints,
+                               const std::vector<vtkIdType> &offsets,
+                               vtkIdType firstId)
+{
+  for (int i = 0; i < outDA->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray *outArray = outDA->GetAbstractArray(i);
+    vtkAbstractArray *inArray = (outArray && outArray->GetName()) ?
+      inDA->GetAbstractArray(outArray->GetName()) : NULL;
+    if (inArray && !vtkArrayDownCast<vtkDataArray>(outArray))
+    {
+      outArray->SetNumberOfTuples(numOutTuples);
+      for (size_t g = 0; g < glyphPoints.size(); ++g)
+      {
+        for (vtkIdType outId = firstId + offsets[g];
+             outId < firstId + offsets[g + 1]; ++outId)
+        {
+          outArray->SetTuple(outId, glyphPoints[g], inArray);
+        }
+      }
+    }
+  }
+}
+
+} // end anon namespace
+
+//----------------------------------------------------------------------------
+bool vtkGlyph3D::GlyphInParallel(
+  vtkDataSet* input,
+  vtkInformationVector* sourceVector,
+  vtkPolyData* output,
+  vtkDataArray *inSScalars,
+  vtkDataArray *inVectors)
+{
+  vtkPointData *pd = input->GetPointData();
+  vtkPointData *outputPD = output->GetPointData();
+  vtkCellData *outputCD = output->GetCellData();
+  int numberOfSources = this->GetNumberOfInputConnections(1);
+  vtkPolyData *source = this->GetSource(0, sourceVector);
+
+  vtkDebugMacro(<<"Generating glyphs in parallel");
+
+  vtkDataArray *inNormals = this->GetInputArrayToProcess(2, input);
+  vtkDataArray *inCScalars = this->GetInputArrayToProcess(3, input);
+  if (inCScalars == NULL)
+  {
+    inCScalars = inSScalars;
+  }
+
+  vtkGlyph3DEvaluator evaluator;
+  evaluator.InputUG = vtkUniformGrid::SafeDownCast(input);
+  evaluator.GhostLevels = NULL;
+  vtkDataArray *temp = pd ?
+    pd->GetArray(vtkDataSetAttributes::GhostArrayName()) : NULL;
+  if (temp && temp->GetDataType() == VTK_UNSIGNED_CHAR &&
+      temp->GetNumberOfComponents() == 1)
+  {
+    evaluator.GhostLevels =
+      static_cast<vtkUnsignedCharArray *>(temp)->GetPointer(0);
+  }
+
+  vtkIdType numPts = input->GetNumberOfPoints();
+  if (numPts < 1)
+  {
+    vtkDebugMacro(<<"No points to glyph!");
+    return true;
+  }
+
+  // Check input for consistency
+  //
+  double den = this->Range[1] - this->Range[0];
+  if (den == 0.0)
+  {
+    den = 1.0;
+  }
+  bool haveVectors = this->VectorMode != VTK_VECTOR_ROTATION_OFF &&
+    ((this->VectorMode == VTK_USE_VECTOR && inVectors != NULL) ||
+     (this->VectorMode == VTK_USE_NORMAL && inNormals != NULL));
+
+  if ( (this->IndexMode == VTK_INDEXING_BY_SCALAR && !inSScalars) ||
+       (this->IndexMode == VTK_INDEXING_BY_VECTOR &&
+       ((!inVectors && this->VectorMode == VTK_USE_VECTOR) ||
+        (!inNormals && this->VectorMode == VTK_USE_NORMAL))) )
+  {
+    if ( !source )
+    {
+      vtkErrorMacro(<<"Indexing on but don't have data to index with");
+      return true;
+    }
+    else
+    {
+      vtkWarningMacro(<<"Turning indexing off: no data to index with");
+      this->IndexMode = VTK_INDEXING_OFF;
+    }
+  }
+
+  vtkDataArray *array3D = NULL;
+  if (haveVectors)
+  {
+    array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
+    if (array3D->GetNumberOfComponents() > 3)
+    {
+      vtkErrorMacro(<<"vtkDataArray "<<array3D->GetName()<<" has more than 3 components.\n");
+      return false;
+    }
+  }
+
+  // Prepare the table of sources, or the only source (a line by default).
+  vtkNew<vtkPolyData> defaultSource;
+  std::vector<vtkGlyph3DSource> sources;
+  bool haveNormals, haveTCoords;
+  if (this->IndexMode != VTK_INDEXING_OFF)
+  {
+    pd = NULL;
+    sources.resize(numberOfSources);
+    haveNormals = true;
+    for (int i = 0; i < numberOfSources; ++i)
+    {
+      vtkGlyph3DPrepareSource(this->GetSource(i, sourceVector),
+                              this->SourceTransform, sources[i]);
+      if (sources[i].Source && !sources[i].Normals)
+      {
+        haveNormals = false;
+      }
+    }
+    haveTCoords = false;
+  }
+  else
+  {
+    if (!source)
+    {
+      vtkNew<vtkPoints> defaultPoints;
+      defaultPoints->InsertNextPoint(0, 0, 0);
+      defaultPoints->InsertNextPoint(1, 0, 0);
+      vtkIdType defaultPointIds[2] = { 0, 1 };
+      defaultSource->Allocate();
+      defaultSource->SetPoints(defaultPoints.GetPointer());
+      defaultSource->InsertNextCell(VTK_LINE, 2, defaultPointIds);
+      source = defaultSource.GetPointer();
+    }
+    sources.resize(1);
+    vtkGlyph3DPrepareSource(source, this->SourceTransform, sources[0]);
+    haveNormals = sources[0].Normals != NULL;
+    haveTCoords = sources[0].TCoords != NULL;
+  }
+
+  evaluator.Scalars = inSScalars;
+  evaluator.Vectors = array3D;
+  evaluator.Scaling = this->Scaling;
+  evaluator.ScaleMode = this->ScaleMode;
+  evaluator.ScaleFactor = this->ScaleFactor;
+  evaluator.Clamping = this->Clamping;
+  evaluator.Range[0] = this->Range[0];
+  evaluator.Range[1] = this->Range[1];
+  evaluator.Den = den;
+  evaluator.Orient = this->Orient;
+  evaluator.IndexMode = this->IndexMode;
+  evaluator.Sources = &sources;
+
+  // Select the glyphed points and their source in parallel. The ghost array
+  // of a uniform grid is cached by its first IsPointVisible() call.
+  if (evaluator.InputUG)
+  {
+    evaluator.InputUG->IsPointVisible(0);
+  }
+  std::vector<int> indexes(numPts);
+  vtkGlyph3DSelect select;
+  select.Evaluator = &evaluator;
+  select.Indexes = &indexes[0];
+  vtkSMPTools::For(0, numPts, select);
+
+  this->UpdateProgress(0.2);
+  if (this->GetAbortExecute())
+  {
+    return true;
+  }
+
+  // IsPointVisible() may not be thread safe, so the glyphed points are
+  // gathered here. The first output point, cell and connectivity entry of
+  // each glyph are then prefix sums over the glyphs.
+  std::vector<vtkIdType> glyphPoints;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (indexes[ptId] >= 0 && this->IsPointVisible(input, ptId))
+    {
+      glyphPoints.push_back(ptId);
+    }
+  }
+  vtkIdType numGlyphs = static_cast<vtkIdType>(glyphPoints.size());
+  std::vector<vtkIdType> sizes(sources.size());
+  std::vector<vtkIdType> pointOffsets;
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    sizes[i] = sources[i].NumberOfPoints;
+  }
+  vtkGlyph3DComputeOffsets(glyphPoints, &indexes[0], sizes, pointOffsets);
+  std::vector<vtkIdType> cellOffsets[4], connOffsets[4];
+  for (int k = 0; k < 4; ++k)
+  {
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+      sizes[i] = sources[i].NumberOfCells[k];
+    }
+    vtkGlyph3DComputeOffsets(glyphPoints, &indexes[0], sizes,
+                             cellOffsets[k]);
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+      sizes[i] = sources[i].ConnectivitySize[k];
+    }
+    vtkGlyph3DComputeOffsets(glyphPoints, &indexes[0], sizes,
+                             connOffsets[k]);
+  }
+  vtkIdType numNewPts =
+    (this->GenerateInstances ? numGlyphs : pointOffsets.back());
+  vtkIdType firstCellIds[4];
+  vtkIdType numNewCells = 0;
+  for (int k = 0; k < 4; ++k)
+  {
+    firstCellIds[k] = numNewCells;
+    numNewCells += cellOffsets[k].back();
+  }
+
+  // Allocate storage for output PolyData
+  //
+  outputPD->CopyVectorsOff();
+  outputPD->CopyNormalsOff();
+  outputPD->CopyTCoordsOff();
+  ArrayList pointArrays;
+  ArrayList cellArrays;
+  bool fillCellData = pd && this->FillCellData && !this->GenerateInstances;
+  if (pd)
+  {
+    outputPD->CopyAllocate(pd, numNewPts);
+    pointArrays.AddArrays(numNewPts, pd, outputPD, 0.0, false);
+  }
+  if (fillCellData)
+  {
+    outputCD->CopyAllocate(pd, numNewCells);
+    cellArrays.AddArrays(numNewCells, pd, outputCD, 0.0, false);
+  }
+
+  vtkNew<vtkPoints> newPts;
+  vtkPointSet *inputPS = vtkPointSet::SafeDownCast(input);
+  if (this->GenerateInstances && inputPS && inputPS->GetPoints())
+  {
+    newPts->SetDataType(inputPS->GetPoints()->GetDataType());
+  }
+  newPts->SetNumberOfPoints(numNewPts);
+
+  vtkSmartPointer<vtkIdTypeArray> pointIds;
+  if ( this->GeneratePointIds )
+  {
+    pointIds = vtkSmartPointer<vtkIdTypeArray>::New();
+    pointIds->SetName(this->PointIdsName);
+    pointIds->SetNumberOfValues(numNewPts);
+    outputPD->AddArray(pointIds);
+  }
+  vtkSmartPointer<vtkDataArray> newScalars;
+  if ( this->ColorMode == VTK_COLOR_BY_SCALAR && inCScalars )
+  {
+    newScalars.TakeReference(inCScalars->NewInstance());
+    newScalars->SetNumberOfComponents(inCScalars->GetNumberOfComponents());
+    newScalars->SetNumberOfTuples(numNewPts);
+    newScalars->SetName(inCScalars->GetName());
+  }
+  else if ( (this->ColorMode == VTK_COLOR_BY_SCALE) && inSScalars)
+  {
+    newScalars = vtkSmartPointer<vtkFloatArray>::New();
+    newScalars->SetNumberOfTuples(numNewPts);
+    newScalars->SetName("GlyphScale");
+    if (this->ScaleMode == VTK_SCALE_BY_SCALAR)
+    {
+      newScalars->SetName(inSScalars->GetName());
+    }
+  }
+  else if ( (this->ColorMode == VTK_COLOR_BY_VECTOR) && haveVectors)
+  {
+    newScalars = vtkSmartPointer<vtkFloatArray>::New();
+    newScalars->SetNumberOfTuples(numNewPts);
+    newScalars->SetName("VectorMagnitude");
+  }
+  vtkSmartPointer<vtkFloatArray> newVectors;
+  if ( haveVectors )
+  {
+    newVectors = vtkSmartPointer<vtkFloatArray>::New();
+    newVectors->SetNumberOfComponents(3);
+    newVectors->SetNumberOfTuples(numNewPts);
+    newVectors->SetName("GlyphVector");
+  }
+
+  vtkGlyph3DPointData pointData;
+  pointData.ColorMode = this->ColorMode;
+  pointData.Vectors = newVectors ? newVectors->GetPointer(0) : NULL;
+  pointData.ColorScalars = inCScalars;
+  pointData.Scalars = newScalars;
+  pointData.ScalarValues = (newScalars && this->ColorMode != VTK_COLOR_BY_SCALAR) ?
+    static_cast<vtkFloatArray *>(newScalars.GetPointer())->GetPointer(0) : NULL;
+  pointData.PointIds = pointIds ? pointIds->GetPointer(0) : NULL;
+  pointData.Arrays = pd ? &pointArrays : NULL;
+
+  vtkSmartPointer<vtkFloatArray> newNormals;
+  vtkSmartPointer<vtkFloatArray> newTCoords;
+  if (this->GenerateInstances)
+  {
+    vtkNew<vtkDoubleArray> scaleFactors;
+    scaleFactors->SetName("GlyphScaleFactors");
+    scaleFactors->SetNumberOfComponents(3);
+    scaleFactors->SetNumberOfTuples(numGlyphs);
+    vtkNew<vtkDoubleArray> orientations;
+    orientations->SetName("GlyphOrientation");
+    orientations->SetNumberOfComponents(3);
+    orientations->SetNumberOfTuples(numGlyphs);
+    vtkNew<vtkIntArray> sourceIndexes;
+    sourceIndexes->SetName("GlyphSourceIndex");
+    sourceIndexes->SetNumberOfTuples(numGlyphs);
+
+    vtkGlyph3DCopyInstances copyInstances;
+    copyInstances.Input = input;
+    copyInstances.Evaluator = &evaluator;
+    copyInstances.GlyphPoints = numGlyphs ? &glyphPoints[0] : NULL;
+    copyInstances.Points = newPts.GetPointer();
+    copyInstances.ScaleFactors = scaleFactors->GetPointer(0);
+    copyInstances.Orientations = orientations->GetPointer(0);
+    copyInstances.SourceIndexes = this->IndexMode != VTK_INDEXING_OFF ?
+      sourceIndexes->GetPointer(0) : NULL;
+    copyInstances.PointData = pointData;
+    vtkSMPTools::For(0, numGlyphs, copyInstances);
+
+    if (pd)
+    {
+      std::vector<vtkIdType> instanceOffsets(numGlyphs + 1);
+      for (vtkIdType i = 0; i <= numGlyphs; ++i)
+      {
+        instanceOffsets[i] = i;
+      }
+      vtkGlyph3DCopyOtherArrays(pd, outputPD, numNewPts, glyphPoints,
+                                instanceOffsets, 0);
+    }
+    outputPD->AddArray(scaleFactors.GetPointer());
+    outputPD->AddArray(orientations.GetPointer());
+    if (copyInstances.SourceIndexes)
+    {
+      outputPD->AddArray(sourceIndexes.GetPointer());
+    }
+  }
+  else
+  {
+    vtkNew<vtkIdTypeArray> connectivity[4];
+    for (int k = 0; k < 4; ++k)
+    {
+      connectivity[k]->SetNumberOfValues(connOffsets[k].back());
+    }
+    if ( haveNormals )
+    {
+      newNormals = vtkSmartPointer<vtkFloatArray>::New();
+      newNormals->SetNumberOfComponents(3);
+      newNormals->SetNumberOfTuples(numNewPts);
+      newNormals->SetName("Normals");
+    }
+    int numTCoordsComps = 0;
+    if (haveTCoords)
+    {
+      newTCoords = vtkSmartPointer<vtkFloatArray>::New();
+      numTCoordsComps = sources[0].TCoords->GetNumberOfComponents();
+      newTCoords->SetNumberOfComponents(numTCoordsComps);
+      newTCoords->SetNumberOfTuples(numNewPts);
+      newTCoords->SetName("TCoords");
+    }
+
+    vtkGlyph3DCopyGlyphs copyGlyphs;
+    copyGlyphs.Input = input;
+    copyGlyphs.Evaluator = &evaluator;
+    copyGlyphs.GlyphPoints = numGlyphs ? &glyphPoints[0] : NULL;
+    copyGlyphs.PointOffsets = &pointOffsets[0];
+    for (int k = 0; k < 4; ++k)
+    {
+      copyGlyphs.CellOffsets[k] = &cellOffsets[k][0];
+      copyGlyphs.ConnectivityOffsets[k] = &connOffsets[k][0];
+      copyGlyphs.Connectivity[k] = connectivity[k]->GetPointer(0);
+      copyGlyphs.FirstCellIds[k] = firstCellIds[k];
+    }
+    copyGlyphs.Points =
+      static_cast<vtkFloatArray *>(newPts->GetData())->GetPointer(0);
+    copyGlyphs.Normals = newNormals ? newNormals->GetPointer(0) : NULL;
+    copyGlyphs.TCoords = newTCoords ? newTCoords->GetPointer(0) : NULL;
+    copyGlyphs.NumberOfTCoordsComponents = numTCoordsComps;
+    copyGlyphs.PointData = pointData;
+    copyGlyphs.CellArrays = fillCellData ? &cellArrays : NULL;
+    vtkSMPTools::For(0, numGlyphs, copyGlyphs);
+
+    if (pd)
+    {
+      vtkGlyph3DCopyOtherArrays(pd, outputPD, numNewPts, glyphPoints,
+                                pointOffsets, 0);
+    }
+    if (fillCellData)
+    {
+      for (int k = 0; k < 4; ++k)
+      {
+        vtkGlyph3DCopyOtherArrays(pd, outputCD, numNewCells, glyphPoints,
+                                  cellOffsets[k], firstCellIds[k]);
+      }
+    }
+
+    for (int k = 0; k < 4; ++k)
+    {
+      if (cellOffsets[k].back() == 0)
+      {
+        continue;
+      }
+      vtkNew<vtkCellArray> cells;
+      cells->SetCells(cellOffsets[k].back(), connectivity[k].GetPointer());
+      switch (k)
+      {
+        case 0:
+          output->SetVerts(cells.GetPointer());
+          break;
+        case 1:
+          output->SetLines(cells.GetPointer());
+          break;
+        case 2:
+          output->SetPolys(cells.GetPointer());
+          break;
+        default:
+          output->SetStrips(cells.GetPointer());
+      }
+    }
+  }
+
+  // Update ourselves and release memory
+  //
+  output->SetPoints(newPts.GetPointer());
+
+  if (newScalars)
+  {
+    int idx = outputPD->AddArray(newScalars);
+    outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+  }
+
+  if (newVectors)
+  {
+    outputPD->SetVectors(newVectors);
+  }
+
+  if (newNormals)
+  {
+    outputPD->SetNormals(newNormals);
+  }
+
+  if (newTCoords)
+  {
+    outputPD->SetTCoords(newTCoords);
+  }
+
+  return true;
+}
+
 //----------------------------------------------------------------------------
 // Specify a source object at a specified table location.
 void vtkGlyph3D::SetSourceConnection(int id, vtkAlgorithmOutput* algOutput)
@@ -879,6 +1829,10 @@ void vtkGlyph3D::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Fill Cell Data: " << (this->FillCellData ? "On\n" : "Off\n");
+  os << indent << "Parallel Glyphing: "
+     << (this->ParallelGlyphing ? "On\n" : "Off\n");
+  os << indent << "Generate Instances: "
+     << (this->GenerateInstances ? "On\n" : "Off\n");
 
   os << indent << "SourceTransform: ";
   if (this->SourceTransform)
@@ -73,6 +73,12 @@
  * vtkAlgorithm. The first array is scalars, the next vectors, the next
  * normals and finally color scalars.
  *
+ * @warning
+ * With ParallelGlyphing on, the glyphs are copied and transformed with
+ * vtkSMPTools. With GenerateInstances on, the output only describes the
+ * glyphs (one point per glyph with its scale and orientation) for
+ * vtkGlyph3DMapper to render, instead of the glyph geometry.
+ *
  * @sa
  * vtkTensorGlyph
 */
@@ -287,6 +293,43 @@ public:
   vtkBooleanMacro(FillCellData,int);
   //@}
 
+  //@{
+  /**
+   * Turn on/off the parallel generation of the glyphs. When on, the glyphs
+   * are counted first, which gives the location of the points and cells of
+   * every glyph in the output, then they are copied and transformed with
+   * vtkSMPTools. The output is the same as the serial one, except that the
+   * cells of sources mixing cell types (e.g., lines and polygons) are
+   * numbered by type over all the glyphs, as vtkPolyData numbers them,
+   * instead of glyph after glyph. IsPointVisible() is still called from a
+   * single thread. Off by default.
+   */
+  vtkSetMacro(ParallelGlyphing,int);
+  vtkGetMacro(ParallelGlyphing,int);
+  vtkBooleanMacro(ParallelGlyphing,int);
+  //@}
+
+  //@{
+  /**
+   * Turn on/off the generation of glyph instances instead of glyph
+   * geometry. When on, the output has a point (and no cell) for every
+   * glyph, located at the input point, with the point data the glyph points
+   * would have (the copied input point data, the color scalars,
+   * "GlyphVector" and the point ids) and the following arrays:
+   * "GlyphScaleFactors", the x, y and z scale factors applied to the source,
+   * "GlyphOrientation", the direction the source x axis is rotated to (zero
+   * when the glyph is not oriented), and "GlyphSourceIndex", the index of
+   * the source in the table of sources when indexing is on. These are the
+   * arrays vtkGlyph3DMapper::ConfigureForGlyph3DInstances() sets up the
+   * mapper with, so that the glyphs are only expanded on the GPU. The
+   * SourceTransform is not part of the instances: apply it to the sources
+   * given to the mapper. Instances are generated in parallel. Off by default.
+   */
+  vtkSetMacro(GenerateInstances,int);
+  vtkGetMacro(GenerateInstances,int);
+  vtkBooleanMacro(GenerateInstances,int);
+  //@}
+
   /**
    * This can be overwritten by subclass to return 0 when a point is
    * blanked. Default implementation is to always return 1;
@@ -334,6 +377,15 @@ protected:
                        vtkDataArray *inVectors);
   //@}
 
+  /**
+   * The parallel algorithm (see ParallelGlyphing and GenerateInstances).
+   */
+  bool GlyphInParallel(vtkDataSet* input,
+                       vtkInformationVector* sourceVector,
+                       vtkPolyData* output,
+                       vtkDataArray *inSScalars,
+                       vtkDataArray *inVectors);
+
   vtkPolyData **Source; // Geometry to copy to each point
   int Scaling; // Determine whether scaling of geometry is performed
   int ScaleMode; // Scale by scalar value or vector magnitude
@@ -346,6 +398,8 @@ protected:
   int IndexMode; // what to use to index into glyph table
   int GeneratePointIds; // produce input points ids for each output point
   int FillCellData; // whether to fill output cell data
+  int ParallelGlyphing; // whether to generate the glyphs with vtkSMPTools
+  int GenerateInstances; // produce glyph instances instead of geometry
   char *PointIdsName;
   vtkTransform* SourceTransform;
 
@@ -19,6 +19,7 @@
 #include <limits>
 #include <vector>
 
+#include "vtkAttributeAveragerTemplate.h"
 #include "vtkCellData.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
@@ -27,6 +28,10 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPAlgorithmProgress.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 
 #define VTK_EPSILON 1.e-6
 
@@ -57,6 +62,8 @@ public:
   typedef std::vector<Bin> HistogramBins;
   typedef HistogramBins::iterator BinIt;
 
+  Histogram() : Counter(0) {}
+
   Histogram(vtkIdType size)
   {
     // Construct the array of bins.
@@ -148,6 +155,67 @@ vtkIdType Histogram::IndexOfLargestBin()
   return std::max_element(this->Bins.begin(), it2, BinCountCmp)->Index;
 }
 
+// Averages the point data onto a range of cells, all the arrays at once. For
+// categorical data, the point data of a majority point are copied instead,
+// and its id is recorded in Sources (-1 for the cells without points).
+// The progress is counted, and the abort checked, for each range of cells.
+struct AveragePointsToCells
+{
+  vtkDataSet *Input;
+  vtkAttributeAveragerList *Arrays;
+  vtkDataArray *Categories;
+  vtkIdType *Sources;
+  vtkSMPAlgorithmProgress *Progress;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+  vtkSMPThreadLocal<Histogram> Histograms;
+
+  AveragePointsToCells(vtkDataSet *input, vtkAttributeAveragerList *arrays,
+                       vtkDataArray *categories, vtkIdType *sources,
+                       vtkSMPAlgorithmProgress *progress, int maxCellSize) :
+    Input(input), Arrays(arrays), Categories(categories), Sources(sources),
+    Progress(progress), Histograms(Histogram(maxCellSize))
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    if (this->Progress->IsAborted())
+    {
+      return;
+    }
+    vtkIdList *cellPts = this->CellPoints.Local();
+    Histogram &hist = this->Histograms.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      this->Input->GetCellPoints(cellId, cellPts);
+      vtkIdType numPts = cellPts->GetNumberOfIds();
+      const vtkIdType *pts = cellPts->GetPointer(0);
+
+      if (numPts == 0)
+      {
+        this->Arrays->Average(0, pts, cellId);
+        this->Sources[cellId] = -1;
+      }
+      else if (!this->Categories)
+      {
+        this->Arrays->Interpolate(numPts, pts, cellId);
+        this->Sources[cellId] = 0;
+      }
+      else
+      {
+        hist.Reset(numPts);
+        for (vtkIdType i = 0; i < numPts; i++)
+        {
+          hist.Fill(pts[i], this->Categories->GetComponent(pts[i], 0));
+        }
+        this->Sources[cellId] = hist.IndexOfLargestBin();
+        this->Arrays->Copy(this->Sources[cellId], cellId);
+      }
+    }
+    this->Progress->Advance(end - begin);
+  }
+};
+
 }
 
 
@@ -175,7 +243,7 @@ int vtkPointDataToCellData::RequestData(
   vtkDataSet *input = vtkDataSet::SafeDownCast(
     inInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType cellId, ptId, pointId;
+  vtkIdType cellId, ptId;
   vtkIdType numCells, numPts;
   vtkPointData *inPD=input->GetPointData();
   vtkCellData *outCD=output->GetCellData();
@@ -196,8 +264,6 @@ int vtkPointDataToCellData::RequestData(
   }
   weights=new double[maxCellSize];
 
-  Histogram hist(maxCellSize);
-
   if (this->CategoricalData == 1)
   {
     // If the categorical data flag is enabled, then a) there must be scalars
@@ -234,52 +300,45 @@ int vtkPointDataToCellData::RequestData(
 
   // notice that inPD and outCD are vtkPointData and vtkCellData; respectively.
   // It's weird, but it works.
-  outCD->InterpolateAllocate(inPD,numCells);
-
-  int abort=0;
-  vtkIdType progressInterval=numCells/20 + 1;
-  for (cellId=0; cellId < numCells && !abort; cellId++)
+  vtkDataSetAttributes::FieldList pfl(1);
+  pfl.InitializeFieldList(inPD);
+  outCD->InterpolateAllocate(pfl, numCells, numCells);
+
+  vtkAttributeAveragerList arrays;
+  arrays.AddArrays(pfl, inPD, outCD, numCells);
+
+  // GetCellPoints() is thread safe once it has been called from a single
+  // thread. The cells are processed in parallel, all the arrays at once.
+  input->GetCellPoints(0, cellPts);
+  std::vector<vtkIdType> sources(numCells);
+  vtkSMPAlgorithmProgress progress(this, numCells, 0.0, 0.9);
+  AveragePointsToCells average(input, &arrays,
+    this->CategoricalData ? inPD->GetScalars() : NULL, &sources[0],
+    &progress, maxCellSize);
+  vtkSMPTools::For(0, numCells, numCells / 100 + 1, average);
+
+  // The arrays that are not data arrays (rare) are processed serially.
+  for (cellId=0; cellId < numCells && !arrays.Others.empty() &&
+         !progress.IsAborted(); cellId++)
   {
-    if ( !(cellId % progressInterval) )
+    if (sources[cellId] < 0)
     {
-      this->UpdateProgress((double)cellId/numCells);
-      abort = GetAbortExecute();
+      continue;
     }
-
-    input->GetCellPoints(cellId, cellPts);
-    numPts = cellPts->GetNumberOfIds();
-
-    if (numPts == 0)
+    if (this->CategoricalData)
     {
+      arrays.CopyOther(sources[cellId], cellId);
       continue;
     }
 
-    // If we aren't dealing with categorical data...
-    if (!(this->CategoricalData))
-    {
-      // ...then we simply provide each point with an equal weight value and
-      // interpolate.
-      weight = 1.0 / numPts;
-      for (ptId=0; ptId < numPts; ptId++)
-      {
-        weights[ptId] = weight;
-      }
-      outCD->InterpolatePoint(inPD, cellId, cellPts, weights);
-    }
-    else
+    input->GetCellPoints(cellId, cellPts);
+    numPts = cellPts->GetNumberOfIds();
+    weight = 1.0 / numPts;
+    for (ptId=0; ptId < numPts; ptId++)
     {
-      // ...otherwise, we populate a histogram from the scalar values at each
-      // point, and then select the bin with the most elements.
-      hist.Reset(numPts);
-      for (ptId=0; ptId < numPts; ptId++)
-      {
-        pointId = cellPts->GetId(ptId);
-        hist.Fill(pointId,
-                  input->GetPointData()->GetScalars()->GetTuple1(pointId));
-      }
-
-      outCD->CopyData(inPD, hist.IndexOfLargestBin(), cellId);
+      weights[ptId] = weight;
     }
+    arrays.InterpolateOther(cellPts, weights, cellId);
   }
 
   if ( !this->PassPointData )
@@ -23,6 +23,10 @@
  * data can be passed through to the output as well.
  *
  * @warning
+ * The averaging is threaded with vtkSMPTools: all the point arrays are
+ * averaged (or, for categorical data, copied) together over ranges of cells.
+ *
+ * @warning
  * This filter is an abstract filter, that is, the output is an abstract type
  * (i.e., vtkDataSet). Use the convenience methods (e.g.,
  * GetPolyDataOutput(), GetStructuredPointsOutput(), etc.) to get the type
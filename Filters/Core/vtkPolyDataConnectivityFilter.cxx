@@ -17,6 +17,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCell.h"
+#include "vtkConnectivityLabeler.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -58,6 +59,7 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
   this->VisitedPointIds = vtkIdList::New();
 
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->ParallelLabeling = 0;
 }
 
 vtkPolyDataConnectivityFilter::~vtkPolyDataConnectivityFilter()
@@ -186,8 +188,32 @@ int vtkPolyDataConnectivityFilter::RequestData(
   this->PointIds = vtkIdList::New();
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
 
+  vtkConnectivityLabeler labeler;
+  if ( this->InScalars )
+  {
+    labeler.SetScalarCriterion(this->InScalars, this->ScalarRange,
+                               this->FullScalarConnectivity != 0);
+  }
+
   if ( this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
   this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
+  this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION &&
+  this->ParallelLabeling )
+  { //label all cells in parallel, regions are numbered as below
+    this->RegionNumber =
+      labeler.LabelAllRegions(this->Mesh, this->Visited, this->RegionSizes);
+    for (i=0; i < this->RegionNumber; i++)
+    {
+      if ( this->RegionSizes->GetValue(i) > maxCellsInRegion )
+      {
+        maxCellsInRegion = this->RegionSizes->GetValue(i);
+        largestRegionId = i;
+      }
+    }
+    this->UpdateProgress (0.9);
+  }
+  else if ( this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+  this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
   this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION )
   { //visit all cells marking with region number
     for (cellId=0; cellId < numCells; cellId++)
@@ -269,13 +295,29 @@ int vtkPolyDataConnectivityFilter::RequestData(
     this->UpdateProgress (0.5);
 
     //mark all seeded regions
-    this->TraverseAndMark ();
+    if ( this->ParallelLabeling )
+    {
+      this->NumCellsInRegion = labeler.LabelSeededRegion(
+        this->Mesh, static_cast<vtkIdType>(this->Wave.size()),
+        this->Wave.empty() ? NULL : &this->Wave[0], this->Visited);
+    }
+    else
+    {
+      this->TraverseAndMark ();
+    }
     this->RegionSizes->InsertValue(this->RegionNumber,this->NumCellsInRegion);
     this->UpdateProgress (0.9);
   }//else extracted seeded cells
 
   vtkDebugMacro (<<"Extracted " << this->RegionNumber << " region(s)");
 
+  if ( this->ParallelLabeling )
+  { //number the points in input order
+    this->PointNumber = labeler.MapPoints(this->Mesh, this->Visited,
+      this->PointMap,
+      vtkArrayDownCast<vtkIdTypeArray>(this->NewScalars)->GetPointer(0));
+  }
+
   // Now that points and cells have been marked, traverse these lists pulling
   // everything that has been visited.
   //
@@ -659,4 +701,6 @@ void vtkPolyDataConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Parallel Labeling: "
+     << (this->ParallelLabeling ? "On\n" : "Off\n");
 }
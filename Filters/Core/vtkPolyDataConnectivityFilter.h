@@ -221,6 +221,20 @@ public:
   vtkGetMacro(OutputPointsPrecision,int);
   //@}
 
+  //@{
+  /**
+   * Turn on/off the labeling of the regions in parallel (vtkSMPTools) with a
+   * union-find over the cells, instead of the serial wave propagation. The
+   * regions, their sizes and the RegionId array are the same, whatever the
+   * number of threads; only the output points are numbered in the order of
+   * the input points rather than in the order of the traversal. Off by
+   * default.
+   */
+  vtkSetMacro(ParallelLabeling,int);
+  vtkGetMacro(ParallelLabeling,int);
+  vtkBooleanMacro(ParallelLabeling,int);
+  //@}
+
 protected:
   vtkPolyDataConnectivityFilter();
   ~vtkPolyDataConnectivityFilter() VTK_OVERRIDE;
@@ -265,6 +279,7 @@ protected:
 
   int MarkVisitedPointIds;
   int OutputPointsPrecision;
+  int ParallelLabeling;
 
 private:
   vtkPolyDataConnectivityFilter(const vtkPolyDataConnectivityFilter&) VTK_DELETE_FUNCTION;
@@ -17,6 +17,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
 #include "vtkMath.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -26,11 +27,293 @@
 #include "vtkPolygon.h"
 #include "vtkTriangleStrip.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 
 #include "vtkNew.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkPolyDataNormals);
 
+namespace
+{
+
+// Compute the normals of the polygons of a mesh whose cells are built.
+struct vtkPolyDataNormalsPolygons
+{
+  vtkPolyData *Mesh;
+  vtkPoints *Points;
+  float *Normals;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType npts, *pts;
+    double n[3];
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      this->Mesh->GetCellPoints(cellId, npts, pts);
+      vtkPolygon::ComputeNormal(this->Points, npts, pts, n);
+      this->Normals[3 * cellId] = static_cast<float>(n[0]);
+      this->Normals[3 * cellId + 1] = static_cast<float>(n[1]);
+      this->Normals[3 * cellId + 2] = static_cast<float>(n[2]);
+    }
+  }
+};
+
+// Index of the first occurrence of cellId in the cells of a point.
+vtkIdType vtkPolyDataNormalsLinkIndex(const vtkIdType *cells,
+                                      unsigned short ncells, vtkIdType cellId)
+{
+  vtkIdType i = 0;
+  while (i < ncells && cells[i] != cellId)
+  {
+    ++i;
+  }
+  return i;
+}
+
+// Mark the regions of the cells around each point, as
+// vtkPolyDataNormals::MarkAndSplit() does. The regions are stored per link
+// of the point (at Offsets[ptId]) instead of per cell, so that the points
+// can be processed concurrently.
+struct vtkPolyDataNormalsRegions
+{
+  vtkPolyData *Mesh;
+  const float *PolyNormals;
+  double CosAngle;
+  const vtkIdType *Offsets;
+  int *Regions;
+  int *NumRegions;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+
+  void Initialize()
+  {
+    vtkIdList *&cellIds = this->CellIds.Local();
+    cellIds->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *&cellIds = this->CellIds.Local();
+    unsigned short ncells;
+    vtkIdType *cells, numPts, *pts;
+    vtkIdType spot, neiPt[2], nei, cellId, neiCellId;
+    double thisNormal[3], neiNormal[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      this->Mesh->GetPointCells(ptId, ncells, cells);
+      int *regions = this->Regions + this->Offsets[ptId];
+      if (ncells <= 1)
+      {
+        std::fill_n(regions, ncells, 0);
+        this->NumRegions[ptId] = 1;
+        continue;
+      }
+      std::fill_n(regions, ncells, -1);
+
+      int numRegions = 0;
+      for (int j = 0; j < ncells; ++j)
+      {
+        vtkIdType seed = vtkPolyDataNormalsLinkIndex(cells, ncells, cells[j]);
+        if (regions[seed] >= 0)
+        {
+          continue;
+        }
+        regions[seed] = numRegions;
+        this->Mesh->GetCellPoints(cells[j], numPts, pts);
+        for (spot = 0; spot < numPts && pts[spot] != ptId; ++spot)
+        {
+        }
+        if (spot == 0)
+        {
+          neiPt[0] = pts[spot + 1];
+          neiPt[1] = pts[numPts - 1];
+        }
+        else if (spot == (numPts - 1))
+        {
+          neiPt[0] = pts[spot - 1];
+          neiPt[1] = pts[0];
+        }
+        else
+        {
+          neiPt[0] = pts[spot + 1];
+          neiPt[1] = pts[spot - 1];
+        }
+
+        for (int i = 0; i < 2; ++i)
+        {
+          cellId = cells[j];
+          nei = neiPt[i];
+          while (cellId >= 0)
+          {
+            this->Mesh->GetCellEdgeNeighbors(cellId, ptId, nei, cellIds);
+            vtkIdType neiIdx = -1;
+            if (cellIds->GetNumberOfIds() == 1)
+            {
+              neiCellId = cellIds->GetId(0);
+              neiIdx = vtkPolyDataNormalsLinkIndex(cells, ncells, neiCellId);
+            }
+            if (neiIdx < 0 || regions[neiIdx] >= 0)
+            {
+              break;
+            }
+            for (int k = 0; k < 3; ++k)
+            {
+              thisNormal[k] = this->PolyNormals[3 * cellId + k];
+              neiNormal[k] = this->PolyNormals[3 * neiCellId + k];
+            }
+            if (vtkMath::Dot(thisNormal, neiNormal) <= this->CosAngle)
+            {
+              break;
+            }
+            regions[neiIdx] = numRegions;
+            cellId = neiCellId;
+            this->Mesh->GetCellPoints(cellId, numPts, pts);
+            for (spot = 0; spot < numPts && pts[spot] != ptId; ++spot)
+            {
+            }
+            if (spot == 0)
+            {
+              nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[numPts - 1]);
+            }
+            else if (spot == (numPts - 1))
+            {
+              nei = (pts[spot - 1] != nei ? pts[spot - 1] : pts[0]);
+            }
+            else
+            {
+              nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[spot - 1]);
+            }
+          }
+        }
+        numRegions++;
+      }
+
+      // A cell listed twice (degenerate polygon) shares its region.
+      for (int j = 0; j < ncells; ++j)
+      {
+        regions[j] = regions[vtkPolyDataNormalsLinkIndex(cells, ncells,
+                                                         cells[j])];
+      }
+      this->NumRegions[ptId] = numRegions;
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+// Replace the points of the cells that are not in the first region around
+// the point by the split points. Each cell is only written by one thread.
+struct vtkPolyDataNormalsReplace
+{
+  vtkPolyData *OldMesh;
+  vtkPolyData *NewMesh;
+  const vtkIdType *Offsets;
+  const int *Regions;
+  const vtkIdType *FirstNewIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    unsigned short ncells;
+    vtkIdType *cells, npts, *pts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      this->OldMesh->GetCellPoints(cellId, npts, pts);
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        vtkIdType ptId = pts[i];
+        if (std::find(pts, pts + i, ptId) != pts + i)
+        {
+          continue; // already replaced for each link of the cell
+        }
+        this->OldMesh->GetPointCells(ptId, ncells, cells);
+        int region = this->Regions[this->Offsets[ptId] +
+          vtkPolyDataNormalsLinkIndex(cells, ncells, cellId)];
+        if (region <= 0)
+        {
+          continue;
+        }
+        // As the serial loop, replace the first remaining match once for
+        // each link of the point to the cell.
+        vtkIdType newId = this->FirstNewIds[ptId] + region - 1;
+        for (unsigned short j = 0; j < ncells; ++j)
+        {
+          if (cells[j] == cellId)
+          {
+            this->NewMesh->ReplaceCellPoint(cellId, ptId, newId);
+          }
+        }
+      }
+    }
+  }
+};
+
+// Sum the polygon normals at each (split) point, in the order of the cells
+// like the serial loop does. All the split points of an input point are
+// handled by the same thread.
+struct vtkPolyDataNormalsAccumulate
+{
+  vtkPolyData *Mesh;
+  const float *PolyNormals;
+  const vtkIdType *Offsets;
+  const int *Regions;
+  const vtkIdType *FirstNewIds;
+  float *Normals;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    unsigned short ncells;
+    vtkIdType *cells;
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      this->Mesh->GetPointCells(ptId, ncells, cells);
+      for (int j = 0; j < ncells; ++j)
+      {
+        vtkIdType id = ptId;
+        if (this->Regions && this->Regions[this->Offsets[ptId] + j] > 0)
+        {
+          id = this->FirstNewIds[ptId] +
+            this->Regions[this->Offsets[ptId] + j] - 1;
+        }
+        this->Normals[3 * id] += this->PolyNormals[3 * cells[j]];
+        this->Normals[3 * id + 1] += this->PolyNormals[3 * cells[j] + 1];
+        this->Normals[3 * id + 2] += this->PolyNormals[3 * cells[j] + 2];
+      }
+    }
+  }
+};
+
+// Normalize the point normals.
+struct vtkPolyDataNormalsNormalize
+{
+  float *Normals;
+  double FlipDirection;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    float *n = this->Normals;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const double length = sqrt(n[3 * i] * n[3 * i] +
+                                 n[3 * i + 1] * n[3 * i + 1] +
+                                 n[3 * i + 2] * n[3 * i + 2]
+                                 ) * this->FlipDirection;
+      if (length != 0.0)
+      {
+        n[3 * i] /= length;
+        n[3 * i + 1] /= length;
+        n[3 * i + 2] /= length;
+      }
+    }
+  }
+};
+
+} // end anon namespace
+
 // Construct with feature angle=30, splitting and consistency turned on,
 // flipNormals turned off, and non-manifold traversal turned on.
 vtkPolyDataNormals::vtkPolyDataNormals()
@@ -46,6 +329,7 @@ vtkPolyDataNormals::vtkPolyDataNormals()
   // some internal data
   this->NumFlips = 0;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->ParallelNormals = 0;
   this->Wave = 0;
   this->Wave2 = 0;
   this->CellIds = 0;
@@ -346,21 +630,38 @@ int vtkPolyDataNormals::RequestData(
   this->PolyNormals->SetName("Normals");
   this->PolyNormals->SetNumberOfTuples(numPolys);
 
-  for (cellId=0, newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts);
-       cellId++ )
+  if ( this->ParallelNormals )
+  {
+    vtkPolyDataNormalsPolygons polygons;
+    polygons.Mesh = this->NewMesh;
+    polygons.Points = inPts;
+    polygons.Normals = this->PolyNormals->GetPointer(0);
+    vtkSMPTools::For(0, numPolys, polygons);
+  }
+  else
   {
-    if ((cellId % 1000) == 0)
+    for (cellId=0, newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts);
+         cellId++ )
     {
-      this->UpdateProgress (0.333 + 0.333 * (double) cellId / (double) numPolys);
-      if (this->GetAbortExecute())
+      if ((cellId % 1000) == 0)
       {
-        break;
+        this->UpdateProgress (0.333 + 0.333 * (double) cellId / (double) numPolys);
+        if (this->GetAbortExecute())
+        {
+          break;
+        }
       }
+      vtkPolygon::ComputeNormal(inPts, npts, pts, n);
+      this->PolyNormals->SetTuple(cellId,n);
     }
-    vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-    this->PolyNormals->SetTuple(cellId,n);
   }
 
+  // With ParallelNormals, the regions of the cells around each point (see
+  // MarkAndSplit()) and the first split point of each point.
+  std::vector<vtkIdType> linkOffsets;
+  std::vector<int> linkRegions;
+  std::vector<vtkIdType> firstNewIds;
+
   // Split mesh if sharp features
   if ( this->Splitting )
   {
@@ -379,10 +680,56 @@ int vtkPolyDataNormals::RequestData(
       this->Map->SetId(i,i);
     }
 
-    for (ptId=0; ptId < numPts; ptId++)
+    if ( this->ParallelNormals )
+    {
+      unsigned short ncells;
+      vtkIdType *cells;
+      linkOffsets.resize(numPts + 1);
+      linkOffsets[0] = 0;
+      for (ptId=0; ptId < numPts; ptId++)
+      {
+        this->OldMesh->GetPointCells(ptId, ncells, cells);
+        linkOffsets[ptId + 1] = linkOffsets[ptId] + ncells;
+      }
+      linkRegions.resize(linkOffsets[numPts]);
+      std::vector<int> numRegions(numPts);
+
+      vtkPolyDataNormalsRegions regions;
+      regions.Mesh = this->OldMesh;
+      regions.PolyNormals = this->PolyNormals->GetPointer(0);
+      regions.CosAngle = this->CosAngle;
+      regions.Offsets = &linkOffsets[0];
+      regions.Regions = linkRegions.empty() ? NULL : &linkRegions[0];
+      regions.NumRegions = &numRegions[0];
+      vtkSMPTools::For(0, numPts, regions);
+
+      // Number the split points in the order of the input points, as the
+      // serial splitting does.
+      firstNewIds.resize(numPts);
+      for (ptId=0; ptId < numPts; ptId++)
+      {
+        firstNewIds[ptId] = this->Map->GetNumberOfIds();
+        for (int r=1; r < numRegions[ptId]; r++)
+        {
+          this->Map->InsertNextId(ptId);
+        }
+      }
+
+      vtkPolyDataNormalsReplace replace;
+      replace.OldMesh = this->OldMesh;
+      replace.NewMesh = this->NewMesh;
+      replace.Offsets = &linkOffsets[0];
+      replace.Regions = regions.Regions;
+      replace.FirstNewIds = &firstNewIds[0];
+      vtkSMPTools::For(0, numPolys, replace);
+    }
+    else
     {
-      this->MarkAndSplit(ptId);
-    }//for all input points
+      for (ptId=0; ptId < numPts; ptId++)
+      {
+        this->MarkAndSplit(ptId);
+      }//for all input points
+    }
 
     numNewPts = this->Map->GetNumberOfIds();
 
@@ -459,7 +806,23 @@ int vtkPolyDataNormals::RequestData(
 
   float *fPolyNormals = this->PolyNormals->WritePointer(0, 3 * numPolys);
 
-  if (this->ComputePointNormals)
+  if (this->ComputePointNormals && this->ParallelNormals)
+  {
+    vtkPolyDataNormalsAccumulate accumulate;
+    accumulate.Mesh = this->OldMesh;
+    accumulate.PolyNormals = fPolyNormals;
+    accumulate.Offsets = linkOffsets.empty() ? NULL : &linkOffsets[0];
+    accumulate.Regions = linkRegions.empty() ? NULL : &linkRegions[0];
+    accumulate.FirstNewIds = firstNewIds.empty() ? NULL : &firstNewIds[0];
+    accumulate.Normals = fNormals;
+    vtkSMPTools::For(0, numPts, accumulate);
+
+    vtkPolyDataNormalsNormalize normalize;
+    normalize.Normals = fNormals;
+    normalize.FlipDirection = flipDirection;
+    vtkSMPTools::For(0, numNewPts, normalize);
+  }
+  else if (this->ComputePointNormals)
   {
     for (cellId=0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts);
          ++cellId)
@@ -772,5 +1135,7 @@ void vtkPolyDataNormals::PrintSelf(ostream& os, vtkIndent indent)
      << (this->NonManifoldTraversal ? "On\n" : "Off\n");
   os << indent << "Precision of the output points: "
      << this->OutputPointsPrecision << "\n";
+  os << indent << "Parallel Normals: "
+     << (this->ParallelNormals ? "On\n" : "Off\n");
 }
 
@@ -173,6 +173,20 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   //@}
 
+  //@{
+  /**
+   * Turn on/off the threaded computation of the normals with vtkSMPTools.
+   * The polygon normals, the splitting of sharp edges and the averaging of
+   * the point normals are then computed in parallel; the consistency and
+   * auto orientation traversals remain serial (turn Consistency off when
+   * the polygons are known to be consistently ordered). The output is the
+   * same as the serial output. Off by default.
+   */
+  vtkSetMacro(ParallelNormals,int);
+  vtkGetMacro(ParallelNormals,int);
+  vtkBooleanMacro(ParallelNormals,int);
+  //@}
+
 protected:
   vtkPolyDataNormals();
   ~vtkPolyDataNormals() VTK_OVERRIDE {}
@@ -190,6 +204,7 @@ protected:
   int ComputeCellNormals;
   int NumFlips;
   int OutputPointsPrecision;
+  int ParallelNormals;
 
 private:
   vtkIdList *Wave;
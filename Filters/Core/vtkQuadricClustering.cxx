@@ -24,10 +24,16 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPAlgorithmProgress.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkTriangle.h"
+#include <vtksys/hash_map.hxx> // quadrics of the visited bins
 #include <vtksys/hash_set.hxx> // keep track of inserted triangles
 
+#include <vector>
+
 vtkStandardNewMacro(vtkQuadricClustering);
 
 //----------------------------------------------------------------------------
@@ -38,6 +44,420 @@ struct vtkQuadricClusteringIdTypeHash {
 class vtkQuadricClusteringCellSet : public vtksys::hash_set<vtkIdType, vtkQuadricClusteringIdTypeHash> {};
 typedef vtkQuadricClusteringCellSet::iterator vtkQuadricClusteringCellSetIterator;
 
+//----------------------------------------------------------------------------
+// The quadric accumulated in a bin, and the output vertex of the bin.
+struct vtkQuadricClusteringPointQuadric
+{
+  vtkQuadricClusteringPointQuadric():VertexId(-1),Dimension(255) {}
+
+  vtkIdType VertexId;
+  // Dimension is a flag representing the dimension of the cells
+  // contributing to the quadric.  Points: 0, Lines: 1, Triangles: 2.
+  unsigned char Dimension;
+  double Quadric[9];
+};
+
+// PIMPLd STL map holding the quadrics of the visited bins only.
+class vtkQuadricClusteringBinMap : public vtksys::hash_map<vtkIdType,
+  vtkQuadricClusteringPointQuadric, vtkQuadricClusteringIdTypeHash> {};
+typedef vtkQuadricClusteringBinMap::iterator vtkQuadricClusteringBinMapIterator;
+
+namespace
+{
+
+// Add a quadric computed from cells of the given dimension to a bin.
+// Lower dimensions supercede higher ones: the quadric of a bin is the sum
+// of the quadrics of its lowest dimension cells.
+inline void vtkQuadricClusteringAddQuadric(
+  vtkQuadricClusteringPointQuadric &bin, const double quadric[9],
+  unsigned char dimension)
+{
+  if (bin.Dimension > dimension)
+  {
+    bin.Dimension = dimension;
+    for (int i = 0; i < 9; ++i)
+    {
+      bin.Quadric[i] = 0.0;
+    }
+  }
+  if (bin.Dimension == dimension)
+  {
+    for (int i = 0; i < 9; ++i)
+    {
+      bin.Quadric[i] += (quadric[i] * 100000000.0);
+    }
+  }
+}
+
+// Merge the (already scaled) quadrics of a map of bins into another one.
+void vtkQuadricClusteringMergeBins(vtkQuadricClusteringBinMap &bins,
+                                   const vtkQuadricClusteringBinMap &partial)
+{
+  for (vtkQuadricClusteringBinMap::const_iterator it = partial.begin();
+       it != partial.end(); ++it)
+  {
+    vtkQuadricClusteringPointQuadric &bin = bins[it->first];
+    if (bin.Dimension > it->second.Dimension)
+    {
+      bin.Dimension = it->second.Dimension;
+      for (int i = 0; i < 9; ++i)
+      {
+        bin.Quadric[i] = it->second.Quadric[i];
+      }
+    }
+    else if (bin.Dimension == it->second.Dimension)
+    {
+      for (int i = 0; i < 9; ++i)
+      {
+        bin.Quadric[i] += it->second.Quadric[i];
+      }
+    }
+  }
+}
+
+// The error function is the volume (squared) of the tetrahedron formed by
+// the triangle and the point.  We ignore constant factors across all
+// coefficients, and the constant coefficient.
+void vtkQuadricClusteringTriangleQuadric(double *pt0, double *pt1,
+                                         double *pt2, double quadric[9])
+{
+  double quadric4x4[4][4];
+  vtkTriangle::ComputeQuadric(pt0, pt1, pt2, quadric4x4);
+  quadric[0] = quadric4x4[0][0];
+  quadric[1] = quadric4x4[0][1];
+  quadric[2] = quadric4x4[0][2];
+  quadric[3] = quadric4x4[0][3];
+  quadric[4] = quadric4x4[1][1];
+  quadric[5] = quadric4x4[1][2];
+  quadric[6] = quadric4x4[1][3];
+  quadric[7] = quadric4x4[2][2];
+  quadric[8] = quadric4x4[2][3];
+}
+
+// The error function is the square of the area of the triangle formed by
+// the edge and the point.  We ignore constants across all terms.
+// Returns false for a degenerate edge, which has no quadric.
+bool vtkQuadricClusteringEdgeQuadric(double *pt0, double *pt1, double q[9])
+{
+  double length2, tmp;
+  double d[3];
+  double m[3];  // The mid point of the segement.(p1 or p2 could be used also).
+  double md;    // The dot product of m and d.
+
+  // Compute quadric for line segment.
+  // Line segment quadric is the area (squared) of the triangle (seg,pt)
+  // Compute the direction vector of the segment.
+  d[0] = pt1[0] - pt0[0];
+  d[1] = pt1[1] - pt0[1];
+  d[2] = pt1[2] - pt0[2];
+
+  // Compute the length^2 of the line segement.
+  length2 = d[0]*d[0] + d[1]*d[1] + d[2]*d[2];
+
+  if (length2 == 0.0)
+  { // Coincident points.  Avoid divide by zero.
+    return false;
+  }
+
+  // Normalize the direction vector.
+  tmp = 1.0 / sqrt(length2);
+  d[0] = d[0] * tmp;
+  d[1] = d[1] * tmp;
+  d[2] = d[2] * tmp;
+
+  // Compute the mid point of the segment.
+  m[0] = 0.5 * (pt1[0] + pt0[0]);
+  m[1] = 0.5 * (pt1[1] + pt0[1]);
+  m[2] = 0.5 * (pt1[2] + pt0[2]);
+
+  // Compute dot(m, d);
+  md = m[0]*d[0] + m[1]*d[1] + m[2]*d[2];
+
+  // We save nine coefficients of the error function cooresponding to:
+  // 0: Px^2
+  // 1: PxPy
+  // 2: PxPz
+  // 3: Px
+  // 4: Py^2
+  // 5: PyPz
+  // 6: Py
+  // 7: Pz^2
+  // 8: Pz
+  // We ignore the constant because it disappears with the derivative.
+  q[0] = length2*(1.0 - d[0]*d[0]);
+  q[1] = -length2*(d[0]*d[1]);
+  q[2] = -length2*(d[0]*d[2]);
+  q[3] = length2*(d[0]*md - m[0]);
+  q[4] = length2*(1.0 - d[1]*d[1]);
+  q[5] = -length2*(d[1]*d[2]);
+  q[6] = length2*(d[1]*md - m[1]);
+  q[7] = length2*(1.0 - d[2]*d[2]);
+  q[8] = length2*(d[2]*md - m[2]);
+  return true;
+}
+
+// The error function is the length (point to vert) squared.
+// We ignore constants across all terms.
+void vtkQuadricClusteringVertexQuadric(double *pt, double q[9])
+{
+  // The nine coefficients are stored in the same order as above.
+  q[0] = 1.0;
+  q[1] = 0.0;
+  q[2] = 0.0;
+  q[3] = -pt[0];
+  q[4] = 1.0;
+  q[5] = 0.0;
+  q[6] = -pt[1];
+  q[7] = 1.0;
+  q[8] = -pt[2];
+}
+
+// Merge the partial maps of bins pairwise: at each level, the map at
+// 2*Stride*pair + Stride is merged into the one at 2*Stride*pair.
+struct vtkQuadricClusteringReduce
+{
+  std::vector<vtkQuadricClusteringBinMap*> *Partials;
+  size_t Stride;
+
+  void operator()(vtkIdType pair, vtkIdType endPair)
+  {
+    for ( ; pair < endPair; ++pair)
+    {
+      size_t into = 2 * this->Stride * static_cast<size_t>(pair);
+      size_t from = into + this->Stride;
+      if (from < this->Partials->size())
+      {
+        vtkQuadricClusteringMergeBins(*(*this->Partials)[into],
+                                      *(*this->Partials)[from]);
+        (*this->Partials)[from]->clear();
+      }
+    }
+  }
+};
+
+}
+
+//----------------------------------------------------------------------------
+// Hash the points of one cell and pass its vertices, the segments of a line
+// or the triangles of a polygon or a strip, with their bins, to a sink.
+// Shared by the serial Add* methods and the parallel accumulation.
+class vtkQuadricClusteringCells
+{
+public:
+  template <class TSink>
+  static void Vertices(vtkQuadricClustering *self, vtkPoints *points,
+                       vtkIdType numPts, const vtkIdType *ptIds, TSink &sink)
+  {
+    double pt[3];
+    // Can there be poly vertices?
+    for (vtkIdType j = 0; j < numPts; ++j)
+    {
+      points->GetPoint(ptIds[j], pt);
+      sink.Vertex(self->HashPoint(pt), pt);
+    }
+  }
+
+  template <class TSink>
+  static void Edges(vtkQuadricClustering *self, vtkPoints *points,
+                    vtkIdType numPts, const vtkIdType *ptIds, TSink &sink)
+  {
+    if (numPts == 0)
+    {
+      return;
+    }
+    double pt0[3], pt1[3];
+    vtkIdType binIds[2];
+    points->GetPoint(ptIds[0], pt0);
+    binIds[0] = self->HashPoint(pt0);
+    // This internal loop handles line strips.
+    for (vtkIdType j = 1; j < numPts; ++j)
+    {
+      points->GetPoint(ptIds[j], pt1);
+      binIds[1] = self->HashPoint(pt1);
+      sink.Edge(binIds, pt0, pt1);
+      pt0[0] = pt1[0];
+      pt0[1] = pt1[1];
+      pt0[2] = pt1[2];
+      binIds[0] = binIds[1];
+    }
+  }
+
+  // Creates triangles; assumes the polygon is convex.
+  template <class TSink>
+  static void Polygon(vtkQuadricClustering *self, vtkPoints *points,
+                      vtkIdType numPts, const vtkIdType *ptIds, TSink &sink)
+  {
+    double pts0[3], pts1[3], pts2[3];
+    vtkIdType binIds[3];
+    points->GetPoint(ptIds[0], pts0);
+    binIds[0] = self->HashPoint(pts0);
+    for (vtkIdType j = 0; j < numPts - 2; ++j)
+    {
+      points->GetPoint(ptIds[j+1], pts1);
+      binIds[1] = self->HashPoint(pts1);
+      points->GetPoint(ptIds[j+2], pts2);
+      binIds[2] = self->HashPoint(pts2);
+      sink.Triangle(binIds, pts0, pts1, pts2);
+    }
+  }
+
+  template <class TSink>
+  static void Strip(vtkQuadricClustering *self, vtkPoints *points,
+                    vtkIdType numPts, const vtkIdType *ptIds, TSink &sink)
+  {
+    double pts[3][3];
+    vtkIdType binIds[3];
+    int odd;  // Used to flip order of every other triangle in a strip.
+    points->GetPoint(ptIds[0], pts[0]);
+    binIds[0] = self->HashPoint(pts[0]);
+    points->GetPoint(ptIds[1], pts[1]);
+    binIds[1] = self->HashPoint(pts[1]);
+    // This internal loop handles triangle strips.
+    odd = 0;
+    for (vtkIdType j = 2; j < numPts; ++j)
+    {
+      points->GetPoint(ptIds[j], pts[2]);
+      binIds[2] = self->HashPoint(pts[2]);
+      sink.Triangle(binIds, pts[0], pts[1], pts[2]);
+      pts[odd][0] = pts[2][0];
+      pts[odd][1] = pts[2][1];
+      pts[odd][2] = pts[2][2];
+      binIds[odd] = binIds[2];
+      // Toggle odd.
+      odd = odd ? 0 : 1;
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Sink of the serial Add* methods: add the quadrics and the output cells.
+struct vtkQuadricClusteringAppend
+{
+  vtkQuadricClustering *Self;
+  int GeometryFlag;
+  vtkPolyData *Input;
+  vtkPolyData *Output;
+
+  void Vertex(vtkIdType binId, double *pt)
+  {
+    this->Self->AddVertex(binId, pt, this->GeometryFlag, this->Input,
+                          this->Output);
+  }
+
+  void Edge(vtkIdType *binIds, double *pt0, double *pt1)
+  {
+    this->Self->AddEdge(binIds, pt0, pt1, this->GeometryFlag, this->Input,
+                        this->Output);
+  }
+
+  void Triangle(vtkIdType *binIds, double *pt0, double *pt1, double *pt2)
+  {
+    this->Self->AddTriangle(binIds, pt0, pt1, pt2, this->GeometryFlag,
+                            this->Input, this->Output);
+  }
+};
+
+namespace
+{
+
+// Sink of the parallel accumulation: only add the quadrics, to the map of
+// bins of a thread, as AddVertex(), AddEdge() and AddTriangle() do.
+struct vtkQuadricClusteringAddQuadrics
+{
+  vtkQuadricClusteringBinMap *Bins;
+  int UseInternalTriangles;
+
+  void Vertex(vtkIdType binId, double *pt)
+  {
+    double q[9];
+    vtkQuadricClusteringVertexQuadric(pt, q);
+    vtkQuadricClusteringAddQuadric((*this->Bins)[binId], q, 0);
+  }
+
+  void Edge(vtkIdType *binIds, double *pt0, double *pt1)
+  {
+    double q[9];
+    if (vtkQuadricClusteringEdgeQuadric(pt0, pt1, q))
+    {
+      vtkQuadricClusteringAddQuadric((*this->Bins)[binIds[0]], q, 1);
+      vtkQuadricClusteringAddQuadric((*this->Bins)[binIds[1]], q, 1);
+    }
+  }
+
+  void Triangle(vtkIdType *binIds, double *pt0, double *pt1, double *pt2)
+  {
+    if (this->UseInternalTriangles == 0 &&
+        (binIds[0] == binIds[1] || binIds[0] == binIds[2] ||
+         binIds[1] == binIds[2]))
+    {
+      return;
+    }
+    double quadric[9];
+    vtkQuadricClusteringTriangleQuadric(pt0, pt1, pt2, quadric);
+    for (int i = 0; i < 3; ++i)
+    {
+      vtkQuadricClusteringAddQuadric((*this->Bins)[binIds[i]], quadric, 2);
+    }
+  }
+};
+
+// Accumulate the quadrics of a range of the cells of a piece, numbered
+// across its verts, lines, polys and strips, into the map of bins of the
+// thread.
+struct vtkQuadricClusteringAccumulate
+{
+  vtkQuadricClustering *Self;
+  int UseInternalTriangles;
+  vtkPoints *Points;
+  const vtkIdType *Connectivity[4]; // of the verts, lines, polys and strips
+  vtkIdType FirstCell[5]; // of each cell type, then the number of cells
+  const vtkIdType *Locations; // of each cell in the connectivity of its type
+  vtkSMPAlgorithmProgress *Progress;
+  vtkSMPThreadLocal<vtkQuadricClusteringBinMap> Bins;
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkQuadricClusteringAddQuadrics sink;
+    sink.Bins = &this->Bins.Local();
+    sink.UseInternalTriangles = this->UseInternalTriangles;
+    int type = 0;
+    for ( ; cellId < endCellId; ++cellId)
+    {
+      if (this->Progress->IsAborted())
+      {
+        return;
+      }
+      while (cellId >= this->FirstCell[type + 1])
+      {
+        ++type;
+      }
+      const vtkIdType *cell = this->Connectivity[type] + this->Locations[cellId];
+      switch (type)
+      {
+        case 0:
+          vtkQuadricClusteringCells::Vertices(this->Self, this->Points,
+                                              cell[0], cell + 1, sink);
+          break;
+        case 1:
+          vtkQuadricClusteringCells::Edges(this->Self, this->Points,
+                                           cell[0], cell + 1, sink);
+          break;
+        case 2:
+          vtkQuadricClusteringCells::Polygon(this->Self, this->Points,
+                                             cell[0], cell + 1, sink);
+          break;
+        default:
+          vtkQuadricClusteringCells::Strip(this->Self, this->Points,
+                                           cell[0], cell + 1, sink);
+          break;
+      }
+      this->Progress->Advance();
+    }
+  }
+};
+
+}
+
 
 //----------------------------------------------------------------------------
 // Construct with default NumberOfDivisions to 50, DivisionSpacing to 1
@@ -53,7 +473,10 @@ vtkQuadricClustering::vtkQuadricClustering()
   this->NumberOfXDivisions = 50;
   this->NumberOfYDivisions = 50;
   this->NumberOfZDivisions = 50;
-  this->QuadricArray = NULL;
+  this->NumberOfDivisions[0] = 50;
+  this->NumberOfDivisions[1] = 50;
+  this->NumberOfDivisions[2] = 50;
+  this->QuadricBins = NULL;
   this->NumberOfBinsUsed = 0;
   this->AbortExecute = 0;
 
@@ -74,6 +497,8 @@ vtkQuadricClustering::vtkQuadricClustering()
   this->UseInputPoints = 0;
 
   this->PreventDuplicateCells = 1;
+  this->ParallelAccumulation = 0;
+  this->QuadricsAccumulated = 0;
   this->CellSet = NULL;
   this->NumberOfBins = 0;
 
@@ -99,8 +524,8 @@ vtkQuadricClustering::~vtkQuadricClustering()
   this->FeaturePoints = NULL;
   delete this->CellSet;
   this->CellSet = NULL;
-  delete [] this->QuadricArray;
-  this->QuadricArray = NULL;
+  delete this->QuadricBins;
+  this->QuadricBins = NULL;
   if (this->OutputTriangleArray)
   {
     this->OutputTriangleArray->Delete();
@@ -186,7 +611,6 @@ int vtkQuadricClustering::RequestData(
 
   this->StartAppend(input->GetBounds());
   this->UpdateProgress(.2);
-  this->SliceSize = this->NumberOfDivisions[0]*this->NumberOfDivisions[1];
 
   this->Append(input);
   if (this->UseFeatureEdges)
@@ -204,8 +628,8 @@ int vtkQuadricClustering::RequestData(
   }
 
   // Free up some memory.
-  delete [] this->QuadricArray;
-  this->QuadricArray = NULL;
+  delete this->QuadricBins;
+  this->QuadricBins = NULL;
 
   if ( this->Debug )
   {
@@ -220,14 +644,6 @@ int vtkQuadricClustering::RequestData(
 //----------------------------------------------------------------------------
 void vtkQuadricClustering::StartAppend(double *bounds)
 {
-  // If there are duplicate triangles. remove them
-  if ( this->PreventDuplicateCells )
-  {
-    this->CellSet = new vtkQuadricClusteringCellSet;
-    this->NumberOfBins =
-      this->NumberOfDivisions[0]*this->NumberOfDivisions[1]*this->NumberOfDivisions[2];
-  }
-
   // Copy over the bounds.
   for (vtkIdType i = 0; i < 6; ++i)
   {
@@ -263,6 +679,15 @@ void vtkQuadricClustering::StartAppend(double *bounds)
     this->DivisionSpacing[1] = (bounds[3]-bounds[2])/this->NumberOfDivisions[1];
     this->DivisionSpacing[2] = (bounds[5]-bounds[4])/this->NumberOfDivisions[2];
   }
+  this->SliceSize = this->NumberOfDivisions[0]*this->NumberOfDivisions[1];
+
+  // If there are duplicate triangles. remove them
+  if ( this->PreventDuplicateCells )
+  {
+    delete this->CellSet;
+    this->CellSet = new vtkQuadricClusteringCellSet;
+    this->NumberOfBins = this->SliceSize*this->NumberOfDivisions[2];
+  }
 
   // Check for conditions that can occur if the Append methods
   // are not called in the correct order.
@@ -290,17 +715,10 @@ void vtkQuadricClustering::StartAppend(double *bounds)
   this->YBinStep = (this->YBinSize > 0.0) ? (1.0/this->YBinSize) : 0.0;
   this->ZBinStep = (this->ZBinSize > 0.0) ? (1.0/this->ZBinSize) : 0.0;
 
+  // Only the visited bins are stored.
   this->NumberOfBinsUsed = 0;
-  delete [] this->QuadricArray;
-  this->QuadricArray =
-    new vtkQuadricClustering::PointQuadric[this->NumberOfDivisions[0] *
-                                          this->NumberOfDivisions[1] *
-                                          this->NumberOfDivisions[2]];
-  if (this->QuadricArray == NULL)
-  {
-    vtkErrorMacro("Could not allocate quadric grid.");
-    return;
-  }
+  delete this->QuadricBins;
+  this->QuadricBins = new vtkQuadricClusteringBinMap;
 
   vtkInformation *inInfo = this->GetExecutive()->GetInputInformation(0, 0);
   vtkInformation *outInfo = this->GetExecutive()->GetOutputInformation(0);
@@ -312,6 +730,11 @@ void vtkQuadricClustering::StartAppend(double *bounds)
   }
   vtkPolyData *output = vtkPolyData::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
+  if (!output)
+  {
+    // The append methods are called directly, before any update.
+    output = this->GetOutput();
+  }
 
   // Allocate CellData here.
   if (this->CopyCellData && input)
@@ -340,6 +763,13 @@ void vtkQuadricClustering::Append(vtkPolyData *pd)
   vtkPolyData *output = vtkPolyData::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
+  if (this->ParallelAccumulation && inputPoints)
+  {
+    // The Add* methods below then only generate the output cells.
+    this->AccumulateQuadricsInParallel(pd);
+    this->QuadricsAccumulated = 1;
+  }
+
   inputVerts = pd->GetVerts();
   if (inputVerts)
   {
@@ -366,6 +796,77 @@ void vtkQuadricClustering::Append(vtkPolyData *pd)
   {
     this->AddStrips(inputStrips, inputPoints, 1, pd, output);
   }
+  this->QuadricsAccumulated = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricClustering::AccumulateQuadricsInParallel(vtkPolyData *pd)
+{
+  vtkQuadricClusteringAccumulate accumulate;
+  accumulate.Self = this;
+  accumulate.UseInternalTriangles = this->UseInternalTriangles;
+  accumulate.Points = pd->GetPoints();
+
+  vtkCellArray *cells[4] = { pd->GetVerts(), pd->GetLines(),
+                             pd->GetPolys(), pd->GetStrips() };
+  accumulate.FirstCell[0] = 0;
+  for (int k = 0; k < 4; ++k)
+  {
+    vtkIdType numCells = cells[k] ? cells[k]->GetNumberOfCells() : 0;
+    accumulate.Connectivity[k] = numCells ? cells[k]->GetPointer() : NULL;
+    accumulate.FirstCell[k + 1] = accumulate.FirstCell[k] + numCells;
+  }
+  vtkIdType totalCells = accumulate.FirstCell[4];
+  if (totalCells == 0)
+  {
+    return;
+  }
+
+  std::vector<vtkIdType> locations(totalCells);
+  for (int k = 0; k < 4; ++k)
+  {
+    vtkIdType loc = 0;
+    for (vtkIdType cellId = accumulate.FirstCell[k];
+         cellId < accumulate.FirstCell[k + 1]; ++cellId)
+    {
+      locations[cellId] = loc;
+      loc += accumulate.Connectivity[k][loc] + 1;
+    }
+  }
+  accumulate.Locations = &locations[0];
+
+  vtkSMPAlgorithmProgress progress(this, totalCells, .2, .4);
+  accumulate.Progress = &progress;
+  vtkSMPTools::For(0, totalCells, accumulate);
+
+  // Merge the maps of the threads pairwise, then into the bins of the
+  // pieces already appended.
+  std::vector<vtkQuadricClusteringBinMap*> partials;
+  for (vtkSMPThreadLocal<vtkQuadricClusteringBinMap>::iterator it =
+         accumulate.Bins.begin(); it != accumulate.Bins.end(); ++it)
+  {
+    partials.push_back(&(*it));
+  }
+  if (partials.empty())
+  {
+    return;
+  }
+  vtkQuadricClusteringReduce reduce;
+  reduce.Partials = &partials;
+  for (reduce.Stride = 1; reduce.Stride < partials.size(); reduce.Stride *= 2)
+  {
+    vtkIdType numPairs = static_cast<vtkIdType>(
+      (partials.size() + 2 * reduce.Stride - 1) / (2 * reduce.Stride));
+    vtkSMPTools::For(0, numPairs, 1, reduce);
+  }
+  if (this->QuadricBins->empty())
+  {
+    this->QuadricBins->swap(*partials[0]);
+  }
+  else
+  {
+    vtkQuadricClusteringMergeBins(*this->QuadricBins, *partials[0]);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -375,8 +876,7 @@ void vtkQuadricClustering::AddPolygons(vtkCellArray *polys, vtkPoints *points,
 {
   vtkIdType *ptIds = 0;
   vtkIdType numPts = 0;
-  double pts0[3], pts1[3], pts2[3];
-  vtkIdType binIds[3];
+  vtkQuadricClusteringAppend append = { this, geometryFlag, input, output };
 
   double total = polys->GetNumberOfCells();
   double curr = 0;
@@ -389,16 +889,7 @@ void vtkQuadricClustering::AddPolygons(vtkCellArray *polys, vtkPoints *points,
 
   for ( polys->InitTraversal(); polys->GetNextCell(numPts, ptIds); )
   {
-    points->GetPoint(ptIds[0],pts0);
-    binIds[0] = this->HashPoint(pts0);
-    for (vtkIdType j=0; j < numPts-2; j++)//creates triangles; assumes poly is convex
-    {
-      points->GetPoint(ptIds[j+1],pts1);
-      binIds[1] = this->HashPoint(pts1);
-      points->GetPoint(ptIds[j+2],pts2);
-      binIds[2] = this->HashPoint(pts2);
-      this->AddTriangle(binIds, pts0, pts1, pts2, geometryFlag, input, output);
-    }
+    vtkQuadricClusteringCells::Polygon(this, points, numPts, ptIds, append);
     ++this->InCellCount;
     if ( curr > cstep )
     {
@@ -416,53 +907,18 @@ void vtkQuadricClustering::AddStrips(vtkCellArray *strips, vtkPoints *points,
 {
   vtkIdType *ptIds = 0;
   vtkIdType numPts = 0;
-  double pts[3][3];
-  vtkIdType binIds[3];
-  int odd;  // Used to flip order of every other triangle in a strip.
+  vtkQuadricClusteringAppend append = { this, geometryFlag, input, output };
 
   for ( strips->InitTraversal(); strips->GetNextCell(numPts, ptIds); )
   {
-    points->GetPoint(ptIds[0], pts[0]);
-    binIds[0] = this->HashPoint(pts[0]);
-    points->GetPoint(ptIds[1], pts[1]);
-    binIds[1] = this->HashPoint(pts[1]);
-    // This internal loop handles triangle strips.
-    odd = 0;
-    for (vtkIdType j = 2; j < numPts; ++j)
-    {
-      points->GetPoint(ptIds[j], pts[2]);
-      binIds[2] = this->HashPoint(pts[2]);
-      this->AddTriangle(binIds, pts[0], pts[1], pts[2], geometryFlag, input,
-                        output);
-      pts[odd][0] = pts[2][0];
-      pts[odd][1] = pts[2][1];
-      pts[odd][2] = pts[2][2];
-      binIds[odd] = binIds[2];
-      // Toggle odd.
-      odd = odd ? 0 : 1;
-    }
+    vtkQuadricClusteringCells::Strip(this, points, numPts, ptIds, append);
     ++this->InCellCount;
   }
 }
 
 //----------------------------------------------------------------------------
-inline void vtkQuadricClustering::InitializeQuadric(double quadric[9])
-{
-  quadric[0] = 0.0;
-  quadric[1] = 0.0;
-  quadric[2] = 0.0;
-  quadric[3] = 0.0;
-  quadric[4] = 0.0;
-  quadric[5] = 0.0;
-  quadric[6] = 0.0;
-  quadric[7] = 0.0;
-  quadric[8] = 0.0;
-}
-
-//----------------------------------------------------------------------------
-// The error function is the volume (squared) of the tetrahedron formed by the
-// triangle and the point.  We ignore constant factors across all coefficients,
-// and the constant coefficient.
+// The triangle quadric is added to the three corner bins, unless the
+// quadrics of the piece were already accumulated in parallel.
 // If geomertyFlag is 1 then the triangle is added to the output.  Otherwise,
 // only the quadric is affected.
 void vtkQuadricClustering::AddTriangle(vtkIdType *binIds, double *pt0, double *pt1,
@@ -480,32 +936,16 @@ void vtkQuadricClustering::AddTriangle(vtkIdType *binIds, double *pt0, double *p
     }
   }
 
-  // Compute the quadric.
-  double quadric[9], quadric4x4[4][4];
-  vtkTriangle::ComputeQuadric(pt0, pt1, pt2, quadric4x4);
-  quadric[0] = quadric4x4[0][0];
-  quadric[1] = quadric4x4[0][1];
-  quadric[2] = quadric4x4[0][2];
-  quadric[3] = quadric4x4[0][3];
-  quadric[4] = quadric4x4[1][1];
-  quadric[5] = quadric4x4[1][2];
-  quadric[6] = quadric4x4[1][3];
-  quadric[7] = quadric4x4[2][2];
-  quadric[8] = quadric4x4[2][3];
-
-  // Add the quadric to each of the three corner bins.
-  for (int i = 0; i < 3; ++i)
+  if (!this->QuadricsAccumulated)
   {
-    // If the current quadric is not initialized, then clear it out.
-    if (this->QuadricArray[binIds[i]].Dimension > 2)
+    // Add the quadric to each of the three corner bins.
+    // Points and segments supercede triangles.
+    double quadric[9];
+    vtkQuadricClusteringTriangleQuadric(pt0, pt1, pt2, quadric);
+    for (int i = 0; i < 3; ++i)
     {
-      this->QuadricArray[binIds[i]].Dimension = 2;
-      // Initialize the coeff
-      this->InitializeQuadric(this->QuadricArray[binIds[i]].Quadric);
-    }
-    if (this->QuadricArray[binIds[i]].Dimension == 2)
-    { // Points and segments supercede triangles.
-      this->AddQuadric(binIds[i], quadric);
+      vtkQuadricClusteringAddQuadric((*this->QuadricBins)[binIds[i]],
+                                     quadric, 2);
     }
   }
 
@@ -516,12 +956,13 @@ void vtkQuadricClustering::AddTriangle(vtkIdType *binIds, double *pt0, double *p
     for (int i = 0; i < 3; i++)
     {
       // Get the vertex from each bin.
-      if (this->QuadricArray[binIds[i]].VertexId == -1)
+      vtkQuadricClusteringPointQuadric &bin = (*this->QuadricBins)[binIds[i]];
+      if (bin.VertexId == -1)
       {
-        this->QuadricArray[binIds[i]].VertexId = this->NumberOfBinsUsed;
+        bin.VertexId = this->NumberOfBinsUsed;
         this->NumberOfBinsUsed++;
       }
-      triPtIds[i] = this->QuadricArray[binIds[i]].VertexId;
+      triPtIds[i] = bin.VertexId;
     }
     // This comparison could just as well be on triPtIds.
     if (binIds[0] != binIds[1] && binIds[0] != binIds[2] &&
@@ -607,8 +1048,7 @@ void vtkQuadricClustering::AddEdges(vtkCellArray *edges, vtkPoints *points,
   vtkIdType numCells;
   vtkIdType *ptIds = 0;
   vtkIdType numPts = 0;
-  double pt0[3], pt1[3];
-  vtkIdType binIds[2];
+  vtkQuadricClusteringAppend append = { this, geometryFlag, input, output };
 
   // Add the edges to the error fuction.
   numCells = edges->GetNumberOfCells();
@@ -616,28 +1056,13 @@ void vtkQuadricClustering::AddEdges(vtkCellArray *edges, vtkPoints *points,
   for (vtkIdType i = 0; i < numCells; ++i)
   {
     edges->GetNextCell(numPts, ptIds);
-    if(numPts != 0)
-    {
-      points->GetPoint(ptIds[0], pt0);
-      binIds[0] = this->HashPoint(pt0);
-      // This internal loop handles line strips.
-      for (vtkIdType j = 1; j < numPts; ++j)
-      {
-        points->GetPoint(ptIds[j], pt1);
-        binIds[1] = this->HashPoint(pt1);
-        this->AddEdge(binIds, pt0, pt1, geometryFlag, input, output);
-        pt0[0] = pt1[0];
-        pt0[1] = pt1[1];
-        pt0[2] = pt1[2];
-        binIds[0] = binIds[1];
-      }
-    }
+    vtkQuadricClusteringCells::Edges(this, points, numPts, ptIds, append);
     ++this->InCellCount;
   }
 }
 //----------------------------------------------------------------------------
-// The error function is the square of the area of the triangle formed by the
-// edge and the point.  We ignore constants across all terms.
+// The edge quadric is added to the two end bins, unless the quadrics of the
+// piece were already accumulated in parallel.
 // If geometryFlag is 1 then the edge is added to the output.  Otherwise,
 // only the quadric is affected.
 void vtkQuadricClustering::AddEdge(vtkIdType *binIds, double *pt0, double *pt1,
@@ -645,74 +1070,18 @@ void vtkQuadricClustering::AddEdge(vtkIdType *binIds, double *pt0, double *pt1,
                                    vtkPolyData *input, vtkPolyData *output)
 {
   vtkIdType edgePtIds[2];
-  double length2, tmp;
-  double d[3];
-  double m[3];  // The mid point of the segement.(p1 or p2 could be used also).
-  double md;    // The dot product of m and d.
   double q[9];
 
-  // Compute quadric for line segment.
-  // Line segment quadric is the area (squared) of the triangle (seg,pt)
-  // Compute the direction vector of the segment.
-  d[0] = pt1[0] - pt0[0];
-  d[1] = pt1[1] - pt0[1];
-  d[2] = pt1[2] - pt0[2];
-
-  // Compute the length^2 of the line segement.
-  length2 = d[0]*d[0] + d[1]*d[1] + d[2]*d[2];
-
-  if (length2 == 0.0)
-  { // Coincident points.  Avoid divide by zero.
+  if (!vtkQuadricClusteringEdgeQuadric(pt0, pt1, q))
+  { // Coincident points.
     return;
   }
 
-  // Normalize the direction vector.
-  tmp = 1.0 / sqrt(length2);
-  d[0] = d[0] * tmp;
-  d[1] = d[1] * tmp;
-  d[2] = d[2] * tmp;
-
-  // Compute the mid point of the segment.
-  m[0] = 0.5 * (pt1[0] + pt0[0]);
-  m[1] = 0.5 * (pt1[1] + pt0[1]);
-  m[2] = 0.5 * (pt1[2] + pt0[2]);
-
-  // Compute dot(m, d);
-  md = m[0]*d[0] + m[1]*d[1] + m[2]*d[2];
-
-  // We save nine coefficients of the error function cooresponding to:
-  // 0: Px^2
-  // 1: PxPy
-  // 2: PxPz
-  // 3: Px
-  // 4: Py^2
-  // 5: PyPz
-  // 6: Py
-  // 7: Pz^2
-  // 8: Pz
-  // We ignore the constant because it disappears with the derivative.
-  q[0] = length2*(1.0 - d[0]*d[0]);
-  q[1] = -length2*(d[0]*d[1]);
-  q[2] = -length2*(d[0]*d[2]);
-  q[3] = length2*(d[0]*md - m[0]);
-  q[4] = length2*(1.0 - d[1]*d[1]);
-  q[5] = -length2*(d[1]*d[2]);
-  q[6] = length2*(d[1]*md - m[1]);
-  q[7] = length2*(1.0 - d[2]*d[2]);
-  q[8] = length2*(d[2]*md - m[2]);
-
-  for (int i = 0; i < 2; ++i)
+  if (!this->QuadricsAccumulated)
   {
-    // If the current quadric is from triangles (or not initialized), then clear it out.
-    if (this->QuadricArray[binIds[i]].Dimension > 1)
-    {
-      this->QuadricArray[binIds[i]].Dimension = 1;
-      // Initialize the coeff
-      this->InitializeQuadric(this->QuadricArray[binIds[i]].Quadric);
-    }
-    if (this->QuadricArray[binIds[i]].Dimension == 1)
+    for (int i = 0; i < 2; ++i)
     { // Points supercede segements.
-      this->AddQuadric(binIds[i], q);
+      vtkQuadricClusteringAddQuadric((*this->QuadricBins)[binIds[i]], q, 1);
     }
   }
 
@@ -722,12 +1091,13 @@ void vtkQuadricClustering::AddEdge(vtkIdType *binIds, double *pt0, double *pt1,
     for (int i = 0; i < 2; i++)
     {
       // Get the vertex from each bin.
-      if (this->QuadricArray[binIds[i]].VertexId == -1)
+      vtkQuadricClusteringPointQuadric &bin = (*this->QuadricBins)[binIds[i]];
+      if (bin.VertexId == -1)
       {
-        this->QuadricArray[binIds[i]].VertexId = this->NumberOfBinsUsed;
+        bin.VertexId = this->NumberOfBinsUsed;
         this->NumberOfBinsUsed++;
       }
-      edgePtIds[i] = this->QuadricArray[binIds[i]].VertexId;
+      edgePtIds[i] = bin.VertexId;
     }
     // This comparison could just as well be on edgePtIds.
     if (binIds[0] != binIds[1])
@@ -751,8 +1121,7 @@ void vtkQuadricClustering::AddVertices(vtkCellArray *verts, vtkPoints *points,
   vtkIdType numCells;
   vtkIdType *ptIds = 0;
   vtkIdType numPts = 0;
-  double pt[3];
-  vtkIdType binId;
+  vtkQuadricClusteringAppend append = { this, geometryFlag, input, output };
 
   numCells = verts->GetNumberOfCells();
   double cstep = (double)numCells / 10.0;
@@ -767,13 +1136,7 @@ void vtkQuadricClustering::AddVertices(vtkCellArray *verts, vtkPoints *points,
   for (vtkIdType i = 0; i < numCells; ++i)
   {
     verts->GetNextCell(numPts, ptIds);
-    // Can there be poly vertices?
-    for (vtkIdType j = 0; j < numPts; ++j)
-    {
-      points->GetPoint(ptIds[j], pt);
-      binId = this->HashPoint(pt);
-      this->AddVertex(binId, pt, geometryFlag, input, output);
-    }
+    vtkQuadricClusteringCells::Vertices(this, points, numPts, ptIds, append);
     ++this->InCellCount;
 
     if ( curr > next )
@@ -786,59 +1149,30 @@ void vtkQuadricClustering::AddVertices(vtkCellArray *verts, vtkPoints *points,
 }
 
 //----------------------------------------------------------------------------
-// The error function is the length (point to vert) squared.
-// We ignore constants across all terms.
+// The vertex quadric is added to its bin, unless the quadrics of the piece
+// were already accumulated in parallel.
 // If geomertyFlag is 1 then the vert is added to the output.  Otherwise,
 // only the quadric is affected.
 void vtkQuadricClustering::AddVertex(vtkIdType binId, double *pt,
                                      int geometryFlag,
                                      vtkPolyData *input, vtkPolyData *output)
 {
-  double q[9];
-
-  // Compute quadric for the vertex.
-
-  // We save nine coefficients of the error function cooresponding to:
-  // 0: Px^2
-  // 1: PxPy
-  // 2: PxPz
-  // 3: Px
-  // 4: Py^2
-  // 5: PyPz
-  // 6: Py
-  // 7: Pz^2
-  // 8: Pz
-  // We ignore the constant because it disappears with the derivative.
-  q[0] = 1.0;
-  q[1] = 0.0;
-  q[2] = 0.0;
-  q[3] = -pt[0];
-  q[4] = 1.0;
-  q[5] = 0.0;
-  q[6] = -pt[1];
-  q[7] = 1.0;
-  q[8] = -pt[2];
+  vtkQuadricClusteringPointQuadric &bin = (*this->QuadricBins)[binId];
 
-  // If the current quadric is from triangles, edges (or not initialized),
-  // then clear it out.
-  if (this->QuadricArray[binId].Dimension > 0)
-  {
-    this->QuadricArray[binId].Dimension = 0;
-    // Initialize the coeff
-    this->InitializeQuadric(this->QuadricArray[binId].Quadric);
-  }
-  if (this->QuadricArray[binId].Dimension == 0)
+  if (!this->QuadricsAccumulated)
   { // Points supercede all other types of quadrics.
-    this->AddQuadric(binId, q);
+    double q[9];
+    vtkQuadricClusteringVertexQuadric(pt, q);
+    vtkQuadricClusteringAddQuadric(bin, q, 0);
   }
 
   if (geometryFlag)
   {
     // Now add the vert to the geometry.
     // Get the vertex from the bin.
-    if (this->QuadricArray[binId].VertexId == -1)
+    if (bin.VertexId == -1)
     {
-      this->QuadricArray[binId].VertexId = this->NumberOfBinsUsed;
+      bin.VertexId = this->NumberOfBinsUsed;
       this->NumberOfBinsUsed++;
 
       if (this->CopyCellData && input)
@@ -851,17 +1185,6 @@ void vtkQuadricClustering::AddVertex(vtkIdType binId, double *pt,
   }
 }
 
-//----------------------------------------------------------------------------
-void vtkQuadricClustering::AddQuadric(vtkIdType binId, double quadric[9])
-{
-  double *q = this->QuadricArray[binId].Quadric;
-
-  for (int i=0; i<9; i++)
-  {
-    q[i] += (quadric[i] * 100000000.0);
-  }
-}
-
 //----------------------------------------------------------------------------
 vtkIdType vtkQuadricClustering::HashPoint(double point[3])
 {
@@ -923,14 +1246,6 @@ void vtkQuadricClustering::EndAppend()
   int abortExecute=0;
   vtkPoints *outputPoints;
   double newPt[3];
-  numBuckets = this->NumberOfDivisions[0] * this->NumberOfDivisions[1] *
-                this->NumberOfDivisions[2];
-  double step = (double)numBuckets / 10.0;
-  if (step < 1000.0)
-  {
-    step = 1000.0;
-  }
-  double cstep = 0;
 
   // Check for mis use of the Append methods.
   if (this->OutputTriangleArray == NULL || this->OutputLines == NULL)
@@ -939,6 +1254,15 @@ void vtkQuadricClustering::EndAppend()
     return;
   }
 
+  // Only the visited bins are stored.
+  numBuckets = static_cast<vtkIdType>(this->QuadricBins->size());
+  double step = (double)numBuckets / 10.0;
+  if (step < 1000.0)
+  {
+    step = 1000.0;
+  }
+  double cstep = 0;
+
   // Clean up
   if ( this->PreventDuplicateCells )
   {
@@ -948,21 +1272,23 @@ void vtkQuadricClustering::EndAppend()
 
   // Compute the representative points for each bin
   outputPoints = vtkPoints::New();
-  for (vtkIdType i = 0; !abortExecute && i < numBuckets; i++ )
+  vtkIdType i = 0;
+  for (vtkQuadricClusteringBinMapIterator bin = this->QuadricBins->begin();
+       !abortExecute && bin != this->QuadricBins->end(); ++bin, ++i)
   {
     if (cstep > step)
     {
       cstep = 0;
-      vtkDebugMacro(<<"Finding point in bin #" << i);
+      vtkDebugMacro(<<"Finding point in bin #" << bin->first);
       this->UpdateProgress (0.8+0.2*i/numBuckets);
       abortExecute = this->GetAbortExecute();
     }
     ++cstep;
 
-    if (this->QuadricArray[i].VertexId != -1)
+    if (bin->second.VertexId != -1)
     {
-      this->ComputeRepresentativePoint(this->QuadricArray[i].Quadric, i, newPt);
-      outputPoints->InsertPoint(this->QuadricArray[i].VertexId, newPt);
+      this->ComputeRepresentativePoint(bin->second.Quadric, bin->first, newPt);
+      outputPoints->InsertPoint(bin->second.VertexId, newPt);
     }
   }
 
@@ -984,15 +1310,19 @@ void vtkQuadricClustering::EndAppend()
   this->OutputLines->Delete();
   this->OutputLines = NULL;
 
-  this->EndAppendVertexGeometry(input, output);
+  // There is no input when the append methods are called directly.
+  if (input)
+  {
+    this->EndAppendVertexGeometry(input, output);
+  }
 
   // Tell the data is is up to date
   // (in case the user calls this method directly).
   output->DataHasBeenGenerated();
 
-  // Free the quadric array.
-  delete [] this->QuadricArray;
-  this->QuadricArray = NULL;
+  // Free the quadric bins.
+  delete this->QuadricBins;
+  this->QuadricBins = NULL;
 }
 
 
@@ -1130,6 +1460,7 @@ void vtkQuadricClustering::SetNumberOfXDivisions(int num)
   }
   this->Modified();
   this->NumberOfXDivisions = num;
+  this->NumberOfDivisions[0] = num; // used by StartAppend
   this->ComputeNumberOfDivisions = 0;
 }
 
@@ -1147,6 +1478,7 @@ void vtkQuadricClustering::SetNumberOfYDivisions(int num)
   }
   this->Modified();
   this->NumberOfYDivisions = num;
+  this->NumberOfDivisions[1] = num; // used by StartAppend
   this->ComputeNumberOfDivisions = 0;
 }
 
@@ -1164,6 +1496,7 @@ void vtkQuadricClustering::SetNumberOfZDivisions(int num)
   }
   this->Modified();
   this->NumberOfZDivisions = num;
+  this->NumberOfDivisions[2] = num; // used by StartAppend
   this->ComputeNumberOfDivisions = 0;
 }
 
@@ -1238,9 +1571,9 @@ void vtkQuadricClustering::EndAppendUsingPoints(vtkPolyData *input,
   vtkIdType   outPtId;
   vtkPoints   *inputPoints;
   vtkPoints   *outputPoints;
-  vtkIdType   numPoints, numBins;
+  vtkIdType   numPoints;
   vtkIdType   binId;
-  double       *minError, e, pt[3];
+  double       e, pt[3];
   double       *q;
 
   inputPoints = input->GetPoints();
@@ -1269,14 +1602,9 @@ void vtkQuadricClustering::EndAppendUsingPoints(vtkPolyData *input,
   output->GetPointData()->
     CopyAllocate(input->GetPointData(), this->NumberOfBinsUsed);
 
-  // Allocate and initialize an array to hold errors for each bin.
-  numBins = this->NumberOfDivisions[0] * this->NumberOfDivisions[1]
-                  * this->NumberOfDivisions[2];
-  minError = new double[numBins];
-  for (vtkIdType i = 0; i < numBins; ++i)
-  {
-    minError[i] = VTK_DOUBLE_MAX;
-  }
+  // Allocate and initialize an array to hold errors for each used bin,
+  // indexed by its output point.
+  std::vector<double> minError(this->NumberOfBinsUsed, VTK_DOUBLE_MAX);
 
   // Loop through the input points.
   numPoints = inputPoints->GetNumberOfPoints();
@@ -1284,7 +1612,8 @@ void vtkQuadricClustering::EndAppendUsingPoints(vtkPolyData *input,
   {
     inputPoints->GetPoint(i, pt);
     binId = this->HashPoint(pt);
-    outPtId = this->QuadricArray[binId].VertexId;
+    vtkQuadricClusteringBinMapIterator bin = this->QuadricBins->find(binId);
+    outPtId = (bin != this->QuadricBins->end() ? bin->second.VertexId : -1);
     // Sanity check.
     if (outPtId == -1)
     {
@@ -1297,13 +1626,13 @@ void vtkQuadricClustering::EndAppendUsingPoints(vtkPolyData *input,
     // Compute the error for this point.  Note: the constant term is ignored.
     // It will be the same for every point in this bin, and it
     // is not stored in the quadric array anyway.
-    q = this->QuadricArray[binId].Quadric;
+    q = bin->second.Quadric;
     e = q[0]*pt[0]*pt[0] + 2.0*q[1]*pt[0]*pt[1] + 2.0*q[2]*pt[0]*pt[2] + 2.0*q[3]*pt[0]
           + q[4]*pt[1]*pt[1] + 2.0*q[5]*pt[1]*pt[2] + 2.0*q[6]*pt[1]
           + q[7]*pt[2]*pt[2] + 2.0*q[8]*pt[2];
-    if (e < minError[binId])
+    if (e < minError[outPtId])
     {
-      minError[binId] = e;
+      minError[outPtId] = e;
       outputPoints->InsertPoint(outPtId, pt);
 
       // Since this is the same point as the input point, copy point data here too.
@@ -1326,10 +1655,8 @@ void vtkQuadricClustering::EndAppendUsingPoints(vtkPolyData *input,
 
   this->EndAppendVertexGeometry(input, output);
 
-  delete [] this->QuadricArray;
-  this->QuadricArray = NULL;
-
-  delete [] minError;
+  delete this->QuadricBins;
+  this->QuadricBins = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -1364,11 +1691,12 @@ void vtkQuadricClustering::EndAppendVertexGeometry(vtkPolyData *input,
     {
       input->GetPoint(ptIds[j], pt);
       binId = this->HashPoint(pt);
-      outPtId = this->QuadricArray[binId].VertexId;
+      vtkQuadricClusteringBinMapIterator bin = this->QuadricBins->find(binId);
+      outPtId = (bin != this->QuadricBins->end() ? bin->second.VertexId : -1);
       if (outPtId >= 0)
       {
         // Do not use this point.  Destroy infomration in Quadric array.
-        this->QuadricArray[binId].VertexId = -1;
+        bin->second.VertexId = -1;
         tmp[tmpIdx] = outPtId;
         ++tmpIdx;
       }
@@ -1580,5 +1908,7 @@ void vtkQuadricClustering::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Prevent Duplicate Cells : "
      << (this->PreventDuplicateCells ? "On\n" : "Off\n");
+  os << indent << "Parallel Accumulation: "
+     << (this->ParallelAccumulation ? "On\n" : "Off\n");
 }
 
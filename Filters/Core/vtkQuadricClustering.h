@@ -57,7 +57,13 @@
  * location of each of the representative vertices for the visited bins. While
  * this approach does not fit into the visualization architecture and requires
  * manual control, it has the advantage that extremely large data can be
- * processed in pieces and appended to the filter piece-by-piece.
+ * processed in pieces and appended to the filter piece-by-piece. For
+ * example, the pieces can be obtained by updating the upstream pipeline with
+ * UpdatePiece() (as vtkPolyDataStreamer requests them), calling Append()
+ * with a shallow copy of each piece, so the whole input never has to be in
+ * memory at once. The quadrics are kept in a hash map of the bins that are
+ * actually visited, so the memory used is proportional to the number of
+ * occupied bins rather than to the number of divisions.
  *
  * @warning
  * This filter can drastically affect topology, i.e., topology is not
@@ -91,6 +97,7 @@
 class vtkCellArray;
 class vtkFeatureEdges;
 class vtkPoints;
+class vtkQuadricClusteringBinMap;
 class vtkQuadricClusteringCellSet;
 
 
@@ -255,6 +262,22 @@ public:
   vtkBooleanMacro(PreventDuplicateCells,int);
   //@}
 
+  //@{
+  /**
+   * Turn on/off the parallel accumulation of the quadrics. When on, Append()
+   * first accumulates the quadrics of the cells of the piece with
+   * vtkSMPTools, each thread in its own map of the bins it visits, and the
+   * per-thread maps are then merged pairwise in parallel. The output cells
+   * are still generated serially, in the order of the input cells, so the
+   * output has the same points and cells as the serial one; only the
+   * summation order of the quadrics (hence the last bits of the computed
+   * positions) may differ. Off by default.
+   */
+  vtkSetMacro(ParallelAccumulation,int);
+  vtkGetMacro(ParallelAccumulation,int);
+  vtkBooleanMacro(ParallelAccumulation,int);
+  //@}
+
 protected:
   vtkQuadricClustering();
   ~vtkQuadricClustering() VTK_OVERRIDE;
@@ -310,14 +333,13 @@ protected:
   //@}
 
   /**
-   * Initialize the quadric matrix to 0's.
+   * Accumulate the quadrics of all the cells of a piece with vtkSMPTools,
+   * for the following Add* calls to only generate the output cells.
+   * Used by Append() when ParallelAccumulation is on.
    */
-  void InitializeQuadric(double quadric[9]);
-
-  /**
-   * Add this quadric to the quadric already associated with this bin.
-   */
-  void AddQuadric(vtkIdType binId, double quadric[9]);
+  void AccumulateQuadricsInParallel(vtkPolyData *piece);
+  int ParallelAccumulation;
+  int QuadricsAccumulated; // the quadrics of the current piece are done
 
   /**
    * Find the feature points of a given set of edges.
@@ -379,19 +401,8 @@ protected:
   double ZBinStep;
   vtkIdType SliceSize; //eliminate one multiplication
 
-  struct PointQuadric
-  {
-    PointQuadric():VertexId(-1),Dimension(255) {}
-
-    vtkIdType VertexId;
-    // Dimension is supposed to be a flag representing the dimension of the
-    // cells contributing to the quadric.  Lines: 1, Triangles: 2 (and points
-    // 0 in the future?)
-    unsigned char Dimension;
-    double Quadric[9];
-  };
-
-  PointQuadric* QuadricArray;
+  // PIMPLd hash map of the quadrics of the visited bins, keyed by bin id.
+  vtkQuadricClusteringBinMap *QuadricBins;
   vtkIdType NumberOfBinsUsed;
 
   // Have to make these instance variables if we are going to allow
@@ -408,6 +419,9 @@ protected:
   int OutCellCount;
 
 private:
+  friend class vtkQuadricClusteringCells;
+  friend struct vtkQuadricClusteringAppend;
+
   vtkQuadricClustering(const vtkQuadricClustering&) VTK_DELETE_FUNCTION;
   void operator=(const vtkQuadricClustering&) VTK_DELETE_FUNCTION;
 };
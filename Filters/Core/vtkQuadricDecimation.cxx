@@ -53,8 +53,13 @@
 #include "vtkPolyData.h"
 #include "vtkPointData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkQuadricDecimation);
 
 
@@ -75,6 +80,7 @@ vtkQuadricDecimation::vtkQuadricDecimation()
 
   this->AttributeErrorMetric = 0;
   this->VolumePreservation = 0;
+  this->ParallelCollapse = 0;
   this->ScalarsAttribute = 1;
   this->VectorsAttribute = 1;
   this->NormalsAttribute = 1;
@@ -319,55 +325,62 @@ int vtkQuadricDecimation::RequestData(
   // Okay collapse edges until desired reduction is reached
   this->ActualReduction = 0.0;
   this->NumberOfEdgeCollapses = 0;
-  edgeId = this->EdgeCosts->Pop(0,cost);
-
-  int abort = 0;
-  while ( !abort && edgeId >= 0 && cost < VTK_DOUBLE_MAX &&
-         this->ActualReduction < this->TargetReduction )
+  if (this->ParallelCollapse)
+  {
+    this->CollapseEdgesInParallel(numTris);
+  }
+  else
   {
-    if ( ! (this->NumberOfEdgeCollapses % 10000) )
+    edgeId = this->EdgeCosts->Pop(0,cost);
+
+    int abort = 0;
+    while ( !abort && edgeId >= 0 && cost < VTK_DOUBLE_MAX &&
+           this->ActualReduction < this->TargetReduction )
     {
-      vtkDebugMacro(<<"Collapsing edge#" << this->NumberOfEdgeCollapses);
-      this->UpdateProgress (0.20 + 0.80*this->NumberOfEdgeCollapses/numPts);
-      abort = this->GetAbortExecute();
-    }
+      if ( ! (this->NumberOfEdgeCollapses % 10000) )
+      {
+        vtkDebugMacro(<<"Collapsing edge#" << this->NumberOfEdgeCollapses);
+        this->UpdateProgress (0.20 + 0.80*this->NumberOfEdgeCollapses/numPts);
+        abort = this->GetAbortExecute();
+      }
 
-    endPtIds[0] = this->EndPoint1List->GetId(edgeId);
-    endPtIds[1] = this->EndPoint2List->GetId(edgeId);
-    this->TargetPoints->GetTuple(edgeId, x);
+      endPtIds[0] = this->EndPoint1List->GetId(edgeId);
+      endPtIds[1] = this->EndPoint2List->GetId(edgeId);
+      this->TargetPoints->GetTuple(edgeId, x);
 
-    // check for a poorly placed point
-    if ( !this->IsGoodPlacement(endPtIds[0], endPtIds[1], x))
-    {
-      vtkDebugMacro(<<"Poor placement detected " << edgeId << " " <<  cost);
-      // return the point to the queue but with the max cost so that
-      // when it is recomputed it will be reconsidered
-      this->EdgeCosts->Insert(VTK_DOUBLE_MAX, edgeId);
+      // check for a poorly placed point
+      if ( !this->IsGoodPlacement(endPtIds[0], endPtIds[1], x))
+      {
+        vtkDebugMacro(<<"Poor placement detected " << edgeId << " " <<  cost);
+        // return the point to the queue but with the max cost so that
+        // when it is recomputed it will be reconsidered
+        this->EdgeCosts->Insert(VTK_DOUBLE_MAX, edgeId);
 
-      edgeId = this->EdgeCosts->Pop(0, cost);
-      continue;
-    }
+        edgeId = this->EdgeCosts->Pop(0, cost);
+        continue;
+      }
 
-    this->NumberOfEdgeCollapses++;
+      this->NumberOfEdgeCollapses++;
 
-    // Set the new coordinates of point0.
-    this->SetPointAttributeArray(endPtIds[0], x);
-    vtkDebugMacro(<<"Cost: " << cost << " Edge: "
-                  << endPtIds[0] << " " << endPtIds[1]);
+      // Set the new coordinates of point0.
+      this->SetPointAttributeArray(endPtIds[0], x);
+      vtkDebugMacro(<<"Cost: " << cost << " Edge: "
+                    << endPtIds[0] << " " << endPtIds[1]);
 
-    // Merge the quadrics of the two points.
-    this->AddQuadric(endPtIds[1], endPtIds[0]);
+      // Merge the quadrics of the two points.
+      this->AddQuadric(endPtIds[1], endPtIds[0]);
 
-    this->UpdateEdgeData(endPtIds[0], endPtIds[1]);
+      this->UpdateEdgeData(endPtIds[0], endPtIds[1]);
 
-    // Update the output triangles.
-    numDeletedTris += this->CollapseEdge(endPtIds[0], endPtIds[1]);
-    this->ActualReduction = (double) numDeletedTris / numTris;
-    edgeId = this->EdgeCosts->Pop(0, cost);
-  }
+      // Update the output triangles.
+      numDeletedTris += this->CollapseEdge(endPtIds[0], endPtIds[1]);
+      this->ActualReduction = (double) numDeletedTris / numTris;
+      edgeId = this->EdgeCosts->Pop(0, cost);
+    }
 
-  vtkDebugMacro(<<"Number Of Edge Collapses: "
-                << this->NumberOfEdgeCollapses << " Cost: " << cost);
+    vtkDebugMacro(<<"Number Of Edge Collapses: "
+                  << this->NumberOfEdgeCollapses << " Cost: " << cost);
+  }
 
   // clean up working data
   for (i = 0; i < numPts; i++)
@@ -420,6 +433,343 @@ int vtkQuadricDecimation::RequestData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+
+// An edge of a batch collapsed in parallel.
+struct vtkQuadricDecimationCandidate
+{
+  vtkIdType EdgeId;
+  vtkIdType PointIds[2];
+  int Collapsed; // 0 when the target point is poorly placed
+  int NumberOfDeletedTriangles;
+  std::vector<vtkIdType> AffectedEdges; // found before the collapse
+};
+
+// An edge too close to the edges of a batch, kept for the next rounds. It
+// is valid while the round at which it was deferred is the last one for
+// this edge, i.e. while it is not taken nor changed by a collapse.
+struct vtkQuadricDecimationDeferred
+{
+  double Cost;
+  vtkIdType EdgeId;
+  int Round;
+};
+
+// Scratch space of a thread for the cost computations.
+struct vtkQuadricDecimationScratch
+{
+  std::vector<double> Quad;
+  std::vector<double> B;
+  std::vector<double> Data;
+  std::vector<double*> A;
+};
+
+// Mark with the current round the points of the triangles using either end
+// point of an edge, i.e. its one-ring. Return the number of triangles using
+// the edge, or -1 without marking anything when one of these points is
+// already marked by another edge of the round.
+int vtkQuadricDecimationMarkOneRing(vtkPolyData *mesh,
+                                    const vtkIdType ptIds[2],
+                                    std::vector<int> &marks, int round)
+{
+  unsigned short ncells, i;
+  vtkIdType *cells, npts, *pts, j;
+  int numEdgeTris = 0;
+  int k;
+
+  // check first, the end points before their cells, then mark
+  if (marks[ptIds[0]] == round || marks[ptIds[1]] == round)
+  {
+    return -1;
+  }
+  for (k = 0; k < 2; k++)
+  {
+    mesh->GetPointCells(ptIds[k], ncells, cells);
+    for (i = 0; i < ncells; i++)
+    {
+      mesh->GetCellPoints(cells[i], npts, pts);
+      for (j = 0; j < npts; j++)
+      {
+        if (marks[pts[j]] == round)
+        {
+          return -1;
+        }
+      }
+    }
+  }
+
+  for (k = 0; k < 2; k++)
+  {
+    marks[ptIds[k]] = round;
+    mesh->GetPointCells(ptIds[k], ncells, cells);
+    for (i = 0; i < ncells; i++)
+    {
+      mesh->GetCellPoints(cells[i], npts, pts);
+      for (j = 0; j < npts; j++)
+      {
+        marks[pts[j]] = round;
+        if (k == 0 && pts[j] == ptIds[1])
+        {
+          numEdgeTris++;
+        }
+      }
+    }
+  }
+  return numEdgeTris;
+}
+
+}
+
+// Collapse the edges of a batch. Their one-rings do not overlap, so each
+// collapse only reads and writes the points, quadrics, links and triangles
+// of its own one-ring.
+class vtkQuadricDecimationCollapse
+{
+public:
+  vtkQuadricDecimation *Self;
+  vtkQuadricDecimationCandidate *Candidates;
+  int NumberOfValues; // per target point
+  vtkSMPThreadLocal<std::vector<double> > X;
+  vtkSMPThreadLocalObject<vtkIdList> AffectedEdges;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<double> &x = this->X.Local();
+    x.resize(this->NumberOfValues);
+    vtkIdList *edges = this->AffectedEdges.Local();
+    vtkIdList *cellIds = this->CellIds.Local();
+
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      vtkQuadricDecimationCandidate &candidate = this->Candidates[i];
+      vtkIdType pt0Id = candidate.PointIds[0];
+      vtkIdType pt1Id = candidate.PointIds[1];
+      this->Self->TargetPoints->GetTuple(candidate.EdgeId, &x[0]);
+
+      candidate.Collapsed = this->Self->IsGoodPlacement(pt0Id, pt1Id, &x[0]);
+      candidate.NumberOfDeletedTriangles = 0;
+      candidate.AffectedEdges.clear();
+      if (!candidate.Collapsed)
+      {
+        continue;
+      }
+
+      this->Self->SetPointAttributeArray(pt0Id, &x[0]);
+      this->Self->AddQuadric(pt1Id, pt0Id);
+      this->Self->FindAffectedEdges(pt0Id, pt1Id, edges);
+      candidate.AffectedEdges.assign(
+        edges->GetPointer(0), edges->GetPointer(0) + edges->GetNumberOfIds());
+      candidate.NumberOfDeletedTriangles =
+        this->Self->CollapseEdge(pt0Id, pt1Id, cellIds);
+    }
+  }
+};
+
+// Compute the cost and target point of a list of edges.
+class vtkQuadricDecimationCost
+{
+public:
+  vtkQuadricDecimation *Self;
+  const vtkIdType *EdgeIds;
+  double *Costs;
+  double *TargetPoints; // NumberOfValues per edge
+  int NumberOfValues;
+  vtkSMPThreadLocal<vtkQuadricDecimationScratch> Scratch;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkQuadricDecimationScratch &scratch = this->Scratch.Local();
+    int n = this->NumberOfValues;
+    if (scratch.A.empty())
+    {
+      scratch.Quad.resize(11 + 4 * this->Self->NumberOfComponents +
+                          this->Self->VolumePreservation);
+      scratch.B.resize(n);
+      scratch.Data.resize(n * n);
+      scratch.A.resize(n);
+      for (int i = 0; i < n; i++)
+      {
+        scratch.A[i] = &scratch.Data[i * n];
+      }
+    }
+
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      double *x = this->TargetPoints + i * n;
+      if (this->Self->AttributeErrorMetric)
+      {
+        this->Costs[i] = this->Self->ComputeCost2(
+          this->EdgeIds[i], x, &scratch.Quad[0], &scratch.A[0], &scratch.B[0]);
+      }
+      else
+      {
+        this->Costs[i] =
+          this->Self->ComputeCost(this->EdgeIds[i], x, &scratch.Quad[0]);
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+void vtkQuadricDecimation::CollapseEdgesInParallel(vtkIdType numTris)
+{
+  vtkIdType numPts = this->Mesh->GetNumberOfPoints();
+  int numValues = this->TargetPoints->GetNumberOfComponents();
+  double targetTris = this->TargetReduction * numTris;
+  vtkIdType numDeletedTris = 0;
+  vtkIdType edgeId, window, i;
+  double cost;
+
+  vtkQuadricDecimationCollapse collapse;
+  collapse.Self = this;
+  collapse.NumberOfValues = numValues;
+  vtkQuadricDecimationCost costs;
+  costs.Self = this;
+  costs.NumberOfValues = numValues;
+
+  std::vector<vtkQuadricDecimationCandidate> batch;
+  std::vector<vtkQuadricDecimationDeferred> deferred;
+  std::vector<vtkQuadricDecimationDeferred> nextDeferred;
+  std::vector<int> deferredRounds; // per edge, 0 when not deferred
+  std::vector<int> marks(numPts, 0);
+  std::vector<double> edgeCosts;
+  std::vector<double> targetPoints;
+  vtkIdList *costEdges = vtkIdList::New();
+  vtkQuadricDecimationCandidate candidate;
+  int round = 0;
+  int abort = 0;
+
+  while ( !abort && this->ActualReduction < this->TargetReduction )
+  {
+    // Select the cheapest edges whose one-rings do not overlap. Only the
+    // head of the queue is searched so that the batch follows the order of
+    // the costs. The edges too close to a selected one are kept, in the
+    // order of their cost, in a list merged with the queue in the next
+    // rounds rather than reinserted in the queue.
+    round++;
+    batch.clear();
+    nextDeferred.clear();
+    deferredRounds.resize(this->Edges->GetNumberOfEdges(), 0);
+    window = this->EdgeCosts->GetNumberOfItems() / 16;
+    window = (window > 16 ? window : 16);
+    double expectedDeletedTris = numDeletedTris;
+    size_t next = 0;
+    for (i = 0; i < window && expectedDeletedTris < targetTris; i++)
+    {
+      while (next < deferred.size() &&
+             deferredRounds[deferred[next].EdgeId] != deferred[next].Round)
+      {
+        next++;
+      }
+      edgeId = this->EdgeCosts->Peek(0, cost);
+      if (next < deferred.size() &&
+          (edgeId < 0 || deferred[next].Cost <= cost))
+      {
+        cost = deferred[next].Cost;
+        edgeId = deferred[next++].EdgeId;
+        deferredRounds[edgeId] = 0;
+      }
+      else if (edgeId < 0 || cost >= VTK_DOUBLE_MAX)
+      {
+        break;
+      }
+      else
+      {
+        this->EdgeCosts->Pop(0);
+      }
+      candidate.EdgeId = edgeId;
+      candidate.PointIds[0] = this->EndPoint1List->GetId(edgeId);
+      candidate.PointIds[1] = this->EndPoint2List->GetId(edgeId);
+      int numEdgeTris = vtkQuadricDecimationMarkOneRing(
+        this->Mesh, candidate.PointIds, marks, round);
+      if (numEdgeTris < 0)
+      {
+        vtkQuadricDecimationDeferred deferredEdge = { cost, edgeId, round };
+        nextDeferred.push_back(deferredEdge);
+        deferredRounds[edgeId] = round;
+        continue;
+      }
+      expectedDeletedTris += numEdgeTris;
+      batch.push_back(candidate);
+    }
+    // The edges not searched are more expensive than the ones deferred now.
+    for ( ; next < deferred.size(); next++)
+    {
+      if (deferredRounds[deferred[next].EdgeId] == deferred[next].Round)
+      {
+        nextDeferred.push_back(deferred[next]);
+      }
+    }
+    deferred.swap(nextDeferred);
+    if (batch.empty())
+    {
+      break;
+    }
+
+    collapse.Candidates = &batch[0];
+    vtkSMPTools::For(0, static_cast<vtkIdType>(batch.size()), collapse);
+
+    // Update the edge table and the queue in the order of the batch, then
+    // recompute the costs of the edges around the collapsed points.
+    costEdges->Reset();
+    for (i = 0; i < static_cast<vtkIdType>(batch.size()); i++)
+    {
+      if (!batch[i].Collapsed)
+      {
+        vtkDebugMacro(<<"Poor placement detected " << batch[i].EdgeId);
+        // return the point to the queue but with the max cost so that
+        // when it is recomputed it will be reconsidered
+        this->EdgeCosts->Insert(VTK_DOUBLE_MAX, batch[i].EdgeId);
+        continue;
+      }
+      this->NumberOfEdgeCollapses++;
+      numDeletedTris += batch[i].NumberOfDeletedTriangles;
+      std::vector<vtkIdType> &affectedEdges = batch[i].AffectedEdges;
+      if (!affectedEdges.empty())
+      {
+        // The affected edges are removed or get a new cost.
+        for (size_t j = 0; j < affectedEdges.size(); j++)
+        {
+          deferredRounds[affectedEdges[j]] = 0;
+        }
+        this->ReconnectEdges(batch[i].PointIds[0], batch[i].PointIds[1],
+                             static_cast<vtkIdType>(affectedEdges.size()),
+                             &affectedEdges[0], costEdges);
+      }
+    }
+
+    vtkIdType numCostEdges = costEdges->GetNumberOfIds();
+    if (numCostEdges > 0)
+    {
+      edgeCosts.resize(numCostEdges);
+      targetPoints.assign(numCostEdges * numValues, 0.0);
+      costs.EdgeIds = costEdges->GetPointer(0);
+      costs.Costs = &edgeCosts[0];
+      costs.TargetPoints = &targetPoints[0];
+      vtkSMPTools::For(0, numCostEdges, costs);
+      for (i = 0; i < numCostEdges; i++)
+      {
+        this->EdgeCosts->Insert(edgeCosts[i], costEdges->GetId(i));
+        this->TargetPoints->InsertTuple(costEdges->GetId(i),
+                                        &targetPoints[i * numValues]);
+      }
+    }
+
+    this->ActualReduction = (double) numDeletedTris / numTris;
+    vtkDebugMacro(<<"Collapsed a batch of " << batch.size()
+                  << " edges, edge#" << this->NumberOfEdgeCollapses);
+    this->UpdateProgress (0.20 + 0.80*this->NumberOfEdgeCollapses/numPts);
+    abort = this->GetAbortExecute();
+  }
+
+  vtkDebugMacro(<<"Number Of Edge Collapses: "
+                << this->NumberOfEdgeCollapses);
+  costEdges->Delete();
+}
+
 //----------------------------------------------------------------------------
 void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
 {
@@ -741,7 +1091,8 @@ void vtkQuadricDecimation::FindAffectedEdges(vtkIdType p1Id, vtkIdType p2Id,
 void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 {
   vtkIdList *changedEdges = vtkIdList::New();
-  vtkIdType i, edgeId, edge[2];
+  vtkIdList *costEdges = vtkIdList::New();
+  vtkIdType i, edgeId;
   double cost;
 
   // Find all edges with exactly either of these 2 endpoints.
@@ -749,80 +1100,74 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 
   // Reset the endpoints for these edges to reflect the new point from the
   // collapsed edge.
-  // Add these new edges to the edge table.
-  // Remove the the changed edges from the priority queue.
-  for (i = 0; i < changedEdges->GetNumberOfIds(); i++)
+  this->ReconnectEdges(pt0Id, pt1Id, changedEdges->GetNumberOfIds(),
+                       changedEdges->GetPointer(0), costEdges);
+
+  // Compute the cost (target point/data) of the new and changed edges and
+  // add them to the priority queue.
+  for (i = 0; i < costEdges->GetNumberOfIds(); i++)
+  {
+    edgeId = costEdges->GetId(i);
+    if (this->AttributeErrorMetric)
+    {
+      cost = this->ComputeCost2(edgeId, this->TempX);
+    }
+    else
+    {
+      cost = this->ComputeCost(edgeId, this->TempX);
+    }
+    this->EdgeCosts->Insert(cost, edgeId);
+    this->TargetPoints->InsertTuple(edgeId, this->TempX);
+  }
+
+  changedEdges->Delete();
+  costEdges->Delete();
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricDecimation::ReconnectEdges(vtkIdType pt0Id, vtkIdType pt1Id,
+                                          vtkIdType numEdges,
+                                          const vtkIdType *changedEdges,
+                                          vtkIdList *costEdges)
+{
+  vtkIdType i, edgeId, otherId, edge[2];
+
+  for (i = 0; i < numEdges; i++)
   {
-    edge[0] = this->EndPoint1List->GetId(changedEdges->GetId(i));
-    edge[1] = this->EndPoint2List->GetId(changedEdges->GetId(i));
+    edge[0] = this->EndPoint1List->GetId(changedEdges[i]);
+    edge[1] = this->EndPoint2List->GetId(changedEdges[i]);
 
     // Remove all affected edges from the priority queue.
-    // This does not include collapsed edge.
-    this->EdgeCosts->DeleteId(changedEdges->GetId(i));
+    this->EdgeCosts->DeleteId(changedEdges[i]);
 
-    // Determine the new set of edges
-    if (edge[0] == pt1Id)
+    if (edge[0] == pt1Id || edge[1] == pt1Id)
     {
-      if (this->Edges->IsEdge(edge[1], pt0Id) == -1)
+      otherId = (edge[0] == pt1Id ? edge[1] : edge[0]);
+      if (this->Edges->IsEdge(otherId, pt0Id) == -1)
       { // The edge will be completely new, add it.
         edgeId = this->Edges->GetNumberOfEdges();
-        this->Edges->InsertEdge(edge[1], pt0Id, edgeId);
-        this->EndPoint1List->InsertId(edgeId, edge[1]);
+        this->Edges->InsertEdge(otherId, pt0Id, edgeId);
+        this->EndPoint1List->InsertId(edgeId, otherId);
         this->EndPoint2List->InsertId(edgeId, pt0Id);
-        // Compute cost (target point/data) and add to priority cue.
-        if (this->AttributeErrorMetric)
-        {
-          cost = this->ComputeCost2(edgeId, this->TempX);
-        }
-        else
-        {
-          cost = this->ComputeCost(edgeId, this->TempX);
-        }
-        this->EdgeCosts->Insert(cost, edgeId);
-        this->TargetPoints->InsertTuple(edgeId, this->TempX);
-      }
-    }
-    else if (edge[1] == pt1Id)
-    { // The edge will be completely new, add it.
-      if (this->Edges->IsEdge(edge[0], pt0Id) == -1)
-      {
-        edgeId = this->Edges->GetNumberOfEdges();
-        this->Edges->InsertEdge(edge[0], pt0Id, edgeId);
-        this->EndPoint1List->InsertId(edgeId, edge[0]);
-        this->EndPoint2List->InsertId(edgeId, pt0Id);
-        // Compute cost (target point/data) and add to priority cue.
-        if (this->AttributeErrorMetric)
-        {
-          cost = this->ComputeCost2(edgeId, this->TempX);
-        }
-        else
-        {
-          cost = this->ComputeCost(edgeId, this->TempX);
-        }
-        this->EdgeCosts->Insert(cost, edgeId);
-        this->TargetPoints->InsertTuple(edgeId, this->TempX);
+        costEdges->InsertNextId(edgeId);
       }
     }
     else
     { // This edge already has one point as the merged point.
-      if (this->AttributeErrorMetric)
-      {
-        cost = this->ComputeCost2(changedEdges->GetId(i), this->TempX);
-      }
-      else
-      {
-        cost = this->ComputeCost(changedEdges->GetId(i), this->TempX);
-      }
-      this->EdgeCosts->Insert(cost, changedEdges->GetId(i));
-      this->TargetPoints->InsertTuple(changedEdges->GetId(i), this->TempX);
+      costEdges->InsertNextId(changedEdges[i]);
     }
   }
-
-  changedEdges->Delete();
 }
 
 //----------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double *x)
+{
+  return this->ComputeCost(edgeId, x, this->TempQuad);
+}
+
+//----------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double *x,
+                                         double *quad)
 {
   static const double errorNumber = 1e-10;
   double temp[3], A[3][3], b[3];
@@ -839,20 +1184,20 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double *x)
 
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] = this->ErrorQuadrics[pointIds[0]].Quadric[i] +
+    quad[i] = this->ErrorQuadrics[pointIds[0]].Quadric[i] +
       this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
-  A[0][0] = this->TempQuad[0];
-  A[0][1] = A[1][0] = this->TempQuad[1];
-  A[0][2] = A[2][0] = this->TempQuad[2];
-  A[1][1] = this->TempQuad[4];
-  A[1][2] = A[2][1] = this->TempQuad[5];
-  A[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
-  b[0] = -this->TempQuad[3];
-  b[1] = -this->TempQuad[6];
-  b[2] = -this->TempQuad[8];
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
 
   norm = vtkMath::Norm(A[0]);
   normTemp = vtkMath::Norm(A[1]);
@@ -906,7 +1251,7 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double *x)
 
   // Compute the cost
   // x'*quad*x
-  index = this->TempQuad;
+  index = quad;
   for (i = 0; i < 4; i++)
   {
     cost += (*index++)*newPoint[i]*newPoint[i];
@@ -922,6 +1267,15 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double *x)
 
 //----------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
+{
+  return this->ComputeCost2(edgeId, x, this->TempQuad, this->TempA,
+                            this->TempB);
+}
+
+//----------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x,
+                                          double *quad, double **A,
+                                          double *B)
 {
   // this function is so ugly because the functionality of converting an QEM
   // into a dense matrix was not extracted into a separate function and
@@ -937,29 +1291,29 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
 
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] = this->ErrorQuadrics[pointIds[0]].Quadric[i] +
+    quad[i] = this->ErrorQuadrics[pointIds[0]].Quadric[i] +
       this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
   // copy the temp quad into TempA
   // converting from the sparse matrix format into a dense
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
-  this->TempB[0] = -this->TempQuad[3];
-  this->TempB[1] = -this->TempQuad[6];
-  this->TempB[2] = -this->TempQuad[8];
+  B[0] = -quad[3];
+  B[1] = -quad[6];
+  B[2] = -quad[8];
 
   for (i = 3; i < 3 +  this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11+4*(i-3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11+4*(i-3)+1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11+4*(i-3)+2];
-    this->TempB[i] = -this->TempQuad[11+4*(i-3)+3];
+    A[0][i] = A[i][0] = quad[11+4*(i-3)];
+    A[1][i] = A[i][1] = quad[11+4*(i-3)+1];
+    A[2][i] = A[i][2] = quad[11+4*(i-3)+2];
+    B[i] = -quad[11+4*(i-3)+3];
   }
 
 
@@ -970,11 +1324,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        A[i][j] = quad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        A[i][j] = 0;
       }
     }
   }
@@ -985,45 +1339,45 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        A[i][3 + this->NumberOfComponents] = 0;
+        A[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] += this->VolumeConstraints[pointIds[1] * 4 + i];
+        A[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[i][3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + i];
+        A[3 + this->NumberOfComponents][i] += this->VolumeConstraints[pointIds[1] * 4 + i];
       }
     }
     // Add constraint to b
-    this->TempB[3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + 3];
-    this->TempB[3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + 3];
+    B[3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + 3];
+    B[3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + 3];
   }
 
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    x[i] = this->TempB[i];
+    x[i] = B[i];
   }
 
   // solve A*x = b
   // this clobers A
   // need to develop a quality of the solution test??
-  solveOk = vtkMath::SolveLinearSystem(this->TempA, x, 3 + this->NumberOfComponents + this->VolumePreservation);
+  solveOk = vtkMath::SolveLinearSystem(A, x, 3 + this->NumberOfComponents + this->VolumePreservation);
 
   // need to copy back into A
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
   for (i = 3; i < 3 +  this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11+4*(i-3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11+4*(i-3)+1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11+4*(i-3)+2];
+    A[0][i] = A[i][0] = quad[11+4*(i-3)];
+    A[1][i] = A[i][1] = quad[11+4*(i-3)+1];
+    A[2][i] = A[i][2] = quad[11+4*(i-3)+2];
   }
 
   for (i = 3; i < 3 +  this->NumberOfComponents; i++)
@@ -1032,11 +1386,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        A[i][j] = quad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        A[i][j] = 0;
       }
     }
   }
@@ -1047,15 +1401,15 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        A[i][3 + this->NumberOfComponents] = 0;
+        A[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] += this->VolumeConstraints[pointIds[1] * 4 + i];
+        A[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[i][3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + i];
+        A[3 + this->NumberOfComponents][i] += this->VolumeConstraints[pointIds[1] * 4 + i];
       }
     }
   }
@@ -1088,7 +1442,7 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
       temp2[i] = 0;
       for (j = 0; j < 3 + this->NumberOfComponents; ++j)
       {
-        temp2[i] += this->TempA[i][j]*v[j];
+        temp2[i] += A[i][j]*v[j];
       }
     }
 
@@ -1106,13 +1460,13 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
         temp[i] = 0;
         for (j = 0; j < 3 + this->NumberOfComponents; ++j)
         {
-          temp[i] += this->TempA[i][j]*pt1[j];
+          temp[i] += A[i][j]*pt1[j];
         }
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
       {
-        temp[i] = this->TempB[i] - temp[i];
+        temp[i] = B[i] - temp[i];
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
@@ -1146,32 +1500,39 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
   // x'*A*x - 2*b*x + d
   for (i = 0; i < 3+this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost += this->TempA[i][i]*x[i]*x[i];
+    cost += A[i][i]*x[i]*x[i];
     for (j = i+1; j < 3+this->NumberOfComponents + this->VolumePreservation; j++)
     {
-      cost += 2.0*this->TempA[i][j]*x[i]*x[j];
+      cost += 2.0*A[i][j]*x[i]*x[j];
     }
   }
   for (i = 0; i < 3+this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost -=  2.0 * this->TempB[i]*x[i];
+    cost -=  2.0 * B[i]*x[i];
   }
 
-  cost += this->TempQuad[9];
+  cost += quad[9];
 
   return cost;
 }
 
 
 int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
+{
+  return this->CollapseEdge(pt0Id, pt1Id, this->CollapseCellIds);
+}
+
+//----------------------------------------------------------------------------
+int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id,
+                                       vtkIdList *cellIds)
 {
   int j, numDeleted=0;
   vtkIdType i, npts, *pts, cellId;
 
-  this->Mesh->GetPointCells(pt0Id, this->CollapseCellIds);
-  for (i = 0; i < this->CollapseCellIds->GetNumberOfIds(); i++)
+  this->Mesh->GetPointCells(pt0Id, cellIds);
+  for (i = 0; i < cellIds->GetNumberOfIds(); i++)
   {
-    cellId = this->CollapseCellIds->GetId(i);
+    cellId = cellIds->GetId(i);
     this->Mesh->GetCellPoints(cellId, npts, pts);
     for (j = 0; j < 3; j++)
     {
@@ -1184,11 +1545,11 @@ int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
     }
   }
 
-  this->Mesh->GetPointCells(pt1Id, this->CollapseCellIds);
-  this->Mesh->ResizeCellList(pt0Id, this->CollapseCellIds->GetNumberOfIds());
-  for (i=0; i < this->CollapseCellIds->GetNumberOfIds(); i++)
+  this->Mesh->GetPointCells(pt1Id, cellIds);
+  this->Mesh->ResizeCellList(pt0Id, cellIds->GetNumberOfIds());
+  for (i=0; i < cellIds->GetNumberOfIds(); i++)
   {
-    cellId = this->CollapseCellIds->GetId(i);
+    cellId = cellIds->GetId(i);
     this->Mesh->GetCellPoints(cellId, npts, pts);
     // making sure we don't already have the triangle we're about to
     // change this one to
@@ -1438,6 +1799,8 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
      << (this->AttributeErrorMetric ? "On\n" : "Off\n");
   os << indent << "Volume Preservation: "
     << (this->VolumePreservation ? "On\n" : "Off\n");
+  os << indent << "Parallel Collapse: "
+     << (this->ParallelCollapse ? "On\n" : "Off\n");
   os << indent << "Scalars Attribute: "
      << (this->ScalarsAttribute ? "On\n" : "Off\n");
   os << indent << "Vectors Attribute: "
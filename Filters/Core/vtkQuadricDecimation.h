@@ -156,17 +156,43 @@ public:
   vtkGetMacro(ActualReduction, double);
   //@}
 
+  //@{
+  /**
+   * Turn on/off the collapse of the edges in parallel batches. When on, each
+   * batch is made of the cheapest edges of the queue whose one-rings (the
+   * points of the triangles using either end point) do not overlap. The
+   * edges of a batch are collapsed concurrently with vtkSMPTools, then the
+   * costs of the edges around the collapsed points are recomputed, also in
+   * parallel. The edges are thus not collapsed in the exact order of their
+   * cost, and the output differs from the serial one, but the reduction and
+   * the quality of the approximation are comparable. Off by default.
+   */
+  vtkSetMacro(ParallelCollapse, int);
+  vtkGetMacro(ParallelCollapse, int);
+  vtkBooleanMacro(ParallelCollapse, int);
+  //@}
+
 protected:
   vtkQuadricDecimation();
   ~vtkQuadricDecimation() VTK_OVERRIDE;
 
   int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *) VTK_OVERRIDE;
 
+  //@{
   /**
    * Do the dirty work of eliminating the edge; return the number of
-   * triangles deleted.
+   * triangles deleted. The second signature uses cellIds as scratch space
+   * instead of CollapseCellIds.
    */
   int CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id);
+  int CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id, vtkIdList *cellIds);
+  //@}
+
+  /**
+   * Collapse edges in parallel batches until the desired reduction is
+   * reached. Used by RequestData() when ParallelCollapse is on.
+   */
+  void CollapseEdgesInParallel(vtkIdType numTris);
 
   /**
    * Compute quadric for all vertices
@@ -198,6 +224,16 @@ protected:
   double ComputeCost2(vtkIdType edgeId, double *x);
   //@}
 
+  //@{
+  /**
+   * Same as above, with the given scratch space instead of TempQuad, TempA
+   * and TempB so that costs can be computed concurrently.
+   */
+  double ComputeCost(vtkIdType edgeId, double *x, double *quad);
+  double ComputeCost2(vtkIdType edgeId, double *x, double *quad,
+                      double **A, double *B);
+  //@}
+
   /**
    * Find all edges that will have an endpoint change ids because of an edge
    * collapse.  p1Id and p2Id are the endpoints of the edge.  p2Id is the
@@ -216,6 +252,15 @@ protected:
   void ComputeNumberOfComponents(void);
   void UpdateEdgeData(vtkIdType ptoId, vtkIdType pt1Id);
 
+  /**
+   * Remove the edges found by FindAffectedEdges() for the collapse of pt1Id
+   * into pt0Id from the priority queue, and add the edges they become to the
+   * edge table. The edges whose cost must be recomputed are appended to
+   * costEdges. Used by UpdateEdgeData() and by the parallel collapse.
+   */
+  void ReconnectEdges(vtkIdType pt0Id, vtkIdType pt1Id, vtkIdType numEdges,
+                      const vtkIdType *changedEdges, vtkIdList *costEdges);
+
   //@{
   /**
    * Helper function to set and get the point and it's attributes as an array
@@ -234,6 +279,7 @@ protected:
   double ActualReduction;
   int   AttributeErrorMetric;
   int   VolumePreservation;
+  int   ParallelCollapse;
 
   int ScalarsAttribute;
   int VectorsAttribute;
@@ -279,6 +325,9 @@ protected:
   double *TempData;
 
 private:
+  friend class vtkQuadricDecimationCollapse;
+  friend class vtkQuadricDecimationCost;
+
   vtkQuadricDecimation(const vtkQuadricDecimation&) VTK_DELETE_FUNCTION;
   void operator=(const vtkQuadricDecimation&) VTK_DELETE_FUNCTION;
 };
@@ -25,10 +25,14 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleFilter.h"
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 vtkStandardNewMacro(vtkSmoothPolyDataFilter);
 
@@ -129,6 +133,7 @@ vtkSmoothPolyDataFilter::vtkSmoothPolyDataFilter()
   this->GenerateErrorVectors = 0;
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->ParallelSmoothing = 0;
 
   this->SmoothPoints = NULL;
 
@@ -279,6 +284,136 @@ template<typename T> void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
   vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
 }
 
+// One Jacobi iteration over a range of points: each movable point is moved
+// toward the mean of its neighbors (Offsets/Neighbors, in compressed row
+// form) as positioned in InCoords, and written to OutCoords. The largest
+// move of the iteration is reduced into MaxDistance.
+template<typename T> struct vtkSPDF_MovePointsFunctor
+{
+  const vtkIdType *Offsets;
+  const vtkIdType *Neighbors;
+  const T *InCoords;
+  T *OutCoords;
+  T Factor;
+  vtkSMPThreadLocal<T> MaxDist;
+  T MaxDistance;
+
+  void Initialize()
+  {
+    this->MaxDist.Local() = 0.0;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    T &maxDist = this->MaxDist.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const T *x = this->InCoords + 3 * i;
+      T *xNew = this->OutCoords + 3 * i;
+      vtkIdType npts = this->Offsets[i + 1] - this->Offsets[i];
+      if (npts == 0)
+      {
+        xNew[0] = x[0];
+        xNew[1] = x[1];
+        xNew[2] = x[2];
+        continue;
+      }
+
+      // Compute the mean (cumulated) direction vector
+      T deltaX[3] = { 0.0, 0.0, 0.0 };
+      const vtkIdType *edgeIdPtr = this->Neighbors + this->Offsets[i];
+      for (vtkIdType j = 0; j < npts; ++j, ++edgeIdPtr)
+      {
+        for (int k = 0; k < 3; ++k)
+        {
+          deltaX[k] += this->InCoords[3 * (*edgeIdPtr) + k];
+        }
+      }
+
+      // Move the point
+      for (int k = 0; k < 3; ++k)
+      {
+        xNew[k] = x[k] + this->Factor * (deltaX[k] / npts - x[k]);
+      }
+
+      T dist = vtkMath::Norm(deltaX);
+      if (dist > maxDist)
+      {
+        maxDist = dist;
+      }
+    }
+  }
+
+  // Threads which took no range keep the value of a previous iteration:
+  // clear every local once it has been reduced.
+  void Reduce()
+  {
+    this->MaxDistance = 0.0;
+    for (typename vtkSMPThreadLocal<T>::iterator itr = this->MaxDist.begin();
+         itr != this->MaxDist.end(); ++itr)
+    {
+      this->MaxDistance = std::max(this->MaxDistance, *itr);
+      *itr = 0.0;
+    }
+  }
+};
+
+template<typename T> void vtkSPDF_MovePointsInParallel(vtkSPDF_InternalParams<T>& params)
+{
+  // Gather the edges of the movable points once.
+  std::vector<vtkIdType> offsets(params.numPts + 1, 0);
+  std::vector<vtkIdType> neighbors;
+  vtkMeshVertexPtr vertsPtr = params.vertexPtr;
+  for (vtkIdType i = 0; i < params.numPts; ++i, ++vertsPtr)
+  {
+    if (vertsPtr->type != VTK_FIXED_VERTEX && vertsPtr->edges != NULL)
+    {
+      vtkIdType *edgeIdPtr = vertsPtr->edges->GetPointer(0);
+      neighbors.insert(neighbors.end(), edgeIdPtr,
+                       edgeIdPtr + vertsPtr->edges->GetNumberOfIds());
+    }
+    offsets[i + 1] = static_cast<vtkIdType>(neighbors.size());
+  }
+
+  // Double buffer the coordinates.
+  T* newPtsCoords = static_cast<T*>(params.newPts->GetVoidPointer(0));
+  std::vector<T> buffer(3 * params.numPts);
+  T* coords[2] = { newPtsCoords, &buffer[0] };
+
+  vtkSPDF_MovePointsFunctor<T> mover;
+  mover.Offsets = &offsets[0];
+  mover.Neighbors = neighbors.empty() ? NULL : &neighbors[0];
+  mover.Factor = params.factor;
+  mover.MaxDistance = 0.0;
+
+  int iterationNumber = 0;
+  for (T maxDist = std::numeric_limits<T>::max();
+       maxDist > params.conv && iterationNumber < params.numberOfIterations;
+       ++iterationNumber)
+  {
+    if (iterationNumber && !(iterationNumber % 5))
+    {
+      params.spdf->UpdateProgress(0.5 + 0.5*iterationNumber / params.numberOfIterations);
+      if (params.spdf->GetAbortExecute())
+      {
+        break;
+      }
+    }
+
+    mover.InCoords = coords[iterationNumber % 2];
+    mover.OutCoords = coords[(iterationNumber + 1) % 2];
+    vtkSMPTools::For(0, params.numPts, mover);
+    maxDist = mover.MaxDistance;
+  }
+
+  if (iterationNumber % 2)
+  {
+    std::copy(buffer.begin(), buffer.end(), newPtsCoords);
+  }
+
+  vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
+}
+
 }// namespace
 
 int vtkSmoothPolyDataFilter::RequestData(
@@ -686,7 +821,14 @@ int vtkSmoothPolyDataFilter::RequestData(
                                               Verts, source, this->SmoothPoints,
                                               w, cellLocator };
 
-    vtkSPDF_MovePoints(params);
+    if (this->ParallelSmoothing && !source)
+    {
+      vtkSPDF_MovePointsInParallel(params);
+    }
+    else
+    {
+      vtkSPDF_MovePoints(params);
+    }
   }
   else
   {
@@ -695,7 +837,14 @@ int vtkSmoothPolyDataFilter::RequestData(
                                              static_cast<float>(conv), numPts, Verts,
                                              source, this->SmoothPoints, w, cellLocator };
 
-    vtkSPDF_MovePoints(params);
+    if (this->ParallelSmoothing && !source)
+    {
+      vtkSPDF_MovePointsInParallel(params);
+    }
+    else
+    {
+      vtkSPDF_MovePoints(params);
+    }
   }
 
   if ( source )
@@ -805,4 +954,5 @@ void vtkSmoothPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Parallel Smoothing: " << (this->ParallelSmoothing ? "On\n" : "Off\n");
 }
@@ -215,6 +215,22 @@ public:
   vtkGetMacro(OutputPointsPrecision,int);
   //@}
 
+  //@{
+  /**
+   * Turn on/off the smoothing iterations in parallel (vtkSMPTools). Each
+   * iteration then moves all the points from their positions at the end of
+   * the previous iteration (Jacobi iterations), rather than from partially
+   * updated positions as the serial sweep does, so the results differ
+   * slightly from the serial ones but do not depend on the number of
+   * threads. The vertex classification (fixed, feature edge and boundary
+   * vertices) is unchanged. Constrained smoothing with a Source is always
+   * serial. Off by default.
+   */
+  vtkSetMacro(ParallelSmoothing,int);
+  vtkGetMacro(ParallelSmoothing,int);
+  vtkBooleanMacro(ParallelSmoothing,int);
+  //@}
+
 protected:
   vtkSmoothPolyDataFilter();
   ~vtkSmoothPolyDataFilter() VTK_OVERRIDE {}
@@ -232,6 +248,7 @@ protected:
   int GenerateErrorScalars;
   int GenerateErrorVectors;
   int OutputPointsPrecision;
+  int ParallelSmoothing;
 
   vtkSmoothPoints *SmoothPoints;
 private:
@@ -14,18 +14,29 @@
 =========================================================================*/
 #include "vtkThreshold.h"
 
+#include "vtkArrayDispatch.h"
+#include "vtkArrayListTemplate.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkMath.h"
 
 #include <algorithm>
+#include <vector>
 
 vtkStandardNewMacro(vtkThreshold);
 
@@ -47,6 +58,8 @@ vtkThreshold::vtkThreshold()
                                vtkDataSetAttributes::SCALARS);
 
   this->UseContinuousCellRange = 0;
+  this->ParallelThresholding = 0;
+  this->SelectionOnly = 0;
 }
 
 vtkThreshold::~vtkThreshold()
@@ -133,6 +146,17 @@ int vtkThreshold::RequestData(
     return 1;
   }
 
+  // are we using pointScalars?
+  int fieldAssociation = this->GetInputArrayAssociation(0, inputVector);
+  bool usePointScalars = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS;
+
+  vtkUnstructuredGrid *inputGrid = vtkUnstructuredGrid::SafeDownCast(input);
+  if ( this->SelectionOnly ||
+       (this->ParallelThresholding && !(inputGrid && inputGrid->GetFaces())) )
+  {
+    return this->ThresholdInParallel(input, inScalars, usePointScalars, output);
+  }
+
   outPD->CopyGlobalIdsOn();
   outPD->CopyAllocate(pd);
   outCD->CopyGlobalIdsOn();
@@ -176,10 +200,6 @@ int vtkThreshold::RequestData(
 
   newCellPts = vtkIdList::New();
 
-  // are we using pointScalars?
-  int fieldAssociation = this->GetInputArrayAssociation(0, inputVector);
-  bool usePointScalars = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS;
-
   // Check that the scalars of each cell satisfy the threshold criterion
   for (cellId=0; cellId < input->GetNumberOfCells(); cellId++)
   {
@@ -344,6 +364,578 @@ int vtkThreshold::EvaluateComponents( vtkDataArray *scalars, vtkIdType id )
 }
 
 
+namespace
+{
+
+// The threshold criterion, as evaluated by vtkThreshold::EvaluateComponents()
+// and vtkThreshold::EvaluateCell().
+struct vtkThresholdCriterion
+{
+  enum { LOWER, UPPER, BETWEEN };
+  int Function;
+  double Lower;
+  double Upper;
+  int ComponentMode;
+  int Component;
+  int NumberOfComponents;
+  bool UsePointScalars;
+  int AllScalars;
+  int UseContinuousCellRange;
+
+  bool Test(double s) const
+  {
+    switch (this->Function)
+    {
+      case LOWER:
+        return s <= this->Lower;
+      case UPPER:
+        return s >= this->Upper;
+      default:
+        return s >= this->Lower && s <= this->Upper;
+    }
+  }
+};
+
+// Select the cells satisfying the criterion: the size of their connectivity
+// entry (number of points + 1) is stored, 0 for the other cells.
+template <typename ArrayT>
+struct vtkThresholdSelectCells
+{
+  ArrayT *Scalars;
+  vtkDataSet *Input;
+  const vtkThresholdCriterion *Criterion;
+  vtkIdType *CellSizes;
+  vtkSMPThreadLocalObject<vtkIdList> CellPts;
+
+  vtkThresholdSelectCells(ArrayT *scalars, vtkDataSet *input,
+                          const vtkThresholdCriterion *criterion,
+                          vtkIdType *cellSizes) :
+    Scalars(scalars), Input(input), Criterion(criterion), CellSizes(cellSizes)
+  {
+  }
+
+  bool EvaluateComponents(vtkIdType id) const
+  {
+    vtkDataArrayAccessor<ArrayT> s(this->Scalars);
+    const vtkThresholdCriterion &crit = *this->Criterion;
+    switch (crit.ComponentMode)
+    {
+      case VTK_COMPONENT_MODE_USE_ANY:
+        for (int c = 0; c < crit.NumberOfComponents; ++c)
+        {
+          if (crit.Test(static_cast<double>(s.Get(id, c))))
+          {
+            return true;
+          }
+        }
+        return false;
+      case VTK_COMPONENT_MODE_USE_ALL:
+        for (int c = 0; c < crit.NumberOfComponents; ++c)
+        {
+          if (!crit.Test(static_cast<double>(s.Get(id, c))))
+          {
+            return false;
+          }
+        }
+        return true;
+      default:
+        return crit.Test(static_cast<double>(s.Get(id, crit.Component)));
+    }
+  }
+
+  bool EvaluateRange(vtkIdType numCellPts, const vtkIdType *pts, int c) const
+  {
+    vtkDataArrayAccessor<ArrayT> s(this->Scalars);
+    double minScalar=DBL_MAX, maxScalar=DBL_MIN;
+    for (vtkIdType i = 0; i < numCellPts; ++i)
+    {
+      double value = static_cast<double>(s.Get(pts[i], c));
+      minScalar = std::min(value, minScalar);
+      maxScalar = std::max(value, maxScalar);
+    }
+    return !(this->Criterion->Lower > maxScalar ||
+             this->Criterion->Upper < minScalar);
+  }
+
+  bool EvaluateCell(vtkIdType numCellPts, const vtkIdType *pts) const
+  {
+    const vtkThresholdCriterion &crit = *this->Criterion;
+    switch (crit.ComponentMode)
+    {
+      case VTK_COMPONENT_MODE_USE_ANY:
+        for (int c = 0; c < crit.NumberOfComponents; ++c)
+        {
+          if (this->EvaluateRange(numCellPts, pts, c))
+          {
+            return true;
+          }
+        }
+        return false;
+      case VTK_COMPONENT_MODE_USE_ALL:
+        for (int c = 0; c < crit.NumberOfComponents; ++c)
+        {
+          if (!this->EvaluateRange(numCellPts, pts, c))
+          {
+            return false;
+          }
+        }
+        return true;
+      default:
+        return this->EvaluateRange(numCellPts, pts, crit.Component);
+    }
+  }
+
+  void Initialize()
+  {
+    this->CellPts.Local()->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    const vtkThresholdCriterion &crit = *this->Criterion;
+    vtkIdList *&cellPts = this->CellPts.Local();
+    for ( ; cellId < endCellId; ++cellId)
+    {
+      this->CellSizes[cellId] = 0;
+      if (this->Input->GetCellType(cellId) == VTK_EMPTY_CELL)
+      {
+        continue;
+      }
+      this->Input->GetCellPoints(cellId, cellPts);
+      vtkIdType numCellPts = cellPts->GetNumberOfIds();
+      const vtkIdType *pts = cellPts->GetPointer(0);
+
+      bool keepCell;
+      if (crit.UsePointScalars)
+      {
+        if (crit.AllScalars)
+        {
+          keepCell = true;
+          for (vtkIdType i = 0; keepCell && i < numCellPts; ++i)
+          {
+            keepCell = this->EvaluateComponents(pts[i]);
+          }
+        }
+        else if (!crit.UseContinuousCellRange)
+        {
+          keepCell = false;
+          for (vtkIdType i = 0; !keepCell && i < numCellPts; ++i)
+          {
+            keepCell = this->EvaluateComponents(pts[i]);
+          }
+        }
+        else
+        {
+          keepCell = this->EvaluateCell(numCellPts, pts);
+        }
+      }
+      else
+      {
+        keepCell = this->EvaluateComponents(cellId);
+      }
+
+      if (numCellPts > 0 && keepCell)
+      {
+        this->CellSizes[cellId] = numCellPts + 1;
+      }
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+// vtkArrayDispatch worker running vtkThresholdSelectCells.
+struct vtkThresholdSelectWorker
+{
+  vtkDataSet *Input;
+  const vtkThresholdCriterion *Criterion;
+  vtkIdType *CellSizes;
+
+  template <typename ArrayT>
+  void operator()(ArrayT *scalars)
+  {
+    vtkThresholdSelectCells<ArrayT> select(scalars, this->Input,
+                                           this->Criterion, this->CellSizes);
+    vtkSMPTools::For(0, this->Input->GetNumberOfCells(), select);
+  }
+};
+
+// 1 for the selected cells, 0 for the others.
+struct vtkThresholdIsSelected
+{
+  vtkIdType operator()(vtkIdType cellSize) const
+  {
+    return cellSize > 0 ? 1 : 0;
+  }
+};
+
+// Store the ids of the selected cells and their locations in the output
+// connectivity, given the exclusive scans of the selection and of the cell
+// sizes.
+struct vtkThresholdFillCells
+{
+  const vtkIdType *CellSizes;
+  const vtkIdType *NewCellIds;
+  const vtkIdType *CellOffsets;
+  vtkIdType *CellIds;
+  vtkIdType *Locations;
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    for ( ; cellId < endCellId; ++cellId)
+    {
+      if (this->CellSizes[cellId] > 0)
+      {
+        vtkIdType newCellId = this->NewCellIds[cellId];
+        this->CellIds[newCellId] = cellId;
+        this->Locations[newCellId] = this->CellOffsets[cellId];
+      }
+    }
+  }
+};
+
+// Copy the selected cells (with the ids of the input points) to the output
+// connectivity, and mark their points as used in the marks of the thread.
+struct vtkThresholdCopyCells
+{
+  vtkDataSet *Input;
+  const vtkIdType *CellIds;
+  const vtkIdType *Locations;
+  vtkIdType *Connectivity;
+  unsigned char *Types;
+  vtkIdType NumberOfPoints;
+  vtkSMPThreadLocal<std::vector<unsigned char> > UsedPoints;
+  vtkSMPThreadLocalObject<vtkIdList> CellPts;
+
+  void Initialize()
+  {
+    this->UsedPoints.Local().resize(this->NumberOfPoints, 0);
+    this->CellPts.Local()->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType newCellId, vtkIdType endNewCellId)
+  {
+    std::vector<unsigned char> &usedPoints = this->UsedPoints.Local();
+    vtkIdList *&cellPts = this->CellPts.Local();
+    for ( ; newCellId < endNewCellId; ++newCellId)
+    {
+      vtkIdType cellId = this->CellIds[newCellId];
+      this->Input->GetCellPoints(cellId, cellPts);
+      vtkIdType numCellPts = cellPts->GetNumberOfIds();
+      vtkIdType *conn = this->Connectivity + this->Locations[newCellId];
+      *conn++ = numCellPts;
+      const vtkIdType *pts = cellPts->GetPointer(0);
+      for (vtkIdType i = 0; i < numCellPts; ++i)
+      {
+        conn[i] = pts[i];
+        usedPoints[pts[i]] = 1;
+      }
+      this->Types[newCellId] =
+        static_cast<unsigned char>(this->Input->GetCellType(cellId));
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+// Merge the marks of the threads into one mark per point.
+struct vtkThresholdMergeUsedPoints
+{
+  std::vector<const unsigned char*> ThreadUsedPoints;
+  vtkIdType *UsedPoints;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      for (size_t t = 0; t < this->ThreadUsedPoints.size(); ++t)
+      {
+        if (this->ThreadUsedPoints[t][ptId])
+        {
+          this->UsedPoints[ptId] = 1;
+          break;
+        }
+      }
+    }
+  }
+};
+
+// Renumber the points of the output cells.
+struct vtkThresholdRenumberPoints
+{
+  const vtkIdType *PointMap;
+  const vtkIdType *Locations;
+  vtkIdType *Connectivity;
+
+  void operator()(vtkIdType newCellId, vtkIdType endNewCellId)
+  {
+    for ( ; newCellId < endNewCellId; ++newCellId)
+    {
+      vtkIdType *conn = this->Connectivity + this->Locations[newCellId];
+      vtkIdType numCellPts = *conn++;
+      for (vtkIdType i = 0; i < numCellPts; ++i)
+      {
+        conn[i] = this->PointMap[conn[i]];
+      }
+    }
+  }
+};
+
+// Copy the used points and their data, and store the input id of each
+// output point.
+struct vtkThresholdCopyPoints
+{
+  vtkDataSet *Input;
+  const vtkIdType *UsedPoints;
+  const vtkIdType *PointMap;
+  vtkPoints *Points;
+  ArrayList *Arrays;
+  vtkIdType *PointIds;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    double x[3];
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      if (this->UsedPoints[ptId])
+      {
+        vtkIdType newId = this->PointMap[ptId];
+        this->Input->GetPoint(ptId, x);
+        this->Points->SetPoint(newId, x);
+        this->Arrays->Copy(ptId, newId);
+        this->PointIds[newId] = ptId;
+      }
+    }
+  }
+};
+
+// Copy the data of the selected cells.
+struct vtkThresholdCopyCellData
+{
+  const vtkIdType *CellIds;
+  ArrayList *Arrays;
+
+  void operator()(vtkIdType newCellId, vtkIdType endNewCellId)
+  {
+    for ( ; newCellId < endNewCellId; ++newCellId)
+    {
+      this->Arrays->Copy(this->CellIds[newCellId], newCellId);
+    }
+  }
+};
+
+// Copy the tuples of the arrays that are not data arrays (e.g., string
+// arrays), which ArrayList does not process.
+void vtkThresholdCopyOtherArrays(vtkDataSetAttributes *inDA,
+                                 vtkDataSetAttributes *outDA,
+                                 vtkIdType numOutTuples,
+                                 const vtkIdType *inIds)
+{
+  for (int i = 0; i < outDA->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray *outArray = outDA->GetAbstractArray(i);
+    vtkAbstractArray *inArray = (outArray && outArray->GetName()) ?
+      inDA->GetAbstractArray(outArray->GetName()) : NULL;
+    if (inArray && !vtkArrayDownCast<vtkDataArray>(outArray))
+    {
+      outArray->SetNumberOfTuples(numOutTuples);
+      for (vtkIdType outId = 0; outId < numOutTuples; ++outId)
+      {
+        outArray->SetTuple(outId, inIds[outId], inArray);
+      }
+    }
+  }
+}
+
+} // end anon namespace
+
+//----------------------------------------------------------------------------
+int vtkThreshold::ThresholdInParallel(vtkDataSet *input, vtkDataArray *scalars,
+                                      bool usePointScalars,
+                                      vtkUnstructuredGrid *output)
+{
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkIdType numPts = input->GetNumberOfPoints();
+
+  vtkThresholdCriterion criterion;
+  criterion.Function = vtkThresholdCriterion::BETWEEN;
+  if (this->ThresholdFunction == &vtkThreshold::Lower)
+  {
+    criterion.Function = vtkThresholdCriterion::LOWER;
+  }
+  else if (this->ThresholdFunction == &vtkThreshold::Upper)
+  {
+    criterion.Function = vtkThresholdCriterion::UPPER;
+  }
+  criterion.Lower = this->LowerThreshold;
+  criterion.Upper = this->UpperThreshold;
+  criterion.ComponentMode = this->ComponentMode;
+  criterion.NumberOfComponents = scalars->GetNumberOfComponents();
+  criterion.Component = (this->SelectedComponent < criterion.NumberOfComponents) ?
+    this->SelectedComponent : 0;
+  criterion.UsePointScalars = usePointScalars;
+  criterion.AllScalars = this->AllScalars;
+  criterion.UseContinuousCellRange = this->UseContinuousCellRange;
+
+  // Select the cells. The first calls build the internal structures of the
+  // input so that the next ones are thread safe.
+  std::vector<vtkIdType> cellSizes(numCells);
+  if (numCells > 0)
+  {
+    vtkNew<vtkIdList> cellPts;
+    input->GetCellType(0);
+    input->GetCellPoints(0, cellPts.GetPointer());
+
+    vtkThresholdSelectWorker worker;
+    worker.Input = input;
+    worker.Criterion = &criterion;
+    worker.CellSizes = &cellSizes[0];
+    if (!vtkArrayDispatch::Dispatch::Execute(scalars, worker))
+    {
+      worker(scalars); // fallback to the vtkDataArray API
+    }
+  }
+
+  // Exclusive scans of the selection and of the cell sizes: ids of the
+  // output cells and their locations in the connectivity.
+  std::vector<vtkIdType> newCellIds(numCells);
+  vtkSMPTools::Transform(cellSizes.begin(), cellSizes.end(),
+                         newCellIds.begin(), vtkThresholdIsSelected());
+  vtkIdType numNewCells = vtkSMPTools::ExclusiveScan(
+    newCellIds.begin(), newCellIds.end(), newCellIds.begin(),
+    static_cast<vtkIdType>(0));
+  std::vector<vtkIdType> cellOffsets(numCells);
+  vtkIdType connSize = vtkSMPTools::ExclusiveScan(
+    cellSizes.begin(), cellSizes.end(), cellOffsets.begin(),
+    static_cast<vtkIdType>(0));
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("vtkOriginalCellIds");
+  cellIds->SetNumberOfValues(numNewCells);
+  vtkNew<vtkIdTypeArray> locations;
+  locations->SetNumberOfValues(numNewCells);
+  if (numNewCells > 0)
+  {
+    vtkThresholdFillCells fillCells;
+    fillCells.CellSizes = &cellSizes[0];
+    fillCells.NewCellIds = &newCellIds[0];
+    fillCells.CellOffsets = &cellOffsets[0];
+    fillCells.CellIds = cellIds->GetPointer(0);
+    fillCells.Locations = locations->GetPointer(0);
+    vtkSMPTools::For(0, numCells, fillCells);
+  }
+  vtkDebugMacro(<< "Extracted " << numNewCells << " number of cells.");
+
+  if (this->SelectionOnly)
+  {
+    output->GetFieldData()->AddArray(cellIds.GetPointer());
+    return 1;
+  }
+
+  // Copy the cells with the ids of the input points, and mark these points.
+  std::vector<vtkIdType> usedPoints(numPts, 0);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(connSize);
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(numNewCells);
+  vtkThresholdCopyCells copyCells;
+  copyCells.Input = input;
+  copyCells.CellIds = cellIds->GetPointer(0);
+  copyCells.Locations = locations->GetPointer(0);
+  copyCells.Connectivity = connectivity->GetPointer(0);
+  copyCells.Types = types->GetPointer(0);
+  copyCells.NumberOfPoints = numPts;
+  vtkSMPTools::For(0, numNewCells, copyCells);
+  vtkThresholdMergeUsedPoints mergeUsedPoints;
+  for (vtkSMPThreadLocal<std::vector<unsigned char> >::iterator itr =
+         copyCells.UsedPoints.begin(); itr != copyCells.UsedPoints.end(); ++itr)
+  {
+    if (!itr->empty())
+    {
+      mergeUsedPoints.ThreadUsedPoints.push_back(&(*itr)[0]);
+    }
+  }
+  mergeUsedPoints.UsedPoints = usedPoints.empty() ? NULL : &usedPoints[0];
+  vtkSMPTools::For(0, numPts, mergeUsedPoints);
+
+  // Number the used points in the order of the input points.
+  std::vector<vtkIdType> pointMap(numPts);
+  vtkIdType numNewPts = vtkSMPTools::ExclusiveScan(
+    usedPoints.begin(), usedPoints.end(), pointMap.begin(),
+    static_cast<vtkIdType>(0));
+  vtkThresholdRenumberPoints renumber;
+  renumber.PointMap = pointMap.empty() ? NULL : &pointMap[0];
+  renumber.Locations = locations->GetPointer(0);
+  renumber.Connectivity = connectivity->GetPointer(0);
+  vtkSMPTools::For(0, numNewCells, renumber);
+
+  vtkNew<vtkPoints> newPoints;
+  // set precision for the points in the output
+  if(this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    vtkPointSet *inputPointSet = vtkPointSet::SafeDownCast(input);
+    if(inputPointSet && inputPointSet->GetPoints())
+    {
+      newPoints->SetDataType(inputPointSet->GetPoints()->GetDataType());
+    }
+    else
+    {
+      newPoints->SetDataType(VTK_FLOAT);
+    }
+  }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPoints->SetDataType(VTK_FLOAT);
+  }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPoints->SetDataType(VTK_DOUBLE);
+  }
+  newPoints->SetNumberOfPoints(numNewPts);
+
+  // Copy the points and the attribute data.
+  vtkPointData *pd = input->GetPointData(), *outPD = output->GetPointData();
+  vtkCellData *cd = input->GetCellData(), *outCD = output->GetCellData();
+  outPD->CopyGlobalIdsOn();
+  outPD->CopyAllocate(pd, numNewPts);
+  outCD->CopyGlobalIdsOn();
+  outCD->CopyAllocate(cd, numNewCells);
+
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, pd, outPD, 0.0, false);
+  vtkThresholdCopyPoints copyPoints;
+  std::vector<vtkIdType> pointIds(numNewPts);
+  copyPoints.Input = input;
+  copyPoints.UsedPoints = mergeUsedPoints.UsedPoints;
+  copyPoints.PointMap = renumber.PointMap;
+  copyPoints.Points = newPoints.GetPointer();
+  copyPoints.Arrays = &pointArrays;
+  copyPoints.PointIds = pointIds.empty() ? NULL : &pointIds[0];
+  vtkSMPTools::For(0, numPts, copyPoints);
+
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numNewCells, cd, outCD, 0.0, false);
+  vtkThresholdCopyCellData copyCellData;
+  copyCellData.CellIds = cellIds->GetPointer(0);
+  copyCellData.Arrays = &cellArrays;
+  vtkSMPTools::For(0, numNewCells, copyCellData);
+
+  vtkThresholdCopyOtherArrays(pd, outPD, numNewPts, copyPoints.PointIds);
+  vtkThresholdCopyOtherArrays(cd, outCD, numNewCells, cellIds->GetPointer(0));
+
+  output->SetPoints(newPoints.GetPointer());
+  vtkNew<vtkCellArray> cells;
+  cells->SetCells(numNewCells, connectivity.GetPointer());
+  output->SetCells(types.GetPointer(), locations.GetPointer(),
+                   cells.GetPointer());
+
+  return 1;
+}
+
 // Return the method for manipulating scalar data as a string.
 const char *vtkThreshold::GetAttributeModeAsString(void)
 {
@@ -450,4 +1042,6 @@ void vtkThreshold::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Precision of the output points: "
      << this->OutputPointsPrecision << "\n";
   os << indent << "Use Continuous Cell Range: "<<this->UseContinuousCellRange<<endl;
+  os << indent << "Parallel Thresholding: " << this->ParallelThresholding << endl;
+  os << indent << "Selection Only: " << this->SelectionOnly << endl;
 }
@@ -30,6 +30,10 @@
  * By default only the first scalar value is used in the decision. Use the ComponentMode
  * and SelectedComponent ivars to control this behavior.
  *
+ * With ParallelThresholding on, the cells are selected and copied to the output
+ * with vtkSMPTools; with SelectionOnly on, only the ids of the selected cells
+ * are produced.
+ *
  * @sa
  * vtkThresholdPoints vtkThresholdTextureCoords
 */
@@ -183,6 +187,35 @@ public:
   int GetOutputPointsPrecision() const;
   //@}
 
+  //@{
+  /**
+   * If this is on (default is off), the criterion is evaluated in parallel
+   * with kernels specialized for the type of the scalars, the output is sized
+   * with a prefix sum over the selected cells, and the connectivity, the
+   * points and the attribute data are copied in parallel. The output cells
+   * are the same as with the serial algorithm, but the output points are
+   * numbered in the order of the input points rather than in the order they
+   * are first used. Unstructured grids with polyhedra are always processed
+   * serially.
+   */
+  vtkSetMacro(ParallelThresholding,int);
+  vtkGetMacro(ParallelThresholding,int);
+  vtkBooleanMacro(ParallelThresholding,int);
+  //@}
+
+  //@{
+  /**
+   * If this is on (default is off), the output has no points and no cells:
+   * the ids of the input cells satisfying the criterion are stored (in
+   * increasing order) in a vtkIdTypeArray named "vtkOriginalCellIds" in the
+   * field data of the output, e.g. for a downstream extraction. The cells are
+   * then always selected in parallel.
+   */
+  vtkSetMacro(SelectionOnly,int);
+  vtkGetMacro(SelectionOnly,int);
+  vtkBooleanMacro(SelectionOnly,int);
+  //@}
+
 protected:
   vtkThreshold();
   ~vtkThreshold() VTK_OVERRIDE;
@@ -201,6 +234,8 @@ protected:
   int    SelectedComponent;
   int OutputPointsPrecision;
   int UseContinuousCellRange;
+  int ParallelThresholding;
+  int SelectionOnly;
 
   int (vtkThreshold::*ThresholdFunction)(double s);
 
@@ -212,6 +247,12 @@ protected:
   int EvaluateComponents( vtkDataArray *scalars, vtkIdType id );
   int EvaluateCell( vtkDataArray *scalars, vtkIdList* cellPts, int numCellPts );
   int EvaluateCell( vtkDataArray *scalars, int c, vtkIdList* cellPts, int numCellPts );
+
+  /**
+   * The parallel algorithm (see ParallelThresholding and SelectionOnly).
+   */
+  int ThresholdInParallel( vtkDataSet *input, vtkDataArray *scalars,
+                           bool usePointScalars, vtkUnstructuredGrid *output );
 private:
   vtkThreshold(const vtkThreshold&) VTK_DELETE_FUNCTION;
   void operator=(const vtkThreshold&) VTK_DELETE_FUNCTION;
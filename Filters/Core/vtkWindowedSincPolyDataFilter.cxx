@@ -24,9 +24,12 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkWindowedSincPolyDataFilter);
 
 // Construct object with number of iterations 20; passband .1;
@@ -50,6 +53,7 @@ vtkWindowedSincPolyDataFilter::vtkWindowedSincPolyDataFilter()
   this->GenerateErrorVectors = 0;
 
   this->NormalizeCoordinates = 0;
+  this->ParallelSmoothing = 0;
 }
 
 #define VTK_SIMPLE_VERTEX 0
@@ -64,6 +68,124 @@ typedef struct _vtkMeshVertex
   vtkIdList *edges; // connected edges (list of connected point ids)
 } vtkMeshVertex, *vtkMeshVertexPtr;
 
+namespace
+{
+
+// The first iteration over a range of points, as done serially below. The
+// edges of the points are in compressed row form (Offsets/Neighbors); the
+// point arrays are the float arrays of newPts[zero], newPts[one] and
+// newPts[three].
+struct vtkWindowedSincFirstIteration
+{
+  const vtkIdType *Offsets;
+  const vtkIdType *Neighbors;
+  const char *Fixed;
+  const float *X0;
+  float *X1;
+  float *X3;
+  const double *C;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3], y[3], deltaX[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType npts = this->Offsets[i + 1] - this->Offsets[i];
+      if (npts > 0)
+      {
+        for (int k = 0; k < 3; ++k)
+        {
+          x[k] = this->X0[3 * i + k];
+          deltaX[k] = 0.0;
+        }
+        for (vtkIdType j = this->Offsets[i]; j < this->Offsets[i + 1]; ++j)
+        {
+          for (int k = 0; k < 3; ++k)
+          {
+            y[k] = this->X0[3 * this->Neighbors[j] + k];
+            deltaX[k] += (x[k] - y[k]) / npts;
+          }
+        }
+        for (int k = 0; k < 3; ++k)
+        {
+          deltaX[k] = x[k] - 0.5*deltaX[k];
+          this->X1[3 * i + k] = static_cast<float>(deltaX[k]);
+          deltaX[k] = this->C[0]*x[k] + this->C[1]*deltaX[k];
+          this->X3[3 * i + k] = this->Fixed[i] ? this->X0[3 * i + k] :
+            static_cast<float>(deltaX[k]);
+        }
+      }
+      else
+      {
+        for (int k = 0; k < 3; ++k)
+        {
+          this->X1[3 * i + k] = 0.0f;
+          this->X3[3 * i + k] = this->X0[3 * i + k];
+        }
+      }
+    }
+  }
+};
+
+// The following iterations over a range of points. The points that cannot
+// move keep a null Laplacian in X1 from the previous iterations.
+struct vtkWindowedSincIteration
+{
+  const vtkIdType *Offsets;
+  const vtkIdType *Neighbors;
+  const char *Fixed;
+  const float *X0;
+  const float *X1;
+  float *X2;
+  float *X3;
+  double C;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double p_x0[3], p_x1[3], y[3], deltaX[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType npts = this->Offsets[i + 1] - this->Offsets[i];
+      if (npts > 0)
+      {
+        for (int k = 0; k < 3; ++k)
+        {
+          p_x0[k] = this->X0[3 * i + k];
+          p_x1[k] = this->X1[3 * i + k];
+          deltaX[k] = 0.0;
+        }
+        for (vtkIdType j = this->Offsets[i]; j < this->Offsets[i + 1]; ++j)
+        {
+          for (int k = 0; k < 3; ++k)
+          {
+            y[k] = this->X1[3 * this->Neighbors[j] + k];
+            deltaX[k] += (p_x1[k] - y[k]) / npts;
+          }
+        }
+        for (int k = 0; k < 3; ++k)
+        {
+          deltaX[k] = p_x1[k] - p_x0[k] + p_x1[k] - deltaX[k];
+          this->X2[3 * i + k] = static_cast<float>(deltaX[k]);
+          if (!this->Fixed[i])
+          {
+            double p_x3 = this->X3[3 * i + k];
+            this->X3[3 * i + k] = static_cast<float>(p_x3 + this->C * deltaX[k]);
+          }
+        }
+      }
+      else
+      {
+        for (int k = 0; k < 3; ++k)
+        {
+          this->X2[3 * i + k] = 0.0f;
+        }
+      }
+    }
+  }
+};
+
+} // anonymous namespace
+
 int vtkWindowedSincPolyDataFilter::RequestData(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **inputVector,
@@ -578,54 +700,90 @@ int vtkWindowedSincPolyDataFilter::RequestData(
     vtkErrorMacro(<< "An optimal offset for the smoothing filter could not be found.  Unpredictable smoothing/shrinkage may result.");
   }
 
-  // first iteration
-  for (i=0; i<numPts; i++)
+  // gather the edges of the points in compressed row form
+  std::vector<vtkIdType> offsets;
+  std::vector<vtkIdType> neighbors;
+  std::vector<char> fixed;
+  if ( this->ParallelSmoothing )
   {
-    if ( Verts[i].edges != NULL &&
-         (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
+    offsets.resize(numPts+1, 0);
+    fixed.resize(numPts);
+    for (i=0; i<numPts; i++)
     {
-      // point is allowed to move
-      newPts[zero]->GetPoint(i, x); //use current points
-      deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+      if ( Verts[i].edges != NULL )
+      {
+        vtkIdType *edgeIds = Verts[i].edges->GetPointer(0);
+        neighbors.insert(neighbors.end(), edgeIds,
+                         edgeIds + Verts[i].edges->GetNumberOfIds());
+      }
+      offsets[i+1] = static_cast<vtkIdType>(neighbors.size());
+      fixed[i] = (Verts[i].type == VTK_FIXED_VERTEX);
+    }
+  }
 
-      // calculate the negative of the laplacian
-      for (j=0; j<npts; j++) //for all connected points
+  // first iteration
+  if ( this->ParallelSmoothing )
+  {
+    vtkWindowedSincFirstIteration iteration;
+    iteration.Offsets = &offsets[0];
+    iteration.Neighbors = neighbors.empty() ? NULL : &neighbors[0];
+    iteration.Fixed = &fixed[0];
+    iteration.X0 = static_cast<float*>(newPts[zero]->GetVoidPointer(0));
+    iteration.X1 = static_cast<float*>(newPts[one]->GetVoidPointer(0));
+    iteration.X3 = static_cast<float*>(newPts[three]->GetVoidPointer(0));
+    iteration.C = c;
+    vtkSMPTools::For(0, numPts, iteration);
+  }
+  else
+  {
+    for (i=0; i<numPts; i++)
+    {
+      if ( Verts[i].edges != NULL &&
+           (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
       {
-        newPts[zero]->GetPoint(Verts[i].edges->GetId(j), y);
+        // point is allowed to move
+        newPts[zero]->GetPoint(i, x); //use current points
+        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+
+        // calculate the negative of the laplacian
+        for (j=0; j<npts; j++) //for all connected points
+        {
+          newPts[zero]->GetPoint(Verts[i].edges->GetId(j), y);
+          for (k=0; k<3; k++)
+          {
+            deltaX[k] += (x[k] - y[k]) / npts;
+          }
+        }
+        // newPts[one] = newPts[zero] - 0.5 newPts[one]
         for (k=0; k<3; k++)
         {
-          deltaX[k] += (x[k] - y[k]) / npts;
+          deltaX[k] = x[k] - 0.5*deltaX[k];
         }
-      }
-      // newPts[one] = newPts[zero] - 0.5 newPts[one]
-      for (k=0; k<3; k++)
-      {
-        deltaX[k] = x[k] - 0.5*deltaX[k];
-      }
-      newPts[one]->SetPoint(i, deltaX);
+        newPts[one]->SetPoint(i, deltaX);
 
-      // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
-      for (k=0; k < 3; k++)
-      {
-        deltaX[k] = c[0]*x[k] + c[1]*deltaX[k];
-      }
-      if (Verts[i].type == VTK_FIXED_VERTEX)
-      {
-        newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-      }
+        // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
+        for (k=0; k < 3; k++)
+        {
+          deltaX[k] = c[0]*x[k] + c[1]*deltaX[k];
+        }
+        if (Verts[i].type == VTK_FIXED_VERTEX)
+        {
+          newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
+        }
+        else
+        {
+          newPts[three]->SetPoint(i, deltaX);
+        }
+      }//if can move point
       else
       {
-        newPts[three]->SetPoint(i, deltaX);
+        // point is not allowed to move, just use the old point...
+        // (zero out the Laplacian)
+        newPts[one]->SetPoint(i, zerovector);
+        newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
       }
-    }//if can move point
-    else
-    {
-      // point is not allowed to move, just use the old point...
-      // (zero out the Laplacian)
-      newPts[one]->SetPoint(i, zerovector);
-      newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-    }
-  }//for all points
+    }//for all points
+  }
 
   // for the rest of the iterations
   for ( iterationNumber=2;
@@ -641,53 +799,69 @@ int vtkWindowedSincPolyDataFilter::RequestData(
       }
     }
 
-    for (i=0; i<numPts; i++)
+    if ( this->ParallelSmoothing )
     {
-      if ( Verts[i].edges != NULL &&
-           (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
+      vtkWindowedSincIteration iteration;
+      iteration.Offsets = &offsets[0];
+      iteration.Neighbors = neighbors.empty() ? NULL : &neighbors[0];
+      iteration.Fixed = &fixed[0];
+      iteration.X0 = static_cast<float*>(newPts[zero]->GetVoidPointer(0));
+      iteration.X1 = static_cast<float*>(newPts[one]->GetVoidPointer(0));
+      iteration.X2 = static_cast<float*>(newPts[two]->GetVoidPointer(0));
+      iteration.X3 = static_cast<float*>(newPts[three]->GetVoidPointer(0));
+      iteration.C = c[iterationNumber];
+      vtkSMPTools::For(0, numPts, iteration);
+    }
+    else
+    {
+      for (i=0; i<numPts; i++)
       {
-        // point is allowed to move
-        newPts[zero]->GetPoint(i, p_x0); //use current points
-        newPts[one]->GetPoint(i, p_x1);
+        if ( Verts[i].edges != NULL &&
+             (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
+        {
+          // point is allowed to move
+          newPts[zero]->GetPoint(i, p_x0); //use current points
+          newPts[one]->GetPoint(i, p_x1);
 
-        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+          deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
 
-        // calculate the negative laplacian of x1
-        for (j=0; j<npts; j++)
-        {
-          newPts[one]->GetPoint(Verts[i].edges->GetId(j), y);
+          // calculate the negative laplacian of x1
+          for (j=0; j<npts; j++)
+          {
+            newPts[one]->GetPoint(Verts[i].edges->GetId(j), y);
+            for (k=0; k<3; k++)
+            {
+              deltaX[k] += (p_x1[k] - y[k]) / npts;
+            }
+          }//for all connected points
+
+          // Taubin:  x2 = (x1 - x0) + (x1 - x2)
           for (k=0; k<3; k++)
           {
-            deltaX[k] += (p_x1[k] - y[k]) / npts;
+            deltaX[k] = p_x1[k] - p_x0[k] + p_x1[k] - deltaX[k];
           }
-        }//for all connected points
-
-        // Taubin:  x2 = (x1 - x0) + (x1 - x2)
-        for (k=0; k<3; k++)
-        {
-          deltaX[k] = p_x1[k] - p_x0[k] + p_x1[k] - deltaX[k];
-        }
-        newPts[two]->SetPoint(i, deltaX);
+          newPts[two]->SetPoint(i, deltaX);
 
-        // smooth the vertex (x3 = x3 + cj x2)
-        newPts[three]->GetPoint(i, p_x3);
-        for (k=0;k<3;k++)
-        {
-          xNew[k] = p_x3[k] + c[iterationNumber] * deltaX[k];
-        }
-        if (Verts[i].type != VTK_FIXED_VERTEX)
+          // smooth the vertex (x3 = x3 + cj x2)
+          newPts[three]->GetPoint(i, p_x3);
+          for (k=0;k<3;k++)
+          {
+            xNew[k] = p_x3[k] + c[iterationNumber] * deltaX[k];
+          }
+          if (Verts[i].type != VTK_FIXED_VERTEX)
+          {
+            newPts[three]->SetPoint(i,xNew);
+          }
+        }//if can move point
+        else
         {
-          newPts[three]->SetPoint(i,xNew);
+          // point is not allowed to move, just use the old point...
+          // (zero out the Laplacian)
+          newPts[one]->SetPoint(i, zerovector);
+          newPts[two]->SetPoint(i, zerovector);
         }
-      }//if can move point
-      else
-      {
-        // point is not allowed to move, just use the old point...
-        // (zero out the Laplacian)
-        newPts[one]->SetPoint(i, zerovector);
-        newPts[two]->SetPoint(i, zerovector);
-      }
-    }//for all points
+      }//for all points
+    }
 
     // update the pointers. three is always three. all other pointers
     // shift by one and wrap.
@@ -806,4 +980,5 @@ void vtkWindowedSincPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Nonmanifold Smoothing: " << (this->NonManifoldSmoothing ? "On\n" : "Off\n");
   os << indent << "Generate Error Scalars: " << (this->GenerateErrorScalars ? "On\n" : "Off\n");
   os << indent << "Generate Error Vectors: " << (this->GenerateErrorVectors ? "On\n" : "Off\n");
+  os << indent << "Parallel Smoothing: " << (this->ParallelSmoothing ? "On\n" : "Off\n");
 }
@@ -251,6 +251,17 @@ public:
   vtkBooleanMacro(GenerateErrorVectors,int);
   //@}
 
+  //@{
+  /**
+   * Turn on/off the smoothing iterations in parallel (vtkSMPTools). Every
+   * iteration only reads the positions of the previous ones, so the results
+   * are the same as the serial ones. Off by default.
+   */
+  vtkSetMacro(ParallelSmoothing,int);
+  vtkGetMacro(ParallelSmoothing,int);
+  vtkBooleanMacro(ParallelSmoothing,int);
+  //@}
+
  protected:
   vtkWindowedSincPolyDataFilter();
   ~vtkWindowedSincPolyDataFilter() VTK_OVERRIDE {}
@@ -267,6 +278,7 @@ public:
   int GenerateErrorScalars;
   int GenerateErrorVectors;
   int NormalizeCoordinates;
+  int ParallelSmoothing;
 private:
   vtkWindowedSincPolyDataFilter(const vtkWindowedSincPolyDataFilter&) VTK_DELETE_FUNCTION;
   void operator=(const vtkWindowedSincPolyDataFilter&) VTK_DELETE_FUNCTION;
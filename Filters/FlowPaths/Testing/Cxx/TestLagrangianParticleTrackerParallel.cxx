@@ -0,0 +1,273 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLagrangianParticleTrackerParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded integration of vtkLagrangianParticleTracker
+// produces the same output as the serial integration, including the
+// particles created by breaking surfaces.
+
+#include "vtkCellData.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkImageDataToPointSet.h"
+#include "vtkIntArray.h"
+#include "vtkLagrangianMatidaIntegrationModel.h"
+#include "vtkLagrangianParticleTracker.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkRungeKutta4.h"
+#include "vtkSmartPointer.h"
+#include "vtkSMPTools.h"
+#include "vtkStructuredGrid.h"
+
+#include "TestDataComparison.h"
+
+#include <cmath>
+
+namespace
+{
+
+// A wavelet image with a cell flow blowing along x.
+vtkSmartPointer<vtkImageData> MakeFlow()
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-8, 8, -8, 8, -8, 8);
+  wavelet->Update();
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->DeepCopy(wavelet->GetOutput());
+
+  vtkNew<vtkDoubleArray> flowVel;
+  flowVel->SetName("FlowVelocity");
+  flowVel->SetNumberOfComponents(3);
+  vtkNew<vtkDoubleArray> flowDens;
+  flowDens->SetName("FlowDensity");
+  vtkNew<vtkDoubleArray> flowDynVisc;
+  flowDynVisc->SetName("FlowDynamicViscosity");
+  for (vtkIdType i = 0; i < image->GetNumberOfCells(); ++i)
+  {
+    int subId;
+    double pcoords[3], center[3], weights[8];
+    vtkCell* cell = image->GetCell(i);
+    cell->GetParametricCenter(pcoords);
+    cell->EvaluateLocation(subId, pcoords, center, weights);
+    flowVel->InsertNextTuple3(1.5, 0.2 * center[0], -2.0);
+    flowDens->InsertNextValue(1000.0);
+    flowDynVisc->InsertNextValue(0.894);
+  }
+  image->GetCellData()->AddArray(flowVel.Get());
+  image->GetCellData()->AddArray(flowDens.Get());
+  image->GetCellData()->AddArray(flowDynVisc.Get());
+  return image;
+}
+
+// Seeds with various initial velocities and a tag, which is seed data that
+// ends up in the outputs.
+void MakeSeeds(vtkPolyData* seeds)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> partVel;
+  partVel->SetName("InitialVelocity");
+  partVel->SetNumberOfComponents(3);
+  vtkNew<vtkDoubleArray> partDens;
+  partDens->SetName("ParticleDensity");
+  vtkNew<vtkDoubleArray> partDiam;
+  partDiam->SetName("ParticleDiameter");
+  vtkNew<vtkIntArray> tag;
+  tag->SetName("Tag");
+  for (int j = 0; j < 6; ++j)
+  {
+    for (int i = 0; i < 6; ++i)
+    {
+      int n = i + 6 * j;
+      points->InsertNextPoint(-7.0 + i, -5.0 + 2.0 * j, 4.0 + 0.1 * i);
+      partVel->InsertNextTuple3(sin(1.3 * n), cos(0.7 * n), -1.0);
+      partDens->InsertNextValue(1500.0 + 20.0 * n);
+      partDiam->InsertNextValue(0.05 + 0.002 * n);
+      tag->InsertNextValue(100 + n);
+    }
+  }
+  seeds->SetPoints(points.Get());
+  seeds->GetPointData()->AddArray(partVel.Get());
+  seeds->GetPointData()->AddArray(partDens.Get());
+  seeds->GetPointData()->AddArray(partDiam.Get());
+  seeds->GetPointData()->AddArray(tag.Get());
+}
+
+vtkSmartPointer<vtkPolyData> MakePlane(double x0, double y0, double x1,
+                                       double y1, double z, int surfaceType)
+{
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetOrigin(x0, y0, z);
+  plane->SetPoint1(x1, y0, z);
+  plane->SetPoint2(x0, y1, z);
+  plane->SetResolution(4, 4);
+  plane->Update();
+  vtkSmartPointer<vtkPolyData> pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->DeepCopy(plane->GetOutput());
+
+  vtkNew<vtkDoubleArray> types;
+  types->SetName("SurfaceType");
+  types->SetNumberOfTuples(pd->GetNumberOfCells());
+  types->FillComponent(0, surfaceType);
+  pd->GetCellData()->AddArray(types.Get());
+  return pd;
+}
+
+int Compare(vtkDataObject* flow, vtkPolyData* seeds, vtkDataObject* surfaces,
+            int cellLengthMode, bool adaptiveStep, int maxSteps,
+            const char* name)
+{
+  vtkNew<vtkLagrangianParticleTracker> serial;
+  vtkNew<vtkLagrangianParticleTracker> parallel;
+  vtkLagrangianParticleTracker* trackers[2] = { serial.Get(), parallel.Get() };
+  for (int t = 0; t < 2; ++t)
+  {
+    vtkNew<vtkLagrangianMatidaIntegrationModel> model;
+    model->SetInputArrayToProcess(0, 1, 0,
+      vtkDataObject::FIELD_ASSOCIATION_POINTS, "InitialVelocity");
+    model->SetInputArrayToProcess(2, 0, 0,
+      vtkDataObject::FIELD_ASSOCIATION_CELLS, "SurfaceType");
+    model->SetInputArrayToProcess(3, 0, 0,
+      vtkDataObject::FIELD_ASSOCIATION_CELLS, "FlowVelocity");
+    model->SetInputArrayToProcess(4, 0, 0,
+      vtkDataObject::FIELD_ASSOCIATION_CELLS, "FlowDensity");
+    model->SetInputArrayToProcess(5, 0, 0,
+      vtkDataObject::FIELD_ASSOCIATION_CELLS, "FlowDynamicViscosity");
+    model->SetInputArrayToProcess(6, 1, 0,
+      vtkDataObject::FIELD_ASSOCIATION_POINTS, "ParticleDiameter");
+    model->SetInputArrayToProcess(7, 1, 0,
+      vtkDataObject::FIELD_ASSOCIATION_POINTS, "ParticleDensity");
+    vtkNew<vtkRungeKutta4> integrator;
+
+    trackers[t]->SetIntegrationModel(model.Get());
+    trackers[t]->SetIntegrator(integrator.Get());
+    trackers[t]->SetInputData(flow);
+    trackers[t]->SetSourceData(seeds);
+    trackers[t]->SetSurfaceData(surfaces);
+    trackers[t]->SetStepFactor(0.3);
+    trackers[t]->SetStepFactorMin(0.1);
+    trackers[t]->SetStepFactorMax(0.5);
+    trackers[t]->SetMaximumNumberOfSteps(maxSteps);
+    trackers[t]->SetCellLengthComputationMode(cellLengthMode);
+    trackers[t]->SetAdaptiveStepReintegration(adaptiveStep);
+    trackers[t]->SetParallelIntegration(t == 1);
+    trackers[t]->Update();
+  }
+
+  vtkPolyData* expected = vtkPolyData::SafeDownCast(serial->GetOutput(0));
+  vtkPolyData* output = vtkPolyData::SafeDownCast(parallel->GetOutput(0));
+  if (expected->GetNumberOfLines() <= seeds->GetNumberOfPoints())
+  {
+    cerr << "No particle created by breaking for " << name << endl;
+    return EXIT_FAILURE;
+  }
+  if (!vtkTest::SamePolyData(expected, output, "particle paths"))
+  {
+    cerr << "with " << name << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkMultiBlockDataSet* expectedInteractions =
+    vtkMultiBlockDataSet::SafeDownCast(serial->GetOutput(1));
+  vtkMultiBlockDataSet* interactions =
+    vtkMultiBlockDataSet::SafeDownCast(parallel->GetOutput(1));
+  if (!expectedInteractions || !interactions ||
+      expectedInteractions->GetNumberOfBlocks() !=
+      interactions->GetNumberOfBlocks())
+  {
+    cerr << "Wrong interaction output for " << name << endl;
+    return EXIT_FAILURE;
+  }
+  for (unsigned int b = 0; b < expectedInteractions->GetNumberOfBlocks(); ++b)
+  {
+    vtkPolyData* block0 =
+      vtkPolyData::SafeDownCast(expectedInteractions->GetBlock(b));
+    vtkPolyData* block1 = vtkPolyData::SafeDownCast(interactions->GetBlock(b));
+    if (!block0 || !block1 ||
+        !vtkTest::SamePolyData(block0, block1, "interactions"))
+    {
+      cerr << "in block " << b << " with " << name << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int TestLagrangianParticleTrackerParallel(int, char*[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkLagrangianMatidaIntegrationModel> model;
+  if (!model->GetThreadSafe())
+  {
+    cerr << "The Matida model should be thread safe." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkPolyData> seeds;
+  MakeSeeds(seeds.Get());
+
+  vtkSmartPointer<vtkImageData> image = MakeFlow();
+
+  // Structured grid, located with cell locators
+  vtkNew<vtkImageDataToPointSet> toGrid;
+  toGrid->SetInputData(image);
+  toGrid->Update();
+  vtkStructuredGrid* grid = toGrid->GetOutput();
+
+  // The domain boundary terminates the particles, which go through the
+  // pass plane, then bounce or break on the lower planes.
+  vtkNew<vtkDataSetSurfaceFilter> boundary;
+  boundary->SetInputData(image);
+  boundary->Update();
+  vtkSmartPointer<vtkPolyData> term = vtkSmartPointer<vtkPolyData>::New();
+  term->DeepCopy(boundary->GetOutput());
+  vtkNew<vtkDoubleArray> termTypes;
+  termTypes->SetName("SurfaceType");
+  termTypes->SetNumberOfTuples(term->GetNumberOfCells());
+  termTypes->FillComponent(0,
+    vtkLagrangianBasicIntegrationModel::SURFACE_TYPE_TERM);
+  term->GetCellData()->AddArray(termTypes.Get());
+
+  vtkNew<vtkMultiBlockDataSet> surfaces;
+  surfaces->SetNumberOfBlocks(4);
+  surfaces->SetBlock(0, term);
+  surfaces->SetBlock(1, MakePlane(-7.0, -7.0, 7.0, 7.0, 1.0,
+    vtkLagrangianBasicIntegrationModel::SURFACE_TYPE_PASS));
+  surfaces->SetBlock(2, MakePlane(-4.0, -7.0, -2.5, 7.0, -2.0,
+    vtkLagrangianBasicIntegrationModel::SURFACE_TYPE_BREAK));
+  surfaces->SetBlock(3, MakePlane(-2.5, -7.0, 7.0, 7.0, -2.0,
+    vtkLagrangianBasicIntegrationModel::SURFACE_TYPE_BOUNCE));
+
+  // The particles created by breaking start on the surface and break again
+  // at their next step, so the number of steps is kept low.
+  int status = EXIT_SUCCESS;
+  status |= Compare(image, seeds.Get(), surfaces.Get(),
+    vtkLagrangianParticleTracker::STEP_LAST_CELL_LENGTH, false, 18, "image");
+  status |= Compare(image, seeds.Get(), surfaces.Get(),
+    vtkLagrangianParticleTracker::STEP_CUR_CELL_VEL_DIR, true, 30,
+    "image and adaptive step");
+  status |= Compare(grid, seeds.Get(), surfaces.Get(),
+    vtkLagrangianParticleTracker::STEP_CUR_CELL_LENGTH, false, 18,
+    "structured grid");
+
+  return status;
+}
@@ -0,0 +1,273 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStreamTracerParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the seed-parallel integration of vtkStreamTracer produces the
+// same output as the serial integration, and keeps the streamlines traced
+// before an abort.
+
+#include "vtkCellData.h"
+#include "vtkCommand.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkImageGradient.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointDataToCellData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkRungeKutta4.h"
+#include "vtkRungeKutta45.h"
+#include "vtkSmartPointer.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamTracer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <map>
+
+#include "TestDataComparison.h"
+
+namespace
+{
+
+vtkSmartPointer<vtkImageData> MakeImage(int xMin, int xMax)
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(xMin, xMax, -6, 6, -6, 6);
+
+  vtkNew<vtkImageGradient> gradient;
+  gradient->SetDimensionality(3);
+  gradient->SetInputConnection(source->GetOutputPort());
+  gradient->Update();
+
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->DeepCopy(gradient->GetOutput());
+  image->GetPointData()->SetActiveVectors("RTDataGradient");
+  return image;
+}
+
+// A grid of seeds, some of them outside of the domain.
+void MakeSeeds(vtkPolyData *seeds)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < 4; ++k)
+  {
+    for (int j = 0; j < 8; ++j)
+    {
+      for (int i = 0; i < 8; ++i)
+      {
+        points->InsertNextPoint(-8.3 + 2.3 * i, -7.1 + 1.9 * j, -4.7 + 3.1 * k);
+      }
+    }
+  }
+  seeds->SetPoints(points.Get());
+}
+
+int Compare(vtkDataObject *input, int association, vtkPolyData *seeds,
+            int integrator, int interpolator, bool vorticity, const char *name)
+{
+  vtkNew<vtkStreamTracer> serial;
+  vtkNew<vtkStreamTracer> parallel;
+  vtkStreamTracer *tracers[2] = { serial.Get(), parallel.Get() };
+  for (int t = 0; t < 2; ++t)
+  {
+    tracers[t]->SetInputData(input);
+    tracers[t]->SetSourceData(seeds);
+    tracers[t]->SetInputArrayToProcess(0, 0, 0, association, "RTDataGradient");
+    tracers[t]->SetIntegrationDirectionToBoth();
+    tracers[t]->SetMaximumPropagation(30.0);
+    tracers[t]->SetInitialIntegrationStep(0.3);
+    tracers[t]->SetMaximumNumberOfSteps(150);
+    if (integrator == 1)
+    {
+      vtkNew<vtkRungeKutta4> rk4;
+      tracers[t]->SetIntegrator(rk4.Get());
+    }
+    else if (integrator == 2)
+    {
+      vtkNew<vtkRungeKutta45> rk45;
+      tracers[t]->SetIntegrator(rk45.Get());
+    }
+    tracers[t]->SetInterpolatorType(interpolator);
+    tracers[t]->SetComputeVorticity(vorticity);
+    tracers[t]->SetParallelIntegration(t == 1);
+    tracers[t]->Update();
+  }
+
+  vtkPolyData *expected = serial->GetOutput();
+  vtkPolyData *output = parallel->GetOutput();
+  if (expected->GetNumberOfLines() < 10)
+  {
+    cerr << "Too few streamlines for " << name << endl;
+    return EXIT_FAILURE;
+  }
+  if (!vtkTest::SamePolyData(expected, output, name))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+// Abort the execution of an algorithm once it reports some progress.
+class AbortObserver : public vtkCommand
+{
+public:
+  static AbortObserver *New()
+  {
+    return new AbortObserver;
+  }
+
+  void Execute(vtkObject *caller, unsigned long, void *callData) VTK_OVERRIDE
+  {
+    double progress = *static_cast<double*>(callData);
+    if (progress > 0.1 && progress < 1.0)
+    {
+      vtkAlgorithm::SafeDownCast(caller)->SetAbortExecute(1);
+    }
+  }
+};
+
+// The lines traced before an abort are kept, and are the same as without
+// the abort.
+int CheckAbort(vtkImageData *image, vtkPolyData *seeds)
+{
+  vtkNew<vtkStreamTracer> complete;
+  vtkNew<vtkStreamTracer> aborted;
+  vtkStreamTracer *tracers[2] = { complete.Get(), aborted.Get() };
+  vtkNew<AbortObserver> observer;
+  for (int t = 0; t < 2; ++t)
+  {
+    tracers[t]->SetInputData(image);
+    tracers[t]->SetSourceData(seeds);
+    tracers[t]->SetIntegrationDirectionToBoth();
+    tracers[t]->SetMaximumPropagation(30.0);
+    tracers[t]->SetInitialIntegrationStep(0.3);
+    tracers[t]->SetMaximumNumberOfSteps(150);
+    tracers[t]->ParallelIntegrationOn();
+    if (t == 1)
+    {
+      tracers[t]->AddObserver(vtkCommand::ProgressEvent, observer.Get());
+    }
+    tracers[t]->Update();
+  }
+
+  vtkPolyData *expected = complete->GetOutput();
+  vtkPolyData *output = aborted->GetOutput();
+  if (output->GetNumberOfLines() == 0 ||
+      output->GetNumberOfLines() >= expected->GetNumberOfLines())
+  {
+    cerr << "The aborted integration has " << output->GetNumberOfLines()
+         << " streamlines out of " << expected->GetNumberOfLines() << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Both streamlines of a seed have its id.
+  std::multimap<double, vtkIdType> expectedLines;
+  vtkDataArray *expectedSeeds = expected->GetCellData()->GetArray("SeedIds");
+  vtkDataArray *seedIds = output->GetCellData()->GetArray("SeedIds");
+  for (vtkIdType i = 0; i < expected->GetNumberOfCells(); ++i)
+  {
+    expectedLines.insert(std::make_pair(expectedSeeds->GetTuple1(i), i));
+  }
+  vtkNew<vtkIdList> expectedPts, pts;
+  for (vtkIdType i = 0; i < output->GetNumberOfCells(); ++i)
+  {
+    output->GetCellPoints(i, pts.Get());
+    bool same = false;
+    typedef std::multimap<double, vtkIdType>::iterator Iterator;
+    std::pair<Iterator, Iterator> range =
+      expectedLines.equal_range(seedIds->GetTuple1(i));
+    for (Iterator itr = range.first; !same && itr != range.second; ++itr)
+    {
+      expected->GetCellPoints(itr->second, expectedPts.Get());
+      same = (pts->GetNumberOfIds() == expectedPts->GetNumberOfIds());
+      for (vtkIdType j = 0; same && j < pts->GetNumberOfIds(); ++j)
+      {
+        double x[3], expectedX[3];
+        output->GetPoint(pts->GetId(j), x);
+        expected->GetPoint(expectedPts->GetId(j), expectedX);
+        same = (x[0] == expectedX[0] && x[1] == expectedX[1] &&
+                x[2] == expectedX[2]);
+      }
+    }
+    if (!same)
+    {
+      cerr << "The streamline of seed " << seedIds->GetTuple1(i)
+           << " differs after the abort." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int TestStreamTracerParallel(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkPolyData> seeds;
+  MakeSeeds(seeds.Get());
+
+  vtkSmartPointer<vtkImageData> image = MakeImage(-6, 6);
+
+  // Tetrahedra, located through the point locator of vtkPointSet
+  vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+  tetrahedralize->SetInputData(image);
+  tetrahedralize->Update();
+  vtkUnstructuredGrid *grid = tetrahedralize->GetOutput();
+
+  // Cell vectors
+  vtkNew<vtkPointDataToCellData> toCells;
+  toCells->SetInputData(image);
+  toCells->PassPointDataOn();
+  toCells->Update();
+  vtkImageData *cellImage = vtkImageData::SafeDownCast(toCells->GetOutput());
+
+  // Two blocks with touching extents, so that streamlines go from one to
+  // the other
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  blocks->SetNumberOfBlocks(2);
+  blocks->SetBlock(0, MakeImage(-6, 0));
+  blocks->SetBlock(1, MakeImage(0, 6));
+
+  const int points = vtkDataObject::FIELD_ASSOCIATION_POINTS;
+  const int cells = vtkDataObject::FIELD_ASSOCIATION_CELLS;
+  int status = EXIT_SUCCESS;
+  for (int integrator = 0; integrator < 3; ++integrator)
+  {
+    bool vorticity = (integrator != 1);
+    status |= Compare(image, points, seeds.Get(), integrator,
+      vtkStreamTracer::INTERPOLATOR_WITH_DATASET_POINT_LOCATOR, vorticity,
+      "image");
+    status |= Compare(grid, points, seeds.Get(), integrator,
+      vtkStreamTracer::INTERPOLATOR_WITH_DATASET_POINT_LOCATOR, vorticity,
+      "unstructured grid");
+    status |= Compare(grid, points, seeds.Get(), integrator,
+      vtkStreamTracer::INTERPOLATOR_WITH_CELL_LOCATOR, vorticity,
+      "unstructured grid with cell locator");
+    status |= Compare(cellImage, cells, seeds.Get(), integrator,
+      vtkStreamTracer::INTERPOLATOR_WITH_DATASET_POINT_LOCATOR, vorticity,
+      "cell vectors");
+    status |= Compare(blocks.Get(), points, seeds.Get(), integrator,
+      vtkStreamTracer::INTERPOLATOR_WITH_DATASET_POINT_LOCATOR, vorticity,
+      "multiblock");
+  }
+
+  status |= CheckAbort(image, seeds.Get());
+
+  return status;
+}
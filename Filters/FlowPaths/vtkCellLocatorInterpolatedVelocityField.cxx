@@ -264,6 +264,48 @@ void vtkCellLocatorInterpolatedVelocityField::AddDataSet( vtkDataSet * dataset )
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkCellLocatorInterpolatedVelocityField::AddDataSets
+  ( vtkCellLocatorInterpolatedVelocityField * from )
+{
+  if ( !from )
+  {
+    vtkErrorMacro( <<"Velocity field NULL!" );
+    return;
+  }
+
+  // the datasets are not registered, as in AddDataSet(), but the locators
+  // are reference counted and thus shared
+  this->DataSets->insert( this->DataSets->end(),
+                          from->DataSets->begin(), from->DataSets->end() );
+  this->CellLocators->insert( this->CellLocators->end(),
+                              from->CellLocators->begin(),
+                              from->CellLocators->end() );
+
+  if ( from->WeightsSize > this->WeightsSize )
+  {
+    this->WeightsSize = from->WeightsSize;
+    delete[] this->Weights;
+    this->Weights = new double[ this->WeightsSize ];
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellLocatorInterpolatedVelocityField::BuildCellLocators()
+{
+  for ( size_t i = 0; i < this->CellLocators->size(); i ++ )
+  {
+    vtkAbstractCellLocator * locator = ( *this->CellLocators )[i].GetPointer();
+    if ( locator )
+    {
+      // a lazily evaluated locator would check whether to build itself at
+      // each search, so the evaluation is turned off before building
+      locator->LazyEvaluationOff();
+      locator->BuildLocator();
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkCellLocatorInterpolatedVelocityField::CopyParameters
   ( vtkAbstractInterpolatedVelocityField * from )
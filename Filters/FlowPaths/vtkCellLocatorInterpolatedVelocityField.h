@@ -102,6 +102,20 @@ public:
    */
   void AddDataSet( vtkDataSet * dataset ) VTK_OVERRIDE;
 
+  /**
+   * Add the datasets of another instance together with its cell locators,
+   * which are then shared instead of being built again by this instance.
+   */
+  void AddDataSets( vtkCellLocatorInterpolatedVelocityField * from );
+
+  /**
+   * Build the cell locators of the datasets now rather than at the first
+   * cell search. Once built, the locators are only read by FindCell(), so
+   * instances sharing them through AddDataSets() can be evaluated by
+   * concurrent threads, as long as the datasets are not modified.
+   */
+  void BuildCellLocators();
+
   /**
    * Evaluate the velocity field f at point (x, y, z).
    */
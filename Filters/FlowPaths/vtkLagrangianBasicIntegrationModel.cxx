@@ -511,6 +511,7 @@ vtkLagrangianBasicIntegrationModel::vtkLagrangianBasicIntegrationModel():
   Tolerance(1.0e-8),
   NonPlanarQuadSupport(false),
   UseInitialIntegrationTime(false),
+  ThreadSafe(false),
   Tracker(NULL)
 {
   SurfaceArrayDescription surfaceTypeDescription;
@@ -586,6 +587,7 @@ void vtkLagrangianBasicIntegrationModel::PrintSelf(ostream& os, vtkIndent indent
     os << indent << "CurrentParticle: " << this->CurrentParticle << endl;
   }
   os << indent << "Tolerance: " << this->Tolerance << endl;
+  os << indent << "ThreadSafe: " << this->ThreadSafe << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -595,6 +597,36 @@ void vtkLagrangianBasicIntegrationModel::SetTracker(
   this->Tracker = tracker;
 }
 
+//----------------------------------------------------------------------------
+void vtkLagrangianBasicIntegrationModel::CopyParameters(
+  vtkLagrangianBasicIntegrationModel* from)
+{
+  this->SetLocator(from->Locator);
+  this->SetTracker(from->Tracker);
+  this->InputArrays = from->InputArrays;
+  this->Tolerance = from->Tolerance;
+  this->NonPlanarQuadSupport = from->NonPlanarQuadSupport;
+  this->UseInitialIntegrationTime = from->UseInitialIntegrationTime;
+  this->NumFuncs = from->NumFuncs;
+  this->NumIndepVars = from->NumIndepVars;
+
+  // Share the flow datasets and locators, only used to find cells
+  this->ClearDataSets();
+  *this->DataSets = *from->DataSets;
+  *this->Locators = *from->Locators;
+  this->WeightsSize = from->WeightsSize;
+  this->LastWeights = new double[this->WeightsSize];
+
+  // Surface locators are used with FindCellsAlongLine, which is not thread
+  // safe, so each copy builds its own
+  this->ClearDataSets(true);
+  for (size_t iDs = 0; iDs < from->Surfaces->size(); iDs++)
+  {
+    this->AddDataSet((*from->Surfaces)[iDs].second, true,
+      (*from->Surfaces)[iDs].first);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkLagrangianBasicIntegrationModel::AddDataSet(vtkDataSet * dataset,
   bool surface, unsigned int surfaceFlatIndex)
@@ -612,6 +644,10 @@ void vtkLagrangianBasicIntegrationModel::AddDataSet(vtkDataSet * dataset,
     return;
   }
 
+  // Cache the ghost array now, so that it is only read when looking for
+  // cells, possibly from several threads
+  dataset->GetCellGhostArray();
+
   // insert the dataset into DataSet vector
   if (surface)
   {
@@ -728,6 +764,7 @@ vtkLagrangianParticle* vtkLagrangianBasicIntegrationModel::ComputeSurfaceInterac
   vtkIdType cellId = -1;
   int surfaceType = -1;
   PassThroughSetType passThroughInterSet;
+  vtkNew<vtkGenericCell> cell;
   bool perforation;
   do
   {
@@ -745,8 +782,8 @@ vtkLagrangianParticle* vtkLagrangianBasicIntegrationModel::ComputeSurfaceInterac
         double tmpFactor;
         double tmpPoint[3];
         vtkIdType tmpCellId = cellList->GetId(i);
-        vtkCell* cell = tmpSurface->GetCell(tmpCellId);
-        if (this->IntersectWithLine(cell, particle->GetPosition(),
+        tmpSurface->GetCell(tmpCellId, cell.Get());
+        if (this->IntersectWithLine(cell.Get(), particle->GetPosition(),
           particle->GetNextPosition(), this->Tolerance,
           tmpFactor, tmpPoint) == 0)
         {
@@ -970,7 +1007,9 @@ bool vtkLagrangianBasicIntegrationModel::IntersectWithLine(vtkCell* cell,
   // Non planar quad support
   if (this->NonPlanarQuadSupport)
   {
-    vtkQuad* quad = vtkQuad::SafeDownCast(cell);
+    vtkGenericCell* genericCell = vtkGenericCell::SafeDownCast(cell);
+    vtkQuad* quad = vtkQuad::SafeDownCast(
+      genericCell ? genericCell->GetRepresentativeCell() : cell);
     if (quad != NULL)
     {
       if (p1[0] == p2[0] && p1[1] == p2[1] && p1[2] == p2[2])
@@ -1338,8 +1377,9 @@ bool vtkLagrangianBasicIntegrationModel::GetFlowOrSurfaceData(int idx, vtkDataSe
       this->TmpArray = array->NewInstance();
       this->TmpArray->SetNumberOfComponents(nComponents);
       this->TmpArray->SetNumberOfTuples(1);
+      dataSet->GetCell(tupleId, this->Cell);
       this->TmpArray->InterpolateTuple(
-        0, dataSet->GetCell(tupleId)->GetPointIds(), array, weights);
+        0, this->Cell->GetPointIds(), array, weights);
 
       // Recover data
       data = this->TmpArray->GetTuple(0);
@@ -1362,7 +1402,9 @@ bool vtkLagrangianBasicIntegrationModel::GetFlowOrSurfaceData(int idx, vtkDataSe
         return false;
       }
       nComponents = array->GetNumberOfComponents();
-      data = array->GetTuple(tupleId);
+      this->TmpTuple.resize(nComponents);
+      array->GetTuple(tupleId, &this->TmpTuple[0]);
+      data = &this->TmpTuple[0];
       return true;
     }
     case vtkDataObject::FIELD_ASSOCIATION_NONE:
@@ -1376,7 +1418,9 @@ bool vtkLagrangianBasicIntegrationModel::GetFlowOrSurfaceData(int idx, vtkDataSe
         return false;
       }
       nComponents = array->GetNumberOfComponents();
-      data = array->GetTuple(tupleId);
+      this->TmpTuple.resize(nComponents);
+      array->GetTuple(tupleId, &this->TmpTuple[0]);
+      data = &this->TmpTuple[0];
       return true;
     }
     default:
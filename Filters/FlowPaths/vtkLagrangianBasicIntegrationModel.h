@@ -43,6 +43,28 @@
  * Inherited class could reimplement CheckFreeFlightTermination to set
  * the way particle terminate in free flight
  *
+ * Thread safety : vtkLagrangianParticleTracker can integrate particles
+ * with several threads (see vtkLagrangianParticleTracker::ParallelIntegration)
+ * if its model is thread safe, which inherited classes declare by setting
+ * ThreadSafe to true in their constructor. Each thread then integrates with
+ * its own copy of the model, created with NewInstance and initialized with
+ * CopyParameters, so members modified during the integration (current
+ * particle, caches, temporary buffers) are not shared. Such a model must
+ * follow these rules during the integration :
+ * * The datasets, the flow locators and the particle seed data are shared
+ *     between the copies and must only be read, using thread safe methods,
+ *     eg. vtkDataSet::GetCell(vtkIdType, vtkGenericCell*) and
+ *     vtkDataArray::GetTuple(vtkIdType, double*) or GetComponent rather
+ *     than vtkDataSet::GetCell(vtkIdType) and vtkDataArray::GetTuple(vtkIdType)
+ *     or GetTuple1, which use a buffer owned by the dataset or array.
+ * * Inherited classes with their own parameters must reimplement
+ *     CopyParameters to copy them, and call the superclass method.
+ * * New particles must be created with vtkLagrangianParticle::NewParticle,
+ *     and pushed in the provided queue.
+ * * FinalizeOutputs and PreIntegrate are only called on the original model.
+ * The flow Locator must have a thread safe FindCell, as vtkCellLocator does.
+ * vtkLagrangianMatidaIntegrationModel is thread safe.
+ *
  * @sa
  * vtkLagrangianParticleTracker vtkLagrangianParticle
  * vtkLagrangianMatidaIntegrationModel
@@ -58,6 +80,7 @@
 
 #include <queue> // for new particles
 #include <map> // for array indexes
+#include <vector> // for tuple buffer
 
 class vtkAbstractArray;
 class vtkAbstractCellLocator;
@@ -129,6 +152,23 @@ public:
    */
   virtual void SetTracker(vtkLagrangianParticleTracker* Tracker);
 
+  /**
+   * Copy the parameters and the datasets of another model of the same
+   * class, as done for each thread of a threaded integration. The flow
+   * datasets and their locators are shared, the surfaces are added again
+   * with their own locators. Inherited classes with their own parameters
+   * must reimplement this method and call the superclass method.
+   */
+  virtual void CopyParameters(vtkLagrangianBasicIntegrationModel* from);
+
+  //@{
+  /**
+   * Get if this model can be used by several threads, with one copy of
+   * the model each, see "Thread safety" above. False by default.
+   */
+  vtkGetMacro(ThreadSafe, bool);
+  //@}
+
   //@{
   /**
    * Add a dataset to locate cells in
@@ -498,10 +538,12 @@ protected:
   vtkLocatorsType* SurfaceLocators;
 
   vtkDataArray* TmpArray;
+  std::vector<double> TmpTuple;
 
   double Tolerance;
   bool NonPlanarQuadSupport;
   bool UseInitialIntegrationTime;
+  bool ThreadSafe;
 
   vtkNew<vtkStringArray> SeedArrayNames;
   vtkNew<vtkIntArray> SeedArrayComps;
@@ -41,6 +41,9 @@ vtkLagrangianMatidaIntegrationModel::vtkLagrangianMatidaIntegrationModel()
 
   this->NumFuncs     = 6; // u, v, w, du/dt, dv/dt, dw/dt
   this->NumIndepVars = 7; // x, y, z, u, v, w, t
+
+  // Only reads shared data with thread safe methods
+  this->ThreadSafe = true;
 }
 
 //---------------------------------------------------------------------------
@@ -123,7 +126,7 @@ int vtkLagrangianMatidaIntegrationModel::FunctionValues(vtkDataSet* dataSet,
       "cannot use Matida equations");
     return 0;
   }
-  double particleDiameter = particleDiameters->GetTuple1(tupleIndex);
+  double particleDiameter = particleDiameters->GetComponent(tupleIndex, 0);
 
   // Fetch Particle Density at index 7
   vtkDataArray* particleDensities = vtkDataArray::SafeDownCast(
@@ -134,7 +137,7 @@ int vtkLagrangianMatidaIntegrationModel::FunctionValues(vtkDataSet* dataSet,
       "cannot use Matida equations");
     return 0;
   }
-  double particleDensity = particleDensities->GetTuple1(tupleIndex);
+  double particleDensity = particleDensities->GetComponent(tupleIndex, 0);
 
   // Compute function values
   for (int i = 0; i<3; i++)
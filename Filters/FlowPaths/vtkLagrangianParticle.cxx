@@ -37,7 +37,9 @@ vtkLagrangianParticle::vtkLagrangianParticle(int numberOfVariables,
   UserFlag(0),
   NumberOfVariables(numberOfVariables),
   PInsertPreviousPosition(false),
-  PManualShift(false)
+  PManualShift(false),
+  ThreadedIntegration(false),
+  DeferredSeedData(false)
 {
   // Initialize equation variables and associated pointers
   this->PrevEquationVariables = new double[this->NumberOfVariables];
@@ -93,10 +95,16 @@ vtkLagrangianParticle* vtkLagrangianParticle::NewInstance(int numberOfVariables,
 //---------------------------------------------------------------------------
 vtkLagrangianParticle* vtkLagrangianParticle::NewParticle(vtkIdType particleId)
 {
-  // Copy point data tuples
+  // Copy point data tuples, or let CopyDeferredSeedData do it when other
+  // threads may be reading them
   vtkPointData* seedData = this->GetSeedData();
   vtkIdType seedArrayTupleIndex = this->GetSeedArrayTupleIndex();
-  if (seedData->GetNumberOfArrays() > 0)
+  bool deferredSeedData = false;
+  if (seedData->GetNumberOfArrays() > 0 && this->ThreadedIntegration)
+  {
+    deferredSeedData = true;
+  }
+  else if (seedData->GetNumberOfArrays() > 0)
   {
     vtkIdType parentSeedArrayTupleIndex = seedArrayTupleIndex;
     seedArrayTupleIndex = seedData->GetArray(0)->GetNumberOfTuples();
@@ -112,6 +120,8 @@ vtkLagrangianParticle* vtkLagrangianParticle::NewParticle(vtkIdType particleId)
     seedArrayTupleIndex, this->IntegrationTime + this->StepTime, seedData);
   particle->ParentId = this->GetId();
   particle->NumberOfSteps = this->GetNumberOfSteps() + 1;
+  particle->ThreadedIntegration = this->ThreadedIntegration;
+  particle->DeferredSeedData = deferredSeedData;
 
   // Copy Variables
   memcpy(particle->GetPrevEquationVariables(), this->GetEquationVariables(),
@@ -139,6 +149,7 @@ vtkLagrangianParticle* vtkLagrangianParticle::CloneParticle()
   memcpy(clone->GetNextEquationVariables(), this->GetNextEquationVariables(),
     this->NumberOfVariables * sizeof(double));
   clone->StepTime = this->StepTime;
+  clone->ThreadedIntegration = this->ThreadedIntegration;
   return clone;
 }
 
@@ -189,6 +200,12 @@ vtkDataSet* vtkLagrangianParticle::GetLastSurfaceDataSet()
   return this->LastSurfaceDataSet;
 }
 
+//---------------------------------------------------------------------------
+void vtkLagrangianParticle::SetId(vtkIdType id)
+{
+  this->Id = id;
+}
+
 //---------------------------------------------------------------------------
 vtkIdType vtkLagrangianParticle::GetId()
 {
@@ -327,6 +344,35 @@ bool vtkLagrangianParticle::GetPManualShift()
   return this->PManualShift;
 }
 
+//---------------------------------------------------------------------------
+void vtkLagrangianParticle::SetThreadedIntegration(bool val)
+{
+  this->ThreadedIntegration = val;
+}
+
+//---------------------------------------------------------------------------
+bool vtkLagrangianParticle::GetThreadedIntegration()
+{
+  return this->ThreadedIntegration;
+}
+
+//---------------------------------------------------------------------------
+void vtkLagrangianParticle::CopyDeferredSeedData()
+{
+  if (!this->DeferredSeedData)
+  {
+    return;
+  }
+  vtkPointData* seedData = this->GetSeedData();
+  vtkIdType parentSeedArrayTupleIndex = this->SeedArrayTupleIndex;
+  this->SeedArrayTupleIndex = seedData->GetArray(0)->GetNumberOfTuples();
+  seedData->CopyAllocate(
+    seedData, this->SeedArrayTupleIndex + 1);
+  seedData->CopyData(
+    seedData, parentSeedArrayTupleIndex, this->SeedArrayTupleIndex);
+  this->DeferredSeedData = false;
+}
+
 //---------------------------------------------------------------------------
 double vtkLagrangianParticle::GetPositionVectorMagnitude()
 {
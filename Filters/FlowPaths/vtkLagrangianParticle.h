@@ -255,10 +255,13 @@ public:
    */
   virtual void MoveToNextPosition();
 
+  //@{
   /**
-   * Get particle id.
+   * Set/Get particle id.
    */
+  virtual void SetId(vtkIdType id);
   virtual vtkIdType GetId();
+  //@}
 
   //@{
   /**
@@ -380,6 +383,28 @@ public:
   virtual bool GetPManualShift();
   //@}
 
+  //@{
+  /**
+   * Set/Get threaded integration specific flag, indicating that the
+   * particle is integrated concurrently with other particles sharing its
+   * seed data. NewParticle() then does not append the seed data tuple of
+   * the new particle, which is done later by CopyDeferredSeedData(); until
+   * then the new particle uses the seed data tuple of its parent.
+   * The flag is passed on to the new particles.
+   * No effect in serial.
+   */
+  virtual void SetThreadedIntegration(bool val);
+  virtual bool GetThreadedIntegration();
+  //@}
+
+  /**
+   * Append the seed data tuple of a particle created by NewParticle()
+   * during a threaded integration, and use it from now on.
+   * Does nothing if there is no such pending tuple.
+   * This method is not thread safe.
+   */
+  virtual void CopyDeferredSeedData();
+
   /**
    * Get reference to step time of this particle
    */
@@ -461,6 +486,10 @@ protected:
   // Parallel related flags
   bool PInsertPreviousPosition;
   bool PManualShift;
+
+  // Threaded integration related flags
+  bool ThreadedIntegration;
+  bool DeferredSeedData;
 };
 
 #endif
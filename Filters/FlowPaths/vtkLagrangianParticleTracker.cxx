@@ -22,6 +22,7 @@
 #include "vtkDataSetSurfaceFilter.h"
 #include "vtkDoubleArray.h"
 #include "vtkExecutive.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -37,12 +38,17 @@
 #include "vtkPolyLine.h"
 #include "vtkPolygon.h"
 #include "vtkRungeKutta2.h"
+#include "vtkSMPAlgorithmProgress.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSimpleCriticalSection.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
-#include "vtkVoxel.h"
 
 #include <algorithm>
 #include <limits>
 #include <sstream>
+#include <vector>
 
 vtkObjectFactoryNewMacro(vtkLagrangianParticleTracker);
 vtkCxxSetObjectMacro(vtkLagrangianParticleTracker, IntegrationModel, vtkLagrangianBasicIntegrationModel);
@@ -71,7 +77,9 @@ vtkLagrangianParticleTracker::vtkLagrangianParticleTracker()
   this->ParticlePathsRenderingPointsThreshold = 100;
 
   this->CreateOutOfDomainParticle = false;
+  this->ParallelIntegration = false;
   this->ParticleCounter = 0;
+  this->ParticleCounterLock = new vtkSimpleCriticalSection;
 }
 
 //---------------------------------------------------------------------------
@@ -79,6 +87,7 @@ vtkLagrangianParticleTracker::~vtkLagrangianParticleTracker()
 {
   this->SetIntegrator(NULL);
   this->SetIntegrationModel(NULL);
+  delete this->ParticleCounterLock;
 }
 
 //---------------------------------------------------------------------------
@@ -116,6 +125,7 @@ void vtkLagrangianParticleTracker::PrintSelf(ostream& os, vtkIndent indent)
     << this->ParticlePathsRenderingPointsThreshold << endl;
   os << indent << "MinimumVelocityMagnitude: " << this->MinimumVelocityMagnitude << endl;
   os << indent << "MinimumReductionFactor: " << this->MinimumReductionFactor << endl;
+  os << indent << "ParallelIntegration: " << this->ParallelIntegration << endl;
   os << indent << "ParticleCounter: " << this->ParticleCounter << endl;
 }
 
@@ -264,6 +274,14 @@ int vtkLagrangianParticleTracker::RequestData(
   // before integration.
   this->IntegrationModel->PreIntegrate(particlesQueue);
 
+  // Integrate the particles with several threads if possible, in which case
+  // the queue is left empty
+  if (this->CanIntegrateInParallel())
+  {
+    this->IntegrateInParallel(particlesQueue, particlePathsOutput,
+      interactionOutput);
+  }
+
   // Integrate each particle
   while (!this->GetAbortExecute())
   {
@@ -344,8 +362,11 @@ vtkMTimeType vtkLagrangianParticleTracker::GetMTime()
 //---------------------------------------------------------------------------
 vtkIdType vtkLagrangianParticleTracker::GetNewParticleId()
 {
+  // Particles may be created by several threads, see ParallelIntegration
+  this->ParticleCounterLock->Lock();
   vtkIdType id = this->ParticleCounter;
   this->ParticleCounter++;
+  this->ParticleCounterLock->Unlock();
   return id;
 }
 
@@ -906,6 +927,21 @@ int vtkLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
   std::queue<vtkLagrangianParticle*>& particlesQueue,
   vtkPolyData* particlePathsOutput, vtkIdList* particlePathPointId,
   vtkDataObject* interactionOutput)
+{
+  vtkNew<vtkGenericCell> cell;
+  return this->IntegrateParticle(this->IntegrationModel, this->Integrator,
+    cell.Get(), particle, particlesQueue, particlePathsOutput,
+    particlePathPointId, interactionOutput, true);
+}
+
+//---------------------------------------------------------------------------
+int vtkLagrangianParticleTracker::IntegrateParticle(
+  vtkLagrangianBasicIntegrationModel* model,
+  vtkInitialValueProblemSolver* integrator, vtkGenericCell* cell,
+  vtkLagrangianParticle* particle,
+  std::queue<vtkLagrangianParticle*>& particlesQueue,
+  vtkPolyData* particlePathsOutput, vtkIdList* particlePathPointId,
+  vtkDataObject* interactionOutput, bool updateProgress)
 {
   // Sanity check
   if (particle == NULL)
@@ -915,7 +951,7 @@ int vtkLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
   }
 
   // Set the current particle
-  this->IntegrationModel->SetCurrentParticle(particle);
+  model->SetCurrentParticle(particle);
 
   // Integrate until MaximumNumberOfSteps is reached or special case stops integration
   int integrationRes = 0;
@@ -925,7 +961,8 @@ int vtkLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
   while (particle->GetNumberOfSteps() < this->MaximumNumberOfSteps)
   {
     // Update progress
-    if (particle->GetNumberOfSteps() % 100 == 0 && this->ParticleCounter > 0)
+    if (updateProgress && particle->GetNumberOfSteps() % 100 == 0 &&
+      this->ParticleCounter > 0)
     {
       double progress = static_cast<double>(particle->GetId() +
         static_cast<double>(particle->GetNumberOfSteps()) / this->MaximumNumberOfSteps) /
@@ -941,7 +978,7 @@ int vtkLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
     double velocityMagnitude = reintegrationFactor * std::max(
       this->MinimumVelocityMagnitude,
       vtkMath::Norm(particle->GetVelocity()));
-    double cellLength = this->ComputeCellLength(particle);
+    double cellLength = this->ComputeCellLength(model, cell, particle);
 
     double stepLength    = stepFactor          * cellLength;
     double stepLengthMin = this->StepFactorMin * cellLength;
@@ -951,7 +988,7 @@ int vtkLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
     double stepTimeMax = stepLengthMax / velocityMagnitude;
 
     // Integrate one step
-    if (!this->ComputeNextStep(particle->GetEquationVariables(),
+    if (!this->ComputeNextStep(model, integrator, particle->GetEquationVariables(),
       particle->GetNextEquationVariables(), particle->GetIntegrationTime(),
       stepTime, stepTimeActual, stepTimeMin, stepTimeMax, integrationRes))
     {
@@ -999,11 +1036,11 @@ int vtkLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
       vtkLagrangianBasicIntegrationModel::PassThroughParticlesType passThroughParticles;
       unsigned int interactedSurfaceFlaxIndex;
       vtkLagrangianParticle* interactionParticle =
-        this->IntegrationModel->ComputeSurfaceInteraction(
+        model->ComputeSurfaceInteraction(
         particle, particlesQueue, interactedSurfaceFlaxIndex, passThroughParticles);
       if (interactionParticle != NULL)
       {
-        this->InsertInteractionOutputPoint(interactionParticle,
+        this->InsertInteractionOutputPoint(model, interactionParticle,
           interactedSurfaceFlaxIndex, interactionOutput);
         delete interactionParticle;
         interactionParticle = NULL;
@@ -1019,7 +1056,8 @@ int vtkLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
         vtkLagrangianBasicIntegrationModel::PassThroughParticlesItem item =
           passThroughParticles.front();
         passThroughParticles.pop();
-        this->InsertInteractionOutputPoint(item.second, item.first, interactionOutput);
+        this->InsertInteractionOutputPoint(model, item.second, item.first,
+          interactionOutput);
 
         // the pass through particles needs to be deleted
         delete item.second;
@@ -1027,7 +1065,8 @@ int vtkLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
 
       // Particle has been correctly integrated and interacted, record it
       // Insert Current particle as an output point
-      this->InsertPathOutputPoint(particle, particlePathsOutput, particlePathPointId);
+      this->InsertPathOutputPoint(model, particle, particlePathsOutput,
+        particlePathPointId);
 
       // Particle has been terminated by surface
       if (particle->GetTermination() !=
@@ -1035,14 +1074,15 @@ int vtkLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
       {
         // Insert last particle path point on surface
         particle->MoveToNextPosition();
-        this->InsertPathOutputPoint(particle, particlePathsOutput, particlePathPointId);
+        this->InsertPathOutputPoint(model, particle, particlePathsOutput,
+          particlePathPointId);
 
         // stop integration
         break;
       }
     }
 
-    if (this->IntegrationModel->CheckFreeFlightTermination(particle))
+    if (model->CheckFreeFlightTermination(particle))
     {
       particle->SetTermination(
         vtkLagrangianParticle::PARTICLE_TERMINATION_FLIGHT_TERMINATED);
@@ -1053,7 +1093,7 @@ int vtkLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
     particle->MoveToNextPosition();
 
     // Compute now adaptive step
-    if (this->Integrator->IsAdaptive() || this->AdaptiveStepReintegration)
+    if (integrator->IsAdaptive() || this->AdaptiveStepReintegration)
     {
       stepFactor = stepTime * velocityMagnitude / cellLength;
     }
@@ -1065,7 +1105,7 @@ int vtkLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
     particle->SetTermination(
       vtkLagrangianParticle::PARTICLE_TERMINATION_OUT_OF_STEPS);
   }
-  this->IntegrationModel->SetCurrentParticle(NULL);
+  model->SetCurrentParticle(NULL);
   return integrationRes;
 }
 
@@ -1073,6 +1113,15 @@ int vtkLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
 void vtkLagrangianParticleTracker::InsertPathOutputPoint(
   vtkLagrangianParticle* particle, vtkPolyData* particlePathsOutput,
   vtkIdList* particlePathPointId, bool prev)
+{
+  this->InsertPathOutputPoint(this->IntegrationModel, particle,
+    particlePathsOutput, particlePathPointId, prev);
+}
+
+//---------------------------------------------------------------------------
+void vtkLagrangianParticleTracker::InsertPathOutputPoint(
+  vtkLagrangianBasicIntegrationModel* model, vtkLagrangianParticle* particle,
+  vtkPolyData* particlePathsOutput, vtkIdList* particlePathPointId, bool prev)
 {
   // Recover structures
   vtkPoints* particlePathsPoints = particlePathsOutput->GetPoints();
@@ -1090,7 +1139,7 @@ void vtkLagrangianParticleTracker::InsertPathOutputPoint(
     vtkLagrangianBasicIntegrationModel::VARIABLE_STEP_CURRENT);
 
   // Add Variables data
-  this->IntegrationModel->InsertVariablesParticleData(particle,
+  model->InsertVariablesParticleData(particle,
     particlePathsPointData, prev ?
     vtkLagrangianBasicIntegrationModel::VARIABLE_STEP_PREV :
     vtkLagrangianBasicIntegrationModel::VARIABLE_STEP_CURRENT);
@@ -1100,6 +1149,15 @@ void vtkLagrangianParticleTracker::InsertPathOutputPoint(
 void vtkLagrangianParticleTracker::InsertInteractionOutputPoint(
   vtkLagrangianParticle* particle, unsigned int interactedSurfaceFlatIndex,
   vtkDataObject* interactionOutput)
+{
+  this->InsertInteractionOutputPoint(this->IntegrationModel, particle,
+    interactedSurfaceFlatIndex, interactionOutput);
+}
+
+//---------------------------------------------------------------------------
+void vtkLagrangianParticleTracker::InsertInteractionOutputPoint(
+  vtkLagrangianBasicIntegrationModel* model, vtkLagrangianParticle* particle,
+  unsigned int interactedSurfaceFlatIndex, vtkDataObject* interactionOutput)
 {
   // Find the correct output
   vtkCompositeDataSet *hdOutput = vtkCompositeDataSet::SafeDownCast(interactionOutput);
@@ -1142,7 +1200,7 @@ void vtkLagrangianParticleTracker::InsertInteractionOutputPoint(
     vtkLagrangianBasicIntegrationModel::VARIABLE_STEP_NEXT);
 
   // Add Variables data
-  this->IntegrationModel->InsertVariablesParticleData(particle, pointData,
+  model->InsertVariablesParticleData(particle, pointData,
     vtkLagrangianBasicIntegrationModel::VARIABLE_STEP_NEXT);
 
   // Finally, Insert data from seed data only on not yet written arrays
@@ -1170,7 +1228,7 @@ void vtkLagrangianParticleTracker::InsertSeedData(vtkLagrangianParticle* particl
     if (arr->GetNumberOfTuples() < maxTuples)
     {
       arr->InsertNextTuple(
-        seedData->GetArray(i)->GetTuple(particle->GetSeedArrayTupleIndex()));
+        particle->GetSeedArrayTupleIndex(), seedData->GetArray(i));
     }
   }
   // here all arrays from data should have the exact same size
@@ -1231,6 +1289,7 @@ void vtkLagrangianParticleTracker::InsertParticleData(vtkLagrangianParticle* par
 
 //---------------------------------------------------------------------------
 double vtkLagrangianParticleTracker::ComputeCellLength(
+  vtkLagrangianBasicIntegrationModel* model, vtkGenericCell* genericCell,
   vtkLagrangianParticle* particle)
 {
   double cellLength = 1.0;
@@ -1242,9 +1301,10 @@ double vtkLagrangianParticleTracker::ComputeCellLength(
     this->CellLengthComputationMode == STEP_CUR_CELL_DIV_THEO)
   {
     vtkIdType cellId;
-    if (this->IntegrationModel->FindInLocators(particle->GetPosition(), dataset, cellId))
+    if (model->FindInLocators(particle->GetPosition(), dataset, cellId))
     {
-      cell = dataset->GetCell(cellId);
+      dataset->GetCell(cellId, genericCell);
+      cell = genericCell;
     }
     else
     {
@@ -1261,11 +1321,12 @@ double vtkLagrangianParticleTracker::ComputeCellLength(
     {
       return cellLength;
     }
-    cell = dataset->GetCell(particle->GetLastCellId());
-    if (!cell)
+    dataset->GetCell(particle->GetLastCellId(), genericCell);
+    if (genericCell->GetCellType() == VTK_EMPTY_CELL)
     {
       return cellLength;
     }
+    cell = genericCell;
   }
   if (cell == NULL)
   {
@@ -1298,7 +1359,7 @@ double vtkLagrangianParticleTracker::ComputeCellLength(
   }
   else if ((this->CellLengthComputationMode == STEP_CUR_CELL_DIV_THEO ||
     this->CellLengthComputationMode == STEP_LAST_CELL_DIV_THEO) &&
-      vtkMath::Norm(vel) > 0.0 && !vtkVoxel::SafeDownCast(cell))
+      vtkMath::Norm(vel) > 0.0 && cell->GetCellType() != VTK_VOXEL)
   {
     double velHat[3] = {vel[0], vel[1], vel[2]};
     vtkMath::Normalize(velHat);
@@ -1337,6 +1398,8 @@ double vtkLagrangianParticleTracker::ComputeCellLength(
 
 //---------------------------------------------------------------------------
 bool vtkLagrangianParticleTracker::ComputeNextStep(
+  vtkLagrangianBasicIntegrationModel* model,
+  vtkInitialValueProblemSolver* integrator,
   double* xprev, double* xnext,
   double t, double& delT, double& delTActual,
   double minStep, double maxStep,
@@ -1344,13 +1407,13 @@ bool vtkLagrangianParticleTracker::ComputeNextStep(
 {
   // Check for potential manual integration
   double error;
-  if (!this->IntegrationModel->ManualIntegration(xprev, xnext, t, delT, delTActual,
-    minStep, maxStep, this->IntegrationModel->GetTolerance(), error, integrationRes))
+  if (!model->ManualIntegration(xprev, xnext, t, delT, delTActual,
+    minStep, maxStep, model->GetTolerance(), error, integrationRes))
   {
     // integrate one step
     integrationRes =
-      this->Integrator->ComputeNextStep(xprev, xnext, t, delT, delTActual,
-        minStep, maxStep, this->IntegrationModel->GetTolerance(), error);
+      integrator->ComputeNextStep(xprev, xnext, t, delT, delTActual,
+        minStep, maxStep, model->GetTolerance(), error);
   }
 
   // Check failure cases
@@ -1366,3 +1429,370 @@ bool vtkLagrangianParticleTracker::ComputeNextStep(
   }
   return true;
 }
+
+//---------------------------------------------------------------------------
+bool vtkLagrangianParticleTracker::CanIntegrateInParallel()
+{
+  return this->ParallelIntegration && this->Integrator &&
+    this->IntegrationModel->GetThreadSafe();
+}
+
+//---------------------------------------------------------------------------
+// Integrate the particles of a pass of vtkLagrangianParticleTracker::
+// IntegrateInParallel(), each thread with its own model, integrator and
+// output buffers.
+class vtkLagrangianParticleTrackerIntegrate
+{
+public:
+  // The buffers and the model of a thread. The model is a copy of the
+  // prototype sharing its flow datasets and locators, with surface locators
+  // of its own.
+  struct LocalData
+  {
+    vtkSmartPointer<vtkLagrangianBasicIntegrationModel> Model;
+    vtkSmartPointer<vtkInitialValueProblemSolver> Integrator;
+    vtkSmartPointer<vtkGenericCell> Cell;
+    vtkSmartPointer<vtkIdList> PathPointIds;
+    vtkSmartPointer<vtkPolyData> Paths;
+    std::vector<vtkIdType> LineIds;
+    vtkSmartPointer<vtkDataObject> Interactions;
+    std::vector<vtkPolyData*> InteractionLeaves;
+  };
+
+  // Where the outputs of a particle are in the buffers of the thread that
+  // integrated it.
+  struct Record
+  {
+    LocalData* Data;
+    vtkIdType PointStart;
+    vtkIdType NumberOfPoints;
+    vtkIdType LineStart;
+    vtkIdType LineSize;
+    vtkIdType CellTuple;
+    std::vector<vtkIdType> InteractionStarts;
+    std::vector<vtkIdType> InteractionCounts;
+  };
+
+  vtkLagrangianParticleTracker* Self;
+  vtkPolyData* PathsOutput;
+  vtkDataObject* InteractionOutput;
+  std::vector<vtkLagrangianParticle*>* Particles;
+  std::vector<Record> Records;
+  std::vector<std::vector<vtkLagrangianParticle*> > Spawned;
+  vtkSMPAlgorithmProgress* Progress;
+  vtkSMPThreadLocal<LocalData> Data;
+
+  static void InitializeBuffer(vtkPolyData* buffer, vtkPolyData* output)
+  {
+    if (output->GetPoints())
+    {
+      vtkNew<vtkPoints> points;
+      points->SetDataType(output->GetPoints()->GetDataType());
+      buffer->SetPoints(points.Get());
+    }
+    buffer->GetPointData()->CopyStructure(output->GetPointData());
+    buffer->GetCellData()->CopyStructure(output->GetCellData());
+  }
+
+  // The buffers of a thread are kept from one generation of particles to
+  // the next, i.e., from one vtkSMPTools::For() call to the next, and
+  // only set up by the first one.
+  void Initialize()
+  {
+    LocalData& data = this->Data.Local();
+    if (data.Model)
+    {
+      return;
+    }
+
+    vtkLagrangianBasicIntegrationModel* prototype =
+      this->Self->IntegrationModel;
+    data.Model.TakeReference(prototype->NewInstance());
+    data.Model->CopyParameters(prototype);
+    data.Model->SetTracker(this->Self);
+    data.Integrator.TakeReference(this->Self->Integrator->NewInstance());
+    data.Integrator->SetFunctionSet(data.Model);
+    data.Cell = vtkSmartPointer<vtkGenericCell>::New();
+    data.PathPointIds = vtkSmartPointer<vtkIdList>::New();
+
+    data.Paths = vtkSmartPointer<vtkPolyData>::New();
+    InitializeBuffer(data.Paths, this->PathsOutput);
+
+    // Same structure as the interaction output, so that the leaves are
+    // found with the same flat indices
+    data.Interactions.TakeReference(this->InteractionOutput->NewInstance());
+    vtkCompositeDataSet* hdOutput =
+      vtkCompositeDataSet::SafeDownCast(this->InteractionOutput);
+    vtkPolyData* pdOutput = vtkPolyData::SafeDownCast(this->InteractionOutput);
+    if (hdOutput)
+    {
+      vtkCompositeDataSet* hdLocal =
+        vtkCompositeDataSet::SafeDownCast(data.Interactions);
+      hdLocal->CopyStructure(hdOutput);
+      vtkSmartPointer<vtkCompositeDataIterator> iter;
+      iter.TakeReference(hdOutput->NewIterator());
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        vtkNew<vtkPolyData> leaf;
+        InitializeBuffer(leaf.Get(),
+          vtkPolyData::SafeDownCast(hdOutput->GetDataSet(iter)));
+        hdLocal->SetDataSet(iter, leaf.Get());
+        data.InteractionLeaves.push_back(leaf.Get());
+      }
+    }
+    else if (pdOutput)
+    {
+      vtkPolyData* pdLocal = vtkPolyData::SafeDownCast(data.Interactions);
+      InitializeBuffer(pdLocal, pdOutput);
+      data.InteractionLeaves.push_back(pdLocal);
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    LocalData& data = this->Data.Local();
+    vtkPolyData* paths = data.Paths;
+    size_t nLeaves = data.InteractionLeaves.size();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      if (this->Progress->IsAborted())
+      {
+        return;
+      }
+      vtkLagrangianParticle* particle = (*this->Particles)[i];
+      Record& record = this->Records[i];
+      record.Data = &data;
+      record.PointStart = paths->GetNumberOfPoints();
+      record.InteractionStarts.resize(nLeaves);
+      record.InteractionCounts.resize(nLeaves);
+      for (size_t l = 0; l < nLeaves; ++l)
+      {
+        record.InteractionStarts[l] =
+          data.InteractionLeaves[l]->GetNumberOfPoints();
+      }
+
+      // Integrate
+      std::queue<vtkLagrangianParticle*> particlesQueue;
+      vtkIdList* pathPointIds = data.PathPointIds;
+      pathPointIds->Reset();
+      this->Self->IntegrateParticle(data.Model, data.Integrator, data.Cell,
+        particle, particlesQueue, paths, pathPointIds, data.Interactions, false);
+
+      // Duplicate single point particle paths, to avoid degenerated lines.
+      if (pathPointIds->GetNumberOfIds() == 1)
+      {
+        pathPointIds->InsertNextId(pathPointIds->GetId(0));
+      }
+
+      record.NumberOfPoints = paths->GetNumberOfPoints() - record.PointStart;
+      record.LineStart = static_cast<vtkIdType>(data.LineIds.size());
+      record.LineSize = pathPointIds->GetNumberOfIds();
+      record.CellTuple = -1;
+      if (record.LineSize > 0)
+      {
+        for (vtkIdType j = 0; j < record.LineSize; ++j)
+        {
+          data.LineIds.push_back(pathPointIds->GetId(j));
+        }
+        vtkCellData* cellData = paths->GetCellData();
+        record.CellTuple = cellData->GetNumberOfArrays() > 0 ?
+          cellData->GetAbstractArray(0)->GetNumberOfTuples() : 0;
+        this->Self->InsertPathData(particle, cellData);
+        this->Self->InsertSeedData(particle, cellData);
+      }
+      for (size_t l = 0; l < nLeaves; ++l)
+      {
+        record.InteractionCounts[l] =
+          data.InteractionLeaves[l]->GetNumberOfPoints() -
+          record.InteractionStarts[l];
+      }
+
+      // Keep the new particles for the next pass
+      std::vector<vtkLagrangianParticle*>& spawned = this->Spawned[i];
+      while (!particlesQueue.empty())
+      {
+        spawned.push_back(particlesQueue.front());
+        particlesQueue.pop();
+      }
+      this->Progress->Advance();
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+//---------------------------------------------------------------------------
+void vtkLagrangianParticleTracker::IntegrateInParallel(
+  std::queue<vtkLagrangianParticle*>& particlesQueue,
+  vtkPolyData* particlePathsOutput, vtkDataObject* interactionOutput)
+{
+  std::vector<vtkLagrangianParticle*> particles;
+  while (!particlesQueue.empty())
+  {
+    particles.push_back(particlesQueue.front());
+    particlesQueue.pop();
+  }
+
+  // Collect the interaction output leaves in the order of the per-thread
+  // buffers
+  std::vector<vtkPolyData*> interactionLeaves;
+  vtkCompositeDataSet* hdOutput = vtkCompositeDataSet::SafeDownCast(interactionOutput);
+  if (hdOutput)
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(hdOutput->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      interactionLeaves.push_back(vtkPolyData::SafeDownCast(hdOutput->GetDataSet(iter)));
+    }
+  }
+  else if (vtkPolyData::SafeDownCast(interactionOutput))
+  {
+    interactionLeaves.push_back(vtkPolyData::SafeDownCast(interactionOutput));
+  }
+
+  vtkLagrangianParticleTrackerIntegrate integrate;
+  integrate.Self = this;
+  integrate.PathsOutput = particlePathsOutput;
+  integrate.InteractionOutput = interactionOutput;
+  integrate.Particles = &particles;
+
+  // The serial loop processes the particles in the order they are queued,
+  // that is the seeds first, then the particles created while integrating
+  // the seeds, and so on. Each of these generations is one pass here.
+  while (!particles.empty())
+  {
+    for (size_t i = 0; i < particles.size(); ++i)
+    {
+      particles[i]->SetThreadedIntegration(true);
+    }
+    vtkIdType numParticles = static_cast<vtkIdType>(particles.size());
+    vtkIdType firstNewId = this->ParticleCounter;
+    integrate.Records.clear();
+    integrate.Records.resize(particles.size());
+    integrate.Spawned.clear();
+    integrate.Spawned.resize(particles.size());
+
+    // As in the serial loop, the progress is the id of the current
+    // particle over the number of particles created so far. The particle
+    // paths vary a lot in length, so the particles are handed out one by
+    // one.
+    double counter = static_cast<double>(std::max(this->ParticleCounter,
+      static_cast<vtkIdType>(1)));
+    vtkSMPAlgorithmProgress progress(this, numParticles,
+      particles.front()->GetId() / counter,
+      (particles.back()->GetId() + 1) / counter);
+    integrate.Progress = &progress;
+    vtkSMPTools::For(0, numParticles, 1, integrate);
+    bool abort = progress.IsAborted();
+
+    if (!abort)
+    {
+      // Merge the buffers in the serial order
+      vtkPoints* points = particlePathsOutput->GetPoints();
+      vtkPointData* pointData = particlePathsOutput->GetPointData();
+      vtkCellData* cellData = particlePathsOutput->GetCellData();
+      vtkCellArray* lines = particlePathsOutput->GetLines();
+      for (vtkIdType i = 0; i < numParticles; ++i)
+      {
+        const vtkLagrangianParticleTrackerIntegrate::Record& record =
+          integrate.Records[i];
+        vtkLagrangianParticleTrackerIntegrate::LocalData* data = record.Data;
+        vtkPolyData* paths = data->Paths;
+        vtkIdType offset = points->GetNumberOfPoints();
+        if (record.NumberOfPoints > 0)
+        {
+          points->GetData()->InsertTuples(offset, record.NumberOfPoints,
+            record.PointStart, paths->GetPoints()->GetData());
+          for (int a = 0; a < pointData->GetNumberOfArrays(); ++a)
+          {
+            pointData->GetAbstractArray(a)->InsertTuples(offset,
+              record.NumberOfPoints, record.PointStart,
+              paths->GetPointData()->GetAbstractArray(a));
+          }
+        }
+        if (record.LineSize > 0)
+        {
+          lines->InsertNextCell(record.LineSize);
+          for (vtkIdType j = 0; j < record.LineSize; ++j)
+          {
+            lines->InsertCellPoint(data->LineIds[record.LineStart + j] -
+              record.PointStart + offset);
+          }
+          for (int a = 0; a < cellData->GetNumberOfArrays(); ++a)
+          {
+            cellData->GetAbstractArray(a)->InsertNextTuple(record.CellTuple,
+              paths->GetCellData()->GetAbstractArray(a));
+          }
+        }
+        for (size_t l = 0; l < interactionLeaves.size(); ++l)
+        {
+          vtkIdType count = record.InteractionCounts[l];
+          if (count == 0)
+          {
+            continue;
+          }
+          vtkPolyData* leaf = interactionLeaves[l];
+          vtkPolyData* localLeaf = data->InteractionLeaves[l];
+          vtkIdType start = record.InteractionStarts[l];
+          offset = leaf->GetNumberOfPoints();
+          leaf->GetPoints()->GetData()->InsertTuples(offset, count, start,
+            localLeaf->GetPoints()->GetData());
+          vtkPointData* leafData = leaf->GetPointData();
+          for (int a = 0; a < leafData->GetNumberOfArrays(); ++a)
+          {
+            leafData->GetAbstractArray(a)->InsertTuples(offset, count, start,
+              localLeaf->GetPointData()->GetAbstractArray(a));
+          }
+        }
+      }
+    }
+
+    // Reset the buffers for the next pass
+    vtkSMPThreadLocal<vtkLagrangianParticleTrackerIntegrate::LocalData>::iterator
+      itr;
+    for (itr = integrate.Data.begin(); itr != integrate.Data.end(); ++itr)
+    {
+      vtkPolyData* paths = itr->Paths;
+      paths->GetPoints()->Reset();
+      paths->GetPointData()->Reset();
+      paths->GetCellData()->Reset();
+      itr->LineIds.clear();
+      for (size_t l = 0; l < itr->InteractionLeaves.size(); ++l)
+      {
+        vtkPolyData* leaf = itr->InteractionLeaves[l];
+        if (leaf->GetPoints())
+        {
+          leaf->GetPoints()->Reset();
+        }
+        leaf->GetPointData()->Reset();
+      }
+    }
+
+    // The particles of this pass are done, the new ones are numbered and
+    // their seed data copied in the order the serial loop creates them.
+    for (size_t i = 0; i < particles.size(); ++i)
+    {
+      delete particles[i];
+    }
+    particles.clear();
+    this->ParticleCounter = firstNewId;
+    for (size_t i = 0; i < integrate.Spawned.size(); ++i)
+    {
+      std::vector<vtkLagrangianParticle*>& spawned = integrate.Spawned[i];
+      for (size_t j = 0; j < spawned.size(); ++j)
+      {
+        if (abort)
+        {
+          delete spawned[j];
+          continue;
+        }
+        spawned[j]->SetId(this->GetNewParticleId());
+        spawned[j]->CopyDeferredSeedData();
+        particles.push_back(spawned[j]);
+      }
+    }
+  }
+}
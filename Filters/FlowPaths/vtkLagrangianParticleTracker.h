@@ -39,6 +39,8 @@
  *     interactions between particles and the surface input
  *
  * It has a parallel implementation which streams particle between domains.
+ * It can also integrate particles with several threads, see
+ * ParallelIntegration.
  *
  * The most important parameters of this filter is it's integrationModel.
  * Only one integration model implementation exist currently in ParaView
@@ -96,6 +98,7 @@ class vtkBoundingBox;
 class vtkCellArray;
 class vtkDataSet;
 class vtkDoubleArray;
+class vtkGenericCell;
 class vtkIdList;
 class vtkInformation;
 class vtkInitialValueProblemSolver;
@@ -104,6 +107,7 @@ class vtkLagrangianParticle;
 class vtkPointData;
 class vtkPoints;
 class vtkPolyData;
+class vtkSimpleCriticalSection;
 
 class VTKFILTERSFLOWPATHS_EXPORT vtkLagrangianParticleTracker :
   public vtkDataObjectAlgorithm
@@ -237,6 +241,28 @@ public:
   vtkBooleanMacro(CreateOutOfDomainParticle, bool);
   //@}
 
+  //@{
+  /**
+   * Turn on/off threaded integration (off by default). When on, and if the
+   * integration model is thread safe (see
+   * vtkLagrangianBasicIntegrationModel::GetThreadSafe), the particles are
+   * integrated concurrently using vtkSMPTools: each thread takes particles
+   * as it becomes idle and integrates them with its own copy of the
+   * integration model and integrator, into its own output buffers. The
+   * particles are processed in successive passes, the particles created by
+   * surface interactions during a pass being integrated in the next one.
+   * After each pass, the new particles are numbered and the buffers are
+   * merged in the serial order, so the output is the same as the serial one.
+   * With a composite flow input, each model copy starts looking for cells in
+   * the first block, thus a particle on an interface shared by several
+   * blocks may be located in a different block than in serial mode.
+   * vtkPLagrangianParticleTracker always integrates serially.
+   */
+  vtkSetMacro(ParallelIntegration, bool);
+  vtkGetMacro(ParallelIntegration, bool);
+  vtkBooleanMacro(ParallelIntegration, bool);
+  //@}
+
   //@{
   /**
    * Specify the source object used to generate particle initial position (seeds).
@@ -300,7 +326,8 @@ public:
   vtkMTimeType GetMTime() VTK_OVERRIDE;
 
   /**
-   * Get an unique id for a particle
+   * Get an unique id for a particle.
+   * This method is thread safe.
    */
   virtual vtkIdType GetNewParticleId();
 
@@ -344,21 +371,56 @@ protected:
     vtkPolyData* particlePathsOutput, vtkIdList* particlePathPointId,
     vtkDataObject* interactionOutput);
 
+  /**
+   * Integrate a particle using the given integration model, integrator and
+   * cell, see Integrate(), which calls it with the integration model and
+   * integrator of this filter. Progress is only reported when
+   * updateProgress is true.
+   */
+  int IntegrateParticle(vtkLagrangianBasicIntegrationModel* model,
+    vtkInitialValueProblemSolver* integrator, vtkGenericCell* cell,
+    vtkLagrangianParticle*, std::queue<vtkLagrangianParticle*>&,
+    vtkPolyData* particlePathsOutput, vtkIdList* particlePathPointId,
+    vtkDataObject* interactionOutput, bool updateProgress);
+
+  /**
+   * Return true if the particles can be integrated with several threads,
+   * see ParallelIntegration.
+   */
+  virtual bool CanIntegrateInParallel();
+
+  /**
+   * The threaded algorithm (see ParallelIntegration). Integrate the
+   * particles of the queue and the particles they create, and insert the
+   * results in the outputs as the serial loop of RequestData does.
+   * The queue is empty on return.
+   */
+  void IntegrateInParallel(std::queue<vtkLagrangianParticle*>& particlesQueue,
+    vtkPolyData* particlePathsOutput, vtkDataObject* interactionOutput);
+
   void InsertPathOutputPoint(vtkLagrangianParticle* particle,
     vtkPolyData* particlePathsOutput, vtkIdList* particlePathPointId,
     bool prev = false);
+  void InsertPathOutputPoint(vtkLagrangianBasicIntegrationModel* model,
+    vtkLagrangianParticle* particle, vtkPolyData* particlePathsOutput,
+    vtkIdList* particlePathPointId, bool prev = false);
 
   void InsertInteractionOutputPoint(vtkLagrangianParticle* particle,
     unsigned int interactedSurfaceFlatIndex, vtkDataObject* interactionOutput);
+  void InsertInteractionOutputPoint(vtkLagrangianBasicIntegrationModel* model,
+    vtkLagrangianParticle* particle, unsigned int interactedSurfaceFlatIndex,
+    vtkDataObject* interactionOutput);
 
   void InsertSeedData(vtkLagrangianParticle* particle, vtkFieldData* data);
   void InsertPathData(vtkLagrangianParticle* particle, vtkFieldData* data);
   void InsertInteractionData(vtkLagrangianParticle* particle, vtkFieldData* data);
   void InsertParticleData(vtkLagrangianParticle* particle, vtkFieldData* data, int stepEnum);
 
-  double ComputeCellLength(vtkLagrangianParticle* particle);
+  double ComputeCellLength(vtkLagrangianBasicIntegrationModel* model,
+    vtkGenericCell* cell, vtkLagrangianParticle* particle);
 
-  bool ComputeNextStep(
+  bool ComputeNextStep(vtkLagrangianBasicIntegrationModel* model,
+    vtkInitialValueProblemSolver* integrator,
     double* xprev, double* xnext,
     double t, double& delT, double& delTActual,
     double minStep, double maxStep,
@@ -378,11 +440,16 @@ protected:
   bool UseParticlePathsRenderingThreshold;
   int ParticlePathsRenderingPointsThreshold;
   bool CreateOutOfDomainParticle;
+  bool ParallelIntegration;
   vtkIdType ParticleCounter;
+  vtkSimpleCriticalSection* ParticleCounterLock;
 
   // internal parameters use for step computation
   double MinimumVelocityMagnitude;
   double MinimumReductionFactor;
+
+  friend class vtkLagrangianParticleTrackerIntegrate;
+
 private:
   vtkLagrangianParticleTracker(const vtkLagrangianParticleTracker&) VTK_DELETE_FUNCTION;
   void operator=(const vtkLagrangianParticleTracker&) VTK_DELETE_FUNCTION;
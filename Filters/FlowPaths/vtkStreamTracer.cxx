@@ -33,6 +33,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkInterpolatedVelocityField.h"
 #include "vtkAbstractInterpolatedVelocityField.h"
 #include "vtkCellLocatorInterpolatedVelocityField.h"
+#include "vtkCompositeInterpolatedVelocityField.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkNew.h"
@@ -45,8 +46,12 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkRungeKutta2.h"
 #include "vtkRungeKutta4.h"
 #include "vtkRungeKutta45.h"
+#include "vtkSMPAlgorithmProgress.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
 #include <vector>
 
 vtkObjectFactoryNewMacro(vtkStreamTracer)
@@ -128,6 +133,8 @@ vtkStreamTracer::vtkStreamTracer()
   this->HasMatchingPointAttributes = true;
 
   this->SurfaceStreamlines = false;
+
+  this->ParallelIntegration = false;
 }
 
 vtkStreamTracer::~vtkStreamTracer()
@@ -514,12 +521,27 @@ int vtkStreamTracer::RequestData(
       double propagation = 0;
       vtkIdType numSteps = 0;
       double integrationTime = 0;
-      this->Integrate(input0->GetPointData(), output,
-                      seeds, seedIds,
-                      integrationDirections,
-                      lastPoint, func,
-                      maxCellSize, vecType,vecName,
-                      propagation, numSteps, integrationTime);
+      // The per-thread interpolators are clones of a composite interpolator
+      // (the AMR one is not), and surface streamlines as well as
+      // non-matching point attributes are only handled serially.
+      if (this->ParallelIntegration && !this->SurfaceStreamlines &&
+          this->HasMatchingPointAttributes && this->GetIntegrator() &&
+          vtkCompositeInterpolatedVelocityField::SafeDownCast(func))
+      {
+        this->IntegrateInParallel(input0->GetPointData(), output,
+                                  seeds, seedIds,
+                                  integrationDirections, func,
+                                  maxCellSize, vecType, vecName);
+      }
+      else
+      {
+        this->Integrate(input0->GetPointData(), output,
+                        seeds, seedIds,
+                        integrationDirections,
+                        lastPoint, func,
+                        maxCellSize, vecType,vecName,
+                        propagation, numSteps, integrationTime);
+      }
     }
     func->Delete();
     seeds->Delete();
@@ -1201,6 +1223,595 @@ void vtkStreamTracer::Integrate(vtkPointData *input0Data,
   output->Squeeze();
 }
 
+// Traces the streamlines of a range of seeds for IntegrateInParallel(). The
+// loop mirrors the one of Integrate(), except that each thread works with its
+// own interpolator, integrator and output arrays, and each line starts with
+// a zero propagation, number of steps and integration time.
+class vtkStreamTracerIntegrateSeeds
+{
+public:
+  // The per-thread state. The interpolator is a clone of the prototype with
+  // the same datasets, so it keeps its own cell cache. A clone of a
+  // vtkCellLocatorInterpolatedVelocityField shares the cell locators of the
+  // prototype.
+  struct LocalData
+  {
+    vtkSmartPointer<vtkAbstractInterpolatedVelocityField> Func;
+    vtkSmartPointer<vtkInitialValueProblemSolver> Integrator;
+    vtkSmartPointer<vtkGenericCell> Cell;
+    std::vector<double> Weights;
+    vtkSmartPointer<vtkDoubleArray> CellVectors;
+    vtkSmartPointer<vtkPoints> Points;
+    vtkSmartPointer<vtkPointData> PointData;
+    vtkSmartPointer<vtkDoubleArray> Time;
+    vtkSmartPointer<vtkDoubleArray> VelocityVectors;
+    vtkSmartPointer<vtkDoubleArray> Vorticity;
+    vtkSmartPointer<vtkDoubleArray> Rotation;
+    vtkSmartPointer<vtkDoubleArray> AngularVel;
+  };
+
+  // Where the points of a streamline are in the arrays of the thread that
+  // traced it.
+  struct Line
+  {
+    LocalData *Data;
+    vtkIdType Offset;
+    vtkIdType NumberOfPoints;
+    int ReasonForTermination;
+    bool HasStep;
+    double LastUsedStepSize;
+  };
+
+  vtkStreamTracer *Self;
+  vtkAbstractInterpolatedVelocityField *Prototype;
+  const std::vector<vtkDataSet*> *DataSets;
+  vtkPointData *InputData;
+  vtkDataArray *SeedSource;
+  vtkIdList *SeedIds;
+  vtkIntArray *IntegrationDirections;
+  int MaxCellSize;
+  int VecType;
+  const char *VecName;
+  std::vector<Line> Lines;
+  vtkSMPAlgorithmProgress *Progress;
+  vtkSMPThreadLocal<LocalData> Data;
+
+  void Initialize()
+  {
+    LocalData &data = this->Data.Local();
+    data.Func.TakeReference(this->Prototype->NewInstance());
+    data.Func->CopyParameters(this->Prototype);
+    vtkCellLocatorInterpolatedVelocityField *cellLocatorFunc =
+      vtkCellLocatorInterpolatedVelocityField::SafeDownCast(data.Func);
+    if (cellLocatorFunc)
+    {
+      cellLocatorFunc->AddDataSets(
+        static_cast<vtkCellLocatorInterpolatedVelocityField*>(
+          this->Prototype));
+    }
+    else
+    {
+      vtkCompositeInterpolatedVelocityField *func =
+        vtkCompositeInterpolatedVelocityField::SafeDownCast(data.Func);
+      for (size_t i = 0; i < this->DataSets->size(); ++i)
+      {
+        func->AddDataSet((*this->DataSets)[i]);
+      }
+    }
+    data.Func->SelectVectors(this->VecType, this->VecName);
+
+    data.Integrator.TakeReference(this->Self->GetIntegrator()->NewInstance());
+    data.Integrator->SetFunctionSet(data.Func);
+    data.Cell = vtkSmartPointer<vtkGenericCell>::New();
+    data.Weights.resize(std::max(this->MaxCellSize, 1));
+
+    data.Points = vtkSmartPointer<vtkPoints>::New();
+    data.PointData = vtkSmartPointer<vtkPointData>::New();
+    data.PointData->InterpolateAllocate(this->InputData,
+                                        this->Self->MaximumNumberOfSteps);
+    data.Time = vtkSmartPointer<vtkDoubleArray>::New();
+    if (this->VecType != vtkDataObject::POINT)
+    {
+      data.VelocityVectors = vtkSmartPointer<vtkDoubleArray>::New();
+      data.VelocityVectors->SetNumberOfComponents(3);
+    }
+    if (this->Self->ComputeVorticity)
+    {
+      data.CellVectors = vtkSmartPointer<vtkDoubleArray>::New();
+      data.CellVectors->SetNumberOfComponents(3);
+      data.CellVectors->Allocate(3*VTK_CELL_SIZE);
+      data.Vorticity = vtkSmartPointer<vtkDoubleArray>::New();
+      data.Vorticity->SetNumberOfComponents(3);
+      data.Rotation = vtkSmartPointer<vtkDoubleArray>::New();
+      data.AngularVel = vtkSmartPointer<vtkDoubleArray>::New();
+    }
+  }
+
+  // Compute vorticity, angular velocity and rotation at the point just
+  // inserted (see Integrate()).
+  void InsertVorticity(LocalData &data, vtkDataArray *inVectors,
+                       double velocity[3], double speed,
+                       double integrationTime, bool firstPoint)
+  {
+    vtkStreamTracer *self = this->Self;
+    double vort[3] = { 0.0, 0.0, 0.0 };
+    if (this->VecType == vtkDataObject::POINT)
+    {
+      double pcoords[3];
+      inVectors->GetTuples(data.Cell->PointIds, data.CellVectors);
+      data.Func->GetLastLocalCoordinates(pcoords);
+      self->CalculateVorticity(data.Cell, pcoords, data.CellVectors, vort);
+    }
+    data.Vorticity->InsertNextTuple(vort);
+
+    double omega = 0.0;
+    if (!firstPoint || speed != 0.0)
+    {
+      omega = vtkMath::Dot(vort, velocity);
+      omega /= speed;
+      omega *= self->RotationScale;
+    }
+    vtkIdType index = data.AngularVel->InsertNextValue(omega);
+    if (firstPoint)
+    {
+      data.Rotation->InsertNextValue(0.0);
+    }
+    else
+    {
+      data.Rotation->InsertNextValue(
+        data.Rotation->GetValue(index-1) +
+        (data.AngularVel->GetValue(index-1) + omega)/2 *
+        (integrationTime - data.Time->GetValue(index-1)));
+    }
+  }
+
+  void IntegrateLine(LocalData &data, vtkIdType currentLine)
+  {
+    vtkStreamTracer *self = this->Self;
+    vtkAbstractInterpolatedVelocityField *func = data.Func;
+    vtkInitialValueProblemSolver *integrator = data.Integrator;
+    vtkGenericCell *cell = data.Cell;
+    double *weights = &data.Weights[0];
+    const bool fast = self->HasMatchingPointAttributes;
+
+    Line &line = this->Lines[currentLine];
+    line.Data = &data;
+    line.Offset = data.Points->GetNumberOfPoints();
+    line.NumberOfPoints = 0;
+    line.ReasonForTermination = vtkStreamTracer::OUT_OF_LENGTH;
+    line.HasStep = false;
+    line.LastUsedStepSize = 0.0;
+
+    int direction = 1;
+    if (this->IntegrationDirections->GetValue(currentLine) ==
+        vtkStreamTracer::BACKWARD)
+    {
+      direction = -1;
+    }
+
+    double propagation = 0.0;
+    vtkIdType numSteps = 0;
+    double integrationTime = 0.0;
+    double point1[3], point2[3], velocity[3];
+
+    // Restart the cell search from scratch, in the first dataset, so that
+    // the line does not depend on the lines previously traced by the thread
+    func->SetLastCellId(-1, 0);
+
+    // Initial point
+    this->SeedSource->GetTuple(this->SeedIds->GetId(currentLine), point1);
+    memcpy(point2, point1, 3*sizeof(double));
+    if (!func->FunctionValues(point1, velocity))
+    {
+      return;
+    }
+
+    if ( propagation >= self->MaximumPropagation ||
+         numSteps    >  self->MaximumNumberOfSteps)
+    {
+      return;
+    }
+
+    line.NumberOfPoints++;
+    vtkIdType nextPoint = data.Points->InsertNextPoint(point1);
+    double lastInsertedPoint[3];
+    data.Points->GetPoint(nextPoint, lastInsertedPoint);
+    data.Time->InsertNextValue(integrationTime);
+
+    vtkStreamTracer::IntervalInformation stepSize;  // either positive or negative
+    stepSize.Unit  = vtkStreamTracer::LENGTH_UNIT;
+    stepSize.Interval = 0;
+    vtkStreamTracer::IntervalInformation aStep; // always positive
+    aStep.Unit = vtkStreamTracer::LENGTH_UNIT;
+    double step, minStep=0, maxStep=0;
+    double stepTaken;
+    double cellLength;
+    int retVal=vtkStreamTracer::OUT_OF_LENGTH, tmp;
+
+    // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
+    vtkDataSet *input = func->GetLastDataSet();
+    vtkPointData *inputPD = input->GetPointData();
+    vtkDataArray *inVectors =
+      input->GetAttributesAsFieldData(this->VecType)->GetArray(this->VecName);
+    // Convert intervals to arc-length unit
+    input->GetCell(func->GetLastCellId(), cell);
+    cellLength = sqrt(static_cast<double>(cell->GetLength2()));
+    double speed = vtkMath::Norm(velocity);
+    // Never call conversion methods if speed == 0
+    if ( speed != 0.0 )
+    {
+      self->ConvertIntervals( stepSize.Interval, minStep, maxStep,
+                              direction, cellLength );
+    }
+
+    // Interpolate all point attributes on first point
+    func->GetLastWeights(weights);
+    InterpolatePoint(data.PointData, inputPD, nextPoint, cell->PointIds,
+                     weights, fast);
+    if (data.VelocityVectors)
+    {
+      data.VelocityVectors->InsertNextTuple(velocity);
+    }
+    if (self->ComputeVorticity)
+    {
+      this->InsertVorticity(data, inVectors, velocity, speed,
+                            integrationTime, true);
+    }
+
+    double error = 0;
+
+    // Integrate until the maximum propagation length is reached,
+    // maximum number of steps is reached or until a boundary is encountered.
+    while ( propagation < self->MaximumPropagation )
+    {
+      if (numSteps++ > self->MaximumNumberOfSteps)
+      {
+        retVal = vtkStreamTracer::OUT_OF_STEPS;
+        break;
+      }
+
+      // Never call conversion methods if speed == 0
+      if ( (speed == 0) || (speed <= self->TerminalSpeed) )
+      {
+        retVal = vtkStreamTracer::STAGNATION;
+        break;
+      }
+
+      // If, with the next step, propagation will be larger than
+      // max, reduce it so that it is (approximately) equal to max.
+      aStep.Interval = fabs( stepSize.Interval );
+
+      if ( ( propagation + aStep.Interval ) > self->MaximumPropagation )
+      {
+        aStep.Interval = self->MaximumPropagation - propagation;
+        if ( stepSize.Interval >= 0 )
+        {
+          stepSize.Interval = vtkStreamTracer::ConvertToLength( aStep, cellLength );
+        }
+        else
+        {
+          stepSize.Interval = vtkStreamTracer::ConvertToLength( aStep, cellLength ) * ( -1.0 );
+        }
+        maxStep = stepSize.Interval;
+      }
+      line.HasStep = true;
+      line.LastUsedStepSize = stepSize.Interval;
+
+      // Calculate the next step using the integrator provided
+      // Break if the next point is out of bounds.
+      func->SetNormalizeVector( true );
+      tmp = integrator->ComputeNextStep( point1, point2, 0, stepSize.Interval,
+                                         stepTaken, minStep, maxStep,
+                                         self->MaximumError, error );
+      func->SetNormalizeVector( false );
+      if ( tmp != 0 )
+      {
+        retVal = tmp;
+        break;
+      }
+
+      // This is the next starting point
+      memcpy(point1, point2, 3*sizeof(double));
+
+      // Interpolate the velocity at the next point
+      if ( !func->FunctionValues(point2, velocity) )
+      {
+        retVal = vtkStreamTracer::OUT_OF_DOMAIN;
+        break;
+      }
+
+      // It is not enough to use the starting point for stagnation calculation
+      // Use average speed to check if it is below stagnation threshold
+      double speed2 = vtkMath::Norm(velocity);
+      if ( (speed+speed2)/2 <= self->TerminalSpeed )
+      {
+        retVal = vtkStreamTracer::STAGNATION;
+        break;
+      }
+
+      integrationTime += stepTaken / speed;
+      // Calculate propagation (using the same units as MaximumPropagation
+      propagation += fabs( stepSize.Interval );
+
+      // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
+      input = func->GetLastDataSet();
+      inputPD = input->GetPointData();
+      inVectors =
+        input->GetAttributesAsFieldData(this->VecType)->GetArray(this->VecName);
+
+      // Calculate cell length and speed to be used in unit conversions
+      input->GetCell(func->GetLastCellId(), cell);
+      cellLength = sqrt(static_cast<double>(cell->GetLength2()));
+      speed = speed2;
+
+      // Check if conversion to float will produce a point in same place
+      float convertedPoint[3];
+      for (int i = 0; i < 3; i++)
+      {
+        convertedPoint[i] = point1[i];
+      }
+      if (lastInsertedPoint[0] != convertedPoint[0] ||
+          lastInsertedPoint[1] != convertedPoint[1] ||
+          lastInsertedPoint[2] != convertedPoint[2])
+      {
+        // Point is valid. Insert it.
+        line.NumberOfPoints++;
+        nextPoint = data.Points->InsertNextPoint(point1);
+        data.Points->GetPoint(nextPoint, lastInsertedPoint);
+        data.Time->InsertNextValue(integrationTime);
+
+        // Interpolate all point attributes on current point
+        func->GetLastWeights(weights);
+        InterpolatePoint(data.PointData, inputPD, nextPoint, cell->PointIds,
+                         weights, fast);
+        if (data.VelocityVectors)
+        {
+          data.VelocityVectors->InsertNextTuple(velocity);
+        }
+        if (self->ComputeVorticity)
+        {
+          this->InsertVorticity(data, inVectors, velocity, speed,
+                                integrationTime, false);
+        }
+      }
+
+      // Never call conversion methods if speed == 0
+      if ( (speed == 0) || (speed <= self->TerminalSpeed) )
+      {
+        retVal = vtkStreamTracer::STAGNATION;
+        break;
+      }
+
+      // Convert all intervals to arc length
+      self->ConvertIntervals( step, minStep, maxStep, direction, cellLength );
+
+      // If the solver is adaptive and the next step size (stepSize.Interval)
+      // that the solver wants to use is smaller than minStep or larger
+      // than maxStep, re-adjust it. This has to be done every step
+      // because minStep and maxStep can change depending on the cell
+      // size (unless it is specified in arc-length unit)
+      if (integrator->IsAdaptive())
+      {
+        if (fabs(stepSize.Interval) < fabs(minStep))
+        {
+          stepSize.Interval = fabs( minStep ) *
+                                stepSize.Interval / fabs( stepSize.Interval );
+        }
+        else if (fabs(stepSize.Interval) > fabs(maxStep))
+        {
+          stepSize.Interval = fabs( maxStep ) *
+                                stepSize.Interval / fabs( stepSize.Interval );
+        }
+      }
+      else
+      {
+        stepSize.Interval = step;
+      }
+    }
+
+    line.ReasonForTermination = retVal;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    LocalData &data = this->Data.Local();
+    for (vtkIdType currentLine = begin; currentLine < end; ++currentLine)
+    {
+      if (this->Progress->IsAborted())
+      {
+        return;
+      }
+      this->IntegrateLine(data, currentLine);
+      this->Progress->Advance();
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+void vtkStreamTracer::IntegrateInParallel(vtkPointData *input0Data,
+                                          vtkPolyData* output,
+                                          vtkDataArray* seedSource,
+                                          vtkIdList* seedIds,
+                                          vtkIntArray* integrationDirections,
+                                          vtkAbstractInterpolatedVelocityField* func,
+                                          int maxCellSize,
+                                          int vecType,
+                                          const char *vecName)
+{
+  vtkIdType numLines = seedIds->GetNumberOfIds();
+
+  // The datasets, and the cell locators of a
+  // vtkCellLocatorInterpolatedVelocityField, are shared by the per-thread
+  // interpolators, so the structures used to locate cells are built before
+  // going parallel.
+  std::vector<vtkDataSet*> dataSets;
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(this->InputData->NewIterator());
+  for (iter->GoToFirstItem(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkDataSet* inp = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    if (inp)
+    {
+      inp->PrepareFindCellWithContext();
+      dataSets.push_back(inp);
+    }
+  }
+  vtkCellLocatorInterpolatedVelocityField *cellLocatorFunc =
+    vtkCellLocatorInterpolatedVelocityField::SafeDownCast(func);
+  if (cellLocatorFunc)
+  {
+    cellLocatorFunc->BuildCellLocators();
+  }
+
+  vtkStreamTracerIntegrateSeeds integrate;
+  integrate.Self = this;
+  integrate.Prototype = func;
+  integrate.DataSets = &dataSets;
+  integrate.InputData = input0Data;
+  integrate.SeedSource = seedSource;
+  integrate.SeedIds = seedIds;
+  integrate.IntegrationDirections = integrationDirections;
+  integrate.MaxCellSize = maxCellSize;
+  integrate.VecType = vecType;
+  integrate.VecName = vecName;
+  integrate.Lines.resize(numLines);
+
+  // One seed at a time, since the lengths of the lines vary a lot.
+  vtkSMPAlgorithmProgress progress(this, numLines);
+  integrate.Progress = &progress;
+  vtkSMPTools::For(0, numLines, 1, integrate);
+
+  // Merge the lines in seed order. When aborted, the lines traced before the
+  // abort are complete and kept; the others have no points.
+  vtkIdType numPtsTotal = 0;
+  for (vtkIdType currentLine = 0; currentLine < numLines; currentLine++)
+  {
+    const vtkStreamTracerIntegrateSeeds::Line &line =
+      integrate.Lines[currentLine];
+    numPtsTotal += line.NumberOfPoints;
+    if (line.HasStep)
+    {
+      this->LastUsedStepSize = line.LastUsedStepSize;
+    }
+  }
+
+  vtkDataSetAttributes* outputPD = output->GetPointData();
+  vtkDataSetAttributes* outputCD = output->GetCellData();
+  outputPD->InterpolateAllocate(input0Data, numPtsTotal);
+
+  vtkNew<vtkPoints> outputPoints;
+  vtkNew<vtkCellArray> outputLines;
+
+  vtkNew<vtkDoubleArray> time;
+  time->SetName("IntegrationTime");
+
+  vtkNew<vtkIntArray> retVals;
+  retVals->SetName("ReasonForTermination");
+
+  vtkNew<vtkIntArray> sids;
+  sids->SetName("SeedIds");
+
+  vtkSmartPointer<vtkDoubleArray> velocityVectors;
+  if(vecType != vtkDataObject::POINT)
+  {
+    velocityVectors = vtkSmartPointer<vtkDoubleArray>::New();
+    velocityVectors->SetName(vecName);
+    velocityVectors->SetNumberOfComponents(3);
+  }
+  vtkSmartPointer<vtkDoubleArray> vorticity;
+  vtkSmartPointer<vtkDoubleArray> rotation;
+  vtkSmartPointer<vtkDoubleArray> angularVel;
+  if (this->ComputeVorticity)
+  {
+    vorticity = vtkSmartPointer<vtkDoubleArray>::New();
+    vorticity->SetName("Vorticity");
+    vorticity->SetNumberOfComponents(3);
+
+    rotation = vtkSmartPointer<vtkDoubleArray>::New();
+    rotation->SetName("Rotation");
+
+    angularVel = vtkSmartPointer<vtkDoubleArray>::New();
+    angularVel->SetName("AngularVelocity");
+  }
+
+  vtkIdType offset = 0;
+  for (vtkIdType currentLine = 0; currentLine < numLines; currentLine++)
+  {
+    const vtkStreamTracerIntegrateSeeds::Line &line =
+      integrate.Lines[currentLine];
+    vtkIdType numPts = line.NumberOfPoints;
+    if (numPts == 0)
+    {
+      continue;
+    }
+
+    vtkStreamTracerIntegrateSeeds::LocalData *data = line.Data;
+    outputPoints->GetData()->InsertTuples(offset, numPts, line.Offset,
+                                          data->Points->GetData());
+    for (int i = 0; i < outputPD->GetNumberOfArrays(); i++)
+    {
+      outputPD->GetAbstractArray(i)->InsertTuples(
+        offset, numPts, line.Offset, data->PointData->GetAbstractArray(i));
+    }
+    time->InsertTuples(offset, numPts, line.Offset, data->Time);
+    if (velocityVectors)
+    {
+      velocityVectors->InsertTuples(offset, numPts, line.Offset,
+                                    data->VelocityVectors);
+    }
+    if (vorticity)
+    {
+      vorticity->InsertTuples(offset, numPts, line.Offset, data->Vorticity);
+      rotation->InsertTuples(offset, numPts, line.Offset, data->Rotation);
+      angularVel->InsertTuples(offset, numPts, line.Offset, data->AngularVel);
+    }
+
+    if (numPts > 1)
+    {
+      outputLines->InsertNextCell(numPts);
+      for (vtkIdType i = offset; i < offset + numPts; i++)
+      {
+        outputLines->InsertCellPoint(i);
+      }
+      retVals->InsertNextValue(line.ReasonForTermination);
+      sids->InsertNextValue(seedIds->GetId(currentLine));
+    }
+    offset += numPts;
+  }
+
+  // Create the output polyline
+  output->SetPoints(outputPoints.Get());
+  outputPD->AddArray(time.Get());
+  if(vecType != vtkDataObject::POINT)
+  {
+    outputPD->AddArray(velocityVectors);
+  }
+  if (vorticity)
+  {
+    outputPD->AddArray(vorticity);
+    outputPD->AddArray(rotation);
+    outputPD->AddArray(angularVel);
+  }
+
+  if ( numPtsTotal > 1 )
+  {
+    // Assign geometry and attributes
+    output->SetLines(outputLines.Get());
+    if (this->GenerateNormalsInIntegrate)
+    {
+      this->GenerateNormals(output, 0, vecName);
+    }
+
+    outputCD->AddArray(retVals.Get());
+    outputCD->AddArray(sids.Get());
+  }
+
+  output->Squeeze();
+}
+
 void vtkStreamTracer::GenerateNormals(vtkPolyData* output, double* firstNormal,
                                       const char *vecName)
 {
@@ -1414,6 +2025,8 @@ void vtkStreamTracer::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Vorticity computation: "
      << (this->ComputeVorticity ? " On" : " Off") << endl;
   os << indent << "Rotation scale: " << this->RotationScale << endl;
+  os << indent << "Parallel integration: "
+     << (this->ParallelIntegration ? " On" : " Off") << endl;
 }
 
 vtkExecutive* vtkStreamTracer::CreateDefaultExecutive()
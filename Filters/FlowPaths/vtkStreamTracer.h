@@ -289,6 +289,25 @@ public:
   vtkBooleanMacro(SurfaceStreamlines, bool);
   //@}
 
+  //@{
+  /**
+   * Turn on/off seed-parallel integration (off by default). When on, the
+   * streamlines are traced concurrently using vtkSMPTools: each thread
+   * takes seeds as it becomes idle and traces them with its own copy of the
+   * interpolator (and thus its own cell cache) and integrator. The lines are
+   * then merged in seed order, so the output is the same as the serial one.
+   * When the execution is aborted, the output holds the streamlines traced
+   * before the abort. Surface streamlines, AMR inputs and composite inputs whose blocks do
+   * not have matching point data arrays are always integrated serially. In
+   * a composite input, each streamline searches the blocks starting from
+   * the first one; thus a seed lying on an interface shared by several
+   * blocks may start in a different block than in serial mode.
+   */
+  vtkSetMacro(ParallelIntegration, bool);
+  vtkGetMacro(ParallelIntegration, bool);
+  vtkBooleanMacro(ParallelIntegration, bool);
+  //@}
+
   enum
   {
     FORWARD,
@@ -383,6 +402,21 @@ protected:
                  double& propagation,
                  vtkIdType& numSteps,
                  double& integrationTime);
+  /**
+   * The parallel algorithm (see ParallelIntegration). It produces the same
+   * output as Integrate() called with a zero propagation, number of steps
+   * and integration time. The interpolator func is used as a prototype for
+   * the per-thread interpolators.
+   */
+  void IntegrateInParallel(vtkPointData *inputData,
+                           vtkPolyData* output,
+                           vtkDataArray* seedSource,
+                           vtkIdList* seedIds,
+                           vtkIntArray* integrationDirections,
+                           vtkAbstractInterpolatedVelocityField* func,
+                           int maxCellSize,
+                           int vecType,
+                           const char *vecFieldName);
   double SimpleIntegrate(double seed[3],
                          double lastPoint[3],
                          double stepSize,
@@ -439,12 +473,15 @@ protected:
   // Compute streamlines only on surface.
   bool SurfaceStreamlines;
 
+  bool ParallelIntegration;
+
   vtkAbstractInterpolatedVelocityField * InterpolatorPrototype;
 
   vtkCompositeDataSet* InputData;
   bool HasMatchingPointAttributes; //does the point data in the multiblocks have the same attributes?
 
   friend class PStreamTracerUtils;
+  friend class vtkStreamTracerIntegrateSeeds;
 
 private:
   vtkStreamTracer(const vtkStreamTracer&) VTK_DELETE_FUNCTION;
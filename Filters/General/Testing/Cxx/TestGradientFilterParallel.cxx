@@ -0,0 +1,203 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGradientFilterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded computation of vtkGradientFilter produces the same
+// output as the serial computation.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkGradientFilter.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "TestDataComparison.h"
+
+#include <cmath>
+
+namespace
+{
+
+const int Res = 12;
+
+// A scalar and a vector field at the given points and at the centers of the
+// cells of the dataset.
+void AddFields(vtkDataSet *dataset)
+{
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("scalars");
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(3);
+  for (vtkIdType i = 0; i < dataset->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    dataset->GetPoint(i, x);
+    scalars->InsertNextValue(sin(0.4 * x[0]) * cos(0.3 * x[1]) + x[2] * x[2]);
+    vectors->InsertNextTuple3(x[1] * x[2], sin(0.5 * x[0]), x[0] - x[1] * x[1]);
+  }
+  dataset->GetPointData()->AddArray(scalars.Get());
+  dataset->GetPointData()->AddArray(vectors.Get());
+
+  vtkNew<vtkFloatArray> cellVectors;
+  cellVectors->SetName("vectors");
+  cellVectors->SetNumberOfComponents(3);
+  for (vtkIdType i = 0; i < dataset->GetNumberOfCells(); ++i)
+  {
+    cellVectors->InsertNextTuple3(cos(0.1 * i), 0.01 * i, sin(0.2 * i));
+  }
+  dataset->GetCellData()->AddArray(cellVectors.Get());
+}
+
+// A wavy surface of quads and triangles, with a polyline and vertices.
+void MakeSurface(vtkPolyData *surface)
+{
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j <= Res; ++j)
+  {
+    for (int i = 0; i <= Res; ++i)
+    {
+      points->InsertNextPoint(i, j + 0.2 * sin(0.7 * i), 0.3 * cos(0.5 * j));
+    }
+  }
+
+  vtkNew<vtkCellArray> polys;
+  const vtkIdType n = Res + 1;
+  for (int j = 0; j < Res; ++j)
+  {
+    for (int i = 0; i < Res; ++i)
+    {
+      vtkIdType p = i + j * n;
+      if (i < Res / 2)
+      {
+        vtkIdType quad[4] = { p, p + 1, p + 1 + n, p + n };
+        polys->InsertNextCell(4, quad);
+      }
+      else
+      {
+        vtkIdType tri0[3] = { p, p + 1, p + 1 + n };
+        vtkIdType tri1[3] = { p, p + 1 + n, p + n };
+        polys->InsertNextCell(3, tri0);
+        polys->InsertNextCell(3, tri1);
+      }
+    }
+  }
+
+  vtkNew<vtkCellArray> lines;
+  lines->InsertNextCell(Res + 1);
+  for (vtkIdType i = 0; i <= Res; ++i)
+  {
+    lines->InsertCellPoint(i);
+  }
+
+  vtkNew<vtkCellArray> verts;
+  for (vtkIdType i = 0; i < 3; ++i)
+  {
+    vtkIdType vert = 5 * i * n + 2;
+    verts->InsertNextCell(1, &vert);
+  }
+
+  surface->SetPoints(points.Get());
+  surface->SetVerts(verts.Get());
+  surface->SetLines(lines.Get());
+  surface->SetPolys(polys.Get());
+  AddFields(surface);
+}
+
+int Compare(vtkDataSet *input, int association, const char *arrayName,
+            int fasterApproximation, const char *name)
+{
+  vtkNew<vtkGradientFilter> serial;
+  vtkNew<vtkGradientFilter> parallel;
+  vtkGradientFilter *filters[2] = { serial.Get(), parallel.Get() };
+  bool vector = (strcmp(arrayName, "vectors") == 0);
+  for (int f = 0; f < 2; ++f)
+  {
+    filters[f]->SetInputData(input);
+    filters[f]->SetInputScalars(association, arrayName);
+    filters[f]->SetFasterApproximation(fasterApproximation);
+    filters[f]->SetComputeDivergence(vector);
+    filters[f]->SetComputeVorticity(vector);
+    filters[f]->SetComputeQCriterion(vector);
+    filters[f]->SetParallelComputation(f);
+    filters[f]->Update();
+  }
+
+  vtkDataSet *expected = serial->GetOutput();
+  vtkDataSet *output = parallel->GetOutput();
+  if (!expected->GetPointData()->GetArray("Gradients") &&
+      !expected->GetCellData()->GetArray("Gradients"))
+  {
+    cerr << "No gradients for " << name << endl;
+    return EXIT_FAILURE;
+  }
+  if (!vtkTest::SameFieldData(expected->GetPointData(),
+                              output->GetPointData(), "point") ||
+      !vtkTest::SameFieldData(expected->GetCellData(),
+                              output->GetCellData(), "cell"))
+  {
+    cerr << "for " << arrayName << " of " << name << " (faster approximation "
+         << fasterApproximation << ")" << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int TestGradientFilterParallel(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  // Tetrahedra
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Res, Res - 2, Res - 4);
+  image->SetOrigin(-3.0, -2.0, -1.0);
+  image->SetSpacing(0.5, 0.4, 0.3);
+  vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+  tetrahedralize->SetInputData(image.Get());
+  tetrahedralize->Update();
+  vtkSmartPointer<vtkUnstructuredGrid> grid =
+    vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->DeepCopy(tetrahedralize->GetOutput());
+  AddFields(grid);
+
+  vtkNew<vtkPolyData> surface;
+  MakeSurface(surface.Get());
+
+  vtkDataSet *inputs[2] = { grid, surface.Get() };
+  const char *names[2] = { "unstructured grid", "polydata" };
+  const int points = vtkDataObject::FIELD_ASSOCIATION_POINTS;
+  const int cells = vtkDataObject::FIELD_ASSOCIATION_CELLS;
+  int status = EXIT_SUCCESS;
+  for (int i = 0; i < 2; ++i)
+  {
+    for (int faster = 0; faster < 2; ++faster)
+    {
+      status |= Compare(inputs[i], points, "scalars", faster, names[i]);
+      status |= Compare(inputs[i], points, "vectors", faster, names[i]);
+      status |= Compare(inputs[i], cells, "vectors", faster, names[i]);
+    }
+  }
+
+  return status;
+}
@@ -0,0 +1,347 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTableBasedClipDataSetParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkTableBasedClipDataSet clips the same cells with and without
+// ParallelClipping, for image data, structured and unstructured grids. The
+// output points and cells are not in the same order, so order independent
+// sums over the output cells, and the numbers of points, are compared.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSphere.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTableBasedClipDataSet.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <map>
+
+namespace
+{
+
+const int Res = 16;
+
+void AddArrays(vtkDataSet *dataSet)
+{
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(dataSet->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < dataSet->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    dataSet->GetPoint(i, x);
+    scalars->SetValue(i, static_cast<float>(x[0] + 2.0 * x[1] - x[2]));
+  }
+  dataSet->GetPointData()->SetScalars(scalars.Get());
+
+  vtkNew<vtkIntArray> cellIndex;
+  cellIndex->SetName("CellIndex");
+  cellIndex->SetNumberOfTuples(dataSet->GetNumberOfCells());
+  for (vtkIdType i = 0; i < dataSet->GetNumberOfCells(); ++i)
+  {
+    cellIndex->SetValue(i, static_cast<int>(i));
+  }
+  dataSet->GetCellData()->AddArray(cellIndex.Get());
+}
+
+// Order independent summary of the output: the number of cells of each type,
+// and the sums over the cells of the cell data and of the mean coordinates
+// and scalars of their points.
+struct Summary
+{
+  std::map<int, vtkIdType> CellTypes;
+  double Sums[5];
+};
+
+bool Summarize(vtkUnstructuredGrid *output, Summary &summary)
+{
+  vtkDataArray *scalars = output->GetPointData()->GetArray("Scalars");
+  vtkDataArray *cellIndex = output->GetCellData()->GetArray("CellIndex");
+  if (!scalars || !cellIndex)
+  {
+    cerr << "Missing output arrays." << endl;
+    return false;
+  }
+  summary.CellTypes.clear();
+  for (int c = 0; c < 5; ++c)
+  {
+    summary.Sums[c] = 0.0;
+  }
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    summary.CellTypes[output->GetCellType(cellId)]++;
+    summary.Sums[4] += cellIndex->GetComponent(cellId, 0);
+    output->GetCellPoints(cellId, ptIds.GetPointer());
+    vtkIdType n = ptIds->GetNumberOfIds();
+    for (vtkIdType i = 0; i < n; ++i)
+    {
+      vtkIdType ptId = ptIds->GetId(i);
+      if (ptId < 0 || ptId >= output->GetNumberOfPoints())
+      {
+        cerr << "Invalid point id " << ptId << endl;
+        return false;
+      }
+      double x[3];
+      output->GetPoint(ptId, x);
+      for (int c = 0; c < 3; ++c)
+      {
+        summary.Sums[c] += x[c] / n;
+      }
+      summary.Sums[3] += scalars->GetComponent(ptId, 0) / n;
+    }
+  }
+  return true;
+}
+
+int Compare(vtkDataSet *input, const char *name)
+{
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(0.37 * Res, 0.41 * Res, 0.29 * Res);
+  plane->SetNormal(1.0, 0.6, 0.3);
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(0.5 * Res, 0.5 * Res, 0.5 * Res);
+  sphere->SetRadius(0.4 * Res);
+
+  for (int test = 0; test < 4; ++test)
+  {
+    vtkNew<vtkTableBasedClipDataSet> serial;
+    vtkNew<vtkTableBasedClipDataSet> parallel;
+    parallel->ParallelClippingOn();
+    vtkTableBasedClipDataSet *clippers[2] = { serial.Get(), parallel.Get() };
+    for (int i = 0; i < 2; ++i)
+    {
+      clippers[i]->SetInputData(input);
+      clippers[i]->GenerateClippedOutputOn();
+      switch (test)
+      {
+        case 0:
+          clippers[i]->SetClipFunction(plane.Get());
+          break;
+        case 1:
+          clippers[i]->SetClipFunction(sphere.Get());
+          clippers[i]->InsideOutOn();
+          break;
+        case 2:
+          clippers[i]->SetValue(0.6 * Res);
+          break;
+        default:
+          clippers[i]->SetValue(0.6 * Res);
+          clippers[i]->InsideOutOn();
+          break;
+      }
+      clippers[i]->Update();
+    }
+
+    vtkUnstructuredGrid *outputs[2][2] = {
+      { serial->GetOutput(), serial->GetClippedOutput() },
+      { parallel->GetOutput(), parallel->GetClippedOutput() } };
+    for (int o = 0; o < 2; ++o)
+    {
+      Summary expected, summary;
+      if (!Summarize(outputs[0][o], expected) ||
+          !Summarize(outputs[1][o], summary))
+      {
+        return EXIT_FAILURE;
+      }
+      bool same = (expected.CellTypes == summary.CellTypes &&
+                   outputs[0][o]->GetNumberOfCells() > 0);
+      for (int c = 0; c < 5; ++c)
+      {
+        same = same && std::abs(expected.Sums[c] - summary.Sums[c]) <=
+          1.0e-6 * (1.0 + std::abs(expected.Sums[c]));
+      }
+      same = same && (outputs[0][o]->GetNumberOfPoints() ==
+                      outputs[1][o]->GetNumberOfPoints());
+      if (!same)
+      {
+        cerr << name << ", test " << test << ", output " << o << ": "
+             << outputs[1][o]->GetNumberOfCells() << " cells and "
+             << outputs[1][o]->GetNumberOfPoints() << " points, expected "
+             << outputs[0][o]->GetNumberOfCells() << " cells and "
+             << outputs[0][o]->GetNumberOfPoints() << " points" << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+// A grid of hexahedra, wedges, pyramids and tetrahedra, with a pentagonal
+// prism that is not clipped with the tables.
+void MakeGrid(vtkUnstructuredGrid *grid)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= Res; ++k)
+  {
+    for (int j = 0; j <= Res; ++j)
+    {
+      for (int i = 0; i <= Res; ++i)
+      {
+        points->InsertNextPoint(i + 0.1 * sin(0.5 * (j + k)), j, k);
+      }
+    }
+  }
+  vtkIdType center = points->GetNumberOfPoints();
+  for (int k = 0; k < Res; ++k)
+  {
+    for (int j = 0; j < Res; ++j)
+    {
+      for (int i = 0; i < Res; ++i)
+      {
+        points->InsertNextPoint(i + 0.5, j + 0.5, k + 0.5);
+      }
+    }
+  }
+  vtkIdType prism = points->GetNumberOfPoints();
+  for (int k = 0; k < 2; ++k)
+  {
+    for (int i = 0; i < 5; ++i)
+    {
+      double angle = 2.0 * vtkMath::Pi() * i / 5;
+      points->InsertNextPoint(0.5 * Res + 2.0 * cos(angle),
+                              0.5 * Res + 2.0 * sin(angle), Res + 1.0 + k);
+    }
+  }
+  grid->SetPoints(points.Get());
+
+  grid->Allocate(6 * Res * Res * Res);
+  const vtkIdType n = Res + 1;
+  for (int k = 0; k < Res; ++k)
+  {
+    for (int j = 0; j < Res; ++j)
+    {
+      for (int i = 0; i < Res; ++i)
+      {
+        vtkIdType p = i + j * n + k * n * n;
+        vtkIdType hex[8] = { p, p + 1, p + 1 + n, p + n, p + n * n,
+                             p + 1 + n * n, p + 1 + n + n * n, p + n + n * n };
+        switch ((i + 2 * j + 3 * k) % 4)
+        {
+          case 0:
+          {
+            vtkIdType wedge0[6] = { hex[0], hex[1], hex[2],
+                                    hex[4], hex[5], hex[6] };
+            vtkIdType wedge1[6] = { hex[0], hex[2], hex[3],
+                                    hex[4], hex[6], hex[7] };
+            grid->InsertNextCell(VTK_WEDGE, 6, wedge0);
+            grid->InsertNextCell(VTK_WEDGE, 6, wedge1);
+            break;
+          }
+          case 1:
+          {
+            // six pyramids around the center of the hexahedron
+            static const int faces[6][4] = { { 0, 3, 2, 1 }, { 4, 5, 6, 7 },
+              { 0, 1, 5, 4 }, { 1, 2, 6, 5 }, { 2, 3, 7, 6 }, { 3, 0, 4, 7 } };
+            for (int f = 0; f < 6; ++f)
+            {
+              vtkIdType pyramid[5] = { hex[faces[f][0]], hex[faces[f][1]],
+                hex[faces[f][2]], hex[faces[f][3]],
+                center + i + j * Res + k * Res * Res };
+              grid->InsertNextCell(VTK_PYRAMID, 5, pyramid);
+            }
+            break;
+          }
+          case 2:
+          {
+            vtkIdType tets[5][4] = {
+              { hex[0], hex[1], hex[3], hex[4] },
+              { hex[1], hex[2], hex[3], hex[6] },
+              { hex[1], hex[4], hex[5], hex[6] },
+              { hex[3], hex[4], hex[6], hex[7] },
+              { hex[1], hex[3], hex[4], hex[6] } };
+            for (int t = 0; t < 5; ++t)
+            {
+              grid->InsertNextCell(VTK_TETRA, 4, tets[t]);
+            }
+            break;
+          }
+          default:
+            grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+            break;
+        }
+      }
+    }
+  }
+  vtkIdType prismIds[10];
+  for (int i = 0; i < 10; ++i)
+  {
+    prismIds[i] = prism + i;
+  }
+  grid->InsertNextCell(VTK_PENTAGONAL_PRISM, 10, prismIds);
+}
+
+}
+
+int TestTableBasedClipDataSetParallel(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Res + 1, Res + 1, Res + 1);
+  AddArrays(image.Get());
+  if (Compare(image.Get(), "Image") != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkImageData> slice;
+  slice->SetDimensions(Res + 1, 1, Res + 1);
+  slice->SetOrigin(0.0, 0.5 * Res, 0.0);
+  AddArrays(slice.Get());
+  if (Compare(slice.Get(), "Slice") != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkStructuredGrid> sgrid;
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= Res; ++k)
+  {
+    for (int j = 0; j <= Res; ++j)
+    {
+      for (int i = 0; i <= Res; ++i)
+      {
+        points->InsertNextPoint(i + 0.2 * sin(0.3 * k), j + 0.1 * i, k);
+      }
+    }
+  }
+  sgrid->SetDimensions(Res + 1, Res + 1, Res + 1);
+  sgrid->SetPoints(points.Get());
+  AddArrays(sgrid.Get());
+  if (Compare(sgrid.Get(), "Structured grid") != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkUnstructuredGrid> ugrid;
+  MakeGrid(ugrid.Get());
+  AddArrays(ugrid.Get());
+  if (Compare(ugrid.Get(), "Unstructured grid") != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -25,6 +25,7 @@
 #include "vtkCellDataToPointData.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
@@ -35,7 +36,11 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLinksTemplate.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
@@ -85,7 +90,7 @@ namespace
   void ComputePointGradientsUG(
     vtkDataSet *structure, data_type *array, data_type *gradients,
     int numberOfInputComponents, data_type* vorticity, data_type* qCriterion,
-    data_type* divergence);
+    data_type* divergence, bool parallel);
 
   int GetCellParametricData(
     vtkIdType pointId, double pointCoord[3], vtkCell *cell, int & subId,
@@ -95,7 +100,7 @@ namespace
   void ComputeCellGradientsUG(
     vtkDataSet *structure, data_type *array, data_type *gradients,
     int numberOfInputComponents, data_type* vorticity, data_type* qCriterion,
-    data_type* divergence);
+    data_type* divergence, bool parallel);
 
   // Functions for image data and structured grids
   template<class Grid, class data_type>
@@ -150,6 +155,7 @@ vtkGradientFilter::vtkGradientFilter()
   this->ComputeDivergence = 0;
   this->ComputeVorticity = 0;
   this->ComputeQCriterion = 0;
+  this->ParallelComputation = 0;
   this->SetInputScalars(vtkDataObject::FIELD_ASSOCIATION_POINTS_THEN_CELLS,
                         vtkDataSetAttributes::SCALARS);
 }
@@ -181,6 +187,7 @@ void vtkGradientFilter::PrintSelf(ostream &os, vtkIndent indent)
   os << indent << "ComputeDivergence:"  << this->ComputeDivergence << endl;
   os << indent << "ComputeVorticity:" << this->ComputeVorticity << endl;
   os << indent << "ComputeQCriterion:" << this->ComputeQCriterion << endl;
+  os << indent << "ParallelComputation:" << this->ParallelComputation << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -395,6 +402,11 @@ int vtkGradientFilter::ComputeUnstructuredGridGradient(
     }
   }
 
+  // Only the unstructured grids and polydatas are known to answer
+  // GetCell() and GetPointCells() safely from several threads.
+  bool parallel = this->ParallelComputation &&
+    (input->IsA("vtkUnstructuredGrid") || input->IsA("vtkPolyData"));
+
   if (fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS)
   {
     if (!this->FasterApproximation)
@@ -412,7 +424,8 @@ int vtkGradientFilter::ComputeUnstructuredGridGradient(
                            (qCriterion == NULL ? NULL :
                             static_cast<VTK_TT *>(qCriterion->GetVoidPointer(0))),
                            (divergence == NULL ? NULL :
-                            static_cast<VTK_TT *>(divergence->GetVoidPointer(0)))));
+                            static_cast<VTK_TT *>(divergence->GetVoidPointer(0))),
+                           parallel));
       }
       if(gradients)
       {
@@ -480,7 +493,8 @@ int vtkGradientFilter::ComputeUnstructuredGridGradient(
             (qCriterion == NULL ? NULL :
              static_cast<VTK_TT *>(cellQCriterion->GetVoidPointer(0))),
             (divergence == NULL ? NULL :
-             static_cast<VTK_TT *>(cellDivergence->GetVoidPointer(0)))));
+             static_cast<VTK_TT *>(cellDivergence->GetVoidPointer(0))),
+            parallel));
       }
 
       // We need to convert cell Array to points Array.
@@ -561,7 +575,8 @@ int vtkGradientFilter::ComputeUnstructuredGridGradient(
                          (qCriterion == NULL ? NULL :
                           static_cast<VTK_TT *>(qCriterion->GetVoidPointer(0))),
                          (divergence == NULL ? NULL :
-                          static_cast<VTK_TT *>(divergence->GetVoidPointer(0)))));
+                          static_cast<VTK_TT *>(divergence->GetVoidPointer(0))),
+                         parallel));
     }
 
     if(gradients)
@@ -755,98 +770,166 @@ int vtkGradientFilter::ComputeRegularGridGradient(
 
 namespace {
 //-----------------------------------------------------------------------------
+  // Computes the gradients at a range of points from the derivatives of the
+  // cells using them. Each thread has its own cell and id list. If Links is
+  // set, the cells of a point are read from it, otherwise from
+  // GetPointCells().
   template<class data_type>
-  void ComputePointGradientsUG(
-    vtkDataSet *structure, data_type *array, data_type *gradients,
-    int numberOfInputComponents, data_type* vorticity, data_type* qCriterion,
-    data_type* divergence)
+  struct PointGradientsUG
   {
-    vtkNew<vtkIdList> currentPoint;
-    currentPoint->SetNumberOfIds(1);
-    vtkNew<vtkIdList> cellsOnPoint;
-
-    vtkIdType numpts = structure->GetNumberOfPoints();
+    vtkDataSet *Structure;
+    vtkStaticCellLinksTemplate<vtkIdType> *Links;
+    data_type *Array;
+    data_type *Gradients;
+    int NumberOfInputComponents;
+    data_type *Vorticity;
+    data_type *QCriterion;
+    data_type *Divergence;
+
+    vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+    vtkSMPThreadLocalObject<vtkIdList> CellsOnPoint;
+    vtkSMPThreadLocal<std::vector<data_type> > G;
+    vtkSMPThreadLocal<std::vector<double> > Values;
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      vtkGenericCell *cell = this->Cell.Local();
+      vtkIdList *cellsOnPoint = this->CellsOnPoint.Local();
+      std::vector<data_type> &g = this->G.Local();
+      std::vector<double> &values = this->Values.Local();
 
-    int numberOfOutputComponents = 3*numberOfInputComponents;
-    std::vector<data_type> g(numberOfOutputComponents);
+      int numberOfInputComponents = this->NumberOfInputComponents;
+      int numberOfOutputComponents = 3*numberOfInputComponents;
+      g.resize(numberOfOutputComponents);
 
-    for (vtkIdType point = 0; point < numpts; point++)
-    {
-      currentPoint->SetId(0, point);
-      double pointcoords[3];
-      structure->GetPoint(point, pointcoords);
-      // Get all cells touching this point.
-      structure->GetCellNeighbors(-1, currentPoint.GetPointer(),
-                                  cellsOnPoint.GetPointer());
-      vtkIdType numCellNeighbors = cellsOnPoint->GetNumberOfIds();
-      vtkIdType numValidCellNeighbors = 0;
-
-      for(int i=0;i<numberOfOutputComponents;i++)
+      for (vtkIdType point = begin; point < end; point++)
       {
-        g[i] = 0;
-      }
+        double pointcoords[3];
+        this->Structure->GetPoint(point, pointcoords);
+        // Get all cells touching this point, in increasing order.
+        if (this->Links)
+        {
+          vtkIdType numCells = this->Links->GetNumberOfCells(point);
+          const vtkIdType *cells = this->Links->GetCells(point);
+          cellsOnPoint->SetNumberOfIds(numCells);
+          for (vtkIdType i = 0; i < numCells; i++)
+          {
+            cellsOnPoint->SetId(i, cells[numCells - 1 - i]);
+          }
+        }
+        else
+        {
+          this->Structure->GetPointCells(point, cellsOnPoint);
+        }
+        vtkIdType numCellNeighbors = cellsOnPoint->GetNumberOfIds();
 
-      // Iterate on all cells and find all points connected to current point
-      // by an edge.
-      for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
-      {
-        vtkCell *cell = structure->GetCell(cellsOnPoint->GetId(neighbor));
-        int subId;
-        double parametricCoord[3];
-        if(GetCellParametricData(point, pointcoords, cell,
-                                 subId, parametricCoord))
+        for(int i=0;i<numberOfOutputComponents;i++)
+        {
+          g[i] = 0;
+        }
+
+        // Iterate on all cells and find all points connected to current point
+        // by an edge.
+        for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
         {
-          numValidCellNeighbors++;
-          for(int InputComponent=0;InputComponent<numberOfInputComponents;InputComponent++)
+          this->Structure->GetCell(cellsOnPoint->GetId(neighbor), cell);
+          int subId;
+          double parametricCoord[3];
+          if(GetCellParametricData(point, pointcoords, cell,
+                                   subId, parametricCoord))
           {
             int NumberOfCellPoints = cell->GetNumberOfPoints();
-            std::vector<double> values(NumberOfCellPoints);
-            // Get values of Array at cell points.
-            for (int i = 0; i < NumberOfCellPoints; i++)
+            values.resize(NumberOfCellPoints);
+            for(int InputComponent=0;InputComponent<numberOfInputComponents;InputComponent++)
             {
-              values[i] = static_cast<double>(
-                array[cell->GetPointId(i)*numberOfInputComponents+InputComponent]);
-            }
-
-            double derivative[3];
-            // Get derivative of cell at point.
-            cell->Derivatives(subId, parametricCoord, &values[0], 1, derivative);
-
-            g[InputComponent*3] += static_cast<data_type>(derivative[0]);
-            g[InputComponent*3+1] += static_cast<data_type>(derivative[1]);
-            g[InputComponent*3+2] += static_cast<data_type>(derivative[2]);
-          } // iterating over Components
-        } // if(GetCellParametricData())
-      } // iterating over neighbors
-
-      if (numCellNeighbors > 0)
-      {
-        for(int i=0;i<3*numberOfInputComponents;i++)
+              // Get values of Array at cell points.
+              for (int i = 0; i < NumberOfCellPoints; i++)
+              {
+                values[i] = static_cast<double>(
+                  this->Array[cell->GetPointId(i)*numberOfInputComponents+InputComponent]);
+              }
+
+              double derivative[3];
+              // Get derivative of cell at point.
+              cell->Derivatives(subId, parametricCoord, &values[0], 1, derivative);
+
+              g[InputComponent*3] += static_cast<data_type>(derivative[0]);
+              g[InputComponent*3+1] += static_cast<data_type>(derivative[1]);
+              g[InputComponent*3+2] += static_cast<data_type>(derivative[2]);
+            } // iterating over Components
+          } // if(GetCellParametricData())
+        } // iterating over neighbors
+
+        if (numCellNeighbors > 0)
         {
-          g[i] /= numCellNeighbors;
+          for(int i=0;i<3*numberOfInputComponents;i++)
+          {
+            g[i] /= numCellNeighbors;
+          }
         }
-      }
 
-      if(vorticity)
-      {
-        ComputeVorticityFromGradient(&g[0], vorticity+3*point);
-      }
-      if(qCriterion)
-      {
-        ComputeQCriterionFromGradient(&g[0], qCriterion+point);
-      }
-      if(divergence)
-      {
-        ComputeDivergenceFromGradient(&g[0], divergence+point);
-      }
-      if(gradients)
-      {
-        for(int i=0;i<numberOfOutputComponents;i++)
+        if(this->Vorticity)
         {
-          gradients[point*numberOfOutputComponents+i] = g[i];
+          ComputeVorticityFromGradient(&g[0], this->Vorticity+3*point);
         }
-      }
-    }  // iterating over points in grid
+        if(this->QCriterion)
+        {
+          ComputeQCriterionFromGradient(&g[0], this->QCriterion+point);
+        }
+        if(this->Divergence)
+        {
+          ComputeDivergenceFromGradient(&g[0], this->Divergence+point);
+        }
+        if(this->Gradients)
+        {
+          for(int i=0;i<numberOfOutputComponents;i++)
+          {
+            this->Gradients[point*numberOfOutputComponents+i] = g[i];
+          }
+        }
+      }  // iterating over points in grid
+    }
+  };
+
+//-----------------------------------------------------------------------------
+  template<class data_type>
+  void ComputePointGradientsUG(
+    vtkDataSet *structure, data_type *array, data_type *gradients,
+    int numberOfInputComponents, data_type* vorticity, data_type* qCriterion,
+    data_type* divergence, bool parallel)
+  {
+    PointGradientsUG<data_type> pointGradients;
+    pointGradients.Structure = structure;
+    pointGradients.Links = NULL;
+    pointGradients.Array = array;
+    pointGradients.Gradients = gradients;
+    pointGradients.NumberOfInputComponents = numberOfInputComponents;
+    pointGradients.Vorticity = vorticity;
+    pointGradients.QCriterion = qCriterion;
+    pointGradients.Divergence = divergence;
+
+    vtkIdType numpts = structure->GetNumberOfPoints();
+    if (!parallel || numpts == 0)
+    {
+      pointGradients(0, numpts);
+      return;
+    }
+
+    // Static links are cheaper to build than the cell links of an
+    // unstructured grid. Those of a polydata (and its cells), built by
+    // GetPointCells(), are then only read by the threads.
+    vtkStaticCellLinksTemplate<vtkIdType> links;
+    if (vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(structure))
+    {
+      links.BuildLinks(grid);
+      pointGradients.Links = &links;
+    }
+    else
+    {
+      vtkNew<vtkIdList> cellIds;
+      structure->GetPointCells(0, cellIds.GetPointer());
+    }
+    vtkSMPTools::For(0, numpts, pointGradients);
   }
 
 //-----------------------------------------------------------------------------
@@ -881,66 +964,117 @@ namespace {
   }
 
 //-----------------------------------------------------------------------------
+  // Computes the gradients of a range of cells at their parametric centers.
+  // Each thread has its own cell.
   template<class data_type>
-    void ComputeCellGradientsUG(
-      vtkDataSet *structure, data_type *array, data_type *gradients,
-      int numberOfInputComponents, data_type* vorticity,
-      data_type* qCriterion, data_type* divergence)
+  struct CellGradientsUG
   {
-    vtkIdType numcells = structure->GetNumberOfCells();
-    std::vector<double> values(8);
-    std::vector<data_type> cellGradients(3*numberOfInputComponents);
-    for (vtkIdType cellid = 0; cellid < numcells; cellid++)
+    vtkDataSet *Structure;
+    data_type *Array;
+    data_type *Gradients;
+    int NumberOfInputComponents;
+    data_type *Vorticity;
+    data_type *QCriterion;
+    data_type *Divergence;
+
+    vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+    vtkSMPThreadLocal<std::vector<data_type> > CellGradients;
+    vtkSMPThreadLocal<std::vector<double> > Values;
+
+    void operator()(vtkIdType begin, vtkIdType end)
     {
-      vtkCell *cell = structure->GetCell(cellid);
-
-      int subId;
-      double cellCenter[3];
-      subId = cell->GetParametricCenter(cellCenter);
+      vtkGenericCell *cell = this->Cell.Local();
+      std::vector<data_type> &cellGradients = this->CellGradients.Local();
+      std::vector<double> &values = this->Values.Local();
 
-      int numpoints = cell->GetNumberOfPoints();
-      if(static_cast<size_t>(numpoints) > values.size())
+      int numberOfInputComponents = this->NumberOfInputComponents;
+      cellGradients.resize(3*numberOfInputComponents);
+      if(values.size() < 8)
       {
-        values.resize(numpoints);
+        values.resize(8);
       }
-      double derivative[3];
-      for(int inputComponent=0;inputComponent<numberOfInputComponents;
-          inputComponent++)
+
+      for (vtkIdType cellid = begin; cellid < end; cellid++)
       {
-        for (int i = 0; i < numpoints; i++)
+        this->Structure->GetCell(cellid, cell);
+
+        int subId;
+        double cellCenter[3];
+        subId = cell->GetParametricCenter(cellCenter);
+
+        int numpoints = cell->GetNumberOfPoints();
+        if(static_cast<size_t>(numpoints) > values.size())
         {
-          values[i] = static_cast<double>(
-            array[cell->GetPointId(i)*numberOfInputComponents+inputComponent]);
+          values.resize(numpoints);
         }
+        double derivative[3];
+        for(int inputComponent=0;inputComponent<numberOfInputComponents;
+            inputComponent++)
+        {
+          for (int i = 0; i < numpoints; i++)
+          {
+            values[i] = static_cast<double>(
+              this->Array[cell->GetPointId(i)*numberOfInputComponents+inputComponent]);
+          }
 
-        cell->Derivatives(subId, cellCenter, &values[0], 1, derivative);
-        cellGradients[inputComponent*3] =
-          static_cast<data_type>(derivative[0]);
-        cellGradients[inputComponent*3+1] =
-          static_cast<data_type>(derivative[1]);
-        cellGradients[inputComponent*3+2] =
-          static_cast<data_type>(derivative[2]);
-      }
-      if(gradients)
-      {
-        for(int i=0;i<3*numberOfInputComponents;i++)
+          cell->Derivatives(subId, cellCenter, &values[0], 1, derivative);
+          cellGradients[inputComponent*3] =
+            static_cast<data_type>(derivative[0]);
+          cellGradients[inputComponent*3+1] =
+            static_cast<data_type>(derivative[1]);
+          cellGradients[inputComponent*3+2] =
+            static_cast<data_type>(derivative[2]);
+        }
+        if(this->Gradients)
         {
-          gradients[cellid*3*numberOfInputComponents+i] = cellGradients[i];
+          for(int i=0;i<3*numberOfInputComponents;i++)
+          {
+            this->Gradients[cellid*3*numberOfInputComponents+i] = cellGradients[i];
+          }
+        }
+        if(this->Vorticity)
+        {
+          ComputeVorticityFromGradient(&cellGradients[0], this->Vorticity+3*cellid);
+        }
+        if(this->QCriterion)
+        {
+          ComputeQCriterionFromGradient(&cellGradients[0], this->QCriterion+cellid);
+        }
+        if(this->Divergence)
+        {
+          ComputeDivergenceFromGradient(&cellGradients[0], this->Divergence+cellid);
         }
       }
-      if(vorticity)
-      {
-        ComputeVorticityFromGradient(&cellGradients[0], vorticity+3*cellid);
-      }
-      if(qCriterion)
-      {
-        ComputeQCriterionFromGradient(&cellGradients[0], qCriterion+cellid);
-      }
-      if(divergence)
-      {
-        ComputeDivergenceFromGradient(&cellGradients[0], divergence+cellid);
-      }
     }
+  };
+
+//-----------------------------------------------------------------------------
+  template<class data_type>
+    void ComputeCellGradientsUG(
+      vtkDataSet *structure, data_type *array, data_type *gradients,
+      int numberOfInputComponents, data_type* vorticity,
+      data_type* qCriterion, data_type* divergence, bool parallel)
+  {
+    CellGradientsUG<data_type> cellGradients;
+    cellGradients.Structure = structure;
+    cellGradients.Array = array;
+    cellGradients.Gradients = gradients;
+    cellGradients.NumberOfInputComponents = numberOfInputComponents;
+    cellGradients.Vorticity = vorticity;
+    cellGradients.QCriterion = qCriterion;
+    cellGradients.Divergence = divergence;
+
+    vtkIdType numcells = structure->GetNumberOfCells();
+    if (!parallel || numcells == 0)
+    {
+      cellGradients(0, numcells);
+      return;
+    }
+
+    // The cells of a polydata are built by the first GetCell().
+    vtkNew<vtkGenericCell> cell;
+    structure->GetCell(0, cell.GetPointer());
+    vtkSMPTools::For(0, numcells, cellGradients);
   }
 
 //-----------------------------------------------------------------------------
@@ -31,6 +31,9 @@
  * output tuple will be {du/dx, du/dy, du/dz, dv/dx, dv/dy, dv/dz, dw/dx,
  * dw/dy, dw/dz} for an input array {u, v, w}. There are also the options
  * to additionally compute the vorticity and Q criterion of a vector field.
+ *
+ * The gradients of a vtkUnstructuredGrid or a vtkPolyData can be computed
+ * with several threads (see ParallelComputation).
 */
 
 #ifndef vtkGradientFilter_h
@@ -161,6 +164,19 @@ public:
   vtkBooleanMacro(ComputeQCriterion, int);
   //@}
 
+  //@{
+  /**
+   * When this flag is on (default is off), the gradients of a
+   * vtkUnstructuredGrid or a vtkPolyData are computed with vtkSMPTools,
+   * over ranges of points or cells, each thread using its own cell and id
+   * lists. The cells of the points of an unstructured grid are read from
+   * static cell links. The results are the same as with a single thread.
+   */
+  vtkSetMacro(ParallelComputation, int);
+  vtkGetMacro(ParallelComputation, int);
+  vtkBooleanMacro(ParallelComputation, int);
+  //@}
+
 protected:
   vtkGradientFilter();
   ~vtkGradientFilter() VTK_OVERRIDE;
@@ -252,6 +268,12 @@ protected:
    */
   int ComputeVorticity;
 
+  /**
+   * Flag to indicate that the gradients of unstructured grids and polydatas
+   * are computed with several threads. By default ParallelComputation is off.
+   */
+  int ParallelComputation;
+
 private:
   vtkGradientFilter(const vtkGradientFilter &) VTK_DELETE_FUNCTION;
   void operator=(const vtkGradientFilter &) VTK_DELETE_FUNCTION;
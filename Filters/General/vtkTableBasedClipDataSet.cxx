@@ -57,9 +57,18 @@
 #include "vtkRectilinearGrid.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
 
 #include "vtkTableBasedClipCases.h"
 
+#include "vtkArrayListTemplate.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 vtkStandardNewMacro( vtkTableBasedClipDataSet );
 vtkCxxSetObjectMacro( vtkTableBasedClipDataSet, ClipFunction, vtkImplicitFunction );
 
@@ -1597,6 +1606,692 @@ inline void GetPoint( double * pt, const double * X, const double * Y,
 // ============================================================================
 
 
+// ============================================================================
+// ===================== parallel clipping helpers (begin) ====================
+// ============================================================================
+
+
+namespace
+{
+
+// Evaluate the implicit function at the points of the input.
+struct TableBasedClipperEvaluateFunction
+{
+  vtkDataSet * Input;
+  vtkImplicitFunction * Function;
+  vtkDoubleArray * Scalars;
+
+  void operator() ( vtkIdType begin, vtkIdType end )
+  {
+    double x[3];
+    for ( vtkIdType i = begin; i < end; i ++ )
+    {
+      this->Input->GetPoint( i, x );
+      this->Scalars->SetValue( i, this->Function->FunctionValue( x ) );
+    }
+  }
+};
+
+// The cells are processed in batches of a fixed size, independent of the
+// number of threads, so that the output is deterministic.
+const vtkIdType TableBasedClipperBatchSize = 1000;
+
+// An output point of a clipped shape: a vertex of the input cell (Id0), a
+// point on an edge of the input cell (Id0 < Id1), or a centroid point of the
+// cell (Id0 being its index N0 - N3).
+enum { TBC_VERTEX, TBC_EDGE, TBC_CENTROID };
+struct TableBasedClipperPointRef
+{
+  int       Kind;
+  vtkIdType Id0;
+  vtkIdType Id1;
+};
+
+// An input edge cut by the iso-value, the key of an output edge point whose
+// parametric coordinate from Pnt0 is T.
+struct TableBasedClipperEdge
+{
+  vtkIdType Pnt0;
+  vtkIdType Pnt1;
+  double    T;
+
+  bool operator < ( const TableBasedClipperEdge & edge ) const
+  {
+    return this->Pnt0 < edge.Pnt0 || ( this->Pnt0 == edge.Pnt0 && this->Pnt1 < edge.Pnt1 );
+  }
+  bool operator == ( const TableBasedClipperEdge & edge ) const
+  {
+    return this->Pnt0 == edge.Pnt0 && this->Pnt1 == edge.Pnt1;
+  }
+};
+
+typedef const int TableBasedClipperEdgeIdxs[2];
+
+// Get the clip case (shapes, number of shapes and vertices of the edges) of a
+// cell, or return false if the cell type is not supported by the tables.
+bool GetTableBasedClipperCase( int cellType, int caseIndx,
+                               const unsigned char *& thisCase, int & nOutputs,
+                               TableBasedClipperEdgeIdxs *& edgeVtxs )
+{
+  int startIdx = 0;
+  switch ( cellType )
+  {
+    case VTK_TETRA:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesTet[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesTet[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTet[ caseIndx ];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::TetVerticesFromEdges;
+      return true;
+
+    case VTK_PYRAMID:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesPyr[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesPyr[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPyr[ caseIndx ];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::PyramidVerticesFromEdges;
+      return true;
+
+    case VTK_WEDGE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesWdg[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesWdg[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesWdg[ caseIndx ];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::WedgeVerticesFromEdges;
+      return true;
+
+    case VTK_HEXAHEDRON:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesHex[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesHex[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[ caseIndx ];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges;
+      return true;
+
+    case VTK_VOXEL:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesVox[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesVox[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVox[ caseIndx ];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::VoxVerticesFromEdges;
+      return true;
+
+    case VTK_TRIANGLE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesTri[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesTri[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTri[ caseIndx ];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::TriVerticesFromEdges;
+      return true;
+
+    case VTK_QUAD:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesQua[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesQua[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[ caseIndx ];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::QuadVerticesFromEdges;
+      return true;
+
+    case VTK_PIXEL:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesPix[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesPix[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPix[ caseIndx ];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::PixelVerticesFromEdges;
+      return true;
+
+    case VTK_LINE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesLin[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesLin[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesLin[ caseIndx ];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::LineVerticesFromEdges;
+      return true;
+
+    case VTK_VERTEX:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesVtx[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesVtx[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVtx[ caseIndx ];
+      edgeVtxs = NULL;
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+// Walk the clip case of a cell (of type cellType and points pts), calling
+// visitor.AddShape( vtkType, nPts, refs ) for each output cell on the kept
+// side and visitor.AddCentroid( index, nPts, refs ) for each centroid point.
+// Return false if the cell can not be clipped with the tables.
+template < typename VisitorT >
+bool ClipTableBasedCell( int cellType, vtkIdType nPts, const vtkIdType * pts,
+                         const double * diffs, int insideOut,
+                         VisitorT & visitor )
+{
+  int caseIndx = 0;
+  for ( vtkIdType j = 0; j < nPts; j ++ )
+  {
+    caseIndx |= (  ( diffs[ pts[j] ] >= 0.0 ) ? 1 : 0  ) << j;
+  }
+
+  const unsigned char * thisCase = NULL;
+  int nOutputs = 0;
+  TableBasedClipperEdgeIdxs * edgeVtxs = NULL;
+  if ( !GetTableBasedClipperCase( cellType, caseIndx,
+                                  thisCase, nOutputs, edgeVtxs ) )
+  {
+    return false;
+  }
+
+  TableBasedClipperPointRef refs[8];
+  for ( int i = 0; i < nOutputs; i ++ )
+  {
+    int nCellPts = 0;
+    int theColor = -1;
+    int intrpIdx = -1;
+    int vtkType  = VTK_EMPTY_CELL;
+    unsigned char theShape = *thisCase ++;
+
+    switch ( theShape )
+    {
+      case ST_HEX: nCellPts = 8; vtkType = VTK_HEXAHEDRON; break;
+      case ST_WDG: nCellPts = 6; vtkType = VTK_WEDGE; break;
+      case ST_PYR: nCellPts = 5; vtkType = VTK_PYRAMID; break;
+      case ST_TET: nCellPts = 4; vtkType = VTK_TETRA; break;
+      case ST_QUA: nCellPts = 4; vtkType = VTK_QUAD; break;
+      case ST_TRI: nCellPts = 3; vtkType = VTK_TRIANGLE; break;
+      case ST_LIN: nCellPts = 2; vtkType = VTK_LINE; break;
+      case ST_VTX: nCellPts = 1; vtkType = VTK_VERTEX; break;
+      case ST_PNT: intrpIdx = *thisCase ++; break;
+    }
+    theColor = *thisCase ++;
+    if ( theShape == ST_PNT )
+    {
+      nCellPts = *thisCase ++;
+    }
+
+    if ( (!insideOut && theColor == COLOR0 ) ||
+         ( insideOut && theColor == COLOR1 )
+       )
+    {
+      // We don't want this one; it's the wrong side.
+      thisCase += nCellPts;
+      continue;
+    }
+
+    for ( int p = 0; p < nCellPts; p ++ )
+    {
+      unsigned char pntIndex = *thisCase ++;
+      if ( pntIndex <= P7 )
+      {
+        refs[p].Kind = TBC_VERTEX;
+        refs[p].Id0  = pts[ pntIndex ];
+      }
+      else
+      if ( pntIndex >= EA && pntIndex <= EL )
+      {
+        vtkIdType pnt1 = pts[ edgeVtxs[ pntIndex - EA ][0] ];
+        vtkIdType pnt2 = pts[ edgeVtxs[ pntIndex - EA ][1] ];
+        refs[p].Kind = TBC_EDGE;
+        refs[p].Id0  = ( pnt1 < pnt2 ? pnt1 : pnt2 );
+        refs[p].Id1  = ( pnt1 < pnt2 ? pnt2 : pnt1 );
+      }
+      else
+      {
+        refs[p].Kind = TBC_CENTROID;
+        refs[p].Id0  = pntIndex - N0;
+      }
+    }
+
+    if ( theShape == ST_PNT )
+    {
+      visitor.AddCentroid( intrpIdx, nCellPts, refs );
+    }
+    else
+    {
+      visitor.AddShape( vtkType, nCellPts, refs );
+    }
+  }
+
+  return true;
+}
+
+// The cells of the input: those of an unstructured grid, or the hexahedra
+// (quads if one of the dimensions is 1) of a structured dataset.
+struct TableBasedClipperCells
+{
+  vtkUnstructuredGrid * Grid;
+  int Dims[3];
+  int CellDims[3];
+  int Axes[3];
+  int CellType;
+  int NumberOfCellPoints;
+
+  // Return the type and the points of a cell; buffer is used for the points
+  // of the cells of structured datasets, and ptIds for those of unstructured
+  // grids whose connectivity cannot be read in place.
+  int GetCell( vtkIdType cellId, vtkIdType & nPts, const vtkIdType *& pts,
+               vtkIdType buffer[8], vtkIdList * ptIds ) const
+  {
+    if ( this->Grid )
+    {
+      this->Grid->GetCellPoints( cellId, nPts, pts, ptIds );
+      return this->Grid->GetCellType( cellId );
+    }
+
+    static const int shiftLUT[3][8] = { { 0, 1, 1, 0, 0, 1, 1, 0 },
+                                        { 0, 0, 1, 1, 0, 0, 1, 1 },
+                                        { 0, 0, 0, 0, 1, 1, 1, 1 } };
+    vtkIdType cellIJK[3];
+    cellIJK[0] = cellId % this->CellDims[0];
+    cellIJK[1] = ( cellId / this->CellDims[0] ) % this->CellDims[1];
+    cellIJK[2] = cellId / ( this->CellDims[0] * this->CellDims[1] );
+    for ( int j = 0; j < this->NumberOfCellPoints; j ++ )
+    {
+      vtkIdType pntIJK[3];
+      for ( int a = 0; a < 3; a ++ )
+      {
+        int axis = this->Axes[a];
+        pntIJK[ axis ] = cellIJK[ axis ] + shiftLUT[a][j];
+      }
+      buffer[j] = pntIJK[0] + ( pntIJK[1] + pntIJK[2] *
+                  static_cast < vtkIdType > ( this->Dims[1] ) ) * this->Dims[0];
+    }
+    nPts = this->NumberOfCellPoints;
+    pts  = buffer;
+    return this->CellType;
+  }
+};
+
+// The coordinates of the input points: explicit, or given by one coordinate
+// array per axis for image data and rectilinear grids.
+struct TableBasedClipperPoints
+{
+  vtkPoints * Points;
+  std::vector < double > Coords[3];
+  vtkIdType Dims[2];
+
+  void GetPoint( vtkIdType id, double x[3] ) const
+  {
+    if ( this->Points )
+    {
+      this->Points->GetPoint( id, x );
+    }
+    else
+    {
+      x[0] = this->Coords[0][ id % this->Dims[0] ];
+      x[1] = this->Coords[1][ ( id / this->Dims[0] ) % this->Dims[1] ];
+      x[2] = this->Coords[2][ id / ( this->Dims[0] * this->Dims[1] ) ];
+    }
+  }
+};
+
+// The output of the two passes over a batch of cells.
+struct TableBasedClipperBatch
+{
+  vtkIdType NumberOfCells;
+  vtkIdType ConnectivitySize;
+  vtkIdType NumberOfCentroids;
+  vtkIdType CellOffset;
+  vtkIdType ConnectivityOffset;
+  vtkIdType CentroidOffset;
+  std::vector < TableBasedClipperEdge > Edges;
+  std::vector < vtkIdType > Points;
+  std::vector < vtkIdType > Specials;
+
+  TableBasedClipperBatch() : NumberOfCells( 0 ), ConnectivitySize( 0 ),
+    NumberOfCentroids( 0 ), CellOffset( 0 ), ConnectivityOffset( 0 ),
+    CentroidOffset( 0 )
+  {
+  }
+};
+
+// Classify the points: the difference to the iso-value.
+struct TableBasedClipperClassifyPoints
+{
+  vtkDataArray * ClipArray;
+  double IsoValue;
+  double * Diffs;
+
+  void operator() ( vtkIdType begin, vtkIdType end )
+  {
+    for ( vtkIdType i = begin; i < end; i ++ )
+    {
+      this->Diffs[i] = this->ClipArray->GetComponent( i, 0 ) - this->IsoValue;
+    }
+  }
+};
+
+// First pass: count the output cells and centroids of each batch, and
+// collect the input points used by them, the keys of its edge points and its
+// cells that can not be clipped with the tables.
+struct TableBasedClipperCountVisitor
+{
+  TableBasedClipperBatch * Batch;
+  const double * Diffs;
+
+  void AddPoints( int nPts, const TableBasedClipperPointRef * refs )
+  {
+    for ( int p = 0; p < nPts; p ++ )
+    {
+      if ( refs[p].Kind == TBC_VERTEX )
+      {
+        this->Batch->Points.push_back( refs[p].Id0 );
+      }
+      else if ( refs[p].Kind == TBC_EDGE )
+      {
+        TableBasedClipperEdge edge;
+        edge.Pnt0 = refs[p].Id0;
+        edge.Pnt1 = refs[p].Id1;
+        double diff0 = this->Diffs[ edge.Pnt0 ];
+        edge.T = diff0 / ( diff0 - this->Diffs[ edge.Pnt1 ] );
+        this->Batch->Edges.push_back( edge );
+      }
+    }
+  }
+
+  void AddShape( int, int nPts, const TableBasedClipperPointRef * refs )
+  {
+    this->Batch->NumberOfCells ++;
+    this->Batch->ConnectivitySize += nPts + 1;
+    this->AddPoints( nPts, refs );
+  }
+
+  void AddCentroid( int, int nPts, const TableBasedClipperPointRef * refs )
+  {
+    this->Batch->NumberOfCentroids ++;
+    this->AddPoints( nPts, refs );
+  }
+};
+
+struct TableBasedClipperCount
+{
+  const TableBasedClipperCells * Cells;
+  const double * Diffs;
+  int InsideOut;
+  vtkIdType NumberOfCells;
+  TableBasedClipperBatch * Batches;
+
+  void operator() ( vtkIdType begin, vtkIdType end )
+  {
+    vtkIdType nPts, buffer[8];
+    const vtkIdType * pts;
+    vtkNew<vtkIdList> ptIds;
+    for ( vtkIdType b = begin; b < end; b ++ )
+    {
+      TableBasedClipperCountVisitor visitor;
+      visitor.Batch = this->Batches + b;
+      visitor.Diffs = this->Diffs;
+      vtkIdType lastCell = std::min( ( b + 1 ) * TableBasedClipperBatchSize,
+                                     this->NumberOfCells );
+      for ( vtkIdType i = b * TableBasedClipperBatchSize; i < lastCell; i ++ )
+      {
+        int cellType = this->Cells->GetCell( i, nPts, pts, buffer,
+                                             ptIds.GetPointer() );
+        if ( !ClipTableBasedCell( cellType, nPts, pts, this->Diffs,
+                                  this->InsideOut, visitor ) )
+        {
+          visitor.Batch->Specials.push_back( i );
+        }
+      }
+      // The edge points and the input points of a batch are merged in the
+      // serial part anyway; sorting them here keeps that part short.
+      std::sort( visitor.Batch->Edges.begin(), visitor.Batch->Edges.end() );
+      visitor.Batch->Edges.erase( std::unique( visitor.Batch->Edges.begin(),
+                                               visitor.Batch->Edges.end() ),
+                                  visitor.Batch->Edges.end() );
+      std::vector < vtkIdType > & points = visitor.Batch->Points;
+      std::sort( points.begin(), points.end() );
+      points.erase( std::unique( points.begin(), points.end() ),
+                    points.end() );
+    }
+  }
+};
+
+// Second pass: write the output cells of each batch at its offsets, and the
+// definitions (number and ids of the output points) of its centroid points.
+struct TableBasedClipperGenerateVisitor
+{
+  const vtkIdType * PointMap;
+  const TableBasedClipperEdge * EdgesBegin;
+  const TableBasedClipperEdge * EdgesEnd;
+  vtkIdType NumberOfKeptPoints;
+  vtkIdType CentroidStart;
+  vtkIdType CellId;
+  vtkIdType OutCellId;
+  vtkIdType Location;
+  vtkIdType CentroidId;
+  vtkIdType IntrpIds[4];
+  vtkIdType * Connectivity;
+  vtkIdType * Locations;
+  unsigned char * Types;
+  vtkIdType * OriginalCellIds;
+  vtkIdType * Centroids;
+
+  vtkIdType GetOutputId( const TableBasedClipperPointRef & ref ) const
+  {
+    if ( ref.Kind == TBC_VERTEX )
+    {
+      return this->PointMap[ ref.Id0 ];
+    }
+    if ( ref.Kind == TBC_EDGE )
+    {
+      TableBasedClipperEdge edge;
+      edge.Pnt0 = ref.Id0;
+      edge.Pnt1 = ref.Id1;
+      return this->NumberOfKeptPoints + ( std::lower_bound
+        ( this->EdgesBegin, this->EdgesEnd, edge ) - this->EdgesBegin );
+    }
+    return this->IntrpIds[ ref.Id0 ];
+  }
+
+  void AddShape( int vtkType, int nPts, const TableBasedClipperPointRef * refs )
+  {
+    this->Types[ this->OutCellId ] = static_cast < unsigned char > ( vtkType );
+    this->Locations[ this->OutCellId ] = this->Location;
+    this->OriginalCellIds[ this->OutCellId ] = this->CellId;
+    this->OutCellId ++;
+    this->Connectivity[ this->Location ++ ] = nPts;
+    for ( int p = 0; p < nPts; p ++ )
+    {
+      this->Connectivity[ this->Location ++ ] = this->GetOutputId( refs[p] );
+    }
+  }
+
+  void AddCentroid( int index, int nPts, const TableBasedClipperPointRef * refs )
+  {
+    vtkIdType * centroid = this->Centroids + 9 * this->CentroidId;
+    centroid[0] = nPts;
+    for ( int p = 0; p < nPts; p ++ )
+    {
+      centroid[ p + 1 ] = this->GetOutputId( refs[p] );
+    }
+    this->IntrpIds[ index ] = this->CentroidStart + this->CentroidId;
+    this->CentroidId ++;
+  }
+};
+
+struct TableBasedClipperGenerate
+{
+  const TableBasedClipperCells * Cells;
+  const double * Diffs;
+  int InsideOut;
+  vtkIdType NumberOfCells;
+  const TableBasedClipperBatch * Batches;
+  TableBasedClipperGenerateVisitor Visitor;
+
+  void operator() ( vtkIdType begin, vtkIdType end )
+  {
+    vtkIdType nPts, buffer[8];
+    const vtkIdType * pts;
+    vtkNew<vtkIdList> ptIds;
+    TableBasedClipperGenerateVisitor visitor = this->Visitor;
+    for ( vtkIdType b = begin; b < end; b ++ )
+    {
+      visitor.OutCellId  = this->Batches[b].CellOffset;
+      visitor.Location   = this->Batches[b].ConnectivityOffset;
+      visitor.CentroidId = this->Batches[b].CentroidOffset;
+      vtkIdType lastCell = std::min( ( b + 1 ) * TableBasedClipperBatchSize,
+                                     this->NumberOfCells );
+      for ( vtkIdType i = b * TableBasedClipperBatchSize; i < lastCell; i ++ )
+      {
+        visitor.CellId = i;
+        int cellType = this->Cells->GetCell( i, nPts, pts, buffer,
+                                             ptIds.GetPointer() );
+        ClipTableBasedCell( cellType, nPts, pts, this->Diffs,
+                            this->InsideOut, visitor );
+      }
+    }
+  }
+};
+
+// Gather the (sorted, unique) edges of each batch.
+struct TableBasedClipperGatherEdges
+{
+  const TableBasedClipperBatch * Batches;
+  const vtkIdType * Offsets;
+  TableBasedClipperEdge * Edges;
+
+  void operator() ( vtkIdType begin, vtkIdType end )
+  {
+    for ( vtkIdType b = begin; b < end; b ++ )
+    {
+      std::copy( this->Batches[b].Edges.begin(), this->Batches[b].Edges.end(),
+                 this->Edges + this->Offsets[b] );
+    }
+  }
+};
+
+// Copy the input points on the kept side and their data.
+struct TableBasedClipperKeptPoints
+{
+  const TableBasedClipperPoints * InPoints;
+  const vtkIdType * PointMap;
+  vtkPoints * OutPoints;
+  ArrayList * Arrays;
+
+  void operator() ( vtkIdType begin, vtkIdType end )
+  {
+    double x[3];
+    for ( vtkIdType i = begin; i < end; i ++ )
+    {
+      vtkIdType outId = this->PointMap[i];
+      if ( outId >= 0 )
+      {
+        this->InPoints->GetPoint( i, x );
+        this->OutPoints->SetPoint( outId, x );
+        this->Arrays->Copy( i, outId );
+      }
+    }
+  }
+};
+
+// Interpolate the edge points and their data.
+struct TableBasedClipperEdgePoints
+{
+  const TableBasedClipperPoints * InPoints;
+  const TableBasedClipperEdge * Edges;
+  vtkIdType NumberOfKeptPoints;
+  vtkPoints * OutPoints;
+  ArrayList * Arrays;
+
+  void operator() ( vtkIdType begin, vtkIdType end )
+  {
+    double x0[3], x1[3];
+    for ( vtkIdType i = begin; i < end; i ++ )
+    {
+      const TableBasedClipperEdge & edge = this->Edges[i];
+      this->InPoints->GetPoint( edge.Pnt0, x0 );
+      this->InPoints->GetPoint( edge.Pnt1, x1 );
+      for ( int c = 0; c < 3; c ++ )
+      {
+        x0[c] += edge.T * ( x1[c] - x0[c] );
+      }
+      vtkIdType outId = this->NumberOfKeptPoints + i;
+      this->OutPoints->SetPoint( outId, x0 );
+      this->Arrays->InterpolateEdge( edge.Pnt0, edge.Pnt1, edge.T, outId );
+    }
+  }
+};
+
+// Average the output points defining the centroid points, and their data.
+// The centroids of a batch are processed in order since a centroid point may
+// be defined by a previous one of the same cell.
+struct TableBasedClipperCentroidPoints
+{
+  const TableBasedClipperBatch * Batches;
+  const vtkIdType * Centroids;
+  vtkIdType CentroidStart;
+  vtkPoints * OutPoints;
+  ArrayList * Arrays;
+
+  void operator() ( vtkIdType begin, vtkIdType end )
+  {
+    double x[3], pt[3], weights[8];
+    for ( vtkIdType b = begin; b < end; b ++ )
+    {
+      vtkIdType first = this->Batches[b].CentroidOffset;
+      vtkIdType last  = first + this->Batches[b].NumberOfCentroids;
+      for ( vtkIdType i = first; i < last; i ++ )
+      {
+        const vtkIdType * centroid = this->Centroids + 9 * i;
+        int nPts = static_cast < int > ( centroid[0] );
+        double weight = 1.0 / nPts;
+        pt[0] = pt[1] = pt[2] = 0.0;
+        for ( int p = 0; p < nPts; p ++ )
+        {
+          this->OutPoints->GetPoint( centroid[ p + 1 ], x );
+          pt[0] += x[0];
+          pt[1] += x[1];
+          pt[2] += x[2];
+          weights[p] = weight;
+        }
+        pt[0] *= weight;
+        pt[1] *= weight;
+        pt[2] *= weight;
+        this->OutPoints->SetPoint( this->CentroidStart + i, pt );
+        this->Arrays->Interpolate( nPts, centroid + 1, weights,
+                                   this->CentroidStart + i );
+      }
+    }
+  }
+};
+
+// Copy the data of the original cells to the output cells.
+struct TableBasedClipperCellData
+{
+  const vtkIdType * OriginalCellIds;
+  ArrayList * Arrays;
+
+  void operator() ( vtkIdType begin, vtkIdType end )
+  {
+    for ( vtkIdType i = begin; i < end; i ++ )
+    {
+      this->Arrays->Copy( this->OriginalCellIds[i], i );
+    }
+  }
+};
+
+// The arrays of outDA that are not data arrays (e.g., string arrays), which
+// ArrayList does not process, paired with the arrays of inDA.
+void GetTableBasedClipperOtherArrays( vtkDataSetAttributes * inDA,
+  vtkDataSetAttributes * outDA, vtkIdType numOutTuples,
+  std::vector < std::pair < vtkAbstractArray *, vtkAbstractArray * > > & others )
+{
+  for ( int i = 0; i < outDA->GetNumberOfArrays(); i ++ )
+  {
+    vtkAbstractArray * outArray = outDA->GetAbstractArray( i );
+    if ( outArray && !vtkArrayDownCast < vtkDataArray > ( outArray ) )
+    {
+      vtkAbstractArray * inArray = inDA->GetAbstractArray( outArray->GetName() );
+      if ( inArray )
+      {
+        outArray->SetNumberOfTuples( numOutTuples );
+        others.push_back( std::make_pair( inArray, outArray ) );
+      }
+    }
+  }
+}
+
+}
+
+// ============================================================================
+// ====================== parallel clipping helpers ( end ) ===================
+// ============================================================================
+
+
 //-----------------------------------------------------------------------------
 // Construct with user-specified implicit function; InsideOut turned off; value
 // set to 0.0; and generate clip scalars turned off.
@@ -1617,6 +2312,7 @@ vtkTableBasedClipDataSet::vtkTableBasedClipDataSet( vtkImplicitFunction * cf )
   this->UseValueAsOffset      = true;
   this->GenerateClipScalars   = 0;
   this->GenerateClippedOutput = 0;
+  this->ParallelClipping      = 0;
 
   this->OutputPointsPrecision = DEFAULT_PRECISION;
 
@@ -1810,10 +2506,21 @@ int vtkTableBasedClipDataSet::RequestData( vtkInformation * vtkNotUsed( request
       cpyInput->GetPointData()->SetScalars( pScalars );
     }
 
-    for ( i = 0; i < numbPnts; i ++ )
+    if ( this->ParallelClipping )
+    {
+      TableBasedClipperEvaluateFunction evaluate;
+      evaluate.Input    = cpyInput.GetPointer();
+      evaluate.Function = this->ClipFunction;
+      evaluate.Scalars  = pScalars;
+      vtkSMPTools::For( 0, numbPnts, evaluate );
+    }
+    else
     {
-      double s = this->ClipFunction->FunctionValue(  cpyInput->GetPoint( i )  );
-      pScalars->SetTuple1( i, s );
+      for ( i = 0; i < numbPnts; i ++ )
+      {
+        double s = this->ClipFunction->FunctionValue(  cpyInput->GetPoint( i )  );
+        pScalars->SetTuple1( i, s );
+      }
     }
 
     clipAray = pScalars;
@@ -1831,6 +2538,22 @@ int vtkTableBasedClipDataSet::RequestData( vtkInformation * vtkNotUsed( request
   int    gridType = cpyInput->GetDataObjectType();
   double isoValue = ( !this->ClipFunction || this->UseValueAsOffset )
                     ?  this->Value  :  0.0;
+  if ( this->ParallelClipping &&
+       ( gridType == VTK_IMAGE_DATA || gridType == VTK_STRUCTURED_POINTS ||
+         gridType == VTK_RECTILINEAR_GRID || gridType == VTK_STRUCTURED_GRID ||
+         gridType == VTK_UNSTRUCTURED_GRID ) )
+  {
+    this->ClipDataSetInParallel( cpyInput.GetPointer(), clipAray,
+                                 isoValue, outputUG );
+    if (clippedOutputUG)
+    {
+      this->InsideOut = !(this->InsideOut);
+      this->ClipDataSetInParallel( cpyInput.GetPointer(), clipAray, isoValue,
+                                   clippedOutputUG );
+      this->InsideOut = !(this->InsideOut);
+    }
+  }
+  else
   if ( gridType == VTK_IMAGE_DATA || gridType == VTK_STRUCTURED_POINTS )
   {
     this->ClipImageData( cpyInput.GetPointer(), clipAray, isoValue, outputUG );
@@ -3423,6 +4146,374 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd,
   unstruct = NULL;
 }
 
+//-----------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipDataSetInParallel( vtkDataSet * inputGrd,
+     vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
+{
+  vtkIdType i, j;
+  vtkIdType numbPnts = inputGrd->GetNumberOfPoints();
+  vtkIdType numCells = inputGrd->GetNumberOfCells();
+
+  // the cells and the coordinates of the points of the input
+  TableBasedClipperCells  inCells;
+  TableBasedClipperPoints inPoints;
+  vtkPointSet * pointSet = vtkPointSet::SafeDownCast( inputGrd );
+  inCells.Grid    = vtkUnstructuredGrid::SafeDownCast( inputGrd );
+  inPoints.Points = ( pointSet ? pointSet->GetPoints() : NULL );
+  if ( !inCells.Grid )
+  {
+    int gridDims[3] = { 0, 0, 0 };
+    vtkImageData       * volImage = vtkImageData::SafeDownCast( inputGrd );
+    vtkRectilinearGrid * rectGrid = vtkRectilinearGrid::SafeDownCast( inputGrd );
+    if ( volImage )
+    {
+      double spacings[3];
+      volImage->GetDimensions( gridDims );
+      volImage->GetSpacing( spacings );
+      const double * dataBBox = volImage->GetBounds();
+      for ( j = 0; j < 3; j ++ )
+      {
+        inPoints.Coords[j].resize( gridDims[j] );
+        for ( i = 0; i < gridDims[j]; i ++ )
+        {
+          inPoints.Coords[j][i] = dataBBox[ j << 1 ] + i * spacings[j];
+        }
+      }
+    }
+    else
+    if ( rectGrid )
+    {
+      rectGrid->GetDimensions( gridDims );
+      vtkDataArray * coords[3] = { rectGrid->GetXCoordinates(),
+                                   rectGrid->GetYCoordinates(),
+                                   rectGrid->GetZCoordinates() };
+      for ( j = 0; j < 3; j ++ )
+      {
+        inPoints.Coords[j].resize( gridDims[j] );
+        for ( i = 0; i < gridDims[j]; i ++ )
+        {
+          inPoints.Coords[j][i] = coords[j]->GetComponent( i, 0 );
+        }
+      }
+    }
+    else
+    {
+      vtkStructuredGrid::SafeDownCast( inputGrd )->GetDimensions( gridDims );
+    }
+
+    // hexahedra, or quads (in the plane of the two other axes) if one of the
+    // dimensions is 1; the cells of lower dimensional grids are handed over
+    // to vtkClipDataSet
+    int numFlat = 0;
+    for ( j = 0; j < 3; j ++ )
+    {
+      inCells.Dims[j]     = gridDims[j];
+      inCells.CellDims[j] = ( gridDims[j] > 1 ? gridDims[j] - 1 : 1 );
+      numFlat += ( gridDims[j] <= 1 ? 1 : 0 );
+    }
+    if ( numFlat > 1 )
+    {
+      this->ClipDataSet( inputGrd, clipAray, outputUG );
+      return;
+    }
+    int axes[3] = { 0, 1, 2 };
+    if ( gridDims[0] <= 1 )
+    {
+      axes[0] = 1;
+      axes[1] = 2;
+      axes[2] = 0;
+    }
+    else
+    if ( gridDims[1] <= 1 )
+    {
+      axes[1] = 2;
+      axes[2] = 1;
+    }
+    std::copy( axes, axes + 3, inCells.Axes );
+    inCells.CellType = ( numFlat ? VTK_QUAD : VTK_HEXAHEDRON );
+    inCells.NumberOfCellPoints = ( numFlat ? 4 : 8 );
+    inPoints.Dims[0] = gridDims[0];
+    inPoints.Dims[1] = gridDims[1];
+  }
+
+  // classify the points
+  std::vector < double >    grdDiffs( numbPnts );
+  std::vector < vtkIdType > pointMap( numbPnts, 0 );
+  TableBasedClipperClassifyPoints classify;
+  classify.ClipArray = clipAray;
+  classify.IsoValue  = isoValue;
+  classify.Diffs     = &grdDiffs[0];
+  vtkSMPTools::For( 0, numbPnts, classify );
+
+  // first pass: count the output of each batch of cells, and collect the
+  // input points they use
+  vtkIdType numBatches = ( numCells + TableBasedClipperBatchSize - 1 ) /
+                         TableBasedClipperBatchSize;
+  std::vector < TableBasedClipperBatch > batches( numBatches );
+  TableBasedClipperCount count;
+  count.Cells         = &inCells;
+  count.Diffs         = &grdDiffs[0];
+  count.InsideOut     = this->InsideOut;
+  count.NumberOfCells = numCells;
+  count.Batches       = batches.empty() ? NULL : &batches[0];
+  vtkSMPTools::For( 0, numBatches, 1, count );
+
+  // mark the input points used by the output cells, and number them as the
+  // serial clipper does; the other points on the kept side are dropped
+  for ( i = 0; i < numBatches; i ++ )
+  {
+    std::vector < vtkIdType > & points = batches[i].Points;
+    for ( size_t p = 0; p < points.size(); p ++ )
+    {
+      pointMap[ points[p] ] = 1;
+    }
+    std::vector < vtkIdType > ().swap( points );
+  }
+  vtkIdType numKept = 0;
+  for ( i = 0; i < numbPnts; i ++ )
+  {
+    pointMap[i] = ( pointMap[i] ? numKept ++ : -1 );
+  }
+
+  vtkIdType numOutCells = 0;
+  vtkIdType connSize    = 0;
+  vtkIdType numCntrds   = 0;
+  vtkIdType numEdgeKeys = 0;
+  std::vector < vtkIdType > edgeOffsets( numBatches );
+  std::vector < vtkIdType > specialIds;
+  for ( i = 0; i < numBatches; i ++ )
+  {
+    TableBasedClipperBatch & batch = batches[i];
+    batch.CellOffset         = numOutCells;
+    batch.ConnectivityOffset = connSize;
+    batch.CentroidOffset     = numCntrds;
+    edgeOffsets[i]           = numEdgeKeys;
+    numOutCells += batch.NumberOfCells;
+    connSize    += batch.ConnectivitySize;
+    numCntrds   += batch.NumberOfCentroids;
+    numEdgeKeys += static_cast < vtkIdType > ( batch.Edges.size() );
+    specialIds.insert( specialIds.end(),
+                       batch.Specials.begin(), batch.Specials.end() );
+  }
+
+  // merge the edge points by sorting their keys
+  std::vector < TableBasedClipperEdge > edges( numEdgeKeys );
+  if ( numEdgeKeys > 0 )
+  {
+    TableBasedClipperGatherEdges gather;
+    gather.Batches = &batches[0];
+    gather.Offsets = &edgeOffsets[0];
+    gather.Edges   = &edges[0];
+    vtkSMPTools::For( 0, numBatches, 1, gather );
+    vtkSMPTools::Sort( edges.begin(), edges.end() );
+    edges.erase( std::unique( edges.begin(), edges.end() ), edges.end() );
+  }
+  vtkIdType numEdges  = static_cast < vtkIdType > ( edges.size() );
+  vtkIdType cntrStart = numKept + numEdges;
+  vtkIdType numOutPts = cntrStart + numCntrds;
+
+  // second pass: generate the output cells and the centroid definitions
+  vtkIdTypeArray * nlist = vtkIdTypeArray::New();
+  nlist->SetNumberOfValues( connSize );
+  vtkUnsignedCharArray * cellTypes = vtkUnsignedCharArray::New();
+  cellTypes->SetNumberOfValues( numOutCells );
+  vtkIdTypeArray * cellLocations = vtkIdTypeArray::New();
+  cellLocations->SetNumberOfValues( numOutCells );
+  std::vector < vtkIdType > origCellIds( numOutCells );
+  std::vector < vtkIdType > centroids( 9 * numCntrds );
+  if ( numOutCells > 0 || numCntrds > 0 )
+  {
+    TableBasedClipperGenerate generate;
+    generate.Cells         = &inCells;
+    generate.Diffs         = &grdDiffs[0];
+    generate.InsideOut     = this->InsideOut;
+    generate.NumberOfCells = numCells;
+    generate.Batches       = &batches[0];
+    generate.Visitor.PointMap           = &pointMap[0];
+    generate.Visitor.EdgesBegin         = edges.empty() ? NULL : &edges[0];
+    generate.Visitor.EdgesEnd           = generate.Visitor.EdgesBegin + numEdges;
+    generate.Visitor.NumberOfKeptPoints = numKept;
+    generate.Visitor.CentroidStart      = cntrStart;
+    generate.Visitor.Connectivity       = nlist->GetPointer( 0 );
+    generate.Visitor.Locations          = cellLocations->GetPointer( 0 );
+    generate.Visitor.Types              = cellTypes->GetPointer( 0 );
+    generate.Visitor.OriginalCellIds    =
+      origCellIds.empty() ? NULL : &origCellIds[0];
+    generate.Visitor.Centroids          = centroids.empty() ? NULL : &centroids[0];
+    vtkSMPTools::For( 0, numBatches, 1, generate );
+  }
+
+  // the stuffs that can not be clipped by the tables
+  vtkUnstructuredGrid * visItGrd = outputUG;
+  if ( !specialIds.empty() )
+  {
+    visItGrd = vtkUnstructuredGrid::New();
+  }
+
+  // the output points and their data
+  vtkPoints * outPts = vtkPoints::New();
+  if ( this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION )
+  {
+    outPts->SetDataType
+      ( inPoints.Points ? inPoints.Points->GetDataType() : VTK_FLOAT );
+  }
+  else if ( this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION )
+  {
+    outPts->SetDataType( VTK_FLOAT );
+  }
+  else if ( this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION )
+  {
+    outPts->SetDataType( VTK_DOUBLE );
+  }
+  outPts->SetNumberOfPoints( numOutPts );
+
+  vtkPointData * inPD  = inputGrd->GetPointData();
+  vtkPointData * outPD = visItGrd->GetPointData();
+  outPD->CopyAllocate( inPD, numOutPts );
+  ArrayList pointArrays;
+  pointArrays.AddArrays( numOutPts, inPD, outPD, 0.0, false );
+
+  TableBasedClipperKeptPoints keptPoints;
+  keptPoints.InPoints  = &inPoints;
+  keptPoints.PointMap  = &pointMap[0];
+  keptPoints.OutPoints = outPts;
+  keptPoints.Arrays    = &pointArrays;
+  vtkSMPTools::For( 0, numbPnts, keptPoints );
+
+  if ( numEdges > 0 )
+  {
+    TableBasedClipperEdgePoints edgePoints;
+    edgePoints.InPoints           = &inPoints;
+    edgePoints.Edges              = &edges[0];
+    edgePoints.NumberOfKeptPoints = numKept;
+    edgePoints.OutPoints          = outPts;
+    edgePoints.Arrays             = &pointArrays;
+    vtkSMPTools::For( 0, numEdges, edgePoints );
+  }
+
+  ArrayList centroidArrays;
+  if ( numCntrds > 0 )
+  {
+    centroidArrays.AddSelfInterpolatingArrays( numOutPts, outPD );
+    TableBasedClipperCentroidPoints centroidPoints;
+    centroidPoints.Batches       = &batches[0];
+    centroidPoints.Centroids     = &centroids[0];
+    centroidPoints.CentroidStart = cntrStart;
+    centroidPoints.OutPoints     = outPts;
+    centroidPoints.Arrays        = &centroidArrays;
+    vtkSMPTools::For( 0, numBatches, 1, centroidPoints );
+  }
+
+  // the (serial) interpolation of the other arrays, e.g. string arrays
+  std::vector < std::pair < vtkAbstractArray *, vtkAbstractArray * > > others;
+  GetTableBasedClipperOtherArrays( inPD, outPD, numOutPts, others );
+  for ( size_t a = 0; a < others.size(); a ++ )
+  {
+    vtkAbstractArray * inArray  = others[a].first;
+    vtkAbstractArray * outArray = others[a].second;
+    for ( i = 0; i < numbPnts; i ++ )
+    {
+      if ( pointMap[i] >= 0 )
+      {
+        outArray->SetTuple( pointMap[i], i, inArray );
+      }
+    }
+    for ( i = 0; i < numEdges; i ++ )
+    {
+      outArray->InterpolateTuple( numKept + i, edges[i].Pnt0, inArray,
+                                  edges[i].Pnt1, inArray, edges[i].T );
+    }
+    vtkSmartPointer < vtkIdList > idList = vtkSmartPointer < vtkIdList >::New();
+    double weights[8];
+    for ( i = 0; i < numCntrds; i ++ )
+    {
+      const vtkIdType * centroid = &centroids[ 9 * i ];
+      idList->SetNumberOfIds( centroid[0] );
+      for ( j = 0; j < centroid[0]; j ++ )
+      {
+        idList->SetId( j, centroid[ j + 1 ] );
+        weights[j] = 1.0 / centroid[0];
+      }
+      outArray->InterpolateTuple( cntrStart + i, idList, outArray, weights );
+    }
+  }
+
+  visItGrd->SetPoints( outPts );
+  outPts->Delete();
+
+  // the output cells and their data
+  vtkCellArray * cells = vtkCellArray::New();
+  cells->SetCells( numOutCells, nlist );
+  visItGrd->SetCells( cellTypes, cellLocations, cells );
+  nlist->Delete();
+  cellTypes->Delete();
+  cellLocations->Delete();
+  cells->Delete();
+
+  vtkCellData * inCD  = inputGrd->GetCellData();
+  vtkCellData * outCD = visItGrd->GetCellData();
+  outCD->CopyAllocate( inCD, numOutCells );
+  ArrayList cellArrays;
+  cellArrays.AddArrays( numOutCells, inCD, outCD, 0.0, false );
+  if ( numOutCells > 0 )
+  {
+    TableBasedClipperCellData cellData;
+    cellData.OriginalCellIds = &origCellIds[0];
+    cellData.Arrays          = &cellArrays;
+    vtkSMPTools::For( 0, numOutCells, cellData );
+  }
+  others.clear();
+  GetTableBasedClipperOtherArrays( inCD, outCD, numOutCells, others );
+  for ( size_t a = 0; a < others.size(); a ++ )
+  {
+    for ( i = 0; i < numOutCells; i ++ )
+    {
+      others[a].second->SetTuple( i, origCellIds[i], others[a].first );
+    }
+  }
+
+  if ( !specialIds.empty() )
+  {
+    vtkIdType numCants = static_cast < vtkIdType > ( specialIds.size() );
+    vtkUnstructuredGrid * specials = vtkUnstructuredGrid::New();
+    specials->SetPoints( inCells.Grid->GetPoints() );
+    specials->GetPointData()->ShallowCopy( inPD );
+    specials->Allocate( numCants );
+    specials->GetCellData()->CopyAllocate( inCD, numCants );
+    for ( i = 0; i < numCants; i ++ )
+    {
+      vtkIdType cellId = specialIds[i];
+      int cellType = inCells.Grid->GetCellType( cellId );
+      vtkIdType numbIds, * pntIndxs;
+      if ( cellType == VTK_POLYHEDRON )
+      {
+        inCells.Grid->GetFaceStream( cellId, numbIds, pntIndxs );
+      }
+      else
+      {
+        inCells.Grid->GetCellPoints( cellId, numbIds, pntIndxs );
+      }
+      specials->InsertNextCell( cellType, numbIds, pntIndxs );
+      specials->GetCellData()->CopyData( inCD, cellId, i );
+    }
+
+    vtkUnstructuredGrid * vtkUGrid = vtkUnstructuredGrid::New();
+    this->ClipDataSet( specials, clipAray, vtkUGrid );
+
+    vtkAppendFilter * appender = vtkAppendFilter::New();
+    appender->AddInputData( vtkUGrid );
+    appender->AddInputData( visItGrd );
+    appender->Update();
+
+    outputUG->ShallowCopy( appender->GetOutput() );
+
+    appender->Delete();
+    vtkUGrid->Delete();
+    specials->Delete();
+    visItGrd->Delete();
+  }
+}
+
 //-----------------------------------------------------------------------------
 void vtkTableBasedClipDataSet::PrintSelf( ostream & os, vtkIndent indent )
 {
@@ -3457,6 +4548,9 @@ void vtkTableBasedClipDataSet::PrintSelf( ostream & os, vtkIndent indent )
   os << indent << "UseValueAsOffset: "
      << (this->UseValueAsOffset ? "On\n" : "Off\n");
 
+  os << indent << "Parallel Clipping: "
+     << (this->ParallelClipping ? "On\n" : "Off\n");
+
   os << indent << "Precision of the output points: "
      << this->OutputPointsPrecision << "\n";
 }
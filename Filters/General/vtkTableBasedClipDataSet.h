@@ -228,6 +228,25 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   //@}
 
+  //@{
+  /**
+   * Set/Get flag ParallelClipping, with 0 as the default value. With this flag
+   * on, image data, rectilinear grids, structured grids and unstructured grids
+   * are clipped by a threaded two-pass (count, then generate) algorithm and
+   * the implicit function, if any, is evaluated from several threads (it must
+   * then be thread safe). The cells are processed in batches of a fixed size
+   * and the points on the clipped edges are merged by sorting the edge keys
+   * instead of using a hash table, so that the output does not depend on the
+   * number of threads. The output cells follow the order of the input cells,
+   * and the output points are the input points on the kept side of the clip
+   * value followed by the edge points and the centroid points. Polygonal data
+   * are always clipped serially.
+   */
+  vtkSetMacro( ParallelClipping, int );
+  vtkGetMacro( ParallelClipping, int );
+  vtkBooleanMacro( ParallelClipping, int );
+  //@}
+
 protected:
   vtkTableBasedClipDataSet( vtkImplicitFunction * cf = NULL );
   ~vtkTableBasedClipDataSet() VTK_OVERRIDE;
@@ -287,6 +306,16 @@ protected:
   void ClipUnstructuredGridData( vtkDataSet * inputGrd, vtkDataArray * clipAray,
                                  double isoValue, vtkUnstructuredGrid * outputUG );
 
+  /**
+   * This function clips a vtkImageData, vtkRectilinearGrid, vtkStructuredGrid
+   * or vtkUnstructuredGrid in parallel (see ParallelClipping) based on a
+   * specified iso-value (isoValue) using a scalar point data array (clipAray).
+   * The cells that can not be clipped with the tables are handed over to
+   * ClipDataSet(......). The clipping result is exported to outputUG.
+   */
+  void ClipDataSetInParallel( vtkDataSet * inputGrd, vtkDataArray * clipAray,
+                              double isoValue, vtkUnstructuredGrid * outputUG );
+
 
   /**
    * Register a callback function with the InternalProgressObserver.
@@ -303,6 +332,7 @@ protected:
   int    InsideOut;
   int    GenerateClipScalars;
   int    GenerateClippedOutput;
+  int    ParallelClipping;
   bool   UseValueAsOffset;
   double Value;
   double MergeTolerance;
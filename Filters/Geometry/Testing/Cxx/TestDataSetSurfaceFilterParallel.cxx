@@ -0,0 +1,174 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetSurfaceFilterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkDataSetSurfaceFilter produces the same output with and
+// without ParallelExternalFaces on an unstructured grid of mixed cells.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "TestDataComparison.h"
+
+#include <cmath>
+
+namespace
+{
+
+// Large enough to use several chunks of cells and partitions of points.
+const int Res = 24;
+
+// A grid of hexahedra, wedges and tetrahedra (which do not conform with the
+// neighboring cells, so that some of their faces are internal yet external),
+// and a few pyramids, prisms and lower dimensional cells.
+void MakeGrid(vtkUnstructuredGrid *grid)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= Res; ++k)
+  {
+    for (int j = 0; j <= Res; ++j)
+    {
+      for (int i = 0; i <= Res; ++i)
+      {
+        double x = i, y = j, z = k;
+        points->InsertNextPoint(x + 0.1 * sin(y + z), y, z);
+      }
+    }
+  }
+  // The apex of a pyramid and the points of a pentagonal prism.
+  vtkIdType apex = points->InsertNextPoint(-1.0, 0.5, 0.5);
+  vtkIdType prism = points->GetNumberOfPoints();
+  for (int k = 0; k < 2; ++k)
+  {
+    for (int i = 0; i < 5; ++i)
+    {
+      double angle = 2.0 * vtkMath::Pi() * i / 5;
+      points->InsertNextPoint(cos(angle), sin(angle), -2.0 - k);
+    }
+  }
+  grid->SetPoints(points.Get());
+
+  vtkNew<vtkIntArray> cellIndex;
+  cellIndex->SetName("CellIndex");
+  grid->Allocate(2 * Res * Res * Res);
+  const vtkIdType n = Res + 1;
+  for (int k = 0; k < Res; ++k)
+  {
+    for (int j = 0; j < Res; ++j)
+    {
+      for (int i = 0; i < Res; ++i)
+      {
+        vtkIdType p = i + j * n + k * n * n;
+        vtkIdType hex[8] = { p, p + 1, p + 1 + n, p + n, p + n * n,
+                             p + 1 + n * n, p + 1 + n + n * n, p + n + n * n };
+        switch ((i + 2 * j + 3 * k) % 5)
+        {
+          case 0:
+          {
+            vtkIdType wedge0[6] = { hex[0], hex[1], hex[2],
+                                    hex[4], hex[5], hex[6] };
+            vtkIdType wedge1[6] = { hex[0], hex[2], hex[3],
+                                    hex[4], hex[6], hex[7] };
+            grid->InsertNextCell(VTK_WEDGE, 6, wedge0);
+            grid->InsertNextCell(VTK_WEDGE, 6, wedge1);
+            break;
+          }
+          case 1:
+          {
+            vtkIdType tets[5][4] = {
+              { hex[0], hex[1], hex[3], hex[4] },
+              { hex[1], hex[2], hex[3], hex[6] },
+              { hex[1], hex[4], hex[5], hex[6] },
+              { hex[3], hex[4], hex[6], hex[7] },
+              { hex[1], hex[3], hex[4], hex[6] } };
+            for (int t = 0; t < 5; ++t)
+            {
+              grid->InsertNextCell(VTK_TETRA, 4, tets[t]);
+            }
+            break;
+          }
+          default:
+            grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+            break;
+        }
+      }
+    }
+  }
+  vtkIdType pyramid[5] = { 0, n, n + n * n, n * n, apex };
+  grid->InsertNextCell(VTK_PYRAMID, 5, pyramid);
+  vtkIdType prismIds[10];
+  for (int i = 0; i < 10; ++i)
+  {
+    prismIds[i] = prism + i;
+  }
+  grid->InsertNextCell(VTK_PENTAGONAL_PRISM, 10, prismIds);
+  vtkIdType tri[3] = { prism, prism + 1, apex };
+  grid->InsertNextCell(VTK_TRIANGLE, 3, tri);
+  vtkIdType line[2] = { apex, prism + 7 };
+  grid->InsertNextCell(VTK_LINE, 2, line);
+  grid->InsertNextCell(VTK_VERTEX, 1, &apex);
+
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    cellIndex->InsertNextValue(static_cast<int>(cellId));
+  }
+  grid->GetCellData()->AddArray(cellIndex.Get());
+}
+
+}
+
+int TestDataSetSurfaceFilterParallel(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid.Get());
+
+  vtkNew<vtkDataSetSurfaceFilter> serial;
+  serial->SetInputData(grid.Get());
+  serial->PassThroughCellIdsOn();
+  serial->PassThroughPointIdsOn();
+  serial->Update();
+  vtkPolyData *expected = serial->GetOutput();
+
+  vtkNew<vtkDataSetSurfaceFilter> parallel;
+  parallel->SetInputData(grid.Get());
+  parallel->PassThroughCellIdsOn();
+  parallel->PassThroughPointIdsOn();
+  parallel->ParallelExternalFacesOn();
+  parallel->Update();
+  vtkPolyData *output = parallel->GetOutput();
+
+  if (expected->GetNumberOfPolys() < 6 * Res * Res)
+  {
+    cerr << "Unexpected number of faces: " << expected->GetNumberOfPolys()
+         << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!vtkTest::SamePolyData(expected, output, "the external faces"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -31,6 +31,8 @@
 #include "vtkPolyData.h"
 #include "vtkPyramid.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGridGeometryFilter.h"
@@ -47,6 +49,7 @@
 #include "vtkStructuredData.h"
 
 #include <algorithm>
+#include <vector>
 #include <vtksys/hash_map.hxx>
 
 #include <cassert>
@@ -67,6 +70,425 @@ static inline int sizeofFastQuad(int numPts)
   }
 }
 
+//----------------------------------------------------------------------------
+// Reorder the ids of a quad / triangle to get the smallest id first, keeping
+// the orientation. This is the order in which the faces are hashed.
+static inline void OrderQuadIds(vtkIdType &a, vtkIdType &b,
+                                vtkIdType &c, vtkIdType &d)
+{
+  vtkIdType tmp;
+  if (b < a && b < c && b < d)
+  {
+    tmp = a;
+    a = b;
+    b = c;
+    c = d;
+    d = tmp;
+  }
+  else if (c < a && c < b && c < d)
+  {
+    tmp = a;
+    a = c;
+    c = tmp;
+    tmp = b;
+    b = d;
+    d = tmp;
+  }
+  else if (d < a && d < b && d < c)
+  {
+    tmp = a;
+    a = d;
+    d = c;
+    c = b;
+    b = tmp;
+  }
+}
+
+static inline void OrderTriIds(vtkIdType &a, vtkIdType &b, vtkIdType &c)
+{
+  vtkIdType tmp;
+  if (b < a && b < c)
+  {
+    tmp = a;
+    a = b;
+    b = c;
+    c = tmp;
+  }
+  else if (c < a && c < b)
+  {
+    tmp = a;
+    a = c;
+    c = b;
+    b = tmp;
+  }
+  // We can't put the second smallest in b because it might change the order
+  // of the vertices in the final triangle.
+}
+
+//----------------------------------------------------------------------------
+// Parallel hashing of the faces of the linear 3D cells of an unstructured
+// grid. It reproduces the serial hash: a face is external if no other face
+// with the same ids (in either orientation) is inserted, and the external
+// faces are traversed by bin (smallest point id), then in the order in
+// which they are inserted (cell id, then face of the cell).
+namespace
+{
+
+// The faces are stored in flat arrays of records (numPts, sourceId, ids...)
+// with the ids ordered as in the serial hash (smallest id first).
+typedef std::vector<vtkIdType> FaceRecords;
+
+// Whether the faces of a cell type are hashed in parallel.
+bool IsHashedInParallel(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_TETRA:
+    case VTK_VOXEL:
+    case VTK_HEXAHEDRON:
+    case VTK_WEDGE:
+    case VTK_PYRAMID:
+    case VTK_PENTAGONAL_PRISM:
+    case VTK_HEXAGONAL_PRISM:
+    case VTK_CONVEX_POINT_SET:
+    case VTK_POLYHEDRON:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Whether the cells of an unstructured grid can use the parallel hash: the
+// other cells are output directly by UnstructuredGridExecute().
+bool CanHashFacesInParallel(vtkUnstructuredGrid *input)
+{
+  vtkIdType numCells = input->GetNumberOfCells();
+  if (numCells < 1 || input->GetNumberOfPoints() < 1 ||
+      !input->GetCellTypesArray())
+  {
+    return false;
+  }
+  bool usedTypes[256] = {false};
+  const unsigned char *types = input->GetCellTypesArray()->GetPointer(0);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    usedTypes[types[cellId]] = true;
+  }
+  for (int cellType = 0; cellType < 256; ++cellType)
+  {
+    if (!usedTypes[cellType] || IsHashedInParallel(cellType))
+    {
+      continue;
+    }
+    switch (cellType)
+    {
+      case VTK_VERTEX:
+      case VTK_POLY_VERTEX:
+      case VTK_LINE:
+      case VTK_POLY_LINE:
+      case VTK_PIXEL:
+      case VTK_QUAD:
+      case VTK_TRIANGLE:
+      case VTK_POLYGON:
+      case VTK_TRIANGLE_STRIP:
+      case VTK_QUADRATIC_TRIANGLE:
+      case VTK_BIQUADRATIC_TRIANGLE:
+      case VTK_QUADRATIC_QUAD:
+      case VTK_QUADRATIC_LINEAR_QUAD:
+      case VTK_BIQUADRATIC_QUAD:
+      case VTK_QUADRATIC_POLYGON:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+// Whether two face records (with the same smallest id) have the same ids
+// in either orientation.
+bool SameFace(const vtkIdType *f0, const vtkIdType *f1)
+{
+  vtkIdType numPts = f0[0];
+  if (f1[0] != numPts)
+  {
+    return false;
+  }
+  const vtkIdType *ids0 = f0 + 2, *ids1 = f1 + 2;
+  bool forward = true, backward = true;
+  for (vtkIdType i = 1; i < numPts && (forward || backward); ++i)
+  {
+    forward = forward && ids0[i] == ids1[i];
+    backward = backward && ids0[i] == ids1[numPts - i];
+  }
+  return forward || backward;
+}
+
+struct FaceHash
+{
+  vtkUnstructuredGrid *Input;
+  vtkIdType NumberOfCells;
+  vtkIdType NumberOfPoints;
+  vtkIdType NumberOfChunks; // the cells are processed by chunks
+  vtkIdType ChunkSize;
+  vtkIdType NumberOfPartitions; // the faces are binned by partitions
+  vtkIdType PartitionSize;
+  // The faces of each chunk in each partition (chunk-major)
+  std::vector<FaceRecords> Faces;
+  // The external faces of each partition, in traversal order
+  std::vector<std::vector<const vtkIdType*> > ExternalFaces;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+  FaceHash(vtkUnstructuredGrid *input) : Input(input)
+  {
+    this->NumberOfCells = input->GetNumberOfCells();
+    this->NumberOfPoints = input->GetNumberOfPoints();
+    this->NumberOfChunks = std::min<vtkIdType>(
+      this->NumberOfCells / 10000 + 1, 1024);
+    this->ChunkSize =
+      (this->NumberOfCells - 1) / this->NumberOfChunks + 1;
+    this->NumberOfPartitions = std::min<vtkIdType>(
+      this->NumberOfPoints / 10000 + 1, 256);
+    this->PartitionSize =
+      (this->NumberOfPoints - 1) / this->NumberOfPartitions + 1;
+    this->Faces.resize(this->NumberOfChunks * this->NumberOfPartitions);
+    this->ExternalFaces.resize(this->NumberOfPartitions);
+  }
+
+  FaceRecords &GetFaces(vtkIdType chunk, vtkIdType smallestId)
+  {
+    return this->Faces[chunk * this->NumberOfPartitions +
+                       smallestId / this->PartitionSize];
+  }
+
+  void AddTri(vtkIdType chunk, vtkIdType a, vtkIdType b, vtkIdType c,
+              vtkIdType cellId)
+  {
+    OrderTriIds(a, b, c);
+    FaceRecords &faces = this->GetFaces(chunk, a);
+    faces.push_back(3);
+    faces.push_back(cellId);
+    faces.push_back(a);
+    faces.push_back(b);
+    faces.push_back(c);
+  }
+
+  void AddQuad(vtkIdType chunk, vtkIdType a, vtkIdType b, vtkIdType c,
+               vtkIdType d, vtkIdType cellId)
+  {
+    OrderQuadIds(a, b, c, d);
+    FaceRecords &faces = this->GetFaces(chunk, a);
+    faces.push_back(4);
+    faces.push_back(cellId);
+    faces.push_back(a);
+    faces.push_back(b);
+    faces.push_back(c);
+    faces.push_back(d);
+  }
+
+  void AddPolygon(vtkIdType chunk, const vtkIdType *ids, int numPts,
+                  vtkIdType cellId)
+  {
+    int offset = 0;
+    for (int i = 1; i < numPts; ++i)
+    {
+      if (ids[i] < ids[offset])
+      {
+        offset = i;
+      }
+    }
+    FaceRecords &faces = this->GetFaces(chunk, ids[offset]);
+    faces.push_back(numPts);
+    faces.push_back(cellId);
+    for (int i = 0; i < numPts; ++i)
+    {
+      faces.push_back(ids[(offset + i) % numPts]);
+    }
+  }
+
+  // Same faces, in the same order, as UnstructuredGridExecute().
+  // The point ids are read without modifying the connectivity, using the
+  // point ids of cell as scratch space if they cannot be read in place.
+  void AddCellFaces(vtkIdType chunk, vtkIdType cellId, vtkGenericCell *cell)
+  {
+    vtkIdType npts;
+    const vtkIdType *ids;
+    int cellType = this->Input->GetCellType(cellId);
+    switch (cellType)
+    {
+      case VTK_HEXAHEDRON:
+        this->Input->GetCellPoints(cellId, npts, ids, cell->PointIds);
+        this->AddQuad(chunk, ids[0], ids[1], ids[5], ids[4], cellId);
+        this->AddQuad(chunk, ids[0], ids[3], ids[2], ids[1], cellId);
+        this->AddQuad(chunk, ids[0], ids[4], ids[7], ids[3], cellId);
+        this->AddQuad(chunk, ids[1], ids[2], ids[6], ids[5], cellId);
+        this->AddQuad(chunk, ids[2], ids[3], ids[7], ids[6], cellId);
+        this->AddQuad(chunk, ids[4], ids[5], ids[6], ids[7], cellId);
+        break;
+
+      case VTK_VOXEL:
+        this->Input->GetCellPoints(cellId, npts, ids, cell->PointIds);
+        this->AddQuad(chunk, ids[0], ids[1], ids[5], ids[4], cellId);
+        this->AddQuad(chunk, ids[0], ids[2], ids[3], ids[1], cellId);
+        this->AddQuad(chunk, ids[0], ids[4], ids[6], ids[2], cellId);
+        this->AddQuad(chunk, ids[1], ids[3], ids[7], ids[5], cellId);
+        this->AddQuad(chunk, ids[2], ids[6], ids[7], ids[3], cellId);
+        this->AddQuad(chunk, ids[4], ids[5], ids[7], ids[6], cellId);
+        break;
+
+      case VTK_TETRA:
+        this->Input->GetCellPoints(cellId, npts, ids, cell->PointIds);
+        this->AddTri(chunk, ids[0], ids[1], ids[3], cellId);
+        this->AddTri(chunk, ids[0], ids[2], ids[1], cellId);
+        this->AddTri(chunk, ids[0], ids[3], ids[2], cellId);
+        this->AddTri(chunk, ids[1], ids[2], ids[3], cellId);
+        break;
+
+      case VTK_PENTAGONAL_PRISM:
+        this->Input->GetCellPoints(cellId, npts, ids, cell->PointIds);
+        this->AddQuad(chunk, ids[0], ids[1], ids[6], ids[5], cellId);
+        this->AddQuad(chunk, ids[1], ids[2], ids[7], ids[6], cellId);
+        this->AddQuad(chunk, ids[2], ids[3], ids[8], ids[7], cellId);
+        this->AddQuad(chunk, ids[3], ids[4], ids[9], ids[8], cellId);
+        this->AddQuad(chunk, ids[4], ids[0], ids[5], ids[9], cellId);
+        this->AddPolygon(chunk, ids, 5, cellId);
+        this->AddPolygon(chunk, &ids[5], 5, cellId);
+        break;
+
+      case VTK_HEXAGONAL_PRISM:
+        this->Input->GetCellPoints(cellId, npts, ids, cell->PointIds);
+        this->AddQuad(chunk, ids[0], ids[1], ids[7], ids[6], cellId);
+        this->AddQuad(chunk, ids[1], ids[2], ids[8], ids[7], cellId);
+        this->AddQuad(chunk, ids[2], ids[3], ids[9], ids[8], cellId);
+        this->AddQuad(chunk, ids[3], ids[4], ids[10], ids[9], cellId);
+        this->AddQuad(chunk, ids[4], ids[5], ids[11], ids[10], cellId);
+        this->AddQuad(chunk, ids[5], ids[0], ids[6], ids[11], cellId);
+        this->AddPolygon(chunk, ids, 6, cellId);
+        this->AddPolygon(chunk, &ids[6], 6, cellId);
+        break;
+
+      default:
+        if (IsHashedInParallel(cellType))
+        {
+          this->Input->GetCell(cellId, cell);
+          int numFaces = cell->GetNumberOfFaces();
+          for (int j = 0; j < numFaces; ++j)
+          {
+            vtkCell *face = cell->GetFace(j);
+            vtkIdType *faceIds = face->PointIds->GetPointer(0);
+            int numFacePts = face->GetNumberOfPoints();
+            if (numFacePts == 4)
+            {
+              this->AddQuad(chunk, faceIds[0], faceIds[1], faceIds[2],
+                            faceIds[3], cellId);
+            }
+            else if (numFacePts == 3)
+            {
+              this->AddTri(chunk, faceIds[0], faceIds[1], faceIds[2], cellId);
+            }
+            else
+            {
+              this->AddPolygon(chunk, faceIds, numFacePts, cellId);
+            }
+          }
+        }
+        break;
+    }
+  }
+};
+
+// Bin the faces of each chunk of cells.
+struct BinFaces
+{
+  FaceHash *Hash;
+
+  BinFaces(FaceHash *hash) : Hash(hash) {}
+
+  void operator()(vtkIdType chunk, vtkIdType endChunk)
+  {
+    vtkGenericCell *cell = this->Hash->Cell.Local();
+    for ( ; chunk < endChunk; ++chunk)
+    {
+      vtkIdType cellId = chunk * this->Hash->ChunkSize;
+      vtkIdType endCellId = std::min(cellId + this->Hash->ChunkSize,
+                                     this->Hash->NumberOfCells);
+      for ( ; cellId < endCellId; ++cellId)
+      {
+        this->Hash->AddCellFaces(chunk, cellId, cell);
+      }
+    }
+  }
+};
+
+// Cancel the faces shared by several cells in each partition. The faces of
+// the partition are visited in insertion order (chunk by chunk), and chained
+// in lists by smallest id, as in the serial hash.
+struct CancelFaces
+{
+  FaceHash *Hash;
+
+  CancelFaces(FaceHash *hash) : Hash(hash) {}
+
+  void operator()(vtkIdType partition, vtkIdType endPartition)
+  {
+    std::vector<const vtkIdType*> faces;
+    std::vector<vtkIdType> next;
+    std::vector<char> hidden;
+    std::vector<vtkIdType> lists;
+    for ( ; partition < endPartition; ++partition)
+    {
+      vtkIdType firstId = partition * this->Hash->PartitionSize;
+      vtkIdType numIds = std::min(firstId + this->Hash->PartitionSize,
+                                  this->Hash->NumberOfPoints) - firstId;
+      faces.clear();
+      next.clear();
+      hidden.clear();
+      lists.assign(numIds, -1);
+      for (vtkIdType chunk = 0; chunk < this->Hash->NumberOfChunks; ++chunk)
+      {
+        const FaceRecords &records = this->Hash->Faces[
+          chunk * this->Hash->NumberOfPartitions + partition];
+        for (size_t pos = 0; pos < records.size(); pos += 2 + records[pos])
+        {
+          const vtkIdType *face = &records[pos];
+          vtkIdType *end = &lists[face[2] - firstId];
+          for ( ; *end >= 0; end = &next[*end])
+          {
+            if (SameFace(faces[*end], face))
+            {
+              hidden[*end] = 1;
+              break;
+            }
+          }
+          if (*end < 0)
+          {
+            *end = static_cast<vtkIdType>(faces.size());
+            faces.push_back(face);
+            next.push_back(-1);
+            hidden.push_back(0);
+          }
+        }
+      }
+
+      std::vector<const vtkIdType*> &externalFaces =
+        this->Hash->ExternalFaces[partition];
+      externalFaces.clear();
+      for (vtkIdType i = 0; i < numIds; ++i)
+      {
+        for (vtkIdType face = lists[i]; face >= 0; face = next[face])
+        {
+          if (!hidden[face])
+          {
+            externalFaces.push_back(faces[face]);
+          }
+        }
+      }
+    }
+  }
+};
+
+}
+
 class vtkDataSetSurfaceFilter::vtkEdgeInterpolationMap
 {
 public:
@@ -129,6 +551,8 @@ vtkDataSetSurfaceFilter::vtkDataSetSurfaceFilter()
   this->OriginalPointIdsName = NULL;
 
   this->NonlinearSubdivisionLevel = 1;
+
+  this->ParallelExternalFaces = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -1433,6 +1857,8 @@ void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "NonlinearSubdivisionLevel: "
      << this->GetNonlinearSubdivisionLevel() << endl;
+  os << indent << "ParallelExternalFaces: "
+     << (this->GetParallelExternalFaces() ? "On\n" : "Off\n");
 }
 
 //========================================================================
@@ -1506,6 +1932,11 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
     cellIter = vtkSmartPointer<vtkCellIterator>::Take(input->NewCellIterator());
   }
 
+  // The faces of the linear 3D cells may be hashed in parallel.
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(input);
+  bool parallelFaces = this->ParallelExternalFaces && grid &&
+    CanHashFacesInParallel(grid);
+
   vtkUnsignedCharArray* ghosts = input->GetPointGhostArray();
   vtkCellArray *newVerts;
   vtkCellArray *newLines;
@@ -1645,6 +2076,11 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
     progressCount++;
 
     cellType = cellIter->GetCellType();
+    if (parallelFaces && IsHashedInParallel(cellType))
+    {
+      // Hashed later, see InsertExternalFacesInHash().
+      continue;
+    }
     switch (cellType)
     {
       case VTK_VERTEX:
@@ -2084,6 +2520,11 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   } // for all cells.
 
 
+  if (parallelFaces && !abort)
+  {
+    this->InsertExternalFacesInHash(grid);
+  }
+
   // Now transfer geometry from hash to output (only triangles and quads).
   this->InitQuadHashTraversal();
   while ( (q = this->GetNextVisibleQuadFromHash()) )
@@ -2230,35 +2671,10 @@ void vtkDataSetSurfaceFilter::InsertQuadInHash(vtkIdType a, vtkIdType b,
                                                vtkIdType c, vtkIdType d,
                                                vtkIdType sourceId)
 {
-  vtkIdType tmp;
   vtkFastGeomQuad *quad, **end;
 
   // Reorder to get smallest id in a.
-  if (b < a && b < c && b < d)
-  {
-    tmp = a;
-    a = b;
-    b = c;
-    c = d;
-    d = tmp;
-  }
-  else if (c < a && c < b && c < d)
-  {
-    tmp = a;
-    a = c;
-    c = tmp;
-    tmp = b;
-    b = d;
-    d = tmp;
-  }
-  else if (d < a && d < b && d < c)
-  {
-    tmp = a;
-    a = d;
-    d = c;
-    c = b;
-    b = tmp;
-  }
+  OrderQuadIds(a, b, c, d);
 
   // Look for existing quad in the hash;
   end = this->QuadHash + a;
@@ -2298,26 +2714,10 @@ void vtkDataSetSurfaceFilter::InsertTriInHash(vtkIdType a, vtkIdType b,
                                               vtkIdType c, vtkIdType sourceId,
                                               vtkIdType vtkNotUsed(faceId)/*= -1*/)
 {
-  vtkIdType tmp;
   vtkFastGeomQuad *quad, **end;
 
   // Reorder to get smallest id in a.
-  if (b < a && b < c)
-  {
-    tmp = a;
-    a = b;
-    b = c;
-    c = tmp;
-  }
-  else if (c < a && c < b)
-  {
-    tmp = a;
-    a = c;
-    c = b;
-    b = tmp;
-  }
-  // We can't put the second smnallest in b because it might change the order
-  // of the vertices in the final triangle.
+  OrderTriIds(a, b, c);
 
   // Look for existing tri in the hash;
   end = this->QuadHash + a;
@@ -2451,6 +2851,45 @@ void vtkDataSetSurfaceFilter::InsertPolygonInHash(vtkIdType* ids,
   delete [] tab;
 }
 
+//----------------------------------------------------------------------------
+// Hash the faces of the linear 3D cells of the input in parallel, then
+// insert the external ones in the (empty) serial hash, in the order in which
+// the serial hash would have traversed them.
+void vtkDataSetSurfaceFilter::InsertExternalFacesInHash(
+  vtkUnstructuredGrid *input)
+{
+  FaceHash hash(input);
+  BinFaces binFaces(&hash);
+  vtkSMPTools::For(0, hash.NumberOfChunks, 1, binFaces);
+  CancelFaces cancelFaces(&hash);
+  vtkSMPTools::For(0, hash.NumberOfPartitions, 1, cancelFaces);
+
+  vtkFastGeomQuad **end = NULL;
+  vtkIdType bin = -1;
+  for (vtkIdType partition = 0; partition < hash.NumberOfPartitions;
+       ++partition)
+  {
+    const std::vector<const vtkIdType*> &externalFaces =
+      hash.ExternalFaces[partition];
+    for (size_t i = 0; i < externalFaces.size(); ++i)
+    {
+      const vtkIdType *face = externalFaces[i];
+      int numPts = static_cast<int>(face[0]);
+      vtkFastGeomQuad *quad = this->NewFastGeomQuad(numPts);
+      quad->Next = NULL;
+      quad->SourceId = face[1];
+      std::copy(face + 2, face + 2 + numPts, quad->ptArray);
+      if (face[2] != bin)
+      {
+        bin = face[2];
+        end = this->QuadHash + bin;
+      }
+      *end = quad;
+      end = &(quad->Next);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkDataSetSurfaceFilter::InitFastGeomQuadAllocation(vtkIdType numberOfCells)
 {
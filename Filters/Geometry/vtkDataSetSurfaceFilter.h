@@ -35,6 +35,7 @@ class vtkPointData;
 class vtkPoints;
 class vtkIdTypeArray;
 class vtkStructuredGrid;
+class vtkUnstructuredGrid;
 
 // Helper structure for hashing faces.
 struct vtkFastGeomQuadStruct
@@ -128,6 +129,22 @@ public:
   vtkGetMacro(NonlinearSubdivisionLevel, int);
   //@}
 
+  //@{
+  /**
+   * If on, and the input is a vtkUnstructuredGrid whose 3D cells are all
+   * linear, the faces of the 3D cells are hashed in parallel (via
+   * vtkSMPTools) to find the external ones: the faces are binned into
+   * partitions of the point ids by chunks of cells, then the faces shared by
+   * several cells are cancelled in each partition independently. The output
+   * (including the original cell and point ids) is the same as with the
+   * serial hash. Note that this bypasses the Insert*InHash() methods. Off by
+   * default.
+   */
+  vtkSetMacro(ParallelExternalFaces, int);
+  vtkGetMacro(ParallelExternalFaces, int);
+  vtkBooleanMacro(ParallelExternalFaces, int);
+  //@}
+
   //@{
   /**
    * Direct access methods that can be used to use the this class as an
@@ -218,6 +235,7 @@ protected:
   virtual void InsertPolygonInHash(vtkIdType* ids, int numpts,
                            vtkIdType sourceId);
   void InitQuadHashTraversal();
+  void InsertExternalFacesInHash(vtkUnstructuredGrid *input);
   vtkFastGeomQuad *GetNextVisibleQuadFromHash();
 
   vtkFastGeomQuad **QuadHash;
@@ -266,6 +284,8 @@ protected:
 
   int NonlinearSubdivisionLevel;
 
+  int ParallelExternalFaces;
+
 private:
   vtkDataSetSurfaceFilter(const vtkDataSetSurfaceFilter&) VTK_DELETE_FUNCTION;
   void operator=(const vtkDataSetSurfaceFilter&) VTK_DELETE_FUNCTION;
@@ -1112,6 +1112,12 @@ void vtkPLagrangianParticleTracker::InitializeSurface(vtkDataObject*& surfaces)
   this->Superclass::InitializeSurface(surfaces);
 }
 
+//---------------------------------------------------------------------------
+bool vtkPLagrangianParticleTracker::CanIntegrateInParallel()
+{
+  return false;
+}
+
 //---------------------------------------------------------------------------
 vtkIdType vtkPLagrangianParticleTracker::GetNewParticleId()
 {
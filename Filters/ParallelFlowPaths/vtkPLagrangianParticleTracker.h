@@ -86,6 +86,12 @@ protected:
     vtkPolyData* particlePathsOutput, vtkIdList* particlePathPointId,
     vtkDataObject* interactionOutput) VTK_OVERRIDE;
 
+  /**
+   * Particles are streamed between ranks by Integrate(), so they are always
+   * integrated serially.
+   */
+  bool CanIntegrateInParallel() VTK_OVERRIDE;
+
   void SendParticle(vtkLagrangianParticle* particle);
   void ReceiveParticles(std::queue<vtkLagrangianParticle*>& particleQueue);
 
@@ -20,6 +20,7 @@
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkSMPTools.h"
 #include "vtkSMPThreadLocalObject.h"
 
@@ -95,6 +96,24 @@ struct RemoveOutliers
 
 }; //RemoveOutliers
 
+//----------------------------------------------------------------------------
+// Map the number of points within the radius (given by consecutive offsets)
+// to the point map.
+struct ThresholdNeighbors
+{
+  int NumNeighbors;
+
+  ThresholdNeighbors(int numNei) : NumNeighbors(numNei)
+  {
+  }
+
+  // Keep in mind that the points found always include the point itself.
+  vtkIdType operator() (vtkIdType offset, vtkIdType nextOffset) const
+  {
+    return ( (nextOffset - offset) > this->NumNeighbors ? 1 : -1 );
+  }
+};
+
 } //anonymous namespace
 
 //================= Begin class proper =======================================
@@ -131,6 +150,22 @@ int vtkRadiusOutlierRemoval::FilterPoints(vtkPointSet *input)
   // Determine which points, if any, should be removed. We create a map
   // to keep track. The bulk of the algorithmic work is done in this pass.
   vtkIdType numPts = input->GetNumberOfPoints();
+
+  // The static point locator counts the neighbors of all the points at once.
+  vtkStaticPointLocator *staticLocator =
+    vtkStaticPointLocator::SafeDownCast(this->Locator);
+  if ( staticLocator )
+  {
+    vtkIdTypeArray *offsets = vtkIdTypeArray::New();
+    staticLocator->FindPointsWithinRadius(this->Radius, input->GetPoints(),
+                                          offsets, NULL);
+    const vtkIdType *o = offsets->GetPointer(0);
+    vtkSMPTools::Transform(o, o + numPts, o + 1, this->PointMap,
+                           ThresholdNeighbors(this->NumberOfNeighbors));
+    offsets->Delete();
+    return 1;
+  }
+
   void *inPtr = input->GetPoints()->GetVoidPointer(0);
   switch (input->GetPoints()->GetDataType())
   {
@@ -0,0 +1,144 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageReaderMemoryMapping.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of memory mapping in vtkImageReader
+// .SECTION Description
+// Reads a raw volume with and without memory mapping, checks that the
+// mapped scalars hold the values of the file and can be modified without
+// changing it, and that a data mask falls back to reading.
+
+#include "vtkImageData.h"
+#include "vtkImageReader.h"
+#include "vtkMemoryMappedFile.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedShortArray.h"
+
+#include <string>
+
+namespace
+{
+
+const int Dims[3] = { 32, 24, 10 };
+const int HeaderSize = 16;
+
+unsigned short Value(int i)
+{
+  return static_cast<unsigned short>((i * 7) % 65521);
+}
+
+void WriteVolume(const std::string& filename)
+{
+  ofstream file(filename.c_str(), ios::out | ios::binary);
+  char header[HeaderSize] = { 0 };
+  file.write(header, HeaderSize);
+  int numValues = Dims[0] * Dims[1] * Dims[2];
+  for (int i = 0; i < numValues; ++i)
+  {
+    unsigned short value = Value(i);
+    file.write(reinterpret_cast<char*>(&value), sizeof(value));
+  }
+}
+
+vtkUnsignedShortArray* Read(vtkImageReader *reader,
+                            const std::string& filename, bool mapping,
+                            vtkTypeUInt64 mask)
+{
+  reader->SetFileName(filename.c_str());
+  reader->SetFileDimensionality(3);
+  reader->SetDataExtent(0, Dims[0] - 1, 0, Dims[1] - 1, 0, Dims[2] - 1);
+  reader->SetDataScalarTypeToUnsignedShort();
+  reader->SetHeaderSize(HeaderSize);
+  reader->SetSwapBytes(0);
+  reader->FileLowerLeftOn();
+  reader->SetDataMask(mask);
+  reader->SetUseMemoryMapping(mapping ? 1 : 0);
+  reader->Update();
+  return vtkArrayDownCast<vtkUnsignedShortArray>(
+    reader->GetOutput()->GetPointData()->GetScalars());
+}
+
+}
+
+int TestImageReaderMemoryMapping(int argc, char *argv[])
+{
+  char* temp_dir_c =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv,
+                                           "VTK_TEMP_DIR",
+                                           "Testing/Temporary");
+  std::string filename = std::string(temp_dir_c) +
+    "/testImageReaderMemoryMapping.raw";
+  delete [] temp_dir_c;
+  WriteVolume(filename);
+
+  const vtkTypeUInt64 noMask = VTK_TYPE_UINT64_MAX;
+  vtkNew<vtkImageReader> reader;
+  vtkUnsignedShortArray *read = Read(reader.GetPointer(), filename, false,
+                                     noMask);
+  vtkNew<vtkImageReader> mappedReader;
+  vtkUnsignedShortArray *mapped = Read(mappedReader.GetPointer(), filename,
+                                       true, noMask);
+  vtkIdType numValues = Dims[0] * Dims[1] * Dims[2];
+  if (!read || !mapped || read->GetNumberOfValues() != numValues ||
+      mapped->GetNumberOfValues() != numValues)
+  {
+    cerr << "Could not read the volume." << endl;
+    return EXIT_FAILURE;
+  }
+  if (vtkMemoryMappedFile::IsSupported() !=
+      vtkMemoryMappedFile::IsMapped(mapped->GetVoidPointer(0)))
+  {
+    cerr << "The scalars were not mapped from the file." << endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    if (read->GetValue(i) != Value(i) || mapped->GetValue(i) != Value(i))
+    {
+      cerr << "Wrong value at " << i << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The mapped values can be modified without changing the file.
+  mapped->SetValue(1, 12345);
+  vtkNew<vtkImageReader> checkReader;
+  vtkUnsignedShortArray *check = Read(checkReader.GetPointer(), filename,
+                                      false, noMask);
+  if (mapped->GetValue(1) != 12345 || check->GetValue(1) != Value(1))
+  {
+    cerr << "Modifying the mapped values changed the file." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // A data mask is applied to the values, which are then read.
+  vtkNew<vtkImageReader> maskReader;
+  vtkUnsignedShortArray *masked = Read(maskReader.GetPointer(), filename,
+                                       true, 0xff);
+  if (vtkMemoryMappedFile::IsMapped(masked->GetVoidPointer(0)))
+  {
+    cerr << "Masked scalars were mapped." << endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    if (masked->GetValue(i) != (Value(i) & 0xff))
+    {
+      cerr << "Wrong masked value at " << i << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -46,7 +46,7 @@ vtkImageReader::vtkImageReader()
     this->DataVOI[idx*2] = this->DataVOI[idx*2 + 1] = 0;
   }
 
-  this->DataMask = static_cast<vtkTypeUInt64>(~0UL);
+  this->DataMask = VTK_TYPE_UINT64_MAX;
   this->Transform = NULL;
 
   this->ScalarArrayName = NULL;
@@ -320,7 +320,7 @@ void vtkImageReaderUpdate2(vtkImageReader *self, vtkImageData *data,
       for (idx0 = dataExtent[0]; idx0 <= dataExtent[1]; ++idx0)
       {
         // Copy pixel into the output.
-        if (DataMask == static_cast<vtkTypeUInt64>(~0UL))
+        if (DataMask == VTK_TYPE_UINT64_MAX)
         {
           for (comp = 0; comp < pixelSkip; comp++)
           {
@@ -414,6 +414,14 @@ void vtkImageReader::ExecuteDataWithInformation(vtkDataObject *output,
 
   this->ComputeDataIncrements();
 
+  // The values can only be mapped when they are used as stored in the file.
+  if (this->UseMemoryMapping && !this->Transform &&
+      this->DataMask == VTK_TYPE_UINT64_MAX &&
+      this->MapFileData(data))
+  {
+    return;
+  }
+
   // Call the correct templated function for the output
   switch (this->GetDataScalarType())
   {
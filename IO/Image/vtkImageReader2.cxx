@@ -19,6 +19,7 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkErrorCode.h"
@@ -75,6 +76,7 @@ vtkImageReader2::vtkImageReader2()
   // Left over from short reader
   this->SwapBytes = 0;
   this->FileLowerLeft = 0;
+  this->UseMemoryMapping = 0;
   this->FileDimensionality = 2;
   this->SetNumberOfInputPorts(0);
 }
@@ -417,6 +419,9 @@ void vtkImageReader2::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Swap Bytes: " << (this->SwapBytes ? "On\n" : "Off\n");
 
+  os << indent << "Use Memory Mapping: "
+     << (this->UseMemoryMapping ? "On\n" : "Off\n");
+
   os << indent << "DataIncrements: (" << this->DataIncrements[0];
   for (idx = 1; idx < 2; ++idx)
   {
@@ -793,6 +798,11 @@ void vtkImageReader2::ExecuteDataWithInformation(vtkDataObject *output,
 
   this->ComputeDataIncrements();
 
+  if (this->UseMemoryMapping && this->MapFileData(data))
+  {
+    return;
+  }
+
   // Call the correct templated function for the output
   ptr = data->GetScalarPointer();
   switch (this->GetDataScalarType())
@@ -803,6 +813,58 @@ void vtkImageReader2::ExecuteDataWithInformation(vtkDataObject *output,
   }
 }
 
+//----------------------------------------------------------------------------
+int vtkImageReader2::MapFileData(vtkImageData *data)
+{
+  int *ext = data->GetExtent();
+  vtkDataArray *scalars = data->GetPointData()->GetScalars();
+  int typeSize = data->GetScalarSize();
+
+  // The requested slices must be stored contiguously and unchanged in the
+  // file.
+  if (this->MemoryBuffer || !scalars ||
+      scalars->GetArrayType() != vtkAbstractArray::AoSDataArrayTemplate ||
+      scalars->GetDataType() != this->DataScalarType ||
+      scalars->GetNumberOfComponents() != this->NumberOfScalarComponents ||
+      (this->SwapBytes && typeSize > 1) || !this->FileLowerLeft ||
+      ext[0] != this->DataExtent[0] || ext[1] != this->DataExtent[1] ||
+      ext[2] != this->DataExtent[2] || ext[3] != this->DataExtent[3] ||
+      (this->FileDimensionality < 3 && ext[4] != ext[5]) ||
+      !vtkMemoryMappedFile::IsSupported())
+  {
+    return 0;
+  }
+
+  vtkTypeUInt64 offset = this->GetHeaderSize(ext[4]);
+  if (this->FileDimensionality >= 3)
+  {
+    offset += static_cast<vtkTypeUInt64>(ext[4] - this->DataExtent[4]) *
+      this->DataIncrements[2];
+    this->ComputeInternalFileName(0);
+  }
+  else
+  {
+    this->ComputeInternalFileName(ext[4]);
+  }
+  if (!this->InternalFileName || offset % typeSize != 0)
+  {
+    return 0;
+  }
+
+  vtkIdType numValues = scalars->GetNumberOfValues();
+  void *ptr = vtkMemoryMappedFile::Map(
+    this->InternalFileName, offset,
+    static_cast<vtkTypeUInt64>(numValues) * typeSize,
+    vtkMemoryMappedFile::COPY_ON_WRITE);
+  if (!ptr)
+  {
+    return 0;
+  }
+  scalars->SetVoidArray(ptr, numValues, 0,
+                        vtkAbstractArray::VTK_DATA_ARRAY_UNMAP);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkImageReader2::SetMemoryBuffer(void *membuf)
 {
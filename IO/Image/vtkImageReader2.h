@@ -259,6 +259,24 @@ public:
   vtkSetMacro(FileLowerLeft, int);
   //@}
 
+  //@{
+  /**
+   * When on, the scalars are mapped in memory (copy-on-write) from the file
+   * instead of being read, when the requested slices are stored contiguously
+   * in one file: the whole X and Y data extent is requested, FileLowerLeft
+   * is on, no byte swapping is needed and the slices are in one volume file
+   * (or only one slice is requested). The values are then loaded on demand
+   * and their pages are shared with the other processes reading the same
+   * file. The file must not be changed while the output exists. Readers
+   * that decode their file format, rather than reading raw values, ignore
+   * this flag, as does vtkImageReader when a Transform or a DataMask is
+   * used. Default is off.
+   */
+  vtkSetMacro(UseMemoryMapping, int);
+  vtkGetMacro(UseMemoryMapping, int);
+  vtkBooleanMacro(UseMemoryMapping, int);
+  //@}
+
   //@{
   /**
    * Set/Get the internal file name
@@ -312,6 +330,7 @@ protected:
   char *FilePattern;
   int NumberOfScalarComponents;
   int FileLowerLeft;
+  int UseMemoryMapping;
 
   void *MemoryBuffer;
   vtkIdType MemoryBufferLength;
@@ -338,6 +357,10 @@ protected:
   virtual void ExecuteInformation();
   void ExecuteDataWithInformation(vtkDataObject *data, vtkInformation *outInfo) VTK_OVERRIDE;
   virtual void ComputeDataIncrements();
+
+  // Replace the scalars of the output by the values mapped from the file.
+  // Returns 0 if the requested extent cannot be mapped.
+  int MapFileData(vtkImageData *data);
 private:
   vtkImageReader2(const vtkImageReader2&) VTK_DELETE_FUNCTION;
   void operator=(const vtkImageReader2&) VTK_DELETE_FUNCTION;
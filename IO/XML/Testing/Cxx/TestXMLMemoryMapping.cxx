@@ -0,0 +1,224 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLMemoryMapping.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of memory mapped arrays
+// .SECTION Description
+// Maps raw files and raw appended XML data in memory and checks the values,
+// the copy-on-write behavior and the fallback to reading.
+
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkMemoryMappedFile.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <string>
+
+namespace
+{
+
+bool TestMapFile(const std::string& filename)
+{
+  const int numValues = 10000;
+  {
+    ofstream file(filename.c_str(), ios::out | ios::binary);
+    file.write("header!!", 8);
+    for (int i = 0; i < numValues; ++i)
+    {
+      float value = static_cast<float>(i);
+      file.write(reinterpret_cast<char*>(&value), sizeof(value));
+    }
+  }
+
+  // Invalid regions are reported and rejected.
+  vtkNew<vtkFloatArray> pairs;
+  pairs->SetNumberOfComponents(2);
+  vtkObject::GlobalWarningDisplayOff();
+  bool rejected = !pairs->MapFile(filename.c_str(), 10, 2) &&
+    !pairs->MapFile(filename.c_str(), 8, 3) &&
+    !pairs->MapFile(filename.c_str(), 8, numValues + 2);
+  vtkObject::GlobalWarningDisplayOn();
+  if (!rejected)
+  {
+    cerr << "Invalid region was mapped." << endl;
+    return false;
+  }
+  if (!vtkMemoryMappedFile::IsSupported())
+  {
+    return true;
+  }
+  if (!pairs->MapFile(filename.c_str(), 12, numValues - 2) ||
+      pairs->GetNumberOfTuples() != numValues / 2 - 1 ||
+      !vtkMemoryMappedFile::IsMapped(pairs->GetVoidPointer(0)) ||
+      pairs->GetTypedComponent(0, 0) != 1.0f ||
+      pairs->GetTypedComponent(1, 1) != 4.0f)
+  {
+    cerr << "Could not map the raw file." << endl;
+    return false;
+  }
+
+  vtkNew<vtkFloatArray> mapped;
+  if (!mapped->MapFile(filename.c_str(), 8, numValues))
+  {
+    cerr << "Could not map the raw file." << endl;
+    return false;
+  }
+  for (int i = 0; i < numValues; ++i)
+  {
+    if (mapped->GetValue(i) != static_cast<float>(i))
+    {
+      cerr << "Wrong mapped value " << mapped->GetValue(i) << " at " << i
+           << endl;
+      return false;
+    }
+  }
+
+  // Copy-on-write: the file is unchanged.
+  mapped->SetValue(0, -1.0f);
+  vtkNew<vtkFloatArray> check;
+  if (!check->MapFile(filename.c_str(), 8, 1) ||
+      check->GetValue(0) != 0.0f || mapped->GetValue(0) != -1.0f)
+  {
+    cerr << "Copy-on-write mapping changed the file." << endl;
+    return false;
+  }
+
+  // Growing the array moves it to the heap.
+  void *pointer = mapped->GetVoidPointer(0);
+  mapped->InsertNextValue(static_cast<float>(numValues));
+  if (vtkMemoryMappedFile::IsMapped(pointer) ||
+      mapped->GetValue(0) != -1.0f || mapped->GetValue(1) != 1.0f ||
+      mapped->GetValue(numValues) != static_cast<float>(numValues))
+  {
+    cerr << "Resizing the mapped array failed." << endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestXMLReader(const std::string& filename)
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(40, 30, 20);
+  vtkIdType numPoints = image->GetNumberOfPoints();
+  vtkNew<vtkUnsignedCharArray> bytes;
+  bytes->SetName("bytes");
+  bytes->SetNumberOfTuples(numPoints);
+  vtkNew<vtkFloatArray> floats;
+  floats->SetName("floats");
+  floats->SetNumberOfComponents(3);
+  floats->SetNumberOfTuples(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    bytes->SetValue(i, static_cast<unsigned char>(i % 251));
+    for (int c = 0; c < 3; ++c)
+    {
+      floats->SetTypedComponent(i, c, static_cast<float>(i * 3 + c));
+    }
+  }
+  image->GetPointData()->AddArray(bytes.GetPointer());
+  image->GetPointData()->AddArray(floats.GetPointer());
+
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetFileName(filename.c_str());
+  writer->SetInputData(image.GetPointer());
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetCompressorTypeToNone();
+  writer->Write();
+
+  for (int useMapping = 0; useMapping < 2; ++useMapping)
+  {
+    vtkNew<vtkXMLImageDataReader> reader;
+    reader->SetFileName(filename.c_str());
+    reader->SetUseMemoryMapping(useMapping);
+    reader->Update();
+
+    vtkPointData *pd = reader->GetOutput()->GetPointData();
+    vtkUnsignedCharArray *readBytes =
+      vtkArrayDownCast<vtkUnsignedCharArray>(pd->GetArray("bytes"));
+    vtkFloatArray *readFloats =
+      vtkArrayDownCast<vtkFloatArray>(pd->GetArray("floats"));
+    if (!readBytes || !readFloats ||
+        readBytes->GetNumberOfTuples() != numPoints ||
+        readFloats->GetNumberOfTuples() != numPoints)
+    {
+      cerr << "Could not read the arrays." << endl;
+      return false;
+    }
+    // Bytes are always aligned, so they must be mapped when supported.
+    bool mapped = vtkMemoryMappedFile::IsMapped(readBytes->GetVoidPointer(0));
+    if (mapped != (useMapping && vtkMemoryMappedFile::IsSupported()))
+    {
+      cerr << "Unexpected mapping state " << mapped << endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+      if (readBytes->GetValue(i) != bytes->GetValue(i) ||
+          readFloats->GetValue(3 * i + 1) != floats->GetValue(3 * i + 1))
+      {
+        cerr << "Wrong value at " << i << endl;
+        return false;
+      }
+    }
+  }
+
+  // Compressed data cannot be mapped and is read.
+  writer->SetCompressorTypeToZLib();
+  writer->Write();
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName(filename.c_str());
+  reader->UseMemoryMappingOn();
+  reader->Update();
+  vtkDataArray *readBytes =
+    reader->GetOutput()->GetPointData()->GetArray("bytes");
+  if (!readBytes || vtkMemoryMappedFile::IsMapped(readBytes->GetVoidPointer(0))
+      || readBytes->GetComponent(numPoints - 1, 0) !=
+         bytes->GetValue(numPoints - 1))
+  {
+    cerr << "Compressed data was not read correctly." << endl;
+    return false;
+  }
+  return true;
+}
+
+}
+
+int TestXMLMemoryMapping(int argc, char *argv[])
+{
+  char* temp_dir_c =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv,
+                                           "VTK_TEMP_DIR",
+                                           "Testing/Temporary");
+  std::string temp_dir = std::string(temp_dir_c);
+  delete [] temp_dir_c;
+
+  if (temp_dir.empty())
+  {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!TestMapFile(temp_dir + "/testXMLMemoryMapping.raw") ||
+      !TestXMLReader(temp_dir + "/testXMLMemoryMapping.vti"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
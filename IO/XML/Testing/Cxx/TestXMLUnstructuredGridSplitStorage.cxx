@@ -0,0 +1,165 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLUnstructuredGridSplitStorage.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the split cell storage of the XML unstructured grid reader
+// .SECTION Description
+// Writes an unstructured grid with 32-bit and 64-bit ids, reads it back and
+// checks that the cells are kept in split storage of the same type while
+// they are accessed through the thread safe vtkUnstructuredGrid methods.
+
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+namespace
+{
+
+// A strip of tetrahedra and hexahedra sharing their faces.
+void MakeGrid(vtkUnstructuredGrid *grid)
+{
+  const int numHexes = 20;
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i <= numHexes; ++i)
+  {
+    points->InsertNextPoint(i, 0, 0);
+    points->InsertNextPoint(i, 1, 0);
+    points->InsertNextPoint(i, 1, 1);
+    points->InsertNextPoint(i, 0, 1);
+  }
+  grid->SetPoints(points.GetPointer());
+  grid->Allocate(2 * numHexes);
+  for (vtkIdType i = 0; i < numHexes; ++i)
+  {
+    vtkIdType p = 4 * i;
+    vtkIdType hex[8] = { p, p + 4, p + 5, p + 1, p + 3, p + 7, p + 6, p + 2 };
+    vtkIdType tet[4] = { p, p + 1, p + 3, p + 4 };
+    grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+    grid->InsertNextCell(VTK_TETRA, 4, tet);
+  }
+}
+
+int TestRoundTrip(vtkUnstructuredGrid *input, bool int32Ids)
+{
+  const char *name = int32Ids ? "32-bit ids" : "64-bit ids";
+  vtkNew<vtkXMLUnstructuredGridWriter> writer;
+  writer->SetInputData(input);
+  writer->WriteToOutputStringOn();
+  if (int32Ids)
+  {
+    writer->SetIdTypeToInt32();
+  }
+  else
+  {
+    writer->SetIdTypeToInt64();
+  }
+  writer->Write();
+
+  vtkNew<vtkXMLUnstructuredGridReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(writer->GetOutputString());
+  reader->Update();
+  vtkUnstructuredGrid *output = reader->GetOutput();
+
+  vtkCellArray *cells = output->GetCells();
+  int storageType = int32Ids && sizeof(vtkIdType) == 8 ?
+    vtkCellArray::SPLIT_STORAGE_32 : vtkCellArray::SPLIT_STORAGE_64;
+  if (cells->GetStorageType() != storageType)
+  {
+    cerr << "Cells read with " << name << " use storage type "
+         << cells->GetStorageType() << " instead of " << storageType << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkIdType numCells = input->GetNumberOfCells();
+  if (output->GetNumberOfCells() != numCells)
+  {
+    cerr << "Wrong number of cells read with " << name << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkIdList> expected;
+  vtkNew<vtkIdList> ids;
+  vtkNew<vtkIdList> scratch;
+  vtkNew<vtkGenericCell> cell;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    input->GetCellPoints(cellId, expected.GetPointer());
+    vtkIdType npts;
+    const vtkIdType *pts;
+    output->GetCellPoints(cellId, npts, pts, scratch.GetPointer());
+    output->GetCellPoints(cellId, ids.GetPointer());
+    output->GetCell(cellId, cell.GetPointer());
+    if (output->GetCellType(cellId) != input->GetCellType(cellId) ||
+        npts != expected->GetNumberOfIds() ||
+        ids->GetNumberOfIds() != npts ||
+        cell->GetNumberOfPoints() != npts)
+    {
+      cerr << "Wrong cell " << cellId << " read with " << name << endl;
+      return EXIT_FAILURE;
+    }
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      vtkIdType id = expected->GetId(i);
+      if (pts[i] != id || ids->GetId(i) != id || cell->GetPointId(i) != id)
+      {
+        cerr << "Wrong point ids for cell " << cellId << " read with "
+             << name << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  if (cells->GetStorageType() != storageType)
+  {
+    cerr << "Accessing the cells read with " << name
+         << " changed their storage type." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // The legacy layout is still available on demand, with the locations of
+  // the grid pointing into it.
+  vtkIdType *legacy = cells->GetData()->GetPointer(0);
+  vtkIdTypeArray *locations = output->GetCellLocationsArray();
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    vtkIdType loc = locations->GetValue(cellId);
+    input->GetCellPoints(cellId, expected.GetPointer());
+    if (legacy[loc] != expected->GetNumberOfIds() ||
+        legacy[loc + 1] != expected->GetId(0))
+    {
+      cerr << "Wrong locations read with " << name << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int TestXMLUnstructuredGridSplitStorage(int, char *[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid.GetPointer());
+
+  int status = EXIT_SUCCESS;
+  status |= TestRoundTrip(grid.GetPointer(), true);
+  status |= TestRoundTrip(grid.GetPointer(), false);
+  return status;
+}
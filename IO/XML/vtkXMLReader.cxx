@@ -34,6 +34,7 @@
 #include "vtkInformationVector.h"
 #include "vtkInstantiator.h"
 #include "vtkLZ4DataCompressor.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkObjectFactory.h"
 #include "vtkQuadratureSchemeDefinition.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -105,6 +106,7 @@ vtkXMLReader::vtkXMLReader()
   this->StringStream = 0;
   this->ReadFromInputString = 0;
   this->InputString = "";
+  this->UseMemoryMapping = 0;
   this->XMLParser = 0;
   this->ReaderErrorObserver = 0;
   this->ParserErrorObserver = 0;
@@ -193,6 +195,7 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Stream: (none)\n";
   }
+  os << indent << "UseMemoryMapping: " << this->UseMemoryMapping << "\n";
   os << indent << "TimeStep:" << this->TimeStep << "\n";
   os << indent << "NumberOfTimeSteps:" << this->NumberOfTimeSteps << "\n";
   os << indent << "TimeStepRange:(" << this->TimeStepRange[0] << ","
@@ -802,19 +805,27 @@ int vtkXMLReader::ReadArrayValues(
   }
   this->InReadData = 1;
   int result;
-  // All arrays types except vtkBitArray.
-  vtkArrayIterator* iter = array->NewIterator();
-  switch (array->GetDataType())
+  if (this->UseMemoryMapping && arrayIndex == 0 &&
+      this->MapArrayValues(da, array, startIndex, numValues))
   {
-    vtkArrayIteratorTemplateMacro(
-      result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-        arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-  default:
-    result = 0;
+    result = 1;
   }
-  if (iter)
+  else
   {
-    iter->Delete();
+    // All arrays types except vtkBitArray.
+    vtkArrayIterator* iter = array->NewIterator();
+    switch (array->GetDataType())
+    {
+      vtkArrayIteratorTemplateMacro(
+        result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
+          arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
+    default:
+      result = 0;
+    }
+    if (iter)
+    {
+      iter->Delete();
+    }
   }
 
   this->ConvertGhostLevelsToGhostType(fieldType, array, startIndex, numValues);
@@ -830,6 +841,48 @@ int vtkXMLReader::ReadArrayValues(
   return result;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLReader::MapArrayValues(
+  vtkXMLDataElement* da, vtkAbstractArray* array, vtkIdType startIndex,
+  vtkIdType numValues)
+{
+  // Only whole arrays of the standard layout read from the appended data of
+  // a file can be mapped.
+  if (array->GetArrayType() != vtkAbstractArray::AoSDataArrayTemplate ||
+      numValues <= 0 ||
+      numValues != array->GetNumberOfValues() ||
+      !da->GetAttribute("offset") || !this->FileName ||
+      !this->FileStream || this->Stream != this->FileStream ||
+      !vtkMemoryMappedFile::IsSupported())
+  {
+    return 0;
+  }
+
+  vtkTypeInt64 offset = 0;
+  da->GetScalarAttribute("offset", offset);
+  vtkTypeInt64 position = this->XMLParser->GetAppendedDataFilePosition(
+    offset, startIndex, numValues, array->GetDataType());
+  int wordSize = array->GetDataTypeSize();
+  if (position < 0 || position % wordSize != 0)
+  {
+    return 0;
+  }
+
+  // Copy-on-write so that the values can still be modified in memory, for
+  // instance by ConvertGhostLevelsToGhostType or the next time step.
+  void* data = vtkMemoryMappedFile::Map(
+    this->FileName, static_cast<vtkTypeUInt64>(position),
+    static_cast<vtkTypeUInt64>(numValues) * wordSize,
+    vtkMemoryMappedFile::COPY_ON_WRITE);
+  if (!data)
+  {
+    return 0;
+  }
+  array->SetVoidArray(data, numValues, 0,
+                      vtkAbstractArray::VTK_DATA_ARRAY_UNMAP);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLReader::ReadXMLData()
 {
@@ -72,6 +72,20 @@ public:
   void SetInputString(const std::string& s) { this->InputString = s; }
   //@}
 
+  //@{
+  /**
+   * When on, arrays stored uncompressed in a raw appended data section in
+   * the byte order of this machine are mapped in memory (copy-on-write)
+   * instead of being read, when the whole array is read at once. The values
+   * are then loaded from the file on demand and their pages are shared with
+   * the other processes reading the same file. The file must not be changed
+   * while the output exists. Default is off.
+   */
+  vtkSetMacro(UseMemoryMapping, int);
+  vtkGetMacro(UseMemoryMapping, int);
+  vtkBooleanMacro(UseMemoryMapping, int);
+  //@}
+
   /**
    * Test whether the file (type) with the given name can be read by this
    * reader. If the file has a newer version than the reader, we still say
@@ -272,6 +286,12 @@ protected:
     vtkXMLDataElement* da, vtkIdType arrayIndex, vtkAbstractArray* array,
     vtkIdType startIndex, vtkIdType numValues, FieldType type = OTHER);
 
+  // Replace the storage of the whole array by the values mapped from the
+  // appended data section of the file. Returns 0 if the values cannot be
+  // mapped, in which case they must be read.
+  int MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array,
+                     vtkIdType startIndex, vtkIdType numValues);
+
   // Setup the data array selections for the input's set of arrays.
   void SetDataArraySelections(vtkXMLDataElement* eDSA,
                               vtkDataArraySelection* sel);
@@ -310,6 +330,9 @@ protected:
   // The input string.
   std::string InputString;
 
+  // Whether appended data may be mapped in memory instead of read.
+  int UseMemoryMapping;
+
   // The array selections.
   vtkDataArraySelection* PointDataArraySelection;
   vtkDataArraySelection* CellDataArraySelection;
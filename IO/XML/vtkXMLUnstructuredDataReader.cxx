@@ -22,7 +22,9 @@
 #include "vtkPointSet.h"
 #include "vtkInformation.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTypeInt32Array.h"
 
+#include <algorithm>
 #include <cassert>
 
 
@@ -655,6 +657,64 @@ int vtkXMLUnstructuredDataReader::ReadCellArray(vtkIdType numberOfCells,
     cellOffsets->Delete();
     return 0;
   }
+
+  vtkIdType curSize = 0;
+  if (this->Piece > this->StartPiece)
+  {
+    // Refer to BUG #12202 and BUG #12690. The (this->Piece > this->StartPiece)
+    // check ensures that when we are reading multiple timesteps, we don't end
+    // up appending to existing cell arrays infinitely. An earlier version of
+    // the fix assumed that vtkXMLUnstructuredDataReader read only 1 piece at a
+    // time, which was incorrect (and hence  BUG #12690).
+    curSize = outCells->GetNumberOfConnectivityEntries();
+  }
+
+  // When this piece provides all the cells and the point ids need no
+  // shifting, the arrays read from the file are handed to the cell array as
+  // split offsets/connectivity storage, without building the legacy layout.
+  if (curSize == 0 && numberOfCells == totalNumberOfCells &&
+      this->StartPoint == 0)
+  {
+    vtkDataArray* offsets;
+    vtkDataArray* connectivity;
+    if (vtkArrayDownCast<vtkAOSDataArrayTemplate<vtkTypeInt32> >(c0) &&
+        cpLength <= VTK_TYPE_INT32_MAX)
+    {
+      vtkTypeInt32Array* offsets32 = vtkTypeInt32Array::New();
+      vtkTypeInt32* optr = offsets32->WritePointer(0, numberOfCells + 1);
+      *optr++ = 0;
+      for(i=0; i < numberOfCells; ++i)
+      {
+        *optr++ = static_cast<vtkTypeInt32>(coffset[i]);
+      }
+      offsets = offsets32;
+      connectivity = c0;
+    }
+    else
+    {
+      vtkIdTypeArray* offsets64 = vtkIdTypeArray::New();
+      vtkIdType* optr = offsets64->WritePointer(0, numberOfCells + 1);
+      *optr++ = 0;
+      std::copy(coffset, coffset + numberOfCells, optr);
+      offsets = offsets64;
+      connectivity = this->ConvertToIdTypeArray(c0);
+    }
+    cellOffsets->Delete();
+    if(!connectivity)
+    {
+      vtkErrorMacro("Cannot read cell connectivity from " << eCells->GetName()
+                    << " in piece " << this->Piece
+                    << " because the \"connectivity\" array could not be"
+                    << " converted to a vtkIdTypeArray.");
+      offsets->Delete();
+      return 0;
+    }
+    bool success = outCells->SetData(offsets, connectivity);
+    offsets->Delete();
+    connectivity->Delete();
+    return success ? 1 : 0;
+  }
+
   vtkIdTypeArray* cellPoints = this->ConvertToIdTypeArray(c0);
   if(!cellPoints)
   {
@@ -666,18 +726,7 @@ int vtkXMLUnstructuredDataReader::ReadCellArray(vtkIdType numberOfCells,
     return 0;
   }
 
-
   // Allocate memory in the output connectivity array.
-  vtkIdType curSize = 0;
-  if (this->Piece > this->StartPiece && outCells->GetData())
-  {
-    // Refer to BUG #12202 and BUG #12690. The (this->Piece > this->StartPiece)
-    // check ensures that when we are reading multiple timesteps, we don't end
-    // up appending to existing cell arrays infinitely. An earlier version of
-    // the fix assumed that vtkXMLUnstructuredDataReader read only 1 piece at a
-    // time, which was incorrect (and hence  BUG #12690).
-    curSize = outCells->GetData()->GetNumberOfTuples();
-  }
 
   vtkIdType newSize = curSize+numberOfCells+cellPoints->GetNumberOfTuples();
   vtkIdType* cptr = outCells->WritePointer(totalNumberOfCells, newSize);
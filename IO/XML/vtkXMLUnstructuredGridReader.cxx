@@ -276,28 +276,41 @@ int vtkXMLUnstructuredGridReader::ReadPieceData()
   // Construct the cell locations.
   vtkIdTypeArray* locations = output->GetCellLocationsArray();
   vtkIdType* locs = locations->GetPointer(this->StartCell);
-  vtkIdTypeArray* cellArrayData = output->GetCells()->GetData();
-  vtkIdType startLoc = 0;
-  if (this->StartCell > 0)
+  vtkCellArray* outCells = output->GetCells();
+  vtkIdType i;
+  if (outCells->IsStorageSplit())
   {
-    // this set the startLoc to point to the location in the cellArray where the
-    // cell for this piece will start writing.
-
-    // Id for last written cell:
-    vtkIdType lastWrittenCell = this->StartCell - 1;
-    vtkIdType locationOfLastWrittenCell = locations->GetValue(lastWrittenCell);
-    startLoc = locationOfLastWrittenCell + 1 +
-      cellArrayData->GetValue(locationOfLastWrittenCell);
-    // startLoc = location-of-last-written-cell + 1 (for put the count for items in the cell)
-    //            + (number of items in the cell).
+    // The cells read as offsets/connectivity are kept in split storage: the
+    // locations are computed from the offsets, without the legacy layout.
+    for(i=0; i < this->NumberOfCells[this->Piece]; ++i)
+    {
+      locs[i] = outCells->GetLegacyLocation(this->StartCell + i);
+    }
   }
-  vtkIdType* begin = output->GetCells()->GetData()->GetPointer(startLoc);
-  vtkIdType* cur = begin;
-  vtkIdType i;
-  for(i=0; i < this->NumberOfCells[this->Piece]; ++i)
+  else
   {
-    locs[i] = startLoc + cur - begin;
-    cur += *cur + 1;
+    vtkIdTypeArray* cellArrayData = outCells->GetData();
+    vtkIdType startLoc = 0;
+    if (this->StartCell > 0)
+    {
+      // this set the startLoc to point to the location in the cellArray where the
+      // cell for this piece will start writing.
+
+      // Id for last written cell:
+      vtkIdType lastWrittenCell = this->StartCell - 1;
+      vtkIdType locationOfLastWrittenCell = locations->GetValue(lastWrittenCell);
+      startLoc = locationOfLastWrittenCell + 1 +
+        cellArrayData->GetValue(locationOfLastWrittenCell);
+      // startLoc = location-of-last-written-cell + 1 (for put the count for items in the cell)
+      //            + (number of items in the cell).
+    }
+    vtkIdType* begin = cellArrayData->GetPointer(startLoc);
+    vtkIdType* cur = begin;
+    for(i=0; i < this->NumberOfCells[this->Piece]; ++i)
+    {
+      locs[i] = startLoc + cur - begin;
+      cur += *cur + 1;
+    }
   }
 
   // Set the range of progress for the cell types.
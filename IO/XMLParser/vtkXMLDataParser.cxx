@@ -926,6 +926,55 @@ size_t vtkXMLDataParser::ReadAppendedData(vtkTypeInt64 offset,
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkXMLDataParser::GetAppendedDataFilePosition(
+  vtkTypeInt64 offset, vtkTypeUInt64 startWord, size_t numWords,
+  int wordType)
+{
+  size_t wordSize = this->GetWordTypeSize(wordType);
+  if(this->Compressor || !this->AppendedDataPosition ||
+     this->AppendedDataStream->IsA("vtkBase64InputStream"))
+  {
+    return -1;
+  }
+#ifdef VTK_WORDS_BIGENDIAN
+  if(wordSize > 1 && this->ByteOrder != vtkXMLDataParser::BigEndian)
+#else
+  if(wordSize > 1 && this->ByteOrder != vtkXMLDataParser::LittleEndian)
+#endif
+  {
+    return -1;
+  }
+
+  // Read the length of the data to make sure the words are there.
+#if defined(VTK_HAS_STD_UNIQUE_PTR)
+  std::unique_ptr<vtkXMLDataHeader>
+    uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+#else
+  std::auto_ptr<vtkXMLDataHeader>
+    uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+#endif
+  size_t const headerSize = uh->DataSize();
+  this->DataStream = this->AppendedDataStream;
+  this->SeekG(this->AppendedDataPosition+offset);
+  this->DataStream->SetStream(this->Stream);
+  this->DataStream->StartReading();
+  size_t r = this->DataStream->Read(uh->Data(), headerSize);
+  this->DataStream->EndReading();
+  if(r < headerSize)
+  {
+    return -1;
+  }
+  this->PerformByteSwap(uh->Data(), uh->WordCount(), uh->WordSize());
+  if((startWord+numWords)*wordSize > uh->Get(0))
+  {
+    return -1;
+  }
+
+  return this->AppendedDataPosition + offset +
+    static_cast<vtkTypeInt64>(headerSize + startWord*wordSize);
+}
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
@@ -79,6 +79,18 @@ public:
   { return this->ReadAppendedData(offset, buffer, startWord, numWords,
                                     VTK_CHAR); }
 
+  /**
+   * Return the position in the input stream of word @a startWord of the
+   * data stored at the given appended data offset, if @a numWords words
+   * starting there can be used in place: the appended data must be raw,
+   * uncompressed and in the byte order of this machine. Returns -1
+   * otherwise. This lets readers map the data in memory instead of reading
+   * it.
+   */
+  vtkTypeInt64 GetAppendedDataFilePosition(vtkTypeInt64 offset,
+                                           vtkTypeUInt64 startWord,
+                                           size_t numWords, int wordType);
+
   /**
    * Read from an ascii data section starting at the current position in
    * the stream.  Returns the number of words read.
@@ -194,6 +194,26 @@ void vtkGlyph3DMapper::SetSourceIndexArray(int fieldAttributeType)
     vtkDataObject::FIELD_ASSOCIATION_POINTS, fieldAttributeType);
 }
 
+// ---------------------------------------------------------------------------
+void vtkGlyph3DMapper::ConfigureForGlyph3DInstances(int numberOfSources)
+{
+  // The instances hold the final scale factors and directions.
+  this->SetScaling(true);
+  this->SetScaleModeToScaleByVectorComponents();
+  this->SetScaleFactor(1.0);
+  this->SetClamping(false);
+  this->SetScaleArray("GlyphScaleFactors");
+  this->SetOrient(true);
+  this->SetOrientationModeToDirection();
+  this->SetOrientationArray("GlyphOrientation");
+  this->SetMasking(false);
+
+  // The source index is mapped to itself: (index - 0) * n / n.
+  this->SetSourceIndexing(numberOfSources > 1);
+  this->SetSourceIndexArray("GlyphSourceIndex");
+  this->SetRange(0.0, numberOfSources > 1 ? numberOfSources : 1.0);
+}
+
 // ---------------------------------------------------------------------------
 vtkDataArray* vtkGlyph3DMapper::GetSourceIndexArray(vtkDataSet* input)
 {
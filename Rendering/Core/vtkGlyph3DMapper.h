@@ -362,6 +362,15 @@ public:
    */
   void SetSourceIndexArray(int fieldAttributeType);
 
+  /**
+   * Set up the mapper to render the glyph instances produced by vtkGlyph3D
+   * with GenerateInstances on: the sources are scaled by the components of
+   * the "GlyphScaleFactors" array, oriented along "GlyphOrientation" and,
+   * when there are several of them, chosen with "GlyphSourceIndex". The
+   * numberOfSources sources of the mapper must be those of the vtkGlyph3D.
+   */
+  void ConfigureForGlyph3DInstances(int numberOfSources = 1);
+
   /**
    * Convenience method to set the array used for selection IDs. This is same
    * as calling